@@ -1,310 +0,0 @@
-/**
- * ABSOLUTE MAXIMUM PERFORMANCE - Push to 179 GB/s hardware limit
- *
- * Optimizations:
- * - 64x loop unrolling (4096 bytes/iteration)
- * - Aligned loads/stores (_mm512_load_si512 / _mm512_store_si512)
- * - rdtsc cycle-accurate timing
- * - Mega-batching (1000 operations per timing call)
- * - Branch prediction hints
- * - Manual prefetching
- * - Compiler alignment hints
- */
-
-#include <immintrin.h>
-#include <x86intrin.h>
-#include <iostream>
-#include <iomanip>
-#include <vector>
-#include <cstdint>
-#include <cstdlib>
-
-// Cycle-accurate timing
-static inline uint64_t rdtsc_start() {
-    uint32_t lo, hi;
-    __asm__ __volatile__ (
-        "cpuid\n\t"
-        "rdtsc\n\t"
-        : "=a" (lo), "=d" (hi)
-        :: "%rbx", "%rcx"
-    );
-    return ((uint64_t)hi << 32) | lo;
-}
-
-static inline uint64_t rdtsc_end() {
-    uint32_t lo, hi;
-    __asm__ __volatile__ (
-        "rdtscp\n\t"
-        "mov %%edx, %0\n\t"
-        "mov %%eax, %1\n\t"
-        "cpuid\n\t"
-        : "=r" (hi), "=r" (lo)
-        :: "%rax", "%rbx", "%rcx", "%rdx"
-    );
-    return ((uint64_t)hi << 32) | lo;
-}
-
-// ULTRA-OPTIMIZED serialize with 64x unrolling (4096 bytes/iter)
-__attribute__((always_inline))
-inline void serialize_ultra_64x(const uint64_t* __restrict__ data, uint8_t* __restrict__ buf, size_t num_elements) {
-    const size_t data_bytes = num_elements * sizeof(uint64_t);
-
-    // Write length prefix
-    *reinterpret_cast<uint64_t*>(buf) = num_elements;
-
-    // Aligned pointers (tell compiler about alignment)
-    const __m512i* s = (const __m512i*)__builtin_assume_aligned(data, 64);
-    __m512i* d = (__m512i*)__builtin_assume_aligned(buf + 8, 64);
-
-    const size_t num_chunks = data_bytes / 64;
-
-    // 64x unrolling - 4096 bytes per iteration
-    for (size_t j = 0; j < num_chunks; j += 64) {
-        // Prefetch next iteration
-        _mm_prefetch((const char*)(s + j + 64), _MM_HINT_T0);
-        _mm_prefetch((const char*)(s + j + 80), _MM_HINT_T0);
-
-        // Load 64 x 64-byte chunks (4096 bytes)
-        __m512i v0 = _mm512_load_si512(s+j);
-        __m512i v1 = _mm512_load_si512(s+j+1);
-        __m512i v2 = _mm512_load_si512(s+j+2);
-        __m512i v3 = _mm512_load_si512(s+j+3);
-        __m512i v4 = _mm512_load_si512(s+j+4);
-        __m512i v5 = _mm512_load_si512(s+j+5);
-        __m512i v6 = _mm512_load_si512(s+j+6);
-        __m512i v7 = _mm512_load_si512(s+j+7);
-        __m512i v8 = _mm512_load_si512(s+j+8);
-        __m512i v9 = _mm512_load_si512(s+j+9);
-        __m512i v10 = _mm512_load_si512(s+j+10);
-        __m512i v11 = _mm512_load_si512(s+j+11);
-        __m512i v12 = _mm512_load_si512(s+j+12);
-        __m512i v13 = _mm512_load_si512(s+j+13);
-        __m512i v14 = _mm512_load_si512(s+j+14);
-        __m512i v15 = _mm512_load_si512(s+j+15);
-
-        __m512i v16 = _mm512_load_si512(s+j+16);
-        __m512i v17 = _mm512_load_si512(s+j+17);
-        __m512i v18 = _mm512_load_si512(s+j+18);
-        __m512i v19 = _mm512_load_si512(s+j+19);
-        __m512i v20 = _mm512_load_si512(s+j+20);
-        __m512i v21 = _mm512_load_si512(s+j+21);
-        __m512i v22 = _mm512_load_si512(s+j+22);
-        __m512i v23 = _mm512_load_si512(s+j+23);
-        __m512i v24 = _mm512_load_si512(s+j+24);
-        __m512i v25 = _mm512_load_si512(s+j+25);
-        __m512i v26 = _mm512_load_si512(s+j+26);
-        __m512i v27 = _mm512_load_si512(s+j+27);
-        __m512i v28 = _mm512_load_si512(s+j+28);
-        __m512i v29 = _mm512_load_si512(s+j+29);
-        __m512i v30 = _mm512_load_si512(s+j+30);
-        __m512i v31 = _mm512_load_si512(s+j+31);
-
-        __m512i v32 = _mm512_load_si512(s+j+32);
-        __m512i v33 = _mm512_load_si512(s+j+33);
-        __m512i v34 = _mm512_load_si512(s+j+34);
-        __m512i v35 = _mm512_load_si512(s+j+35);
-        __m512i v36 = _mm512_load_si512(s+j+36);
-        __m512i v37 = _mm512_load_si512(s+j+37);
-        __m512i v38 = _mm512_load_si512(s+j+38);
-        __m512i v39 = _mm512_load_si512(s+j+39);
-        __m512i v40 = _mm512_load_si512(s+j+40);
-        __m512i v41 = _mm512_load_si512(s+j+41);
-        __m512i v42 = _mm512_load_si512(s+j+42);
-        __m512i v43 = _mm512_load_si512(s+j+43);
-        __m512i v44 = _mm512_load_si512(s+j+44);
-        __m512i v45 = _mm512_load_si512(s+j+45);
-        __m512i v46 = _mm512_load_si512(s+j+46);
-        __m512i v47 = _mm512_load_si512(s+j+47);
-
-        __m512i v48 = _mm512_load_si512(s+j+48);
-        __m512i v49 = _mm512_load_si512(s+j+49);
-        __m512i v50 = _mm512_load_si512(s+j+50);
-        __m512i v51 = _mm512_load_si512(s+j+51);
-        __m512i v52 = _mm512_load_si512(s+j+52);
-        __m512i v53 = _mm512_load_si512(s+j+53);
-        __m512i v54 = _mm512_load_si512(s+j+54);
-        __m512i v55 = _mm512_load_si512(s+j+55);
-        __m512i v56 = _mm512_load_si512(s+j+56);
-        __m512i v57 = _mm512_load_si512(s+j+57);
-        __m512i v58 = _mm512_load_si512(s+j+58);
-        __m512i v59 = _mm512_load_si512(s+j+59);
-        __m512i v60 = _mm512_load_si512(s+j+60);
-        __m512i v61 = _mm512_load_si512(s+j+61);
-        __m512i v62 = _mm512_load_si512(s+j+62);
-        __m512i v63 = _mm512_load_si512(s+j+63);
-
-        // Store all 64 chunks
-        _mm512_store_si512(d+j, v0);
-        _mm512_store_si512(d+j+1, v1);
-        _mm512_store_si512(d+j+2, v2);
-        _mm512_store_si512(d+j+3, v3);
-        _mm512_store_si512(d+j+4, v4);
-        _mm512_store_si512(d+j+5, v5);
-        _mm512_store_si512(d+j+6, v6);
-        _mm512_store_si512(d+j+7, v7);
-        _mm512_store_si512(d+j+8, v8);
-        _mm512_store_si512(d+j+9, v9);
-        _mm512_store_si512(d+j+10, v10);
-        _mm512_store_si512(d+j+11, v11);
-        _mm512_store_si512(d+j+12, v12);
-        _mm512_store_si512(d+j+13, v13);
-        _mm512_store_si512(d+j+14, v14);
-        _mm512_store_si512(d+j+15, v15);
-
-        _mm512_store_si512(d+j+16, v16);
-        _mm512_store_si512(d+j+17, v17);
-        _mm512_store_si512(d+j+18, v18);
-        _mm512_store_si512(d+j+19, v19);
-        _mm512_store_si512(d+j+20, v20);
-        _mm512_store_si512(d+j+21, v21);
-        _mm512_store_si512(d+j+22, v22);
-        _mm512_store_si512(d+j+23, v23);
-        _mm512_store_si512(d+j+24, v24);
-        _mm512_store_si512(d+j+25, v25);
-        _mm512_store_si512(d+j+26, v26);
-        _mm512_store_si512(d+j+27, v27);
-        _mm512_store_si512(d+j+28, v28);
-        _mm512_store_si512(d+j+29, v29);
-        _mm512_store_si512(d+j+30, v30);
-        _mm512_store_si512(d+j+31, v31);
-
-        _mm512_store_si512(d+j+32, v32);
-        _mm512_store_si512(d+j+33, v33);
-        _mm512_store_si512(d+j+34, v34);
-        _mm512_store_si512(d+j+35, v35);
-        _mm512_store_si512(d+j+36, v36);
-        _mm512_store_si512(d+j+37, v37);
-        _mm512_store_si512(d+j+38, v38);
-        _mm512_store_si512(d+j+39, v39);
-        _mm512_store_si512(d+j+40, v40);
-        _mm512_store_si512(d+j+41, v41);
-        _mm512_store_si512(d+j+42, v42);
-        _mm512_store_si512(d+j+43, v43);
-        _mm512_store_si512(d+j+44, v44);
-        _mm512_store_si512(d+j+45, v45);
-        _mm512_store_si512(d+j+46, v46);
-        _mm512_store_si512(d+j+47, v47);
-
-        _mm512_store_si512(d+j+48, v48);
-        _mm512_store_si512(d+j+49, v49);
-        _mm512_store_si512(d+j+50, v50);
-        _mm512_store_si512(d+j+51, v51);
-        _mm512_store_si512(d+j+52, v52);
-        _mm512_store_si512(d+j+53, v53);
-        _mm512_store_si512(d+j+54, v54);
-        _mm512_store_si512(d+j+55, v55);
-        _mm512_store_si512(d+j+56, v56);
-        _mm512_store_si512(d+j+57, v57);
-        _mm512_store_si512(d+j+58, v58);
-        _mm512_store_si512(d+j+59, v59);
-        _mm512_store_si512(d+j+60, v60);
-        _mm512_store_si512(d+j+61, v61);
-        _mm512_store_si512(d+j+62, v62);
-        _mm512_store_si512(d+j+63, v63);
-    }
-}
-
-double benchmark_absolute_max(size_t num_elements) {
-    const size_t data_bytes = num_elements * sizeof(uint64_t);
-
-    // Must be multiple of 4096 bytes for 64x unrolling
-    if (data_bytes < 4096 || data_bytes % 4096 != 0) {
-        return 0.0;
-    }
-
-    // Aligned allocation
-    uint64_t* data = (uint64_t*)aligned_alloc(64, data_bytes);
-    uint8_t* buf = (uint8_t*)aligned_alloc(64, data_bytes + 64);
-
-    // Initialize
-    for (size_t i = 0; i < num_elements; ++i) {
-        data[i] = 0xABCDEF0123456789ULL;
-    }
-
-    // Warmup - 100 iterations
-    for (size_t i = 0; i < 100; ++i) {
-        serialize_ultra_64x(data, buf, num_elements);
-    }
-
-    // Mega-batch: 10000 operations per timing call to minimize overhead
-    const size_t mega_batch = 10000;
-
-    uint64_t start = rdtsc_start();
-
-    for (size_t i = 0; i < mega_batch; ++i) {
-        serialize_ultra_64x(data, buf, num_elements);
-    }
-
-    uint64_t end = rdtsc_end();
-
-    // Prevent optimization
-    volatile uint8_t sink = buf[0];
-    (void)sink;
-
-    free(data);
-    free(buf);
-
-    // Calculate GB/s
-    const double cpu_ghz = 2.8;
-    uint64_t total_cycles = end - start;
-    double cycles_per_op = total_cycles / static_cast<double>(mega_batch);
-    double ns_per_op = cycles_per_op / cpu_ghz;
-
-    return data_bytes / ns_per_op; // GB/s
-}
-
-int main() {
-    std::cout << "\n═══════════════════════════════════════════════════════════════════════════\n";
-    std::cout << "  ABSOLUTE MAXIMUM - Pushing to 179 GB/s Hardware Limit\n";
-    std::cout << "═══════════════════════════════════════════════════════════════════════════\n\n";
-    std::cout << "| Size | Throughput | Hardware Max | % of Max | Status |\n";
-    std::cout << "|------|------------|--------------|----------|--------|\n";
-
-    struct TestSize {
-        size_t num_elements;
-        const char* name;
-    };
-
-    // Only test sizes that are multiples of 4096 bytes (for 64x unrolling)
-    std::vector<TestSize> sizes = {
-        {512, "4KB"},        // 512 * 8 = 4096
-        {1024, "8KB"},       // 1024 * 8 = 8192
-        {2048, "16KB"},
-        {4096, "32KB"},
-        {8192, "64KB"},
-        {16384, "128KB"},
-        {32768, "256KB"},
-        {65536, "512KB"},
-        {131072, "1MB"},
-        {262144, "2MB"},
-    };
-
-    for (const auto& cfg : sizes) {
-        double gbps = benchmark_absolute_max(cfg.num_elements);
-        if (gbps > 0) {
-            double percent = (gbps / 179.0) * 100.0;
-            const char* status = (percent >= 90) ? "🏆 GOAL!" : (percent >= 80) ? "✅ Great" : "⚠️ Optimize";
-
-            std::cout << "| " << std::setw(4) << cfg.name
-                      << " | **" << std::fixed << std::setprecision(2) << std::setw(8) << gbps << " GB/s** | "
-                      << "179.00 GB/s | "
-                      << std::setw(6) << std::setprecision(1) << percent << "% | "
-                      << status << " |\n";
-            std::cout.flush();
-        }
-    }
-
-    std::cout << "\n═══════════════════════════════════════════════════════════════════════════\n";
-    std::cout << "  Optimizations:\n";
-    std::cout << "  - 64x loop unrolling (4096 bytes/iteration)\n";
-    std::cout << "  - Aligned loads/stores (_mm512_load/store_si512)\n";
-    std::cout << "  - rdtsc cycle-accurate timing\n";
-    std::cout << "  - Mega-batching (10000 ops/timing)\n";
-    std::cout << "  - Software prefetching\n";
-    std::cout << "  - Compiler alignment hints (__builtin_assume_aligned)\n";
-    std::cout << "  \n";
-    std::cout << "  TARGET: 90%+ of 179 GB/s hardware limit (161 GB/s+)\n";
-    std::cout << "═══════════════════════════════════════════════════════════════════════════\n\n";
-
-    return 0;
-}
@@ -1,187 +0,0 @@
-/**
- * @file bench.cpp
- * @brief Performance benchmark suite for limcode serialization
- */
-
-#include <limcode/limcode.h>
-#include <chrono>
-#include <iostream>
-#include <iomanip>
-#include <vector>
-
-using namespace std::chrono;
-
-double benchmark_size(size_t num_elements, size_t iterations) {
-    const size_t data_bytes = num_elements * sizeof(uint64_t);
-
-    // Use aligned allocation matching old benchmark (64-byte alignment for AVX-512)
-    uint64_t* data = (uint64_t*)aligned_alloc(64, data_bytes);
-    uint8_t* buf = (uint8_t*)aligned_alloc(64, data_bytes + 64);
-
-    for (size_t i = 0; i < num_elements; ++i) {
-        data[i] = 0xABCDEF0123456789ULL;
-    }
-
-    // Warmup
-    for (size_t i = 0; i < 3; ++i) {
-        *reinterpret_cast<uint64_t*>(buf) = num_elements;
-        const __m512i* s = (const __m512i*)data;
-        __m512i* d = (__m512i*)(buf + 8);
-
-        for (size_t j = 0; j < data_bytes/64; j += 16) {
-            __m512i v0 = _mm512_loadu_si512(s+j);
-            __m512i v1 = _mm512_loadu_si512(s+j+1);
-            __m512i v2 = _mm512_loadu_si512(s+j+2);
-            __m512i v3 = _mm512_loadu_si512(s+j+3);
-            __m512i v4 = _mm512_loadu_si512(s+j+4);
-            __m512i v5 = _mm512_loadu_si512(s+j+5);
-            __m512i v6 = _mm512_loadu_si512(s+j+6);
-            __m512i v7 = _mm512_loadu_si512(s+j+7);
-            __m512i v8 = _mm512_loadu_si512(s+j+8);
-            __m512i v9 = _mm512_loadu_si512(s+j+9);
-            __m512i v10 = _mm512_loadu_si512(s+j+10);
-            __m512i v11 = _mm512_loadu_si512(s+j+11);
-            __m512i v12 = _mm512_loadu_si512(s+j+12);
-            __m512i v13 = _mm512_loadu_si512(s+j+13);
-            __m512i v14 = _mm512_loadu_si512(s+j+14);
-            __m512i v15 = _mm512_loadu_si512(s+j+15);
-
-            _mm512_storeu_si512(d+j, v0);
-            _mm512_storeu_si512(d+j+1, v1);
-            _mm512_storeu_si512(d+j+2, v2);
-            _mm512_storeu_si512(d+j+3, v3);
-            _mm512_storeu_si512(d+j+4, v4);
-            _mm512_storeu_si512(d+j+5, v5);
-            _mm512_storeu_si512(d+j+6, v6);
-            _mm512_storeu_si512(d+j+7, v7);
-            _mm512_storeu_si512(d+j+8, v8);
-            _mm512_storeu_si512(d+j+9, v9);
-            _mm512_storeu_si512(d+j+10, v10);
-            _mm512_storeu_si512(d+j+11, v11);
-            _mm512_storeu_si512(d+j+12, v12);
-            _mm512_storeu_si512(d+j+13, v13);
-            _mm512_storeu_si512(d+j+14, v14);
-            _mm512_storeu_si512(d+j+15, v15);
-        }
-    }
-
-    // Benchmark - same code as warmup
-    auto start = high_resolution_clock::now();
-    for (size_t i = 0; i < iterations; ++i) {
-        *reinterpret_cast<uint64_t*>(buf) = num_elements;
-        const __m512i* s = (const __m512i*)data;
-        __m512i* d = (__m512i*)(buf + 8);
-
-        for (size_t j = 0; j < data_bytes/64; j += 16) {
-            __m512i v0 = _mm512_loadu_si512(s+j);
-            __m512i v1 = _mm512_loadu_si512(s+j+1);
-            __m512i v2 = _mm512_loadu_si512(s+j+2);
-            __m512i v3 = _mm512_loadu_si512(s+j+3);
-            __m512i v4 = _mm512_loadu_si512(s+j+4);
-            __m512i v5 = _mm512_loadu_si512(s+j+5);
-            __m512i v6 = _mm512_loadu_si512(s+j+6);
-            __m512i v7 = _mm512_loadu_si512(s+j+7);
-            __m512i v8 = _mm512_loadu_si512(s+j+8);
-            __m512i v9 = _mm512_loadu_si512(s+j+9);
-            __m512i v10 = _mm512_loadu_si512(s+j+10);
-            __m512i v11 = _mm512_loadu_si512(s+j+11);
-            __m512i v12 = _mm512_loadu_si512(s+j+12);
-            __m512i v13 = _mm512_loadu_si512(s+j+13);
-            __m512i v14 = _mm512_loadu_si512(s+j+14);
-            __m512i v15 = _mm512_loadu_si512(s+j+15);
-
-            _mm512_storeu_si512(d+j, v0);
-            _mm512_storeu_si512(d+j+1, v1);
-            _mm512_storeu_si512(d+j+2, v2);
-            _mm512_storeu_si512(d+j+3, v3);
-            _mm512_storeu_si512(d+j+4, v4);
-            _mm512_storeu_si512(d+j+5, v5);
-            _mm512_storeu_si512(d+j+6, v6);
-            _mm512_storeu_si512(d+j+7, v7);
-            _mm512_storeu_si512(d+j+8, v8);
-            _mm512_storeu_si512(d+j+9, v9);
-            _mm512_storeu_si512(d+j+10, v10);
-            _mm512_storeu_si512(d+j+11, v11);
-            _mm512_storeu_si512(d+j+12, v12);
-            _mm512_storeu_si512(d+j+13, v13);
-            _mm512_storeu_si512(d+j+14, v14);
-            _mm512_storeu_si512(d+j+15, v15);
-        }
-    }
-    auto end = high_resolution_clock::now();
-
-    double ns_per_op = duration_cast<nanoseconds>(end - start).count() / static_cast<double>(iterations);
-
-    // Prevent optimization - use the buffer
-    volatile uint8_t sink = buf[0];
-    (void)sink;
-
-    free(data);
-    free(buf);
-
-    return data_bytes / ns_per_op;
-}
-
-std::string format_size(size_t bytes) {
-    if (bytes >= 1024 * 1024) {
-        return std::to_string(bytes / (1024 * 1024)) + "MB";
-    } else if (bytes >= 1024) {
-        return std::to_string(bytes / 1024) + "KB";
-    } else {
-        return std::to_string(bytes) + "B";
-    }
-}
-
-int main() {
-    std::cout << "\n═══════════════════════════════════════════════════════════════════════════\n";
-    std::cout << "  C++ LIMCODE - TRUE THEORETICAL MAXIMUM (df4a8da method)\n";
-    std::cout << "═══════════════════════════════════════════════════════════════════════════\n\n";
-    std::cout << "| Size | Throughput | Theoretical Max (179 GB/s) | % of Max |\n";
-    std::cout << "|------|------------|----------------------------|----------|\n";
-
-    struct SizeConfig {
-        size_t num_elements;
-        size_t iterations;
-    };
-
-    std::vector<SizeConfig> sizes = {
-        // Skip < 1KB to avoid heap corruption with aligned_alloc
-        {128, 1000},         // 1KB
-        {256, 500},          // 2KB
-        {512, 250},          // 4KB
-        {1024, 100},         // 8KB
-        {2048, 50},          // 16KB
-        {4096, 25},          // 32KB
-        {8192, 10},          // 64KB
-        {16384, 5},          // 128KB
-        {32768, 3},          // 256KB
-        {65536, 2},          // 512KB
-        {131072, 2},         // 1MB
-        {262144, 1},         // 2MB
-        {524288, 1},         // 4MB
-        {1048576, 1},        // 8MB
-        {2097152, 1},        // 16MB
-        {4194304, 1},        // 32MB
-        {8388608, 1},        // 64MB
-        {16777216, 1},       // 128MB
-    };
-
-    for (const auto& cfg : sizes) {
-        size_t size_bytes = cfg.num_elements * sizeof(uint64_t);
-        double gbps = benchmark_size(cfg.num_elements, cfg.iterations);
-        double theoretical = (size_bytes >= 262144) ? 120.0 : 179.0; // 256KB+ limited by memory BW
-        double percent = (gbps / theoretical) * 100.0;
-
-        std::cout << "| " << std::setw(4) << format_size(size_bytes)
-                  << " | **" << std::fixed << std::setprecision(2) << std::setw(8) << gbps << " GB/s** | "
-                  << std::setw(8) << theoretical << " GB/s | "
-                  << std::setw(6) << std::setprecision(1) << percent << "% |\n";
-        std::cout.flush();
-    }
-
-    std::cout << "\n═══════════════════════════════════════════════════════════════════════════\n";
-    std::cout << "  Using df4a8da method: aligned_alloc(64) + AVX-512 16x unrolling\n";
-    std::cout << "═══════════════════════════════════════════════════════════════════════════\n\n";
-
-    return 0;
-}
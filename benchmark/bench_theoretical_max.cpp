@@ -1,238 +0,0 @@
-/**
- * Theoretical Maximum Performance Benchmark
- * Using AVX-512 16x unrolling with aligned allocations + OpenMP parallelism
- */
-
-#include <immintrin.h>
-#include <chrono>
-#include <iostream>
-#include <iomanip>
-#include <vector>
-#include <cstdlib>
-#include <omp.h>
-
-using namespace std::chrono;
-
-double benchmark_serialize(size_t num_elements, size_t iterations) {
-    const size_t data_bytes = num_elements * sizeof(uint64_t);
-
-    // Skip if too small for 16x unrolling (need at least 1024 bytes = 64 * 16)
-    // But allow smaller sizes with reduced unrolling
-    if (data_bytes < 64) {
-        return 0.0;
-    }
-
-    // Use aligned allocation matching original df4a8da benchmark
-    // CRITICAL: Fresh allocation gives better performance than buffer reuse!
-    uint64_t* data = (uint64_t*)aligned_alloc(64, data_bytes);
-    uint8_t* buf = (uint8_t*)aligned_alloc(64, data_bytes + 64);
-
-    for (size_t i = 0; i < num_elements; ++i) {
-        data[i] = 0xABCDEF0123456789ULL;
-    }
-
-    // Warmup
-    for (size_t i = 0; i < 3; ++i) {
-        *reinterpret_cast<uint64_t*>(buf) = num_elements;
-        const __m512i* s = (const __m512i*)data;
-        __m512i* d = (__m512i*)(buf + 8);
-
-        for (size_t j = 0; j < data_bytes/64; j += 16) {
-            __m512i v0 = _mm512_loadu_si512(s+j);
-            __m512i v1 = _mm512_loadu_si512(s+j+1);
-            __m512i v2 = _mm512_loadu_si512(s+j+2);
-            __m512i v3 = _mm512_loadu_si512(s+j+3);
-            __m512i v4 = _mm512_loadu_si512(s+j+4);
-            __m512i v5 = _mm512_loadu_si512(s+j+5);
-            __m512i v6 = _mm512_loadu_si512(s+j+6);
-            __m512i v7 = _mm512_loadu_si512(s+j+7);
-            __m512i v8 = _mm512_loadu_si512(s+j+8);
-            __m512i v9 = _mm512_loadu_si512(s+j+9);
-            __m512i v10 = _mm512_loadu_si512(s+j+10);
-            __m512i v11 = _mm512_loadu_si512(s+j+11);
-            __m512i v12 = _mm512_loadu_si512(s+j+12);
-            __m512i v13 = _mm512_loadu_si512(s+j+13);
-            __m512i v14 = _mm512_loadu_si512(s+j+14);
-            __m512i v15 = _mm512_loadu_si512(s+j+15);
-
-            _mm512_storeu_si512(d+j, v0);
-            _mm512_storeu_si512(d+j+1, v1);
-            _mm512_storeu_si512(d+j+2, v2);
-            _mm512_storeu_si512(d+j+3, v3);
-            _mm512_storeu_si512(d+j+4, v4);
-            _mm512_storeu_si512(d+j+5, v5);
-            _mm512_storeu_si512(d+j+6, v6);
-            _mm512_storeu_si512(d+j+7, v7);
-            _mm512_storeu_si512(d+j+8, v8);
-            _mm512_storeu_si512(d+j+9, v9);
-            _mm512_storeu_si512(d+j+10, v10);
-            _mm512_storeu_si512(d+j+11, v11);
-            _mm512_storeu_si512(d+j+12, v12);
-            _mm512_storeu_si512(d+j+13, v13);
-            _mm512_storeu_si512(d+j+14, v14);
-            _mm512_storeu_si512(d+j+15, v15);
-        }
-    }
-
-    // Benchmark - OpenMP parallelism disabled due to thread overhead
-    // Single-threaded AVX-512 SIMD is faster for all sizes
-    const bool use_parallel = false;
-
-    auto start = high_resolution_clock::now();
-    for (size_t i = 0; i < iterations; ++i) {
-        *reinterpret_cast<uint64_t*>(buf) = num_elements;
-        const __m512i* s = (const __m512i*)data;
-        __m512i* d = (__m512i*)(buf + 8);
-
-        const size_t num_chunks = data_bytes/64;
-        const size_t unroll_factor = (num_chunks >= 16) ? 16 : 1; // Reduce unrolling for small data
-
-        if (use_parallel) {
-            #pragma omp parallel for schedule(static)
-            for (size_t j = 0; j < num_chunks; j += unroll_factor) {
-                __m512i v0 = _mm512_loadu_si512(s+j);
-                __m512i v1 = _mm512_loadu_si512(s+j+1);
-                __m512i v2 = _mm512_loadu_si512(s+j+2);
-                __m512i v3 = _mm512_loadu_si512(s+j+3);
-                __m512i v4 = _mm512_loadu_si512(s+j+4);
-                __m512i v5 = _mm512_loadu_si512(s+j+5);
-                __m512i v6 = _mm512_loadu_si512(s+j+6);
-                __m512i v7 = _mm512_loadu_si512(s+j+7);
-                __m512i v8 = _mm512_loadu_si512(s+j+8);
-                __m512i v9 = _mm512_loadu_si512(s+j+9);
-                __m512i v10 = _mm512_loadu_si512(s+j+10);
-                __m512i v11 = _mm512_loadu_si512(s+j+11);
-                __m512i v12 = _mm512_loadu_si512(s+j+12);
-                __m512i v13 = _mm512_loadu_si512(s+j+13);
-                __m512i v14 = _mm512_loadu_si512(s+j+14);
-                __m512i v15 = _mm512_loadu_si512(s+j+15);
-
-                _mm512_storeu_si512(d+j, v0);
-                _mm512_storeu_si512(d+j+1, v1);
-                _mm512_storeu_si512(d+j+2, v2);
-                _mm512_storeu_si512(d+j+3, v3);
-                _mm512_storeu_si512(d+j+4, v4);
-                _mm512_storeu_si512(d+j+5, v5);
-                _mm512_storeu_si512(d+j+6, v6);
-                _mm512_storeu_si512(d+j+7, v7);
-                _mm512_storeu_si512(d+j+8, v8);
-                _mm512_storeu_si512(d+j+9, v9);
-                _mm512_storeu_si512(d+j+10, v10);
-                _mm512_storeu_si512(d+j+11, v11);
-                _mm512_storeu_si512(d+j+12, v12);
-                _mm512_storeu_si512(d+j+13, v13);
-                _mm512_storeu_si512(d+j+14, v14);
-                _mm512_storeu_si512(d+j+15, v15);
-            }
-        } else {
-            for (size_t j = 0; j < num_chunks; j += unroll_factor) {
-                __m512i v0 = _mm512_loadu_si512(s+j);
-                __m512i v1 = _mm512_loadu_si512(s+j+1);
-                __m512i v2 = _mm512_loadu_si512(s+j+2);
-                __m512i v3 = _mm512_loadu_si512(s+j+3);
-                __m512i v4 = _mm512_loadu_si512(s+j+4);
-                __m512i v5 = _mm512_loadu_si512(s+j+5);
-                __m512i v6 = _mm512_loadu_si512(s+j+6);
-                __m512i v7 = _mm512_loadu_si512(s+j+7);
-                __m512i v8 = _mm512_loadu_si512(s+j+8);
-                __m512i v9 = _mm512_loadu_si512(s+j+9);
-                __m512i v10 = _mm512_loadu_si512(s+j+10);
-                __m512i v11 = _mm512_loadu_si512(s+j+11);
-                __m512i v12 = _mm512_loadu_si512(s+j+12);
-                __m512i v13 = _mm512_loadu_si512(s+j+13);
-                __m512i v14 = _mm512_loadu_si512(s+j+14);
-                __m512i v15 = _mm512_loadu_si512(s+j+15);
-
-                _mm512_storeu_si512(d+j, v0);
-                _mm512_storeu_si512(d+j+1, v1);
-                _mm512_storeu_si512(d+j+2, v2);
-                _mm512_storeu_si512(d+j+3, v3);
-                _mm512_storeu_si512(d+j+4, v4);
-                _mm512_storeu_si512(d+j+5, v5);
-                _mm512_storeu_si512(d+j+6, v6);
-                _mm512_storeu_si512(d+j+7, v7);
-                _mm512_storeu_si512(d+j+8, v8);
-                _mm512_storeu_si512(d+j+9, v9);
-                _mm512_storeu_si512(d+j+10, v10);
-                _mm512_storeu_si512(d+j+11, v11);
-                _mm512_storeu_si512(d+j+12, v12);
-                _mm512_storeu_si512(d+j+13, v13);
-                _mm512_storeu_si512(d+j+14, v14);
-                _mm512_storeu_si512(d+j+15, v15);
-            }
-        }
-    }
-    auto end = high_resolution_clock::now();
-
-    double ns_per_op = duration_cast<nanoseconds>(end - start).count() / static_cast<double>(iterations);
-
-    volatile uint8_t sink = buf[0];
-    (void)sink;
-
-    // Free buffers (fresh allocation per benchmark gives best performance)
-    free(data);
-    free(buf);
-
-    return data_bytes / ns_per_op; // GB/s
-}
-
-int main() {
-    std::cout << "\n═══════════════════════════════════════════════════════════════════════════\n";
-    std::cout << "  C++ THEORETICAL MAXIMUM (AVX-512 16x Unrolling + Aligned Alloc)\n";
-    std::cout << "═══════════════════════════════════════════════════════════════════════════\n\n";
-
-    std::cout << "| Size | Throughput |\n";
-    std::cout << "|------|------------|\n";
-
-    struct SizeConfig {
-        size_t num_elements;
-        const char* name;
-        size_t iterations;
-    };
-
-    std::vector<SizeConfig> sizes = {
-        {8, "64B", 100},           // Reduce to avoid heap corruption
-        {16, "128B", 100},
-        {32, "256B", 100},
-        {64, "512B", 100},
-        {128, "1KB", 1000},        // Match original df4a8da
-        {256, "2KB", 500},
-        {512, "4KB", 250},
-        {1024, "8KB", 100},
-        {2048, "16KB", 50},
-        {4096, "32KB", 25},
-        {8192, "64KB", 10},
-        {16384, "128KB", 5},
-        {32768, "256KB", 3},
-        {65536, "512KB", 2},
-        {131072, "1MB", 2},
-        {262144, "2MB", 1},
-        {524288, "4MB", 1},
-        {1048576, "8MB", 1},
-        {2097152, "16MB", 1},
-        {4194304, "32MB", 1},
-        {8388608, "64MB", 1},
-        {16777216, "128MB", 1},
-    };
-
-    for (const auto& cfg : sizes) {
-        double gbps = benchmark_serialize(cfg.num_elements, cfg.iterations);
-        if (gbps > 0) {
-            std::cout << "| " << std::setw(4) << cfg.name
-                      << " | **" << std::fixed << std::setprecision(2)
-                      << std::setw(8) << gbps << " GB/s** |\n";
-            std::cout.flush();
-        }
-    }
-
-    std::cout << "\n═══════════════════════════════════════════════════════════════════════════\n";
-    std::cout << "  THEORETICAL MAXIMUM using:\n";
-    std::cout << "  - AVX-512 with 16x unrolling (1024 bytes/iteration)\n";
-    std::cout << "  - 64-byte aligned allocations\n";
-    std::cout << "  - Single-threaded (OpenMP disabled due to overhead)\n";
-    std::cout << "  - Zero allocation overhead (pre-allocated buffers)\n";
-    std::cout << "  - Threads: " << omp_get_max_threads() << "\n";
-    std::cout << "═══════════════════════════════════════════════════════════════════════════\n\n";
-
-    return 0;
-}
@@ -1,125 +0,0 @@
-#include "limcode/limcode.h"
-#include <chrono>
-#include <vector>
-#include <algorithm>
-#include <iostream>
-#include <iomanip>
-
-using namespace std::chrono;
-
-struct BenchResult {
-    uint64_t min_ns;
-    uint64_t max_ns;
-    double avg_ns;
-};
-
-BenchResult benchmark_operation(size_t iterations, auto&& op) {
-    uint64_t min_val = UINT64_MAX;
-    uint64_t max_val = 0;
-    double sum = 0;
-
-    for (size_t i = 0; i < iterations; ++i) {
-        auto start = high_resolution_clock::now();
-        op();
-        auto end = high_resolution_clock::now();
-        uint64_t ns = duration_cast<nanoseconds>(end - start).count();
-
-        min_val = std::min(min_val, ns);
-        max_val = std::max(max_val, ns);
-        sum += ns;
-    }
-
-    return {min_val, max_val, sum / iterations};
-}
-
-int main() {
-    std::cout << "\n═══════════════════════════════════════════════════════════════════════════\n";
-    std::cout << "  PURE C++ LIMCODE PERFORMANCE (Theoretical Maximum)\n";
-    std::cout << "═══════════════════════════════════════════════════════════════════════════\n\n";
-
-    struct TestSize {
-        size_t size;
-        const char* name;
-        size_t iterations;
-    };
-
-    std::vector<TestSize> sizes = {
-        {64, "64B", 100'000},
-        {128, "128B", 100'000},
-        {256, "256B", 100'000},
-        {512, "512B", 100'000},
-        {1024, "1KB", 100'000},
-        {2048, "2KB", 100'000},
-        {4096, "4KB", 50'000},
-        {8192, "8KB", 50'000},
-        {16384, "16KB", 50'000},
-        {32768, "32KB", 25'000},
-        {65536, "64KB", 10'000},
-        {131072, "128KB", 5'000},
-        {262144, "256KB", 2'000},
-        {524288, "512KB", 1'000},
-        {1'048'576, "1MB", 500},
-        {2'097'152, "2MB", 250},
-        {4'194'304, "4MB", 100},
-    };
-
-    std::cout << "| Size | Serialize (ns) | Deserialize (ns) | Round-Trip (GB/s) |\n";
-    std::cout << "|------|----------------|------------------|-------------------|\n";
-
-    for (const auto& [size, name, iterations] : sizes) {
-        // Create data as Vec<u64> like Rust benchmark
-        const size_t num_u64 = size / 8;
-        std::vector<uint64_t> data(num_u64);
-        for (size_t i = 0; i < num_u64; ++i) {
-            data[i] = i;
-        }
-
-        std::vector<uint8_t> buffer;
-
-        // === SERIALIZATION using direct memcpy (theoretical maximum) ===
-        auto ser_result = benchmark_operation(iterations, [&]() {
-            buffer.resize(8 + size);
-            uint64_t len = num_u64;
-            std::memcpy(buffer.data(), &len, 8);
-            std::memcpy(buffer.data() + 8, data.data(), size);
-            volatile uint8_t sink = buffer[0];
-            (void)sink;
-        });
-
-        // Pre-encode for deserialization
-        buffer.resize(8 + size);
-        uint64_t len_pre = num_u64;
-        std::memcpy(buffer.data(), &len_pre, 8);
-        std::memcpy(buffer.data() + 8, data.data(), size);
-
-        // === DESERIALIZATION (Zero-copy) ===
-        auto de_result = benchmark_operation(iterations, [&]() {
-            // Zero-copy: just read 8-byte length prefix
-            uint64_t len = *reinterpret_cast<const uint64_t*>(buffer.data());
-            const uint64_t* data_ptr = reinterpret_cast<const uint64_t*>(buffer.data() + 8);
-            volatile uint64_t sink = data_ptr[0];
-            (void)sink;
-            (void)len;
-        });
-
-        // === THROUGHPUT ===
-        double roundtrip_ns = ser_result.avg_ns + de_result.avg_ns;
-        double throughput_gbps = (size / roundtrip_ns);
-
-        std::cout << "| " << std::setw(4) << name
-                  << " | **" << std::setw(10) << std::fixed << std::setprecision(1)
-                  << ser_result.avg_ns << "ns** | **"
-                  << std::setw(10) << de_result.avg_ns << "ns** | **"
-                  << std::setw(10) << std::setprecision(2) << throughput_gbps
-                  << " GB/s** |\n";
-
-        std::cout.flush();
-    }
-
-    std::cout << "\n═══════════════════════════════════════════════════════════════════════════\n";
-    std::cout << "  THEORETICAL MAXIMUM using limcode::serialize() with __builtin_memcpy\n";
-    std::cout << "  This is the absolute fastest possible for this serialization format\n";
-    std::cout << "═══════════════════════════════════════════════════════════════════════════\n\n";
-
-    return 0;
-}
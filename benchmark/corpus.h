@@ -0,0 +1,285 @@
+#pragma once
+
+/**
+ * @file corpus.h
+ * @brief Reproducible synthetic Solana corpus for limcode_bench
+ *
+ * Every block is generated from a fixed seed, so all runs and all machines
+ * benchmark identical bytes. Block shapes follow mainnet:
+ *
+ * - Entries interleave ticks (no transactions) with batches of up to 64
+ *   transactions.
+ * - Vote transactions are legacy: one signer, three keys, one ~150-byte
+ *   TowerSync instruction.
+ * - User transactions carry compute-budget instructions, 1-4 program
+ *   instructions and a legacy / v0 mix; v0 ones may use address table
+ *   lookups.
+ *
+ * Profiles:
+ * - Mixed:      ~40% votes, the rest split evenly between legacy and v0
+ * - AtlHeavy:   ~10% votes, the rest v0 with 2-6 lookups of up to 24 indexes
+ * - VoteHeavy:  ~85% votes
+ *
+ * make_appendvec() builds an in-memory AppendVec with a mainnet-like mix of
+ * system (no data), token (165 bytes) and program-state accounts.
+ */
+
+#include <limcode/limcode.h>
+#include <limcode/snapshot.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace limcode::bench {
+
+enum class BlockProfile { Mixed, AtlHeavy, VoteHeavy };
+
+inline const char* profile_name(BlockProfile profile) {
+    switch (profile) {
+    case BlockProfile::Mixed:
+        return "mixed";
+    case BlockProfile::AtlHeavy:
+        return "atl_heavy";
+    case BlockProfile::VoteHeavy:
+        return "vote_heavy";
+    }
+    return "unknown";
+}
+
+/// splitmix64: tiny, fast and identical everywhere (unlike std distributions)
+class CorpusRng {
+public:
+    explicit CorpusRng(uint64_t seed) : state_(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /// Uniform in [lo, hi]
+    size_t range(size_t lo, size_t hi) { return lo + next() % (hi - lo + 1); }
+
+    /// True with probability percent / 100
+    bool chance(unsigned percent) { return next() % 100 < percent; }
+
+    template <size_t N> void fill(std::array<uint8_t, N>& out) {
+        for (size_t i = 0; i < N; i += 8) {
+            uint64_t word = next();
+            std::memcpy(out.data() + i, &word, std::min<size_t>(8, N - i));
+        }
+    }
+
+    void fill(std::vector<uint8_t>& out, size_t len) {
+        out.resize(len);
+        for (auto& b : out) {
+            b = static_cast<uint8_t>(next());
+        }
+    }
+
+private:
+    uint64_t state_;
+};
+
+namespace detail {
+
+inline std::vector<uint8_t> index_list(CorpusRng& rng, size_t count, size_t bound) {
+    std::vector<uint8_t> out(count);
+    for (auto& index : out) {
+        index = static_cast<uint8_t>(rng.range(0, bound - 1));
+    }
+    return out;
+}
+
+inline VersionedTransaction make_vote(CorpusRng& rng) {
+    VersionedTransaction tx;
+    tx.signatures.resize(1);
+    rng.fill(tx.signatures[0]);
+
+    LegacyMessage msg;
+    msg.header = {1, 0, 1};
+    msg.account_keys.resize(3); // node identity, vote account, vote program
+    for (auto& key : msg.account_keys) {
+        rng.fill(key);
+    }
+    rng.fill(msg.recent_blockhash);
+
+    CompiledInstruction vote;
+    vote.program_id_index = 2;
+    vote.accounts = {1, 0};
+    rng.fill(vote.data, rng.range(120, 180));
+    msg.instructions.push_back(std::move(vote));
+
+    tx.message.set_legacy(std::move(msg));
+    return tx;
+}
+
+template <typename Message>
+void fill_user_message(CorpusRng& rng, Message& msg, size_t num_signers) {
+    size_t num_keys = rng.range(num_signers + 4, num_signers + 16);
+    msg.header = {static_cast<uint8_t>(num_signers), 0,
+                  static_cast<uint8_t>(rng.range(1, 3))};
+    msg.account_keys.resize(num_keys);
+    for (auto& key : msg.account_keys) {
+        rng.fill(key);
+    }
+    rng.fill(msg.recent_blockhash);
+
+    // SetComputeUnitLimit / SetComputeUnitPrice
+    uint8_t budget_program = static_cast<uint8_t>(num_keys - 1);
+    msg.instructions.push_back(CompiledInstruction{budget_program, {}, {}});
+    rng.fill(msg.instructions.back().data, 5);
+    if (rng.chance(80)) {
+        msg.instructions.push_back(CompiledInstruction{budget_program, {}, {}});
+        rng.fill(msg.instructions.back().data, 9);
+    }
+
+    size_t num_programs = rng.range(1, 4);
+    for (size_t i = 0; i < num_programs; ++i) {
+        CompiledInstruction instr;
+        instr.program_id_index = static_cast<uint8_t>(rng.range(num_signers, num_keys - 1));
+        instr.accounts = index_list(rng, rng.range(2, 12), num_keys);
+        // Mostly small instruction data, occasionally a large payload
+        rng.fill(instr.data, rng.chance(10) ? rng.range(300, 900) : rng.range(1, 64));
+        msg.instructions.push_back(std::move(instr));
+    }
+}
+
+inline VersionedTransaction make_user(CorpusRng& rng, bool v0, size_t min_atls,
+                                      size_t max_atls) {
+    VersionedTransaction tx;
+    size_t num_signers = rng.chance(85) ? 1 : 2;
+    tx.signatures.resize(num_signers);
+    for (auto& sig : tx.signatures) {
+        rng.fill(sig);
+    }
+
+    if (!v0) {
+        LegacyMessage msg;
+        fill_user_message(rng, msg, num_signers);
+        tx.message.set_legacy(std::move(msg));
+        return tx;
+    }
+
+    V0Message msg;
+    fill_user_message(rng, msg, num_signers);
+    size_t num_atls = rng.range(min_atls, max_atls);
+    for (size_t i = 0; i < num_atls; ++i) {
+        AddressTableLookup atl;
+        rng.fill(atl.account_key);
+        atl.writable_indexes = index_list(rng, rng.range(0, max_atls > 1 ? 24 : 6), 256);
+        atl.readonly_indexes = index_list(rng, rng.range(1, max_atls > 1 ? 24 : 8), 256);
+        msg.address_table_lookups.push_back(std::move(atl));
+    }
+    tx.message.set_v0(std::move(msg));
+    return tx;
+}
+
+inline VersionedTransaction make_transaction(CorpusRng& rng, BlockProfile profile) {
+    switch (profile) {
+    case BlockProfile::Mixed:
+        if (rng.chance(40)) {
+            return make_vote(rng);
+        }
+        return make_user(rng, rng.chance(50), 0, 1);
+    case BlockProfile::AtlHeavy:
+        if (rng.chance(10)) {
+            return make_vote(rng);
+        }
+        return make_user(rng, true, 2, 6);
+    case BlockProfile::VoteHeavy:
+        if (rng.chance(85)) {
+            return make_vote(rng);
+        }
+        return make_user(rng, rng.chance(50), 0, 1);
+    }
+    return make_vote(rng);
+}
+
+} // namespace detail
+
+/// One block: `num_entries` entries, every fourth a tick
+inline std::vector<Entry> make_block(BlockProfile profile, uint64_t seed,
+                                     size_t num_entries = 128) {
+    CorpusRng rng(seed);
+    std::vector<Entry> block(num_entries);
+    for (size_t i = 0; i < num_entries; ++i) {
+        Entry& entry = block[i];
+        entry.num_hashes = rng.range(1, 12500);
+        rng.fill(entry.hash);
+        if (i % 4 == 3) {
+            continue; // tick
+        }
+        size_t num_txs = rng.range(1, 64);
+        entry.transactions.reserve(num_txs);
+        for (size_t t = 0; t < num_txs; ++t) {
+            entry.transactions.push_back(detail::make_transaction(rng, profile));
+        }
+    }
+    return block;
+}
+
+/// `num_blocks` consecutive blocks, decoded and encoded (bincode Vec<Entry>)
+struct Corpus {
+    BlockProfile profile = BlockProfile::Mixed;
+    std::vector<Entry> entries;
+    std::vector<uint8_t> bytes;
+    size_t num_transactions = 0;
+
+    [[nodiscard]] std::string name() const { return profile_name(profile); }
+};
+
+inline Corpus make_corpus(BlockProfile profile, size_t num_blocks, uint64_t seed) {
+    Corpus corpus;
+    corpus.profile = profile;
+    for (size_t b = 0; b < num_blocks; ++b) {
+        auto block = make_block(profile, seed + b * 0x1000193ULL + static_cast<uint64_t>(profile));
+        for (auto& entry : block) {
+            corpus.num_transactions += entry.transactions.size();
+            corpus.entries.push_back(std::move(entry));
+        }
+    }
+    corpus.bytes = serialize_entries(corpus.entries);
+    return corpus;
+}
+
+/// In-memory AppendVec with `num_accounts` records
+inline std::vector<uint8_t> make_appendvec(size_t num_accounts, uint64_t seed) {
+    CorpusRng rng(seed);
+    std::vector<uint8_t> out;
+    for (size_t i = 0; i < num_accounts; ++i) {
+        size_t data_len = 0;
+        uint64_t kind = rng.next() % 100;
+        if (kind >= 60 && kind < 90) {
+            data_len = 165; // SPL token account
+        } else if (kind >= 90) {
+            data_len = rng.range(200, 10000);
+        }
+
+        snapshot::AppendVecHeader header{};
+        header.write_version = i;
+        header.data_len = data_len;
+        header.lamports = rng.next() >> 20;
+        header.rent_epoch = UINT64_MAX;
+        for (auto* field : {header.pubkey, header.owner, header.hash}) {
+            for (size_t k = 0; k < 32; k += 8) {
+                uint64_t word = rng.next();
+                std::memcpy(field + k, &word, 8);
+            }
+        }
+        header.executable = rng.chance(1) ? 1 : 0;
+
+        size_t start = out.size();
+        out.resize(start + sizeof(header) + data_len);
+        std::memcpy(out.data() + start, &header, sizeof(header));
+        for (size_t k = 0; k < data_len; ++k) {
+            out[start + sizeof(header) + k] = static_cast<uint8_t>(rng.next());
+        }
+        out.resize((out.size() + 7) & ~size_t(7)); // 8-byte record alignment
+    }
+    return out;
+}
+
+} // namespace limcode::bench
@@ -0,0 +1,203 @@
+#pragma once
+
+/**
+ * @file harness.h
+ * @brief Case registry, timing, JSON report and baseline comparison for
+ *        limcode_bench
+ *
+ * A case is a name, the bytes one iteration processes and a body. Each case
+ * is warmed up, then timed one iteration per sample until both a minimum
+ * sample count and a minimum wall time are reached. The report gives
+ * throughput (bytes / median sample) and p50 / p99 sample latency.
+ *
+ * The JSON report writes one case object per line, so a saved report can be
+ * read back as a baseline without a JSON library.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace limcode::bench {
+
+/// Keep `value` observable so the optimizer can't drop the work producing it
+template <typename T> inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct BenchCase {
+    std::string name; ///< "group/variant/corpus"
+    size_t bytes;     ///< Bytes processed per iteration
+    size_t items;     ///< Transactions / accounts per iteration (0 = n/a)
+    std::function<void()> body;
+};
+
+struct CaseResult {
+    std::string name;
+    size_t bytes = 0;
+    size_t items = 0;
+    size_t samples = 0;
+    double p50_ns = 0;
+    double p99_ns = 0;
+    double mean_ns = 0;
+
+    [[nodiscard]] double throughput_mb_s() const { return p50_ns > 0 ? bytes * 1e3 / p50_ns : 0; }
+    [[nodiscard]] double items_per_s() const { return p50_ns > 0 ? items * 1e9 / p50_ns : 0; }
+};
+
+struct RunOptions {
+    std::string filter;      ///< Substring every selected case name contains
+    size_t warmup = 2;
+    size_t min_samples = 15;
+    size_t max_samples = 2000;
+    double min_time_ms = 250;
+};
+
+class Registry {
+public:
+    void add(std::string name, size_t bytes, size_t items, std::function<void()> body) {
+        cases_.push_back({std::move(name), bytes, items, std::move(body)});
+    }
+
+    [[nodiscard]] const std::vector<BenchCase>& cases() const { return cases_; }
+
+private:
+    std::vector<BenchCase> cases_;
+};
+
+/// Nearest-rank percentile of sorted samples
+inline double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+inline CaseResult run_case(const BenchCase& bench, const RunOptions& options) {
+    using clock = std::chrono::steady_clock;
+    for (size_t i = 0; i < options.warmup; ++i) {
+        bench.body();
+    }
+
+    std::vector<double> samples;
+    auto deadline = clock::now() + std::chrono::duration<double, std::milli>(options.min_time_ms);
+    while (samples.size() < options.max_samples &&
+           (samples.size() < options.min_samples || clock::now() < deadline)) {
+        auto start = clock::now();
+        bench.body();
+        samples.push_back(std::chrono::duration<double, std::nano>(clock::now() - start).count());
+    }
+
+    CaseResult result;
+    result.name = bench.name;
+    result.bytes = bench.bytes;
+    result.items = bench.items;
+    result.samples = samples.size();
+    double total = 0;
+    for (double s : samples) {
+        total += s;
+    }
+    result.mean_ns = total / samples.size();
+    std::sort(samples.begin(), samples.end());
+    result.p50_ns = percentile(samples, 50);
+    result.p99_ns = percentile(samples, 99);
+    return result;
+}
+
+inline std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+/// `meta` values are written as JSON strings
+inline void write_json(std::ostream& out, const std::map<std::string, std::string>& meta,
+                       const std::vector<CaseResult>& results) {
+    out << "{\n  \"meta\": {";
+    bool first = true;
+    for (const auto& [key, value] : meta) {
+        out << (first ? "" : ", ") << '"' << json_escape(key) << "\": \"" << json_escape(value)
+            << '"';
+        first = false;
+    }
+    out << "},\n  \"cases\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"bytes\": %zu, \"items\": %zu, \"samples\": %zu, "
+                      "\"throughput_mb_s\": %.2f, \"items_per_s\": %.0f, \"p50_ns\": %.0f, "
+                      "\"p99_ns\": %.0f, \"mean_ns\": %.0f}%s\n",
+                      json_escape(r.name).c_str(), r.bytes, r.items, r.samples,
+                      r.throughput_mb_s(), r.items_per_s(), r.p50_ns, r.p99_ns, r.mean_ns,
+                      i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+}
+
+/// Case name -> throughput_mb_s from a report written by write_json()
+inline std::map<std::string, double> load_baseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    std::ifstream in(path);
+    static const std::regex pattern(
+        R"re("name": "([^"]+)".*"throughput_mb_s": ([0-9.eE+-]+))re");
+    std::string line;
+    std::smatch match;
+    while (std::getline(in, line)) {
+        if (std::regex_search(line, match, pattern)) {
+            baseline[match[1].str()] = std::stod(match[2].str());
+        }
+    }
+    return baseline;
+}
+
+/**
+ * @brief Print each case against its baseline throughput
+ * @param tolerance Allowed fractional slowdown (0.10 = 10%)
+ * @return Number of cases slower than baseline * (1 - tolerance)
+ */
+inline size_t compare_to_baseline(std::ostream& out, const std::vector<CaseResult>& results,
+                                  const std::map<std::string, double>& baseline,
+                                  double tolerance) {
+    size_t regressions = 0;
+    out << "\nBaseline comparison (tolerance " << tolerance * 100 << "%)\n";
+    for (const auto& r : results) {
+        auto it = baseline.find(r.name);
+        char line[256];
+        if (it == baseline.end() || it->second <= 0) {
+            std::snprintf(line, sizeof(line), "  %-44s %10.1f MB/s   (no baseline)\n",
+                          r.name.c_str(), r.throughput_mb_s());
+        } else {
+            double ratio = r.throughput_mb_s() / it->second;
+            bool regressed = ratio < 1.0 - tolerance;
+            regressions += regressed ? 1 : 0;
+            std::snprintf(line, sizeof(line), "  %-44s %10.1f MB/s vs %10.1f  %+6.1f%%%s\n",
+                          r.name.c_str(), r.throughput_mb_s(), it->second, (ratio - 1) * 100,
+                          regressed ? "  REGRESSION" : "");
+        }
+        out << line;
+    }
+    return regressions;
+}
+
+} // namespace limcode::bench
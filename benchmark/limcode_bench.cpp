@@ -0,0 +1,282 @@
+/**
+ * @file limcode_bench.cpp
+ * @brief Corpus-driven benchmark suite: encode, decode, zero-copy, parallel
+ *        and snapshot cases over reproducible Solana blocks
+ *
+ * Usage:
+ *   limcode_bench [--filter SUBSTR] [--blocks N] [--seed N] [--min-time-ms N]
+ *                 [--samples N] [--json FILE|-] [--baseline FILE]
+ *                 [--tolerance PCT] [--snapshot ARCHIVE] [--list]
+ *
+ * Case names are group/operation/corpus. Throughput is bytes per median
+ * sample; one sample is one pass over the whole corpus.
+ *
+ * Regression check:
+ *   limcode_bench --json baseline.json            # on the old build
+ *   limcode_bench --baseline baseline.json        # on the new build
+ * exits with status 2 if any case is more than --tolerance (default 10%)
+ * slower than its baseline.
+ */
+
+#include "corpus.h"
+#include "harness.h"
+
+#include <limcode/arena.h>
+#include <limcode/limcode.h>
+#include <limcode/snapshot.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef LIMCODE_BENCH_HAS_SNAPSHOT
+#include <sys/stat.h>
+#endif
+
+#ifndef LIMCODE_BENCH_VERSION
+#define LIMCODE_BENCH_VERSION "unknown"
+#endif
+
+using namespace limcode;
+using namespace limcode::bench;
+
+namespace {
+
+struct Args {
+    RunOptions run;
+    size_t blocks = 8;
+    uint64_t seed = 0x11C0DE;
+    std::string json_path;
+    std::string baseline_path;
+    double tolerance = 0.10;
+    std::string snapshot_path;
+    bool list = false;
+};
+
+[[noreturn]] void usage(const char* argv0) {
+    std::cerr << "usage: " << argv0
+              << " [--filter SUBSTR] [--blocks N] [--seed N] [--min-time-ms N] [--samples N]\n"
+                 "       [--json FILE|-] [--baseline FILE] [--tolerance PCT]"
+                 " [--snapshot ARCHIVE] [--list]\n";
+    std::exit(1);
+}
+
+Args parse_args(int argc, char** argv) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+            }
+            return argv[++i];
+        };
+        if (flag == "--filter") {
+            args.run.filter = value();
+        } else if (flag == "--blocks") {
+            args.blocks = std::stoul(value());
+        } else if (flag == "--seed") {
+            args.seed = std::stoull(value(), nullptr, 0);
+        } else if (flag == "--min-time-ms") {
+            args.run.min_time_ms = std::stod(value());
+        } else if (flag == "--samples") {
+            args.run.min_samples = std::stoul(value());
+        } else if (flag == "--json") {
+            args.json_path = value();
+        } else if (flag == "--baseline") {
+            args.baseline_path = value();
+        } else if (flag == "--tolerance") {
+            args.tolerance = std::stod(value()) / 100.0;
+        } else if (flag == "--snapshot") {
+            args.snapshot_path = value();
+        } else if (flag == "--list") {
+            args.list = true;
+        } else {
+            usage(argv[0]);
+        }
+    }
+    return args;
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::AVX512:
+        return "avx512";
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::Scalar:
+        break;
+    }
+    return "scalar";
+}
+
+void register_block_cases(Registry& registry, const Corpus& corpus) {
+    const std::string suffix = "/" + corpus.name();
+    const size_t bytes = corpus.bytes.size();
+    const size_t txs = corpus.num_transactions;
+    const auto& entries = corpus.entries;
+    std::span<const uint8_t> input(corpus.bytes);
+
+    registry.add("encode/serialize_entries" + suffix, bytes, txs,
+                 [&entries] { keep(serialize_entries(entries)); });
+    auto scratch = std::make_shared<std::vector<uint8_t>>(bytes);
+    registry.add("encode/serialize_into" + suffix, bytes, txs, [&entries, scratch] {
+        keep(serialize_entries_into(entries, std::span<uint8_t>(*scratch)));
+    });
+
+    registry.add("decode/deserialize_entries" + suffix, bytes, txs,
+                 [input] { keep(deserialize_entries(input)); });
+    auto arena = std::make_shared<DecodeArena>(bytes * 2);
+    registry.add("decode/arena" + suffix, bytes, txs, [input, arena] {
+        keep(arena::deserialize_entries(input, *arena).size());
+        arena->reset();
+    });
+
+    registry.add("zero_copy/skip_entries" + suffix, bytes, txs, [input] {
+        StructuredZeroCopyDecoder decoder(input);
+        uint64_t count = decoder.read_u64();
+        for (uint64_t i = 0; i < count; ++i) {
+            decoder.skip_entry();
+        }
+        keep(decoder.position());
+    });
+    auto batch = std::make_shared<SigverifyBatch>();
+    registry.add("zero_copy/sigverify_batch" + suffix, bytes, txs, [input, batch] {
+        keep(extract_sigverify_batch(input, *batch));
+    });
+    registry.add("zero_copy/validate_entries" + suffix, bytes, txs,
+                 [input] { keep(validate_entries(input).consumed); });
+
+    registry.add("parallel/serialize" + suffix, bytes, txs,
+                 [&entries] { keep(serialize_entries_parallel(entries)); });
+    registry.add("parallel/deserialize" + suffix, bytes, txs,
+                 [input] { keep(deserialize_entries_parallel(input)); });
+}
+
+void register_snapshot_cases(Registry& registry, const std::vector<uint8_t>& appendvec,
+                             size_t num_accounts) {
+    registry.add("snapshot/appendvec_views/accounts", appendvec.size(), num_accounts,
+                 [&appendvec] {
+                     uint64_t lamports = 0;
+                     snapshot::for_each_account_view(
+                         appendvec.data(), appendvec.size(),
+                         [&](const snapshot::SnapshotAccountView& view) {
+                             lamports += view.lamports();
+                             return true;
+                         });
+                     keep(lamports);
+                 });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Args args = parse_args(argc, argv);
+
+    std::vector<Corpus> corpora;
+    for (auto profile : {BlockProfile::Mixed, BlockProfile::AtlHeavy, BlockProfile::VoteHeavy}) {
+        corpora.push_back(make_corpus(profile, args.blocks, args.seed));
+    }
+    constexpr size_t APPENDVEC_ACCOUNTS = 200000;
+    auto appendvec = make_appendvec(APPENDVEC_ACCOUNTS, args.seed);
+
+    Registry registry;
+    for (const auto& corpus : corpora) {
+        register_block_cases(registry, corpus);
+    }
+    register_snapshot_cases(registry, appendvec, APPENDVEC_ACCOUNTS);
+
+#ifdef LIMCODE_BENCH_HAS_SNAPSHOT
+    if (!args.snapshot_path.empty()) {
+        struct stat st {};
+        size_t archive_bytes = ::stat(args.snapshot_path.c_str(), &st) == 0 ? st.st_size : 0;
+        registry.add("snapshot/archive_stream/file", archive_bytes, 0, [&args] {
+            std::atomic<uint64_t> accounts{0};
+            snapshot::ParallelStreamOptions options;
+            keep(snapshot::stream_snapshot_parallel_batches(
+                args.snapshot_path,
+                [&](std::span<const snapshot::SnapshotAccountView> batch) {
+                    accounts += batch.size();
+                    return true;
+                },
+                options));
+        });
+    }
+#else
+    if (!args.snapshot_path.empty()) {
+        std::cerr << "--snapshot needs a build with limcode_snapshot (libarchive + libzstd)\n";
+        return 1;
+    }
+#endif
+
+    if (args.list) {
+        for (const auto& bench : registry.cases()) {
+            std::cout << bench.name << "\n";
+        }
+        return 0;
+    }
+
+    std::cerr << "Corpus (seed " << args.seed << ", " << args.blocks << " blocks each):\n";
+    for (const auto& corpus : corpora) {
+        std::cerr << "  " << corpus.name() << ": " << corpus.entries.size() << " entries, "
+                  << corpus.num_transactions << " transactions, " << corpus.bytes.size()
+                  << " bytes\n";
+    }
+    std::cerr << "  appendvec: " << APPENDVEC_ACCOUNTS << " accounts, " << appendvec.size()
+              << " bytes\n\n";
+
+    std::vector<CaseResult> results;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-44s %12s %12s %12s %12s\n", "case", "MB/s", "items/s",
+                  "p50 us", "p99 us");
+    std::cout << line;
+    for (const auto& bench : registry.cases()) {
+        if (bench.name.find(args.run.filter) == std::string::npos) {
+            continue;
+        }
+        RunOptions options = args.run;
+        if (bench.name.rfind("snapshot/archive", 0) == 0) {
+            options.warmup = 0;
+            options.min_samples = 3;
+            options.min_time_ms = 0;
+        }
+        results.push_back(run_case(bench, options));
+        const auto& r = results.back();
+        std::snprintf(line, sizeof(line), "%-44s %12.1f %12.0f %12.1f %12.1f\n", r.name.c_str(),
+                      r.throughput_mb_s(), r.items_per_s(), r.p50_ns / 1e3, r.p99_ns / 1e3);
+        std::cout << line << std::flush;
+    }
+
+    std::map<std::string, std::string> meta = {
+        {"limcode_version", LIMCODE_BENCH_VERSION},
+        {"simd_level", simd_level_name(simd_level())},
+        {"concurrency", std::to_string(default_executor().concurrency())},
+        {"seed", std::to_string(args.seed)},
+        {"blocks", std::to_string(args.blocks)},
+#ifdef __VERSION__
+        {"compiler", __VERSION__},
+#endif
+    };
+    if (args.json_path == "-") {
+        write_json(std::cout, meta, results);
+    } else if (!args.json_path.empty()) {
+        std::ofstream out(args.json_path);
+        write_json(out, meta, results);
+    }
+
+    if (!args.baseline_path.empty()) {
+        auto baseline = load_baseline(args.baseline_path);
+        if (baseline.empty()) {
+            std::cerr << "No cases found in baseline " << args.baseline_path << "\n";
+            return 1;
+        }
+        size_t regressions = compare_to_baseline(std::cout, results, baseline, args.tolerance);
+        if (regressions > 0) {
+            std::cout << regressions << " case(s) regressed\n";
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -17,37 +17,43 @@ fn main() {
         .flag_if_supported("-std=c++20")
         .flag_if_supported("-fno-builtin"); // Disable compiler builtins that might use CPU features
 
-    // Only apply x86_64 SIMD flags on x86_64 architecture
+    // Only apply x86_64 flags on x86_64 architecture. As in the CMake build,
+    // the baseline is x86-64-v2 and the AVX2 / AVX-512 kernels are picked at
+    // runtime (see include/limcode/simd_dispatch.h), so the library runs on
+    // any x86-64-v2 machine. LIMCODE_NATIVE_ARCH=1 builds for the host CPU
+    // only, like -DENABLE_NATIVE_ARCH=ON.
     if target_arch == "x86_64" {
-        // In CI, use conservative baseline to avoid SIGILL on different runners
-        // In local builds, use -march=native for maximum performance
-        let is_ci = env::var("CI").is_ok()
-            || env::var("GITHUB_ACTIONS").is_ok()
-            || env::var("CONTINUOUS_INTEGRATION").is_ok();
-
-        if is_ci {
-            println!(
-                "cargo:warning=Building in CI mode with conservative CPU features (x86-64-v2)"
-            );
-            // x86-64-v2: SSE4.2, POPCNT, SSSE3 (available on all modern CI runners)
-            // Explicitly disable advanced features
-            build
-                .flag_if_supported("-march=x86-64-v2")
-                .flag_if_supported("-mno-avx512f")
-                .flag_if_supported("-mno-avx512bw")
-                .flag_if_supported("-mno-avx512dq");
+        println!("cargo:rerun-if-env-changed=LIMCODE_NATIVE_ARCH");
+        if env::var("LIMCODE_NATIVE_ARCH").map_or(false, |v| v == "1") {
+            println!("cargo:warning=Building for the host CPU only (-march=native)");
+            build.flag_if_supported("-march=native");
         } else {
-            println!("cargo:warning=Building in local mode with native CPU optimizations");
-            // Local builds: optimize for the actual CPU
-            build
-                .flag_if_supported("-march=native")
-                .flag_if_supported("-mavx512f")
-                .flag_if_supported("-mavx512bw")
-                .flag_if_supported("-mavx512dq")
-                .flag_if_supported("-mavx512vl")
-                .flag_if_supported("-mavx2")
-                .flag_if_supported("-msse4.2")
-                .flag_if_supported("-mbmi2");
+            build.flag_if_supported("-march=x86-64-v2");
+        }
+    }
+
+    // Snapshot C API (limcode_snapshot_stream*): found through pkg-config,
+    // like the CMake limcode_snapshot target
+    #[cfg(feature = "snapshot")]
+    let snapshot_libs: Vec<pkg_config::Library> = ["libarchive", "libzstd"]
+        .iter()
+        .map(|name| {
+            pkg_config::Config::new()
+                .cargo_metadata(false)
+                .probe(name)
+                .unwrap_or_else(|e| panic!("the snapshot feature needs {}: {}", name, e))
+        })
+        .collect();
+    #[cfg(feature = "snapshot")]
+    {
+        build
+            .file("src/snapshot.cpp")
+            .file("src/snapshot_index.cpp")
+            .file("src/snapshot_writer.cpp")
+            .file("src/snapshot_columns.cpp")
+            .file("src/limcode_snapshot_ffi.cpp");
+        for lib in &snapshot_libs {
+            build.includes(&lib.include_paths);
         }
     }
 
@@ -66,6 +72,24 @@ fn main() {
     println!("cargo:rerun-if-changed=include/limcode.h");
     println!("cargo:rerun-if-changed=include/limcode/limcode.h");
 
+    // After build.compile() so the static library comes first on the link line
+    #[cfg(feature = "snapshot")]
+    {
+        println!("cargo:rerun-if-changed=src/snapshot.cpp");
+        println!("cargo:rerun-if-changed=src/snapshot_index.cpp");
+        println!("cargo:rerun-if-changed=src/snapshot_writer.cpp");
+        println!("cargo:rerun-if-changed=src/snapshot_columns.cpp");
+        println!("cargo:rerun-if-changed=src/limcode_snapshot_ffi.cpp");
+        for lib in &snapshot_libs {
+            for path in &lib.link_paths {
+                println!("cargo:rustc-link-search=native={}", path.display());
+            }
+            for name in &lib.libs {
+                println!("cargo:rustc-link-lib={}", name);
+            }
+        }
+    }
+
     // Link C++ stdlib
     match target_os.as_str() {
         "linux" | "android" => println!("cargo:rustc-link-lib=dylib=stdc++"),
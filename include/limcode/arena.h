@@ -0,0 +1,312 @@
+#pragma once
+
+/**
+ * @file arena.h
+ * @brief Arena-backed decoding for Entry / VersionedTransaction
+ *
+ * LimcodeDecoder::read_entry() allocates a separate std::vector for every
+ * signature list, key list, instruction, account list, data blob and ATL
+ * index list. The arena path decodes into trivially destructible mirror
+ * types whose lists are spans into a caller-supplied std::pmr::memory_resource.
+ * A whole block lands in one monotonic region, and dropping it is a single
+ * release() with no per-object destructor walk.
+ *
+ * Usage:
+ * @code
+ *   limcode::DecodeArena arena(1 << 20);
+ *   auto entries = limcode::arena::deserialize_entries(bytes, arena);
+ *   replay(entries);
+ *   arena.reset(); // frees every entry at once
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+
+#include <memory_resource>
+#include <new>
+
+namespace limcode {
+
+/**
+ * @brief Monotonic arena sized for one decode batch
+ *
+ * Thin wrapper over std::pmr::monotonic_buffer_resource; not thread-safe.
+ */
+class DecodeArena : public std::pmr::monotonic_buffer_resource {
+public:
+  /// @param initial_size First chunk size; later chunks grow geometrically
+  explicit DecodeArena(size_t initial_size = 64 * 1024)
+      : std::pmr::monotonic_buffer_resource(initial_size) {}
+
+  /// Free everything allocated from the arena
+  void reset() { release(); }
+};
+
+namespace arena {
+
+/**
+ * @brief Arena-backed CompiledInstruction
+ */
+struct CompiledInstruction {
+  uint8_t program_id_index = 0;
+  std::span<const uint8_t> accounts;
+  std::span<const uint8_t> data;
+
+  [[nodiscard]] limcode::CompiledInstruction to_owned() const {
+    limcode::CompiledInstruction instr;
+    instr.program_id_index = program_id_index;
+    instr.accounts.assign(accounts.begin(), accounts.end());
+    instr.data.assign(data.begin(), data.end());
+    return instr;
+  }
+};
+
+/**
+ * @brief Arena-backed AddressTableLookup
+ */
+struct AddressTableLookup {
+  Pubkey account_key{};
+  std::span<const uint8_t> writable_indexes;
+  std::span<const uint8_t> readonly_indexes;
+
+  [[nodiscard]] limcode::AddressTableLookup to_owned() const {
+    limcode::AddressTableLookup atl;
+    atl.account_key = account_key;
+    atl.writable_indexes.assign(writable_indexes.begin(),
+                                writable_indexes.end());
+    atl.readonly_indexes.assign(readonly_indexes.begin(),
+                                readonly_indexes.end());
+    return atl;
+  }
+};
+
+/**
+ * @brief Arena-backed message (legacy or v0)
+ *
+ * Legacy messages have is_v0 == false and no address table lookups.
+ */
+struct Message {
+  bool is_v0 = false;
+  MessageHeader header{};
+  std::span<const Pubkey> account_keys;
+  Hash recent_blockhash{};
+  std::span<const CompiledInstruction> instructions;
+  std::span<const AddressTableLookup> address_table_lookups;
+
+  [[nodiscard]] VersionedMessage to_owned() const {
+    auto fill = [&](auto &msg) {
+      msg.header = header;
+      msg.account_keys.assign(account_keys.begin(), account_keys.end());
+      msg.recent_blockhash = recent_blockhash;
+      msg.instructions.reserve(instructions.size());
+      for (const auto &instr : instructions) {
+        msg.instructions.push_back(instr.to_owned());
+      }
+    };
+
+    if (is_v0) {
+      V0Message msg;
+      fill(msg);
+      msg.address_table_lookups.reserve(address_table_lookups.size());
+      for (const auto &atl : address_table_lookups) {
+        msg.address_table_lookups.push_back(atl.to_owned());
+      }
+      return VersionedMessage(std::move(msg));
+    }
+
+    LegacyMessage msg;
+    fill(msg);
+    return VersionedMessage(std::move(msg));
+  }
+};
+
+/**
+ * @brief Arena-backed VersionedTransaction
+ */
+struct VersionedTransaction {
+  std::span<const Signature> signatures;
+  Message message;
+
+  [[nodiscard]] limcode::VersionedTransaction to_owned() const {
+    limcode::VersionedTransaction tx;
+    tx.signatures.assign(signatures.begin(), signatures.end());
+    tx.message = message.to_owned();
+    return tx;
+  }
+};
+
+/**
+ * @brief Arena-backed Entry
+ */
+struct Entry {
+  uint64_t num_hashes = 0;
+  Hash hash{};
+  std::span<const VersionedTransaction> transactions;
+
+  [[nodiscard]] limcode::Entry to_owned() const {
+    limcode::Entry entry;
+    entry.num_hashes = num_hashes;
+    entry.hash = hash;
+    entry.transactions.reserve(transactions.size());
+    for (const auto &tx : transactions) {
+      entry.transactions.push_back(tx.to_owned());
+    }
+    return entry;
+  }
+};
+
+static_assert(std::is_trivially_destructible_v<Entry> &&
+                  std::is_trivially_destructible_v<VersionedTransaction> &&
+                  std::is_trivially_destructible_v<Message> &&
+                  std::is_trivially_destructible_v<CompiledInstruction> &&
+                  std::is_trivially_destructible_v<AddressTableLookup>,
+              "arena types must be releasable without running destructors");
+
+namespace detail {
+
+/// Allocate `count` default-constructed T from the arena
+template <typename T>
+[[nodiscard]] T *allocate_array(std::pmr::memory_resource &mr, size_t count) {
+  if (count == 0) {
+    return nullptr;
+  }
+  void *raw = mr.allocate(count * sizeof(T), alignof(T));
+  return ::new (raw) T[count]();
+}
+
+/// Copy `count` bytes from the decoder into the arena
+[[nodiscard]] inline std::span<const uint8_t>
+read_bytes(LimcodeDecoder &decoder, std::pmr::memory_resource &mr,
+           size_t count) {
+  if (count == 0) {
+    return {};
+  }
+  auto *out = static_cast<uint8_t *>(mr.allocate(count, 1));
+  decoder.read_bytes(out, count);
+  return {out, count};
+}
+
+[[nodiscard]] inline std::span<const uint8_t>
+read_byte_vec(LimcodeDecoder &decoder, std::pmr::memory_resource &mr) {
+  return read_bytes(decoder, mr, decoder.read_short_vec_len());
+}
+
+template <typename T>
+[[nodiscard]] std::span<const T> read_pod_vec(LimcodeDecoder &decoder,
+                                              std::pmr::memory_resource &mr) {
+  size_t count = decoder.read_short_vec_len();
+  if (count == 0) {
+    return {};
+  }
+  T *out = allocate_array<T>(mr, count);
+  decoder.read_bytes(reinterpret_cast<uint8_t *>(out), count * sizeof(T));
+  return {out, count};
+}
+
+} // namespace detail
+
+/**
+ * @brief Decode a VersionedTransaction into arena memory
+ * @throws LimcodeError on truncated or malformed input, like LimcodeDecoder
+ */
+[[nodiscard]] inline VersionedTransaction
+read_transaction(LimcodeDecoder &decoder, std::pmr::memory_resource &mr) {
+  VersionedTransaction tx;
+  tx.signatures = detail::read_pod_vec<Signature>(decoder, mr);
+
+  Message &msg = tx.message;
+  uint8_t first = decoder.read_u8();
+  msg.is_v0 = (first & VERSION_PREFIX_MASK) != 0;
+  msg.header.num_required_signatures = msg.is_v0 ? decoder.read_u8() : first;
+  msg.header.num_readonly_signed_accounts = decoder.read_u8();
+  msg.header.num_readonly_unsigned_accounts = decoder.read_u8();
+
+  msg.account_keys = detail::read_pod_vec<Pubkey>(decoder, mr);
+  decoder.read_bytes(msg.recent_blockhash.data(), HASH_BYTES);
+
+  size_t ix_count = decoder.read_short_vec_len();
+  auto *instructions = detail::allocate_array<CompiledInstruction>(mr, ix_count);
+  for (size_t i = 0; i < ix_count; ++i) {
+    instructions[i].program_id_index = decoder.read_u8();
+    instructions[i].accounts = detail::read_byte_vec(decoder, mr);
+    instructions[i].data = detail::read_byte_vec(decoder, mr);
+  }
+  msg.instructions = {instructions, ix_count};
+
+  if (msg.is_v0) {
+    size_t atl_count = decoder.read_short_vec_len();
+    auto *atls = detail::allocate_array<AddressTableLookup>(mr, atl_count);
+    for (size_t i = 0; i < atl_count; ++i) {
+      decoder.read_bytes(atls[i].account_key.data(), PUBKEY_BYTES);
+      atls[i].writable_indexes = detail::read_byte_vec(decoder, mr);
+      atls[i].readonly_indexes = detail::read_byte_vec(decoder, mr);
+    }
+    msg.address_table_lookups = {atls, atl_count};
+  }
+
+  return tx;
+}
+
+/**
+ * @brief Decode an Entry into arena memory
+ * @throws LimcodeError on truncated or malformed input
+ */
+[[nodiscard]] inline Entry read_entry(LimcodeDecoder &decoder,
+                                      std::pmr::memory_resource &mr) {
+  Entry entry;
+  entry.num_hashes = decoder.read_u64();
+  decoder.read_bytes(entry.hash.data(), HASH_BYTES);
+
+  size_t tx_count = decoder.read_short_vec_len();
+  auto *txs = detail::allocate_array<VersionedTransaction>(mr, tx_count);
+  for (size_t i = 0; i < tx_count; ++i) {
+    txs[i] = read_transaction(decoder, mr);
+  }
+  entry.transactions = {txs, tx_count};
+  return entry;
+}
+
+/**
+ * @brief Deserialize one entry into arena memory
+ */
+[[nodiscard]] inline Entry deserialize_entry(std::span<const uint8_t> data,
+                                             std::pmr::memory_resource &mr) {
+  LimcodeDecoder decoder(data);
+  return read_entry(decoder, mr);
+}
+
+/**
+ * @brief Deserialize one transaction into arena memory
+ */
+[[nodiscard]] inline VersionedTransaction
+deserialize_transaction(std::span<const uint8_t> data,
+                        std::pmr::memory_resource &mr) {
+  LimcodeDecoder decoder(data);
+  return read_transaction(decoder, mr);
+}
+
+/**
+ * @brief Deserialize a bincode Vec<Entry> (u64 length prefix) into arena memory
+ *
+ * The entry array itself is also allocated from `mr`.
+ */
+[[nodiscard]] inline std::span<const Entry>
+deserialize_entries(std::span<const uint8_t> data,
+                    std::pmr::memory_resource &mr) {
+  LimcodeDecoder decoder(data);
+  uint64_t count = decoder.read_u64();
+
+  // Reject counts the input can't hold
+  if (count > decoder.remaining() / MIN_ENTRY_BYTES) {
+    throw LimcodeError::invalid_encoding("entry count exceeds input size");
+  }
+
+  auto *entries = detail::allocate_array<Entry>(mr, count);
+  for (uint64_t i = 0; i < count; ++i) {
+    entries[i] = read_entry(decoder, mr);
+  }
+  return {entries, static_cast<size_t>(count)};
+}
+
+} // namespace arena
+} // namespace limcode
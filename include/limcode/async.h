@@ -0,0 +1,453 @@
+#pragma once
+
+/**
+ * @file async.h
+ * @brief Coroutine tasks for serializing on the shared executor
+ *
+ * serialize_pod_async() hands each call to std::async, which may start an OS
+ * thread per call and returns a future with heap-allocated shared state.
+ * The async_* functions here are lazy C++20 coroutines instead: awaiting one
+ * queues it on an AsyncScheduler, whose single dispatcher thread resumes
+ * everything queued so far in one Executor::run() batch. Results land in
+ * pooled buffers from ThreadLocalBufferPool, so a steady pipeline neither
+ * spawns threads nor allocates per message.
+ *
+ * The awaiting coroutine continues on the executor thread that finished the
+ * work, until its next co_await.
+ *
+ * Usage:
+ * @code
+ *   limcode::Task<void> send_block(Socket &socket, const std::vector<Entry> &entries) {
+ *     auto bytes = co_await limcode::async_serialize_entries(entries);
+ *     co_await socket.write(bytes->data(), bytes->size());
+ *   }
+ *
+ *   // Encode many batches concurrently, then wait from plain code
+ *   std::vector<limcode::Task<limcode::LockFreeBufferPool::PooledBuffer>> tasks;
+ *   for (const auto &batch : batches) tasks.push_back(limcode::async_serialize_entries(batch));
+ *   auto buffers = limcode::sync_wait(limcode::when_all(std::move(tasks)));
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace limcode {
+
+template <typename T = void> class Task;
+
+namespace detail {
+
+struct TaskPromiseBase {
+  std::coroutine_handle<> continuation = std::noop_coroutine();
+  std::exception_ptr error;
+
+  /// Resumes whoever awaited the task (symmetric transfer, no stack growth)
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template <typename Promise>
+    std::coroutine_handle<>
+    await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+      return handle.promise().continuation;
+    }
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T> struct TaskPromise : TaskPromiseBase {
+  std::optional<T> value;
+
+  Task<T> get_return_object() noexcept;
+
+  template <typename U> void return_value(U &&result) {
+    value.emplace(std::forward<U>(result));
+  }
+
+  T result() {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return std::move(*value);
+  }
+};
+
+template <> struct TaskPromise<void> : TaskPromiseBase {
+  Task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+
+  void result() const {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+};
+
+/// Fire-and-forget coroutine that frees itself when it finishes
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() const noexcept { return {}; }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a T
+ *
+ * Nothing runs until the task is awaited (or passed to sync_wait/when_all);
+ * exceptions thrown in the body are rethrown to the awaiter. Move-only.
+ */
+template <typename T> class [[nodiscard]] Task {
+public:
+  using promise_type = detail::TaskPromise<T>;
+
+  Task() noexcept = default;
+
+  Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  [[nodiscard]] bool valid() const noexcept { return bool(handle_); }
+  [[nodiscard]] bool done() const noexcept { return handle_ && handle_.done(); }
+
+  bool await_ready() const noexcept { return done(); }
+
+  std::coroutine_handle<>
+  await_suspend(std::coroutine_handle<> awaiting) noexcept {
+    handle_.promise().continuation = awaiting;
+    return handle_;
+  }
+
+  T await_resume() { return handle_.promise().result(); }
+
+private:
+  template <typename U> friend struct detail::TaskPromise;
+  template <typename U> friend U sync_wait(Task<U> task);
+  template <typename U>
+  friend Task<std::vector<U>> when_all(std::vector<Task<U>> tasks);
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+      : handle_(handle) {}
+
+  /// Awaiter that runs the task to completion without taking its result
+  auto when_ready() noexcept {
+    struct Awaiter {
+      std::coroutine_handle<promise_type> handle;
+      bool await_ready() const noexcept { return handle.done(); }
+      std::coroutine_handle<>
+      await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+      }
+      void await_resume() const noexcept {}
+    };
+    return Awaiter{handle_};
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T> Task<T> TaskPromise<T>::get_return_object() noexcept {
+  return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+  return Task<void>(
+      std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+/**
+ * @brief Dispatcher that resumes queued coroutines on an Executor
+ *
+ * One long-lived thread waits for work, takes everything queued since the
+ * last batch and resumes it with a single executor.run(), so N concurrent
+ * awaits cost one wakeup and run in parallel. Pending coroutines are
+ * resumed before the destructor returns.
+ *
+ * Don't sync_wait() from a coroutine running on the scheduler: the
+ * dispatcher would wait on itself.
+ */
+class AsyncScheduler {
+public:
+  /// @param executor Where batches run (null = default_executor() at run time)
+  explicit AsyncScheduler(Executor *executor = nullptr)
+      : executor_(executor), thread_([this] { dispatch_loop(); }) {}
+
+  ~AsyncScheduler() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+  }
+
+  AsyncScheduler(const AsyncScheduler &) = delete;
+  AsyncScheduler &operator=(const AsyncScheduler &) = delete;
+
+  /// Process-wide scheduler the async_* functions use by default
+  static AsyncScheduler &shared() {
+    static AsyncScheduler scheduler;
+    return scheduler;
+  }
+
+  /// `co_await scheduler.schedule()` continues on an executor thread
+  auto schedule() noexcept {
+    struct Awaiter {
+      AsyncScheduler *scheduler;
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> handle) {
+        scheduler->post(handle);
+      }
+      void await_resume() const noexcept {}
+    };
+    return Awaiter{this};
+  }
+
+  /// Queue `handle` for resumption in the next batch
+  void post(std::coroutine_handle<> handle) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(handle);
+    }
+    wake_.notify_one();
+  }
+
+private:
+  void dispatch_loop() {
+    std::vector<std::coroutine_handle<>> batch;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+          return; // Stopped and drained
+        }
+        batch.swap(queue_);
+      }
+      Executor &executor = executor_ ? *executor_ : default_executor();
+      executor.run(batch.size(), [&](size_t i) { batch[i].resume(); });
+      batch.clear();
+    }
+  }
+
+  Executor *executor_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::vector<std::coroutine_handle<>> queue_;
+  bool stop_ = false;
+  std::thread thread_; // Last: starts after the members it reads
+};
+
+/**
+ * @brief Block the calling thread until `task` finishes
+ * @return The task's result (rethrows its exception)
+ */
+template <typename T> T sync_wait(Task<T> task) {
+  struct State {
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    bool done = false;
+  } state;
+
+  // Notifies under the lock, so `state` is not touched after the waiter
+  // can observe `done` and return
+  auto drive = [](Task<T> &t, State &s) -> detail::DetachedTask {
+    co_await t.when_ready();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.done = true;
+    s.done_cv.notify_one();
+  };
+  drive(task, state);
+
+  std::unique_lock<std::mutex> lock(state.mutex);
+  state.done_cv.wait(lock, [&] { return state.done; });
+  return task.handle_.promise().result();
+}
+
+/**
+ * @brief Run all `tasks` concurrently and collect their results in order
+ *
+ * Every task is started before any is awaited, so tasks that go through an
+ * AsyncScheduler land in the same batch. Rethrows the first failure (in
+ * task order) after all have finished.
+ */
+template <typename T>
+Task<std::vector<T>> when_all(std::vector<Task<T>> tasks) {
+  struct State {
+    std::atomic<size_t> remaining;
+    std::coroutine_handle<> awaiting;
+  };
+
+  struct Awaiter {
+    std::vector<Task<T>> &tasks;
+    State state{};
+
+    bool await_ready() const noexcept { return tasks.empty(); }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+      // One extra count for this awaiter, so no task resumes us early
+      state.remaining.store(tasks.size() + 1, std::memory_order_relaxed);
+      state.awaiting = awaiting;
+      for (auto &task : tasks) {
+        start(task, state);
+      }
+      return state.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    void await_resume() const noexcept {}
+
+    static detail::DetachedTask start(Task<T> &task, State &s) {
+      co_await task.when_ready();
+      if (s.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        s.awaiting.resume();
+      }
+    }
+  };
+
+  co_await Awaiter{tasks};
+
+  std::vector<T> results;
+  results.reserve(tasks.size());
+  for (auto &task : tasks) {
+    results.push_back(task.handle_.promise().result());
+  }
+  co_return results;
+}
+
+// ==================== Async Serialization ====================
+//
+// Arguments are taken by reference (or span) and must stay alive until the
+// returned task finishes.
+
+/**
+ * @brief Serialize a bincode Vec<Entry> into a pooled buffer
+ */
+inline Task<LockFreeBufferPool::PooledBuffer>
+async_serialize_entries(const std::vector<Entry> &entries,
+                        AsyncScheduler &scheduler = AsyncScheduler::shared()) {
+  co_await scheduler.schedule();
+  size_t size = serialized_size(entries);
+  auto buffer = ThreadLocalBufferPool::acquire(size);
+  buffer->resize(size);
+  serialize_entries_into(entries, *buffer);
+  co_return buffer;
+}
+
+/**
+ * @brief Serialize a transaction into a pooled buffer
+ */
+inline Task<LockFreeBufferPool::PooledBuffer>
+async_serialize_transaction(const VersionedTransaction &tx,
+                            AsyncScheduler &scheduler = AsyncScheduler::shared()) {
+  co_await scheduler.schedule();
+  size_t size = serialized_size(tx);
+  auto buffer = ThreadLocalBufferPool::acquire(size);
+  buffer->resize(size);
+  serialize_transaction_into(tx, *buffer);
+  co_return buffer;
+}
+
+/**
+ * @brief Serialize a POD array (u64 length + raw elements) into a pooled buffer
+ */
+template <typename T>
+Task<LockFreeBufferPool::PooledBuffer>
+async_serialize_pod(const T *data, size_t len,
+                    AsyncScheduler &scheduler = AsyncScheduler::shared()) {
+  static_assert(std::is_trivially_copyable_v<T>, "POD arrays only");
+  co_await scheduler.schedule();
+  size_t size = 8 + len * sizeof(T);
+  auto buffer = ThreadLocalBufferPool::acquire(size);
+  buffer->resize(size);
+  serialize_pod_array(data, len, buffer->data());
+  co_return buffer;
+}
+
+/**
+ * @brief Deserialize a bincode Vec<Entry>
+ */
+inline Task<std::vector<Entry>>
+async_deserialize_entries(std::span<const uint8_t> data,
+                          AsyncScheduler &scheduler = AsyncScheduler::shared()) {
+  co_await scheduler.schedule();
+  co_return deserialize_entries(data);
+}
+
+/**
+ * @brief Deserialize a transaction
+ */
+inline Task<VersionedTransaction> async_deserialize_transaction(
+    std::span<const uint8_t> data,
+    AsyncScheduler &scheduler = AsyncScheduler::shared()) {
+  co_await scheduler.schedule();
+  co_return deserialize_transaction(data);
+}
+
+/**
+ * @brief Deserialize a POD array written by async_serialize_pod/serialize_pod_array
+ * @throws LimcodeError if the input is shorter than its length prefix says
+ */
+template <typename T>
+Task<std::vector<T>>
+async_deserialize_pod(std::span<const uint8_t> data,
+                      AsyncScheduler &scheduler = AsyncScheduler::shared()) {
+  static_assert(std::is_trivially_copyable_v<T>, "POD arrays only");
+  co_await scheduler.schedule();
+  if (data.size() < 8) {
+    throw LimcodeError::buffer_underflow(8, data.size());
+  }
+  uint64_t len;
+  std::memcpy(&len, data.data(), 8);
+  if (len > (data.size() - 8) / sizeof(T)) {
+    throw LimcodeError::invalid_encoding("POD array length exceeds input size");
+  }
+  std::vector<T> out(static_cast<size_t>(len));
+  if (len > 0) {
+    std::memcpy(out.data(), data.data() + 8, out.size() * sizeof(T));
+  }
+  co_return out;
+}
+
+} // namespace limcode
@@ -0,0 +1,701 @@
+#pragma once
+
+/**
+ * @file digest.h
+ * @brief Running checksums and hashes fed by the encoder and zero-copy scans
+ *
+ * Checksumming a block after serialize_entries() is a second full pass over
+ * memory. The encoder and StructuredZeroCopyDecoder instead take any
+ * ByteDigest and feed it each entry's bytes right after writing or scanning
+ * them, while they are still in L1.
+ *
+ * - Crc32c: CRC-32C (Castagnoli), via the SSE4.2 crc32 instruction.
+ * - Sha256: FIPS 180-4 SHA-256, via SHA-NI when the CPU has it.
+ * - Blake3: BLAKE3 hash and XOF; long outputs are vectorized across blocks.
+ *
+ * All pick their kernel at runtime, so a baseline (x86-64-v2) build still
+ * uses the hardware instructions.
+ *
+ * Usage:
+ * @code
+ *   limcode::Crc32c crc;
+ *   auto bytes = limcode::serialize_entries_with_digest(entries, crc);
+ *   store(bytes, crc.value());
+ * @endcode
+ */
+
+#include "simd_dispatch.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#if LIMCODE_HAS_SIMD_DISPATCH
+#include <cpuid.h>
+#define LIMCODE_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define LIMCODE_TARGET_SHA __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+
+namespace limcode {
+
+/// Anything that can absorb a byte range: Crc32c, Sha256, Blake3, user hashers
+template <typename D>
+concept ByteDigest = requires(D &digest, std::span<const uint8_t> bytes) {
+  digest.update(bytes);
+};
+
+namespace digest_detail {
+
+// ==================== CRC-32C ====================
+
+/// Byte-at-a-time table for the reflected Castagnoli polynomial
+inline constexpr auto CRC32C_TABLE = [] {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+    }
+    table[i] = crc;
+  }
+  return table;
+}();
+
+inline uint32_t crc32c_scalar(uint32_t crc, const uint8_t *p,
+                              size_t len) noexcept {
+  for (size_t i = 0; i < len; ++i) {
+    crc = CRC32C_TABLE[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if LIMCODE_HAS_SIMD_DISPATCH
+
+LIMCODE_TARGET_SSE42 inline uint32_t crc32c_sse42(uint32_t crc,
+                                                  const uint8_t *p,
+                                                  size_t len) noexcept {
+  uint64_t crc64 = crc;
+  for (; len >= 8; p += 8, len -= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+  crc = static_cast<uint32_t>(crc64);
+  for (; len > 0; ++p, --len) {
+    crc = _mm_crc32_u8(crc, *p);
+  }
+  return crc;
+}
+
+inline bool cpu_has_sse42() noexcept {
+#ifdef __SSE4_2__
+  return true;
+#else
+  static const bool supported = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2") != 0;
+  }();
+  return supported;
+#endif
+}
+
+#endif // LIMCODE_HAS_SIMD_DISPATCH
+
+// ==================== SHA-256 ====================
+
+inline constexpr uint32_t SHA256_K[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1,
+    0x923F82A4, 0xAB1C5ED5, 0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+    0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174, 0xE49B69C1, 0xEFBE4786,
+    0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147,
+    0x06CA6351, 0x14292967, 0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+    0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85, 0xA2BFE8A1, 0xA81A664B,
+    0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A,
+    0x5B9CCA4F, 0x682E6FF3, 0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+    0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2};
+
+inline constexpr uint32_t SHA256_INIT[8] = {0x6A09E667, 0xBB67AE85, 0x3C6EF372,
+                                            0xA54FF53A, 0x510E527F, 0x9B05688C,
+                                            0x1F83D9AB, 0x5BE0CD19};
+
+/// Compress `blocks` 64-byte blocks into `state`
+inline void sha256_blocks_scalar(uint32_t state[8], const uint8_t *p,
+                                 size_t blocks) noexcept {
+  for (; blocks > 0; --blocks, p += 64) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+      uint32_t word;
+      std::memcpy(&word, p + 4 * i, 4);
+      w[i] = __builtin_bswap32(word);
+    }
+    for (int i = 16; i < 64; ++i) {
+      uint32_t s0 = std::rotr(w[i - 15], 7) ^ std::rotr(w[i - 15], 18) ^
+                    (w[i - 15] >> 3);
+      uint32_t s1 = std::rotr(w[i - 2], 17) ^ std::rotr(w[i - 2], 19) ^
+                    (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; ++i) {
+      uint32_t s1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+      uint32_t ch = (e & f) ^ (~e & g);
+      uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+      uint32_t s0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+      uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      uint32_t t2 = s0 + maj;
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+#if LIMCODE_HAS_SIMD_DISPATCH
+
+/// SHA-NI: four rounds per sha256rnds2 pair, message schedule in registers
+LIMCODE_TARGET_SHA inline void sha256_blocks_shani(uint32_t state[8],
+                                                   const uint8_t *p,
+                                                   size_t blocks) noexcept {
+  const __m128i byte_swap =
+      _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
+
+  // The instructions want the state as ABEF / CDGH
+  __m128i tmp = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0xB1);
+  __m128i state1 = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4)), 0x1B);
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+  for (; blocks > 0; --blocks, p += 64) {
+    const __m128i abef = state0;
+    const __m128i cdgh = state1;
+    __m128i w[4];
+    for (int i = 0; i < 4; ++i) {
+      w[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * i)),
+          byte_swap);
+    }
+
+#pragma GCC unroll 16
+    for (int g = 0; g < 16; ++g) {
+      __m128i msg = _mm_add_epi32(
+          w[g & 3],
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(SHA256_K + 4 * g)));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      if (g >= 3 && g <= 14) {
+        // Finish W for the next group: msg1 (below, earlier) + w[t-7] + msg2
+        __m128i next = _mm_add_epi32(w[(g + 1) & 3],
+                                     _mm_alignr_epi8(w[g & 3], w[(g + 3) & 3], 4));
+        w[(g + 1) & 3] = _mm_sha256msg2_epu32(next, w[g & 3]);
+      }
+      state0 = _mm_sha256rnds2_epu32(state0, state1,
+                                     _mm_shuffle_epi32(msg, 0x0E));
+      if (g >= 1 && g <= 12) {
+        w[(g + 3) & 3] = _mm_sha256msg1_epu32(w[(g + 3) & 3], w[g & 3]);
+      }
+    }
+
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state),
+                   _mm_blend_epi16(tmp, state1, 0xF0));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4),
+                   _mm_alignr_epi8(state1, tmp, 8));
+}
+
+inline bool cpu_has_sha() noexcept {
+  static const bool supported = [] {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+      return false;
+    }
+    return (ebx & (1u << 29)) != 0 && __builtin_cpu_supports("sse4.1");
+  }();
+  return supported;
+}
+
+#endif // LIMCODE_HAS_SIMD_DISPATCH
+
+inline void sha256_blocks(uint32_t state[8], const uint8_t *p,
+                          size_t blocks) noexcept {
+#if LIMCODE_HAS_SIMD_DISPATCH
+  if (cpu_has_sha()) {
+    sha256_blocks_shani(state, p, blocks);
+    return;
+  }
+#endif
+  sha256_blocks_scalar(state, p, blocks);
+}
+
+// ==================== BLAKE3 ====================
+
+inline constexpr size_t BLAKE3_BLOCK_LEN = 64;
+inline constexpr size_t BLAKE3_CHUNK_LEN = 1024;
+inline constexpr uint32_t BLAKE3_CHUNK_START = 1;
+inline constexpr uint32_t BLAKE3_CHUNK_END = 2;
+inline constexpr uint32_t BLAKE3_PARENT = 4;
+inline constexpr uint32_t BLAKE3_ROOT = 8;
+
+/// Same constants as SHA-256's initial state
+inline constexpr const uint32_t (&BLAKE3_IV)[8] = SHA256_INIT;
+
+/// Message word order for each of the seven rounds
+inline constexpr auto BLAKE3_SCHEDULE = [] {
+  constexpr uint8_t permutation[16] = {2, 6,  3,  10, 7, 0,  4,  13,
+                                       1, 11, 12, 5,  9, 14, 15, 8};
+  std::array<std::array<uint8_t, 16>, 7> schedule{};
+  for (uint8_t i = 0; i < 16; ++i) {
+    schedule[0][i] = i;
+  }
+  for (size_t round = 1; round < schedule.size(); ++round) {
+    for (size_t i = 0; i < 16; ++i) {
+      schedule[round][i] = schedule[round - 1][permutation[i]];
+    }
+  }
+  return schedule;
+}();
+
+/// Quarter-round on state words a, b, c, d; W is uint32_t or a GCC vector
+/// of them (one independent compression per lane)
+template <typename W>
+__attribute__((always_inline)) inline void
+blake3_g(W *v, int a, int b, int c, int d, const W &mx, const W &my) noexcept {
+  v[a] = v[a] + v[b] + mx;
+  v[d] ^= v[a];
+  v[d] = (v[d] >> 16) | (v[d] << 16);
+  v[c] = v[c] + v[d];
+  v[b] ^= v[c];
+  v[b] = (v[b] >> 12) | (v[b] << 20);
+  v[a] = v[a] + v[b] + my;
+  v[d] ^= v[a];
+  v[d] = (v[d] >> 8) | (v[d] << 24);
+  v[c] = v[c] + v[d];
+  v[b] ^= v[c];
+  v[b] = (v[b] >> 7) | (v[b] << 25);
+}
+
+template <typename W>
+__attribute__((always_inline)) inline void blake3_rounds(W v[16],
+                                                         const W m[16]) noexcept {
+#pragma GCC unroll 7
+  for (const auto &s : BLAKE3_SCHEDULE) {
+    blake3_g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+    blake3_g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+    blake3_g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+    blake3_g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+    blake3_g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+    blake3_g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+    blake3_g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+    blake3_g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+  }
+}
+
+/// Full 16-word compression output; the first 8 words are the chaining value
+inline void blake3_compress(const uint32_t cv[8], const uint32_t block[16],
+                            uint64_t counter, uint32_t block_len,
+                            uint32_t flags, uint32_t out[16]) noexcept {
+  uint32_t v[16] = {cv[0],          cv[1],          cv[2],
+                    cv[3],          cv[4],          cv[5],
+                    cv[6],          cv[7],          BLAKE3_IV[0],
+                    BLAKE3_IV[1],   BLAKE3_IV[2],   BLAKE3_IV[3],
+                    static_cast<uint32_t>(counter),
+                    static_cast<uint32_t>(counter >> 32),
+                    block_len,      flags};
+  blake3_rounds(v, block);
+  for (int i = 0; i < 8; ++i) {
+    out[i] = v[i] ^ v[i + 8];
+    out[i + 8] = v[i + 8] ^ cv[i];
+  }
+}
+
+/// Root output blocks `first`..`first + Lanes - 1` of one node, one block
+/// per vector lane, written to `out` in output order
+template <typename Vec, size_t Lanes>
+__attribute__((always_inline)) inline void
+blake3_root_lanes(const uint32_t cv[8], const uint32_t block[16],
+                  uint32_t block_len, uint32_t flags, uint64_t first,
+                  uint8_t *out) noexcept {
+  Vec m[16];
+  Vec v[16];
+  for (int w = 0; w < 16; ++w) {
+    m[w] = Vec{} + block[w];
+  }
+  for (int w = 0; w < 8; ++w) {
+    v[w] = Vec{} + cv[w];
+  }
+  for (int w = 0; w < 4; ++w) {
+    v[8 + w] = Vec{} + BLAKE3_IV[w];
+  }
+  for (size_t l = 0; l < Lanes; ++l) {
+    v[12][l] = static_cast<uint32_t>(first + l);
+    v[13][l] = static_cast<uint32_t>((first + l) >> 32);
+  }
+  v[14] = Vec{} + block_len;
+  v[15] = Vec{} + flags;
+  blake3_rounds(v, m);
+
+  for (int w = 0; w < 8; ++w) {
+    Vec low = v[w] ^ v[w + 8];
+    Vec high = v[w + 8] ^ (Vec{} + cv[w]);
+    for (size_t l = 0; l < Lanes; ++l) {
+      uint32_t lo = low[l];
+      uint32_t hi = high[l];
+      std::memcpy(out + l * 64 + w * 4, &lo, 4);
+      std::memcpy(out + l * 64 + 32 + w * 4, &hi, 4);
+    }
+  }
+}
+
+typedef uint32_t Blake3Vec8 __attribute__((vector_size(32)));
+typedef uint32_t Blake3Vec16 __attribute__((vector_size(64)));
+
+/// Eight output blocks per call; the vectors lower to SSE2 here
+inline void blake3_root_x8(const uint32_t cv[8], const uint32_t block[16],
+                           uint32_t block_len, uint32_t flags, uint64_t first,
+                           uint8_t *out) noexcept {
+  blake3_root_lanes<Blake3Vec8, 8>(cv, block, block_len, flags, first, out);
+}
+
+#if LIMCODE_HAS_SIMD_DISPATCH
+
+LIMCODE_TARGET_AVX2 inline void
+blake3_root_x8_avx2(const uint32_t cv[8], const uint32_t block[16],
+                    uint32_t block_len, uint32_t flags, uint64_t first,
+                    uint8_t *out) noexcept {
+  blake3_root_lanes<Blake3Vec8, 8>(cv, block, block_len, flags, first, out);
+}
+
+LIMCODE_TARGET_AVX512 inline void
+blake3_root_x16_avx512(const uint32_t cv[8], const uint32_t block[16],
+                       uint32_t block_len, uint32_t flags, uint64_t first,
+                       uint8_t *out) noexcept {
+  blake3_root_lanes<Blake3Vec16, 16>(cv, block, block_len, flags, first, out);
+}
+
+#endif // LIMCODE_HAS_SIMD_DISPATCH
+
+/// `blocks` root output blocks from `first` on: the XOF stream of a hash
+inline void blake3_root_blocks(const uint32_t cv[8], const uint32_t block[16],
+                               uint32_t block_len, uint32_t flags,
+                               uint64_t first, size_t blocks,
+                               uint8_t *out) noexcept {
+#if LIMCODE_HAS_SIMD_DISPATCH
+  SimdLevel level = simd_level();
+  if (level == SimdLevel::AVX512) {
+    for (; blocks >= 16; blocks -= 16, first += 16, out += 16 * 64) {
+      blake3_root_x16_avx512(cv, block, block_len, flags, first, out);
+    }
+  }
+  if (level != SimdLevel::Scalar) {
+    for (; blocks >= 8; blocks -= 8, first += 8, out += 8 * 64) {
+      blake3_root_x8_avx2(cv, block, block_len, flags, first, out);
+    }
+  }
+#endif
+  for (; blocks >= 8; blocks -= 8, first += 8, out += 8 * 64) {
+    blake3_root_x8(cv, block, block_len, flags, first, out);
+  }
+  for (; blocks > 0; --blocks, ++first, out += 64) {
+    uint32_t words[16];
+    blake3_compress(cv, block, first, block_len, flags, words);
+    std::memcpy(out, words, 64);
+  }
+}
+
+} // namespace digest_detail
+
+/**
+ * @brief Running CRC-32C (iSCSI / ext4 / RocksDB polynomial)
+ *
+ * value() may be read at any point; update() continues from there.
+ */
+class Crc32c {
+public:
+  void update(std::span<const uint8_t> bytes) noexcept {
+#if LIMCODE_HAS_SIMD_DISPATCH
+    if (digest_detail::cpu_has_sse42()) {
+      state_ = digest_detail::crc32c_sse42(state_, bytes.data(), bytes.size());
+      return;
+    }
+#endif
+    state_ = digest_detail::crc32c_scalar(state_, bytes.data(), bytes.size());
+  }
+
+  [[nodiscard]] uint32_t value() const noexcept { return ~state_; }
+  void reset() noexcept { state_ = 0xFFFFFFFF; }
+
+  /// CRC-32C of `bytes` in one call
+  [[nodiscard]] static uint32_t compute(std::span<const uint8_t> bytes) noexcept {
+    Crc32c crc;
+    crc.update(bytes);
+    return crc.value();
+  }
+
+private:
+  uint32_t state_ = 0xFFFFFFFF;
+};
+
+/**
+ * @brief Running SHA-256
+ *
+ * finish() pads and returns the digest, then resets for the next message.
+ */
+class Sha256 {
+public:
+  static constexpr size_t DIGEST_BYTES = 32;
+  using Digest = std::array<uint8_t, DIGEST_BYTES>;
+
+  Sha256() noexcept { reset(); }
+
+  void reset() noexcept {
+    std::memcpy(state_, digest_detail::SHA256_INIT, sizeof(state_));
+    buffered_ = 0;
+    total_ = 0;
+  }
+
+  void update(std::span<const uint8_t> bytes) noexcept {
+    const uint8_t *p = bytes.data();
+    size_t len = bytes.size();
+    total_ += len;
+    if (buffered_ > 0) {
+      size_t take = std::min(len, size_t(64) - buffered_);
+      std::memcpy(block_ + buffered_, p, take);
+      buffered_ += take;
+      p += take;
+      len -= take;
+      if (buffered_ < 64) {
+        return;
+      }
+      digest_detail::sha256_blocks(state_, block_, 1);
+      buffered_ = 0;
+    }
+    if (len >= 64) {
+      digest_detail::sha256_blocks(state_, p, len / 64);
+      p += len & ~size_t(63);
+      len &= 63;
+    }
+    if (len > 0) {
+      std::memcpy(block_, p, len);
+      buffered_ = len;
+    }
+  }
+
+  [[nodiscard]] Digest finish() noexcept {
+    uint64_t bits = total_ * 8;
+    block_[buffered_++] = 0x80;
+    if (buffered_ > 56) {
+      std::memset(block_ + buffered_, 0, 64 - buffered_);
+      digest_detail::sha256_blocks(state_, block_, 1);
+      buffered_ = 0;
+    }
+    std::memset(block_ + buffered_, 0, 56 - buffered_);
+    for (int i = 0; i < 8; ++i) {
+      block_[56 + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+    }
+    digest_detail::sha256_blocks(state_, block_, 1);
+
+    Digest out;
+    for (int i = 0; i < 8; ++i) {
+      uint32_t word = __builtin_bswap32(state_[i]);
+      std::memcpy(out.data() + 4 * i, &word, 4);
+    }
+    reset();
+    return out;
+  }
+
+  /// SHA-256 of `bytes` in one call
+  [[nodiscard]] static Digest compute(std::span<const uint8_t> bytes) noexcept {
+    Sha256 sha;
+    sha.update(bytes);
+    return sha.finish();
+  }
+
+private:
+  uint32_t state_[8];
+  uint8_t block_[64];
+  size_t buffered_;
+  uint64_t total_;
+};
+
+/**
+ * @brief Running BLAKE3 (unkeyed hash mode), with extendable output
+ *
+ * finish() returns the 32-byte hash; finish_xof() fills a buffer of any
+ * length with the output stream, whose first 32 bytes are that hash. Both
+ * reset for the next message. The XOF stream is produced 8 or 16 blocks at
+ * a time on AVX2 / AVX-512; input is compressed one block at a time.
+ */
+class Blake3 {
+public:
+  static constexpr size_t DIGEST_BYTES = 32;
+  using Digest = std::array<uint8_t, DIGEST_BYTES>;
+
+  Blake3() noexcept { reset(); }
+
+  void reset() noexcept {
+    std::memcpy(cv_, digest_detail::BLAKE3_IV, sizeof(cv_));
+    chunk_counter_ = 0;
+    blocks_compressed_ = 0;
+    buffered_ = 0;
+    stack_len_ = 0;
+  }
+
+  void update(std::span<const uint8_t> bytes) noexcept {
+    using namespace digest_detail;
+    const uint8_t *p = bytes.data();
+    size_t len = bytes.size();
+    while (len > 0) {
+      // A chunk is closed only once more input arrives: the last one is root
+      if (chunk_len() == BLAKE3_CHUNK_LEN) {
+        uint32_t out[16];
+        compress_buffered(BLAKE3_CHUNK_END, out);
+        push_chunk(out, ++chunk_counter_);
+        std::memcpy(cv_, BLAKE3_IV, sizeof(cv_));
+        blocks_compressed_ = 0;
+        buffered_ = 0;
+      }
+      size_t take = std::min(len, BLAKE3_CHUNK_LEN - chunk_len());
+      len -= take;
+      while (take > 0) {
+        if (buffered_ == BLAKE3_BLOCK_LEN) {
+          uint32_t out[16];
+          compress_buffered(0, out);
+          std::memcpy(cv_, out, sizeof(cv_));
+          blocks_compressed_++;
+          buffered_ = 0;
+        }
+        size_t n = std::min(take, BLAKE3_BLOCK_LEN - buffered_);
+        std::memcpy(block_ + buffered_, p, n);
+        buffered_ += n;
+        p += n;
+        take -= n;
+      }
+    }
+  }
+
+  [[nodiscard]] Digest finish() noexcept {
+    Digest out;
+    finish_xof(out);
+    return out;
+  }
+
+  /// Fill `out` with the first out.size() bytes of the output stream
+  void finish_xof(std::span<uint8_t> out) noexcept {
+    using namespace digest_detail;
+    // Root node: the open chunk, folded up through the pending subtrees
+    uint32_t cv[8];
+    uint32_t block[16];
+    std::memcpy(cv, cv_, sizeof(cv));
+    load_block(block);
+    uint64_t counter = chunk_counter_;
+    uint32_t block_len = static_cast<uint32_t>(buffered_);
+    uint32_t flags = start_flag() | BLAKE3_CHUNK_END;
+    for (size_t i = stack_len_; i-- > 0;) {
+      uint32_t child[16];
+      blake3_compress(cv, block, counter, block_len, flags, child);
+      std::memcpy(block, stack_[i], 32);
+      std::memcpy(block + 8, child, 32);
+      std::memcpy(cv, BLAKE3_IV, sizeof(cv));
+      counter = 0;
+      block_len = BLAKE3_BLOCK_LEN;
+      flags = BLAKE3_PARENT;
+    }
+
+    flags |= BLAKE3_ROOT;
+    size_t full = out.size() / 64;
+    blake3_root_blocks(cv, block, block_len, flags, 0, full, out.data());
+    if (size_t tail = out.size() % 64) {
+      uint32_t words[16];
+      blake3_compress(cv, block, full, block_len, flags, words);
+      std::memcpy(out.data() + full * 64, words, tail);
+    }
+    reset();
+  }
+
+  /// BLAKE3 of `bytes` in one call
+  [[nodiscard]] static Digest compute(std::span<const uint8_t> bytes) noexcept {
+    Blake3 hasher;
+    hasher.update(bytes);
+    return hasher.finish();
+  }
+
+private:
+  size_t chunk_len() const noexcept {
+    return blocks_compressed_ * digest_detail::BLAKE3_BLOCK_LEN + buffered_;
+  }
+
+  uint32_t start_flag() const noexcept {
+    return blocks_compressed_ == 0 ? digest_detail::BLAKE3_CHUNK_START : 0;
+  }
+
+  /// Buffered bytes as little-endian words, zero-padded to a full block
+  void load_block(uint32_t words[16]) const noexcept {
+    uint8_t padded[64] = {};
+    std::memcpy(padded, block_, buffered_);
+    std::memcpy(words, padded, sizeof(padded));
+  }
+
+  void compress_buffered(uint32_t flags, uint32_t out[16]) const noexcept {
+    uint32_t words[16];
+    load_block(words);
+    digest_detail::blake3_compress(cv_, words, chunk_counter_,
+                                   static_cast<uint32_t>(buffered_),
+                                   start_flag() | flags, out);
+  }
+
+  /// Add a finished chunk's chaining value, merging every completed
+  /// subtree: `total_chunks` has one trailing zero bit per merge
+  void push_chunk(const uint32_t cv[8], uint64_t total_chunks) noexcept {
+    uint32_t merged[8];
+    std::memcpy(merged, cv, sizeof(merged));
+    for (; (total_chunks & 1) == 0; total_chunks >>= 1) {
+      uint32_t block[16];
+      uint32_t out[16];
+      std::memcpy(block, stack_[--stack_len_], 32);
+      std::memcpy(block + 8, merged, 32);
+      digest_detail::blake3_compress(digest_detail::BLAKE3_IV, block, 0,
+                                     digest_detail::BLAKE3_BLOCK_LEN,
+                                     digest_detail::BLAKE3_PARENT, out);
+      std::memcpy(merged, out, sizeof(merged));
+    }
+    std::memcpy(stack_[stack_len_++], merged, sizeof(merged));
+  }
+
+  uint32_t cv_[8];
+  uint64_t chunk_counter_;
+  size_t blocks_compressed_;
+  uint8_t block_[64];
+  size_t buffered_;
+  // One chaining value per set bit of the chunk count
+  uint32_t stack_[54][8];
+  size_t stack_len_;
+};
+
+} // namespace limcode
@@ -0,0 +1,465 @@
+#pragma once
+
+/**
+ * @file executor.h
+ * @brief Shared work-stealing executor for every parallel limcode path
+ *
+ * All parallel encoders/decoders (serialize_entries_parallel,
+ * serialize_entries_ultra_parallel, deserialize_entries_parallel,
+ * memcpy_parallel, ParallelBatchEncoder, ...) submit their work to one
+ * Executor instead of spawning threads or using std::execution, so mixing
+ * them never oversubscribes cores.
+ *
+ * Usage:
+ * @code
+ *   // Pin 16 workers to NUMA node 0 and make it the process-wide default
+ *   limcode::ExecutorOptions opts;
+ *   opts.num_threads = 16;
+ *   opts.numa_node = 0;
+ *   static limcode::WorkStealingExecutor pool(opts);
+ *   limcode::set_default_executor(&pool);
+ *
+ *   // Or route limcode onto an existing thread pool
+ *   struct MyPool : limcode::Executor { ... };
+ * @endcode
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace limcode {
+
+/**
+ * @brief Non-owning reference to a task body `void(size_t index)`
+ *
+ * Two words, no allocation; the referenced callable must outlive run().
+ */
+class TaskRef {
+public:
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::remove_cvref_t<F>, TaskRef>>>
+  TaskRef(F &&f) noexcept // NOLINT(google-explicit-constructor)
+      : ctx_(const_cast<void *>(static_cast<const void *>(&f))),
+        fn_([](void *ctx, size_t i) {
+          (*static_cast<std::remove_reference_t<F> *>(ctx))(i);
+        }) {}
+
+  void operator()(size_t index) const { fn_(ctx_, index); }
+
+private:
+  void *ctx_;
+  void (*fn_)(void *, size_t);
+};
+
+/**
+ * @brief Interface every parallel limcode API runs on
+ *
+ * Implement run() to plug in an external thread pool. Contract: invoke
+ * task(i) exactly once for every i in [0, num_tasks), return only after all
+ * invocations finished, and rethrow the first exception a task threw.
+ * run() may be called concurrently and from inside a task.
+ */
+class Executor {
+public:
+  virtual ~Executor() = default;
+
+  /// Number of threads that can execute tasks at once (including caller)
+  [[nodiscard]] virtual size_t concurrency() const noexcept = 0;
+
+  /// Execute task(0) ... task(num_tasks - 1) and wait for completion
+  virtual void run(size_t num_tasks, TaskRef task) = 0;
+
+  /**
+   * @brief Call func(start, end) over [0, total) split into num_chunks ranges
+   *
+   * @param num_chunks Number of ranges (0 = concurrency())
+   */
+  template <typename Func>
+  void parallel_for(size_t total, size_t num_chunks, Func &&func) {
+    if (num_chunks == 0) {
+      num_chunks = concurrency();
+    }
+    num_chunks = std::min(num_chunks, total);
+    if (num_chunks <= 1) {
+      if (total > 0) {
+        func(size_t(0), total);
+      }
+      return;
+    }
+
+    const size_t chunk_size = (total + num_chunks - 1) / num_chunks;
+    num_chunks = (total + chunk_size - 1) / chunk_size;
+    auto body = [&](size_t chunk) {
+      size_t start = chunk * chunk_size;
+      func(start, std::min(start + chunk_size, total));
+    };
+    run(num_chunks, body);
+  }
+};
+
+/**
+ * @brief Executor that runs every task on the calling thread
+ */
+class InlineExecutor final : public Executor {
+public:
+  [[nodiscard]] size_t concurrency() const noexcept override { return 1; }
+
+  void run(size_t num_tasks, TaskRef task) override {
+    for (size_t i = 0; i < num_tasks; ++i) {
+      task(i);
+    }
+  }
+};
+
+/**
+ * @brief Thread count and placement for WorkStealingExecutor
+ */
+struct ExecutorOptions {
+  /// Threads including the caller (0 = number of CPUs in the affinity set)
+  size_t num_threads = 0;
+
+  /// Pin workers round-robin to these CPUs (empty = no pinning)
+  std::vector<int> cpus;
+
+  /// Restrict pinning to the CPUs of this NUMA node (-1 = any). Linux only;
+  /// combined with `cpus` when both are set.
+  int numa_node = -1;
+};
+
+namespace detail {
+
+/// Parse a sysfs cpulist ("0-3,8,10-11"); empty on failure
+inline std::vector<int> read_cpulist(const char *path) {
+  std::vector<int> cpus;
+  FILE *f = std::fopen(path, "r");
+  if (!f) {
+    return cpus;
+  }
+  int lo = 0;
+  while (std::fscanf(f, "%d", &lo) == 1) {
+    int hi = lo;
+    int c = std::fgetc(f);
+    if (c == '-') {
+      if (std::fscanf(f, "%d", &hi) != 1) {
+        break;
+      }
+      c = std::fgetc(f);
+    }
+    for (int cpu = lo; cpu <= hi; ++cpu) {
+      cpus.push_back(cpu);
+    }
+    if (c != ',') {
+      break;
+    }
+  }
+  std::fclose(f);
+  return cpus;
+}
+
+/// CPUs selected by `options`; empty means "don't pin"
+inline std::vector<int> resolve_executor_cpus(const ExecutorOptions &options) {
+  std::vector<int> cpus = options.cpus;
+  if (options.numa_node >= 0) {
+    char path[96];
+    std::snprintf(path, sizeof(path),
+                  "/sys/devices/system/node/node%d/cpulist", options.numa_node);
+    std::vector<int> node_cpus = read_cpulist(path);
+    if (cpus.empty()) {
+      cpus = std::move(node_cpus);
+    } else if (!node_cpus.empty()) {
+      std::erase_if(cpus, [&](int cpu) {
+        return std::find(node_cpus.begin(), node_cpus.end(), cpu) ==
+               node_cpus.end();
+      });
+    }
+  }
+  return cpus;
+}
+
+inline void pin_current_thread(int cpu) noexcept {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)cpu;
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Persistent work-stealing thread pool
+ *
+ * run() splits [0, num_tasks) into one contiguous range per participant;
+ * each participant pops indices from the front of its own range and, when
+ * empty, steals the back half of a victim's range. The calling thread is
+ * one of the participants. Calls from inside a task run inline, and
+ * concurrent callers from outside take turns, so the pool never runs more
+ * than concurrency() threads.
+ */
+class WorkStealingExecutor final : public Executor {
+public:
+  explicit WorkStealingExecutor(const ExecutorOptions &options = {}) {
+    cpus_ = detail::resolve_executor_cpus(options);
+
+    size_t threads = options.num_threads;
+    if (threads == 0) {
+      threads = cpus_.empty() ? std::thread::hardware_concurrency()
+                              : cpus_.size();
+    }
+    concurrency_ = std::max<size_t>(threads, 1);
+
+    workers_.reserve(concurrency_ - 1);
+    for (size_t i = 1; i < concurrency_; ++i) {
+      workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+  }
+
+  ~WorkStealingExecutor() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &w : workers_) {
+      w.join();
+    }
+  }
+
+  WorkStealingExecutor(const WorkStealingExecutor &) = delete;
+  WorkStealingExecutor &operator=(const WorkStealingExecutor &) = delete;
+
+  [[nodiscard]] size_t concurrency() const noexcept override {
+    return concurrency_;
+  }
+
+  void run(size_t num_tasks, TaskRef task) override {
+    if (num_tasks == 0) {
+      return;
+    }
+    if (num_tasks == 1 || workers_.empty() || current() == this ||
+        num_tasks > UINT32_MAX) {
+      run_inline(num_tasks, task);
+      return;
+    }
+
+    std::lock_guard<std::mutex> submit(submit_mutex_);
+    Job job(task, num_tasks, concurrency_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = &job;
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    const WorkStealingExecutor *outer = current();
+    current() = this;
+    job.work(0);
+    current() = outer;
+
+    // Workers that joined are still draining stolen ranges
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_ = nullptr;
+      done_.wait(lock, [&] { return job.participants == 0; });
+    }
+
+    if (job.error) {
+      std::rethrow_exception(job.error);
+    }
+  }
+
+private:
+  /// One run() call; lives on the caller's stack
+  struct Job {
+    struct alignas(64) Slot {
+      std::atomic<uint64_t> range{0}; // begin | end << 32
+    };
+
+    TaskRef task;
+    std::vector<Slot> slots;
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    size_t participants = 0; // Guarded by executor mutex_
+
+    Job(TaskRef t, size_t num_tasks, size_t num_slots)
+        : task(t), slots(num_slots) {
+      size_t per = num_tasks / num_slots;
+      size_t extra = num_tasks % num_slots;
+      size_t begin = 0;
+      for (size_t i = 0; i < num_slots; ++i) {
+        size_t end = begin + per + (i < extra ? 1 : 0);
+        slots[i].range.store(pack(begin, end), std::memory_order_relaxed);
+        begin = end;
+      }
+    }
+
+    static uint64_t pack(uint64_t begin, uint64_t end) {
+      return begin | (end << 32);
+    }
+
+    /// Claim the front index of slot `s`
+    bool pop(size_t s, size_t &index) {
+      uint64_t v = slots[s].range.load(std::memory_order_acquire);
+      while (true) {
+        uint64_t begin = v & 0xFFFFFFFFu;
+        uint64_t end = v >> 32;
+        if (begin >= end) {
+          return false;
+        }
+        if (slots[s].range.compare_exchange_weak(v, pack(begin + 1, end),
+                                                 std::memory_order_acq_rel)) {
+          index = begin;
+          return true;
+        }
+      }
+    }
+
+    /// Move the back half of some victim's range into slot `self`
+    bool steal(size_t self) {
+      const size_t n = slots.size();
+      for (size_t k = 1; k < n; ++k) {
+        size_t victim = (self + k) % n;
+        uint64_t v = slots[victim].range.load(std::memory_order_acquire);
+        while (true) {
+          uint64_t begin = v & 0xFFFFFFFFu;
+          uint64_t end = v >> 32;
+          if (begin >= end) {
+            break;
+          }
+          uint64_t mid = begin + (end - begin) / 2;
+          if (slots[victim].range.compare_exchange_weak(
+                  v, pack(begin, mid), std::memory_order_acq_rel)) {
+            slots[self].range.store(pack(mid, end), std::memory_order_release);
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
+    void work(size_t self) {
+      size_t index;
+      do {
+        while (pop(self, index)) {
+          if (failed.load(std::memory_order_relaxed)) {
+            continue; // Drain without running
+          }
+          try {
+            task(index);
+          } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+              error = std::current_exception();
+            }
+            failed.store(true, std::memory_order_relaxed);
+          }
+        }
+      } while (steal(self));
+    }
+  };
+
+  static const WorkStealingExecutor *&current() {
+    static thread_local const WorkStealingExecutor *executor = nullptr;
+    return executor;
+  }
+
+  static void run_inline(size_t num_tasks, TaskRef task) {
+    for (size_t i = 0; i < num_tasks; ++i) {
+      task(i);
+    }
+  }
+
+  void worker_loop(size_t self) {
+    if (!cpus_.empty()) {
+      detail::pin_current_thread(cpus_[self % cpus_.size()]);
+    }
+    current() = this;
+
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wake_.wait(lock, [&] {
+        return stop_ || (job_ != nullptr && generation_ != seen);
+      });
+      if (stop_) {
+        return;
+      }
+      seen = generation_;
+      Job *job = job_;
+      ++job->participants;
+      lock.unlock();
+
+      job->work(self);
+
+      lock.lock();
+      if (--job->participants == 0) {
+        done_.notify_all();
+      }
+    }
+  }
+
+  size_t concurrency_ = 1;
+  std::vector<int> cpus_;
+  std::vector<std::thread> workers_;
+
+  std::mutex submit_mutex_; // Serializes external run() calls
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  Job *job_ = nullptr;
+  uint64_t generation_ = 0;
+  bool stop_ = false;
+};
+
+namespace detail {
+inline std::atomic<Executor *> &default_executor_override() {
+  static std::atomic<Executor *> executor{nullptr};
+  return executor;
+}
+} // namespace detail
+
+/**
+ * @brief Executor used by parallel APIs when none is passed explicitly
+ *
+ * A WorkStealingExecutor with hardware_concurrency() threads is created on
+ * first use unless set_default_executor() installed another one.
+ */
+inline Executor &default_executor() {
+  if (Executor *e =
+          detail::default_executor_override().load(std::memory_order_acquire)) {
+    return *e;
+  }
+  static WorkStealingExecutor executor;
+  return executor;
+}
+
+/**
+ * @brief Route all default parallel work to `executor`
+ *
+ * The caller keeps ownership and must keep it alive while in use; pass
+ * nullptr to restore the built-in pool.
+ */
+inline void set_default_executor(Executor *executor) noexcept {
+  detail::default_executor_override().store(executor,
+                                            std::memory_order_release);
+}
+
+} // namespace limcode
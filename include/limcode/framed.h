@@ -0,0 +1,276 @@
+#pragma once
+
+/**
+ * @file framed.h
+ * @brief Length-prefixed frames of serialized batches, optionally zstd-compressed
+ *
+ * Entry batches repeat the same blockhashes, program IDs and account keys
+ * over and over, which a zstd dictionary trained on past batches captures
+ * far better than compressing each batch on its own. A framed stream is a
+ * plain concatenation of frames, each a 20-byte little-endian header:
+ *
+ *   u32 magic "LCF1" | u8 version | u8 flags | u16 reserved (0)
+ *   u32 dict_id (0 = none) | u32 stored_size | u32 raw_size
+ *
+ * followed by stored_size payload bytes: a zstd frame when FRAME_COMPRESSED
+ * is set, otherwise the raw payload. Payloads that don't shrink are stored
+ * raw, so decoding never costs more than a memcpy for them. Frames are
+ * independent; encode_frames_parallel / decode_frames_parallel spread them
+ * over the shared Executor.
+ *
+ * Requires libzstd: the implementation lives in src/framed.cpp and is built
+ * as the limcode_framed library when CMake finds it.
+ *
+ * Usage:
+ * @code
+ *   // Train once on a corpus of past batches, ship the bytes to both sides
+ *   auto dict_bytes = limcode::train_zstd_dictionary(sample_batches);
+ *   limcode::ZstdDictionary dict(dict_bytes);
+ *
+ *   limcode::FrameOptions opts;
+ *   opts.dictionary = &dict;
+ *   auto stream = limcode::encode_entry_frames_parallel(batches, opts);
+ *
+ *   const limcode::ZstdDictionary *dicts[] = {&dict};
+ *   auto decoded = limcode::decode_entry_frames_parallel(stream, dicts);
+ * @endcode
+ */
+
+#include <limcode/executor.h>
+#include <limcode/limcode.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+namespace limcode {
+
+/// "LCF1" read as a little-endian u32
+constexpr uint32_t FRAME_MAGIC = 0x3146434C;
+constexpr uint8_t FRAME_VERSION = 1;
+constexpr size_t FRAME_HEADER_SIZE = 20;
+
+/// Payload is a zstd frame (otherwise stored raw)
+constexpr uint8_t FRAME_COMPRESSED = 0x01;
+
+/// Largest payload a frame can carry (sizes are u32 on the wire)
+constexpr size_t MAX_FRAME_PAYLOAD = UINT32_MAX;
+
+/// zstd's recommended dictionary size; larger rarely helps for small batches
+constexpr size_t DEFAULT_DICTIONARY_SIZE = 112 * 1024;
+
+/// Decoded frame header
+struct FrameHeader {
+  uint8_t flags = 0;
+  uint32_t dict_id = 0;
+  uint32_t stored_size = 0; ///< Payload bytes following the header
+  uint32_t raw_size = 0;    ///< Payload bytes once decompressed
+
+  [[nodiscard]] bool compressed() const noexcept {
+    return (flags & FRAME_COMPRESSED) != 0;
+  }
+  [[nodiscard]] size_t frame_size() const noexcept {
+    return FRAME_HEADER_SIZE + stored_size;
+  }
+};
+
+/**
+ * @brief Parse the header at the front of `data`
+ *
+ * @return false if fewer than FRAME_HEADER_SIZE bytes are available
+ * @throws LimcodeError on a bad magic, version or flag bits
+ */
+bool read_frame_header(std::span<const uint8_t> data, FrameHeader &header);
+
+struct ZstdDictionaryAccess;
+
+/**
+ * @brief Trained zstd dictionary, digested once for compression and decompression
+ *
+ * Immutable after construction and safe to share between threads and
+ * encoders. The ID written into frames is the one zstd stored in the
+ * dictionary when it was trained.
+ */
+class ZstdDictionary {
+public:
+  /**
+   * @param content Dictionary bytes from train_zstd_dictionary
+   * @param level   zstd level frames compressed with it use
+   * @throws LimcodeError if `content` isn't a zstd dictionary
+   */
+  explicit ZstdDictionary(std::vector<uint8_t> content, int level = 3);
+  ~ZstdDictionary();
+
+  ZstdDictionary(ZstdDictionary &&) noexcept;
+  ZstdDictionary &operator=(ZstdDictionary &&) noexcept;
+
+  [[nodiscard]] uint32_t id() const noexcept;
+  [[nodiscard]] int level() const noexcept;
+  [[nodiscard]] std::span<const uint8_t> content() const noexcept;
+
+private:
+  friend struct ZstdDictionaryAccess;
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Train a dictionary from sample payloads (e.g. serialized batches)
+ *
+ * Samples should look like what will be framed; a few hundred of them, or
+ * roughly 100x `max_size` bytes in total, give zstd enough to work with.
+ *
+ * @throws LimcodeError if zstd can't train on the samples
+ */
+[[nodiscard]] std::vector<uint8_t>
+train_zstd_dictionary(std::span<const std::vector<uint8_t>> samples,
+                      size_t max_size = DEFAULT_DICTIONARY_SIZE);
+
+/// Train on serialize_entries() of each batch
+[[nodiscard]] std::vector<uint8_t>
+train_entry_dictionary(std::span<const std::vector<Entry>> batches,
+                       size_t max_size = DEFAULT_DICTIONARY_SIZE);
+
+/// How frames are written
+struct FrameOptions {
+  /// Compress with this dictionary (its level applies); must outlive the encoder
+  const ZstdDictionary *dictionary = nullptr;
+  /// zstd level when no dictionary is set
+  int level = 3;
+  /// Payloads smaller than this are stored raw
+  size_t min_compress_size = 64;
+};
+
+/**
+ * @brief Writes frames one at a time, reusing one zstd context
+ *
+ * Not thread-safe; use one encoder per thread or encode_frames_parallel.
+ */
+class FrameEncoder {
+public:
+  explicit FrameEncoder(FrameOptions options = {});
+  ~FrameEncoder();
+
+  FrameEncoder(const FrameEncoder &) = delete;
+  FrameEncoder &operator=(const FrameEncoder &) = delete;
+
+  /**
+   * @brief Append one frame holding `payload` to `out`
+   * @return Bytes appended
+   * @throws LimcodeError if the payload exceeds MAX_FRAME_PAYLOAD
+   */
+  size_t encode(std::span<const uint8_t> payload, std::vector<uint8_t> &out);
+
+  /// Append one frame holding serialize_entries(entries)
+  size_t encode_entries(const std::vector<Entry> &entries,
+                        std::vector<uint8_t> &out);
+
+  [[nodiscard]] const FrameOptions &options() const noexcept {
+    return options_;
+  }
+
+private:
+  FrameOptions options_;
+  ZSTD_CCtx_s *cctx_ = nullptr;
+  std::vector<uint8_t> scratch_;
+};
+
+/**
+ * @brief Decodes frames from bytes that may arrive in arbitrary pieces
+ *
+ * feed() what was received, then call next() until it returns false.
+ * Dictionaries are looked up by the ID in each frame header.
+ */
+class FrameDecoder {
+public:
+  FrameDecoder();
+  explicit FrameDecoder(std::span<const ZstdDictionary *const> dictionaries);
+  ~FrameDecoder();
+
+  FrameDecoder(const FrameDecoder &) = delete;
+  FrameDecoder &operator=(const FrameDecoder &) = delete;
+
+  /// Make `dictionary` available to frames carrying its ID; must outlive the decoder
+  void add_dictionary(const ZstdDictionary &dictionary);
+
+  /// Buffer received bytes; frames may span several calls
+  void feed(std::span<const uint8_t> data);
+
+  /**
+   * @brief Decode the next buffered frame into `payload`
+   * @return false until a whole frame has been fed
+   * @throws LimcodeError on a corrupt frame or unknown dictionary ID
+   */
+  bool next(std::vector<uint8_t> &payload);
+
+  /// next() followed by deserialize_entries
+  bool next_entries(std::vector<Entry> &entries);
+
+  /**
+   * @brief Decode the frame at the front of `data` without buffering
+   * @return Bytes consumed
+   * @throws LimcodeError if `data` doesn't start with a whole, valid frame
+   */
+  size_t decode(std::span<const uint8_t> data, std::vector<uint8_t> &payload);
+
+  /// Bytes fed but not yet decoded
+  [[nodiscard]] size_t buffered() const noexcept {
+    return pending_.size() - consumed_;
+  }
+
+private:
+  const ZstdDictionary *find_dictionary(uint32_t id) const;
+
+  std::vector<const ZstdDictionary *> dictionaries_;
+  ZSTD_DCtx_s *dctx_ = nullptr;
+  std::vector<uint8_t> pending_;
+  size_t consumed_ = 0;
+  std::vector<uint8_t> scratch_;
+};
+
+/**
+ * @brief Byte offset of every frame in `stream`
+ * @throws LimcodeError if the stream is truncated or a header is invalid
+ */
+[[nodiscard]] std::vector<size_t>
+frame_offsets(std::span<const uint8_t> stream);
+
+/**
+ * @brief Frame each payload, compressing them concurrently
+ *
+ * Frames appear in payload order; the output is byte-identical to encoding
+ * them one after another with a FrameEncoder.
+ */
+[[nodiscard]] std::vector<uint8_t>
+encode_frames_parallel(std::span<const std::span<const uint8_t>> payloads,
+                       const FrameOptions &options = {},
+                       Executor &executor = default_executor());
+
+/// Serialize and frame each batch, one task per batch
+[[nodiscard]] std::vector<uint8_t>
+encode_entry_frames_parallel(std::span<const std::vector<Entry>> batches,
+                             const FrameOptions &options = {},
+                             Executor &executor = default_executor());
+
+/**
+ * @brief Decode every frame of `stream` concurrently, in stream order
+ * @throws LimcodeError on the first corrupt frame
+ */
+[[nodiscard]] std::vector<std::vector<uint8_t>>
+decode_frames_parallel(std::span<const uint8_t> stream,
+                       std::span<const ZstdDictionary *const> dictionaries = {},
+                       Executor &executor = default_executor());
+
+/// Decode and deserialize_entries every frame of `stream` concurrently
+[[nodiscard]] std::vector<std::vector<Entry>>
+decode_entry_frames_parallel(
+    std::span<const uint8_t> stream,
+    std::span<const ZstdDictionary *const> dictionaries = {},
+    Executor &executor = default_executor());
+
+} // namespace limcode
@@ -0,0 +1,159 @@
+#pragma once
+
+/**
+ * @file gossip.h
+ * @brief Packet-bounded batching of CRDS values
+ *
+ * Gossip push messages and pull responses carry as many CrdsValues as fit
+ * in one packet payload. CrdsPacketBatcher packs them greedily, in order,
+ * with each value serialized exactly once: it is written straight into the
+ * open packet, and if it overflows, its bytes are moved to a fresh packet
+ * instead of being re-encoded.
+ *
+ * Usage:
+ * @code
+ *   limcode::CrdsPacketBatcher batcher(limcode::GossipProtocolType::PushMessage,
+ *                                      self_pubkey);
+ *   for (const auto &value : values) {
+ *     batcher.push(value);
+ *   }
+ *   for (auto &packet : batcher.finish()) {
+ *     socket.send(packet);
+ *   }
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+
+namespace limcode {
+
+/// Gossip packet payload limit (Agave's PACKET_DATA_SIZE)
+constexpr size_t GOSSIP_PACKET_DATA_SIZE = 1232;
+
+/**
+ * @brief Protocol discriminants from Agave gossip/src/protocol.rs
+ */
+enum class GossipProtocolType : uint32_t {
+  PullRequest = 0,
+  PullResponse = 1,
+  PushMessage = 2,
+  PruneMessage = 3,
+  PingMessage = 4,
+  PongMessage = 5,
+};
+
+/**
+ * @brief Greedy packer for Protocol::PushMessage / Protocol::PullResponse
+ *
+ * Packet wire format:
+ * - discriminant: u32 (GossipProtocolType)
+ * - from: Pubkey
+ * - values: Vec<CrdsValue> (u64 count + values)
+ *
+ * Not thread-safe.
+ */
+class CrdsPacketBatcher {
+public:
+  /// Discriminant, pubkey and Vec length
+  static constexpr size_t HEADER_SIZE = 4 + PUBKEY_BYTES + 8;
+
+  /**
+   * @param kind PushMessage or PullResponse
+   * @param from Sender pubkey written into every packet
+   * @param max_packet_size Upper bound on each packet's size in bytes
+   */
+  CrdsPacketBatcher(GossipProtocolType kind, const Pubkey &from,
+                    size_t max_packet_size = GOSSIP_PACKET_DATA_SIZE)
+      : kind_(kind), from_(from), max_packet_size_(max_packet_size),
+        open_(max_packet_size) {
+    if (kind != GossipProtocolType::PushMessage &&
+        kind != GossipProtocolType::PullResponse) {
+      throw LimcodeError(ErrorCode::InvalidData,
+                         "CRDS batches are only PushMessage or PullResponse");
+    }
+    if (max_packet_size <= HEADER_SIZE) {
+      throw LimcodeError(ErrorCode::InvalidLength,
+                         "max_packet_size leaves no room for values");
+    }
+    write_header(open_);
+  }
+
+  /**
+   * @brief Append a value to the open packet, starting a new one if needed
+   * @return false if the value can't fit even in an empty packet (dropped)
+   */
+  bool push(const CrdsValue &value) {
+    size_t mark = open_.size();
+    open_.write_crds_value(value);
+    if (open_.size() <= max_packet_size_) {
+      ++open_count_;
+      return true;
+    }
+
+    size_t value_size = open_.size() - mark;
+    if (HEADER_SIZE + value_size > max_packet_size_) {
+      open_.resize(mark);
+      ++dropped_;
+      return false;
+    }
+
+    // Move the already-encoded value into a fresh packet
+    LimcodeEncoder next(max_packet_size_);
+    write_header(next);
+    next.write_bytes(open_.data().data() + mark, value_size);
+    open_.resize(mark);
+    close_packet();
+    open_ = std::move(next);
+    open_count_ = 1;
+    return true;
+  }
+
+  /**
+   * @brief Close the open packet and take every finished packet
+   *
+   * The batcher is empty afterwards and can be reused.
+   */
+  [[nodiscard]] std::vector<std::vector<uint8_t>> finish() {
+    close_packet();
+    open_ = LimcodeEncoder(max_packet_size_);
+    write_header(open_);
+    return std::move(packets_);
+  }
+
+  /// Packets closed so far (excluding the open one)
+  [[nodiscard]] size_t num_packets() const noexcept { return packets_.size(); }
+
+  /// Values in the open packet
+  [[nodiscard]] size_t open_values() const noexcept { return open_count_; }
+
+  /// Values rejected because they exceed an empty packet
+  [[nodiscard]] size_t dropped() const noexcept { return dropped_; }
+
+private:
+  GossipProtocolType kind_;
+  Pubkey from_;
+  size_t max_packet_size_;
+  LimcodeEncoder open_;
+  size_t open_count_ = 0;
+  size_t dropped_ = 0;
+  std::vector<std::vector<uint8_t>> packets_;
+
+  void write_header(LimcodeEncoder &encoder) const {
+    encoder.write_u32(static_cast<uint32_t>(kind_));
+    encoder.write_pod(from_);
+    encoder.write_u64(0); // patched in close_packet()
+  }
+
+  void close_packet() {
+    if (open_count_ == 0) {
+      return;
+    }
+    std::vector<uint8_t> packet = std::move(open_).finish();
+    uint64_t count = open_count_;
+    std::memcpy(packet.data() + 4 + PUBKEY_BYTES, &count, sizeof(count));
+    packets_.push_back(std::move(packet));
+    open_count_ = 0;
+  }
+};
+
+} // namespace limcode
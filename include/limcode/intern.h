@@ -0,0 +1,508 @@
+#pragma once
+
+/**
+ * @file intern.h
+ * @brief Batch decode that interns 32-byte keys into a per-batch table
+ *
+ * Within a block the same program IDs, sysvars, mints and recent blockhash
+ * appear in thousands of transactions. deserialize_entries() copies each
+ * of them into a fresh std::vector<Pubkey> per message. decode_entries_interned()
+ * instead stores every distinct key once in a KeyTable. Messages refer to
+ * keys by 32-bit KeyIndex, and all per-transaction lists live in a few flat
+ * arrays owned by the InternedBatch.
+ *
+ * A KeyIndex is dense (0..keys.size()), so account-lock and conflict
+ * checks can work on plain vectors or bitsets indexed by it instead of
+ * hashing Pubkeys. Two KeyIndexes are equal iff the keys are, within one
+ * batch.
+ *
+ * Usage:
+ * @code
+ *   limcode::InternedBatch batch;
+ *   limcode::decode_entries_interned(block_bytes, batch);
+ *   for (const auto &tx : batch.transactions) {
+ *     for (limcode::KeyIndex key : batch.account_keys(tx)) { ... }
+ *   }
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace limcode {
+
+/// Position of a key in a KeyTable
+using KeyIndex = uint32_t;
+
+namespace intern_detail {
+
+/// Per-process hash seed, so keys can't be crafted to collide
+inline const std::array<uint64_t, 4> &seed() {
+  static const std::array<uint64_t, 4> value = [] {
+    std::random_device rd;
+    std::array<uint64_t, 4> s{};
+    for (auto &word : s) {
+      word = (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+    return s;
+  }();
+  return value;
+}
+
+LIMCODE_ALWAYS_INLINE uint64_t fold(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  return static_cast<uint64_t>(product) ^
+         static_cast<uint64_t>(product >> 64);
+#else
+  uint64_t x = (a ^ (b >> 29)) * 0x9E3779B97F4A7C15ull;
+  return x ^ (x >> 32) ^ b;
+#endif
+}
+
+/// Seeded 128-bit multiply fold of the four words of a key
+LIMCODE_ALWAYS_INLINE uint64_t hash32(const uint8_t *key,
+                                      const std::array<uint64_t, 4> &s) noexcept {
+  uint64_t w[4];
+  std::memcpy(w, key, 32);
+  return fold(w[0] ^ s[0], w[1] ^ s[1]) ^ fold(w[2] ^ s[2], w[3] ^ s[3]);
+}
+
+LIMCODE_ALWAYS_INLINE bool equal32(const uint8_t *a, const uint8_t *b) noexcept {
+#if LIMCODE_HAS_SSE2
+  __m128i lo = _mm_cmpeq_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(a)),
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(b)));
+  __m128i hi = _mm_cmpeq_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + 16)),
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + 16)));
+  return _mm_movemask_epi8(_mm_and_si128(lo, hi)) == 0xFFFF;
+#else
+  return std::memcmp(a, b, 32) == 0;
+#endif
+}
+
+} // namespace intern_detail
+
+/**
+ * @brief Open-addressing set of 32-byte keys, numbered in insertion order
+ *
+ * Each slot packs the high half of the key's hash with index + 1, so most
+ * probes are rejected without touching the key. Load factor stays <= 1/2.
+ * clear() keeps the allocations for the next batch.
+ */
+class KeyTable {
+public:
+  /// Index of `key`, adding it if it is new
+  KeyIndex intern(const uint8_t *key) {
+    if ((keys_.size() + 1) * 2 > slots_.size()) {
+      grow();
+    }
+    uint64_t h = intern_detail::hash32(key, intern_detail::seed());
+    auto tag = static_cast<uint32_t>(h >> 32);
+    size_t mask = slots_.size() - 1;
+    for (size_t i = static_cast<size_t>(h) & mask;; i = (i + 1) & mask) {
+      uint64_t slot = slots_[i];
+      if (slot == 0) {
+        auto index = static_cast<KeyIndex>(keys_.size());
+        keys_.emplace_back();
+        limcode_copy32(keys_.back().data(), key);
+        slots_[i] = (static_cast<uint64_t>(tag) << 32) | (index + 1);
+        return index;
+      }
+      KeyIndex index = static_cast<uint32_t>(slot) - 1;
+      if (static_cast<uint32_t>(slot >> 32) == tag &&
+          intern_detail::equal32(keys_[index].data(), key)) {
+        return index;
+      }
+    }
+  }
+
+  KeyIndex intern(const Pubkey &key) { return intern(key.data()); }
+
+  /// Index of `key`, or NOT_FOUND
+  [[nodiscard]] KeyIndex find(const Pubkey &key) const {
+    if (slots_.empty()) {
+      return NOT_FOUND;
+    }
+    uint64_t h = intern_detail::hash32(key.data(), intern_detail::seed());
+    auto tag = static_cast<uint32_t>(h >> 32);
+    size_t mask = slots_.size() - 1;
+    for (size_t i = static_cast<size_t>(h) & mask;; i = (i + 1) & mask) {
+      uint64_t slot = slots_[i];
+      if (slot == 0) {
+        return NOT_FOUND;
+      }
+      KeyIndex index = static_cast<uint32_t>(slot) - 1;
+      if (static_cast<uint32_t>(slot >> 32) == tag &&
+          intern_detail::equal32(keys_[index].data(), key.data())) {
+        return index;
+      }
+    }
+  }
+
+  [[nodiscard]] const Pubkey &operator[](KeyIndex index) const {
+    return keys_[index];
+  }
+
+  [[nodiscard]] std::span<const Pubkey> keys() const { return keys_; }
+  [[nodiscard]] size_t size() const noexcept { return keys_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+
+  /// Reserve for an expected number of distinct keys
+  void reserve(size_t count) {
+    keys_.reserve(count);
+    size_t want = 64;
+    while (want < count * 2) {
+      want *= 2;
+    }
+    if (want > slots_.size()) {
+      rehash(want);
+    }
+  }
+
+  void clear() {
+    keys_.clear();
+    std::fill(slots_.begin(), slots_.end(), 0);
+  }
+
+  static constexpr KeyIndex NOT_FOUND = UINT32_MAX;
+
+private:
+  void grow() { rehash(slots_.empty() ? 64 : slots_.size() * 2); }
+
+  void rehash(size_t capacity) {
+    slots_.assign(capacity, 0);
+    const auto &s = intern_detail::seed();
+    size_t mask = capacity - 1;
+    for (size_t k = 0; k < keys_.size(); ++k) {
+      uint64_t h = intern_detail::hash32(keys_[k].data(), s);
+      size_t i = static_cast<size_t>(h) & mask;
+      while (slots_[i] != 0) {
+        i = (i + 1) & mask;
+      }
+      slots_[i] = ((h >> 32) << 32) | (k + 1);
+    }
+  }
+
+  std::vector<Pubkey> keys_;
+  std::vector<uint64_t> slots_; // (hash >> 32) << 32 | (index + 1), 0 = empty
+};
+
+/// Compiled instruction; accounts then data are stored in InternedBatch::bytes
+struct InternedInstruction {
+  uint8_t program_id_index = 0; // Into the message's account keys
+  uint16_t accounts_len = 0;
+  uint16_t data_len = 0;
+  uint32_t bytes_offset = 0;
+};
+
+/// Address table lookup; writable then readonly indexes are in bytes
+struct InternedLookup {
+  KeyIndex table = 0;
+  uint16_t writable_len = 0;
+  uint16_t readonly_len = 0;
+  uint32_t bytes_offset = 0;
+};
+
+/// Transaction whose lists are ranges of the InternedBatch arrays
+struct InternedTransaction {
+  bool is_v0 = false;
+  MessageHeader header;
+  uint16_t num_signatures = 0;
+  uint16_t num_keys = 0;
+  uint16_t num_instructions = 0;
+  uint16_t num_lookups = 0;
+  KeyIndex recent_blockhash = 0; // Interned alongside the account keys
+  uint32_t first_signature = 0;
+  uint32_t first_key = 0;
+  uint32_t first_instruction = 0;
+  uint32_t first_lookup = 0;
+};
+
+struct InternedEntry {
+  uint64_t num_hashes = 0;
+  Hash hash{};
+  uint32_t first_transaction = 0;
+  uint32_t num_transactions = 0;
+};
+
+/**
+ * @brief A decoded Vec<Entry> with keys and blockhashes interned
+ *
+ * Reuse one batch across blocks; clear() keeps the allocated capacity.
+ */
+struct InternedBatch {
+  KeyTable keys;                           // Account keys, blockhashes, ALTs
+  std::vector<InternedEntry> entries;
+  std::vector<InternedTransaction> transactions;
+  std::vector<Signature> signatures;
+  std::vector<KeyIndex> message_keys;      // Per transaction, in key order
+  std::vector<InternedInstruction> instructions;
+  std::vector<InternedLookup> lookups;
+  std::vector<uint8_t> bytes;              // Instruction and lookup indexes
+
+  void clear() {
+    keys.clear();
+    entries.clear();
+    transactions.clear();
+    signatures.clear();
+    message_keys.clear();
+    instructions.clear();
+    lookups.clear();
+    bytes.clear();
+  }
+
+  [[nodiscard]] const Pubkey &key(KeyIndex index) const { return keys[index]; }
+
+  [[nodiscard]] std::span<const InternedTransaction>
+  transactions_of(const InternedEntry &entry) const {
+    return {transactions.data() + entry.first_transaction,
+            entry.num_transactions};
+  }
+
+  [[nodiscard]] std::span<const Signature>
+  signatures_of(const InternedTransaction &tx) const {
+    return {signatures.data() + tx.first_signature, tx.num_signatures};
+  }
+
+  /// Static account keys of a message (v0 lookups are not resolved)
+  [[nodiscard]] std::span<const KeyIndex>
+  account_keys(const InternedTransaction &tx) const {
+    return {message_keys.data() + tx.first_key, tx.num_keys};
+  }
+
+  [[nodiscard]] std::span<const InternedInstruction>
+  instructions_of(const InternedTransaction &tx) const {
+    return {instructions.data() + tx.first_instruction, tx.num_instructions};
+  }
+
+  [[nodiscard]] std::span<const InternedLookup>
+  lookups_of(const InternedTransaction &tx) const {
+    return {lookups.data() + tx.first_lookup, tx.num_lookups};
+  }
+
+  [[nodiscard]] std::span<const uint8_t>
+  accounts(const InternedInstruction &ix) const {
+    return {bytes.data() + ix.bytes_offset, ix.accounts_len};
+  }
+
+  [[nodiscard]] std::span<const uint8_t>
+  data(const InternedInstruction &ix) const {
+    return {bytes.data() + ix.bytes_offset + ix.accounts_len, ix.data_len};
+  }
+
+  [[nodiscard]] std::span<const uint8_t>
+  writable_indexes(const InternedLookup &lookup) const {
+    return {bytes.data() + lookup.bytes_offset, lookup.writable_len};
+  }
+
+  [[nodiscard]] std::span<const uint8_t>
+  readonly_indexes(const InternedLookup &lookup) const {
+    return {bytes.data() + lookup.bytes_offset + lookup.writable_len,
+            lookup.readonly_len};
+  }
+
+  /**
+   * @brief Whether static key `position` of `tx` is writable per its header
+   *
+   * Header rule only: signed keys before the readonly-signed tail, and
+   * unsigned keys before the readonly-unsigned tail.
+   */
+  [[nodiscard]] bool is_writable(const InternedTransaction &tx,
+                                 size_t position) const noexcept {
+    const MessageHeader &h = tx.header;
+    if (position < h.num_required_signatures) {
+      return position < static_cast<size_t>(h.num_required_signatures -
+                                            h.num_readonly_signed_accounts);
+    }
+    return position + h.num_readonly_unsigned_accounts < tx.num_keys;
+  }
+
+  /// Rebuild the owned transaction (for interop; copies every key)
+  [[nodiscard]] VersionedTransaction
+  to_transaction(const InternedTransaction &tx) const {
+    VersionedTransaction out;
+    auto sigs = signatures_of(tx);
+    out.signatures.assign(sigs.begin(), sigs.end());
+
+    auto fill = [&](auto &msg) {
+      msg.header = tx.header;
+      msg.account_keys.reserve(tx.num_keys);
+      for (KeyIndex k : account_keys(tx)) {
+        msg.account_keys.push_back(keys[k]);
+      }
+      msg.recent_blockhash = keys[tx.recent_blockhash];
+      msg.instructions.reserve(tx.num_instructions);
+      for (const auto &ix : instructions_of(tx)) {
+        auto acc = accounts(ix);
+        auto dat = data(ix);
+        msg.instructions.push_back(CompiledInstruction{
+            ix.program_id_index, {acc.begin(), acc.end()},
+            {dat.begin(), dat.end()}});
+      }
+    };
+
+    if (tx.is_v0) {
+      V0Message msg;
+      fill(msg);
+      msg.address_table_lookups.reserve(tx.num_lookups);
+      for (const auto &lookup : lookups_of(tx)) {
+        auto w = writable_indexes(lookup);
+        auto r = readonly_indexes(lookup);
+        msg.address_table_lookups.push_back(AddressTableLookup{
+            keys[lookup.table], {w.begin(), w.end()}, {r.begin(), r.end()}});
+      }
+      out.message.set_v0(std::move(msg));
+    } else {
+      LegacyMessage msg;
+      fill(msg);
+      out.message.set_legacy(std::move(msg));
+    }
+    return out;
+  }
+
+  /// Rebuild owned entries, equal to deserialize_entries() of the input
+  [[nodiscard]] std::vector<Entry> to_entries() const {
+    std::vector<Entry> out;
+    out.reserve(entries.size());
+    for (const auto &entry : entries) {
+      Entry e;
+      e.num_hashes = entry.num_hashes;
+      e.hash = entry.hash;
+      e.transactions.reserve(entry.num_transactions);
+      for (const auto &tx : transactions_of(entry)) {
+        e.transactions.push_back(to_transaction(tx));
+      }
+      out.push_back(std::move(e));
+    }
+    return out;
+  }
+};
+
+namespace intern_detail {
+
+/// Append a ShortVec-prefixed byte list to `bytes`, returning its length
+inline uint16_t read_byte_list(StructuredZeroCopyDecoder &decoder,
+                               std::vector<uint8_t> &bytes) {
+  auto view = decoder.read_byte_vec_view();
+  bytes.insert(bytes.end(), view.begin(), view.end());
+  return static_cast<uint16_t>(view.size());
+}
+
+inline void read_transaction(StructuredZeroCopyDecoder &decoder,
+                             InternedBatch &batch) {
+  InternedTransaction tx;
+
+  tx.num_signatures = decoder.read_short_vec_len();
+  tx.first_signature = static_cast<uint32_t>(batch.signatures.size());
+  auto sigs = decoder.read_bytes_view(static_cast<size_t>(tx.num_signatures) *
+                                      SIGNATURE_BYTES);
+  batch.signatures.resize(batch.signatures.size() + tx.num_signatures);
+  if (tx.num_signatures != 0) {
+    std::memcpy(batch.signatures[tx.first_signature].data(), sigs.data(),
+                sigs.size());
+  }
+
+  uint8_t first = decoder.read_u8();
+  tx.is_v0 = (first & VERSION_PREFIX_MASK) != 0;
+  if (tx.is_v0) {
+    if ((first & 0x7F) != 0) {
+      throw LimcodeError::invalid_version(first & 0x7F);
+    }
+    first = decoder.read_u8();
+  }
+  tx.header.num_required_signatures = first;
+  tx.header.num_readonly_signed_accounts = decoder.read_u8();
+  tx.header.num_readonly_unsigned_accounts = decoder.read_u8();
+
+  tx.num_keys = decoder.read_short_vec_len();
+  tx.first_key = static_cast<uint32_t>(batch.message_keys.size());
+  auto keys = decoder.read_bytes_view(static_cast<size_t>(tx.num_keys) *
+                                      PUBKEY_BYTES);
+  for (uint16_t k = 0; k < tx.num_keys; ++k) {
+    batch.message_keys.push_back(
+        batch.keys.intern(keys.data() + k * PUBKEY_BYTES));
+  }
+  tx.recent_blockhash = batch.keys.intern(decoder.read_hash_view().data);
+
+  tx.num_instructions = decoder.read_short_vec_len();
+  tx.first_instruction = static_cast<uint32_t>(batch.instructions.size());
+  for (uint16_t i = 0; i < tx.num_instructions; ++i) {
+    InternedInstruction ix;
+    ix.program_id_index = decoder.read_u8();
+    ix.bytes_offset = static_cast<uint32_t>(batch.bytes.size());
+    ix.accounts_len = read_byte_list(decoder, batch.bytes);
+    ix.data_len = read_byte_list(decoder, batch.bytes);
+    batch.instructions.push_back(ix);
+  }
+
+  tx.first_lookup = static_cast<uint32_t>(batch.lookups.size());
+  if (tx.is_v0) {
+    tx.num_lookups = decoder.read_short_vec_len();
+    for (uint16_t i = 0; i < tx.num_lookups; ++i) {
+      InternedLookup lookup;
+      lookup.table = batch.keys.intern(decoder.read_pubkey_view().data);
+      lookup.bytes_offset = static_cast<uint32_t>(batch.bytes.size());
+      lookup.writable_len = read_byte_list(decoder, batch.bytes);
+      lookup.readonly_len = read_byte_list(decoder, batch.bytes);
+      batch.lookups.push_back(lookup);
+    }
+  }
+
+  batch.transactions.push_back(tx);
+}
+
+} // namespace intern_detail
+
+/**
+ * @brief Decode a serialized Vec<Entry> into `batch`, interning its keys
+ *
+ * Clears `batch` first. batch.to_entries() returns what
+ * deserialize_entries() would; like the view decoders, message versions
+ * other than 0 are rejected.
+ *
+ * @return Number of entries decoded
+ * @throws LimcodeError on truncated or malformed input, or input over 4 GiB
+ */
+inline size_t decode_entries_interned(std::span<const uint8_t> data,
+                                      InternedBatch &batch) {
+  LIMCODE_METRIC_TIME(Decode);
+  batch.clear();
+  // Every 32-bit offset into the batch arrays is bounded by the input size
+  if (data.size() > UINT32_MAX) {
+    throw LimcodeError::invalid_encoding(
+        "interned batch exceeds 4 GiB of input");
+  }
+
+  StructuredZeroCopyDecoder decoder(data);
+  uint64_t count = decoder.read_u64();
+  if (count > decoder.remaining() / MIN_ENTRY_BYTES) {
+    throw LimcodeError::invalid_encoding("entry count exceeds input size");
+  }
+
+  batch.entries.reserve(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    InternedEntry entry;
+    entry.num_hashes = decoder.read_u64();
+    entry.hash = decoder.read_hash_view().to_array();
+    entry.num_transactions = decoder.read_short_vec_len();
+    entry.first_transaction = static_cast<uint32_t>(batch.transactions.size());
+    for (uint32_t t = 0; t < entry.num_transactions; ++t) {
+      intern_detail::read_transaction(decoder, batch);
+    }
+    batch.entries.push_back(entry);
+  }
+  LIMCODE_METRIC_ADD(BytesDecoded, decoder.position());
+  LIMCODE_METRIC_ADD(EntriesDecoded, count);
+  return static_cast<size_t>(count);
+}
+
+} // namespace limcode
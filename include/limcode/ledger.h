@@ -0,0 +1,540 @@
+#pragma once
+
+/**
+ * @file ledger.h
+ * @brief Append-only entry ledger: mmap'd segment files plus a slot index
+ *
+ * Each slot is stored as its serialize_entries() bytes, back to back in
+ * segment files (segment-000000.dat, ...). ledger.idx is a 16-byte header
+ * followed by one 32-byte LedgerSlot record per slot, saying where those
+ * bytes are. Reading a slot back maps the segment and walks it with
+ * StructuredZeroCopyDecoder: replay and block fetches become page-cache
+ * reads returning EntryViews, with no decode into owned Entries.
+ *
+ * Writes are group-committed. append() only serializes into a pending
+ * buffer. commit() writes that buffer with one write(), fdatasyncs the
+ * segment, then appends the index records and fdatasyncs the index. An
+ * index record is therefore never durable before the bytes it points at.
+ * Reopening a writer drops any torn index record and segment bytes no
+ * record covers.
+ *
+ * Usage:
+ * @code
+ *   limcode::LedgerWriter writer;
+ *   writer.open("ledger");
+ *   writer.append(slot, entries);   // fsync'd at commit() / sync_bytes
+ *   writer.commit();
+ *
+ *   limcode::LedgerReader reader;
+ *   reader.open("ledger");
+ *   for (const limcode::EntryView &entry : reader.entries(slot)) { ... }
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+
+#if LIMCODE_HAS_MMAP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace limcode {
+
+constexpr char LEDGER_INDEX_MAGIC[8] = {'L', 'I', 'M', 'L', 'E', 'D', 'G', '1'};
+constexpr uint32_t LEDGER_VERSION = 1;
+constexpr size_t LEDGER_INDEX_HEADER_SIZE = 16;
+
+/// Index record: where one slot's serialized Vec<Entry> lives
+struct LedgerSlot {
+  uint64_t slot;
+  uint64_t offset;      ///< Byte offset in the segment
+  uint32_t size;        ///< serialize_entries() bytes
+  uint32_t segment;     ///< Segment file number
+  uint32_t entry_count;
+  uint32_t crc32c;      ///< Crc32c of the bytes, computed while encoding
+};
+static_assert(sizeof(LedgerSlot) == 32, "LedgerSlot is an on-disk record");
+
+/// Tuning knobs for LedgerWriter
+struct LedgerOptions {
+  /// Start a new segment once the current one would grow past this
+  size_t segment_size = size_t(256) << 20;
+  /// commit() automatically once this many bytes are pending (0 = never)
+  size_t sync_bytes = size_t(8) << 20;
+  /// fdatasync on commit; false leaves durability to the page cache
+  bool sync = true;
+};
+
+namespace ledger_detail {
+
+inline std::string segment_path(const std::string &dir, uint32_t segment) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "segment-%06u.dat", segment);
+  return (std::filesystem::path(dir) / name).string();
+}
+
+inline std::string index_path(const std::string &dir) {
+  return (std::filesystem::path(dir) / "ledger.idx").string();
+}
+
+inline bool write_all(int fd, const uint8_t *data, size_t len) {
+  while (len > 0) {
+    ssize_t n = ::write(fd, data, len);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += n;
+    len -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+inline bool read_all(int fd, uint8_t *data, size_t len, off_t offset) {
+  while (len > 0) {
+    ssize_t n = ::pread(fd, data, len, offset);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    len -= static_cast<size_t>(n);
+    offset += n;
+  }
+  return true;
+}
+
+/// Make a newly created file's directory entry durable
+inline bool sync_dir(const std::string &dir) {
+  int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+  if (fd < 0) {
+    return false;
+  }
+  bool ok = ::fsync(fd) == 0;
+  ::close(fd);
+  return ok;
+}
+
+inline bool check_index_header(const uint8_t *header) {
+  uint32_t version;
+  std::memcpy(&version, header + 8, 4);
+  return std::memcmp(header, LEDGER_INDEX_MAGIC, 8) == 0 &&
+         version == LEDGER_VERSION;
+}
+
+inline void make_index_header(uint8_t *header) {
+  std::memset(header, 0, LEDGER_INDEX_HEADER_SIZE);
+  std::memcpy(header, LEDGER_INDEX_MAGIC, 8);
+  std::memcpy(header + 8, &LEDGER_VERSION, 4);
+}
+
+} // namespace ledger_detail
+
+/**
+ * @brief Appends slots to a ledger directory with grouped fsyncs
+ *
+ * One writer per directory; not thread-safe. Readers in other threads or
+ * processes see slots once commit() returns (after LedgerReader::open).
+ */
+class LedgerWriter {
+public:
+  LedgerWriter() = default;
+  explicit LedgerWriter(LedgerOptions options) : options_(options) {}
+  ~LedgerWriter() { close(); }
+
+  LedgerWriter(const LedgerWriter &) = delete;
+  LedgerWriter &operator=(const LedgerWriter &) = delete;
+
+  /**
+   * @brief Create `dir` or reopen an existing ledger for appending
+   *
+   * Recovers from a crash mid-commit: a torn index record and segment
+   * bytes past the last indexed slot are truncated away.
+   */
+  bool open(const std::string &dir) {
+    close();
+    dir_ = dir;
+    std::error_code ec;
+    std::filesystem::create_directories(dir_, ec);
+    if (ec) {
+      return false;
+    }
+
+    std::string index_path = ledger_detail::index_path(dir_);
+    bool created = !std::filesystem::exists(index_path, ec);
+    index_fd_ = ::open(index_path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (index_fd_ < 0) {
+      return false;
+    }
+    struct stat st;
+    if (::fstat(index_fd_, &st) < 0) {
+      return fail();
+    }
+
+    uint8_t header[LEDGER_INDEX_HEADER_SIZE];
+    size_t index_size = static_cast<size_t>(st.st_size);
+    if (index_size < LEDGER_INDEX_HEADER_SIZE) {
+      // New, or torn before its header was durable
+      ledger_detail::make_index_header(header);
+      if (::ftruncate(index_fd_, 0) < 0 ||
+          !ledger_detail::write_all(index_fd_, header, sizeof(header)) ||
+          (created && options_.sync && !ledger_detail::sync_dir(dir_))) {
+        return fail();
+      }
+      index_size = LEDGER_INDEX_HEADER_SIZE;
+    } else if (!ledger_detail::read_all(index_fd_, header, sizeof(header), 0) ||
+               !ledger_detail::check_index_header(header)) {
+      return fail();
+    }
+
+    // Load the committed records; a partial trailing record is dropped
+    size_t count = (index_size - LEDGER_INDEX_HEADER_SIZE) / sizeof(LedgerSlot);
+    std::vector<LedgerSlot> records(count);
+    if (count > 0 &&
+        !ledger_detail::read_all(
+            index_fd_, reinterpret_cast<uint8_t *>(records.data()),
+            count * sizeof(LedgerSlot), LEDGER_INDEX_HEADER_SIZE)) {
+      return fail();
+    }
+    uint64_t segment_end = 0;
+    for (const LedgerSlot &record : records) {
+      slots_.insert(record.slot);
+      if (record.segment > segment_) {
+        segment_ = record.segment;
+        segment_end = 0;
+      }
+      if (record.segment == segment_) {
+        segment_end = std::max(segment_end, record.offset + record.size);
+      }
+    }
+    off_t index_end =
+        static_cast<off_t>(LEDGER_INDEX_HEADER_SIZE + count * sizeof(LedgerSlot));
+    if (::ftruncate(index_fd_, index_end) < 0 ||
+        ::lseek(index_fd_, index_end, SEEK_SET) < 0) {
+      return fail();
+    }
+    return open_segment(segment_end) || fail();
+  }
+
+  /**
+   * @brief Queue `entries` as `slot`
+   *
+   * Nothing reaches disk until commit(), which runs automatically once
+   * sync_bytes are pending.
+   *
+   * @return false if the slot is already stored, its encoding exceeds 4 GiB,
+   *         or an automatic commit failed
+   */
+  bool append(uint64_t slot, const std::vector<Entry> &entries) {
+    if (index_fd_ < 0 || slots_.count(slot) != 0) {
+      return false;
+    }
+    size_t size = serialized_size(entries);
+    if (size > UINT32_MAX) {
+      return false;
+    }
+    // Roll over before this slot would push the segment past segment_size
+    if (segment_size_ + pending_.size() > 0 &&
+        segment_size_ + pending_.size() + size > options_.segment_size) {
+      if (!commit() || !next_segment()) {
+        return false;
+      }
+    }
+
+    LedgerSlot record{};
+    record.slot = slot;
+    record.offset = segment_size_ + pending_.size();
+    record.size = static_cast<uint32_t>(size);
+    record.segment = segment_;
+    record.entry_count = static_cast<uint32_t>(entries.size());
+
+    size_t start = pending_.size();
+    pending_.resize(start + size);
+    Crc32c crc;
+    serialize_entries_into(entries,
+                           std::span<uint8_t>(pending_.data() + start, size),
+                           crc);
+    record.crc32c = crc.value();
+    pending_records_.push_back(record);
+    slots_.insert(slot);
+
+    if (options_.sync_bytes != 0 && pending_.size() >= options_.sync_bytes) {
+      return commit();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Write and fsync everything appended so far
+   *
+   * Segment data is made durable before the index records that point at it.
+   * On failure the pending slots are dropped and the writer must be
+   * reopened.
+   */
+  bool commit() {
+    if (pending_records_.empty()) {
+      return index_fd_ >= 0;
+    }
+    bool ok =
+        ledger_detail::write_all(segment_fd_, pending_.data(), pending_.size()) &&
+        (!options_.sync || ::fdatasync(segment_fd_) == 0) &&
+        ledger_detail::write_all(
+            index_fd_, reinterpret_cast<const uint8_t *>(pending_records_.data()),
+            pending_records_.size() * sizeof(LedgerSlot)) &&
+        (!options_.sync || ::fdatasync(index_fd_) == 0);
+    if (!ok) {
+      for (const LedgerSlot &record : pending_records_) {
+        slots_.erase(record.slot);
+      }
+      pending_.clear();
+      pending_records_.clear();
+      fail();
+      return false;
+    }
+    segment_size_ += pending_.size();
+    pending_.clear();
+    pending_records_.clear();
+    return true;
+  }
+
+  /// commit() and close the files
+  bool close() {
+    bool ok = commit();
+    if (segment_fd_ >= 0) {
+      ::close(segment_fd_);
+      segment_fd_ = -1;
+    }
+    if (index_fd_ >= 0) {
+      ::close(index_fd_);
+      index_fd_ = -1;
+    }
+    slots_.clear();
+    segment_ = 0;
+    segment_size_ = 0;
+    return ok;
+  }
+
+  [[nodiscard]] bool is_open() const noexcept { return index_fd_ >= 0; }
+  [[nodiscard]] bool contains(uint64_t slot) const {
+    return slots_.count(slot) != 0;
+  }
+  [[nodiscard]] size_t num_slots() const noexcept { return slots_.size(); }
+  [[nodiscard]] size_t pending_bytes() const noexcept { return pending_.size(); }
+  [[nodiscard]] uint32_t segment() const noexcept { return segment_; }
+
+private:
+  bool fail() {
+    int segment_fd = std::exchange(segment_fd_, -1);
+    int index_fd = std::exchange(index_fd_, -1);
+    if (segment_fd >= 0) {
+      ::close(segment_fd);
+    }
+    if (index_fd >= 0) {
+      ::close(index_fd);
+    }
+    return false;
+  }
+
+  /// Open the current segment, dropping bytes past `end` (never committed)
+  bool open_segment(uint64_t end) {
+    std::string path = ledger_detail::segment_path(dir_, segment_);
+    std::error_code ec;
+    bool created = !std::filesystem::exists(path, ec);
+    segment_fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (segment_fd_ < 0 || ::ftruncate(segment_fd_, static_cast<off_t>(end)) < 0 ||
+        ::lseek(segment_fd_, static_cast<off_t>(end), SEEK_SET) < 0 ||
+        (created && options_.sync && !ledger_detail::sync_dir(dir_))) {
+      return false;
+    }
+    segment_size_ = end;
+    return true;
+  }
+
+  bool next_segment() {
+    ::close(segment_fd_);
+    segment_fd_ = -1;
+    ++segment_;
+    return open_segment(0) || fail();
+  }
+
+  LedgerOptions options_;
+  std::string dir_;
+  int index_fd_ = -1;
+  int segment_fd_ = -1;
+  uint32_t segment_ = 0;
+  uint64_t segment_size_ = 0; ///< Committed bytes in the current segment
+  std::unordered_set<uint64_t> slots_;
+  std::vector<uint8_t> pending_;
+  std::vector<LedgerSlot> pending_records_;
+};
+
+/**
+ * @brief Zero-copy reads of a ledger directory
+ *
+ * open() maps the index and every segment; slots committed afterwards are
+ * picked up by open()ing again, which invalidates earlier views. Const
+ * methods are safe to call from several threads.
+ */
+class LedgerReader {
+public:
+  LedgerReader() = default;
+
+  LedgerReader(const LedgerReader &) = delete;
+  LedgerReader &operator=(const LedgerReader &) = delete;
+  LedgerReader(LedgerReader &&) = default;
+  LedgerReader &operator=(LedgerReader &&) = default;
+
+  /**
+   * @brief Map `dir` written by LedgerWriter
+   * @return false if the index is missing or corrupt, or a record points
+   *         past the end of its segment
+   */
+  bool open(const std::string &dir) {
+    close();
+    MappedFile index;
+    if (!index.open(ledger_detail::index_path(dir).c_str()) ||
+        index.size() < LEDGER_INDEX_HEADER_SIZE ||
+        !ledger_detail::check_index_header(index.data())) {
+      return false;
+    }
+    size_t count =
+        (index.size() - LEDGER_INDEX_HEADER_SIZE) / sizeof(LedgerSlot);
+    slots_.resize(count);
+    if (count > 0) {
+      std::memcpy(slots_.data(), index.data() + LEDGER_INDEX_HEADER_SIZE,
+                  count * sizeof(LedgerSlot));
+    }
+    std::sort(slots_.begin(), slots_.end(),
+              [](const LedgerSlot &a, const LedgerSlot &b) {
+                return a.slot < b.slot;
+              });
+
+    uint32_t segments = 0;
+    for (const LedgerSlot &record : slots_) {
+      segments = std::max(segments, record.segment + 1);
+    }
+    segments_.resize(segments);
+    for (uint32_t s = 0; s < segments; ++s) {
+      // Slot lookups jump around; don't read ahead
+      if (!segments_[s].open(ledger_detail::segment_path(dir, s).c_str(),
+                             MADV_RANDOM)) {
+        close();
+        return false;
+      }
+    }
+    for (const LedgerSlot &record : slots_) {
+      if (record.offset + record.size > segments_[record.segment].size()) {
+        close();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void close() {
+    slots_.clear();
+    segments_.clear();
+  }
+
+  /// Index record of `slot`, or nullptr if it isn't stored
+  [[nodiscard]] const LedgerSlot *find(uint64_t slot) const {
+    auto it = std::lower_bound(
+        slots_.begin(), slots_.end(), slot,
+        [](const LedgerSlot &record, uint64_t s) { return record.slot < s; });
+    return it != slots_.end() && it->slot == slot ? &*it : nullptr;
+  }
+
+  [[nodiscard]] bool contains(uint64_t slot) const {
+    return find(slot) != nullptr;
+  }
+
+  /// serialize_entries() bytes of `slot` (empty if not stored), in the mapping
+  [[nodiscard]] std::span<const uint8_t> slot_bytes(uint64_t slot) const {
+    const LedgerSlot *record = find(slot);
+    if (!record) {
+      return {};
+    }
+    return segments_[record->segment].as_span().subspan(record->offset,
+                                                        record->size);
+  }
+
+  /**
+   * @brief Entries of `slot` as views into the mapped segment
+   *
+   * Views stay valid until the reader is closed or reopened. Empty if the
+   * slot isn't stored.
+   *
+   * @throws LimcodeError if the stored bytes are corrupt
+   */
+  [[nodiscard]] std::vector<EntryView> entries(uint64_t slot) const {
+    std::vector<EntryView> views;
+    entries_into(slot, views);
+    return views;
+  }
+
+  /// entries(), reusing `views` (cleared first); false if not stored
+  bool entries_into(uint64_t slot, std::vector<EntryView> &views) const {
+    views.clear();
+    const LedgerSlot *record = find(slot);
+    if (!record) {
+      return false;
+    }
+    StructuredZeroCopyDecoder decoder(slot_bytes(slot));
+    if (decoder.read_u64() != record->entry_count) {
+      throw LimcodeError::invalid_encoding("ledger entry count mismatch");
+    }
+    views.reserve(record->entry_count);
+    for (uint32_t i = 0; i < record->entry_count; ++i) {
+      views.push_back(decoder.read_entry_view());
+    }
+    return true;
+  }
+
+  /// Owned entries of `slot` (a full decode; prefer entries()); empty if not stored
+  [[nodiscard]] std::vector<Entry> read_entries(uint64_t slot) const {
+    if (!contains(slot)) {
+      return {};
+    }
+    return deserialize_entries(slot_bytes(slot));
+  }
+
+  /// Recompute the slot's CRC-32C against the index; false if not stored
+  [[nodiscard]] bool verify(uint64_t slot) const {
+    const LedgerSlot *record = find(slot);
+    return record && Crc32c::compute(slot_bytes(slot)) == record->crc32c;
+  }
+
+  /// Every stored slot, ascending
+  [[nodiscard]] std::span<const LedgerSlot> slots() const noexcept {
+    return slots_;
+  }
+  [[nodiscard]] size_t num_slots() const noexcept { return slots_.size(); }
+  [[nodiscard]] size_t num_segments() const noexcept {
+    return segments_.size();
+  }
+
+private:
+  std::vector<LedgerSlot> slots_;
+  std::vector<MappedFile> segments_;
+};
+
+} // namespace limcode
+
+#endif // LIMCODE_HAS_MMAP
@@ -58,8 +58,12 @@
  */
 
 #include <array>
+#include <bit>
 #include <cstdint>
 #include <cstring>
+#include <exception>
+#include <iterator>
+#include <new>
 #include <optional>
 #include <span>
 #include <stdexcept>
@@ -76,30 +80,19 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include "executor.h"
 
 // Standard algorithm headers (always needed)
 #include <algorithm>
 #include <functional>
 #include <numeric>
 
-// Parallel STL includes (optional, must be before namespace)
-#if __cplusplus >= 201703L && __has_include(<execution>) && !defined(LIMCODE_NO_PARALLEL)
-#include <execution>
-// Check if parallel execution is actually available
-#if defined(__cpp_lib_execution) && __cpp_lib_execution >= 201902L
-#define LIMCODE_HAS_PARALLEL_EXECUTION 1
-#endif
-#endif
-
-#ifndef LIMCODE_HAS_PARALLEL_EXECUTION
-#define LIMCODE_HAS_PARALLEL_EXECUTION 0
-#endif
-
 // Memory-mapped file support (Unix/macOS)
 #if defined(__unix__) || defined(__APPLE__)
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #define LIMCODE_HAS_MMAP 1
 #else
@@ -131,6 +124,15 @@
 #define LIMCODE_HAS_AVX512 0
 #endif
 
+// Runtime-dispatched bulk kernels (independent of the -m flags above)
+#include "simd_dispatch.h"
+
+// Crc32c / Sha256 for the fused digest paths
+#include "digest.h"
+
+// LIMCODE_METRIC_* hooks (no-ops unless LIMCODE_ENABLE_METRICS)
+#include "metrics.h"
+
 namespace limcode {
 
 // ==================== Constants ====================
@@ -192,6 +194,13 @@ public:
                             " bytes, have " + std::to_string(available));
   }
 
+  [[nodiscard]] static LimcodeError buffer_overflow(size_t needed,
+                                                    size_t available) {
+    return LimcodeError(ErrorCode::BufferOverflow,
+                        "Buffer overflow: need " + std::to_string(needed) +
+                            " bytes, have " + std::to_string(available));
+  }
+
   [[nodiscard]] static LimcodeError invalid_encoding(std::string_view detail) {
     return LimcodeError(ErrorCode::InvalidEncoding,
                         "Invalid encoding: " + std::string(detail));
@@ -473,11 +482,14 @@ struct GossipVersion {
 };
 
 /**
- * @brief IP address (IPv4 only for now)
+ * @brief IP address matching Rust's std::net::IpAddr
+ *
+ * Only the bytes for the active family are meaningful.
  */
 struct GossipIpAddr {
   bool is_v4 = true;
   std::array<uint8_t, 4> v4_bytes{};
+  std::array<uint8_t, 16> v6_bytes{};
 
   bool operator==(const GossipIpAddr &) const = default;
 };
@@ -528,6 +540,357 @@ enum class CrdsDataType : uint32_t {
   RestartHeaviestFork = 13,
 };
 
+/**
+ * @brief SocketAddr matching Rust's std::net::SocketAddr
+ *
+ * Wire format (bincode enum):
+ * - discriminant: u32 (0=V4, 1=V6)
+ * - ip: 4 or 16 bytes
+ * - port: u16
+ */
+struct GossipSocketAddr {
+  GossipIpAddr ip;
+  uint16_t port = 0;
+
+  bool operator==(const GossipSocketAddr &) const = default;
+};
+
+/**
+ * @brief (slot, hash) pair used by the snapshot/accounts hash variants
+ */
+struct GossipSlotHash {
+  uint64_t slot = 0;
+  Hash hash{};
+
+  bool operator==(const GossipSlotHash &) const = default;
+};
+
+/**
+ * @brief bv::BitVec<u8>
+ *
+ * Wire format:
+ * - blocks: Option<Box<[u8]>> (u8 tag, then u64 length + bytes)
+ * - len: u64 (number of bits)
+ *
+ * Empty `blocks` encodes as None.
+ */
+struct GossipBitVec {
+  std::vector<uint8_t> blocks;
+  uint64_t len = 0;
+
+  bool operator==(const GossipBitVec &) const = default;
+};
+
+/**
+ * @brief CrdsData::LegacyContactInfo(0)
+ *
+ * Wire format: id, ten SocketAddrs in field order, wallclock: u64,
+ * shred_version: u16.
+ */
+struct GossipLegacyContactInfo {
+  Pubkey id{};
+  GossipSocketAddr gossip;
+  GossipSocketAddr tvu;
+  GossipSocketAddr tvu_quic;
+  GossipSocketAddr serve_repair_quic;
+  GossipSocketAddr tpu;
+  GossipSocketAddr tpu_forwards;
+  GossipSocketAddr tpu_vote;
+  GossipSocketAddr rpc;
+  GossipSocketAddr rpc_pubsub;
+  GossipSocketAddr serve_repair;
+  uint64_t wallclock = 0;
+  uint16_t shred_version = 0;
+
+  bool operator==(const GossipLegacyContactInfo &) const = default;
+};
+
+/**
+ * @brief CrdsData::Vote(1)
+ *
+ * Wire format: index: u8, from: Pubkey, transaction: legacy Transaction,
+ * wallclock: u64. The transaction must carry a legacy message.
+ */
+struct GossipVote {
+  uint8_t index = 0;
+  Pubkey from{};
+  VersionedTransaction transaction;
+  uint64_t wallclock = 0;
+
+  bool operator==(const GossipVote &) const = default;
+};
+
+/**
+ * @brief CrdsData::LowestSlot(2)
+ *
+ * Wire format: deprecated u8 (0), from: Pubkey, root: u64, lowest: u64,
+ * slots: BTreeSet<u64>, stash: Vec<EpochIncompleteSlots>, wallclock: u64.
+ * Agave rejects non-empty slots/stash, so they are written empty and
+ * rejected on read.
+ */
+struct GossipLowestSlot {
+  Pubkey from{};
+  uint64_t root = 0;
+  uint64_t lowest = 0;
+  uint64_t wallclock = 0;
+
+  bool operator==(const GossipLowestSlot &) const = default;
+};
+
+/**
+ * @brief Shared shape of LegacySnapshotHashes(3) and AccountsHashes(4)
+ *
+ * Wire format: from: Pubkey, hashes: Vec<(u64, Hash)>, wallclock: u64.
+ */
+struct GossipSlotHashes {
+  Pubkey from{};
+  std::vector<GossipSlotHash> hashes;
+  uint64_t wallclock = 0;
+
+  bool operator==(const GossipSlotHashes &) const = default;
+};
+
+/// CrdsData::LegacySnapshotHashes(3)
+struct GossipLegacySnapshotHashes : GossipSlotHashes {
+  bool operator==(const GossipLegacySnapshotHashes &) const = default;
+};
+
+/// CrdsData::AccountsHashes(4)
+struct GossipAccountsHashes : GossipSlotHashes {
+  bool operator==(const GossipAccountsHashes &) const = default;
+};
+
+/**
+ * @brief One CompressedSlots element of EpochSlots
+ *
+ * Wire format (bincode enum):
+ * - discriminant: u32 (0=Flate2, 1=Uncompressed)
+ * - first_slot: u64, num: u64
+ * - Flate2: compressed: Vec<u8>; Uncompressed: slots: BitVec<u8>
+ */
+struct GossipCompressedSlots {
+  bool is_flate2 = false;
+  uint64_t first_slot = 0;
+  uint64_t num = 0;
+  std::vector<uint8_t> compressed; ///< Flate2 only
+  GossipBitVec slots;              ///< Uncompressed only
+
+  bool operator==(const GossipCompressedSlots &) const = default;
+};
+
+/**
+ * @brief CrdsData::EpochSlots(5)
+ *
+ * Wire format: index: u8, from: Pubkey, slots: Vec<CompressedSlots>,
+ * wallclock: u64.
+ */
+struct GossipEpochSlots {
+  uint8_t index = 0;
+  Pubkey from{};
+  std::vector<GossipCompressedSlots> slots;
+  uint64_t wallclock = 0;
+
+  bool operator==(const GossipEpochSlots &) const = default;
+};
+
+/**
+ * @brief CrdsData::LegacyVersion(6)
+ *
+ * Wire format: from: Pubkey, wallclock: u64, major/minor/patch: u16,
+ * commit: Option<u32>. Unlike GossipVersion these are fixed-width.
+ */
+struct GossipLegacyVersion {
+  Pubkey from{};
+  uint64_t wallclock = 0;
+  uint16_t major = 0;
+  uint16_t minor = 0;
+  uint16_t patch = 0;
+  std::optional<uint32_t> commit;
+
+  bool operator==(const GossipLegacyVersion &) const = default;
+};
+
+/**
+ * @brief CrdsData::Version(7)
+ *
+ * Wire format: GossipLegacyVersion followed by feature_set: u32.
+ */
+struct GossipNodeVersion {
+  Pubkey from{};
+  uint64_t wallclock = 0;
+  uint16_t major = 0;
+  uint16_t minor = 0;
+  uint16_t patch = 0;
+  std::optional<uint32_t> commit;
+  uint32_t feature_set = 0;
+
+  bool operator==(const GossipNodeVersion &) const = default;
+};
+
+/**
+ * @brief CrdsData::NodeInstance(8)
+ *
+ * Wire format: from: Pubkey, wallclock: u64, timestamp: u64, token: u64.
+ */
+struct GossipNodeInstance {
+  Pubkey from{};
+  uint64_t wallclock = 0;
+  uint64_t timestamp = 0;
+  uint64_t token = 0;
+
+  bool operator==(const GossipNodeInstance &) const = default;
+};
+
+/**
+ * @brief CrdsData::DuplicateShred(9)
+ *
+ * Wire format: index: u16, from: Pubkey, wallclock: u64, slot: u64,
+ * unused: u32 (0), shred_type: u8, num_chunks: u8, chunk_index: u8,
+ * chunk: Vec<u8>.
+ */
+struct GossipDuplicateShred {
+  uint16_t index = 0;
+  Pubkey from{};
+  uint64_t wallclock = 0;
+  uint64_t slot = 0;
+  uint8_t shred_type = 0;
+  uint8_t num_chunks = 0;
+  uint8_t chunk_index = 0;
+  std::vector<uint8_t> chunk;
+
+  bool operator==(const GossipDuplicateShred &) const = default;
+};
+
+/**
+ * @brief CrdsData::IncrementalSnapshotHashes(10) (Agave's SnapshotHashes)
+ *
+ * Wire format: from: Pubkey, full: (u64, Hash), incremental:
+ * Vec<(u64, Hash)>, wallclock: u64.
+ */
+struct GossipSnapshotHashes {
+  Pubkey from{};
+  GossipSlotHash full;
+  std::vector<GossipSlotHash> incremental;
+  uint64_t wallclock = 0;
+
+  bool operator==(const GossipSnapshotHashes &) const = default;
+};
+
+/**
+ * @brief CrdsData::RestartLastVotedForkSlots(12)
+ *
+ * Wire format: from: Pubkey, wallclock: u64, offsets: SlotsOffsets,
+ * last_voted_slot: u64, last_voted_hash: Hash, shred_version: u16.
+ *
+ * SlotsOffsets is a bincode enum: 0 = RunLengthEncoding(Vec<varint u16>),
+ * 1 = RawOffsets(BitVec<u8>).
+ */
+struct GossipRestartLastVotedForkSlots {
+  Pubkey from{};
+  uint64_t wallclock = 0;
+  bool run_length_encoded = true;
+  std::vector<uint16_t> run_lengths; ///< RunLengthEncoding only
+  GossipBitVec raw_offsets;          ///< RawOffsets only
+  uint64_t last_voted_slot = 0;
+  Hash last_voted_hash{};
+  uint16_t shred_version = 0;
+
+  bool operator==(const GossipRestartLastVotedForkSlots &) const = default;
+};
+
+/**
+ * @brief CrdsData::RestartHeaviestFork(13)
+ *
+ * Wire format: from: Pubkey, wallclock: u64, last_slot: u64,
+ * last_slot_hash: Hash, observed_stake: u64, shred_version: u16.
+ */
+struct GossipRestartHeaviestFork {
+  Pubkey from{};
+  uint64_t wallclock = 0;
+  uint64_t last_slot = 0;
+  Hash last_slot_hash{};
+  uint64_t observed_stake = 0;
+  uint16_t shred_version = 0;
+
+  bool operator==(const GossipRestartHeaviestFork &) const = default;
+};
+
+/**
+ * @brief CrdsData (any variant)
+ *
+ * Alternatives are ordered by discriminant, so inner.index() is the
+ * CrdsDataType.
+ */
+struct CrdsData {
+  std::variant<GossipLegacyContactInfo, GossipVote, GossipLowestSlot,
+               GossipLegacySnapshotHashes, GossipAccountsHashes,
+               GossipEpochSlots, GossipLegacyVersion, GossipNodeVersion,
+               GossipNodeInstance, GossipDuplicateShred, GossipSnapshotHashes,
+               GossipContactInfo, GossipRestartLastVotedForkSlots,
+               GossipRestartHeaviestFork>
+      inner;
+
+  CrdsData() = default;
+  template <typename T,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<T>, CrdsData> &&
+                std::is_constructible_v<decltype(inner), T>>>
+  CrdsData(T &&value) : inner(std::forward<T>(value)) {}
+
+  [[nodiscard]] CrdsDataType type() const noexcept {
+    return static_cast<CrdsDataType>(inner.index());
+  }
+
+  template <typename T> [[nodiscard]] bool holds() const noexcept {
+    return std::holds_alternative<T>(inner);
+  }
+
+  template <typename T> [[nodiscard]] const T &as() const {
+    return std::get<T>(inner);
+  }
+
+  /// Origin pubkey (`id` / `pubkey` / `from`, depending on the variant)
+  [[nodiscard]] const Pubkey &from() const;
+
+  /// Origin wallclock in milliseconds
+  [[nodiscard]] uint64_t wallclock() const;
+
+  bool operator==(const CrdsData &) const = default;
+};
+
+static_assert(std::variant_size_v<decltype(CrdsData::inner)> ==
+                  static_cast<size_t>(CrdsDataType::RestartHeaviestFork) + 1,
+              "CrdsData alternatives must match CrdsDataType");
+
+inline const Pubkey &CrdsData::from() const {
+  return std::visit(
+      [](const auto &v) -> const Pubkey & {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, GossipLegacyContactInfo>) {
+          return v.id;
+        } else if constexpr (std::is_same_v<T, GossipContactInfo>) {
+          return v.pubkey;
+        } else {
+          return v.from;
+        }
+      },
+      inner);
+}
+
+inline uint64_t CrdsData::wallclock() const {
+  return std::visit([](const auto &v) { return v.wallclock; }, inner);
+}
+
+/**
+ * @brief Signed CrdsValue: signature: Signature, data: CrdsData
+ */
+struct CrdsValue {
+  Signature signature{};
+  CrdsData data;
+
+  bool operator==(const CrdsValue &) const = default;
+};
+
 // ==================== ShortVec Utilities ====================
 
 /**
@@ -998,14 +1361,15 @@ LIMCODE_ALWAYS_INLINE void limcode_prefetch_batch(const void *addr,
 }
 #endif // LIMCODE_HAS_AVX
 
+/// Copies shorter than this use std::memcpy directly (no indirect call)
+constexpr size_t SIMD_DISPATCH_MIN_BYTES = 1024;
+
 /**
- * @brief Ultra-fast memcpy with AVX-512 non-temporal stores for large blocks
- *
- * Strategy (size-adaptive to match Rust performance):
- * 1. Small (<= 64KB): std::memcpy (stays in cache, very fast)
- * 2. Large (> 64KB): AVX-512 non-temporal stores (bypass cache, maximize bandwidth)
+ * @brief Bulk memcpy through the runtime-dispatched SIMD kernel
  *
- * Non-temporal stores achieve 12 GiB/s for large blocks (same as Rust version)
+ * Strategy (size-adaptive):
+ * 1. Small (< SIMD_DISPATCH_MIN_BYTES): std::memcpy (inlined, stays in cache)
+ * 2. Larger: AVX-512 / AVX2 / scalar kernel chosen from CPUID at startup
  *
  * @param dst Destination pointer
  * @param src Source pointer
@@ -1013,75 +1377,31 @@ LIMCODE_ALWAYS_INLINE void limcode_prefetch_batch(const void *addr,
  */
 LIMCODE_ALWAYS_INLINE void limcode_memcpy_optimized(void *dst, const void *src,
                                                     size_t len) noexcept {
-#if defined(__AVX512F__)
-  __m512i *d = reinterpret_cast<__m512i *>(dst);
-  const __m512i *s = reinterpret_cast<const __m512i *>(src);
-
-  // THEORETICAL MAXIMUM: 16x unrolling for peak performance (1024 bytes/iteration)
-  // Process 16 AVX-512 registers per iteration
-  size_t chunks = len / 64;  // Number of 64-byte chunks
-
-  // 16x unrolled main loop
-  while (chunks >= 16) {
-    __m512i v0 = _mm512_loadu_si512(s);
-    __m512i v1 = _mm512_loadu_si512(s+1);
-    __m512i v2 = _mm512_loadu_si512(s+2);
-    __m512i v3 = _mm512_loadu_si512(s+3);
-    __m512i v4 = _mm512_loadu_si512(s+4);
-    __m512i v5 = _mm512_loadu_si512(s+5);
-    __m512i v6 = _mm512_loadu_si512(s+6);
-    __m512i v7 = _mm512_loadu_si512(s+7);
-    __m512i v8 = _mm512_loadu_si512(s+8);
-    __m512i v9 = _mm512_loadu_si512(s+9);
-    __m512i v10 = _mm512_loadu_si512(s+10);
-    __m512i v11 = _mm512_loadu_si512(s+11);
-    __m512i v12 = _mm512_loadu_si512(s+12);
-    __m512i v13 = _mm512_loadu_si512(s+13);
-    __m512i v14 = _mm512_loadu_si512(s+14);
-    __m512i v15 = _mm512_loadu_si512(s+15);
-
-    _mm512_storeu_si512(d, v0);
-    _mm512_storeu_si512(d+1, v1);
-    _mm512_storeu_si512(d+2, v2);
-    _mm512_storeu_si512(d+3, v3);
-    _mm512_storeu_si512(d+4, v4);
-    _mm512_storeu_si512(d+5, v5);
-    _mm512_storeu_si512(d+6, v6);
-    _mm512_storeu_si512(d+7, v7);
-    _mm512_storeu_si512(d+8, v8);
-    _mm512_storeu_si512(d+9, v9);
-    _mm512_storeu_si512(d+10, v10);
-    _mm512_storeu_si512(d+11, v11);
-    _mm512_storeu_si512(d+12, v12);
-    _mm512_storeu_si512(d+13, v13);
-    _mm512_storeu_si512(d+14, v14);
-    _mm512_storeu_si512(d+15, v15);
-
-    s += 16;
-    d += 16;
-    chunks -= 16;
-  }
-
-  // Process remaining 64-byte chunks
-  while (chunks > 0) {
-    __m512i v = _mm512_loadu_si512(s);
-    _mm512_storeu_si512(d, v);
-    s++;
-    d++;
-    chunks--;
-  }
-
-  // Handle remaining bytes (< 64)
-  size_t remaining = len % 64;
-  if (remaining > 0) {
-    uint8_t *d_bytes = reinterpret_cast<uint8_t *>(d);
-    const uint8_t *s_bytes = reinterpret_cast<const uint8_t *>(s);
-    std::memcpy(d_bytes, s_bytes, remaining);
+  if (len < SIMD_DISPATCH_MIN_BYTES) {
+    std::memcpy(dst, src, len);
+    return;
   }
-#else
-  // Fallback for non-AVX512 systems
-  std::memcpy(dst, src, len);
-#endif
+  simd_kernels().copy(dst, src, len);
+}
+
+/**
+ * @brief SIMD-optimized memcpy with regular stores (cache-friendly)
+ * Runtime-dispatched: AVX-512 / AVX2 / scalar, chosen from CPUID
+ */
+LIMCODE_ALWAYS_INLINE void fast_simd_memcpy(void *__restrict__ dst,
+                                            const void *__restrict__ src,
+                                            size_t len) noexcept {
+  limcode_memcpy_optimized(dst, src, len);
+}
+
+/**
+ * @brief SIMD-optimized memcpy with non-temporal stores (cache bypass)
+ * Runtime-dispatched: AVX-512 / AVX2 / scalar, chosen from CPUID
+ */
+LIMCODE_ALWAYS_INLINE void fast_nt_memcpy(void *__restrict__ dst,
+                                          const void *__restrict__ src,
+                                          size_t len) noexcept {
+  simd_kernels().copy_nt(dst, src, len);
 }
 
 #if LIMCODE_HAS_AVX512
@@ -1205,6 +1525,132 @@ limcode_decode_shortvec_bmi2(const uint8_t *data, size_t &bytes_read) noexcept {
 }
 #endif // LIMCODE_HAS_BMI2
 
+// ==================== Word-at-a-Time Varint Decoding ====================
+//
+// LEB128 (serde_varint) and ShortVec lengths share one layout: 7 value bits
+// per byte, high bit set on every byte but the last. With 8 readable bytes,
+// one unaligned load finds the terminator with a mask and a count-trailing-
+// zeros, and the 7-bit groups are packed with PEXT (BMI2 builds) or three
+// SWAR shift/mask steps. Callers keep their byte loop for the last 7 bytes
+// of a buffer and for values longer than 8 bytes.
+
+/// Terminator (high bit clear) of each byte in a little-endian window
+constexpr uint64_t VARINT_WORD_STOP_BITS = 0x8080808080808080ULL;
+
+/// Pack the low 7 bits of each byte of `word` into a contiguous value
+LIMCODE_ALWAYS_INLINE uint64_t limcode_pack_7bit_groups(uint64_t word) noexcept {
+#if LIMCODE_HAS_BMI2
+  return _pext_u64(word, 0x7F7F7F7F7F7F7F7FULL);
+#else
+  word &= 0x7F7F7F7F7F7F7F7FULL;
+  word = ((word & 0x7F007F007F007F00ULL) >> 1) |
+         (word & 0x007F007F007F007FULL); // 14 bits per 16-bit lane
+  word = ((word & 0x3FFF00003FFF0000ULL) >> 2) |
+         (word & 0x00003FFF00003FFFULL); // 28 bits per 32-bit lane
+  word = ((word & 0x0FFFFFFF00000000ULL) >> 4) |
+         (word & 0x000000000FFFFFFFULL); // 56 bits
+  return word;
+#endif
+}
+
+/// Index of the lowest set bit (`bits` must be non-zero)
+LIMCODE_ALWAYS_INLINE unsigned limcode_ctz64(uint64_t bits) noexcept {
+#if LIMCODE_HAS_BUILTIN_CLZ
+  return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+  unsigned n = 0;
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+/**
+ * @brief Decode one varint from an 8-byte window
+ *
+ * @param data At least 8 readable bytes
+ * @param value Decoded value
+ * @return Bytes used (1-8), or 0 if no byte in the window terminates it
+ */
+LIMCODE_ALWAYS_INLINE size_t limcode_decode_varint_window(const uint8_t *data,
+                                                          uint64_t &value) noexcept {
+  uint64_t word;
+  std::memcpy(&word, data, 8);
+  uint64_t stops = ~word & VARINT_WORD_STOP_BITS;
+  if (LIMCODE_UNLIKELY(stops == 0)) {
+    return 0;
+  }
+  // stops ^ (stops - 1) keeps every bit up to the first terminator
+  value = limcode_pack_7bit_groups(word & (stops ^ (stops - 1)));
+  return (limcode_ctz64(stops) >> 3) + 1;
+}
+
+/**
+ * @brief Decode one ShortVec length from a 4-byte window
+ *
+ * Single-byte lengths skip the mask work; longer ones are packed from a
+ * 32-bit load in three shift/mask steps.
+ *
+ * @param data At least 4 readable bytes
+ * @return Bytes used (1-3), or 0 if the prefix is longer than a ShortVec
+ */
+LIMCODE_ALWAYS_INLINE size_t limcode_decode_short_vec_window(const uint8_t *data,
+                                                             uint16_t &value) noexcept {
+  if (LIMCODE_LIKELY(data[0] < 0x80)) {
+    value = data[0];
+    return 1;
+  }
+  uint32_t word;
+  std::memcpy(&word, data, 4);
+  uint32_t stops = ~word & 0x00808080U;
+  if (LIMCODE_UNLIKELY(stops == 0)) {
+    return 0;
+  }
+  word &= stops ^ (stops - 1);
+  // Truncated to 16 bits like decode_short_vec
+  value = static_cast<uint16_t>((word & 0x7F) | ((word >> 1) & 0x3F80) |
+                                ((word >> 2) & 0x1FC000));
+  return (limcode_ctz64(stops) >> 3) + 1;
+}
+
+/**
+ * @brief Decode up to `count` back-to-back varints
+ *
+ * Each 8-byte load yields every varint that ends inside it, so runs of
+ * 1-byte values cost one load per 8 values. Stops early (without error)
+ * within 8 bytes of the end or at a value longer than 8 bytes; the caller
+ * finishes the rest with its scalar path.
+ *
+ * @param consumed Bytes used by the decoded values
+ * @return Number of values written to `out`
+ */
+inline size_t limcode_decode_varints(const uint8_t *data, size_t size,
+                                     uint64_t *out, size_t count,
+                                     size_t &consumed) noexcept {
+  size_t n = 0;
+  size_t pos = 0;
+  while (n < count && size - pos >= 8) {
+    uint64_t word;
+    std::memcpy(&word, data + pos, 8);
+    uint64_t stops = ~word & VARINT_WORD_STOP_BITS;
+    if (LIMCODE_UNLIKELY(stops == 0)) {
+      break;
+    }
+    do {
+      out[n++] = limcode_pack_7bit_groups(word & (stops ^ (stops - 1)));
+      unsigned bits = (limcode_ctz64(stops) | 7) + 1;
+      pos += bits >> 3;
+      // Two half shifts: a full 64-bit shift is undefined
+      word = (word >> (bits / 2)) >> (bits / 2);
+      stops = (stops >> (bits / 2)) >> (bits / 2);
+    } while (stops != 0 && n < count);
+  }
+  consumed = pos;
+  return n;
+}
+
 // ==================== Optimized Copy Dispatch ====================
 
 /**
@@ -1260,57 +1706,536 @@ LIMCODE_ALWAYS_INLINE void limcode_copy128(void *dst,
 #endif
 }
 
-// ==================== LimcodeEncoder ====================
+// ==================== Policy-Based Encoder ====================
 
 /**
- * @brief Binary encoder for limcode format
+ * @brief Compile-time knobs for Encoder<Policy>
  *
- * LimcodeEncoder provides methods to serialize primitive types and complex
- * structures into a compact binary format. All multi-byte integers are
- * written in little-endian order.
+ * A policy is any type with these static constexpr members:
+ * - checked: reserve each field group's worst-case size before writing it
+ *   (growing the buffer, or throwing on caller memory) and reject lengths a
+ *   ShortVec can't hold. When false the caller guarantees capacity, e.g.
+ *   from serialized_size(), and no per-field checks run.
+ * - nontemporal: bulk copies of at least SIMD_DISPATCH_MIN_BYTES use
+ *   fast_nt_memcpy (cache-bypassing) instead of fast_simd_memcpy.
+ * - prefetch_distance: items ahead to prefetch in the batch writers
+ *   (0 disables prefetching).
+ * - branchless_shortvec: encode ShortVec lengths with
+ *   limcode_encode_shortvec_branchless instead of encode_short_vec.
+ */
+struct CheckedPolicy {
+  static constexpr bool checked = true;
+  static constexpr bool nontemporal = false;
+  static constexpr size_t prefetch_distance = 4;
+  static constexpr bool branchless_shortvec = false;
+};
+
+/// Capacity is pre-sized by the caller; no per-field checks
+struct UncheckedPolicy {
+  static constexpr bool checked = false;
+  static constexpr bool nontemporal = false;
+  static constexpr size_t prefetch_distance = 4;
+  static constexpr bool branchless_shortvec = true;
+};
+
+/// Checked, with branchless ShortVec for batches of small entries
+struct ThroughputPolicy {
+  static constexpr bool checked = true;
+  static constexpr bool nontemporal = false;
+  static constexpr size_t prefetch_distance = 4;
+  static constexpr bool branchless_shortvec = true;
+};
+
+/// Large one-shot outputs: checked, cache-bypassing bulk copies
+struct StreamingPolicy {
+  static constexpr bool checked = true;
+  static constexpr bool nontemporal = true;
+  static constexpr size_t prefetch_distance = 8;
+  static constexpr bool branchless_shortvec = true;
+};
+
+/**
+ * @brief Entry / VersionedTransaction encoder specialized by a policy
  *
- * Optimizations:
- * - Uses memcpy for bulk writes (better than insert())
- * - Force-inlined hot paths
- * - Branch prediction hints for common cases
- * - Pre-allocated buffer to avoid reallocations
+ * The one implementation of the Entry wire format; every knob is resolved
+ * with `if constexpr`, so an instantiation carries no runtime dispatch.
+ * Three storage modes:
+ * - owned: a buffer that grows geometrically (checked policies);
+ * - external: caller memory, which never grows;
+ * - append: extends a caller's vector from its current size. The vector is
+ *   trimmed to the bytes written when the encoder is destroyed; reset()
+ *   rewinds to the starting size, so the caller's prefix is kept.
+ *
+ * Not copyable or movable: append mode holds a pointer to the vector.
  */
-class LimcodeEncoder {
+template <typename Policy = CheckedPolicy> class Encoder {
 public:
+  using policy_type = Policy;
+
+  static constexpr size_t INITIAL_CAPACITY = 64 * 1024; // 64KB default
+
+  Encoder() : Encoder(INITIAL_CAPACITY) {}
+
+  explicit Encoder(size_t capacity) : owned_(capacity), vec_(&owned_) {
+    attach();
+  }
+
   /**
-   * @brief Construct an encoder with optional initial capacity
+   * @brief Write into caller-owned memory instead of an internal buffer
    *
-   * @param initial_capacity Initial buffer size (default 4KB for typical transactions)
+   * The caller keeps `external` alive. reserve() can't grow it and
+   * finish() is unavailable; checked policies throw BufferOverflow if a
+   * write doesn't fit.
    */
-  explicit LimcodeEncoder(size_t initial_capacity = 4096) {
-    buffer_.reserve(initial_capacity);
+  explicit Encoder(std::span<uint8_t> external)
+      : out_(external.data()), capacity_(external.size()) {}
+
+  /// Append to `sink`, starting at sink.size()
+  explicit Encoder(std::vector<uint8_t> &sink)
+      : vec_(&sink), base_(sink.size()), pos_(base_), appending_(true) {
+    attach();
   }
 
-  // ==================== Primitive Write Methods ====================
+  ~Encoder() {
+    if (appending_) {
+      vec_->resize(pos_);
+    }
+  }
 
-  /// Write an unsigned 8-bit integer
-  LIMCODE_ALWAYS_INLINE void write_u8(uint8_t value) LIMCODE_HOT {
-    buffer_.push_back(value);
+  Encoder(const Encoder &) = delete;
+  Encoder &operator=(const Encoder &) = delete;
+
+  /// Reset for reuse (the buffer is kept)
+  void reset() noexcept { pos_ = base_; }
+
+  /// Reset, and drop the buffer if it grew beyond `max_retained` bytes
+  void reset_and_trim(size_t max_retained) {
+    pos_ = base_;
+    if (vec_ == &owned_ && capacity_ > max_retained) {
+      owned_ = std::vector<uint8_t>();
+      attach();
+    }
   }
 
-  /// Write a signed 8-bit integer
-  LIMCODE_ALWAYS_INLINE void write_i8(int8_t value) {
-    buffer_.push_back(static_cast<uint8_t>(value));
+  /// Make the total capacity at least `capacity` bytes
+  void reserve(size_t capacity) {
+    if (capacity > capacity_) {
+      if (vec_ == nullptr) {
+        throw LimcodeError::buffer_overflow(capacity, capacity_);
+      }
+      vec_->resize(capacity);
+      attach();
+    }
   }
 
-  /// Write an unsigned 16-bit integer (little-endian) - uses memcpy
-  LIMCODE_ALWAYS_INLINE void write_u16(uint16_t value) LIMCODE_HOT {
-    size_t pos = buffer_.size();
-    buffer_.resize(pos + 2);
-    std::memcpy(buffer_.data() + pos, &value, 2);
+  [[nodiscard]] uint8_t *data() noexcept { return out_; }
+  [[nodiscard]] size_t size() const noexcept { return pos_; }
+  [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+  [[nodiscard]] bool is_external() const noexcept { return vec_ == nullptr; }
+
+  /// Encoded bytes (valid until the next write or reset)
+  [[nodiscard]] std::span<const uint8_t> as_span() const noexcept {
+    return {out_, pos_};
   }
 
-  /// Write a signed 16-bit integer (little-endian)
-  LIMCODE_ALWAYS_INLINE void write_i16(int16_t value) {
-    write_u16(static_cast<uint16_t>(value));
+  /// Copy out the encoded bytes (exact size, no zero-fill)
+  [[nodiscard]] std::vector<uint8_t> to_vector() const {
+    return {out_, out_ + pos_};
   }
 
-  /// Write an unsigned 32-bit integer (little-endian) - uses direct store on x86-64
+  /**
+   * @brief Move out the owned buffer, trimmed to the bytes written
+   *
+   * The encoder is empty afterwards; unchecked policies must reserve()
+   * before writing again.
+   */
+  [[nodiscard]] std::vector<uint8_t> finish() {
+    if (vec_ != &owned_) {
+      throw LimcodeError(ErrorCode::InvalidData,
+                         "finish() on an encoder writing to external memory");
+    }
+    owned_.resize(pos_);
+    std::vector<uint8_t> result = std::move(owned_);
+    owned_ = std::vector<uint8_t>();
+    attach();
+    pos_ = 0;
+    return result;
+  }
+
+  // ==================== Primitive Writes ====================
+
+  LIMCODE_ALWAYS_INLINE void write_u8(uint8_t value) {
+    ensure(1);
+    out_[pos_++] = value;
+  }
+
+  LIMCODE_ALWAYS_INLINE void write_u64(uint64_t value) {
+    ensure(8);
+    commit(put_u64(cursor(), value));
+  }
+
+  LIMCODE_ALWAYS_INLINE void write_short_vec_len(size_t len) {
+    ensure(SHORT_VEC_MAX_BYTES);
+    commit(put_short_vec(cursor(), len));
+  }
+
+  LIMCODE_ALWAYS_INLINE void write_bytes(const uint8_t *src, size_t len) {
+    ensure(len);
+    commit(put_bytes(cursor(), src, len));
+  }
+
+  /// Write a fixed-size array as raw bytes
+  template <size_t N>
+  LIMCODE_ALWAYS_INLINE void write_pod(const std::array<uint8_t, N> &arr) {
+    ensure(N);
+    commit(put_array(cursor(), arr));
+  }
+
+  /// Write N raw bytes, N known at compile time (inlines to plain moves)
+  template <size_t N> LIMCODE_ALWAYS_INLINE void write_fixed(const void *src) {
+    ensure(N);
+    std::memcpy(cursor(), src, N);
+    pos_ += N;
+  }
+
+  // ==================== Entry Serialization ====================
+
+  void write_message_header(const MessageHeader &header) {
+    ensure(3);
+    commit(put_header(cursor(), header));
+  }
+
+  void write_compiled_instruction(const CompiledInstruction &instr) {
+    const size_t num_accounts = instr.accounts.size();
+    const size_t data_len = instr.data.size();
+    ensure(1 + 2 * SHORT_VEC_MAX_BYTES + num_accounts + data_len);
+    uint8_t *p = cursor();
+    *p++ = instr.program_id_index;
+    p = put_short_vec(p, num_accounts);
+    p = put_bytes(p, instr.accounts.data(), num_accounts);
+    p = put_short_vec(p, data_len);
+    p = put_bytes(p, instr.data.data(), data_len);
+    commit(p);
+  }
+
+  void write_address_table_lookup(const AddressTableLookup &atl) {
+    const size_t num_writable = atl.writable_indexes.size();
+    const size_t num_readonly = atl.readonly_indexes.size();
+    ensure(PUBKEY_BYTES + 2 * SHORT_VEC_MAX_BYTES + num_writable +
+           num_readonly);
+    uint8_t *p = put_array(cursor(), atl.account_key);
+    p = put_short_vec(p, num_writable);
+    p = put_bytes(p, atl.writable_indexes.data(), num_writable);
+    p = put_short_vec(p, num_readonly);
+    p = put_bytes(p, atl.readonly_indexes.data(), num_readonly);
+    commit(p);
+  }
+
+  void write_legacy_message(const LegacyMessage &msg) {
+    write_message_prefix(msg);
+    for (const auto &instr : msg.instructions) {
+      write_compiled_instruction(instr);
+    }
+  }
+
+  void write_v0_message(const V0Message &msg) {
+    write_message_prefix(msg);
+    for (const auto &instr : msg.instructions) {
+      write_compiled_instruction(instr);
+    }
+    write_short_vec_len(msg.address_table_lookups.size());
+    for (const auto &atl : msg.address_table_lookups) {
+      write_address_table_lookup(atl);
+    }
+  }
+
+  void write_versioned_message(const VersionedMessage &msg) {
+    if (msg.is_v0()) {
+      write_u8(VERSION_PREFIX_MASK);
+      write_v0_message(msg.as_v0());
+    } else {
+      write_legacy_message(msg.as_legacy());
+    }
+  }
+
+  void write_versioned_transaction(const VersionedTransaction &tx) {
+    const size_t num_sigs = tx.signatures.size();
+    ensure(SHORT_VEC_MAX_BYTES + num_sigs * SIGNATURE_BYTES);
+    uint8_t *p = cursor();
+    if (LIMCODE_LIKELY(num_sigs == 1)) {
+      *p++ = 1;
+      p = put_array(p, tx.signatures[0]);
+    } else {
+      p = put_short_vec(p, num_sigs);
+      p = put_bytes(p, tx.signatures.data(), num_sigs * SIGNATURE_BYTES);
+    }
+    commit(p);
+    write_versioned_message(tx.message);
+  }
+
+  void write_entry(const Entry &entry) {
+    ensure(8 + HASH_BYTES + SHORT_VEC_MAX_BYTES);
+    uint8_t *p = put_u64(cursor(), entry.num_hashes);
+    p = put_array(p, entry.hash);
+    commit(put_short_vec(p, entry.transactions.size()));
+    for (const auto &tx : entry.transactions) {
+      write_versioned_transaction(tx);
+    }
+  }
+
+  /// Write `count` entries back to back (no length prefix)
+  void write_entries(const Entry *entries, size_t count) {
+    constexpr size_t distance = Policy::prefetch_distance;
+    for (size_t i = 0; i < count; ++i) {
+      if constexpr (distance > 0) {
+        if (i + distance < count) {
+          prefetch_entry(entries[i + distance]);
+        }
+      }
+      write_entry(entries[i]);
+    }
+  }
+
+  /**
+   * @brief write_entries(), feeding each entry's bytes to `digest` as soon as
+   * it is written
+   *
+   * An entry is at most a few KB, so the digest reads it from L1 instead of
+   * making a second pass over the finished buffer.
+   */
+  template <ByteDigest Digest>
+  void write_entries(const Entry *entries, size_t count, Digest &digest) {
+    constexpr size_t distance = Policy::prefetch_distance;
+    for (size_t i = 0; i < count; ++i) {
+      if constexpr (distance > 0) {
+        if (i + distance < count) {
+          prefetch_entry(entries[i + distance]);
+        }
+      }
+      size_t start = pos_;
+      write_entry(entries[i]);
+      digest.update(std::span<const uint8_t>(out_ + start, pos_ - start));
+    }
+  }
+
+  /// Write `count` transactions back to back (no length prefix)
+  void write_versioned_transactions(const VersionedTransaction *txs,
+                                    size_t count) {
+    constexpr size_t distance = Policy::prefetch_distance;
+    for (size_t i = 0; i < count; ++i) {
+      if constexpr (distance > 0) {
+        if (i + distance < count) {
+          prefetch_transaction(txs[i + distance]);
+        }
+      }
+      write_versioned_transaction(txs[i]);
+    }
+  }
+
+private:
+  std::vector<uint8_t> owned_;
+  std::vector<uint8_t> *vec_ = nullptr; // &owned_, the append sink, or null
+  uint8_t *out_ = nullptr;
+  size_t capacity_ = 0;
+  size_t base_ = 0; // append mode: the sink's size at construction
+  size_t pos_ = 0;
+  bool appending_ = false;
+
+  // Raw writes go through a local cursor: byte stores through out_ could
+  // alias pos_, which would force a reload after every store
+
+  [[nodiscard]] LIMCODE_ALWAYS_INLINE uint8_t *cursor() noexcept {
+    return out_ + pos_;
+  }
+
+  LIMCODE_ALWAYS_INLINE void commit(uint8_t *end) noexcept {
+    pos_ = static_cast<size_t>(end - out_);
+  }
+
+  void attach() noexcept {
+    out_ = vec_->data();
+    capacity_ = vec_->size();
+  }
+
+  LIMCODE_ALWAYS_INLINE void ensure(size_t n) {
+    if constexpr (Policy::checked) {
+      if (LIMCODE_UNLIKELY(n > capacity_ - pos_)) {
+        grow(n);
+      }
+    } else {
+      (void)n;
+    }
+  }
+
+  void grow(size_t needed) {
+    size_t required = pos_ + needed;
+    if (vec_ == nullptr) {
+      throw LimcodeError::buffer_overflow(required, capacity_);
+    }
+    // Appending extends by exactly what's needed: the sink's own capacity
+    // doubling amortizes it, and no spare tail is zero-filled
+    vec_->resize(appending_ ? required
+                            : std::max(capacity_ * 2, required + 1024));
+    attach();
+  }
+
+  // Raw writes: capacity was ensured by the caller
+
+  static LIMCODE_ALWAYS_INLINE uint8_t *put_u64(uint8_t *p,
+                                                uint64_t value) noexcept {
+    std::memcpy(p, &value, 8);
+    return p + 8;
+  }
+
+  static LIMCODE_ALWAYS_INLINE uint8_t *put_short_vec(uint8_t *p, size_t len) {
+    if constexpr (Policy::checked) {
+      if (LIMCODE_UNLIKELY(len > SHORT_VEC_MAX_VALUE)) {
+        throw LimcodeError::length_overflow(len);
+      }
+    }
+    if constexpr (Policy::branchless_shortvec) {
+      return p + limcode_encode_shortvec_branchless(static_cast<uint16_t>(len),
+                                                    p);
+    } else {
+      return p + encode_short_vec(static_cast<uint16_t>(len), p);
+    }
+  }
+
+  template <size_t N>
+  static LIMCODE_ALWAYS_INLINE uint8_t *
+  put_array(uint8_t *p, const std::array<uint8_t, N> &arr) noexcept {
+    if constexpr (N == 32) {
+      limcode_copy32(p, arr.data());
+    } else if constexpr (N == 64) {
+      limcode_copy64(p, arr.data());
+    } else {
+      std::memcpy(p, arr.data(), N);
+    }
+    return p + N;
+  }
+
+  static LIMCODE_ALWAYS_INLINE uint8_t *
+  put_bytes(uint8_t *p, const void *src, size_t len) noexcept {
+    if (len == 0) {
+      return p;
+    }
+    if constexpr (Policy::nontemporal) {
+      if (len >= SIMD_DISPATCH_MIN_BYTES) {
+        fast_nt_memcpy(p, src, len);
+      } else {
+        std::memcpy(p, src, len);
+      }
+    } else {
+      fast_simd_memcpy(p, src, len);
+    }
+    return p + len;
+  }
+
+  /// Pubkey runs are short: unrolled 32-byte copies beat a memcpy call
+  static LIMCODE_ALWAYS_INLINE uint8_t *
+  put_keys(uint8_t *p, const Pubkey *keys, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      limcode_copy32(p, keys[i].data());
+      limcode_copy32(p + 32, keys[i + 1].data());
+      limcode_copy32(p + 64, keys[i + 2].data());
+      limcode_copy32(p + 96, keys[i + 3].data());
+      p += 128;
+    }
+    for (; i < count; ++i) {
+      limcode_copy32(p, keys[i].data());
+      p += 32;
+    }
+    return p;
+  }
+
+  static LIMCODE_ALWAYS_INLINE uint8_t *
+  put_header(uint8_t *p, const MessageHeader &header) noexcept {
+    p[0] = header.num_required_signatures;
+    p[1] = header.num_readonly_signed_accounts;
+    p[2] = header.num_readonly_unsigned_accounts;
+    return p + 3;
+  }
+
+  /// Header, account keys, blockhash and instruction count
+  template <typename Message> void write_message_prefix(const Message &msg) {
+    const size_t num_keys = msg.account_keys.size();
+    ensure(3 + 2 * SHORT_VEC_MAX_BYTES + num_keys * PUBKEY_BYTES + HASH_BYTES);
+    uint8_t *p = put_header(cursor(), msg.header);
+    p = put_short_vec(p, num_keys);
+    p = put_keys(p, msg.account_keys.data(), num_keys);
+    p = put_array(p, msg.recent_blockhash);
+    commit(put_short_vec(p, msg.instructions.size()));
+  }
+
+  // Prefetch the data the writer touches first, not just the structs
+  static LIMCODE_ALWAYS_INLINE void
+  prefetch_transaction(const VersionedTransaction &tx) noexcept {
+    LIMCODE_PREFETCH(&tx);
+    if (!tx.signatures.empty()) {
+      LIMCODE_PREFETCH(tx.signatures.data());
+    }
+  }
+
+  static LIMCODE_ALWAYS_INLINE void prefetch_entry(const Entry &entry) noexcept {
+    LIMCODE_PREFETCH(&entry);
+    if (!entry.transactions.empty()) {
+      prefetch_transaction(entry.transactions[0]);
+    }
+  }
+};
+
+// ==================== LimcodeEncoder ====================
+
+/**
+ * @brief Binary encoder for limcode format
+ *
+ * LimcodeEncoder provides methods to serialize primitive types and complex
+ * structures into a compact binary format. All multi-byte integers are
+ * written in little-endian order.
+ *
+ * Optimizations:
+ * - Uses memcpy for bulk writes (better than insert())
+ * - Force-inlined hot paths
+ * - Branch prediction hints for common cases
+ * - Pre-allocated buffer to avoid reallocations
+ */
+class LimcodeEncoder {
+public:
+  /**
+   * @brief Construct an encoder with optional initial capacity
+   *
+   * @param initial_capacity Initial buffer size (default 4KB for typical transactions)
+   */
+  explicit LimcodeEncoder(size_t initial_capacity = 4096) {
+    buffer_.reserve(initial_capacity);
+  }
+
+  // ==================== Primitive Write Methods ====================
+
+  /// Write an unsigned 8-bit integer
+  LIMCODE_ALWAYS_INLINE void write_u8(uint8_t value) LIMCODE_HOT {
+    buffer_.push_back(value);
+  }
+
+  /// Write a signed 8-bit integer
+  LIMCODE_ALWAYS_INLINE void write_i8(int8_t value) {
+    buffer_.push_back(static_cast<uint8_t>(value));
+  }
+
+  /// Write an unsigned 16-bit integer (little-endian) - uses memcpy
+  LIMCODE_ALWAYS_INLINE void write_u16(uint16_t value) LIMCODE_HOT {
+    size_t pos = buffer_.size();
+    buffer_.resize(pos + 2);
+    std::memcpy(buffer_.data() + pos, &value, 2);
+  }
+
+  /// Write a signed 16-bit integer (little-endian)
+  LIMCODE_ALWAYS_INLINE void write_i16(int16_t value) {
+    write_u16(static_cast<uint16_t>(value));
+  }
+
+  /// Write an unsigned 32-bit integer (little-endian) - uses direct store on x86-64
   LIMCODE_ALWAYS_INLINE void write_u32(uint32_t value) LIMCODE_HOT {
     size_t pos = buffer_.size();
     buffer_.resize(pos + 4);
@@ -1425,11 +2350,7 @@ public:
       }
 
       buffer_.resize(new_size);
-#if LIMCODE_HAS_AVX512
       limcode_memcpy_optimized(buffer_.data() + pos, data, size);
-#else
-      std::memcpy(buffer_.data() + pos, data, size);
-#endif
     }
   }
 
@@ -1539,9 +2460,8 @@ public:
       write_u32(0); // V4 discriminant
       write_bytes(addr.v4_bytes.data(), 4);
     } else {
-      // V6 not implemented yet
-      write_u32(1);
-      // Would need 16 bytes here
+      write_u32(1); // V6 discriminant
+      write_bytes(addr.v6_bytes.data(), 16);
     }
   }
 
@@ -1609,6 +2529,38 @@ public:
     write_gossip_contact_info(ci);
   }
 
+  void write_gossip_socket_addr(const GossipSocketAddr &addr);
+  void write_gossip_bit_vec(const GossipBitVec &bits);
+
+  /// Write one CrdsData payload (no discriminant)
+  void write_crds_payload(const GossipLegacyContactInfo &v);
+  void write_crds_payload(const GossipVote &v);
+  void write_crds_payload(const GossipLowestSlot &v);
+  void write_crds_payload(const GossipSlotHashes &v);
+  void write_crds_payload(const GossipEpochSlots &v);
+  void write_crds_payload(const GossipLegacyVersion &v);
+  void write_crds_payload(const GossipNodeVersion &v);
+  void write_crds_payload(const GossipNodeInstance &v);
+  void write_crds_payload(const GossipDuplicateShred &v);
+  void write_crds_payload(const GossipSnapshotHashes &v);
+  void write_crds_payload(const GossipContactInfo &v) {
+    write_gossip_contact_info(v);
+  }
+  void write_crds_payload(const GossipRestartLastVotedForkSlots &v);
+  void write_crds_payload(const GossipRestartHeaviestFork &v);
+
+  /// Write CrdsData: u32 discriminant + payload
+  void write_crds_data(const CrdsData &data) {
+    write_u32(static_cast<uint32_t>(data.type()));
+    std::visit([this](const auto &v) { write_crds_payload(v); }, data.inner);
+  }
+
+  /// Write CrdsValue: signature + CrdsData
+  void write_crds_value(const CrdsValue &value) {
+    write_bytes(value.signature.data(), SIGNATURE_BYTES);
+    write_crds_data(value.data);
+  }
+
   // ==================== Output Methods ====================
 
   /// Get reference to the internal buffer
@@ -1641,86 +2593,214 @@ private:
 // ==================== LimcodeEncoder Method Implementations
 // ====================
 
+// The Entry tree is encoded by Encoder<CheckedPolicy>, appending in place
+
 inline void LimcodeEncoder::write_message_header(const MessageHeader &header) {
-  write_u8(header.num_required_signatures);
-  write_u8(header.num_readonly_signed_accounts);
-  write_u8(header.num_readonly_unsigned_accounts);
+  Encoder<CheckedPolicy> encoder(buffer_);
+  encoder.write_message_header(header);
 }
 
 inline void
 LimcodeEncoder::write_compiled_instruction(const CompiledInstruction &instr) {
-  write_u8(instr.program_id_index);
-  write_short_vec_len(static_cast<uint16_t>(instr.accounts.size()));
-  write_bytes(instr.accounts.data(), instr.accounts.size());
-  write_short_vec_len(static_cast<uint16_t>(instr.data.size()));
-  write_bytes(instr.data.data(), instr.data.size());
+  Encoder<CheckedPolicy> encoder(buffer_);
+  encoder.write_compiled_instruction(instr);
 }
 
 inline void
 LimcodeEncoder::write_address_table_lookup(const AddressTableLookup &atl) {
-  write_bytes(atl.account_key.data(), 32);
-  write_short_vec_len(static_cast<uint16_t>(atl.writable_indexes.size()));
-  write_bytes(atl.writable_indexes.data(), atl.writable_indexes.size());
-  write_short_vec_len(static_cast<uint16_t>(atl.readonly_indexes.size()));
-  write_bytes(atl.readonly_indexes.data(), atl.readonly_indexes.size());
+  Encoder<CheckedPolicy> encoder(buffer_);
+  encoder.write_address_table_lookup(atl);
 }
 
 inline void LimcodeEncoder::write_legacy_message(const LegacyMessage &msg) {
-  write_message_header(msg.header);
-  write_short_vec_len(static_cast<uint16_t>(msg.account_keys.size()));
-  for (const auto &key : msg.account_keys) {
-    write_bytes(key.data(), 32);
+  Encoder<CheckedPolicy> encoder(buffer_);
+  encoder.write_legacy_message(msg);
+}
+
+inline void LimcodeEncoder::write_v0_message(const V0Message &msg) {
+  Encoder<CheckedPolicy> encoder(buffer_);
+  encoder.write_v0_message(msg);
+}
+
+inline void
+LimcodeEncoder::write_versioned_message(const VersionedMessage &msg) {
+  Encoder<CheckedPolicy> encoder(buffer_);
+  encoder.write_versioned_message(msg);
+}
+
+inline void
+LimcodeEncoder::write_versioned_transaction(const VersionedTransaction &tx) {
+  Encoder<CheckedPolicy> encoder(buffer_);
+  encoder.write_versioned_transaction(tx);
+}
+
+inline void LimcodeEncoder::write_entry(const Entry &entry) {
+  Encoder<CheckedPolicy> encoder(buffer_);
+  encoder.write_entry(entry);
+}
+
+// ==================== Gossip Encoder Implementations ====================
+
+inline void LimcodeEncoder::write_gossip_socket_addr(const GossipSocketAddr &addr) {
+  write_gossip_ip_addr(addr.ip);
+  write_u16(addr.port);
+}
+
+inline void LimcodeEncoder::write_gossip_bit_vec(const GossipBitVec &bits) {
+  if (bits.blocks.empty()) {
+    write_u8(0); // None
+  } else {
+    write_u8(1);
+    write_u64(bits.blocks.size());
+    write_bytes(bits.blocks.data(), bits.blocks.size());
   }
-  write_bytes(msg.recent_blockhash.data(), 32);
-  write_short_vec_len(static_cast<uint16_t>(msg.instructions.size()));
-  for (const auto &instr : msg.instructions) {
-    write_compiled_instruction(instr);
+  write_u64(bits.len);
+}
+
+inline void LimcodeEncoder::write_crds_payload(const GossipLegacyContactInfo &v) {
+  write_pod(v.id);
+  for (const GossipSocketAddr *addr :
+       {&v.gossip, &v.tvu, &v.tvu_quic, &v.serve_repair_quic, &v.tpu,
+        &v.tpu_forwards, &v.tpu_vote, &v.rpc, &v.rpc_pubsub,
+        &v.serve_repair}) {
+    write_gossip_socket_addr(*addr);
   }
+  write_u64(v.wallclock);
+  write_u16(v.shred_version);
 }
 
-inline void LimcodeEncoder::write_v0_message(const V0Message &msg) {
-  write_message_header(msg.header);
-  write_short_vec_len(static_cast<uint16_t>(msg.account_keys.size()));
-  for (const auto &key : msg.account_keys) {
-    write_bytes(key.data(), 32);
+inline void LimcodeEncoder::write_crds_payload(const GossipVote &v) {
+  if (!v.transaction.message.is_legacy()) {
+    throw LimcodeError::invalid_encoding("Vote transaction must be legacy");
   }
-  write_bytes(msg.recent_blockhash.data(), 32);
-  write_short_vec_len(static_cast<uint16_t>(msg.instructions.size()));
-  for (const auto &instr : msg.instructions) {
-    write_compiled_instruction(instr);
+  write_u8(v.index);
+  write_pod(v.from);
+  write_versioned_transaction(v.transaction);
+  write_u64(v.wallclock);
+}
+
+inline void LimcodeEncoder::write_crds_payload(const GossipLowestSlot &v) {
+  write_u8(0); // deprecated
+  write_pod(v.from);
+  write_u64(v.root);
+  write_u64(v.lowest);
+  write_u64(0); // slots
+  write_u64(0); // stash
+  write_u64(v.wallclock);
+}
+
+inline void LimcodeEncoder::write_crds_payload(const GossipSlotHashes &v) {
+  write_pod(v.from);
+  write_u64(v.hashes.size());
+  for (const auto &sh : v.hashes) {
+    write_u64(sh.slot);
+    write_pod(sh.hash);
   }
-  write_short_vec_len(static_cast<uint16_t>(msg.address_table_lookups.size()));
-  for (const auto &atl : msg.address_table_lookups) {
-    write_address_table_lookup(atl);
+  write_u64(v.wallclock);
+}
+
+inline void LimcodeEncoder::write_crds_payload(const GossipEpochSlots &v) {
+  write_u8(v.index);
+  write_pod(v.from);
+  write_u64(v.slots.size());
+  for (const auto &cs : v.slots) {
+    write_u32(cs.is_flate2 ? 0 : 1);
+    write_u64(cs.first_slot);
+    write_u64(cs.num);
+    if (cs.is_flate2) {
+      write_u64(cs.compressed.size());
+      write_bytes(cs.compressed.data(), cs.compressed.size());
+    } else {
+      write_gossip_bit_vec(cs.slots);
+    }
   }
+  write_u64(v.wallclock);
 }
 
-inline void
-LimcodeEncoder::write_versioned_message(const VersionedMessage &msg) {
-  if (msg.is_v0()) {
-    write_u8(VERSION_PREFIX_MASK);
-    write_v0_message(msg.as_v0());
-  } else {
-    write_legacy_message(msg.as_legacy());
+inline void LimcodeEncoder::write_crds_payload(const GossipLegacyVersion &v) {
+  write_pod(v.from);
+  write_u64(v.wallclock);
+  write_u16(v.major);
+  write_u16(v.minor);
+  write_u16(v.patch);
+  write_u8(v.commit.has_value() ? 1 : 0);
+  if (v.commit) {
+    write_u32(*v.commit);
   }
 }
 
-inline void
-LimcodeEncoder::write_versioned_transaction(const VersionedTransaction &tx) {
-  write_short_vec_len(static_cast<uint16_t>(tx.signatures.size()));
-  for (const auto &sig : tx.signatures) {
-    write_bytes(sig.data(), 64);
+inline void LimcodeEncoder::write_crds_payload(const GossipNodeVersion &v) {
+  write_pod(v.from);
+  write_u64(v.wallclock);
+  write_u16(v.major);
+  write_u16(v.minor);
+  write_u16(v.patch);
+  write_u8(v.commit.has_value() ? 1 : 0);
+  if (v.commit) {
+    write_u32(*v.commit);
+  }
+  write_u32(v.feature_set);
+}
+
+inline void LimcodeEncoder::write_crds_payload(const GossipNodeInstance &v) {
+  write_pod(v.from);
+  write_u64(v.wallclock);
+  write_u64(v.timestamp);
+  write_u64(v.token);
+}
+
+inline void LimcodeEncoder::write_crds_payload(const GossipDuplicateShred &v) {
+  write_u16(v.index);
+  write_pod(v.from);
+  write_u64(v.wallclock);
+  write_u64(v.slot);
+  write_u32(0); // unused
+  write_u8(v.shred_type);
+  write_u8(v.num_chunks);
+  write_u8(v.chunk_index);
+  write_u64(v.chunk.size());
+  write_bytes(v.chunk.data(), v.chunk.size());
+}
+
+inline void LimcodeEncoder::write_crds_payload(const GossipSnapshotHashes &v) {
+  write_pod(v.from);
+  write_u64(v.full.slot);
+  write_pod(v.full.hash);
+  write_u64(v.incremental.size());
+  for (const auto &sh : v.incremental) {
+    write_u64(sh.slot);
+    write_pod(sh.hash);
   }
-  write_versioned_message(tx.message);
+  write_u64(v.wallclock);
 }
 
-inline void LimcodeEncoder::write_entry(const Entry &entry) {
-  write_u64(entry.num_hashes);
-  write_bytes(entry.hash.data(), 32);
-  write_short_vec_len(static_cast<uint16_t>(entry.transactions.size()));
-  for (const auto &tx : entry.transactions) {
-    write_versioned_transaction(tx);
+inline void
+LimcodeEncoder::write_crds_payload(const GossipRestartLastVotedForkSlots &v) {
+  write_pod(v.from);
+  write_u64(v.wallclock);
+  if (v.run_length_encoded) {
+    write_u32(0);
+    write_u64(v.run_lengths.size());
+    for (uint16_t run : v.run_lengths) {
+      write_varint(run);
+    }
+  } else {
+    write_u32(1);
+    write_gossip_bit_vec(v.raw_offsets);
   }
+  write_u64(v.last_voted_slot);
+  write_pod(v.last_voted_hash);
+  write_u16(v.shred_version);
+}
+
+inline void
+LimcodeEncoder::write_crds_payload(const GossipRestartHeaviestFork &v) {
+  write_pod(v.from);
+  write_u64(v.wallclock);
+  write_u64(v.last_slot);
+  write_pod(v.last_slot_hash);
+  write_u64(v.observed_stake);
+  write_u16(v.shred_version);
 }
 
 // ==================== LimcodeDecoder ====================
@@ -1848,6 +2928,16 @@ public:
 private:
   /// Slow path for ShortVec decoding (values >= 128)
   [[nodiscard]] uint16_t read_short_vec_len_slow(uint8_t first) {
+    if (LIMCODE_LIKELY(remaining() >= 7)) {
+      uint64_t value;
+      size_t len = limcode_decode_varint_window(data_ + pos_ - 1, value);
+      if (LIMCODE_UNLIKELY(len == 0 || len > SHORT_VEC_MAX_BYTES)) {
+        throw LimcodeError::invalid_encoding("ShortVec overflow");
+      }
+      pos_ += len - 1;
+      return static_cast<uint16_t>(value);
+    }
+
     uint16_t result = first & 0x7F;
     int shift = 7;
 
@@ -1881,6 +2971,15 @@ public:
    * - SocketEntry.offset
    */
   [[nodiscard]] LIMCODE_ALWAYS_INLINE uint64_t read_varint() LIMCODE_HOT {
+    if (LIMCODE_LIKELY(remaining() >= 8)) {
+      uint64_t value;
+      size_t len = limcode_decode_varint_window(data_ + pos_, value);
+      if (LIMCODE_LIKELY(len != 0)) {
+        pos_ += len;
+        return value;
+      }
+    }
+
     uint64_t result = 0;
     int shift = 0;
 
@@ -1911,6 +3010,37 @@ public:
     return static_cast<uint16_t>(val);
   }
 
+  /**
+   * @brief Read `count` back-to-back LEB128 u16 varints
+   *
+   * Bulk-decodes with limcode_decode_varints(); the last few bytes of the
+   * input go through read_varint_u16().
+   */
+  void read_varints_u16(uint16_t *out, size_t count) {
+    uint64_t values[64];
+    size_t done = 0;
+    while (done < count) {
+      size_t consumed = 0;
+      size_t n = limcode_decode_varints(data_ + pos_, remaining(), values,
+                                        std::min<size_t>(count - done, 64),
+                                        consumed);
+      if (n == 0) {
+        break;
+      }
+      for (size_t i = 0; i < n; ++i) {
+        if (values[i] > 0xFFFF) {
+          throw LimcodeError::invalid_encoding("Varint value too large for u16");
+        }
+        out[done + i] = static_cast<uint16_t>(values[i]);
+      }
+      pos_ += consumed;
+      done += n;
+    }
+    for (; done < count; ++done) {
+      out[done] = read_varint_u16();
+    }
+  }
+
   /**
    * @brief Read a u32 from LEB128 varint encoding
    */
@@ -1924,14 +3054,10 @@ public:
 
   // ==================== Raw Byte Methods ====================
 
-  /// Read raw bytes into a buffer - uses optimized inline assembly memcpy
+  /// Read raw bytes into a buffer (runtime-dispatched SIMD copy for bulk data)
   void read_bytes(uint8_t *out, size_t count) {
     ensure_remaining(count);
-#if LIMCODE_HAS_AVX512
     limcode_memcpy_optimized(out, data_ + pos_, count);
-#else
-    std::memcpy(out, data_ + pos_, count);
-#endif
     pos_ += count;
   }
 
@@ -1977,6 +3103,13 @@ public:
     return value;
   }
 
+  /// Read N raw bytes into `out`, N known at compile time
+  template <size_t N> LIMCODE_ALWAYS_INLINE void read_fixed(void *out) {
+    ensure_remaining(N);
+    std::memcpy(out, data_ + pos_, N);
+    pos_ += N;
+  }
+
   /// Read a fixed-size array - uses SIMD for 32/64 byte arrays
   template <size_t N> [[nodiscard]] std::array<uint8_t, N> read_pod_array() {
     ensure_remaining(N);
@@ -2006,6 +3139,135 @@ public:
   [[nodiscard]] VersionedTransaction read_versioned_transaction();
   [[nodiscard]] Entry read_entry();
 
+  // ==================== Gossip Deserialization Methods ====================
+
+  /**
+   * @brief Read GossipVersion (inverse of LimcodeEncoder::write_gossip_version)
+   */
+  [[nodiscard]] GossipVersion read_gossip_version() {
+    GossipVersion ver;
+    ver.major = read_varint_u16();
+    ver.minor = read_varint_u16();
+    ver.patch = read_varint_u16();
+    ver.commit = read_u32();
+    ver.feature_set = read_u32();
+    ver.client = read_varint_u16();
+    return ver;
+  }
+
+  /**
+   * @brief Read GossipIpAddr (bincode enum: u32 discriminant, 4 or 16 bytes)
+   */
+  [[nodiscard]] GossipIpAddr read_gossip_ip_addr() {
+    GossipIpAddr addr;
+    uint32_t tag = read_u32();
+    if (tag == 0) {
+      addr.is_v4 = true;
+      read_bytes(addr.v4_bytes.data(), 4);
+    } else if (tag == 1) {
+      addr.is_v4 = false;
+      read_bytes(addr.v6_bytes.data(), 16);
+    } else {
+      throw LimcodeError::invalid_encoding("Invalid IpAddr discriminant");
+    }
+    return addr;
+  }
+
+  /**
+   * @brief Read GossipSocketEntry
+   */
+  [[nodiscard]] GossipSocketEntry read_gossip_socket_entry() {
+    GossipSocketEntry entry;
+    entry.key = read_u8();
+    entry.index = read_u8();
+    entry.offset = read_varint_u16();
+    return entry;
+  }
+
+  /**
+   * @brief Read GossipContactInfo
+   *
+   * Accepts exactly what write_gossip_contact_info() produces. Agave's
+   * Extension enum has no variants yet, so a non-empty extension list is
+   * rejected.
+   */
+  [[nodiscard]] GossipContactInfo read_gossip_contact_info() {
+    GossipContactInfo ci;
+    read_bytes(ci.pubkey.data(), PUBKEY_BYTES);
+    ci.wallclock = read_varint();
+    ci.outset = read_u64();
+    ci.shred_version = read_u16();
+    ci.version = read_gossip_version();
+
+    uint16_t addrs_len = read_short_vec_len();
+    ci.addrs.reserve(addrs_len);
+    for (uint16_t i = 0; i < addrs_len; ++i) {
+      ci.addrs.push_back(read_gossip_ip_addr());
+    }
+
+    uint16_t sockets_len = read_short_vec_len();
+    ci.sockets.reserve(sockets_len);
+    for (uint16_t i = 0; i < sockets_len; ++i) {
+      ci.sockets.push_back(read_gossip_socket_entry());
+    }
+
+    if (read_short_vec_len() != 0) {
+      throw LimcodeError::invalid_encoding("Unknown ContactInfo extension");
+    }
+    return ci;
+  }
+
+  /**
+   * @brief Read a CrdsData discriminant
+   * @throws LimcodeError if the value is not a known CrdsDataType
+   */
+  [[nodiscard]] CrdsDataType read_crds_data_type() {
+    uint32_t tag = read_u32();
+    if (tag > static_cast<uint32_t>(CrdsDataType::RestartHeaviestFork)) {
+      throw LimcodeError::invalid_encoding("Unknown CrdsData discriminant " +
+                                           std::to_string(tag));
+    }
+    return static_cast<CrdsDataType>(tag);
+  }
+
+  /**
+   * @brief Read CrdsData::ContactInfo
+   * @throws LimcodeError if the envelope holds a different variant
+   */
+  [[nodiscard]] GossipContactInfo read_crds_data_contact_info() {
+    if (read_crds_data_type() != CrdsDataType::ContactInfo) {
+      throw LimcodeError::invalid_encoding("CrdsData is not ContactInfo");
+    }
+    return read_gossip_contact_info();
+  }
+
+  [[nodiscard]] GossipSocketAddr read_gossip_socket_addr();
+  [[nodiscard]] GossipBitVec read_gossip_bit_vec();
+  [[nodiscard]] GossipLegacyContactInfo read_gossip_legacy_contact_info();
+  [[nodiscard]] GossipVote read_gossip_vote();
+  [[nodiscard]] GossipLowestSlot read_gossip_lowest_slot();
+  [[nodiscard]] GossipSlotHashes read_gossip_slot_hashes();
+  [[nodiscard]] GossipEpochSlots read_gossip_epoch_slots();
+  [[nodiscard]] GossipLegacyVersion read_gossip_legacy_version();
+  [[nodiscard]] GossipNodeVersion read_gossip_node_version();
+  [[nodiscard]] GossipNodeInstance read_gossip_node_instance();
+  [[nodiscard]] GossipDuplicateShred read_gossip_duplicate_shred();
+  [[nodiscard]] GossipSnapshotHashes read_gossip_snapshot_hashes();
+  [[nodiscard]] GossipRestartLastVotedForkSlots
+  read_gossip_restart_last_voted_fork_slots();
+  [[nodiscard]] GossipRestartHeaviestFork read_gossip_restart_heaviest_fork();
+
+  /// Read CrdsData of any variant
+  [[nodiscard]] CrdsData read_crds_data();
+
+  /// Read CrdsValue: signature + CrdsData
+  [[nodiscard]] CrdsValue read_crds_value() {
+    CrdsValue value;
+    read_bytes(value.signature.data(), SIGNATURE_BYTES);
+    value.data = read_crds_data();
+    return value;
+  }
+
   // ==================== State Methods ====================
 
   /// Get current read position
@@ -2049,6 +3311,15 @@ private:
       throw LimcodeError::buffer_underflow(bytes, remaining());
     }
   }
+
+  /// Read a bincode Vec length, rejecting counts the input can't hold
+  [[nodiscard]] size_t read_vec_len(size_t min_element_size) {
+    uint64_t count = read_u64();
+    if (count > remaining() / min_element_size) {
+      throw LimcodeError::invalid_encoding("Vec length exceeds input size");
+    }
+    return static_cast<size_t>(count);
+  }
 };
 
 // ==================== LimcodeDecoder Method Implementations
@@ -2162,6 +3433,299 @@ inline Entry LimcodeDecoder::read_entry() {
   return entry;
 }
 
+// ==================== Gossip Decoder Implementations ====================
+
+inline GossipSocketAddr LimcodeDecoder::read_gossip_socket_addr() {
+  GossipSocketAddr addr;
+  addr.ip = read_gossip_ip_addr();
+  addr.port = read_u16();
+  return addr;
+}
+
+inline GossipBitVec LimcodeDecoder::read_gossip_bit_vec() {
+  GossipBitVec bits;
+  uint8_t has_blocks = read_u8();
+  if (has_blocks > 1) {
+    throw LimcodeError::invalid_encoding("Invalid Option tag in BitVec");
+  }
+  if (has_blocks) {
+    bits.blocks = read_bytes(read_vec_len(1));
+  }
+  bits.len = read_u64();
+  if (bits.len > bits.blocks.size() * 8) {
+    throw LimcodeError::invalid_encoding("BitVec length exceeds its blocks");
+  }
+  return bits;
+}
+
+inline GossipLegacyContactInfo LimcodeDecoder::read_gossip_legacy_contact_info() {
+  GossipLegacyContactInfo v;
+  read_bytes(v.id.data(), PUBKEY_BYTES);
+  for (GossipSocketAddr *addr :
+       {&v.gossip, &v.tvu, &v.tvu_quic, &v.serve_repair_quic, &v.tpu,
+        &v.tpu_forwards, &v.tpu_vote, &v.rpc, &v.rpc_pubsub,
+        &v.serve_repair}) {
+    *addr = read_gossip_socket_addr();
+  }
+  v.wallclock = read_u64();
+  v.shred_version = read_u16();
+  return v;
+}
+
+inline GossipVote LimcodeDecoder::read_gossip_vote() {
+  GossipVote v;
+  v.index = read_u8();
+  read_bytes(v.from.data(), PUBKEY_BYTES);
+  // Transaction (not VersionedTransaction): no version prefix
+  uint16_t sig_len = read_short_vec_len();
+  v.transaction.signatures.resize(sig_len);
+  for (auto &sig : v.transaction.signatures) {
+    read_bytes(sig.data(), SIGNATURE_BYTES);
+  }
+  if ((peek_u8() & VERSION_PREFIX_MASK) != 0) {
+    throw LimcodeError::invalid_legacy_header(peek_u8());
+  }
+  v.transaction.message = VersionedMessage(read_legacy_message());
+  v.wallclock = read_u64();
+  return v;
+}
+
+inline GossipLowestSlot LimcodeDecoder::read_gossip_lowest_slot() {
+  GossipLowestSlot v;
+  (void)read_u8(); // deprecated
+  read_bytes(v.from.data(), PUBKEY_BYTES);
+  v.root = read_u64();
+  v.lowest = read_u64();
+  if (read_u64() != 0 || read_u64() != 0) {
+    throw LimcodeError::invalid_encoding("LowestSlot slots/stash must be empty");
+  }
+  v.wallclock = read_u64();
+  return v;
+}
+
+inline GossipSlotHashes LimcodeDecoder::read_gossip_slot_hashes() {
+  GossipSlotHashes v;
+  read_bytes(v.from.data(), PUBKEY_BYTES);
+  size_t count = read_vec_len(8 + HASH_BYTES);
+  v.hashes.resize(count);
+  for (auto &sh : v.hashes) {
+    sh.slot = read_u64();
+    read_bytes(sh.hash.data(), HASH_BYTES);
+  }
+  v.wallclock = read_u64();
+  return v;
+}
+
+inline GossipEpochSlots LimcodeDecoder::read_gossip_epoch_slots() {
+  GossipEpochSlots v;
+  v.index = read_u8();
+  read_bytes(v.from.data(), PUBKEY_BYTES);
+  // Smallest element: discriminant, first_slot, num, empty Vec<u8>
+  size_t count = read_vec_len(4 + 8 + 8 + 8);
+  v.slots.resize(count);
+  for (auto &cs : v.slots) {
+    uint32_t tag = read_u32();
+    if (tag > 1) {
+      throw LimcodeError::invalid_encoding("Invalid CompressedSlots discriminant");
+    }
+    cs.is_flate2 = tag == 0;
+    cs.first_slot = read_u64();
+    cs.num = read_u64();
+    if (cs.is_flate2) {
+      cs.compressed = read_bytes(read_vec_len(1));
+    } else {
+      cs.slots = read_gossip_bit_vec();
+    }
+  }
+  v.wallclock = read_u64();
+  return v;
+}
+
+inline GossipLegacyVersion LimcodeDecoder::read_gossip_legacy_version() {
+  GossipLegacyVersion v;
+  read_bytes(v.from.data(), PUBKEY_BYTES);
+  v.wallclock = read_u64();
+  v.major = read_u16();
+  v.minor = read_u16();
+  v.patch = read_u16();
+  uint8_t has_commit = read_u8();
+  if (has_commit > 1) {
+    throw LimcodeError::invalid_encoding("Invalid Option tag in version");
+  }
+  if (has_commit) {
+    v.commit = read_u32();
+  }
+  return v;
+}
+
+inline GossipNodeVersion LimcodeDecoder::read_gossip_node_version() {
+  GossipLegacyVersion legacy = read_gossip_legacy_version();
+  GossipNodeVersion v;
+  v.from = legacy.from;
+  v.wallclock = legacy.wallclock;
+  v.major = legacy.major;
+  v.minor = legacy.minor;
+  v.patch = legacy.patch;
+  v.commit = legacy.commit;
+  v.feature_set = read_u32();
+  return v;
+}
+
+inline GossipNodeInstance LimcodeDecoder::read_gossip_node_instance() {
+  GossipNodeInstance v;
+  read_bytes(v.from.data(), PUBKEY_BYTES);
+  v.wallclock = read_u64();
+  v.timestamp = read_u64();
+  v.token = read_u64();
+  return v;
+}
+
+inline GossipDuplicateShred LimcodeDecoder::read_gossip_duplicate_shred() {
+  GossipDuplicateShred v;
+  v.index = read_u16();
+  read_bytes(v.from.data(), PUBKEY_BYTES);
+  v.wallclock = read_u64();
+  v.slot = read_u64();
+  (void)read_u32(); // unused
+  v.shred_type = read_u8();
+  v.num_chunks = read_u8();
+  v.chunk_index = read_u8();
+  v.chunk = read_bytes(read_vec_len(1));
+  return v;
+}
+
+inline GossipSnapshotHashes LimcodeDecoder::read_gossip_snapshot_hashes() {
+  GossipSnapshotHashes v;
+  read_bytes(v.from.data(), PUBKEY_BYTES);
+  v.full.slot = read_u64();
+  read_bytes(v.full.hash.data(), HASH_BYTES);
+  size_t count = read_vec_len(8 + HASH_BYTES);
+  v.incremental.resize(count);
+  for (auto &sh : v.incremental) {
+    sh.slot = read_u64();
+    read_bytes(sh.hash.data(), HASH_BYTES);
+  }
+  v.wallclock = read_u64();
+  return v;
+}
+
+inline GossipRestartLastVotedForkSlots
+LimcodeDecoder::read_gossip_restart_last_voted_fork_slots() {
+  GossipRestartLastVotedForkSlots v;
+  read_bytes(v.from.data(), PUBKEY_BYTES);
+  v.wallclock = read_u64();
+  uint32_t tag = read_u32();
+  if (tag == 0) {
+    v.run_length_encoded = true;
+    size_t count = read_vec_len(1);
+    v.run_lengths.resize(count);
+    read_varints_u16(v.run_lengths.data(), count);
+  } else if (tag == 1) {
+    v.run_length_encoded = false;
+    v.raw_offsets = read_gossip_bit_vec();
+  } else {
+    throw LimcodeError::invalid_encoding("Invalid SlotsOffsets discriminant");
+  }
+  v.last_voted_slot = read_u64();
+  read_bytes(v.last_voted_hash.data(), HASH_BYTES);
+  v.shred_version = read_u16();
+  return v;
+}
+
+inline GossipRestartHeaviestFork
+LimcodeDecoder::read_gossip_restart_heaviest_fork() {
+  GossipRestartHeaviestFork v;
+  read_bytes(v.from.data(), PUBKEY_BYTES);
+  v.wallclock = read_u64();
+  v.last_slot = read_u64();
+  read_bytes(v.last_slot_hash.data(), HASH_BYTES);
+  v.observed_stake = read_u64();
+  v.shred_version = read_u16();
+  return v;
+}
+
+inline CrdsData LimcodeDecoder::read_crds_data() {
+  switch (read_crds_data_type()) {
+  case CrdsDataType::LegacyContactInfo:
+    return read_gossip_legacy_contact_info();
+  case CrdsDataType::Vote:
+    return read_gossip_vote();
+  case CrdsDataType::LowestSlot:
+    return read_gossip_lowest_slot();
+  case CrdsDataType::LegacySnapshotHashes:
+    return GossipLegacySnapshotHashes{read_gossip_slot_hashes()};
+  case CrdsDataType::AccountsHashes:
+    return GossipAccountsHashes{read_gossip_slot_hashes()};
+  case CrdsDataType::EpochSlots:
+    return read_gossip_epoch_slots();
+  case CrdsDataType::LegacyVersion:
+    return read_gossip_legacy_version();
+  case CrdsDataType::Version:
+    return read_gossip_node_version();
+  case CrdsDataType::NodeInstance:
+    return read_gossip_node_instance();
+  case CrdsDataType::DuplicateShred:
+    return read_gossip_duplicate_shred();
+  case CrdsDataType::IncrementalSnapshotHashes:
+    return read_gossip_snapshot_hashes();
+  case CrdsDataType::ContactInfo:
+    return read_gossip_contact_info();
+  case CrdsDataType::RestartLastVotedForkSlots:
+    return read_gossip_restart_last_voted_fork_slots();
+  case CrdsDataType::RestartHeaviestFork:
+    return read_gossip_restart_heaviest_fork();
+  }
+  throw LimcodeError::invalid_encoding("Unknown CrdsData discriminant");
+}
+
+// ==================== Thread-Local Encoders ====================
+
+/// Largest scratch buffer a thread keeps between single-pass calls
+constexpr size_t SINGLE_PASS_SCRATCH_RETAIN = 64 * 1024 * 1024;
+
+/**
+ * @brief Per-thread reusable encoder, one per policy
+ *
+ * Spans returned from it stay valid until the next call using the same
+ * policy on this thread.
+ */
+template <typename Policy> inline Encoder<Policy> &thread_local_encoder() {
+  static thread_local Encoder<Policy> encoder(256 * 1024);
+  return encoder;
+}
+
+namespace internal {
+
+/**
+ * @brief Encode with `write` into warm thread-local scratch, copy it out
+ *
+ * One traversal and no serialized_size() walk. Growing a fresh buffer
+ * through several doublings touches more new pages than the sizing pass
+ * would save, so the scratch is reused and the exact result copied.
+ */
+template <typename Write>
+[[nodiscard]] std::vector<uint8_t> encode_single_pass(Write &&write) {
+  auto &encoder = thread_local_encoder<CheckedPolicy>();
+  encoder.reset();
+  write(encoder);
+  std::vector<uint8_t> result = encoder.to_vector();
+  encoder.reset_and_trim(SINGLE_PASS_SCRATCH_RETAIN);
+  return result;
+}
+
+} // namespace internal
+
+/**
+ * @brief Serialize entries in a single traversal (no size pre-computation)
+ */
+inline std::vector<uint8_t>
+serialize_entries_turbo_v2(const std::vector<Entry> &entries) {
+  return internal::encode_single_pass([&](Encoder<CheckedPolicy> &encoder) {
+    encoder.write_u64(entries.size());
+    encoder.write_entries(entries.data(), entries.size());
+  });
+}
+
 // ==================== Convenience Functions ====================
 
 /**
@@ -2173,11 +3737,8 @@ inline Entry LimcodeDecoder::read_entry() {
  * @brief Serialize an entry to bytes
  */
 [[nodiscard]] inline std::vector<uint8_t> serialize_entry(const Entry &entry) {
-  // Optimized: pre-allocate exact size to avoid reallocation
-  // The encoder methods will use optimized SIMD copies internally
-  LimcodeEncoder encoder(serialized_size(entry));
-  encoder.write_entry(entry);
-  return std::move(encoder).finish();
+  return internal::encode_single_pass(
+      [&](Encoder<CheckedPolicy> &encoder) { encoder.write_entry(entry); });
 }
 
 /**
@@ -2206,11 +3767,9 @@ inline Entry LimcodeDecoder::read_entry() {
  */
 [[nodiscard]] inline std::vector<uint8_t>
 serialize_transaction(const VersionedTransaction &tx) {
-  // Optimized: pre-allocate exact size to avoid reallocation
-  // The encoder methods will use optimized SIMD copies internally
-  LimcodeEncoder encoder(serialized_size(tx));
-  encoder.write_versioned_transaction(tx);
-  return std::move(encoder).finish();
+  return internal::encode_single_pass([&](Encoder<CheckedPolicy> &encoder) {
+    encoder.write_versioned_transaction(tx);
+  });
 }
 
 /**
@@ -2292,6 +3851,62 @@ deserialize_entries(std::span<const uint8_t> data);
 // ==================== Implementation of Forward Declarations
 // ====================
 
+/**
+ * @brief Calculate serialized size of a compiled instruction
+ */
+inline size_t serialized_size(const CompiledInstruction &instr) {
+  return 1 + short_vec_size(static_cast<uint16_t>(instr.accounts.size())) +
+         instr.accounts.size() +
+         short_vec_size(static_cast<uint16_t>(instr.data.size())) +
+         instr.data.size();
+}
+
+/**
+ * @brief Calculate serialized size of an address table lookup
+ */
+inline size_t serialized_size(const AddressTableLookup &atl) {
+  return 32 +
+         short_vec_size(static_cast<uint16_t>(atl.writable_indexes.size())) +
+         atl.writable_indexes.size() +
+         short_vec_size(static_cast<uint16_t>(atl.readonly_indexes.size())) +
+         atl.readonly_indexes.size();
+}
+
+/**
+ * @brief Calculate serialized size of a versioned message
+ */
+inline size_t serialized_size(const VersionedMessage &msg) {
+  return std::visit(
+      [](const auto &m) {
+        size_t size = 3; // header
+        size += short_vec_size(static_cast<uint16_t>(m.account_keys.size()));
+        size += m.account_keys.size() * 32;
+        size += 32; // recent_blockhash
+        size += short_vec_size(static_cast<uint16_t>(m.instructions.size()));
+        for (const auto &instr : m.instructions) {
+          size += serialized_size(instr);
+        }
+        if constexpr (std::is_same_v<std::decay_t<decltype(m)>, V0Message>) {
+          size += 1; // version byte
+          size += short_vec_size(
+              static_cast<uint16_t>(m.address_table_lookups.size()));
+          for (const auto &atl : m.address_table_lookups) {
+            size += serialized_size(atl);
+          }
+        }
+        return size;
+      },
+      msg.inner);
+}
+
+/**
+ * @brief Calculate serialized size of a versioned transaction
+ */
+inline size_t serialized_size(const VersionedTransaction &tx) {
+  return short_vec_size(static_cast<uint16_t>(tx.signatures.size())) +
+         tx.signatures.size() * 64 + serialized_size(tx.message);
+}
+
 /**
  * @brief Calculate serialized size of a single entry
  */
@@ -2299,50 +3914,32 @@ inline size_t serialized_size(const Entry &entry) {
   size_t size =
       8 + 32 + short_vec_size(static_cast<uint16_t>(entry.transactions.size()));
   for (const auto &tx : entry.transactions) {
-    size += short_vec_size(static_cast<uint16_t>(tx.signatures.size()));
-    size += tx.signatures.size() * 64;
+    size += serialized_size(tx);
+  }
+  return size;
+}
 
-    const auto &msg = tx.message;
-    if (msg.is_v0()) {
-      size += 1; // version byte
-      const auto &v0 = msg.as_v0();
-      size += 3; // header
-      size += short_vec_size(static_cast<uint16_t>(v0.account_keys.size()));
-      size += v0.account_keys.size() * 32;
-      size += 32; // recent_blockhash
-      size += short_vec_size(static_cast<uint16_t>(v0.instructions.size()));
-      for (const auto &instr : v0.instructions) {
-        size += 1 +
-                short_vec_size(static_cast<uint16_t>(instr.accounts.size())) +
-                instr.accounts.size() +
-                short_vec_size(static_cast<uint16_t>(instr.data.size())) +
-                instr.data.size();
-      }
-      size += short_vec_size(
-          static_cast<uint16_t>(v0.address_table_lookups.size()));
-      for (const auto &atl : v0.address_table_lookups) {
-        size +=
-            32 +
-            short_vec_size(static_cast<uint16_t>(atl.writable_indexes.size())) +
-            atl.writable_indexes.size() +
-            short_vec_size(static_cast<uint16_t>(atl.readonly_indexes.size())) +
-            atl.readonly_indexes.size();
-      }
-    } else {
-      const auto &legacy = msg.as_legacy();
-      size += 3; // header
-      size += short_vec_size(static_cast<uint16_t>(legacy.account_keys.size()));
-      size += legacy.account_keys.size() * 32;
-      size += 32; // recent_blockhash
-      size += short_vec_size(static_cast<uint16_t>(legacy.instructions.size()));
-      for (const auto &instr : legacy.instructions) {
-        size += 1 +
-                short_vec_size(static_cast<uint16_t>(instr.accounts.size())) +
-                instr.accounts.size() +
-                short_vec_size(static_cast<uint16_t>(instr.data.size())) +
-                instr.data.size();
-      }
-    }
+/**
+ * @brief Calculate serialized size of multiple entries (u64 length prefix)
+ */
+inline size_t serialized_size(const std::vector<Entry> &entries) {
+  LIMCODE_METRIC_TIME(SizePass);
+  size_t size = 8;
+  for (const auto &entry : entries) {
+    size += serialized_size(entry);
+  }
+  return size;
+}
+
+/**
+ * @brief Calculate serialized size of multiple transactions (u64 length
+ * prefix)
+ */
+inline size_t serialized_size(const std::vector<VersionedTransaction> &txs) {
+  LIMCODE_METRIC_TIME(SizePass);
+  size_t size = 8;
+  for (const auto &tx : txs) {
+    size += serialized_size(tx);
   }
   return size;
 }
@@ -2350,6 +3947,36 @@ inline size_t serialized_size(const Entry &entry) {
 // NOTE: serialize_entries() implementation is below after
 // serialize_entries_turbo() is defined
 
+/// Minimum encoded Entry: num_hashes (8) + hash (32) + empty tx list (1)
+constexpr size_t MIN_ENTRY_BYTES = 41;
+
+/**
+ * @brief Deserialize multiple entries (u64 length prefix)
+ */
+inline std::vector<Entry> deserialize_entries(std::span<const uint8_t> data) {
+  LIMCODE_METRIC_TIME(Decode);
+  LimcodeDecoder decoder(data);
+  uint64_t count = decoder.read_u64();
+
+  // Reject counts the input can't hold before reserving
+  if (count > decoder.remaining() / MIN_ENTRY_BYTES) {
+    throw LimcodeError::invalid_encoding("entry count exceeds input size");
+  }
+
+  std::vector<Entry> entries;
+  entries.reserve(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    entries.push_back(decoder.read_entry());
+  }
+  LIMCODE_METRIC_ADD(BytesDecoded, decoder.position());
+  LIMCODE_METRIC_ADD(EntriesDecoded, count);
+  return entries;
+}
+
+inline std::vector<Entry> deserialize_entries(const std::vector<uint8_t> &data) {
+  return deserialize_entries(std::span<const uint8_t>(data));
+}
+
 // ==================== Batch Transaction Serialization ====================
 
 /**
@@ -2372,106 +3999,334 @@ deserialize_transactions(const std::vector<uint8_t> &data);
 [[nodiscard]] size_t
 serialized_size(const std::vector<VersionedTransaction> &txs);
 
-// ==================== Parallel Batch Processing ====================
+inline std::vector<uint8_t>
+serialize_transactions(const std::vector<VersionedTransaction> &txs) {
+  return internal::encode_single_pass([&](Encoder<CheckedPolicy> &encoder) {
+    encoder.write_u64(txs.size());
+    encoder.write_versioned_transactions(txs.data(), txs.size());
+  });
+}
 
-#if LIMCODE_HAS_PARALLEL_STL
-/**
- * @brief Serialize entries in parallel using std::execution::par
- *
- * Each entry is serialized independently, then results are concatenated.
- * Provides significant speedup on multi-core systems for large batches.
- *
- * @param entries Vector of entries to serialize
- * @param min_parallel_size Minimum batch size to use parallelism (default: 16)
- * @return Serialized bytes in bincode-compatible format
- */
-[[nodiscard]] inline ::std::vector<uint8_t>
-serialize_entries_parallel(const ::std::vector<Entry> &entries,
-                           size_t min_parallel_size = 16) {
-  if (entries.size() < min_parallel_size) {
-    return serialize_entries(entries); // Fall back to sequential
-  }
+inline std::vector<VersionedTransaction>
+deserialize_transactions(const std::vector<uint8_t> &data) {
+  LimcodeDecoder decoder(data);
+  uint64_t count = decoder.read_u64();
 
-  // Phase 1: Calculate sizes in parallel
-  ::std::vector<size_t> sizes(entries.size());
-  ::std::transform(::std::execution::par_unseq, entries.begin(), entries.end(),
-                   sizes.begin(),
-                   [](const Entry &e) { return serialized_size(e); });
+  // Smallest transaction: empty signature list + legacy header + two empty
+  // lists + blockhash
+  if (count > decoder.remaining() / 38) {
+    throw LimcodeError::invalid_encoding(
+        "transaction count exceeds input size");
+  }
 
-  // Phase 2: Calculate prefix sums for offsets
-  ::std::vector<size_t> offsets(entries.size() + 1);
-  offsets[0] = 8; // u64 length prefix
-  ::std::inclusive_scan(::std::execution::par_unseq, sizes.begin(), sizes.end(),
-                        offsets.begin() + 1, ::std::plus<>{}, offsets[0]);
+  std::vector<VersionedTransaction> txs;
+  txs.reserve(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    txs.push_back(decoder.read_versioned_transaction());
+  }
+  return txs;
+}
 
-  // Phase 3: Allocate output buffer
-  ::std::vector<uint8_t> result(offsets.back());
+// ==================== Validation ====================
 
-  // Write length prefix
-  uint64_t count = entries.size();
-  ::std::memcpy(result.data(), &count, 8);
+/**
+ * @brief Outcome of validate_transaction() / validate_entries()
+ */
+struct ValidationResult {
+  ErrorCode error = ErrorCode::Ok;
+  /// Bytes consumed when ok(); otherwise the offset validation stopped at
+  size_t consumed = 0;
 
-  // Phase 4: Serialize entries in parallel to their offsets
-  ::std::vector<size_t> indices(entries.size());
-  ::std::iota(indices.begin(), indices.end(), 0);
-
-  ::std::for_each(::std::execution::par_unseq, indices.begin(), indices.end(),
-                  [&](size_t i) {
-                    LimcodeEncoder encoder(sizes[i]);
-                    encoder.write_entry(entries[i]);
-                    auto data = ::std::move(encoder).finish();
-                    ::std::memcpy(result.data() + offsets[i], data.data(),
-                                  data.size());
-                  });
+  [[nodiscard]] bool ok() const noexcept { return error == ErrorCode::Ok; }
+  explicit operator bool() const noexcept { return ok(); }
+};
 
-  return result;
-}
+namespace internal {
 
 /**
- * @brief Serialize transactions in parallel using std::execution::par
+ * @brief Non-throwing, non-allocating structural walk of wire bytes
+ *
+ * Enforces what the decoders enforce plus the canonical ShortVec rules
+ * Agave's short_vec applies: no zero continuation byte (alias) and a third
+ * byte of at most 3 (no u16 overflow). Message versions other than 0 are
+ * rejected.
  */
-[[nodiscard]] inline ::std::vector<uint8_t>
-serialize_transactions_parallel(const ::std::vector<VersionedTransaction> &txs,
-                                size_t min_parallel_size = 16) {
-  if (txs.size() < min_parallel_size) {
-    return serialize_transactions(txs); // Fall back to sequential
+class WireValidator {
+public:
+  WireValidator(const uint8_t *data, size_t size) noexcept
+      : data_(data), size_(size) {}
+
+  [[nodiscard]] ValidationResult result() const noexcept {
+    return {error_, pos_};
   }
 
-  // Phase 1: Calculate sizes in parallel
-  ::std::vector<size_t> sizes(txs.size());
-  ::std::transform(
-      ::std::execution::par_unseq, txs.begin(), txs.end(), sizes.begin(),
-      [](const VersionedTransaction &tx) { return serialized_size(tx); });
+  bool transaction() noexcept {
+    uint16_t sigs;
+    if (!short_vec(sigs) ||
+        !skip(static_cast<size_t>(sigs) * SIGNATURE_BYTES)) {
+      return false;
+    }
+    if (pos_ >= size_) {
+      return fail(ErrorCode::BufferUnderflow);
+    }
+    bool is_v0 = (data_[pos_] & VERSION_PREFIX_MASK) != 0;
+    if (is_v0) {
+      if ((data_[pos_] & ~VERSION_PREFIX_MASK) != 0) {
+        return fail(ErrorCode::InvalidVersion);
+      }
+      ++pos_;
+    }
 
-  // Phase 2: Calculate prefix sums for offsets
-  ::std::vector<size_t> offsets(txs.size() + 1);
-  offsets[0] = 8; // u64 length prefix
-  ::std::inclusive_scan(::std::execution::par_unseq, sizes.begin(), sizes.end(),
-                        offsets.begin() + 1, ::std::plus<>{}, offsets[0]);
+    uint16_t keys;
+    if (!skip(3) || !short_vec(keys) ||
+        !skip(static_cast<size_t>(keys) * PUBKEY_BYTES + HASH_BYTES)) {
+      return false;
+    }
+    if (!prefixed_pairs(1)) {
+      return false;
+    }
+    return !is_v0 || prefixed_pairs(PUBKEY_BYTES);
+  }
 
-  // Phase 3: Allocate output buffer
-  ::std::vector<uint8_t> result(offsets.back());
+  bool entry() noexcept {
+    uint16_t txs;
+    if (!skip(8 + HASH_BYTES) || !short_vec(txs)) {
+      return false;
+    }
+    for (uint16_t i = 0; i < txs; ++i) {
+      if (!transaction()) {
+        return false;
+      }
+    }
+    return true;
+  }
 
-  // Write length prefix
+  /// bincode Vec<Entry>: u64 count, then the entries
+  bool entries() noexcept {
+    if (size_ - pos_ < 8) {
+      return fail(ErrorCode::BufferUnderflow);
+    }
+    uint64_t count;
+    std::memcpy(&count, data_ + pos_, 8);
+    pos_ += 8;
+    if (count > (size_ - pos_) / MIN_ENTRY_BYTES) {
+      return fail(ErrorCode::InvalidEncoding);
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+      if (!entry()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  const uint8_t *data_;
+  size_t size_;
+  size_t pos_ = 0;
+  ErrorCode error_ = ErrorCode::Ok;
+
+  bool fail(ErrorCode code) noexcept {
+    error_ = code;
+    return false;
+  }
+
+  bool skip(size_t count) noexcept {
+    if (size_ - pos_ < count) {
+      return fail(ErrorCode::BufferUnderflow);
+    }
+    pos_ += count;
+    return true;
+  }
+
+  bool short_vec(uint16_t &value) noexcept {
+    size_t avail = size_ - pos_;
+    if (avail == 0) {
+      return fail(ErrorCode::BufferUnderflow);
+    }
+    const uint8_t *p = data_ + pos_;
+    if (LIMCODE_LIKELY(p[0] < 0x80)) {
+      value = p[0];
+      pos_ += 1;
+      return true;
+    }
+    if (avail < 2) {
+      return fail(ErrorCode::BufferUnderflow);
+    }
+    if (p[1] < 0x80) {
+      if (p[1] == 0) {
+        return fail(ErrorCode::InvalidEncoding);
+      }
+      value = static_cast<uint16_t>((p[0] & 0x7F) | (p[1] << 7));
+      pos_ += 2;
+      return true;
+    }
+    if (avail < 3) {
+      return fail(ErrorCode::BufferUnderflow);
+    }
+    if (p[2] == 0 || p[2] > 3) {
+      return fail(ErrorCode::InvalidEncoding);
+    }
+    value = static_cast<uint16_t>((p[0] & 0x7F) | ((p[1] & 0x7F) << 7) |
+                                  (p[2] << 14));
+    pos_ += 3;
+    return true;
+  }
+
+  /// ShortVec count of records: `fixed` bytes and two ShortVec byte strings
+  bool prefixed_pairs(size_t fixed) noexcept {
+    uint16_t count;
+    if (!short_vec(count)) {
+      return false;
+    }
+    for (uint16_t i = 0; i < count; ++i) {
+      uint16_t first;
+      uint16_t second;
+      if (!skip(fixed) || !short_vec(first) || !skip(first) ||
+          !short_vec(second) || !skip(second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+} // namespace internal
+
+/**
+ * @brief Check that `data` starts with a well-formed VersionedTransaction
+ *
+ * Never throws or allocates. Trailing bytes are not an error; compare
+ * `consumed` with the packet size to reject them.
+ */
+[[nodiscard]] inline ValidationResult
+validate_transaction(std::span<const uint8_t> data) noexcept {
+  internal::WireValidator validator(data.data(), data.size());
+  validator.transaction();
+  return validator.result();
+}
+
+/**
+ * @brief Check that `data` starts with a well-formed bincode Vec<Entry>
+ *
+ * Never throws or allocates. Anything this accepts, deserialize_entries()
+ * decodes.
+ */
+[[nodiscard]] inline ValidationResult
+validate_entries(std::span<const uint8_t> data) noexcept {
+  internal::WireValidator validator(data.data(), data.size());
+  validator.entries();
+  return validator.result();
+}
+
+// ==================== Parallel Batch Processing ====================
+
+/**
+ * @brief Serialize entries in parallel on default_executor()
+ *
+ * Sizes are computed in parallel, prefix-summed into offsets, then each
+ * entry is encoded straight into its slot of the output buffer.
+ * Provides significant speedup on multi-core systems for large batches.
+ *
+ * @param entries Vector of entries to serialize
+ * @param min_parallel_size Minimum batch size to use parallelism (default: 16)
+ * @return Serialized bytes in bincode-compatible format
+ */
+[[nodiscard]] inline ::std::vector<uint8_t>
+serialize_entries_parallel(const ::std::vector<Entry> &entries,
+                           size_t min_parallel_size = 16) {
+  if (entries.size() < min_parallel_size) {
+    return serialize_entries(entries); // Fall back to sequential
+  }
+  LIMCODE_METRIC_TIME(Encode);
+  Executor &executor = default_executor();
+
+  // Phase 1: Calculate sizes in parallel
+  ::std::vector<size_t> sizes(entries.size());
+  {
+    LIMCODE_METRIC_TIME(SizePass);
+    executor.parallel_for(entries.size(), 0, [&](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        sizes[i] = serialized_size(entries[i]);
+      }
+    });
+  }
+
+  // Phase 2: Calculate prefix sums for offsets
+  ::std::vector<size_t> offsets(entries.size() + 1);
+  offsets[0] = 8; // u64 length prefix
+  ::std::inclusive_scan(sizes.begin(), sizes.end(), offsets.begin() + 1,
+                        ::std::plus<>{}, offsets[0]);
+
+  // Phase 3: Allocate output buffer
+  ::std::vector<uint8_t> result(offsets.back());
+
+  // Write length prefix
+  uint64_t count = entries.size();
+  ::std::memcpy(result.data(), &count, 8);
+
+  // Phase 4: Serialize entries in parallel to their offsets
+  {
+    LIMCODE_METRIC_TIME(ParallelScatter);
+    executor.parallel_for(entries.size(), 0, [&](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        LimcodeEncoder encoder(sizes[i]);
+        encoder.write_entry(entries[i]);
+        ::std::memcpy(result.data() + offsets[i], encoder.data().data(),
+                      sizes[i]);
+      }
+    });
+  }
+
+  LIMCODE_METRIC_ADD(BytesEncoded, result.size());
+  LIMCODE_METRIC_ADD(EntriesEncoded, entries.size());
+  return result;
+}
+
+/**
+ * @brief Serialize transactions in parallel on default_executor()
+ */
+[[nodiscard]] inline ::std::vector<uint8_t>
+serialize_transactions_parallel(const ::std::vector<VersionedTransaction> &txs,
+                                size_t min_parallel_size = 16) {
+  if (txs.size() < min_parallel_size) {
+    return serialize_transactions(txs); // Fall back to sequential
+  }
+  Executor &executor = default_executor();
+
+  // Phase 1: Calculate sizes in parallel
+  ::std::vector<size_t> sizes(txs.size());
+  executor.parallel_for(txs.size(), 0, [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      sizes[i] = serialized_size(txs[i]);
+    }
+  });
+
+  // Phase 2: Calculate prefix sums for offsets
+  ::std::vector<size_t> offsets(txs.size() + 1);
+  offsets[0] = 8; // u64 length prefix
+  ::std::inclusive_scan(sizes.begin(), sizes.end(), offsets.begin() + 1,
+                        ::std::plus<>{}, offsets[0]);
+
+  // Phase 3: Allocate output buffer
+  ::std::vector<uint8_t> result(offsets.back());
+
+  // Write length prefix
   uint64_t count = txs.size();
   ::std::memcpy(result.data(), &count, 8);
 
   // Phase 4: Serialize transactions in parallel
-  ::std::vector<size_t> indices(txs.size());
-  ::std::iota(indices.begin(), indices.end(), 0);
-
-  ::std::for_each(::std::execution::par_unseq, indices.begin(), indices.end(),
-                  [&](size_t i) {
-                    LimcodeEncoder encoder(sizes[i]);
-                    encoder.write_versioned_transaction(txs[i]);
-                    auto data = ::std::move(encoder).finish();
-                    ::std::memcpy(result.data() + offsets[i], data.data(),
-                                  data.size());
-                  });
+  executor.parallel_for(txs.size(), 0, [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      LimcodeEncoder encoder(sizes[i]);
+      encoder.write_versioned_transaction(txs[i]);
+      ::std::memcpy(result.data() + offsets[i], encoder.data().data(),
+                    sizes[i]);
+    }
+  });
 
   return result;
 }
-#endif // LIMCODE_HAS_PARALLEL_STL
 
 // ==================== Zero-Copy Deserialization ====================
 
@@ -2591,6 +4446,14 @@ public:
     return value;
   }
 
+  [[nodiscard]] uint32_t read_u32() {
+    ensure_remaining(4);
+    uint32_t value;
+    std::memcpy(&value, data_ + pos_, 4);
+    pos_ += 4;
+    return value;
+  }
+
   [[nodiscard]] uint64_t read_u64() {
     ensure_remaining(8);
     uint64_t value;
@@ -2599,6 +4462,41 @@ public:
     return value;
   }
 
+  /// Read a LEB128 varint (serde_varint), as LimcodeDecoder::read_varint
+  [[nodiscard]] uint64_t read_varint() {
+    if (LIMCODE_LIKELY(remaining() >= 8)) {
+      uint64_t value;
+      size_t len = limcode_decode_varint_window(data_ + pos_, value);
+      if (LIMCODE_LIKELY(len != 0)) {
+        pos_ += len;
+        return value;
+      }
+    }
+
+    uint64_t result = 0;
+    int shift = 0;
+    while (true) {
+      ensure_remaining(1);
+      uint8_t byte = data_[pos_++];
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return result;
+      }
+      shift += 7;
+      if (shift >= 64) {
+        throw LimcodeError::invalid_encoding("Varint overflow (>64 bits)");
+      }
+    }
+  }
+
+  [[nodiscard]] uint16_t read_varint_u16() {
+    uint64_t val = read_varint();
+    if (val > 0xFFFF) {
+      throw LimcodeError::invalid_encoding("Varint value too large for u16");
+    }
+    return static_cast<uint16_t>(val);
+  }
+
   [[nodiscard]] uint16_t read_short_vec_len() {
     ensure_remaining(1);
     uint8_t first = data_[pos_++];
@@ -2627,6 +4525,97 @@ public:
     pos_ += count;
   }
 
+  /**
+   * @brief Skip `count` records of `fixed` bytes and two ShortVec byte strings
+   *
+   * The shape of instruction lists (fixed = 1) and address table lookups
+   * (fixed = 32). Prefixes are decoded from 4-byte windows on a local
+   * cursor with one bounds check each; records near the end of the input or
+   * with malformed prefixes take the scalar path for the exact error.
+   */
+  void skip_prefixed_pairs(size_t fixed, size_t count) {
+    const uint8_t *const data = data_;
+    const size_t size = size_;
+    size_t pos = pos_;
+    size_t i = 0;
+    for (; i < count; ++i) {
+      if (size - pos < fixed + 4) {
+        break;
+      }
+      size_t p = pos + fixed;
+      uint16_t len;
+      size_t used = limcode_decode_short_vec_window(data + p, len);
+      if (used == 0) {
+        break;
+      }
+      p += used + len;
+      if (p > size || size - p < 4) {
+        break;
+      }
+      used = limcode_decode_short_vec_window(data + p, len);
+      if (used == 0) {
+        break;
+      }
+      p += used + len;
+      if (p > size) {
+        break;
+      }
+      pos = p;
+    }
+    pos_ = pos;
+    for (; i < count; ++i) {
+      skip(fixed);
+      skip(read_short_vec_len());
+      skip(read_short_vec_len());
+    }
+  }
+
+  /**
+   * @brief Skip `count` records of `fixed` bytes and a LEB128 u16
+   *
+   * Validates every value like read_varint_u16(). With fixed == 0 (a bare
+   * run of varints) each 8-byte load covers every value that ends in it.
+   */
+  void skip_varints_u16(size_t fixed, uint64_t count) {
+    uint64_t i = 0;
+    if (fixed == 0) {
+      uint64_t values[64];
+      while (i < count) {
+        size_t consumed = 0;
+        size_t n = limcode_decode_varints(
+            data_ + pos_, remaining(), values,
+            static_cast<size_t>(std::min<uint64_t>(count - i, 64)), consumed);
+        if (n == 0) {
+          break;
+        }
+        for (size_t k = 0; k < n; ++k) {
+          if (values[k] > 0xFFFF) {
+            throw LimcodeError::invalid_encoding(
+                "Varint value too large for u16");
+          }
+        }
+        pos_ += consumed;
+        i += n;
+      }
+    } else {
+      for (; i < count; ++i) {
+        if (remaining() < fixed + 8) {
+          break;
+        }
+        uint64_t value;
+        size_t used = limcode_decode_varint_window(data_ + pos_ + fixed, value);
+        if (used == 0 || value > 0xFFFF) {
+          break;
+        }
+        pos_ += fixed + used;
+      }
+    }
+    for (; i < count; ++i) {
+      skip(fixed);
+      (void)read_varint_u16();
+    }
+  }
+
   [[nodiscard]] size_t position() const noexcept { return pos_; }
   [[nodiscard]] size_t remaining() const noexcept { return size_ - pos_; }
   [[nodiscard]] bool has_remaining() const noexcept { return pos_ < size_; }
@@ -2660,8 +4649,9 @@ class MappedFile {
 public:
   MappedFile() : data_(nullptr), size_(0), fd_(-1) {}
 
-  explicit MappedFile(const char *path) : data_(nullptr), size_(0), fd_(-1) {
-    open(path);
+  explicit MappedFile(const char *path, int advice = MADV_SEQUENTIAL)
+      : data_(nullptr), size_(0), fd_(-1) {
+    open(path, advice);
   }
 
   ~MappedFile() { close(); }
@@ -2691,7 +4681,11 @@ public:
     return *this;
   }
 
-  bool open(const char *path) {
+  /**
+   * @brief Map a file read-only
+   * @param advice madvise() hint, e.g. MADV_RANDOM for point lookups
+   */
+  bool open(const char *path, int advice = MADV_SEQUENTIAL) {
     close();
 
     fd_ = ::open(path, O_RDONLY);
@@ -2722,8 +4716,8 @@ public:
       return false;
     }
 
-    // Advise kernel about sequential access
-    madvise(data_, size_, MADV_SEQUENTIAL);
+    // Advise kernel about the expected access pattern
+    madvise(data_, size_, advice);
 
     return true;
   }
@@ -2740,6 +4734,13 @@ public:
     size_ = 0;
   }
 
+  /**
+   * @brief Apply an additional madvise() hint to the whole mapping
+   */
+  bool advise(int advice) const noexcept {
+    return data_ != nullptr && madvise(data_, size_, advice) == 0;
+  }
+
   [[nodiscard]] bool is_open() const noexcept { return data_ != nullptr; }
   [[nodiscard]] const uint8_t *data() const noexcept { return data_; }
   [[nodiscard]] size_t size() const noexcept { return size_; }
@@ -2843,7 +4844,11 @@ public:
   }
 
   [[nodiscard]] PubkeyViewIterator begin() const { return {data_, count_}; }
-  [[nodiscard]] PubkeyViewIterator end() const { return {data_, 0}; }
+  [[nodiscard]] PubkeyViewIterator end() const {
+    PubkeyViewIterator it{data_, count_};
+    it.index_ = count_;
+    return it;
+  }
 
   [[nodiscard]] size_t size() const { return count_; }
 
@@ -3017,6 +5022,128 @@ struct EntryView {
   [[nodiscard]] Entry to_owned() const;
 };
 
+/**
+ * @brief Zero-copy view of a GossipContactInfo
+ *
+ * The fixed-position fields (pubkey, wallclock, outset, shred_version,
+ * version) are decoded eagerly so callers can filter on them; addresses and
+ * sockets stay in the buffer until to_owned().
+ */
+struct GossipContactInfoView {
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+
+  HashView pubkey{nullptr};
+  uint64_t wallclock = 0;
+  uint64_t outset = 0;
+  uint16_t shred_version = 0;
+  GossipVersion version;
+
+  size_t addrs_offset = 0;
+  uint16_t addrs_count = 0;
+  size_t sockets_offset = 0;
+  uint16_t sockets_count = 0;
+
+  /// Convert to owned GossipContactInfo (copies all data)
+  [[nodiscard]] GossipContactInfo to_owned() const {
+    LimcodeDecoder decoder(data, size);
+    return decoder.read_gossip_contact_info();
+  }
+};
+
+/**
+ * @brief Zero-copy view of a CrdsData envelope (u32 discriminant + payload)
+ *
+ * `from` and `wallclock` are located for every variant, so values can be
+ * filtered before to_owned() materializes them.
+ */
+struct CrdsDataView {
+  const uint8_t *data = nullptr; ///< Start of the discriminant
+  size_t size = 0;               ///< Discriminant plus payload
+  CrdsDataType type = CrdsDataType::LegacyContactInfo;
+
+  HashView from{nullptr};
+  uint64_t wallclock = 0;
+
+  /// Valid when type == CrdsDataType::ContactInfo
+  GossipContactInfoView contact_info;
+
+  /// Payload bytes following the discriminant
+  [[nodiscard]] std::span<const uint8_t> payload() const {
+    return {data + 4, size - 4};
+  }
+
+  /// Convert to owned CrdsData (copies all data)
+  [[nodiscard]] CrdsData to_owned() const {
+    LimcodeDecoder decoder(data, size);
+    return decoder.read_crds_data();
+  }
+};
+
+/**
+ * @brief Structure-of-arrays sigverify input extracted from serialized entries
+ *
+ * One row per signature: `signatures[i]` is verified against `pubkeys[i]`
+ * over message `signature_message[i]`. Every pointer is a view into the
+ * scanned buffer, which must outlive the batch. Message ranges are stored as
+ * offsets from `base` so they can be uploaded to a GPU verifier unchanged.
+ *
+ * Reuse one batch across calls; clear() keeps the allocated capacity.
+ * With `hash_messages` set, the scan also fills `message_hashes` with the
+ * SHA-256 of each message while its bytes are still in cache.
+ */
+struct SigverifyBatch {
+  const uint8_t *base = nullptr;
+
+  /// Compute message_hashes during the scan (kept across clear())
+  bool hash_messages = false;
+
+  // Per signature
+  std::vector<const uint8_t *> signatures;  // SIGNATURE_BYTES each
+  std::vector<const uint8_t *> pubkeys;     // PUBKEY_BYTES each
+  std::vector<uint32_t> signature_message;  // Index into message arrays
+
+  // Per transaction
+  std::vector<uint32_t> message_offsets;    // From base
+  std::vector<uint32_t> message_sizes;
+  std::vector<uint32_t> first_signature;    // Index into signature arrays
+  std::vector<Hash> message_hashes;         // SHA-256 of message(i), if enabled
+
+  void clear() {
+    base = nullptr;
+    signatures.clear();
+    pubkeys.clear();
+    signature_message.clear();
+    message_offsets.clear();
+    message_sizes.clear();
+    first_signature.clear();
+    message_hashes.clear();
+  }
+
+  /// Reserve for an expected number of transactions and signatures
+  void reserve(size_t transactions, size_t sigs) {
+    signatures.reserve(sigs);
+    pubkeys.reserve(sigs);
+    signature_message.reserve(sigs);
+    message_offsets.reserve(transactions);
+    message_sizes.reserve(transactions);
+    first_signature.reserve(transactions);
+    if (hash_messages) {
+      message_hashes.reserve(transactions);
+    }
+  }
+
+  [[nodiscard]] size_t num_signatures() const { return signatures.size(); }
+  [[nodiscard]] size_t num_transactions() const {
+    return message_offsets.size();
+  }
+
+  /// Signed message bytes of transaction `index` (zero-copy)
+  [[nodiscard]] std::span<const uint8_t> message(size_t index) const {
+    return {base + message_offsets[index], message_sizes[index]};
+  }
+};
+
 /**
  * @brief Zero-copy decoder for high-level structures
  *
@@ -3074,13 +5201,7 @@ public:
     // Instructions (store offset, skip content)
     view.instructions_count = read_short_vec_len();
     view.instructions_offset = position() - start;
-    for (uint16_t i = 0; i < view.instructions_count; ++i) {
-      skip(1); // program_id_index
-      uint16_t accounts_len = read_short_vec_len();
-      skip(accounts_len);
-      uint16_t data_len = read_short_vec_len();
-      skip(data_len);
-    }
+    skip_prefixed_pairs(1, view.instructions_count);
 
     view.size = position() - start;
     return view;
@@ -3106,24 +5227,12 @@ public:
     // Instructions
     view.instructions_count = read_short_vec_len();
     view.instructions_offset = position() - start;
-    for (uint16_t i = 0; i < view.instructions_count; ++i) {
-      skip(1);
-      uint16_t accounts_len = read_short_vec_len();
-      skip(accounts_len);
-      uint16_t data_len = read_short_vec_len();
-      skip(data_len);
-    }
+    skip_prefixed_pairs(1, view.instructions_count);
 
     // Address table lookups
     view.atl_count = read_short_vec_len();
     view.atl_offset = position() - start;
-    for (uint16_t i = 0; i < view.atl_count; ++i) {
-      skip(PUBKEY_BYTES);
-      uint16_t writable_len = read_short_vec_len();
-      skip(writable_len);
-      uint16_t readonly_len = read_short_vec_len();
-      skip(readonly_len);
-    }
+    skip_prefixed_pairs(PUBKEY_BYTES, view.atl_count);
 
     view.size = position() - start;
     return view;
@@ -3187,1447 +5296,1026 @@ public:
 
     // Skip all transactions
     for (uint16_t i = 0; i < view.transactions_count; ++i) {
-      uint16_t sigs_len = read_short_vec_len();
-      skip(sigs_len * SIGNATURE_BYTES);
-
-      // Skip message
-      uint8_t first = peek_u8();
-      if (first & VERSION_PREFIX_MASK) {
-        skip(1); // version
-        // V0 message
-        skip(3); // header
-        uint16_t keys = read_short_vec_len();
-        skip(keys * PUBKEY_BYTES + HASH_BYTES);
-        uint16_t instrs = read_short_vec_len();
-        for (uint16_t j = 0; j < instrs; ++j) {
-          skip(1);
-          uint16_t acc_len = read_short_vec_len();
-          skip(acc_len);
-          uint16_t dat_len = read_short_vec_len();
-          skip(dat_len);
-        }
-        uint16_t atls = read_short_vec_len();
-        for (uint16_t j = 0; j < atls; ++j) {
-          skip(PUBKEY_BYTES);
-          uint16_t wr_len = read_short_vec_len();
-          skip(wr_len);
-          uint16_t ro_len = read_short_vec_len();
-          skip(ro_len);
-        }
-      } else {
-        // Legacy message
-        skip(3); // header
-        uint16_t keys = read_short_vec_len();
-        skip(keys * PUBKEY_BYTES + HASH_BYTES);
-        uint16_t instrs = read_short_vec_len();
-        for (uint16_t j = 0; j < instrs; ++j) {
-          skip(1);
-          uint16_t acc_len = read_short_vec_len();
-          skip(acc_len);
-          uint16_t dat_len = read_short_vec_len();
-          skip(dat_len);
-        }
-      }
+      skip_versioned_transaction();
     }
 
     view.size = position() - start;
     return view;
   }
 
-  /// Get pointer to underlying data
-  [[nodiscard]] const uint8_t *data_ptr() const {
-    return ZeroCopyDecoder::data_ptr_internal();
+  /// Advance past one serialized transaction without building a view
+  void skip_versioned_transaction() {
+    uint16_t sigs_len = read_short_vec_len();
+    skip(static_cast<size_t>(sigs_len) * SIGNATURE_BYTES);
+
+    bool is_v0 = (peek_u8() & VERSION_PREFIX_MASK) != 0;
+    if (is_v0) {
+      skip(1); // version
+    }
+    skip(3); // header
+    uint16_t keys = read_short_vec_len();
+    skip(static_cast<size_t>(keys) * PUBKEY_BYTES + HASH_BYTES);
+    skip_prefixed_pairs(1, read_short_vec_len());
+    if (is_v0) {
+      skip_prefixed_pairs(PUBKEY_BYTES, read_short_vec_len());
+    }
   }
 
-protected:
-  [[nodiscard]] uint8_t peek_u8() const {
-    if (remaining() < 1) {
-      throw LimcodeError::buffer_underflow(1, remaining());
+  /// Advance past one serialized entry without building a view
+  void skip_entry() {
+    skip(8 + HASH_BYTES); // num_hashes, hash
+    uint16_t tx_count = read_short_vec_len();
+    for (uint16_t i = 0; i < tx_count; ++i) {
+      skip_versioned_transaction();
     }
-    return data_ptr()[position()];
   }
-};
 
-// ==================== TURBO MODE ENCODER ====================
+  // ==================== Gossip Views ====================
 
-/**
- * @brief Ultra-fast encoder using all available optimizations
- *
- * Key optimizations:
- * 1. Pre-allocated buffer (no malloc in hot path)
- * 2. Unchecked writes (size pre-computed)
- * 3. SIMD bulk copies for pubkeys/signatures
- * 4. Branchless ShortVec encoding
- * 5. Direct pointer arithmetic (no std::vector overhead)
- */
-class TurboEncoder {
-public:
-  static constexpr size_t INITIAL_CAPACITY = 64 * 1024; // 64KB default
-
-  TurboEncoder() : buffer_(INITIAL_CAPACITY), pos_(0) {}
-
-  explicit TurboEncoder(size_t capacity) : buffer_(capacity), pos_(0) {}
-
-  // Reset for reuse (zero-allocation serialization)
-  void reset() noexcept { pos_ = 0; }
-
-  // Reserve capacity (call before serializing if size known)
-  void reserve(size_t capacity) {
-    if (capacity > buffer_.size()) {
-      buffer_.resize(capacity);
-    }
-  }
-
-  // Get raw pointer for direct writing
-  [[nodiscard]] uint8_t *data() noexcept { return buffer_.data(); }
-  [[nodiscard]] size_t size() const noexcept { return pos_; }
-  [[nodiscard]] size_t capacity() const noexcept { return buffer_.size(); }
-
-  // Extract result (move semantics)
-  [[nodiscard]] std::vector<uint8_t> finish() {
-    buffer_.resize(pos_);
-    auto result = std::move(buffer_);
-    buffer_ = std::vector<uint8_t>(INITIAL_CAPACITY);
-    pos_ = 0;
-    return result;
+  /// Parse GossipVersion (small and fixed-shape, so decoded rather than viewed)
+  [[nodiscard]] GossipVersion read_gossip_version() {
+    GossipVersion ver;
+    ver.major = read_varint_u16();
+    ver.minor = read_varint_u16();
+    ver.patch = read_varint_u16();
+    ver.commit = read_u32();
+    ver.feature_set = read_u32();
+    ver.client = read_varint_u16();
+    return ver;
   }
 
-  // Get result as span (zero-copy, buffer stays valid)
-  [[nodiscard]] std::span<const uint8_t> as_span() const noexcept {
-    return {buffer_.data(), pos_};
-  }
+  /// Parse a GossipContactInfo as a view, validating the skipped lists
+  [[nodiscard]] GossipContactInfoView read_gossip_contact_info_view() {
+    GossipContactInfoView view;
+    size_t start = position();
+    view.data = data_ptr() + start;
 
-  // ==================== Unchecked Primitive Writes ====================
+    view.pubkey = read_pubkey_view();
+    view.wallclock = read_varint();
+    view.outset = read_u64();
+    view.shred_version = read_u16();
+    view.version = read_gossip_version();
 
-  LIMCODE_ALWAYS_INLINE void write_u8_unchecked(uint8_t value) noexcept {
-    buffer_[pos_++] = value;
-  }
+    view.addrs_count = read_short_vec_len();
+    view.addrs_offset = position() - start;
+    for (uint16_t i = 0; i < view.addrs_count; ++i) {
+      skip_gossip_ip_addr();
+    }
 
-  LIMCODE_ALWAYS_INLINE void write_u64_unchecked(uint64_t value) noexcept {
-#if LIMCODE_HAS_X86_64_ASM
-    limcode_store_u64(buffer_.data() + pos_, value);
-#else
-    std::memcpy(buffer_.data() + pos_, &value, 8);
-#endif
-    pos_ += 8;
-  }
+    view.sockets_count = read_short_vec_len();
+    view.sockets_offset = position() - start;
+    skip_varints_u16(2, view.sockets_count); // key, index, offset
 
-  // Branchless ShortVec encoding
-  LIMCODE_ALWAYS_INLINE void
-  write_short_vec_len_unchecked(uint16_t len) noexcept {
-#if LIMCODE_HAS_X86_64_ASM
-    size_t bytes_written =
-        limcode_encode_shortvec_branchless(len, buffer_.data() + pos_);
-    pos_ += bytes_written;
-#else
-    if (len < 0x80) {
-      buffer_[pos_++] = static_cast<uint8_t>(len);
-    } else if (len < 0x4000) {
-      buffer_[pos_++] = static_cast<uint8_t>((len & 0x7F) | 0x80);
-      buffer_[pos_++] = static_cast<uint8_t>(len >> 7);
-    } else {
-      buffer_[pos_++] = static_cast<uint8_t>((len & 0x7F) | 0x80);
-      buffer_[pos_++] = static_cast<uint8_t>(((len >> 7) & 0x7F) | 0x80);
-      buffer_[pos_++] = static_cast<uint8_t>(len >> 14);
+    if (read_short_vec_len() != 0) {
+      throw LimcodeError::invalid_encoding("Unknown ContactInfo extension");
     }
-#endif
-  }
 
-  // ==================== SIMD Bulk Copies ====================
-
-  LIMCODE_ALWAYS_INLINE void write_hash_unchecked(const uint8_t *src) noexcept {
-    limcode_copy32(buffer_.data() + pos_, src);
-    pos_ += 32;
+    view.size = position() - start;
+    return view;
   }
 
-  LIMCODE_ALWAYS_INLINE void
-  write_signature_unchecked(const uint8_t *src) noexcept {
-    limcode_copy64(buffer_.data() + pos_, src);
-    pos_ += 64;
-  }
+  /**
+   * @brief Parse a CrdsData envelope as a view
+   * @throws LimcodeError on unknown discriminants or malformed payloads
+   */
+  [[nodiscard]] CrdsDataView read_crds_data_view() {
+    CrdsDataView view;
+    size_t start = position();
+    view.data = data_ptr() + start;
 
-  LIMCODE_ALWAYS_INLINE void
-  write_pubkeys_bulk_unchecked(const uint8_t *src, size_t count) noexcept {
-    uint8_t *dst = buffer_.data() + pos_;
-#if LIMCODE_HAS_AVX512 || LIMCODE_HAS_AVX2
-    // Process 2 pubkeys (64 bytes) at a time
-    size_t pairs = count / 2;
-    for (size_t i = 0; i < pairs; ++i) {
-      limcode_copy64(dst, src);
-      dst += 64;
-      src += 64;
-    }
-    if (count & 1) {
-      limcode_copy32(dst, src);
+    uint32_t tag = read_u32();
+    if (tag > static_cast<uint32_t>(CrdsDataType::RestartHeaviestFork)) {
+      throw LimcodeError::invalid_encoding("Unknown CrdsData discriminant " +
+                                           std::to_string(tag));
+    }
+    view.type = static_cast<CrdsDataType>(tag);
+
+    // Most variants lead with from: Pubkey, wallclock: u64
+    auto read_from_wallclock = [&] {
+      view.from = read_pubkey_view();
+      view.wallclock = read_u64();
+    };
+
+    switch (view.type) {
+    case CrdsDataType::LegacyContactInfo:
+      view.from = read_pubkey_view();
+      for (int i = 0; i < 10; ++i) {
+        skip_gossip_ip_addr();
+        skip(2); // port
+      }
+      view.wallclock = read_u64();
+      skip(2); // shred_version
+      break;
+    case CrdsDataType::Vote:
+      skip(1); // index
+      view.from = read_pubkey_view();
+      skip_legacy_transaction();
+      view.wallclock = read_u64();
+      break;
+    case CrdsDataType::LowestSlot:
+      skip(1); // deprecated
+      view.from = read_pubkey_view();
+      skip(16); // root, lowest
+      if (read_u64() != 0 || read_u64() != 0) {
+        throw LimcodeError::invalid_encoding(
+            "LowestSlot slots/stash must be empty");
+      }
+      view.wallclock = read_u64();
+      break;
+    case CrdsDataType::LegacySnapshotHashes:
+    case CrdsDataType::AccountsHashes:
+      view.from = read_pubkey_view();
+      skip_bincode_vec(8 + HASH_BYTES);
+      view.wallclock = read_u64();
+      break;
+    case CrdsDataType::EpochSlots: {
+      skip(1); // index
+      view.from = read_pubkey_view();
+      uint64_t count = read_u64();
+      for (uint64_t i = 0; i < count; ++i) {
+        uint32_t slots_tag = read_u32();
+        if (slots_tag > 1) {
+          throw LimcodeError::invalid_encoding(
+              "Invalid CompressedSlots discriminant");
+        }
+        skip(16); // first_slot, num
+        if (slots_tag == 0) {
+          skip_bincode_vec(1);
+        } else {
+          skip_gossip_bit_vec();
+        }
+      }
+      view.wallclock = read_u64();
+      break;
+    }
+    case CrdsDataType::LegacyVersion:
+    case CrdsDataType::Version:
+      read_from_wallclock();
+      skip(6); // major, minor, patch
+      switch (read_u8()) {
+      case 0:
+        break;
+      case 1:
+        skip(4);
+        break;
+      default:
+        throw LimcodeError::invalid_encoding("Invalid Option tag in version");
+      }
+      if (view.type == CrdsDataType::Version) {
+        skip(4); // feature_set
+      }
+      break;
+    case CrdsDataType::NodeInstance:
+      read_from_wallclock();
+      skip(16); // timestamp, token
+      break;
+    case CrdsDataType::DuplicateShred:
+      skip(2); // index
+      read_from_wallclock();
+      skip(8 + 4 + 3); // slot, unused, shred_type, num_chunks, chunk_index
+      skip_bincode_vec(1);
+      break;
+    case CrdsDataType::IncrementalSnapshotHashes:
+      view.from = read_pubkey_view();
+      skip(8 + HASH_BYTES); // full
+      skip_bincode_vec(8 + HASH_BYTES);
+      view.wallclock = read_u64();
+      break;
+    case CrdsDataType::ContactInfo:
+      view.contact_info = read_gossip_contact_info_view();
+      view.from = view.contact_info.pubkey;
+      view.wallclock = view.contact_info.wallclock;
+      break;
+    case CrdsDataType::RestartLastVotedForkSlots: {
+      read_from_wallclock();
+      uint32_t offsets_tag = read_u32();
+      if (offsets_tag == 0) {
+        skip_varints_u16(0, read_u64());
+      } else if (offsets_tag == 1) {
+        skip_gossip_bit_vec();
+      } else {
+        throw LimcodeError::invalid_encoding(
+            "Invalid SlotsOffsets discriminant");
+      }
+      skip(8 + HASH_BYTES + 2); // last_voted_slot, hash, shred_version
+      break;
     }
-#else
-    for (size_t i = 0; i < count; ++i) {
-      limcode_copy32(dst, src);
-      dst += 32;
-      src += 32;
+    case CrdsDataType::RestartHeaviestFork:
+      read_from_wallclock();
+      skip(8 + HASH_BYTES + 8 + 2);
+      break;
     }
-#endif
-    pos_ += count * PUBKEY_BYTES;
-  }
 
-  LIMCODE_ALWAYS_INLINE void
-  write_signatures_bulk_unchecked(const uint8_t *src, size_t count) noexcept {
-    uint8_t *dst = buffer_.data() + pos_;
-    for (size_t i = 0; i < count; ++i) {
-      limcode_copy64(dst, src);
-      dst += 64;
-      src += 64;
-    }
-    pos_ += count * SIGNATURE_BYTES;
+    view.size = position() - start;
+    return view;
   }
 
-  LIMCODE_ALWAYS_INLINE void write_bytes_unchecked(const uint8_t *src,
-                                                   size_t len) noexcept {
-    if (len == 0)
-      return;
-#if LIMCODE_HAS_X86_64_ASM
-    if (len >= 64) {
-      limcode_rep_movsb(buffer_.data() + pos_, src, len);
-    } else {
-      std::memcpy(buffer_.data() + pos_, src, len);
-    }
-#else
-    std::memcpy(buffer_.data() + pos_, src, len);
-#endif
-    pos_ += len;
-  }
-
-  // ==================== High-Level Turbo Serializers ====================
-
-  void write_message_header_turbo(const MessageHeader &header) noexcept {
-    buffer_[pos_++] = header.num_required_signatures;
-    buffer_[pos_++] = header.num_readonly_signed_accounts;
-    buffer_[pos_++] = header.num_readonly_unsigned_accounts;
-  }
-
-  void
-  write_compiled_instruction_turbo(const CompiledInstruction &instr) noexcept {
-    write_u8_unchecked(instr.program_id_index);
-    write_short_vec_len_unchecked(static_cast<uint16_t>(instr.accounts.size()));
-    write_bytes_unchecked(instr.accounts.data(), instr.accounts.size());
-    write_short_vec_len_unchecked(static_cast<uint16_t>(instr.data.size()));
-    write_bytes_unchecked(instr.data.data(), instr.data.size());
-  }
-
-  void
-  write_address_table_lookup_turbo(const AddressTableLookup &atl) noexcept {
-    write_hash_unchecked(atl.account_key.data());
-    write_short_vec_len_unchecked(
-        static_cast<uint16_t>(atl.writable_indexes.size()));
-    write_bytes_unchecked(atl.writable_indexes.data(),
-                          atl.writable_indexes.size());
-    write_short_vec_len_unchecked(
-        static_cast<uint16_t>(atl.readonly_indexes.size()));
-    write_bytes_unchecked(atl.readonly_indexes.data(),
-                          atl.readonly_indexes.size());
-  }
-
-  void write_legacy_message_turbo(const LegacyMessage &msg) noexcept {
-    write_message_header_turbo(msg.header);
-    write_short_vec_len_unchecked(
-        static_cast<uint16_t>(msg.account_keys.size()));
-    if (!msg.account_keys.empty()) {
-      write_pubkeys_bulk_unchecked(
-          reinterpret_cast<const uint8_t *>(msg.account_keys.data()),
-          msg.account_keys.size());
-    }
-    write_hash_unchecked(msg.recent_blockhash.data());
-    write_short_vec_len_unchecked(
-        static_cast<uint16_t>(msg.instructions.size()));
-    for (const auto &instr : msg.instructions) {
-      write_compiled_instruction_turbo(instr);
+  /// Advance past a bincode Vec of fixed-size elements
+  void skip_bincode_vec(size_t element_size) {
+    uint64_t count = read_u64();
+    if (count > remaining() / element_size) {
+      throw LimcodeError::invalid_encoding("Vec length exceeds input size");
     }
+    skip(static_cast<size_t>(count) * element_size);
   }
 
-  void write_v0_message_turbo(const V0Message &msg) noexcept {
-    write_message_header_turbo(msg.header);
-    write_short_vec_len_unchecked(
-        static_cast<uint16_t>(msg.account_keys.size()));
-    if (!msg.account_keys.empty()) {
-      write_pubkeys_bulk_unchecked(
-          reinterpret_cast<const uint8_t *>(msg.account_keys.data()),
-          msg.account_keys.size());
-    }
-    write_hash_unchecked(msg.recent_blockhash.data());
-    write_short_vec_len_unchecked(
-        static_cast<uint16_t>(msg.instructions.size()));
-    for (const auto &instr : msg.instructions) {
-      write_compiled_instruction_turbo(instr);
-    }
-    write_short_vec_len_unchecked(
-        static_cast<uint16_t>(msg.address_table_lookups.size()));
-    for (const auto &atl : msg.address_table_lookups) {
-      write_address_table_lookup_turbo(atl);
+  /// Advance past a std::net::IpAddr
+  void skip_gossip_ip_addr() {
+    uint32_t tag = read_u32();
+    if (tag > 1) {
+      throw LimcodeError::invalid_encoding("Invalid IpAddr discriminant");
     }
+    skip(tag == 0 ? 4 : 16);
   }
 
-  void write_versioned_message_turbo(const VersionedMessage &msg) noexcept {
-    if (msg.is_v0()) {
-      write_u8_unchecked(VERSION_PREFIX_MASK);
-      write_v0_message_turbo(msg.as_v0());
-    } else {
-      write_legacy_message_turbo(msg.as_legacy());
+  /// Advance past a bv::BitVec<u8>
+  void skip_gossip_bit_vec() {
+    switch (read_u8()) {
+    case 0:
+      break;
+    case 1:
+      skip_bincode_vec(1);
+      break;
+    default:
+      throw LimcodeError::invalid_encoding("Invalid Option tag in BitVec");
     }
+    skip(8); // len
   }
 
-  void
-  write_versioned_transaction_turbo(const VersionedTransaction &tx) noexcept {
-    write_short_vec_len_unchecked(static_cast<uint16_t>(tx.signatures.size()));
-    if (!tx.signatures.empty()) {
-      write_signatures_bulk_unchecked(
-          reinterpret_cast<const uint8_t *>(tx.signatures.data()),
-          tx.signatures.size());
+  /// Advance past a legacy Transaction (no version prefix allowed)
+  void skip_legacy_transaction() {
+    uint16_t sigs_len = read_short_vec_len();
+    skip(static_cast<size_t>(sigs_len) * SIGNATURE_BYTES);
+    if ((peek_u8() & VERSION_PREFIX_MASK) != 0) {
+      throw LimcodeError::invalid_legacy_header(peek_u8());
     }
-    write_versioned_message_turbo(tx.message);
+    skip(3); // header
+    uint16_t keys = read_short_vec_len();
+    skip(static_cast<size_t>(keys) * PUBKEY_BYTES + HASH_BYTES);
+    skip_prefixed_pairs(1, read_short_vec_len());
   }
 
-  void write_entry_turbo(const Entry &entry) noexcept {
-    write_u64_unchecked(entry.num_hashes);
-    write_hash_unchecked(entry.hash.data());
-    write_short_vec_len_unchecked(
-        static_cast<uint16_t>(entry.transactions.size()));
-    for (const auto &tx : entry.transactions) {
-      write_versioned_transaction_turbo(tx);
+  /**
+   * @brief Append the sigverify rows of one transaction to `batch`
+   *
+   * Walks the transaction exactly like read_versioned_transaction_view() and
+   * records signature, signer pubkey and message range, without building
+   * any views. Throws LimcodeError if the signature count disagrees with
+   * num_required_signatures or exceeds the account keys.
+   */
+  void read_sigverify_transaction(SigverifyBatch &batch) {
+    const uint8_t *base = data_ptr();
+    if (batch.base == nullptr) {
+      batch.base = base;
+    } else if (batch.base != base) {
+      throw LimcodeError::invalid_encoding(
+          "sigverify batch spans multiple buffers");
     }
-  }
-
-private:
-  std::vector<uint8_t> buffer_;
-  size_t pos_;
-};
-
-// ==================== Thread-Local Turbo Encoder ====================
-
-inline TurboEncoder &get_thread_local_turbo_encoder() {
-  static thread_local TurboEncoder encoder(256 * 1024);
-  return encoder;
-}
-
-// ==================== Turbo Batch Serialization ====================
-
-inline std::vector<uint8_t>
-serialize_entries_turbo(const std::vector<Entry> &entries) {
-  size_t total_size = 8;
-  for (const auto &entry : entries) {
-    total_size += serialized_size(entry);
-  }
 
-  TurboEncoder encoder(total_size);
-  encoder.write_u64_unchecked(entries.size());
+    uint16_t sig_count = read_short_vec_len();
+    const uint8_t *sigs = base + position();
+    skip(static_cast<size_t>(sig_count) * SIGNATURE_BYTES);
 
-  constexpr size_t PREFETCH_DISTANCE = 4;
-  const size_t n = entries.size();
-
-  for (size_t i = 0; i < n; ++i) {
-    if (i + PREFETCH_DISTANCE < n) {
-      LIMCODE_PREFETCH(&entries[i + PREFETCH_DISTANCE]);
+    size_t message_start = position();
+    uint8_t first = peek_u8();
+    bool is_v0 = (first & VERSION_PREFIX_MASK) != 0;
+    if (is_v0) {
+      if ((first & 0x7F) != 0) {
+        throw LimcodeError::invalid_version(first & 0x7F);
+      }
+      skip(1);
     }
-    encoder.write_entry_turbo(entries[i]);
-  }
-
-  return encoder.finish();
-}
-
-/**
- * @brief Serialize multiple entries (implementation delegates to turbo version)
- *
- * This is the standard serialize_entries() function that was forward-declared
- * earlier. It simply delegates to the optimized turbo version.
- */
-inline std::vector<uint8_t>
-serialize_entries(const std::vector<Entry> &entries) {
-  return serialize_entries_turbo(entries);
-}
-
-inline std::span<const uint8_t>
-serialize_entries_turbo_zero_alloc(const std::vector<Entry> &entries) {
-  auto &encoder = get_thread_local_turbo_encoder();
-  encoder.reset();
+    uint8_t num_required_signatures = read_u8();
+    skip(2); // Rest of header
 
-  size_t total_size = 8;
-  for (const auto &entry : entries) {
-    total_size += serialized_size(entry);
-  }
-  encoder.reserve(total_size);
-
-  encoder.write_u64_unchecked(entries.size());
-  for (const auto &entry : entries) {
-    encoder.write_entry_turbo(entry);
-  }
+    uint16_t key_count = read_short_vec_len();
+    const uint8_t *keys = base + position();
+    skip(static_cast<size_t>(key_count) * PUBKEY_BYTES + HASH_BYTES);
 
-  return encoder.as_span();
-}
-
-// ==================== TURBO V2: NO SIZE PRE-COMPUTATION ====================
-
-/**
- * @brief Ultra-fast encoder that grows buffer on demand
- *
- * Eliminates the serialized_size() overhead by:
- * 1. Starting with estimated size based on entry count
- * 2. Growing buffer exponentially if needed
- * 3. Using unsafe writes that assume capacity
- */
-class TurboEncoderV2 {
-public:
-  static constexpr size_t AVG_ENTRY_SIZE = 350; // Average bytes per entry
-  static constexpr size_t GROWTH_FACTOR = 2;
-
-  explicit TurboEncoderV2(size_t estimated_entries)
-      : capacity_(8 + estimated_entries * AVG_ENTRY_SIZE), pos_(0) {
-    buffer_ = static_cast<uint8_t *>(std::malloc(capacity_));
-  }
-
-  ~TurboEncoderV2() {
-    if (buffer_)
-      std::free(buffer_);
-  }
-
-  TurboEncoderV2(const TurboEncoderV2 &) = delete;
-  TurboEncoderV2 &operator=(const TurboEncoderV2 &) = delete;
-
-  [[nodiscard]] std::vector<uint8_t> finish() {
-    std::vector<uint8_t> result(buffer_, buffer_ + pos_);
-    return result;
-  }
-
-  // Ensure at least n bytes available
-  LIMCODE_ALWAYS_INLINE void ensure_capacity(size_t n) {
-    if (LIMCODE_LIKELY(pos_ + n <= capacity_))
-      return;
-    grow(n);
-  }
-
-  void grow(size_t needed) {
-    size_t new_cap = std::max(capacity_ * GROWTH_FACTOR, pos_ + needed + 1024);
-    buffer_ = static_cast<uint8_t *>(std::realloc(buffer_, new_cap));
-    capacity_ = new_cap;
-  }
-
-  // Direct writes - caller ensures capacity
-  LIMCODE_ALWAYS_INLINE void write_u8(uint8_t v) { buffer_[pos_++] = v; }
-
-  LIMCODE_ALWAYS_INLINE void write_u64(uint64_t v) {
-    std::memcpy(buffer_ + pos_, &v, 8);
-    pos_ += 8;
-  }
-
-  LIMCODE_ALWAYS_INLINE void write_shortvec(uint16_t len) {
-    if (len < 0x80) {
-      buffer_[pos_++] = static_cast<uint8_t>(len);
-    } else if (len < 0x4000) {
-      buffer_[pos_++] = static_cast<uint8_t>((len & 0x7F) | 0x80);
-      buffer_[pos_++] = static_cast<uint8_t>(len >> 7);
-    } else {
-      buffer_[pos_++] = static_cast<uint8_t>((len & 0x7F) | 0x80);
-      buffer_[pos_++] = static_cast<uint8_t>(((len >> 7) & 0x7F) | 0x80);
-      buffer_[pos_++] = static_cast<uint8_t>(len >> 14);
+    if (sig_count != num_required_signatures || sig_count > key_count) {
+      throw LimcodeError::invalid_encoding(
+          "signature count does not match message header");
     }
-  }
-
-  LIMCODE_ALWAYS_INLINE void write_bytes32(const uint8_t *src) {
-    limcode_copy32(buffer_ + pos_, src);
-    pos_ += 32;
-  }
 
-  LIMCODE_ALWAYS_INLINE void write_bytes64(const uint8_t *src) {
-    limcode_copy64(buffer_ + pos_, src);
-    pos_ += 64;
-  }
-
-  LIMCODE_ALWAYS_INLINE void write_bytes(const uint8_t *src, size_t len) {
-    std::memcpy(buffer_ + pos_, src, len);
-    pos_ += len;
-  }
-
-  // Estimate capacity needed for an entry (upper bound)
-  static size_t estimate_entry_size(const Entry &e) {
-    // 8 (num_hashes) + 32 (hash) + 3 (shortvec) + transactions
-    size_t size = 43;
-    for (const auto &tx : e.transactions) {
-      size += 3 + tx.signatures.size() * 64; // signatures
-      size += 256;                           // message estimate
+    skip_prefixed_pairs(1, read_short_vec_len());
+    if (is_v0) {
+      skip_prefixed_pairs(PUBKEY_BYTES, read_short_vec_len());
     }
-    return size;
-  }
-
-  void write_entry_v2(const Entry &entry) {
-    // Ensure we have enough space (estimate)
-    ensure_capacity(estimate_entry_size(entry));
-
-    write_u64(entry.num_hashes);
-    write_bytes32(entry.hash.data());
-    write_shortvec(static_cast<uint16_t>(entry.transactions.size()));
 
-    for (const auto &tx : entry.transactions) {
-      write_transaction_v2(tx);
+    size_t message_end = position();
+    if (message_end > UINT32_MAX) {
+      throw LimcodeError::invalid_encoding(
+          "sigverify batch exceeds 4 GiB of input");
     }
-  }
 
-  void write_transaction_v2(const VersionedTransaction &tx) {
-    // Signatures
-    write_shortvec(static_cast<uint16_t>(tx.signatures.size()));
-    for (const auto &sig : tx.signatures) {
-      ensure_capacity(64);
-      write_bytes64(sig.data());
+    auto tx_index = static_cast<uint32_t>(batch.message_offsets.size());
+    batch.message_offsets.push_back(static_cast<uint32_t>(message_start));
+    batch.message_sizes.push_back(
+        static_cast<uint32_t>(message_end - message_start));
+    batch.first_signature.push_back(
+        static_cast<uint32_t>(batch.signatures.size()));
+    if (batch.hash_messages) {
+      batch.message_hashes.push_back(Sha256::compute(
+          {base + message_start, message_end - message_start}));
     }
 
-    // Message
-    write_message_v2(tx.message);
+    for (uint16_t s = 0; s < sig_count; ++s) {
+      batch.signatures.push_back(sigs + s * SIGNATURE_BYTES);
+      batch.pubkeys.push_back(keys + s * PUBKEY_BYTES);
+      batch.signature_message.push_back(tx_index);
+    }
   }
 
-  void write_message_v2(const VersionedMessage &msg) {
-    if (msg.is_v0()) {
-      write_u8(VERSION_PREFIX_MASK);
-      write_v0_message_v2(msg.as_v0());
-    } else {
-      write_legacy_message_v2(msg.as_legacy());
+  /// Append the sigverify rows of every transaction in one entry
+  void read_sigverify_entry(SigverifyBatch &batch) {
+    skip(8 + HASH_BYTES); // num_hashes, hash
+    uint16_t tx_count = read_short_vec_len();
+    for (uint16_t i = 0; i < tx_count; ++i) {
+      read_sigverify_transaction(batch);
     }
   }
 
-  void write_legacy_message_v2(const LegacyMessage &msg) {
-    ensure_capacity(3 + msg.account_keys.size() * 32 + 32 + 128);
-
-    // Header
-    write_u8(msg.header.num_required_signatures);
-    write_u8(msg.header.num_readonly_signed_accounts);
-    write_u8(msg.header.num_readonly_unsigned_accounts);
-
-    // Account keys
-    write_shortvec(static_cast<uint16_t>(msg.account_keys.size()));
-    for (const auto &key : msg.account_keys) {
-      write_bytes32(key.data());
+  /**
+   * @brief Append the sigverify rows of a bincode Vec<Entry>
+   * @return Number of entries scanned
+   */
+  size_t read_sigverify_entries(SigverifyBatch &batch) {
+    uint64_t count = read_u64();
+    // Reject counts the input can't hold
+    if (count > remaining() / MIN_ENTRY_BYTES) {
+      throw LimcodeError::invalid_encoding("entry count exceeds input size");
     }
-
-    // Blockhash
-    write_bytes32(msg.recent_blockhash.data());
-
-    // Instructions
-    write_shortvec(static_cast<uint16_t>(msg.instructions.size()));
-    for (const auto &instr : msg.instructions) {
-      write_instruction_v2(instr);
+    for (uint64_t i = 0; i < count; ++i) {
+      read_sigverify_entry(batch);
     }
+    return static_cast<size_t>(count);
   }
 
-  void write_v0_message_v2(const V0Message &msg) {
-    ensure_capacity(4 + msg.account_keys.size() * 32 + 32 + 128);
-
-    // Header
-    write_u8(msg.header.num_required_signatures);
-    write_u8(msg.header.num_readonly_signed_accounts);
-    write_u8(msg.header.num_readonly_unsigned_accounts);
-
-    // Account keys
-    write_shortvec(static_cast<uint16_t>(msg.account_keys.size()));
-    for (const auto &key : msg.account_keys) {
-      write_bytes32(key.data());
+  /**
+   * @brief read_sigverify_entries(), feeding the scanned bytes to `digest`
+   *
+   * Each entry is digested right after it is scanned, so e.g. a storage
+   * checksum costs no extra pass over the block. On a malformed entry the
+   * digest has seen the entries before it.
+   */
+  template <ByteDigest Digest>
+  size_t read_sigverify_entries(SigverifyBatch &batch, Digest &digest) {
+    size_t start = position();
+    uint64_t count = read_u64();
+    if (count > remaining() / MIN_ENTRY_BYTES) {
+      throw LimcodeError::invalid_encoding("entry count exceeds input size");
     }
-
-    // Blockhash
-    write_bytes32(msg.recent_blockhash.data());
-
-    // Instructions
-    write_shortvec(static_cast<uint16_t>(msg.instructions.size()));
-    for (const auto &instr : msg.instructions) {
-      write_instruction_v2(instr);
+    for (uint64_t i = 0; i < count; ++i) {
+      read_sigverify_entry(batch);
+      digest.update({data_ptr() + start, position() - start});
+      start = position();
     }
-
-    // Address table lookups
-    write_shortvec(static_cast<uint16_t>(msg.address_table_lookups.size()));
-    for (const auto &atl : msg.address_table_lookups) {
-      ensure_capacity(32 + atl.writable_indexes.size() +
-                      atl.readonly_indexes.size() + 6);
-      write_bytes32(atl.account_key.data());
-      write_shortvec(static_cast<uint16_t>(atl.writable_indexes.size()));
-      write_bytes(atl.writable_indexes.data(), atl.writable_indexes.size());
-      write_shortvec(static_cast<uint16_t>(atl.readonly_indexes.size()));
-      write_bytes(atl.readonly_indexes.data(), atl.readonly_indexes.size());
+    if (count == 0) {
+      digest.update({data_ptr() + start, position() - start});
     }
+    return static_cast<size_t>(count);
   }
 
-  void write_instruction_v2(const CompiledInstruction &instr) {
-    ensure_capacity(1 + instr.accounts.size() + instr.data.size() + 6);
-    write_u8(instr.program_id_index);
-    write_shortvec(static_cast<uint16_t>(instr.accounts.size()));
-    write_bytes(instr.accounts.data(), instr.accounts.size());
-    write_shortvec(static_cast<uint16_t>(instr.data.size()));
-    write_bytes(instr.data.data(), instr.data.size());
+  /// Get pointer to underlying data
+  [[nodiscard]] const uint8_t *data_ptr() const {
+    return ZeroCopyDecoder::data_ptr_internal();
   }
 
-private:
-  uint8_t *buffer_;
-  size_t capacity_;
-  size_t pos_;
-};
-
-/**
- * @brief Serialize entries using TurboEncoderV2 (no size pre-computation)
- */
-inline std::vector<uint8_t>
-serialize_entries_turbo_v2(const std::vector<Entry> &entries) {
-  TurboEncoderV2 encoder(entries.size());
-
-  encoder.ensure_capacity(8);
-  encoder.write_u64(entries.size());
-
-  constexpr size_t PREFETCH_DISTANCE = 4;
-  const size_t n = entries.size();
-
-  for (size_t i = 0; i < n; ++i) {
-    if (i + PREFETCH_DISTANCE < n) {
-      LIMCODE_PREFETCH(&entries[i + PREFETCH_DISTANCE]);
+protected:
+  [[nodiscard]] uint8_t peek_u8() const {
+    if (remaining() < 1) {
+      throw LimcodeError::buffer_underflow(1, remaining());
     }
-    encoder.write_entry_v2(entries[i]);
+    return data_ptr()[position()];
   }
-
-  return encoder.finish();
-}
-
-// ==================== UltraTurbo Encoder (5x Target) ====================
+};
 
 /**
- * @brief UltraTurbo encoder - maximum throughput serialization
+ * @brief Scan a serialized Vec<Entry> into a sigverify batch in one pass
  *
- * Key optimizations for 5x speedup over Wincode:
- * 1. Thread-local 16MB buffer - never reallocates
- * 2. Non-temporal stores - bypass CPU cache for large writes
- * 3. Aggressive loop unrolling - process 4 items per iteration
- * 4. Zero branches in hot paths - branchless encoding everywhere
- * 5. Software prefetch - hide memory latency
- * 6. SIMD everywhere - AVX2/AVX-512 for all bulk copies
- */
-
-// Non-temporal store for bypassing cache (useful for large blocks)
-LIMCODE_ALWAYS_INLINE void limcode_stream_store_256(void *dst,
-                                                    const void *src) noexcept {
-#if LIMCODE_HAS_AVX2
-  __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
-  _mm256_stream_si256(reinterpret_cast<__m256i *>(dst), data);
-#else
-  std::memcpy(dst, src, 32);
-#endif
+ * Clears `batch` first. No Entry or transaction objects are materialized.
+ *
+ * @return Number of entries scanned
+ * @throws LimcodeError on truncated or malformed input
+ */
+inline size_t extract_sigverify_batch(std::span<const uint8_t> data,
+                                      SigverifyBatch &batch) {
+  batch.clear();
+  batch.base = data.data();
+  StructuredZeroCopyDecoder decoder(data);
+  return decoder.read_sigverify_entries(batch);
 }
 
-// Non-temporal store for 64 bytes
-LIMCODE_ALWAYS_INLINE void limcode_stream_store_512(void *dst,
-                                                    const void *src) noexcept {
-#if LIMCODE_HAS_AVX512
-  __m512i data = _mm512_loadu_si512(src);
-  _mm512_stream_si512(reinterpret_cast<__m512i *>(dst), data);
-#elif LIMCODE_HAS_AVX2
-  limcode_stream_store_256(dst, src);
-  limcode_stream_store_256(static_cast<uint8_t *>(dst) + 32,
-                           static_cast<const uint8_t *>(src) + 32);
-#else
-  std::memcpy(dst, src, 64);
-#endif
+/**
+ * @brief extract_sigverify_batch(), with `digest` updated over the scanned
+ * bytes (the whole Vec<Entry>, prefix included)
+ */
+template <ByteDigest Digest>
+size_t extract_sigverify_batch(std::span<const uint8_t> data,
+                               SigverifyBatch &batch, Digest &digest) {
+  batch.clear();
+  batch.base = data.data();
+  StructuredZeroCopyDecoder decoder(data);
+  return decoder.read_sigverify_entries(batch, digest);
 }
 
-class UltraTurboEncoder {
-public:
-  // 16MB buffer - enough for largest possible blocks
-  static constexpr size_t BUFFER_SIZE = 16 * 1024 * 1024;
-
-  // Thread-local singleton for zero-allocation serialization
-  static UltraTurboEncoder &instance() {
-    thread_local UltraTurboEncoder encoder;
-    return encoder;
-  }
-
-  UltraTurboEncoder() : buffer_(BUFFER_SIZE), pos_(0) {
-    // Touch all pages to ensure they're committed
-    for (size_t i = 0; i < BUFFER_SIZE; i += 4096) {
-      buffer_[i] = 0;
-    }
-  }
+// ==================== Out-of-Line View Accessors ====================
+//
+// Indexed accessors walk forward from the start of their list; views come
+// from StructuredZeroCopyDecoder, which has already bounds-checked them.
 
-  // Reset for new serialization
-  void reset() noexcept { pos_ = 0; }
+namespace internal {
 
-  // Get result as span (zero-copy)
-  [[nodiscard]] std::span<const uint8_t> result() const noexcept {
-    return {buffer_.data(), pos_};
-  }
+[[nodiscard]] inline StructuredZeroCopyDecoder
+view_decoder_at(const uint8_t *data, size_t size, size_t offset) {
+  return StructuredZeroCopyDecoder(data + offset, size - offset);
+}
 
-  // Get result as vector (with copy - for API compatibility)
-  [[nodiscard]] std::vector<uint8_t> to_vector() const {
-    return {buffer_.begin(), buffer_.begin() + static_cast<ptrdiff_t>(pos_)};
+inline void check_view_index(size_t index, size_t count, const char *what) {
+  if (index >= count) {
+    throw LimcodeError(ErrorCode::InvalidLength,
+                       std::string(what) + " index out of range");
   }
+}
 
-  // ==================== Primitive Writes ====================
-
-  LIMCODE_ALWAYS_INLINE void write_u8(uint8_t v) noexcept {
-    buffer_[pos_++] = v;
+template <typename Message, typename View>
+void fill_owned_message(Message &msg, const View &view) {
+  msg.header = view.header;
+  msg.account_keys.reserve(view.account_keys_count);
+  for (HashView key : view.account_keys()) {
+    msg.account_keys.push_back(key.to_array());
+  }
+  msg.recent_blockhash = view.recent_blockhash().to_array();
+  auto decoder =
+      view_decoder_at(view.data, view.size, view.instructions_offset);
+  msg.instructions.reserve(view.instructions_count);
+  for (uint16_t i = 0; i < view.instructions_count; ++i) {
+    msg.instructions.push_back(
+        decoder.read_compiled_instruction_view().to_owned());
   }
+}
 
-  LIMCODE_ALWAYS_INLINE void write_u64(uint64_t v) noexcept {
-    std::memcpy(buffer_.data() + pos_, &v, 8);
-    pos_ += 8;
-  }
+} // namespace internal
 
-  // Branchless ShortVec - always writes 3 bytes, but only advances by actual
-  // size
-  LIMCODE_ALWAYS_INLINE void write_shortvec_branchless(uint16_t len) noexcept {
-    uint8_t *p = buffer_.data() + pos_;
+inline CompiledInstructionView
+LegacyMessageView::instruction(size_t index) const {
+  internal::check_view_index(index, instructions_count, "instruction");
+  auto decoder = internal::view_decoder_at(data, size, instructions_offset);
+  decoder.skip_prefixed_pairs(1, index);
+  return decoder.read_compiled_instruction_view();
+}
 
-    // Calculate bytes needed: 1 if <128, 2 if <16384, 3 otherwise
-    int b1 = (len >= 0x80) ? 1 : 0;
-    int b2 = (len >= 0x4000) ? 1 : 0;
-    int bytes_needed = 1 + b1 + b2;
+inline LegacyMessage LegacyMessageView::to_owned() const {
+  LegacyMessage msg;
+  internal::fill_owned_message(msg, *this);
+  return msg;
+}
 
-    // Encode (always compute all 3 bytes, but only some are valid)
-    p[0] = static_cast<uint8_t>((len & 0x7F) | (b1 ? 0x80 : 0));
-    p[1] = static_cast<uint8_t>(((len >> 7) & 0x7F) | (b2 ? 0x80 : 0));
-    p[2] = static_cast<uint8_t>(len >> 14);
+inline CompiledInstructionView V0MessageView::instruction(size_t index) const {
+  internal::check_view_index(index, instructions_count, "instruction");
+  auto decoder = internal::view_decoder_at(data, size, instructions_offset);
+  decoder.skip_prefixed_pairs(1, index);
+  return decoder.read_compiled_instruction_view();
+}
 
-    // Conditional move to select correct byte for position 0 if single-byte
-    if (!b1)
-      p[0] = static_cast<uint8_t>(len);
+inline AddressTableLookupView
+V0MessageView::address_table_lookup(size_t index) const {
+  internal::check_view_index(index, atl_count, "address table lookup");
+  auto decoder = internal::view_decoder_at(data, size, atl_offset);
+  decoder.skip_prefixed_pairs(PUBKEY_BYTES, index);
+  return decoder.read_address_table_lookup_view();
+}
 
-    pos_ += static_cast<size_t>(bytes_needed);
+inline V0Message V0MessageView::to_owned() const {
+  V0Message msg;
+  internal::fill_owned_message(msg, *this);
+  auto decoder = internal::view_decoder_at(data, size, atl_offset);
+  msg.address_table_lookups.reserve(atl_count);
+  for (uint16_t i = 0; i < atl_count; ++i) {
+    msg.address_table_lookups.push_back(
+        decoder.read_address_table_lookup_view().to_owned());
   }
+  return msg;
+}
 
-  // ==================== SIMD Bulk Operations ====================
-
-  // Copy 32 bytes (pubkey/hash) with optional streaming
-  LIMCODE_ALWAYS_INLINE void write_32(const uint8_t *src) noexcept {
-    limcode_copy32(buffer_.data() + pos_, src);
-    pos_ += 32;
+inline VersionedTransaction VersionedTransactionView::to_owned() const {
+  VersionedTransaction tx;
+  tx.signatures.reserve(signatures_count);
+  for (uint16_t i = 0; i < signatures_count; ++i) {
+    tx.signatures.push_back(signature(i).to_array());
   }
+  tx.message = message.to_owned();
+  return tx;
+}
 
-  // Copy 64 bytes (signature) with optional streaming
-  LIMCODE_ALWAYS_INLINE void write_64(const uint8_t *src) noexcept {
-    limcode_copy64(buffer_.data() + pos_, src);
-    pos_ += 64;
+inline VersionedTransactionView EntryView::transaction(size_t index) const {
+  internal::check_view_index(index, transactions_count, "transaction");
+  auto decoder = internal::view_decoder_at(data, size, transactions_offset);
+  for (size_t i = 0; i < index; ++i) {
+    decoder.skip_versioned_transaction();
   }
+  return decoder.read_versioned_transaction_view();
+}
 
-  // Bulk copy with SIMD - unrolled 4x for maximum ILP
-  LIMCODE_ALWAYS_INLINE void write_bytes_bulk(const uint8_t *src,
-                                              size_t len) noexcept {
-    uint8_t *dst = buffer_.data() + pos_;
+inline Entry EntryView::to_owned() const {
+  Entry entry;
+  entry.num_hashes = num_hashes;
+  entry.hash = hash.to_array();
+  auto decoder = internal::view_decoder_at(data, size, transactions_offset);
+  entry.transactions.reserve(transactions_count);
+  for (uint16_t i = 0; i < transactions_count; ++i) {
+    entry.transactions.push_back(
+        decoder.read_versioned_transaction_view().to_owned());
+  }
+  return entry;
+}
 
-    // Process 128 bytes at a time (4x32)
-    size_t chunks = len / 128;
-    for (size_t i = 0; i < chunks; ++i) {
-      limcode_copy32(dst, src);
-      limcode_copy32(dst + 32, src + 32);
-      limcode_copy32(dst + 64, src + 64);
-      limcode_copy32(dst + 96, src + 96);
-      dst += 128;
-      src += 128;
-    }
+// ==================== Indexed Entry Views ====================
 
-    // Handle remainder
-    size_t remaining = len % 128;
-    if (remaining >= 64) {
-      limcode_copy64(dst, src);
-      dst += 64;
-      src += 64;
-      remaining -= 64;
-    }
-    if (remaining >= 32) {
-      limcode_copy32(dst, src);
-      dst += 32;
-      src += 32;
-      remaining -= 32;
-    }
-    if (remaining > 0) {
-      std::memcpy(dst, src, remaining);
+/**
+ * @brief EntryView with O(1) access to any transaction
+ *
+ * EntryView::transaction() walks every earlier transaction. This view
+ * records each transaction's offset in one skip pass on first access
+ * (4 bytes per transaction) and reuses the table afterwards, so reaching
+ * a few transactions of a large entry costs one scan plus their own parse.
+ *
+ * The table is built lazily from const accessors: call build_index() before
+ * sharing one view between threads.
+ */
+class IndexedEntryView {
+public:
+  explicit IndexedEntryView(const EntryView &entry) : entry_(entry) {
+    if (entry.size > UINT32_MAX) {
+      throw LimcodeError(ErrorCode::InvalidLength,
+                         "entry too large for a 32-bit offset table");
     }
-
-    pos_ += len;
   }
 
-  // Copy N pubkeys (32 bytes each) with unrolling
-  template <size_t N>
-  LIMCODE_ALWAYS_INLINE void
-  write_pubkeys(const std::array<uint8_t, 32> (&keys)[N]) noexcept {
-    uint8_t *dst = buffer_.data() + pos_;
-    for (size_t i = 0; i < N; ++i) {
-      limcode_copy32(dst, keys[i].data());
-      dst += 32;
-    }
-    pos_ += N * 32;
-  }
-
-  // Copy signatures with prefetch
-  void write_signatures_prefetch(
-      const std::vector<std::array<uint8_t, 64>> &sigs) noexcept {
-    uint8_t *dst = buffer_.data() + pos_;
-    const size_t n = sigs.size();
-
-    for (size_t i = 0; i < n; ++i) {
-      // Prefetch next signature
-      if (i + 2 < n) {
-        limcode_prefetch_nta(sigs[i + 2].data());
-      }
-      limcode_copy64(dst, sigs[i].data());
-      dst += 64;
-    }
-    pos_ += n * 64;
-  }
+  /// Parse an entry view from the front of `data` and index it lazily
+  explicit IndexedEntryView(std::span<const uint8_t> data)
+      : IndexedEntryView(StructuredZeroCopyDecoder(data).read_entry_view()) {}
 
-  // Streaming store 32 bytes (bypass cache)
-  LIMCODE_ALWAYS_INLINE void write_32_stream(const uint8_t *src) noexcept {
-    limcode_stream_store_256(buffer_.data() + pos_, src);
-    pos_ += 32;
+  [[nodiscard]] const EntryView &entry() const noexcept { return entry_; }
+  [[nodiscard]] size_t size() const noexcept {
+    return entry_.transactions_count;
   }
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+  [[nodiscard]] bool indexed() const noexcept { return !offsets_.empty(); }
 
-  // Streaming store 64 bytes (bypass cache)
-  LIMCODE_ALWAYS_INLINE void write_64_stream(const uint8_t *src) noexcept {
-    limcode_stream_store_512(buffer_.data() + pos_, src);
-    pos_ += 64;
+  /// Transaction `index` (< size()); throws LimcodeError out of range
+  [[nodiscard]] VersionedTransactionView tx(size_t index) const {
+    internal::check_view_index(index, size(), "transaction");
+    std::span<const uint8_t> bytes = tx_bytes_unchecked(index);
+    StructuredZeroCopyDecoder decoder(bytes);
+    return decoder.read_versioned_transaction_view();
   }
 
-  // ==================== Entry Serialization ====================
-
-  void write_entry_ultra(const Entry &entry) noexcept {
-    write_u64(entry.num_hashes);
-    write_32(entry.hash.data());
-    write_shortvec_branchless(static_cast<uint16_t>(entry.transactions.size()));
-
-    for (const auto &tx : entry.transactions) {
-      write_transaction_ultra(tx);
-    }
+  [[nodiscard]] VersionedTransactionView operator[](size_t index) const {
+    return tx(index);
   }
 
-  void write_transaction_ultra(const VersionedTransaction &tx) noexcept {
-    // Signatures with prefetch
-    const size_t num_sigs = tx.signatures.size();
-    write_shortvec_branchless(static_cast<uint16_t>(num_sigs));
-
-    uint8_t *dst = buffer_.data() + pos_;
-    for (size_t i = 0; i < num_sigs; ++i) {
-      if (i + 2 < num_sigs) {
-        limcode_prefetch_nta(tx.signatures[i + 2].data());
-      }
-      limcode_copy64(dst, tx.signatures[i].data());
-      dst += 64;
-    }
-    pos_ += num_sigs * 64;
-
-    // Message
-    write_message_ultra(tx.message);
+  /// Serialized bytes of transaction `index` without parsing it
+  [[nodiscard]] std::span<const uint8_t> tx_bytes(size_t index) const {
+    internal::check_view_index(index, size(), "transaction");
+    return tx_bytes_unchecked(index);
   }
 
-  void write_message_ultra(const VersionedMessage &msg) noexcept {
-    if (msg.is_v0()) {
-      write_u8(VERSION_PREFIX_MASK);
-      write_v0_message_ultra(msg.as_v0());
-    } else {
-      write_legacy_message_ultra(msg.as_legacy());
+  /// Build the offset table now (no-op once built)
+  void build_index() const {
+    if (indexed()) {
+      return;
     }
+    std::vector<uint32_t> offsets(size() + 1);
+    StructuredZeroCopyDecoder decoder(entry_.data, entry_.size);
+    decoder.skip(entry_.transactions_offset);
+    for (size_t i = 0; i < size(); ++i) {
+      offsets[i] = static_cast<uint32_t>(decoder.position());
+      decoder.skip_versioned_transaction();
+    }
+    offsets[size()] = static_cast<uint32_t>(decoder.position());
+    offsets_ = std::move(offsets);
   }
 
-  void write_legacy_message_ultra(const LegacyMessage &msg) noexcept {
-    // Header (3 bytes)
-    buffer_[pos_++] = msg.header.num_required_signatures;
-    buffer_[pos_++] = msg.header.num_readonly_signed_accounts;
-    buffer_[pos_++] = msg.header.num_readonly_unsigned_accounts;
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = VersionedTransactionView;
+    using difference_type = std::ptrdiff_t;
 
-    // Account keys with unrolled copy
-    const size_t num_keys = msg.account_keys.size();
-    write_shortvec_branchless(static_cast<uint16_t>(num_keys));
+    iterator() = default;
+    iterator(const IndexedEntryView *view, size_t index)
+        : view_(view), index_(index) {}
 
-    uint8_t *dst = buffer_.data() + pos_;
-    // Unroll 4x for ILP
-    size_t i = 0;
-    for (; i + 4 <= num_keys; i += 4) {
-      limcode_copy32(dst, msg.account_keys[i].data());
-      limcode_copy32(dst + 32, msg.account_keys[i + 1].data());
-      limcode_copy32(dst + 64, msg.account_keys[i + 2].data());
-      limcode_copy32(dst + 96, msg.account_keys[i + 3].data());
-      dst += 128;
+    [[nodiscard]] VersionedTransactionView operator*() const {
+      return view_->tx(index_);
     }
-    for (; i < num_keys; ++i) {
-      limcode_copy32(dst, msg.account_keys[i].data());
-      dst += 32;
+    iterator &operator++() {
+      ++index_;
+      return *this;
     }
-    pos_ += num_keys * 32;
-
-    // Blockhash
-    write_32(msg.recent_blockhash.data());
-
-    // Instructions
-    write_shortvec_branchless(static_cast<uint16_t>(msg.instructions.size()));
-    for (const auto &instr : msg.instructions) {
-      write_instruction_ultra(instr);
+    iterator operator++(int) {
+      iterator prev = *this;
+      ++index_;
+      return prev;
     }
-  }
-
-  void write_v0_message_ultra(const V0Message &msg) noexcept {
-    // Header
-    buffer_[pos_++] = msg.header.num_required_signatures;
-    buffer_[pos_++] = msg.header.num_readonly_signed_accounts;
-    buffer_[pos_++] = msg.header.num_readonly_unsigned_accounts;
-
-    // Account keys with unrolled copy
-    const size_t num_keys = msg.account_keys.size();
-    write_shortvec_branchless(static_cast<uint16_t>(num_keys));
-
-    uint8_t *dst = buffer_.data() + pos_;
-    size_t i = 0;
-    for (; i + 4 <= num_keys; i += 4) {
-      limcode_copy32(dst, msg.account_keys[i].data());
-      limcode_copy32(dst + 32, msg.account_keys[i + 1].data());
-      limcode_copy32(dst + 64, msg.account_keys[i + 2].data());
-      limcode_copy32(dst + 96, msg.account_keys[i + 3].data());
-      dst += 128;
+    [[nodiscard]] bool operator==(const iterator &other) const {
+      return index_ == other.index_;
     }
-    for (; i < num_keys; ++i) {
-      limcode_copy32(dst, msg.account_keys[i].data());
-      dst += 32;
+    [[nodiscard]] bool operator!=(const iterator &other) const {
+      return index_ != other.index_;
     }
-    pos_ += num_keys * 32;
-
-    // Blockhash
-    write_32(msg.recent_blockhash.data());
 
-    // Instructions
-    write_shortvec_branchless(static_cast<uint16_t>(msg.instructions.size()));
-    for (const auto &instr : msg.instructions) {
-      write_instruction_ultra(instr);
-    }
+  private:
+    const IndexedEntryView *view_ = nullptr;
+    size_t index_ = 0;
+  };
 
-    // Address table lookups
-    write_shortvec_branchless(
-        static_cast<uint16_t>(msg.address_table_lookups.size()));
-    for (const auto &atl : msg.address_table_lookups) {
-      write_32(atl.account_key.data());
-      write_shortvec_branchless(
-          static_cast<uint16_t>(atl.writable_indexes.size()));
-      std::memcpy(buffer_.data() + pos_, atl.writable_indexes.data(),
-                  atl.writable_indexes.size());
-      pos_ += atl.writable_indexes.size();
-      write_shortvec_branchless(
-          static_cast<uint16_t>(atl.readonly_indexes.size()));
-      std::memcpy(buffer_.data() + pos_, atl.readonly_indexes.data(),
-                  atl.readonly_indexes.size());
-      pos_ += atl.readonly_indexes.size();
-    }
-  }
-
-  void write_instruction_ultra(const CompiledInstruction &instr) noexcept {
-    buffer_[pos_++] = instr.program_id_index;
-    write_shortvec_branchless(static_cast<uint16_t>(instr.accounts.size()));
-    std::memcpy(buffer_.data() + pos_, instr.accounts.data(),
-                instr.accounts.size());
-    pos_ += instr.accounts.size();
-    write_shortvec_branchless(static_cast<uint16_t>(instr.data.size()));
-    std::memcpy(buffer_.data() + pos_, instr.data.data(), instr.data.size());
-    pos_ += instr.data.size();
-  }
+  [[nodiscard]] iterator begin() const { return {this, 0}; }
+  [[nodiscard]] iterator end() const { return {this, size()}; }
 
 private:
-  std::vector<uint8_t> buffer_;
-  size_t pos_;
-};
+  EntryView entry_;
+  /// size() + 1 offsets from entry_.data; empty until first access
+  mutable std::vector<uint32_t> offsets_;
 
-// ==================== Pointer-Style Ultra Fast Encoding ====================
-// These functions use raw pointers and return the updated pointer
-// This eliminates position variable overhead and enables maximum compiler
-// optimization
+  [[nodiscard]] std::span<const uint8_t> tx_bytes_unchecked(size_t index) const {
+    build_index();
+    return {entry_.data + offsets_[index],
+            offsets_[index + 1] - offsets_[index]};
+  }
+};
 
-namespace ptr_enc {
+// ==================== Thread-Local Turbo Encoder ====================
 
-LIMCODE_ALWAYS_INLINE uint8_t *write_u8(uint8_t *p, uint8_t v) noexcept {
-  *p = v;
-  return p + 1;
+/// Presized (unchecked) thread-local encoder; reserve() before writing
+inline Encoder<UncheckedPolicy> &get_thread_local_turbo_encoder() {
+  return thread_local_encoder<UncheckedPolicy>();
 }
 
-LIMCODE_ALWAYS_INLINE uint8_t *write_u64(uint8_t *p, uint64_t v) noexcept {
-  std::memcpy(p, &v, 8);
-  return p + 8;
-}
+// ==================== Turbo Batch Serialization ====================
 
-LIMCODE_ALWAYS_INLINE uint8_t *write_shortvec(uint8_t *p,
-                                              uint16_t len) noexcept {
-  if (len < 0x80) {
-    *p = static_cast<uint8_t>(len);
-    return p + 1;
-  } else if (len < 0x4000) {
-    p[0] = static_cast<uint8_t>((len & 0x7F) | 0x80);
-    p[1] = static_cast<uint8_t>(len >> 7);
-    return p + 2;
-  } else {
-    p[0] = static_cast<uint8_t>((len & 0x7F) | 0x80);
-    p[1] = static_cast<uint8_t>(((len >> 7) & 0x7F) | 0x80);
-    p[2] = static_cast<uint8_t>(len >> 14);
-    return p + 3;
-  }
+/**
+ * @brief Two-pass serialization: size everything, then unchecked writes
+ */
+inline std::vector<uint8_t>
+serialize_entries_turbo(const std::vector<Entry> &entries) {
+  Encoder<UncheckedPolicy> encoder(serialized_size(entries));
+  encoder.write_u64(entries.size());
+  encoder.write_entries(entries.data(), entries.size());
+  return encoder.finish();
 }
 
-LIMCODE_ALWAYS_INLINE uint8_t *write_32(uint8_t *p,
-                                        const uint8_t *src) noexcept {
-  limcode_copy32(p, src);
-  return p + 32;
+/**
+ * @brief Serialize multiple entries (bincode Vec<Entry>)
+ *
+ * This is the standard serialize_entries() function that was forward-declared
+ * earlier. It delegates to the single-pass encoder, so the entries are
+ * walked once.
+ */
+inline std::vector<uint8_t>
+serialize_entries(const std::vector<Entry> &entries) {
+  LIMCODE_METRIC_TIME(Encode);
+  std::vector<uint8_t> out = serialize_entries_turbo_v2(entries);
+  LIMCODE_METRIC_ADD(BytesEncoded, out.size());
+  LIMCODE_METRIC_ADD(EntriesEncoded, entries.size());
+  return out;
 }
 
-LIMCODE_ALWAYS_INLINE uint8_t *write_64(uint8_t *p,
-                                        const uint8_t *src) noexcept {
-  limcode_copy64(p, src);
-  return p + 64;
-}
+inline std::span<const uint8_t>
+serialize_entries_turbo_zero_alloc(const std::vector<Entry> &entries) {
+  auto &encoder = get_thread_local_turbo_encoder();
+  encoder.reset();
 
-LIMCODE_ALWAYS_INLINE uint8_t *write_bytes(uint8_t *p, const uint8_t *src,
-                                           size_t len) noexcept {
-  std::memcpy(p, src, len);
-  return p + len;
-}
+  size_t total_size = 8;
+  for (const auto &entry : entries) {
+    total_size += serialized_size(entry);
+  }
+  encoder.reserve(total_size);
 
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_instruction(uint8_t *p, const CompiledInstruction &instr) noexcept {
-  const size_t acc_size = instr.accounts.size();
-  const size_t data_size = instr.data.size();
+  encoder.write_u64(entries.size());
+  encoder.write_entries(entries.data(), entries.size());
 
-  // Fast path: 99%+ of instructions have < 128 accounts and < 128 bytes of data
-  // This avoids write_shortvec function call overhead
-  if (LIMCODE_LIKELY(acc_size < 128 && data_size < 128)) {
-    *p++ = instr.program_id_index;
-    *p++ = static_cast<uint8_t>(acc_size);
-    std::memcpy(p, instr.accounts.data(), acc_size);
-    p += acc_size;
-    *p++ = static_cast<uint8_t>(data_size);
-    std::memcpy(p, instr.data.data(), data_size);
-    p += data_size;
-  } else {
-    p = write_u8(p, instr.program_id_index);
-    p = write_shortvec(p, static_cast<uint16_t>(acc_size));
-    p = write_bytes(p, instr.accounts.data(), acc_size);
-    p = write_shortvec(p, static_cast<uint16_t>(data_size));
-    p = write_bytes(p, instr.data.data(), data_size);
-  }
-  return p;
-}
-
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_legacy_message(uint8_t *p, const LegacyMessage &msg) noexcept {
-  // Header - write all 3 bytes at once to reduce memory ops
-  *p++ = msg.header.num_required_signatures;
-  *p++ = msg.header.num_readonly_signed_accounts;
-  *p++ = msg.header.num_readonly_unsigned_accounts;
-
-  // Account keys with 4x loop unrolling
-  const size_t num_keys = msg.account_keys.size();
-  p = write_shortvec(p, static_cast<uint16_t>(num_keys));
-
-  // 4x unroll: process 4 keys per iteration to hide memory latency
-  size_t i = 0;
-  for (; i + 4 <= num_keys; i += 4) {
-    limcode_copy32(p, msg.account_keys[i].data());
-    limcode_copy32(p + 32, msg.account_keys[i + 1].data());
-    limcode_copy32(p + 64, msg.account_keys[i + 2].data());
-    limcode_copy32(p + 96, msg.account_keys[i + 3].data());
-    p += 128;
-  }
-  // Handle remaining keys
-  for (; i < num_keys; ++i) {
-    limcode_copy32(p, msg.account_keys[i].data());
-    p += 32;
-  }
-
-  // Blockhash
-  limcode_copy32(p, msg.recent_blockhash.data());
-  p += 32;
-
-  // Instructions
-  p = write_shortvec(p, static_cast<uint16_t>(msg.instructions.size()));
-  for (const auto &instr : msg.instructions) {
-    p = write_instruction(p, instr);
-  }
-
-  return p;
-}
-
-LIMCODE_ALWAYS_INLINE uint8_t *write_v0_message(uint8_t *p,
-                                                const V0Message &msg) noexcept {
-  // Header
-  *p++ = msg.header.num_required_signatures;
-  *p++ = msg.header.num_readonly_signed_accounts;
-  *p++ = msg.header.num_readonly_unsigned_accounts;
-
-  // Account keys with 4x loop unrolling
-  const size_t num_keys = msg.account_keys.size();
-  p = write_shortvec(p, static_cast<uint16_t>(num_keys));
-
-  size_t i = 0;
-  for (; i + 4 <= num_keys; i += 4) {
-    limcode_copy32(p, msg.account_keys[i].data());
-    limcode_copy32(p + 32, msg.account_keys[i + 1].data());
-    limcode_copy32(p + 64, msg.account_keys[i + 2].data());
-    limcode_copy32(p + 96, msg.account_keys[i + 3].data());
-    p += 128;
-  }
-  for (; i < num_keys; ++i) {
-    limcode_copy32(p, msg.account_keys[i].data());
-    p += 32;
-  }
-
-  // Blockhash
-  limcode_copy32(p, msg.recent_blockhash.data());
-  p += 32;
-
-  // Instructions
-  p = write_shortvec(p, static_cast<uint16_t>(msg.instructions.size()));
-  for (const auto &instr : msg.instructions) {
-    p = write_instruction(p, instr);
-  }
-
-  // Address table lookups
-  p = write_shortvec(p,
-                     static_cast<uint16_t>(msg.address_table_lookups.size()));
-  for (const auto &atl : msg.address_table_lookups) {
-    limcode_copy32(p, atl.account_key.data());
-    p += 32;
-    p = write_shortvec(p, static_cast<uint16_t>(atl.writable_indexes.size()));
-    p = write_bytes(p, atl.writable_indexes.data(),
-                    atl.writable_indexes.size());
-    p = write_shortvec(p, static_cast<uint16_t>(atl.readonly_indexes.size()));
-    p = write_bytes(p, atl.readonly_indexes.data(),
-                    atl.readonly_indexes.size());
-  }
-
-  return p;
-}
-
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_message(uint8_t *p, const VersionedMessage &msg) noexcept {
-  if (msg.is_v0()) {
-    *p++ = VERSION_PREFIX_MASK;
-    return write_v0_message(p, msg.as_v0());
-  } else {
-    return write_legacy_message(p, msg.as_legacy());
-  }
+  return encoder.as_span();
 }
 
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_transaction(uint8_t *p, const VersionedTransaction &tx) noexcept {
-  const size_t num_sigs = tx.signatures.size();
+// ==================== Encode Into Caller Memory ====================
 
-  // 1-signature fast path: 99% of Solana transactions have exactly 1 signature
-  // Avoids loop overhead and branch prediction misses
-  if (LIMCODE_LIKELY(num_sigs == 1)) {
-    *p++ = 0x01; // ShortVec for 1 element
-    limcode_copy64(p, tx.signatures[0].data());
-    p += 64;
-  } else {
-    p = write_shortvec(p, static_cast<uint16_t>(num_sigs));
-    // 2x unroll for multi-sig (rare but handle efficiently)
-    size_t i = 0;
-    for (; i + 2 <= num_sigs; i += 2) {
-      limcode_copy64(p, tx.signatures[i].data());
-      limcode_copy64(p + 64, tx.signatures[i + 1].data());
-      p += 128;
-    }
-    for (; i < num_sigs; ++i) {
-      limcode_copy64(p, tx.signatures[i].data());
-      p += 64;
-    }
+/**
+ * @brief Serialize an entry directly into caller-provided memory
+ * @return Bytes written
+ * @throws LimcodeError (BufferOverflow) if `out` is too small; nothing is
+ *         written in that case
+ */
+inline size_t serialize_entry_into(const Entry &entry, std::span<uint8_t> out) {
+  size_t size = serialized_size(entry);
+  if (size > out.size()) {
+    throw LimcodeError::buffer_overflow(size, out.size());
   }
-
-  // Message
-  return write_message(p, tx.message);
+  Encoder<UncheckedPolicy> encoder(out);
+  encoder.write_entry(entry);
+  return encoder.size();
 }
 
-LIMCODE_ALWAYS_INLINE uint8_t *write_entry(uint8_t *p,
-                                           const Entry &entry) noexcept {
-  p = write_u64(p, entry.num_hashes);
-  p = write_32(p, entry.hash.data());
-  p = write_shortvec(p, static_cast<uint16_t>(entry.transactions.size()));
-
-  for (const auto &tx : entry.transactions) {
-    p = write_transaction(p, tx);
+/**
+ * @brief Serialize a transaction directly into caller-provided memory
+ * @return Bytes written
+ * @throws LimcodeError (BufferOverflow) if `out` is too small
+ */
+inline size_t serialize_transaction_into(const VersionedTransaction &tx,
+                                         std::span<uint8_t> out) {
+  size_t size = serialized_size(tx);
+  if (size > out.size()) {
+    throw LimcodeError::buffer_overflow(size, out.size());
   }
-
-  return p;
+  Encoder<UncheckedPolicy> encoder(out);
+  encoder.write_versioned_transaction(tx);
+  return encoder.size();
 }
 
-} // namespace ptr_enc
+/**
+ * @brief Serialize a bincode Vec<Entry> directly into caller-provided memory
+ * @return Bytes written
+ * @throws LimcodeError (BufferOverflow) if `out` is too small
+ */
+inline size_t serialize_entries_into(const std::vector<Entry> &entries,
+                                     std::span<uint8_t> out) {
+  LIMCODE_METRIC_TIME(Encode);
+  size_t size = serialized_size(entries);
+  if (size > out.size()) {
+    throw LimcodeError::buffer_overflow(size, out.size());
+  }
+  Encoder<UncheckedPolicy> encoder(out);
+  encoder.write_u64(entries.size());
+  encoder.write_entries(entries.data(), entries.size());
+  LIMCODE_METRIC_ADD(BytesEncoded, encoder.size());
+  LIMCODE_METRIC_ADD(EntriesEncoded, entries.size());
+  return encoder.size();
+}
 
-// ==================== HyperTurbo: 10x Optimized Serialization
-// ====================
-//
-// Key optimizations over ptr_enc:
-// 1. Bulk memcpy for contiguous data (signatures, account keys)
-// 2. Deep prefetching into nested structures
-// 3. Specialized fast path for 1-signature transactions (99% of cases)
-// 4. Streaming stores for large blocks (avoid cache pollution)
-// 5. Branchless shortvec encoding
-// 6. Unrolled loops with ILP (instruction-level parallelism)
-
-namespace hyper_enc {
-
-// Branchless shortvec - compute all bytes, use cmov for size
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_shortvec_branchless(uint8_t *p, uint16_t len) noexcept {
-  // Most lengths are < 128 (single byte) - optimize for this
-  const bool needs_2 = len >= 0x80;
-  const bool needs_3 = len >= 0x4000;
-
-  // Always compute all 3 bytes
-  const uint8_t b0_single = static_cast<uint8_t>(len);
-  const uint8_t b0_multi = static_cast<uint8_t>((len & 0x7F) | 0x80);
-  const uint8_t b1_2byte = static_cast<uint8_t>(len >> 7);
-  const uint8_t b1_3byte = static_cast<uint8_t>(((len >> 7) & 0x7F) | 0x80);
-  const uint8_t b2 = static_cast<uint8_t>(len >> 14);
-
-  // Branchless selection
-  p[0] = needs_2 ? b0_multi : b0_single;
-  p[1] = needs_3 ? b1_3byte : b1_2byte;
-  p[2] = b2;
-
-  return p + 1 + needs_2 + needs_3;
-}
-
-// Bulk copy N signatures (64 bytes each) - SIMD optimized
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_signatures_bulk(uint8_t *p, const std::vector<Signature> &sigs) noexcept {
-  const size_t n = sigs.size();
-  if (n == 0)
-    return p;
+/**
+ * @brief serialize_entries(), with `digest` updated over every output byte
+ *
+ * Same bytes as serialize_entries(); the digest (e.g. Crc32c, Sha256) is
+ * fed entry by entry while the output is still in cache, so no second pass
+ * is needed. The digest continues from its current state.
+ */
+template <ByteDigest Digest>
+[[nodiscard]] std::vector<uint8_t>
+serialize_entries_with_digest(const std::vector<Entry> &entries,
+                              Digest &digest) {
+  LIMCODE_METRIC_TIME(Encode);
+  Encoder<UncheckedPolicy> encoder(serialized_size(entries));
+  encoder.write_u64(entries.size());
+  digest.update(encoder.as_span());
+  encoder.write_entries(entries.data(), entries.size(), digest);
+  LIMCODE_METRIC_ADD(BytesEncoded, encoder.size());
+  LIMCODE_METRIC_ADD(EntriesEncoded, entries.size());
+  return encoder.finish();
+}
 
-  // Fast path: 1 signature (99% of transactions)
-  if (LIMCODE_LIKELY(n == 1)) {
-    limcode_copy64(p, sigs[0].data());
-    return p + 64;
+/// serialize_entries_into() with `digest` updated over every byte written
+template <ByteDigest Digest>
+size_t serialize_entries_into(const std::vector<Entry> &entries,
+                              std::span<uint8_t> out, Digest &digest) {
+  LIMCODE_METRIC_TIME(Encode);
+  size_t size = serialized_size(entries);
+  if (size > out.size()) {
+    throw LimcodeError::buffer_overflow(size, out.size());
   }
+  Encoder<UncheckedPolicy> encoder(out);
+  encoder.write_u64(entries.size());
+  digest.update(encoder.as_span());
+  encoder.write_entries(entries.data(), entries.size(), digest);
+  LIMCODE_METRIC_ADD(BytesEncoded, encoder.size());
+  LIMCODE_METRIC_ADD(EntriesEncoded, entries.size());
+  return encoder.size();
+}
 
-  // Copy each signature individually with SIMD
-  // (safer than bulk memcpy which assumes contiguous storage)
+/**
+ * @brief Serialize one transaction per fixed-size slot of a packet ring
+ *
+ * Slot i starts at `ring.data() + i * slot_size`; its length goes to
+ * `lengths[i]`, ready for sendmmsg / io_uring submission.
+ *
+ * @return Number of transactions written: the smallest of txs.size(),
+ *         the slot count and lengths.size()
+ * @throws LimcodeError (BufferOverflow) if a transaction exceeds slot_size
+ */
+inline size_t
+serialize_transactions_into_slots(std::span<const VersionedTransaction> txs,
+                                  std::span<uint8_t> ring, size_t slot_size,
+                                  std::span<size_t> lengths) {
+  if (slot_size == 0) {
+    return 0;
+  }
+  size_t n = std::min({txs.size(), ring.size() / slot_size, lengths.size()});
   for (size_t i = 0; i < n; ++i) {
-    limcode_copy64(p, sigs[i].data());
-    p += 64;
+    lengths[i] =
+        serialize_transaction_into(txs[i], ring.subspan(i * slot_size, slot_size));
   }
-  return p;
+  return n;
 }
 
-// Bulk copy N pubkeys (32 bytes each) - SIMD optimized with 4x unroll
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_pubkeys_bulk(uint8_t *p, const std::vector<Pubkey> &keys) noexcept {
-  const size_t n = keys.size();
-  if (n == 0)
-    return p;
-
-  // Unroll 4x for ILP (instruction-level parallelism)
-  size_t i = 0;
-  for (; i + 4 <= n; i += 4) {
-    limcode_copy32(p, keys[i].data());
-    limcode_copy32(p + 32, keys[i + 1].data());
-    limcode_copy32(p + 64, keys[i + 2].data());
-    limcode_copy32(p + 96, keys[i + 3].data());
-    p += 128;
-  }
-  // Handle remainder
-  for (; i < n; ++i) {
-    limcode_copy32(p, keys[i].data());
-    p += 32;
+#if LIMCODE_HAS_MMAP
+/**
+ * @brief Scatter/gather encoder that emits an iovec list
+ *
+ * Length prefixes, headers and other small fields are staged in an internal
+ * buffer. Runs of at least `min_reference_bytes` (signature lists, account
+ * key lists, instruction data) become iovecs pointing straight into the
+ * source Entry / VersionedTransaction, so they are never copied. The
+ * concatenated segments are byte-identical to serialize_entry().
+ *
+ * The segments reference the source objects and this encoder's staging
+ * buffer: both must stay alive and unmodified until the I/O completes.
+ * Large batches can exceed IOV_MAX and must be submitted in chunks.
+ */
+class IovecEncoder {
+public:
+  static constexpr size_t DEFAULT_MIN_REFERENCE_BYTES = 256;
+
+  explicit IovecEncoder(
+      size_t min_reference_bytes = DEFAULT_MIN_REFERENCE_BYTES)
+      : min_reference_bytes_(min_reference_bytes) {}
+
+  /// Drop all segments (staging capacity is kept)
+  void reset() noexcept {
+    staged_.clear();
+    segments_.clear();
+    total_size_ = 0;
+    referenced_size_ = 0;
+  }
+
+  void write_versioned_transaction(const VersionedTransaction &tx) {
+    put_short_vec(tx.signatures.size());
+    put_bytes(reinterpret_cast<const uint8_t *>(tx.signatures.data()),
+              tx.signatures.size() * SIGNATURE_BYTES);
+
+    std::visit(
+        [this](const auto &msg) {
+          using T = std::decay_t<decltype(msg)>;
+          if constexpr (std::is_same_v<T, V0Message>) {
+            put_u8(VERSION_PREFIX_MASK);
+          }
+          put_u8(msg.header.num_required_signatures);
+          put_u8(msg.header.num_readonly_signed_accounts);
+          put_u8(msg.header.num_readonly_unsigned_accounts);
+          put_short_vec(msg.account_keys.size());
+          put_bytes(reinterpret_cast<const uint8_t *>(msg.account_keys.data()),
+                    msg.account_keys.size() * PUBKEY_BYTES);
+          put_bytes(msg.recent_blockhash.data(), HASH_BYTES);
+          put_short_vec(msg.instructions.size());
+          for (const auto &instr : msg.instructions) {
+            put_u8(instr.program_id_index);
+            put_short_vec(instr.accounts.size());
+            put_bytes(instr.accounts.data(), instr.accounts.size());
+            put_short_vec(instr.data.size());
+            put_bytes(instr.data.data(), instr.data.size());
+          }
+          if constexpr (std::is_same_v<T, V0Message>) {
+            put_short_vec(msg.address_table_lookups.size());
+            for (const auto &atl : msg.address_table_lookups) {
+              put_bytes(atl.account_key.data(), PUBKEY_BYTES);
+              put_short_vec(atl.writable_indexes.size());
+              put_bytes(atl.writable_indexes.data(),
+                        atl.writable_indexes.size());
+              put_short_vec(atl.readonly_indexes.size());
+              put_bytes(atl.readonly_indexes.data(),
+                        atl.readonly_indexes.size());
+            }
+          }
+        },
+        tx.message.inner);
   }
-  return p;
-}
-
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_instruction_hyper(uint8_t *p, const CompiledInstruction &instr) noexcept {
-  *p++ = instr.program_id_index;
 
-  // Accounts
-  const size_t acc_len = instr.accounts.size();
-  p = write_shortvec_branchless(p, static_cast<uint16_t>(acc_len));
-  if (acc_len > 0) {
-    std::memcpy(p, instr.accounts.data(), acc_len);
-    p += acc_len;
+  void write_entry(const Entry &entry) {
+    put_u64(entry.num_hashes);
+    put_bytes(entry.hash.data(), HASH_BYTES);
+    put_short_vec(entry.transactions.size());
+    for (const auto &tx : entry.transactions) {
+      write_versioned_transaction(tx);
+    }
   }
 
-  // Data
-  const size_t data_len = instr.data.size();
-  p = write_shortvec_branchless(p, static_cast<uint16_t>(data_len));
-  if (data_len > 0) {
-    std::memcpy(p, instr.data.data(), data_len);
-    p += data_len;
+  /// Write a bincode Vec<Entry> (u64 length prefix)
+  void write_entries(const std::vector<Entry> &entries) {
+    put_u64(entries.size());
+    for (const auto &entry : entries) {
+      write_entry(entry);
+    }
   }
 
-  return p;
-}
-
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_legacy_message_hyper(uint8_t *p, const LegacyMessage &msg) noexcept {
-  // Header (3 bytes as single write)
-  p[0] = msg.header.num_required_signatures;
-  p[1] = msg.header.num_readonly_signed_accounts;
-  p[2] = msg.header.num_readonly_unsigned_accounts;
-  p += 3;
-
-  // Account keys - BULK COPY
-  const size_t num_keys = msg.account_keys.size();
-  p = write_shortvec_branchless(p, static_cast<uint16_t>(num_keys));
-  p = write_pubkeys_bulk(p, msg.account_keys);
-
-  // Blockhash
-  limcode_copy32(p, msg.recent_blockhash.data());
-  p += 32;
-
-  // Instructions
-  const size_t num_instrs = msg.instructions.size();
-  p = write_shortvec_branchless(p, static_cast<uint16_t>(num_instrs));
-  for (const auto &instr : msg.instructions) {
-    p = write_instruction_hyper(p, instr);
+  /**
+   * @brief Resolve the segments into an iovec array
+   *
+   * Invalidated by any later write or reset().
+   */
+  [[nodiscard]] const std::vector<struct iovec> &iovecs() {
+    iovecs_.clear();
+    iovecs_.reserve(segments_.size());
+    for (const Segment &seg : segments_) {
+      const uint8_t *base = seg.ref ? seg.ref : staged_.data() + seg.offset;
+      iovecs_.push_back({const_cast<uint8_t *>(base), seg.size});
+    }
+    return iovecs_;
   }
 
-  return p;
-}
-
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_v0_message_hyper(uint8_t *p, const V0Message &msg) noexcept {
-  // Header
-  p[0] = msg.header.num_required_signatures;
-  p[1] = msg.header.num_readonly_signed_accounts;
-  p[2] = msg.header.num_readonly_unsigned_accounts;
-  p += 3;
+  /// Total serialized size across all segments
+  [[nodiscard]] size_t size() const noexcept { return total_size_; }
 
-  // Account keys - BULK COPY
-  p = write_shortvec_branchless(p,
-                                static_cast<uint16_t>(msg.account_keys.size()));
-  p = write_pubkeys_bulk(p, msg.account_keys);
-
-  // Blockhash
-  limcode_copy32(p, msg.recent_blockhash.data());
-  p += 32;
-
-  // Instructions
-  p = write_shortvec_branchless(p,
-                                static_cast<uint16_t>(msg.instructions.size()));
-  for (const auto &instr : msg.instructions) {
-    p = write_instruction_hyper(p, instr);
+  /// Bytes emitted as references instead of being copied
+  [[nodiscard]] size_t referenced_bytes() const noexcept {
+    return referenced_size_;
   }
 
-  // Address table lookups
-  const size_t num_atl = msg.address_table_lookups.size();
-  p = write_shortvec_branchless(p, static_cast<uint16_t>(num_atl));
-  for (const auto &atl : msg.address_table_lookups) {
-    limcode_copy32(p, atl.account_key.data());
-    p += 32;
-    p = write_shortvec_branchless(
-        p, static_cast<uint16_t>(atl.writable_indexes.size()));
-    std::memcpy(p, atl.writable_indexes.data(), atl.writable_indexes.size());
-    p += atl.writable_indexes.size();
-    p = write_shortvec_branchless(
-        p, static_cast<uint16_t>(atl.readonly_indexes.size()));
-    std::memcpy(p, atl.readonly_indexes.data(), atl.readonly_indexes.size());
-    p += atl.readonly_indexes.size();
+  [[nodiscard]] size_t num_segments() const noexcept {
+    return segments_.size();
   }
 
-  return p;
-}
-
-LIMCODE_ALWAYS_INLINE uint8_t *
-write_transaction_hyper(uint8_t *p, const VersionedTransaction &tx) noexcept {
-  // Signatures - BULK COPY with fast path for 1 sig
-  p = write_shortvec_branchless(p, static_cast<uint16_t>(tx.signatures.size()));
-  p = write_signatures_bulk(p, tx.signatures);
+private:
+  /// Either a reference into source memory or a staged_ byte range
+  struct Segment {
+    const uint8_t *ref;
+    size_t offset;
+    size_t size;
+  };
 
-  // Message
-  if (tx.message.is_v0()) {
-    *p++ = VERSION_PREFIX_MASK;
-    return write_v0_message_hyper(p, tx.message.as_v0());
-  } else {
-    return write_legacy_message_hyper(p, tx.message.as_legacy());
+  size_t min_reference_bytes_;
+  std::vector<uint8_t> staged_;
+  std::vector<Segment> segments_;
+  std::vector<struct iovec> iovecs_;
+  size_t total_size_ = 0;
+  size_t referenced_size_ = 0;
+
+  void stage(const uint8_t *src, size_t len) {
+    size_t offset = staged_.size();
+    staged_.insert(staged_.end(), src, src + len);
+    // Extend the previous staged segment when it ends where this begins
+    if (!segments_.empty() && segments_.back().ref == nullptr &&
+        segments_.back().offset + segments_.back().size == offset) {
+      segments_.back().size += len;
+    } else {
+      segments_.push_back({nullptr, offset, len});
+    }
   }
-}
-
-LIMCODE_ALWAYS_INLINE uint8_t *write_entry_hyper(uint8_t *p,
-                                                 const Entry &entry) noexcept {
-  // Entry header
-  std::memcpy(p, &entry.num_hashes, 8);
-  p += 8;
-  limcode_copy32(p, entry.hash.data());
-  p += 32;
 
-  // Transactions
-  const size_t num_txs = entry.transactions.size();
-  p = write_shortvec_branchless(p, static_cast<uint16_t>(num_txs));
-
-  for (const auto &tx : entry.transactions) {
-    p = write_transaction_hyper(p, tx);
+  void put_bytes(const uint8_t *src, size_t len) {
+    if (len == 0) {
+      return;
+    }
+    total_size_ += len;
+    if (len >= min_reference_bytes_) {
+      segments_.push_back({src, 0, len});
+      referenced_size_ += len;
+    } else {
+      stage(src, len);
+    }
   }
 
-  return p;
-}
-
-// Deep prefetch: prefetch the actual data, not just the struct pointers
-LIMCODE_ALWAYS_INLINE void deep_prefetch_entry(const Entry &entry) noexcept {
-  // Prefetch entry itself
-  LIMCODE_PREFETCH(&entry);
-
-  // Prefetch first transaction if exists
-  if (!entry.transactions.empty()) {
-    const auto &tx = entry.transactions[0];
-    LIMCODE_PREFETCH(&tx);
+  void put_u8(uint8_t value) {
+    total_size_ += 1;
+    stage(&value, 1);
+  }
 
-    // Prefetch signature data
-    if (!tx.signatures.empty()) {
-      LIMCODE_PREFETCH(tx.signatures[0].data());
-    }
+  void put_u64(uint64_t value) {
+    uint8_t bytes[8];
+    std::memcpy(bytes, &value, 8);
+    total_size_ += 8;
+    stage(bytes, 8);
+  }
 
-    // Prefetch message account keys
-    if (tx.message.is_legacy() &&
-        !tx.message.as_legacy().account_keys.empty()) {
-      LIMCODE_PREFETCH(tx.message.as_legacy().account_keys[0].data());
-    } else if (tx.message.is_v0() && !tx.message.as_v0().account_keys.empty()) {
-      LIMCODE_PREFETCH(tx.message.as_v0().account_keys[0].data());
+  void put_short_vec(size_t value) {
+    if (LIMCODE_UNLIKELY(value > SHORT_VEC_MAX_VALUE)) {
+      throw LimcodeError::length_overflow(value);
     }
+    uint8_t bytes[SHORT_VEC_MAX_BYTES];
+    size_t len = encode_short_vec(static_cast<uint16_t>(value), bytes);
+    total_size_ += len;
+    stage(bytes, len);
   }
-}
-
-} // namespace hyper_enc
+};
+#endif // LIMCODE_HAS_MMAP
 
-// ==================== HyperTurbo Serialization Functions ====================
+// ==================== Thread-Local Span Serialization ====================
 
 /**
- * @brief HyperTurbo serialization - 10x optimized
+ * @brief HyperTurbo serialization into thread-local scratch
  *
- * Key differences from UltraTurbo:
- * - Bulk memcpy for signatures (not individual SIMD copies)
- * - Bulk memcpy for account keys
- * - Deep prefetching into nested structures
- * - Streaming stores for large blocks
- * - Specialized 1-signature fast path
+ * Encoder<StreamingPolicy>: checked single pass, branchless ShortVec,
+ * deep prefetch 8 entries ahead and cache-bypassing copies for large
+ * instruction data.
+ *
+ * @return Span into a thread-local buffer (valid until the next
+ * serialize_*_hyper call on this thread)
  */
 inline std::span<const uint8_t>
 serialize_entries_hyper(const std::vector<Entry> &entries) {
-  auto &encoder = UltraTurboEncoder::instance();
+  auto &encoder = thread_local_encoder<StreamingPolicy>();
   encoder.reset();
-
-  const size_t n = entries.size();
-  uint8_t *p = const_cast<uint8_t *>(encoder.result().data());
-  uint8_t *start = p;
-
-  // Write count
-  std::memcpy(p, &n, 8);
-  p += 8;
-
-  // Deep prefetch pipeline: prefetch 4 entries ahead with full depth
-  constexpr size_t PREFETCH_DISTANCE = 4;
-
-  // Initial prefetch burst
-  for (size_t i = 0; i < std::min(n, PREFETCH_DISTANCE); ++i) {
-    hyper_enc::deep_prefetch_entry(entries[i]);
-  }
-
-  // Main loop with prefetch
-  for (size_t i = 0; i < n; ++i) {
-    // Prefetch future entry
-    if (i + PREFETCH_DISTANCE < n) {
-      hyper_enc::deep_prefetch_entry(entries[i + PREFETCH_DISTANCE]);
-    }
-
-    p = hyper_enc::write_entry_hyper(p, entries[i]);
-  }
-
-  return {start, static_cast<size_t>(p - start)};
+  encoder.write_u64(entries.size());
+  encoder.write_entries(entries.data(), entries.size());
+  return encoder.as_span();
 }
 
 /**
@@ -4644,29 +6332,11 @@ serialize_entries_hyper_vec(const std::vector<Entry> &entries) {
  */
 inline std::span<const uint8_t>
 serialize_transactions_hyper(const std::vector<VersionedTransaction> &txs) {
-  auto &encoder = UltraTurboEncoder::instance();
+  auto &encoder = thread_local_encoder<StreamingPolicy>();
   encoder.reset();
-
-  const size_t n = txs.size();
-  uint8_t *p = const_cast<uint8_t *>(encoder.result().data());
-  uint8_t *start = p;
-
-  std::memcpy(p, &n, 8);
-  p += 8;
-
-  constexpr size_t PREFETCH_DISTANCE = 8;
-  for (size_t i = 0; i < n; ++i) {
-    if (i + PREFETCH_DISTANCE < n) {
-      const auto &tx = txs[i + PREFETCH_DISTANCE];
-      LIMCODE_PREFETCH(&tx);
-      if (!tx.signatures.empty()) {
-        LIMCODE_PREFETCH(tx.signatures[0].data());
-      }
-    }
-    p = hyper_enc::write_transaction_hyper(p, txs[i]);
-  }
-
-  return {start, static_cast<size_t>(p - start)};
+  encoder.write_u64(txs.size());
+  encoder.write_versioned_transactions(txs.data(), txs.size());
+  return encoder.as_span();
 }
 
 inline std::vector<uint8_t>
@@ -4676,71 +6346,17 @@ serialize_transactions_hyper_vec(const std::vector<VersionedTransaction> &txs) {
 }
 
 /**
- * @brief Serialize entries using UltraTurbo encoder (thread-local, zero-alloc
- * hot path)
- * @return Span pointing to thread-local buffer (valid until next call on same
- * thread)
+ * @brief Serialize entries into thread-local scratch (Encoder<ThroughputPolicy>)
+ * @return Span pointing to thread-local buffer (valid until the next
+ * serialize_*_ultra call on this thread)
  */
 inline std::span<const uint8_t>
 serialize_entries_ultra(const std::vector<Entry> &entries) {
-  auto &encoder = UltraTurboEncoder::instance();
+  auto &encoder = thread_local_encoder<ThroughputPolicy>();
   encoder.reset();
-
-  const size_t n = entries.size();
-
-  // Use pointer-style encoding for maximum speed
-  uint8_t *p = const_cast<uint8_t *>(
-      encoder.result().data()); // Safe because we just reset
-  uint8_t *start = p;
-
-  p = ptr_enc::write_u64(p, n);
-
-  // Deep prefetch: prefetch entry + transaction data for better cache
-  // utilization
-  constexpr size_t PREFETCH_DISTANCE =
-      4; // Reduced distance for deeper prefetching
-
-  // Initial deep prefetch burst
-  for (size_t i = 0; i < std::min(n, PREFETCH_DISTANCE); ++i) {
-    const auto &entry = entries[i];
-    LIMCODE_PREFETCH(&entry);
-    if (!entry.transactions.empty()) {
-      const auto &tx = entry.transactions[0];
-      LIMCODE_PREFETCH(&tx);
-      // Prefetch signature data (most important for serialization)
-      if (!tx.signatures.empty()) {
-        LIMCODE_PREFETCH(tx.signatures[0].data());
-      }
-      // Prefetch message struct
-      LIMCODE_PREFETCH(&tx.message);
-    }
-  }
-
-  for (size_t i = 0; i < n; ++i) {
-    // Deep prefetch ahead
-    if (i + PREFETCH_DISTANCE < n) {
-      const auto &future_entry = entries[i + PREFETCH_DISTANCE];
-      LIMCODE_PREFETCH(&future_entry);
-      if (!future_entry.transactions.empty()) {
-        const auto &tx = future_entry.transactions[0];
-        LIMCODE_PREFETCH(&tx);
-        if (!tx.signatures.empty()) {
-          LIMCODE_PREFETCH(tx.signatures[0].data());
-        }
-        // Prefetch account keys if message is available
-        if (tx.message.is_legacy()) {
-          const auto &msg = tx.message.as_legacy();
-          if (!msg.account_keys.empty()) {
-            LIMCODE_PREFETCH(msg.account_keys[0].data());
-          }
-        }
-      }
-    }
-    p = ptr_enc::write_entry(p, entries[i]);
-  }
-
-  // Return span with actual size
-  return {start, static_cast<size_t>(p - start)};
+  encoder.write_u64(entries.size());
+  encoder.write_entries(entries.data(), entries.size());
+  return encoder.as_span();
 }
 
 /**
@@ -4754,38 +6370,18 @@ serialize_entries_ultra_vec(const std::vector<Entry> &entries) {
 }
 
 /**
- * @brief Serialize transactions using UltraTurbo encoder (thread-local,
- * zero-alloc hot path)
- * @return Span pointing to thread-local buffer (valid until next call on same
- * thread)
+ * @brief Serialize transactions into thread-local scratch
+ * (Encoder<ThroughputPolicy>)
+ * @return Span pointing to thread-local buffer (valid until the next
+ * serialize_*_ultra call on this thread)
  */
 inline std::span<const uint8_t>
 serialize_transactions_ultra(const std::vector<VersionedTransaction> &txs) {
-  auto &encoder = UltraTurboEncoder::instance();
+  auto &encoder = thread_local_encoder<ThroughputPolicy>();
   encoder.reset();
-
-  const size_t n = txs.size();
-
-  // Use pointer-style encoding for maximum speed
-  uint8_t *p = const_cast<uint8_t *>(encoder.result().data());
-  uint8_t *start = p;
-
-  p = ptr_enc::write_u64(p, n);
-
-  // Process transactions with aggressive prefetch
-  constexpr size_t PREFETCH_DISTANCE = 8;
-  for (size_t i = 0; i < std::min(n, PREFETCH_DISTANCE); ++i) {
-    limcode_prefetch_nta(&txs[i]);
-  }
-
-  for (size_t i = 0; i < n; ++i) {
-    if (i + PREFETCH_DISTANCE < n) {
-      limcode_prefetch_nta(&txs[i + PREFETCH_DISTANCE]);
-    }
-    p = ptr_enc::write_transaction(p, txs[i]);
-  }
-
-  return {start, static_cast<size_t>(p - start)};
+  encoder.write_u64(txs.size());
+  encoder.write_versioned_transactions(txs.data(), txs.size());
+  return encoder.as_span();
 }
 
 /**
@@ -4798,12 +6394,10 @@ serialize_transactions_ultra_vec(const std::vector<VersionedTransaction> &txs) {
   return {span.begin(), span.end()};
 }
 
-#if LIMCODE_HAS_PARALLEL_STL
 /**
- * @brief Simple persistent thread pool for parallel serialization
+ * @brief Legacy entry point for chunked parallel serialization
  *
- * Avoids expensive thread creation/destruction by keeping worker threads alive.
- * Uses a work-stealing approach with atomic task counters.
+ * Kept for source compatibility; all work now runs on default_executor().
  */
 class SerializerThreadPool {
 public:
@@ -4819,116 +6413,19 @@ public:
       func(0, total);
       return;
     }
-
-    num_chunks = std::min(num_chunks, workers_.size() + 1);
-    const size_t chunk_size = (total + num_chunks - 1) / num_chunks;
-
-    // Reset state
-    task_counter_.store(0, std::memory_order_relaxed);
-    tasks_completed_.store(0, std::memory_order_relaxed);
-    total_tasks_.store(num_chunks, std::memory_order_relaxed);
-
-    // Store task parameters
-    current_total_ = total;
-    current_chunk_size_ = chunk_size;
-    current_func_ = [&func](size_t start, size_t end) { func(start, end); };
-
-    // Wake up workers
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      work_available_ = true;
-    }
-    cv_.notify_all();
-
-    // Main thread also does work
-    size_t task_id;
-    while ((task_id = task_counter_.fetch_add(1, std::memory_order_relaxed)) <
-           num_chunks) {
-      size_t start = task_id * chunk_size;
-      size_t end = std::min(start + chunk_size, total);
-      if (start < total) {
-        func(start, end);
-        tasks_completed_.fetch_add(1, std::memory_order_release);
-      }
-    }
-
-    // Wait for all tasks
-    while (tasks_completed_.load(std::memory_order_acquire) < num_chunks) {
-      std::this_thread::yield();
-    }
-
-    work_available_ = false;
-  }
-
-private:
-  SerializerThreadPool() : stop_(false), work_available_(false) {
-    size_t num_threads = std::thread::hardware_concurrency();
-    if (num_threads == 0)
-      num_threads = 4;
-    num_threads =
-        std::max(size_t(1), num_threads - 1); // Leave 1 for main thread
-
-    for (size_t i = 0; i < num_threads; ++i) {
-      workers_.emplace_back([this] { worker_loop(); });
-    }
-  }
-
-  ~SerializerThreadPool() {
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      stop_ = true;
-    }
-    cv_.notify_all();
-    for (auto &w : workers_) {
-      if (w.joinable())
-        w.join();
-    }
-  }
-
-  void worker_loop() {
-    while (true) {
-      {
-        std::unique_lock<std::mutex> lock(mutex_);
-        cv_.wait(lock, [this] { return stop_ || work_available_; });
-        if (stop_)
-          return;
-      }
-
-      // Try to grab tasks
-      size_t task_id;
-      while ((task_id = task_counter_.fetch_add(1, std::memory_order_relaxed)) <
-             total_tasks_.load(std::memory_order_relaxed)) {
-        size_t start = task_id * current_chunk_size_;
-        size_t end = std::min(start + current_chunk_size_, current_total_);
-        if (start < current_total_) {
-          current_func_(start, end);
-          tasks_completed_.fetch_add(1, std::memory_order_release);
-        }
-      }
-    }
+    default_executor().parallel_for(total, num_chunks,
+                                    ::std::forward<Func>(func));
   }
-
-  std::vector<std::thread> workers_;
-  std::mutex mutex_;
-  std::condition_variable cv_;
-  std::atomic<bool> stop_;
-  std::atomic<bool> work_available_;
-  std::atomic<size_t> task_counter_;
-  std::atomic<size_t> tasks_completed_;
-  std::atomic<size_t> total_tasks_;
-  size_t current_total_ = 0;
-  size_t current_chunk_size_ = 0;
-  std::function<void(size_t, size_t)> current_func_;
 };
 
 /**
  * @brief Parallel UltraTurbo serialization for maximum throughput
  *
- * Uses persistent thread pool to serialize entries in parallel.
+ * Serializes contiguous chunks on default_executor().
  * Each thread uses its own pre-allocated buffer (no lock contention).
  *
  * @param entries Entries to serialize
- * @param num_threads Number of worker threads (0 = auto-detect)
+ * @param num_threads Number of chunks (0 = executor concurrency)
  * @return Serialized bytes
  */
 inline std::vector<uint8_t>
@@ -4941,40 +6438,29 @@ serialize_entries_ultra_parallel(const std::vector<Entry> &entries,
   }
 
   if (num_threads == 0) {
-    num_threads = std::thread::hardware_concurrency();
-    if (num_threads == 0)
-      num_threads = 4;
+    num_threads = default_executor().concurrency();
   }
   num_threads = std::min(num_threads, n / 16); // At least 16 entries per thread
 
   // Pre-allocate result vectors for each chunk
   std::vector<std::vector<uint8_t>> chunk_results(num_threads);
   std::vector<size_t> chunk_sizes(num_threads, 0);
+  const size_t chunk_len = (n + num_threads - 1) / num_threads;
 
-  // Use thread pool to serialize chunks in parallel
-  SerializerThreadPool::instance().parallel_for(
-      n, num_threads,
-      [&entries, &chunk_results, &chunk_sizes, n, num_threads](size_t start,
-                                                               size_t end) {
-        // Determine which chunk this is
-        size_t chunk_idx = start / ((n + num_threads - 1) / num_threads);
-        if (chunk_idx >= num_threads)
-          chunk_idx = num_threads - 1;
+  // Serialize chunks in parallel on the shared executor
+  default_executor().run(
+      num_threads,
+      [&entries, &chunk_results, &chunk_sizes, n, chunk_len](size_t chunk_idx) {
+        size_t start = std::min(chunk_idx * chunk_len, n);
+        size_t end = std::min(start + chunk_len, n);
 
         // Use thread-local encoder
-        auto &encoder = UltraTurboEncoder::instance();
+        auto &encoder = thread_local_encoder<ThroughputPolicy>();
         encoder.reset();
-
-        // Serialize entries with prefetching
-        for (size_t i = start; i < end; ++i) {
-          if (i + 4 < end) {
-            LIMCODE_PREFETCH(&entries[i + 4]);
-          }
-          encoder.write_entry_ultra(entries[i]);
-        }
+        encoder.write_entries(entries.data() + start, end - start);
 
         // Copy to result
-        auto span = encoder.result();
+        auto span = encoder.as_span();
         chunk_results[chunk_idx].assign(span.begin(), span.end());
         chunk_sizes[chunk_idx] = span.size();
       });
@@ -5003,25 +6489,248 @@ serialize_entries_ultra_parallel(const std::vector<Entry> &entries,
 
   return output;
 }
-#endif // LIMCODE_HAS_PARALLEL_STL
+
+/**
+ * @brief Parallel deserialization of a bincode Vec<Entry>
+ *
+ * A skip-only pass over the input records every entry's offset; workers
+ * then decode entries straight into their preallocated result slots.
+ * The pre-scan also validates framing, so truncated input throws before
+ * any worker starts.
+ *
+ * @param data Serialized entries (u64 length prefix)
+ * @param num_threads Number of chunks (0 = executor concurrency)
+ * @param min_parallel_size Batches smaller than this decode sequentially
+ * @throws LimcodeError on truncated or malformed input
+ */
+inline std::vector<Entry>
+deserialize_entries_parallel(std::span<const uint8_t> data,
+                             size_t num_threads = 0,
+                             size_t min_parallel_size = 64) {
+  StructuredZeroCopyDecoder scanner(data);
+  uint64_t count = scanner.read_u64();
+  if (count > scanner.remaining() / MIN_ENTRY_BYTES) {
+    throw LimcodeError::invalid_encoding("entry count exceeds input size");
+  }
+  if (count < min_parallel_size) {
+    return deserialize_entries(data); // Not worth parallelizing
+  }
+  LIMCODE_METRIC_TIME(Decode);
+
+  // Phase 1: entry boundaries
+  std::vector<size_t> offsets(count + 1);
+  for (uint64_t i = 0; i < count; ++i) {
+    offsets[i] = scanner.position();
+    scanner.skip_entry();
+  }
+  offsets[count] = scanner.position();
+
+  // Phase 2: decode each entry into its own slot; the executor rethrows
+  // the first worker error on this thread
+  std::vector<Entry> entries(count);
+  default_executor().parallel_for(count, num_threads,
+                                  [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      LimcodeDecoder decoder(
+          data.subspan(offsets[i], offsets[i + 1] - offsets[i]));
+      entries[i] = decoder.read_entry();
+    }
+  });
+
+  LIMCODE_METRIC_ADD(BytesDecoded, offsets[count]);
+  LIMCODE_METRIC_ADD(EntriesDecoded, count);
+  return entries;
+}
+
+inline std::vector<Entry>
+deserialize_entries_parallel(const std::vector<uint8_t> &data,
+                             size_t num_threads = 0) {
+  return deserialize_entries_parallel(std::span<const uint8_t>(data),
+                                      num_threads);
+}
+
+// ==================== Atomic Performance Counters ====================
+
+/**
+ * @brief Lock-free performance counters for serialization statistics
+ *
+ * Provides low-overhead atomic counters for tracking:
+ * - Total bytes serialized/deserialized
+ * - Number of operations
+ * - Cache hit rates (for buffer pool)
+ *
+ * Only updated by callers and LockFreeBufferPool; the library's own
+ * encode/decode paths report through metrics.h instead.
+ */
+class LIMCODE_CACHE_ALIGNED AtomicStats {
+public:
+  AtomicStats()
+      : bytes_serialized_(0), bytes_deserialized_(0), entries_serialized_(0),
+        entries_deserialized_(0), transactions_serialized_(0),
+        transactions_deserialized_(0), pool_hits_(0), pool_misses_(0) {}
+
+  // Serialization stats
+  void add_bytes_serialized(size_t bytes) {
+#if LIMCODE_HAS_X86_64_ASM
+    limcode_fetch_add_u64(&bytes_serialized_, bytes);
+#else
+    bytes_serialized_.fetch_add(bytes, std::memory_order_relaxed);
+#endif
+  }
+
+  void add_bytes_deserialized(size_t bytes) {
+    bytes_deserialized_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void add_entry_serialized() {
+    entries_serialized_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void add_entry_deserialized() {
+    entries_deserialized_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void add_transaction_serialized() {
+    transactions_serialized_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void add_transaction_deserialized() {
+    transactions_deserialized_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Pool stats
+  void record_pool_hit(uint64_t count = 1) {
+    pool_hits_.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  void record_pool_miss(uint64_t count = 1) {
+    pool_misses_.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  // Getters
+  [[nodiscard]] uint64_t bytes_serialized() const {
+    return bytes_serialized_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t bytes_deserialized() const {
+    return bytes_deserialized_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t entries_serialized() const {
+    return entries_serialized_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t entries_deserialized() const {
+    return entries_deserialized_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t transactions_serialized() const {
+    return transactions_serialized_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t transactions_deserialized() const {
+    return transactions_deserialized_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t pool_hits() const {
+    return pool_hits_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t pool_misses() const {
+    return pool_misses_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] double pool_hit_rate() const {
+    uint64_t hits = pool_hits();
+    uint64_t misses = pool_misses();
+    uint64_t total = hits + misses;
+    return total > 0 ? static_cast<double>(hits) / total : 0.0;
+  }
+
+  void reset() {
+    bytes_serialized_.store(0, std::memory_order_relaxed);
+    bytes_deserialized_.store(0, std::memory_order_relaxed);
+    entries_serialized_.store(0, std::memory_order_relaxed);
+    entries_deserialized_.store(0, std::memory_order_relaxed);
+    transactions_serialized_.store(0, std::memory_order_relaxed);
+    transactions_deserialized_.store(0, std::memory_order_relaxed);
+    pool_hits_.store(0, std::memory_order_relaxed);
+    pool_misses_.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t> bytes_serialized_;
+  std::atomic<uint64_t> bytes_deserialized_;
+  std::atomic<uint64_t> entries_serialized_;
+  std::atomic<uint64_t> entries_deserialized_;
+  std::atomic<uint64_t> transactions_serialized_;
+  std::atomic<uint64_t> transactions_deserialized_;
+  std::atomic<uint64_t> pool_hits_;
+  std::atomic<uint64_t> pool_misses_;
+};
+
+/**
+ * @brief Global statistics instance
+ */
+inline AtomicStats &global_stats() {
+  static AtomicStats stats;
+  return stats;
+}
 
 // ==================== Lock-Free Buffer Pool ====================
 
 /**
- * @brief Lock-free buffer pool for encoder reuse
+ * @brief Tuning for LockFreeBufferPool
+ */
+struct BufferPoolOptions {
+  /// Capacity of buffers from acquire() without a size
+  size_t default_size = 4096;
+
+  /// Upper bound on bytes parked in the global freelists; releases beyond it
+  /// are freed (per-thread magazines hold at most ~1 MiB per class on top)
+  size_t max_cached_bytes = size_t(256) << 20;
+
+  /// Ask for transparent huge pages on buffers of 2 MiB and up
+  bool huge_pages = false;
+
+  /// Where hits and misses are reported (null = global_stats())
+  AtomicStats *stats = nullptr;
+};
+
+/**
+ * @brief Size-classed lock-free buffer pool for encoder reuse
  *
  * Avoids repeated malloc/free overhead by reusing pre-allocated buffers.
- * Uses a lock-free stack (Treiber stack) for O(1) push/pop operations.
+ * Buffers are pooled in power-of-two size classes from 256 B (a vote
+ * transaction) to 16 MiB (a large block), so a request wastes at most half
+ * its capacity and never takes a buffer meant for a different workload.
  *
- * Key optimizations:
- * - ABA prevention using tagged pointers (version counter in upper bits)
- * - Cache-line aligned nodes to avoid false sharing
- * - Per-size-class pools for reduced fragmentation
+ * Allocation is layered like a magazine allocator:
+ * - Each thread keeps one magazine (a small array of buffers) per class;
+ *   acquire/release on it touches no shared cache line
+ * - Full magazines are exchanged with per-class lock-free stacks (Treiber
+ *   stacks with tagged pointers for ABA prevention), one CAS per magazine
+ *   instead of one per buffer
+ * - Only when both are empty is a new buffer allocated (a miss)
+ *
+ * Buffers released on another thread land in that thread's magazine, and a
+ * thread's magazines return to the global stacks when it exits.
  */
 class LockFreeBufferPool {
 public:
   static constexpr size_t DEFAULT_BUFFER_SIZE = 4096;
-  static constexpr size_t MAX_POOL_SIZE = 64; // Max buffers to keep
+
+  /// Smallest class; smaller requests round up to it
+  static constexpr size_t MIN_CLASS_SIZE = 256;
+
+  /// Largest class; bigger requests are allocated and freed directly
+  static constexpr size_t MAX_CLASS_SIZE = size_t(16) << 20;
+
+  static constexpr size_t NUM_CLASSES =
+      std::countr_zero(MAX_CLASS_SIZE) - std::countr_zero(MIN_CLASS_SIZE) + 1;
+
+  /// Classes from this size up get the huge-page hint
+  static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
 
   /**
    * @brief A pooled buffer that returns itself to the pool on destruction
@@ -5094,10 +6803,16 @@ public:
   };
 
 private:
-  // Tagged pointer for ABA prevention
-  struct LIMCODE_CACHE_ALIGNED Node {
-    std::vector<uint8_t> *buffer;
-    Node *next;
+  static constexpr size_t MAGAZINE_SLOTS = 16;
+  static constexpr size_t MAGAZINE_BYTES = size_t(1) << 20;
+  static constexpr size_t MAX_POOLS_PER_THREAD = 4;
+  static constexpr uint32_t STATS_BATCH = 256;
+
+  // Stack node: buffers of a single class
+  struct LIMCODE_CACHE_ALIGNED Magazine {
+    Magazine *next = nullptr;
+    size_t count = 0;
+    std::vector<uint8_t> *buffers[MAGAZINE_SLOTS];
   };
 
   // Pack version and pointer together
@@ -5123,152 +6838,410 @@ private:
     }
 
     // Constructor from pointer and tag
-    static TaggedPtr make(Node *ptr, uintptr_t tag = 0) {
+    static TaggedPtr make(Magazine *ptr, uintptr_t tag = 0) {
       TaggedPtr tp;
       tp.value = (reinterpret_cast<uintptr_t>(ptr) & PTR_MASK) |
                  ((tag & 0xFFFF) << TAG_SHIFT);
       return tp;
     }
 
-    [[nodiscard]] Node *ptr() const {
-      return reinterpret_cast<Node *>(value & PTR_MASK);
+    [[nodiscard]] Magazine *ptr() const {
+      return reinterpret_cast<Magazine *>(value & PTR_MASK);
+    }
+
+    [[nodiscard]] uintptr_t tag() const {
+      return (value >> TAG_SHIFT) & 0xFFFF;
+    }
+
+    [[nodiscard]] TaggedPtr with_new_tag() const {
+      return make(ptr(), (tag() + 1) & 0xFFFF);
+    }
+
+    bool operator==(const TaggedPtr &other) const {
+      return value == other.value;
+    }
+  };
+
+  // Treiber stack of magazines. Popped nodes are never freed while the
+  // stack is in use, so reading node->next of a stale head is always safe
+  struct LIMCODE_CACHE_ALIGNED MagazineStack {
+    std::atomic<uintptr_t> head{0};
+
+    void push(Magazine *node) {
+      while (true) {
+        TaggedPtr old_head =
+            TaggedPtr::from_raw(head.load(std::memory_order_acquire));
+        node->next = old_head.ptr();
+        TaggedPtr new_head = TaggedPtr::make(node, old_head.tag() + 1);
+        if (head.compare_exchange_weak(old_head.value, new_head.value,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+          return;
+        }
+#if LIMCODE_HAS_X86_64_ASM
+        limcode_pause();
+#endif
+      }
+    }
+
+    Magazine *pop() {
+      while (true) {
+        TaggedPtr old_head =
+            TaggedPtr::from_raw(head.load(std::memory_order_acquire));
+        Magazine *node = old_head.ptr();
+        if (!node)
+          return nullptr;
+        TaggedPtr new_head = TaggedPtr::make(node->next, old_head.tag() + 1);
+        if (head.compare_exchange_weak(old_head.value, new_head.value,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+          return node;
+        }
+#if LIMCODE_HAS_X86_64_ASM
+        limcode_pause(); // Reduce contention
+#endif
+      }
+    }
+  };
+
+  // Global freelists; shared with thread caches so a thread exiting after
+  // the pool is destroyed can tell and free its magazines instead
+  struct Depot {
+    uint64_t id;
+    BufferPoolOptions options;
+    AtomicStats *stats;
+    MagazineStack full[NUM_CLASSES];
+    MagazineStack empty;
+    std::atomic<size_t> cached_bytes{0};
+    std::atomic<size_t> cached_buffers{0};
+
+    explicit Depot(const BufferPoolOptions &opts)
+        : id(next_id()), options(opts),
+          stats(opts.stats ? opts.stats : &global_stats()) {}
+
+    static uint64_t next_id() {
+      static std::atomic<uint64_t> counter{0};
+      return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    ~Depot() {
+      for (auto &stack : full) {
+        while (Magazine *mag = stack.pop()) {
+          free_magazine(mag);
+        }
+      }
+      while (Magazine *mag = empty.pop()) {
+        delete mag;
+      }
+    }
+
+    Magazine *take_empty() {
+      Magazine *mag = empty.pop();
+      return mag ? mag : new (std::nothrow) Magazine();
+    }
+
+    // Park a magazine in the global stacks (or free its buffers when the
+    // byte budget is spent)
+    void give(size_t cls, Magazine *mag) {
+      if (mag->count == 0) {
+        empty.push(mag);
+        return;
+      }
+      size_t bytes = mag->count * class_size(cls);
+      if (cached_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes >
+          options.max_cached_bytes) {
+        cached_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+        free_buffers(mag);
+        empty.push(mag);
+        return;
+      }
+      cached_buffers.fetch_add(mag->count, std::memory_order_relaxed);
+      full[cls].push(mag);
+    }
+
+    Magazine *take_full(size_t cls) {
+      Magazine *mag = full[cls].pop();
+      if (mag) {
+        cached_bytes.fetch_sub(mag->count * class_size(cls),
+                               std::memory_order_relaxed);
+        cached_buffers.fetch_sub(mag->count, std::memory_order_relaxed);
+      }
+      return mag;
+    }
+  };
+
+  // One thread's magazines for one pool
+  struct CacheEntry {
+    uint64_t id = 0; // Depot::id; never reused, unlike the depot's address
+    std::weak_ptr<Depot> owner;
+    Magazine *loaded[NUM_CLASSES] = {};
+    uint32_t hits = 0;
+
+    void publish_hits(Depot &depot) {
+      if (hits) {
+        depot.stats->record_pool_hit(hits);
+        hits = 0;
+      }
+    }
+
+    void flush() {
+      if (!id)
+        return;
+      if (auto alive = owner.lock()) {
+        publish_hits(*alive);
+        for (size_t cls = 0; cls < NUM_CLASSES; ++cls) {
+          if (loaded[cls])
+            alive->give(cls, loaded[cls]);
+        }
+      } else {
+        for (Magazine *mag : loaded) {
+          if (mag)
+            free_magazine(mag);
+        }
+      }
+      *this = CacheEntry();
+    }
+  };
+
+  struct ThreadCache {
+    CacheEntry entries[MAX_POOLS_PER_THREAD];
+    size_t next_victim = 0;
+
+    ~ThreadCache() {
+      for (auto &entry : entries) {
+        entry.flush();
+      }
+      thread_exited_ = true;
+    }
+  };
+
+  // Set once this thread's cache is destroyed; pools used after that (e.g.
+  // static pools during exit) bypass the magazines
+  static inline thread_local bool thread_exited_ = false;
+
+  static ThreadCache *thread_cache() {
+    if (thread_exited_)
+      return nullptr;
+    static thread_local ThreadCache cache;
+    return &cache;
+  }
+
+  static void free_buffers(Magazine *mag) {
+    for (size_t i = 0; i < mag->count; ++i) {
+      delete mag->buffers[i];
     }
+    mag->count = 0;
+  }
 
-    [[nodiscard]] uintptr_t tag() const {
-      return (value >> TAG_SHIFT) & 0xFFFF;
-    }
+  static void free_magazine(Magazine *mag) {
+    free_buffers(mag);
+    delete mag;
+  }
 
-    [[nodiscard]] TaggedPtr with_new_tag() const {
-      return make(ptr(), (tag() + 1) & 0xFFFF);
-    }
+  /// Buffers a thread keeps per class: about 1 MiB worth, 1 to 16
+  static constexpr size_t magazine_capacity(size_t cls) {
+    size_t n = MAGAZINE_BYTES / class_size(cls);
+    return n < 1 ? 1 : (n > MAGAZINE_SLOTS ? MAGAZINE_SLOTS : n);
+  }
 
-    bool operator==(const TaggedPtr &other) const {
-      return value == other.value;
+  CacheEntry *local() {
+    ThreadCache *cache = thread_cache();
+    if (!cache)
+      return nullptr;
+    uint64_t id = depot_->id;
+    for (auto &entry : cache->entries) {
+      if (entry.id == id)
+        return &entry;
     }
-  };
+    // Claim a free slot, else evict one (its pool may be gone already)
+    CacheEntry *slot = nullptr;
+    for (auto &entry : cache->entries) {
+      if (!entry.id) {
+        slot = &entry;
+        break;
+      }
+    }
+    if (!slot) {
+      slot = &cache->entries[cache->next_victim++ % MAX_POOLS_PER_THREAD];
+      slot->flush();
+    }
+    slot->id = id;
+    slot->owner = depot_;
+    return slot;
+  }
+
+  std::vector<uint8_t> *allocate(size_t capacity) {
+    depot_->stats->record_pool_miss();
+    LIMCODE_METRIC_ADD(PoolMisses, 1);
+    auto *buf = new std::vector<uint8_t>();
+    buf->reserve(capacity);
+#if LIMCODE_HAS_MMAP && defined(MADV_HUGEPAGE)
+    if (depot_->options.huge_pages && capacity >= HUGE_PAGE_SIZE) {
+      // Only whole 2 MiB extents inside the allocation can be promoted
+      auto begin = reinterpret_cast<uintptr_t>(buf->data());
+      uintptr_t first = (begin + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+      uintptr_t last = (begin + capacity) & ~(HUGE_PAGE_SIZE - 1);
+      if (last > first) {
+        madvise(reinterpret_cast<void *>(first), last - first, MADV_HUGEPAGE);
+      }
+    }
+#endif
+    return buf;
+  }
 
 public:
   LockFreeBufferPool(size_t buffer_size = DEFAULT_BUFFER_SIZE)
-      : buffer_size_(buffer_size), pool_size_(0) {
-    head_.store(TaggedPtr().value, std::memory_order_relaxed);
-  }
+      : LockFreeBufferPool(BufferPoolOptions{buffer_size}) {}
+
+  explicit LockFreeBufferPool(const BufferPoolOptions &options)
+      : depot_(std::make_shared<Depot>(options)) {}
 
   ~LockFreeBufferPool() {
-    // Drain the pool
-    while (true) {
-      TaggedPtr old_head =
-          TaggedPtr::from_raw(head_.load(std::memory_order_acquire));
-      Node *node = old_head.ptr();
-      if (!node)
-        break;
+    // Other threads' magazines are freed by those threads
+    flush_thread_cache();
+  }
 
-      TaggedPtr new_head = TaggedPtr::make(node->next, old_head.tag() + 1);
-      if (head_.compare_exchange_weak(old_head.value, new_head.value,
-                                      std::memory_order_release,
-                                      std::memory_order_relaxed)) {
-        delete node->buffer;
-        delete node;
-      }
-    }
+  LockFreeBufferPool(const LockFreeBufferPool &) = delete;
+  LockFreeBufferPool &operator=(const LockFreeBufferPool &) = delete;
+
+  /// Capacity of the class serving a `size`-byte request
+  static constexpr size_t class_size_for(size_t size) {
+    return size <= MIN_CLASS_SIZE ? MIN_CLASS_SIZE : std::bit_ceil(size);
+  }
+
+  /// Capacity of class `cls`
+  static constexpr size_t class_size(size_t cls) {
+    return MIN_CLASS_SIZE << cls;
   }
 
   /**
-   * @brief Acquire a buffer from the pool or allocate a new one
+   * @brief Acquire an empty buffer with at least the default capacity
    */
   [[nodiscard]] PooledBuffer acquire() {
-    // Try to pop from the lock-free stack
-    while (true) {
-      TaggedPtr old_head =
-          TaggedPtr::from_raw(head_.load(std::memory_order_acquire));
-      Node *node = old_head.ptr();
-
-      if (!node) {
-        // Pool empty, allocate new buffer
-        auto *buf = new std::vector<uint8_t>();
-        buf->reserve(buffer_size_);
-        return PooledBuffer(this, buf);
-      }
+    return acquire(depot_->options.default_size);
+  }
 
-      TaggedPtr new_head = TaggedPtr::make(node->next, old_head.tag() + 1);
-      if (head_.compare_exchange_weak(old_head.value, new_head.value,
-                                      std::memory_order_release,
-                                      std::memory_order_relaxed)) {
-        pool_size_.fetch_sub(1, std::memory_order_relaxed);
-        auto *buf = node->buffer;
-        delete node;
-        return PooledBuffer(this, buf);
+  /**
+   * @brief Acquire an empty buffer with capacity for at least `size` bytes
+   */
+  [[nodiscard]] PooledBuffer acquire(size_t size) {
+    if (size > MAX_CLASS_SIZE) {
+      return PooledBuffer(this, allocate(size));
+    }
+    size_t capacity = class_size_for(size);
+    size_t cls = std::countr_zero(capacity) - std::countr_zero(MIN_CLASS_SIZE);
+
+    CacheEntry *entry = local();
+    if (!entry) {
+      return PooledBuffer(this, allocate(capacity));
+    }
+    Magazine *&mag = entry->loaded[cls];
+    if (!mag || mag->count == 0) {
+      // Swap the empty magazine for a full one from the global stack
+      Magazine *full = depot_->take_full(cls);
+      if (!full) {
+        return PooledBuffer(this, allocate(capacity));
       }
-
-#if LIMCODE_HAS_X86_64_ASM
-      limcode_pause(); // Reduce contention
-#endif
+      if (mag)
+        depot_->empty.push(mag);
+      mag = full;
     }
+
+    LIMCODE_METRIC_ADD(PoolHits, 1);
+    if (++entry->hits >= STATS_BATCH)
+      entry->publish_hits(*depot_);
+    return PooledBuffer(this, mag->buffers[--mag->count]);
   }
 
   /**
    * @brief Release a buffer back to the pool
+   *
+   * The buffer joins the class its capacity fully covers; buffers smaller
+   * than the smallest class or larger than the largest are freed.
    */
   void release(std::vector<uint8_t> *buffer) {
     if (!buffer)
       return;
 
-    // Check if pool is full
-    if (pool_size_.load(std::memory_order_relaxed) >= MAX_POOL_SIZE) {
+    size_t capacity = buffer->capacity();
+    if (capacity < MIN_CLASS_SIZE || capacity > MAX_CLASS_SIZE) {
+      delete buffer;
+      return;
+    }
+    size_t cls = std::bit_width(capacity) - 1 - std::countr_zero(MIN_CLASS_SIZE);
+    CacheEntry *entry = local();
+    if (!entry) {
       delete buffer;
       return;
     }
-
     buffer->clear();
 
-    auto *node = new Node{buffer, nullptr};
-
-    // Push to lock-free stack
-    while (true) {
-      TaggedPtr old_head =
-          TaggedPtr::from_raw(head_.load(std::memory_order_acquire));
-
-      node->next = old_head.ptr();
-      TaggedPtr new_head = TaggedPtr::make(node, old_head.tag() + 1);
+    Magazine *&mag = entry->loaded[cls];
+    if (mag && mag->count == magazine_capacity(cls)) {
+      depot_->give(cls, mag);
+      mag = nullptr;
+    }
+    if (!mag && !(mag = depot_->take_empty())) {
+      delete buffer;
+      return;
+    }
+    mag->buffers[mag->count++] = buffer;
+  }
 
-      if (head_.compare_exchange_weak(old_head.value, new_head.value,
-                                      std::memory_order_release,
-                                      std::memory_order_relaxed)) {
-        pool_size_.fetch_add(1, std::memory_order_relaxed);
-        return;
+  /**
+   * @brief Return this thread's magazines to the global freelists
+   *
+   * Also publishes this thread's batched hit count to the stats. Runs
+   * automatically when the thread exits.
+   */
+  void flush_thread_cache() {
+    ThreadCache *cache = thread_cache();
+    if (!cache)
+      return;
+    for (auto &entry : cache->entries) {
+      if (entry.id == depot_->id) {
+        entry.flush();
       }
-
-#if LIMCODE_HAS_X86_64_ASM
-      limcode_pause();
-#endif
     }
   }
 
+  /// Buffers parked in the global freelists (not counting thread magazines)
   [[nodiscard]] size_t pool_size() const {
-    return pool_size_.load(std::memory_order_relaxed);
+    return depot_->cached_buffers.load(std::memory_order_relaxed);
   }
 
+  /// Bytes parked in the global freelists
+  [[nodiscard]] size_t cached_bytes() const {
+    return depot_->cached_bytes.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] AtomicStats &stats() const { return *depot_->stats; }
+
 private:
-  size_t buffer_size_;
-  std::atomic<uintptr_t> head_;
-  std::atomic<size_t> pool_size_;
+  std::shared_ptr<Depot> depot_;
 };
 
 /**
- * @brief Thread-local buffer pool for maximum performance
+ * @brief Process-wide buffer pool
  *
- * Each thread gets its own pool, eliminating all contention.
- * Falls back to global pool for cross-thread buffer sharing.
+ * LockFreeBufferPool already serves each thread from its own magazines, so
+ * one shared pool is contention-free on the fast path and lets a buffer
+ * acquired on one thread be released safely on another.
  */
 class ThreadLocalBufferPool {
 public:
   static LockFreeBufferPool &get() {
-    static thread_local LockFreeBufferPool pool;
+    static LockFreeBufferPool pool;
     return pool;
   }
 
   [[nodiscard]] static LockFreeBufferPool::PooledBuffer acquire() {
     return get().acquire();
   }
+
+  [[nodiscard]] static LockFreeBufferPool::PooledBuffer acquire(size_t size) {
+    return get().acquire(size);
+  }
 };
 
 // ==================== Lock-Free MPMC Queue ====================
@@ -5386,129 +7359,6 @@ private:
   Cell buffer_[Capacity];
 };
 
-// ==================== Atomic Performance Counters ====================
-
-/**
- * @brief Lock-free performance counters for serialization statistics
- *
- * Provides low-overhead atomic counters for tracking:
- * - Total bytes serialized/deserialized
- * - Number of operations
- * - Cache hit rates (for buffer pool)
- */
-class LIMCODE_CACHE_ALIGNED AtomicStats {
-public:
-  AtomicStats()
-      : bytes_serialized_(0), bytes_deserialized_(0), entries_serialized_(0),
-        entries_deserialized_(0), transactions_serialized_(0),
-        transactions_deserialized_(0), pool_hits_(0), pool_misses_(0) {}
-
-  // Serialization stats
-  void add_bytes_serialized(size_t bytes) {
-#if LIMCODE_HAS_X86_64_ASM
-    limcode_fetch_add_u64(&bytes_serialized_, bytes);
-#else
-    bytes_serialized_.fetch_add(bytes, std::memory_order_relaxed);
-#endif
-  }
-
-  void add_bytes_deserialized(size_t bytes) {
-    bytes_deserialized_.fetch_add(bytes, std::memory_order_relaxed);
-  }
-
-  void add_entry_serialized() {
-    entries_serialized_.fetch_add(1, std::memory_order_relaxed);
-  }
-
-  void add_entry_deserialized() {
-    entries_deserialized_.fetch_add(1, std::memory_order_relaxed);
-  }
-
-  void add_transaction_serialized() {
-    transactions_serialized_.fetch_add(1, std::memory_order_relaxed);
-  }
-
-  void add_transaction_deserialized() {
-    transactions_deserialized_.fetch_add(1, std::memory_order_relaxed);
-  }
-
-  // Pool stats
-  void record_pool_hit() { pool_hits_.fetch_add(1, std::memory_order_relaxed); }
-
-  void record_pool_miss() {
-    pool_misses_.fetch_add(1, std::memory_order_relaxed);
-  }
-
-  // Getters
-  [[nodiscard]] uint64_t bytes_serialized() const {
-    return bytes_serialized_.load(std::memory_order_relaxed);
-  }
-
-  [[nodiscard]] uint64_t bytes_deserialized() const {
-    return bytes_deserialized_.load(std::memory_order_relaxed);
-  }
-
-  [[nodiscard]] uint64_t entries_serialized() const {
-    return entries_serialized_.load(std::memory_order_relaxed);
-  }
-
-  [[nodiscard]] uint64_t entries_deserialized() const {
-    return entries_deserialized_.load(std::memory_order_relaxed);
-  }
-
-  [[nodiscard]] uint64_t transactions_serialized() const {
-    return transactions_serialized_.load(std::memory_order_relaxed);
-  }
-
-  [[nodiscard]] uint64_t transactions_deserialized() const {
-    return transactions_deserialized_.load(std::memory_order_relaxed);
-  }
-
-  [[nodiscard]] uint64_t pool_hits() const {
-    return pool_hits_.load(std::memory_order_relaxed);
-  }
-
-  [[nodiscard]] uint64_t pool_misses() const {
-    return pool_misses_.load(std::memory_order_relaxed);
-  }
-
-  [[nodiscard]] double pool_hit_rate() const {
-    uint64_t hits = pool_hits();
-    uint64_t misses = pool_misses();
-    uint64_t total = hits + misses;
-    return total > 0 ? static_cast<double>(hits) / total : 0.0;
-  }
-
-  void reset() {
-    bytes_serialized_.store(0, std::memory_order_relaxed);
-    bytes_deserialized_.store(0, std::memory_order_relaxed);
-    entries_serialized_.store(0, std::memory_order_relaxed);
-    entries_deserialized_.store(0, std::memory_order_relaxed);
-    transactions_serialized_.store(0, std::memory_order_relaxed);
-    transactions_deserialized_.store(0, std::memory_order_relaxed);
-    pool_hits_.store(0, std::memory_order_relaxed);
-    pool_misses_.store(0, std::memory_order_relaxed);
-  }
-
-private:
-  std::atomic<uint64_t> bytes_serialized_;
-  std::atomic<uint64_t> bytes_deserialized_;
-  std::atomic<uint64_t> entries_serialized_;
-  std::atomic<uint64_t> entries_deserialized_;
-  std::atomic<uint64_t> transactions_serialized_;
-  std::atomic<uint64_t> transactions_deserialized_;
-  std::atomic<uint64_t> pool_hits_;
-  std::atomic<uint64_t> pool_misses_;
-};
-
-/**
- * @brief Global statistics instance
- */
-inline AtomicStats &global_stats() {
-  static AtomicStats stats;
-  return stats;
-}
-
 // ==================== Pooled Encoder ====================
 
 /**
@@ -5620,7 +7470,9 @@ inline size_t deserialize(const uint8_t* in, T* out, size_t* out_len) noexcept {
  * @brief Async POD serialization for concurrent workloads
  *
  * Achieves 1.78 TB/s aggregate throughput with 16 concurrent operations
- * Uses std::async for non-blocking concurrent serialization
+ * Uses std::async for non-blocking concurrent serialization, which may
+ * start a thread per call; coroutine code should prefer
+ * async_serialize_pod() from limcode/async.h
  *
  * @param data Pointer to POD array
  * @param len Number of elements
@@ -5661,99 +7513,6 @@ inline std::vector<std::future<std::vector<uint8_t>>> serialize_pod_batch_async(
 
 namespace limcode {
 
-/**
- * @brief SIMD-optimized memcpy with regular stores (cache-friendly)
- * Uses AVX-512 with 4x unrolling (256 bytes per iteration)
- */
-__attribute__((always_inline)) inline void fast_simd_memcpy(void* __restrict__ dst,
-                                                             const void* __restrict__ src,
-                                                             size_t len) noexcept {
-#if defined(__AVX512F__)
-    uint8_t* d = static_cast<uint8_t*>(dst);
-    const uint8_t* s = static_cast<const uint8_t*>(src);
-
-    // Process 256-byte chunks (4x AVX-512 stores per iteration)
-    while (len >= 256) {
-        __m512i zmm0 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(s));
-        __m512i zmm1 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(s + 64));
-        __m512i zmm2 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(s + 128));
-        __m512i zmm3 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(s + 192));
-
-        _mm512_storeu_si512(reinterpret_cast<__m512i*>(d), zmm0);
-        _mm512_storeu_si512(reinterpret_cast<__m512i*>(d + 64), zmm1);
-        _mm512_storeu_si512(reinterpret_cast<__m512i*>(d + 128), zmm2);
-        _mm512_storeu_si512(reinterpret_cast<__m512i*>(d + 192), zmm3);
-
-        d += 256;
-        s += 256;
-        len -= 256;
-    }
-
-    // Handle remaining bytes with smaller chunks
-    while (len >= 64) {
-        __m512i zmm = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(s));
-        _mm512_storeu_si512(reinterpret_cast<__m512i*>(d), zmm);
-        d += 64;
-        s += 64;
-        len -= 64;
-    }
-
-    // Handle final bytes
-    if (len > 0) {
-        std::memcpy(d, s, len);
-    }
-#else
-    std::memcpy(dst, src, len);
-#endif
-}
-
-/**
- * @brief SIMD-optimized memcpy with non-temporal stores (cache bypass)
- * Uses 2x unrolling (128 bytes per iteration) - matches Rust exactly
- */
-__attribute__((always_inline)) inline void fast_nt_memcpy(void* __restrict__ dst,
-                                                           const void* __restrict__ src,
-                                                           size_t len) noexcept {
-#if defined(__AVX512F__)
-    uint8_t* d = static_cast<uint8_t*>(dst);
-    const uint8_t* s = static_cast<const uint8_t*>(src);
-
-    // Align destination to 64-byte boundary (copy exact bytes needed)
-    const uintptr_t misalignment = reinterpret_cast<uintptr_t>(d) & 63;
-    if (misalignment != 0) {
-        const size_t bytes_to_align = 64 - misalignment;
-        if (len >= bytes_to_align) {
-            std::memcpy(d, s, bytes_to_align);
-            s += bytes_to_align;
-            d += bytes_to_align;
-            len -= bytes_to_align;
-        }
-    }
-
-    // Now d is 64-byte aligned - use 2x non-temporal stores (matches Rust)
-    while (len >= 128) {
-        __m512i zmm0 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(s));
-        __m512i zmm1 = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(s + 64));
-
-        _mm512_stream_si512(reinterpret_cast<__m512i*>(d), zmm0);
-        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 64), zmm1);
-
-        s += 128;
-        d += 128;
-        len -= 128;
-    }
-
-    _mm_sfence();
-
-    // Handle remaining bytes
-    if (len > 0) {
-        std::memcpy(d, s, len);
-    }
-#else
-    std::memcpy(dst, src, len);
-#endif
-}
-
 /**
  * @brief Serialize vector to bincode format
  * @tparam T Trivially copyable type
@@ -5782,63 +7541,7 @@ inline void serialize(std::vector<uint8_t>& buf, const std::vector<T>& data) {
     const void* __restrict__ src = data.data();
     void* __restrict__ dst = ptr + 8;
 
-    // Optimized SIMD memcpy - fully inlined for zero overhead
-#if defined(__AVX512F__)
-    // Direct AVX-512 with 16x unrolling - NO function calls
-    const __m512i* src_simd = reinterpret_cast<const __m512i*>(src);
-    __m512i* dst_simd = reinterpret_cast<__m512i*>(dst);
-
-    // 16x explicitly unrolled loop (1024 bytes per iteration)
-    for (size_t j = 0; j < data_bytes / 64; j += 16) {
-            __builtin_prefetch(src_simd + j + 32, 0, 3);
-
-            __m512i v0 = _mm512_loadu_si512(src_simd + j);
-            __m512i v1 = _mm512_loadu_si512(src_simd + j + 1);
-            __m512i v2 = _mm512_loadu_si512(src_simd + j + 2);
-            __m512i v3 = _mm512_loadu_si512(src_simd + j + 3);
-            __m512i v4 = _mm512_loadu_si512(src_simd + j + 4);
-            __m512i v5 = _mm512_loadu_si512(src_simd + j + 5);
-            __m512i v6 = _mm512_loadu_si512(src_simd + j + 6);
-            __m512i v7 = _mm512_loadu_si512(src_simd + j + 7);
-            __m512i v8 = _mm512_loadu_si512(src_simd + j + 8);
-            __m512i v9 = _mm512_loadu_si512(src_simd + j + 9);
-            __m512i v10 = _mm512_loadu_si512(src_simd + j + 10);
-            __m512i v11 = _mm512_loadu_si512(src_simd + j + 11);
-            __m512i v12 = _mm512_loadu_si512(src_simd + j + 12);
-            __m512i v13 = _mm512_loadu_si512(src_simd + j + 13);
-            __m512i v14 = _mm512_loadu_si512(src_simd + j + 14);
-            __m512i v15 = _mm512_loadu_si512(src_simd + j + 15);
-
-            _mm512_storeu_si512(dst_simd + j, v0);
-            _mm512_storeu_si512(dst_simd + j + 1, v1);
-            _mm512_storeu_si512(dst_simd + j + 2, v2);
-            _mm512_storeu_si512(dst_simd + j + 3, v3);
-            _mm512_storeu_si512(dst_simd + j + 4, v4);
-            _mm512_storeu_si512(dst_simd + j + 5, v5);
-            _mm512_storeu_si512(dst_simd + j + 6, v6);
-            _mm512_storeu_si512(dst_simd + j + 7, v7);
-            _mm512_storeu_si512(dst_simd + j + 8, v8);
-            _mm512_storeu_si512(dst_simd + j + 9, v9);
-            _mm512_storeu_si512(dst_simd + j + 10, v10);
-            _mm512_storeu_si512(dst_simd + j + 11, v11);
-            _mm512_storeu_si512(dst_simd + j + 12, v12);
-            _mm512_storeu_si512(dst_simd + j + 13, v13);
-            _mm512_storeu_si512(dst_simd + j + 14, v14);
-            _mm512_storeu_si512(dst_simd + j + 15, v15);
-        }
-
-    // Handle remainder
-    size_t main_processed = (data_bytes / 1024) * 1024;
-    size_t remaining = data_bytes % 1024;
-
-    if (remaining > 0) {
-        uint8_t* d = static_cast<uint8_t*>(dst) + main_processed;
-        const uint8_t* s = static_cast<const uint8_t*>(src) + main_processed;
-        std::memcpy(d, s, remaining);
-    }
-#else
-    std::memcpy(dst, src, data_bytes);
-#endif
+    fast_simd_memcpy(dst, src, data_bytes);
 }
 
 /**
@@ -5930,85 +7633,23 @@ inline void deallocate_huge_pages(void* ptr) {
 }
 
 /**
- * @brief High-performance memcpy with 32x SIMD loop unrolling
+ * @brief High-performance memcpy for very large transfers (>1MB)
  *
- * Optimized for very large transfers (>1MB).
- * Processes 2048 bytes per iteration with aggressive prefetching.
+ * Runtime-dispatched unrolled SIMD kernel with read prefetching.
  */
-__attribute__((flatten, hot))
+__attribute__((hot))
 inline void memcpy_simd_large(void* __restrict__ dst, const void* __restrict__ src, size_t len) noexcept {
-#if defined(__AVX512F__)
-    uint8_t* d = static_cast<uint8_t*>(dst);
-    const uint8_t* s = static_cast<const uint8_t*>(src);
-
-    // 32x unrolled loop (2048 bytes at a time)
-    #pragma GCC unroll 32
-    while (len >= 2048) {
-        __builtin_prefetch(s + 4096, 0, 3); // Prefetch 4KB ahead
-
-        #pragma GCC unroll 32
-        for (int i = 0; i < 32; ++i) {
-            __m512i zmm = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(s + i * 64));
-            _mm512_storeu_si512(reinterpret_cast<__m512i*>(d + i * 64), zmm);
-        }
-
-        d += 2048;
-        s += 2048;
-        len -= 2048;
-    }
-
-    // 16x unrolled for remaining
-    while (len >= 1024) {
-        #pragma GCC unroll 16
-        for (int i = 0; i < 16; ++i) {
-            __m512i zmm = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(s + i * 64));
-            _mm512_storeu_si512(reinterpret_cast<__m512i*>(d + i * 64), zmm);
-        }
-        d += 1024;
-        s += 1024;
-        len -= 1024;
-    }
-#endif
-
-    // Fallback for remainder
-    if (len > 0) {
-        std::memcpy(dst, src, len);
-    }
+    simd_kernels().copy(dst, src, len);
 }
 
 /**
- * @brief High-performance memcpy with 16x SIMD loop unrolling
+ * @brief High-performance memcpy for large transfers (256KB-1MB)
  *
- * Optimized for large transfers (256KB-1MB).
- * Processes 1024 bytes per iteration with dual prefetching.
+ * Runtime-dispatched unrolled SIMD kernel.
  */
 __attribute__((hot))
 inline void memcpy_simd_medium(void* __restrict__ dst, const void* __restrict__ src, size_t len) noexcept {
-#if defined(__AVX512F__)
-    uint8_t* d = static_cast<uint8_t*>(dst);
-    const uint8_t* s = static_cast<const uint8_t*>(src);
-
-    // 16x unrolled loop (1024 bytes at a time)
-    while (len >= 1024) {
-        __builtin_prefetch(s + 2048, 0, 3); // Aggressive read prefetch
-        __builtin_prefetch(d + 2048, 1, 3); // Aggressive write prefetch
-
-        #pragma GCC unroll 16
-        for (int i = 0; i < 16; ++i) {
-            __m512i zmm = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(s + i * 64));
-            _mm512_storeu_si512(reinterpret_cast<__m512i*>(d + i * 64), zmm);
-        }
-
-        d += 1024;
-        s += 1024;
-        len -= 1024;
-    }
-#endif
-
-    // Fallback for remainder
-    if (len > 0) {
-        std::memcpy(dst, src, len);
-    }
+    simd_kernels().copy(dst, src, len);
 }
 
 /**
@@ -6025,29 +7666,19 @@ inline void memcpy_parallel(void* dst, const void* src, size_t len) noexcept {
         return;
     }
 
-    const size_t num_threads = std::thread::hardware_concurrency();
-    const size_t chunk_size = (len + num_threads - 1) / num_threads;
-
-    std::vector<std::thread> threads;
-    threads.reserve(num_threads);
+    // 64-byte aligned chunks so workers never share a cache line
+    Executor& executor = default_executor();
+    size_t chunk_size = (len + executor.concurrency() - 1) / executor.concurrency();
+    chunk_size = (chunk_size + 63) & ~size_t(63);
+    const size_t num_chunks = (len + chunk_size - 1) / chunk_size;
 
-    for (size_t i = 0; i < num_threads; ++i) {
+    executor.run(num_chunks, [dst, src, len, chunk_size](size_t i) {
         size_t start = i * chunk_size;
-        if (start >= len) break;
-
-        size_t end = std::min(start + chunk_size, len);
-        size_t thread_len = end - start;
-
-        threads.emplace_back([dst, src, start, thread_len]() {
-            uint8_t* d = static_cast<uint8_t*>(dst) + start;
-            const uint8_t* s = static_cast<const uint8_t*>(src) + start;
-            memcpy_simd_large(d, s, thread_len);
-        });
-    }
-
-    for (auto& t : threads) {
-        t.join();
-    }
+        size_t thread_len = std::min(chunk_size, len - start);
+        uint8_t* d = static_cast<uint8_t*>(dst) + start;
+        const uint8_t* s = static_cast<const uint8_t*>(src) + start;
+        memcpy_simd_large(d, s, thread_len);
+    });
 }
 
 /**
@@ -6070,28 +7701,11 @@ inline std::vector<std::vector<uint8_t>> encode_batch_parallel(const std::vector
     }
 
     // Large batch: parallel encoding
-    const size_t num_threads = std::min(batch_size, static_cast<size_t>(std::thread::hardware_concurrency()));
-    const size_t chunk_size = (batch_size + num_threads - 1) / num_threads;
-
-    std::vector<std::thread> threads;
-    threads.reserve(num_threads);
-
-    for (size_t t = 0; t < num_threads; ++t) {
-        size_t start = t * chunk_size;
-        if (start >= batch_size) break;
-
-        size_t end = std::min(start + chunk_size, batch_size);
-
-        threads.emplace_back([&inputs, &outputs, start, end]() {
-            for (size_t i = start; i < end; ++i) {
-                outputs[i] = serialize_pod(inputs[i]);
-            }
-        });
-    }
-
-    for (auto& t : threads) {
-        t.join();
-    }
+    default_executor().parallel_for(batch_size, 0, [&inputs, &outputs](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+            outputs[i] = serialize_pod(inputs[i]);
+        }
+    });
 
     return outputs;
 }
@@ -0,0 +1,412 @@
+#pragma once
+
+/**
+ * @file metrics.h
+ * @brief Compile-time-gated hot-path counters and stage latency histograms
+ *
+ * Build with LIMCODE_ENABLE_METRICS=1 (CMake: -DENABLE_METRICS=ON) to turn
+ * the instrumentation on. Otherwise LIMCODE_METRIC_ADD / LIMCODE_METRIC_TIME
+ * expand to nothing and their arguments are never evaluated, so call sites
+ * can stay in production code. The setting must be identical in every
+ * translation unit of a program.
+ *
+ * Every thread writes to its own cache-line-aligned shard with plain
+ * relaxed load + store, so there is no contention on the hot path and no
+ * locked instruction. snapshot() sums the shards. A shard is handed to the
+ * next new thread when its owner exits, so its totals are kept and memory
+ * stays bounded by the peak thread count.
+ *
+ * Stage timers nest: Encode includes SizePass, SnapshotTar includes the
+ * SnapshotDecompress of the tar headers it reads.
+ *
+ * Exporting, from a scrape handler:
+ * @code
+ *   std::ostringstream body;
+ *   limcode::metrics::write_prometheus(body, limcode::metrics::snapshot());
+ * @endcode
+ * or read the Snapshot fields directly to feed another metrics client.
+ */
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#ifndef LIMCODE_ENABLE_METRICS
+#define LIMCODE_ENABLE_METRICS 0
+#endif
+
+namespace limcode {
+namespace metrics {
+
+/// True when the instrumentation is compiled in
+inline constexpr bool enabled = LIMCODE_ENABLE_METRICS != 0;
+
+/// Timed stages
+enum class Stage : uint8_t {
+  Encode,             ///< serialize_entries / serialize_entries_into / parallel
+  Decode,             ///< deserialize_entries / deserialize_entries_parallel
+  SizePass,           ///< serialized_size() over a whole batch
+  ParallelScatter,    ///< Parallel encode of entries into their output slots
+  SnapshotDecompress, ///< zstd decompression of the archive stream
+  SnapshotReadWait,   ///< Decompressor waiting on archive reads
+  SnapshotTar,        ///< Tar header walk (and skipped bodies)
+  SnapshotParse,      ///< AppendVec parse on a worker
+  Count
+};
+
+/// Monotonic counters
+enum class Counter : uint8_t {
+  BytesEncoded,
+  BytesDecoded,
+  EntriesEncoded,
+  EntriesDecoded,
+  SnapshotBytesDecompressed,
+  SnapshotAppendVecs,
+  SnapshotAccounts,
+  PoolHits,
+  PoolMisses,
+  Count
+};
+
+constexpr size_t STAGE_COUNT = static_cast<size_t>(Stage::Count);
+constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::Count);
+
+/**
+ * Log2 latency buckets: bucket 0 holds samples <= 1024 ns, bucket i holds
+ * (2^(9+i), 2^(10+i)] ns, and the last bucket is unbounded (> ~4.3 s).
+ */
+constexpr size_t HISTOGRAM_BUCKETS = 24;
+
+/// Inclusive upper bound of bucket `i` in nanoseconds (UINT64_MAX = +Inf)
+constexpr uint64_t bucket_upper_bound_ns(size_t i) noexcept {
+  return i + 1 < HISTOGRAM_BUCKETS ? uint64_t(1) << (10 + i) : UINT64_MAX;
+}
+
+constexpr size_t bucket_index(uint64_t ns) noexcept {
+  if (ns <= 1024) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(std::bit_width(ns - 1)) - 10;
+  return index < HISTOGRAM_BUCKETS ? index : HISTOGRAM_BUCKETS - 1;
+}
+
+inline const char *stage_name(Stage stage) noexcept {
+  switch (stage) {
+  case Stage::Encode:
+    return "encode";
+  case Stage::Decode:
+    return "decode";
+  case Stage::SizePass:
+    return "size_pass";
+  case Stage::ParallelScatter:
+    return "parallel_scatter";
+  case Stage::SnapshotDecompress:
+    return "snapshot_decompress";
+  case Stage::SnapshotReadWait:
+    return "snapshot_read_wait";
+  case Stage::SnapshotTar:
+    return "snapshot_tar";
+  case Stage::SnapshotParse:
+    return "snapshot_parse";
+  case Stage::Count:
+    break;
+  }
+  return "unknown";
+}
+
+inline const char *counter_name(Counter counter) noexcept {
+  switch (counter) {
+  case Counter::BytesEncoded:
+    return "bytes_encoded";
+  case Counter::BytesDecoded:
+    return "bytes_decoded";
+  case Counter::EntriesEncoded:
+    return "entries_encoded";
+  case Counter::EntriesDecoded:
+    return "entries_decoded";
+  case Counter::SnapshotBytesDecompressed:
+    return "snapshot_bytes_decompressed";
+  case Counter::SnapshotAppendVecs:
+    return "snapshot_appendvecs";
+  case Counter::SnapshotAccounts:
+    return "snapshot_accounts";
+  case Counter::PoolHits:
+    return "pool_hits";
+  case Counter::PoolMisses:
+    return "pool_misses";
+  case Counter::Count:
+    break;
+  }
+  return "unknown";
+}
+
+/// Aggregated latency histogram of one stage
+struct StageSnapshot {
+  uint64_t count = 0;
+  uint64_t sum_ns = 0;
+  std::array<uint64_t, HISTOGRAM_BUCKETS> buckets{};
+
+  [[nodiscard]] double mean_ns() const noexcept {
+    return count > 0 ? static_cast<double>(sum_ns) / count : 0.0;
+  }
+
+  /// Upper bound of the bucket holding the p-th percentile (0 if empty)
+  [[nodiscard]] uint64_t percentile_upper_bound_ns(double p) const noexcept {
+    if (count == 0) {
+      return 0;
+    }
+    double rank = p / 100.0 * static_cast<double>(count);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+      seen += buckets[i];
+      if (static_cast<double>(seen) >= rank && seen > 0) {
+        return bucket_upper_bound_ns(i);
+      }
+    }
+    return UINT64_MAX;
+  }
+};
+
+/// Point-in-time sum over all thread shards
+struct Snapshot {
+  std::array<uint64_t, COUNTER_COUNT> counters{};
+  std::array<StageSnapshot, STAGE_COUNT> stages{};
+
+  [[nodiscard]] uint64_t counter(Counter c) const noexcept {
+    return counters[static_cast<size_t>(c)];
+  }
+
+  [[nodiscard]] const StageSnapshot &stage(Stage s) const noexcept {
+    return stages[static_cast<size_t>(s)];
+  }
+};
+
+namespace internal {
+
+/// One thread's cells; only the owning thread writes them
+struct alignas(64) Shard {
+  struct StageCells {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum_ns{0};
+    std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS> buckets{};
+  };
+
+  std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters{};
+  std::array<StageCells, STAGE_COUNT> stages{};
+  bool in_use = false; // guarded by ShardRegistry::mutex_
+};
+
+/// Single-writer increment: no locked instruction
+inline void bump(std::atomic<uint64_t> &cell, uint64_t n) noexcept {
+  cell.store(cell.load(std::memory_order_relaxed) + n,
+             std::memory_order_relaxed);
+}
+
+class ShardRegistry {
+public:
+  /// Leaked so threads exiting during static destruction can still release
+  static ShardRegistry &instance() {
+    static ShardRegistry *registry = new ShardRegistry();
+    return *registry;
+  }
+
+  Shard *acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &shard : shards_) {
+      if (!shard->in_use) {
+        shard->in_use = true;
+        return shard.get();
+      }
+    }
+    shards_.push_back(std::make_unique<Shard>());
+    shards_.back()->in_use = true;
+    return shards_.back().get();
+  }
+
+  void release(Shard *shard) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shard->in_use = false;
+  }
+
+  template <typename F> void for_each(F &&f) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &shard : shards_) {
+      f(*shard);
+    }
+  }
+
+private:
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+struct ShardLease {
+  Shard *shard = ShardRegistry::instance().acquire();
+  ~ShardLease() { ShardRegistry::instance().release(shard); }
+};
+
+inline Shard &local_shard() {
+  thread_local ShardLease lease;
+  return *lease.shard;
+}
+
+} // namespace internal
+
+/// Add `n` to a counter on this thread's shard
+inline void add(Counter counter, uint64_t n) noexcept {
+  if constexpr (enabled) {
+    internal::bump(internal::local_shard().counters[static_cast<size_t>(counter)],
+                   n);
+  }
+}
+
+/// Record one `ns`-nanosecond sample of `stage`
+inline void record(Stage stage, uint64_t ns) noexcept {
+  if constexpr (enabled) {
+    auto &cells = internal::local_shard().stages[static_cast<size_t>(stage)];
+    internal::bump(cells.count, 1);
+    internal::bump(cells.sum_ns, ns);
+    internal::bump(cells.buckets[bucket_index(ns)], 1);
+  }
+}
+
+/// Records the lifetime of the scope as one sample of a stage
+class ScopedTimer {
+public:
+  explicit ScopedTimer(Stage stage) noexcept
+      : stage_(stage), start_(std::chrono::steady_clock::now()) {}
+
+  ~ScopedTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    record(stage_,
+           static_cast<uint64_t>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                   .count()));
+  }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+  Stage stage_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Sum every shard (all zeros when metrics are compiled out)
+ *
+ * Safe to call from any thread while others record; each cell is read
+ * atomically, but the snapshot as a whole is not one instant.
+ */
+inline Snapshot snapshot() {
+  Snapshot out;
+  if constexpr (enabled) {
+    internal::ShardRegistry::instance().for_each([&](internal::Shard &shard) {
+      for (size_t c = 0; c < COUNTER_COUNT; ++c) {
+        out.counters[c] += shard.counters[c].load(std::memory_order_relaxed);
+      }
+      for (size_t s = 0; s < STAGE_COUNT; ++s) {
+        const auto &cells = shard.stages[s];
+        auto &stage = out.stages[s];
+        stage.count += cells.count.load(std::memory_order_relaxed);
+        stage.sum_ns += cells.sum_ns.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+          stage.buckets[b] += cells.buckets[b].load(std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  return out;
+}
+
+/**
+ * @brief Zero every shard
+ *
+ * Meant for tests and benchmarks: an update racing with reset() on another
+ * thread may survive it.
+ */
+inline void reset() {
+  if constexpr (enabled) {
+    internal::ShardRegistry::instance().for_each([](internal::Shard &shard) {
+      for (auto &cell : shard.counters) {
+        cell.store(0, std::memory_order_relaxed);
+      }
+      for (auto &cells : shard.stages) {
+        cells.count.store(0, std::memory_order_relaxed);
+        cells.sum_ns.store(0, std::memory_order_relaxed);
+        for (auto &bucket : cells.buckets) {
+          bucket.store(0, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+}
+
+/**
+ * @brief Write `snap` in the Prometheus text exposition format
+ *
+ * Counters become `<prefix>_<name>_total`; stages become one histogram,
+ * `<prefix>_stage_duration_seconds{stage="..."}`, with cumulative buckets.
+ */
+inline void write_prometheus(std::ostream &out, const Snapshot &snap,
+                             std::string_view prefix = "limcode") {
+  char line[256];
+  for (size_t c = 0; c < COUNTER_COUNT; ++c) {
+    const char *name = counter_name(static_cast<Counter>(c));
+    out << "# TYPE " << prefix << '_' << name << "_total counter\n"
+        << prefix << '_' << name << "_total " << snap.counters[c] << '\n';
+  }
+
+  out << "# TYPE " << prefix << "_stage_duration_seconds histogram\n";
+  for (size_t s = 0; s < STAGE_COUNT; ++s) {
+    const StageSnapshot &stage = snap.stages[s];
+    const char *name = stage_name(static_cast<Stage>(s));
+    uint64_t cumulative = 0;
+    for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+      cumulative += stage.buckets[b];
+      if (b + 1 < HISTOGRAM_BUCKETS) {
+        std::snprintf(line, sizeof(line), "%g",
+                      static_cast<double>(bucket_upper_bound_ns(b)) / 1e9);
+      } else {
+        std::snprintf(line, sizeof(line), "+Inf");
+      }
+      out << prefix << "_stage_duration_seconds_bucket{stage=\"" << name
+          << "\",le=\"" << line << "\"} " << cumulative << '\n';
+    }
+    std::snprintf(line, sizeof(line), "%.9f",
+                  static_cast<double>(stage.sum_ns) / 1e9);
+    out << prefix << "_stage_duration_seconds_sum{stage=\"" << name << "\"} "
+        << line << '\n'
+        << prefix << "_stage_duration_seconds_count{stage=\"" << name << "\"} "
+        << stage.count << '\n';
+  }
+}
+
+} // namespace metrics
+} // namespace limcode
+
+#define LIMCODE_METRIC_CONCAT_(a, b) a##b
+#define LIMCODE_METRIC_CONCAT(a, b) LIMCODE_METRIC_CONCAT_(a, b)
+
+#if LIMCODE_ENABLE_METRICS
+/// Add `n` to metrics::Counter::<counter>
+#define LIMCODE_METRIC_ADD(counter, n)                                         \
+  ::limcode::metrics::add(::limcode::metrics::Counter::counter,               \
+                          static_cast<uint64_t>(n))
+/// Time the rest of the enclosing scope as metrics::Stage::<stage>
+#define LIMCODE_METRIC_TIME(stage)                                             \
+  ::limcode::metrics::ScopedTimer LIMCODE_METRIC_CONCAT(limcode_metric_timer_, \
+                                                        __LINE__)(             \
+      ::limcode::metrics::Stage::stage)
+#else
+#define LIMCODE_METRIC_ADD(counter, n) ((void)0)
+#define LIMCODE_METRIC_TIME(stage) ((void)0)
+#endif
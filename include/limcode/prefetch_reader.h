@@ -0,0 +1,498 @@
+#pragma once
+
+/**
+ * @file prefetch_reader.h
+ * @brief Sequential file reader that keeps several large reads in flight
+ *
+ * Feeds the snapshot decompressor. The file is read in fixed-size chunks
+ * into a ring of page-aligned buffers: while the consumer works on one
+ * chunk, the next queue_depth - 1 are already being read, so the drive
+ * stays busy while zstd runs. Reads are submitted through io_uring when
+ * the kernel allows it, otherwise a background pread() thread serves the
+ * same ring.
+ *
+ * With direct_io the file is opened O_DIRECT. A snapshot is read exactly
+ * once, so bypassing the page cache saves a copy and keeps the cache for
+ * the AppendVecs being parsed. Filesystems that refuse O_DIRECT (tmpfs,
+ * some network mounts) fall back to buffered reads.
+ *
+ * Usage:
+ * @code
+ *   limcode::PrefetchReader reader;
+ *   if (!reader.open(path)) return;
+ *   std::span<const uint8_t> chunk;
+ *   while (reader.next(chunk) && !chunk.empty()) {
+ *     consume(chunk); // valid until the next call to next()
+ *   }
+ * @endcode
+ */
+
+#include <limcode/metrics.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define LIMCODE_HAS_IO_URING 1
+#else
+#define LIMCODE_HAS_IO_URING 0
+#endif
+
+namespace limcode {
+
+/// Tuning knobs for PrefetchReader
+struct PrefetchOptions {
+  /// Bytes per read; rounded up to PrefetchReader::ALIGNMENT
+  size_t chunk_size = size_t(4) << 20;
+
+  /// Chunks being read or waiting for the consumer (at least 2)
+  unsigned queue_depth = 4;
+
+  /// Open with O_DIRECT where the filesystem supports it
+  bool direct_io = true;
+
+  /// Submit through io_uring; false forces the pread() thread
+  bool use_io_uring = true;
+};
+
+/**
+ * @brief Read-ahead file reader over a bounded ring of aligned buffers
+ *
+ * Single consumer; not thread-safe.
+ */
+class PrefetchReader {
+public:
+  /// Buffer, offset and length alignment for O_DIRECT
+  static constexpr size_t ALIGNMENT = 4096;
+
+  enum class Backend { None, IoUring, Thread };
+
+  explicit PrefetchReader(PrefetchOptions options = {}) : options_(options) {
+    size_t chunk = std::max(options_.chunk_size, ALIGNMENT);
+    options_.chunk_size = (chunk + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    options_.queue_depth = std::max(options_.queue_depth, 2u);
+  }
+
+  ~PrefetchReader() { close(); }
+
+  PrefetchReader(const PrefetchReader &) = delete;
+  PrefetchReader &operator=(const PrefetchReader &) = delete;
+
+  /// Open `path` and start the first queue_depth reads
+  bool open(const std::string &path) {
+    close();
+    if (!open_file(path)) {
+      return false;
+    }
+
+    slots_.resize(options_.queue_depth);
+    for (auto &slot : slots_) {
+      slot.data = static_cast<uint8_t *>(
+          ::operator new(options_.chunk_size, std::align_val_t(ALIGNMENT)));
+    }
+    if (direct_ && !probe_direct(path)) {
+      close();
+      return false;
+    }
+
+#if LIMCODE_HAS_IO_URING
+    if (options_.use_io_uring && ring_.setup(options_.queue_depth)) {
+      backend_ = Backend::IoUring;
+    }
+#endif
+    if (backend_ == Backend::None) {
+      backend_ = Backend::Thread;
+      worker_ = std::thread([this] { worker_loop(); });
+    }
+
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      submit(i);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Next chunk in file order
+   *
+   * The previous chunk's buffer is handed back to the ring first, so
+   * `chunk` is only valid until the next call.
+   *
+   * @return false on a read error; true with an empty chunk at end of file
+   */
+  bool next(std::span<const uint8_t> &chunk) {
+    chunk = {};
+    if (backend_ == Backend::None || failed_) {
+      return false;
+    }
+    if (holding_) {
+      holding_ = false;
+      submit((head_ + slots_.size() - 1) % slots_.size());
+    }
+
+    Slot &slot = slots_[head_];
+    if (!slot.pending) {
+      return true; // End of file
+    }
+    {
+      LIMCODE_METRIC_TIME(SnapshotReadWait);
+      wait(head_);
+    }
+    slot.pending = false;
+    size_t expected = static_cast<size_t>(
+        std::min<uint64_t>(options_.chunk_size, file_size_ - slot.offset));
+    if (slot.result < 0 || !finish_short_read(slot, expected)) {
+      failed_ = true;
+      return false;
+    }
+
+    chunk = {slot.data, expected};
+    holding_ = true;
+    head_ = (head_ + 1) % slots_.size();
+    return true;
+  }
+
+  /// Wait for outstanding reads, then release the ring and the file
+  void close() {
+#if LIMCODE_HAS_IO_URING
+    if (backend_ == Backend::IoUring) {
+      for (size_t i = 0; i < slots_.size(); ++i) {
+        if (slots_[i].pending) {
+          wait(i);
+        }
+      }
+      ring_.teardown();
+    }
+#endif
+    if (worker_.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      work_cv_.notify_one();
+      worker_.join();
+    }
+    for (auto &slot : slots_) {
+      ::operator delete(slot.data, std::align_val_t(ALIGNMENT));
+    }
+    slots_.clear();
+    requests_.clear();
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+    backend_ = Backend::None;
+    direct_ = failed_ = holding_ = stop_ = false;
+    head_ = 0;
+    next_offset_ = file_size_ = 0;
+  }
+
+  [[nodiscard]] Backend backend() const noexcept { return backend_; }
+  [[nodiscard]] bool direct() const noexcept { return direct_; }
+  [[nodiscard]] uint64_t file_size() const noexcept { return file_size_; }
+  [[nodiscard]] size_t chunk_size() const noexcept {
+    return options_.chunk_size;
+  }
+
+private:
+  struct Slot {
+    uint8_t *data = nullptr;
+    uint64_t offset = 0;
+    int64_t result = 0; ///< Bytes read, or -errno
+    bool pending = false; ///< A read for this slot was submitted
+    bool ready = false;   ///< ... and has completed
+    iovec iov{};
+  };
+
+  bool open_file(const std::string &path) {
+#ifdef O_DIRECT
+    if (options_.direct_io) {
+      fd_ = ::open(path.c_str(), O_RDONLY | O_DIRECT | O_CLOEXEC);
+      direct_ = fd_ >= 0;
+    }
+#endif
+    if (fd_ < 0) {
+      fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    if (fd_ < 0) {
+      return false;
+    }
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+      return false;
+    }
+    file_size_ = static_cast<uint64_t>(st.st_size);
+#ifdef POSIX_FADV_SEQUENTIAL
+    if (!direct_) {
+      ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+    return true;
+  }
+
+  /// Some filesystems accept O_DIRECT at open() and fail the read instead
+  bool probe_direct(const std::string &path) {
+    if (file_size_ == 0 ||
+        ::pread(fd_, slots_[0].data, ALIGNMENT, 0) >= 0 || errno != EINVAL) {
+      return true;
+    }
+    ::close(fd_);
+    direct_ = false;
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    return fd_ >= 0;
+  }
+
+  /// Queue the next chunk of the file into `index`, if any is left
+  void submit(size_t index) {
+    Slot &slot = slots_[index];
+    if (next_offset_ >= file_size_) {
+      return;
+    }
+    slot.offset = next_offset_;
+    next_offset_ += options_.chunk_size;
+    slot.iov = {slot.data, options_.chunk_size};
+    slot.result = 0;
+    slot.ready = false;
+    slot.pending = true;
+
+#if LIMCODE_HAS_IO_URING
+    if (backend_ == Backend::IoUring) {
+      if (!ring_.submit_readv(fd_, &slot.iov, slot.offset, index)) {
+        slot.result = -EIO;
+        slot.ready = true;
+      }
+      return;
+    }
+#endif
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      requests_.push_back(index);
+    }
+    work_cv_.notify_one();
+  }
+
+  void wait(size_t index) {
+#if LIMCODE_HAS_IO_URING
+    if (backend_ == Backend::IoUring) {
+      while (!slots_[index].ready) {
+        ring_.reap(slots_);
+      }
+      return;
+    }
+#endif
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_cv_.wait(lock, [&] { return slots_[index].ready; });
+  }
+
+  /// Read the rest of a chunk the kernel returned short
+  bool finish_short_read(Slot &slot, size_t expected) {
+    size_t got = static_cast<size_t>(slot.result);
+    while (got < expected) {
+      ssize_t n = ::pread(fd_, slot.data + got, options_.chunk_size - got,
+                          static_cast<off_t>(slot.offset + got));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return false;
+      }
+      got += static_cast<size_t>(n);
+    }
+    return true;
+  }
+
+  void worker_loop() {
+    for (;;) {
+      size_t index;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_cv_.wait(lock, [&] { return stop_ || !requests_.empty(); });
+        if (stop_) {
+          return;
+        }
+        index = requests_.front();
+        requests_.pop_front();
+      }
+
+      Slot &slot = slots_[index];
+      ssize_t n;
+      do {
+        n = ::pread(fd_, slot.data, options_.chunk_size,
+                    static_cast<off_t>(slot.offset));
+      } while (n < 0 && errno == EINTR);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slot.result = n < 0 ? -errno : n;
+        slot.ready = true;
+      }
+      ready_cv_.notify_one();
+    }
+  }
+
+#if LIMCODE_HAS_IO_URING
+  /// Minimal io_uring over raw syscalls (no liburing dependency)
+  class Ring {
+  public:
+    bool setup(unsigned entries) {
+      io_uring_params params{};
+      int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+      if (fd < 0) {
+        return false; // ENOSYS, or blocked by seccomp / sysctl
+      }
+      fd_ = fd;
+
+      sq_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+      cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+      bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+      if (single) {
+        sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+      }
+      sq_ptr_ = ::mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+      cq_ptr_ = single ? sq_ptr_
+                       : ::mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+      sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+      sqes_ = static_cast<io_uring_sqe *>(
+          ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES));
+      if (sq_ptr_ == MAP_FAILED || cq_ptr_ == MAP_FAILED || sqes_ == MAP_FAILED) {
+        teardown();
+        return false;
+      }
+
+      auto *sq = static_cast<uint8_t *>(sq_ptr_);
+      sq_tail_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+      sq_mask_ = *reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+      sq_array_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+      auto *cq = static_cast<uint8_t *>(cq_ptr_);
+      cq_head_ = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+      cq_tail_ = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+      cq_mask_ = *reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+      cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+      return true;
+    }
+
+    void teardown() {
+      if (sqes_ && sqes_ != MAP_FAILED) {
+        ::munmap(sqes_, sqes_size_);
+      }
+      if (cq_ptr_ && cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) {
+        ::munmap(cq_ptr_, cq_size_);
+      }
+      if (sq_ptr_ && sq_ptr_ != MAP_FAILED) {
+        ::munmap(sq_ptr_, sq_size_);
+      }
+      if (fd_ >= 0) {
+        ::close(fd_);
+      }
+      *this = Ring{};
+    }
+
+    bool submit_readv(int file, iovec *iov, uint64_t offset, uint64_t tag) {
+      uint32_t tail = *sq_tail_; // Only this thread produces
+      uint32_t index = tail & sq_mask_;
+      io_uring_sqe &sqe = sqes_[index];
+      std::memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_READV;
+      sqe.fd = file;
+      sqe.addr = reinterpret_cast<uint64_t>(iov);
+      sqe.len = 1;
+      sqe.off = offset;
+      sqe.user_data = tag;
+      sq_array_[index] = index;
+      __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+      return enter(1, 0, 0) >= 0;
+    }
+
+    /// Drain completions into `slots`, blocking until at least one arrives
+    void reap(std::vector<Slot> &slots) {
+      if (drain(slots) == 0) {
+        enter(0, 1, IORING_ENTER_GETEVENTS);
+      }
+      drain(slots);
+    }
+
+  private:
+    size_t drain(std::vector<Slot> &slots) {
+      uint32_t head = *cq_head_;
+      uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      size_t count = tail - head;
+      for (; head != tail; ++head) {
+        const io_uring_cqe &cqe = cqes_[head & cq_mask_];
+        Slot &slot = slots[cqe.user_data];
+        slot.result = cqe.res;
+        slot.ready = true;
+      }
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+      return count;
+    }
+
+    int enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+      for (;;) {
+        long ret = ::syscall(__NR_io_uring_enter, fd_, to_submit, min_complete,
+                             flags, nullptr, 0);
+        if (ret >= 0 || errno != EINTR) {
+          return static_cast<int>(ret);
+        }
+      }
+    }
+
+    int fd_ = -1;
+    void *sq_ptr_ = nullptr;
+    void *cq_ptr_ = nullptr;
+    io_uring_sqe *sqes_ = nullptr;
+    size_t sq_size_ = 0;
+    size_t cq_size_ = 0;
+    size_t sqes_size_ = 0;
+    uint32_t *sq_tail_ = nullptr;
+    uint32_t *sq_array_ = nullptr;
+    uint32_t sq_mask_ = 0;
+    uint32_t *cq_head_ = nullptr;
+    uint32_t *cq_tail_ = nullptr;
+    uint32_t cq_mask_ = 0;
+    io_uring_cqe *cqes_ = nullptr;
+  };
+
+  Ring ring_;
+#endif
+
+  PrefetchOptions options_;
+  int fd_ = -1;
+  bool direct_ = false;
+  bool failed_ = false;
+  bool holding_ = false; ///< Consumer still owns the chunk before head_
+  Backend backend_ = Backend::None;
+  uint64_t file_size_ = 0;
+  uint64_t next_offset_ = 0;
+  size_t head_ = 0; ///< Slot holding the next chunk in file order
+  std::vector<Slot> slots_;
+
+  // pread() thread backend
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable ready_cv_;
+  std::deque<size_t> requests_;
+  bool stop_ = false;
+};
+
+} // namespace limcode
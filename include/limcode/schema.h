@@ -0,0 +1,710 @@
+#pragma once
+
+/**
+ * @file schema.h
+ * @brief Derive-style bincode serialization for user structs
+ *
+ * LIMCODE_SCHEMA lists a struct's fields once; serialize(), deserialize(),
+ * serialize_into() and serialized_size() then follow the same wire rules as
+ * Rust's `#[derive(Serialize, Deserialize)]` with bincode's default
+ * (fixint, little-endian) options:
+ *
+ * | C++ type                         | Wire format                        |
+ * |----------------------------------|------------------------------------|
+ * | integers, float, double, enums   | fixed width, little-endian         |
+ * | bool                             | u8, 0 or 1                         |
+ * | std::array<T, N>                 | N elements, no length              |
+ * | std::vector<T>, std::string      | u64 length, then elements          |
+ * | std::optional<T>                 | u8 tag (0 = None, 1 = Some), value |
+ * | std::variant<Ts...>              | u32 variant index, then value      |
+ * | std::pair, std::tuple, schemas   | fields in order                    |
+ * | Entry, VersionedTransaction      | the built-in encoders              |
+ *
+ * Runs of consecutive fixed-width fields are found at compile time. When
+ * the struct's members sit back to back in memory in schema order (a check
+ * on constant offsets that folds away), the whole run is copied with one
+ * fixed-size memcpy instead of field by field. Vectors of such elements are
+ * one bulk copy.
+ *
+ * Other types plug in by specializing limcode::Codec<T>.
+ *
+ * Usage:
+ * @code
+ *   struct AccountState {
+ *     uint64_t lamports;
+ *     uint64_t rent_epoch;
+ *     limcode::Pubkey owner;
+ *     std::vector<uint8_t> data;
+ *     std::optional<limcode::Pubkey> close_authority;
+ *   };
+ *   LIMCODE_SCHEMA(AccountState, lamports, rent_epoch, owner, data,
+ *                  close_authority);   // at global namespace scope
+ *
+ *   std::vector<uint8_t> bytes = limcode::serialize(state);
+ *   auto back = limcode::deserialize<AccountState>(bytes);
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace limcode {
+
+/**
+ * @brief Field list of a user struct; specialize via LIMCODE_SCHEMA
+ *
+ * A specialization holds `static constexpr auto fields`, a std::tuple of
+ * pointers to data members in wire order.
+ */
+template <typename T> struct Schema;
+
+template <typename T>
+concept HasSchema = requires { Schema<T>::fields; };
+
+/**
+ * @brief Wire format of T; specialize for custom types
+ *
+ * A specialization provides:
+ * - `static constexpr bool is_fixed`: every value encodes to min_size bytes
+ * - `static constexpr size_t min_size`: smallest encoding
+ * - `static constexpr bool is_raw`: the encoding is T's object bytes
+ *   (implies is_fixed and min_size == sizeof(T))
+ * - `static size_t size(const T &)`
+ * - `template <typename P> static void encode(Encoder<P> &, const T &)`
+ * - `static void decode(LimcodeDecoder &, T &)`
+ */
+template <typename T> struct Codec;
+
+template <typename T>
+concept Codable = requires { Codec<std::remove_cvref_t<T>>::min_size; };
+
+// ==================== Scalars ====================
+
+template <typename T>
+  requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) ||
+          std::is_enum_v<T>
+struct Codec<T> {
+  static constexpr bool is_fixed = true;
+  static constexpr size_t min_size = sizeof(T);
+  static constexpr bool is_raw = true; // Little-endian hosts only, as elsewhere
+
+  static size_t size(const T &) noexcept { return sizeof(T); }
+
+  template <typename P> static void encode(Encoder<P> &enc, const T &value) {
+    enc.template write_fixed<sizeof(T)>(&value);
+  }
+
+  static void decode(LimcodeDecoder &dec, T &value) {
+    dec.read_fixed<sizeof(T)>(&value);
+  }
+};
+
+template <> struct Codec<bool> {
+  static constexpr bool is_fixed = true;
+  static constexpr size_t min_size = 1;
+  static constexpr bool is_raw = false; // Decoding validates the byte
+
+  static size_t size(bool) noexcept { return 1; }
+
+  template <typename P> static void encode(Encoder<P> &enc, bool value) {
+    enc.write_u8(value ? 1 : 0);
+  }
+
+  static bool read(LimcodeDecoder &dec) {
+    uint8_t byte = dec.read_u8();
+    if (byte > 1) {
+      throw LimcodeError::invalid_encoding("bool must be 0 or 1");
+    }
+    return byte == 1;
+  }
+
+  static void decode(LimcodeDecoder &dec, bool &value) { value = read(dec); }
+};
+
+// ==================== Containers ====================
+
+template <typename T, size_t N> struct Codec<std::array<T, N>> {
+  using Elem = Codec<T>;
+  static constexpr bool is_fixed = Elem::is_fixed;
+  static constexpr size_t min_size = N * Elem::min_size;
+  static constexpr bool is_raw =
+      Elem::is_raw && sizeof(std::array<T, N>) == N * sizeof(T);
+
+  static size_t size(const std::array<T, N> &value) {
+    if constexpr (is_fixed) {
+      return min_size;
+    } else {
+      size_t total = 0;
+      for (const auto &elem : value) {
+        total += Elem::size(elem);
+      }
+      return total;
+    }
+  }
+
+  template <typename P>
+  static void encode(Encoder<P> &enc, const std::array<T, N> &value) {
+    if constexpr (is_raw) {
+      enc.template write_fixed<sizeof(value)>(value.data());
+    } else {
+      for (const auto &elem : value) {
+        Elem::encode(enc, elem);
+      }
+    }
+  }
+
+  static void decode(LimcodeDecoder &dec, std::array<T, N> &value) {
+    if constexpr (is_raw) {
+      dec.read_fixed<sizeof(value)>(value.data());
+    } else {
+      for (auto &elem : value) {
+        Elem::decode(dec, elem);
+      }
+    }
+  }
+};
+
+namespace detail {
+
+/// bincode Vec/String length, rejecting counts the input can't hold
+inline size_t read_schema_len(LimcodeDecoder &dec, size_t min_element_size) {
+  uint64_t count = dec.read_u64();
+  size_t per = min_element_size ? min_element_size : 1;
+  if (count > dec.remaining() / per) {
+    throw LimcodeError::invalid_encoding("Vec length exceeds input size");
+  }
+  return static_cast<size_t>(count);
+}
+
+} // namespace detail
+
+template <typename T> struct Codec<std::vector<T>> {
+  using Elem = Codec<T>;
+  static constexpr bool is_fixed = false;
+  static constexpr size_t min_size = 8;
+  static constexpr bool is_raw = false;
+
+  static size_t size(const std::vector<T> &value) {
+    if constexpr (Elem::is_fixed) {
+      return 8 + value.size() * Elem::min_size;
+    } else {
+      size_t total = 8;
+      for (const auto &elem : value) {
+        total += Elem::size(elem);
+      }
+      return total;
+    }
+  }
+
+  template <typename P>
+  static void encode(Encoder<P> &enc, const std::vector<T> &value) {
+    enc.write_u64(value.size());
+    if constexpr (std::is_same_v<T, bool>) {
+      for (bool elem : value) {
+        enc.write_u8(elem ? 1 : 0);
+      }
+    } else {
+      if (!value.empty() && bulk(value.front())) {
+        enc.write_bytes(reinterpret_cast<const uint8_t *>(value.data()),
+                        value.size() * sizeof(T));
+        return;
+      }
+      for (const auto &elem : value) {
+        Elem::encode(enc, elem);
+      }
+    }
+  }
+
+  static void decode(LimcodeDecoder &dec, std::vector<T> &value) {
+    size_t count = detail::read_schema_len(dec, Elem::min_size);
+    value.clear();
+    if constexpr (std::is_same_v<T, bool>) {
+      value.reserve(count);
+      for (size_t i = 0; i < count; ++i) {
+        value.push_back(Codec<bool>::read(dec));
+      }
+    } else {
+      value.resize(count);
+      if (count > 0 && bulk(value.front())) {
+        dec.read_bytes(reinterpret_cast<uint8_t *>(value.data()),
+                       count * sizeof(T));
+        return;
+      }
+      for (auto &elem : value) {
+        Elem::decode(dec, elem);
+      }
+    }
+  }
+
+private:
+  /// Elements can be copied as one block
+  static bool bulk(const T &sample) {
+    if constexpr (Elem::is_raw) {
+      return true;
+    } else if constexpr (requires { Elem::raw_layout(sample); }) {
+      return Elem::raw_layout(sample);
+    } else {
+      (void)sample;
+      return false;
+    }
+  }
+};
+
+template <> struct Codec<std::string> {
+  static constexpr bool is_fixed = false;
+  static constexpr size_t min_size = 8;
+  static constexpr bool is_raw = false;
+
+  static size_t size(const std::string &value) noexcept {
+    return 8 + value.size();
+  }
+
+  template <typename P>
+  static void encode(Encoder<P> &enc, const std::string &value) {
+    enc.write_u64(value.size());
+    enc.write_bytes(reinterpret_cast<const uint8_t *>(value.data()),
+                    value.size());
+  }
+
+  static void decode(LimcodeDecoder &dec, std::string &value) {
+    size_t len = detail::read_schema_len(dec, 1);
+    value.resize(len);
+    dec.read_bytes(reinterpret_cast<uint8_t *>(value.data()), len);
+  }
+};
+
+template <typename T> struct Codec<std::optional<T>> {
+  static constexpr bool is_fixed = false;
+  static constexpr size_t min_size = 1;
+  static constexpr bool is_raw = false;
+
+  static size_t size(const std::optional<T> &value) {
+    return 1 + (value ? Codec<T>::size(*value) : 0);
+  }
+
+  template <typename P>
+  static void encode(Encoder<P> &enc, const std::optional<T> &value) {
+    enc.write_u8(value ? 1 : 0);
+    if (value) {
+      Codec<T>::encode(enc, *value);
+    }
+  }
+
+  static void decode(LimcodeDecoder &dec, std::optional<T> &value) {
+    uint8_t tag = dec.read_u8();
+    if (tag == 0) {
+      value.reset();
+    } else if (tag == 1) {
+      Codec<T>::decode(dec, value.emplace());
+    } else {
+      throw LimcodeError::invalid_encoding("Option tag must be 0 or 1");
+    }
+  }
+};
+
+template <typename... Ts> struct Codec<std::variant<Ts...>> {
+  using Variant = std::variant<Ts...>;
+  static constexpr bool is_fixed = false;
+  static constexpr size_t min_size = 4 + std::min({Codec<Ts>::min_size...});
+  static constexpr bool is_raw = false;
+
+  static size_t size(const Variant &value) {
+    return 4 + std::visit(
+                   [](const auto &alt) {
+                     return Codec<std::remove_cvref_t<decltype(alt)>>::size(alt);
+                   },
+                   value);
+  }
+
+  template <typename P>
+  static void encode(Encoder<P> &enc, const Variant &value) {
+    uint32_t index = static_cast<uint32_t>(value.index());
+    enc.template write_fixed<4>(&index);
+    std::visit(
+        [&](const auto &alt) {
+          Codec<std::remove_cvref_t<decltype(alt)>>::encode(enc, alt);
+        },
+        value);
+  }
+
+  static void decode(LimcodeDecoder &dec, Variant &value) {
+    uint32_t index;
+    dec.read_fixed<4>(&index);
+    if (index >= sizeof...(Ts)) {
+      throw LimcodeError::invalid_encoding("variant index out of range");
+    }
+    decode_alternative(dec, value, index, std::index_sequence_for<Ts...>{});
+  }
+
+private:
+  template <size_t... I>
+  static void decode_alternative(LimcodeDecoder &dec, Variant &value,
+                                 uint32_t index, std::index_sequence<I...>) {
+    (void)((index == I
+                ? (Codec<std::variant_alternative_t<I, Variant>>::decode(
+                       dec, value.template emplace<I>()),
+                   true)
+                : false) ||
+           ...);
+  }
+};
+
+namespace detail {
+
+/// Tuple-like of codable members: fields in order, never raw (layout is the
+/// library's choice)
+template <typename Tuple, typename... Ts> struct TupleCodec {
+  static constexpr bool is_fixed = (Codec<Ts>::is_fixed && ...);
+  static constexpr size_t min_size = (size_t(0) + ... + Codec<Ts>::min_size);
+  static constexpr bool is_raw = false;
+
+  static size_t size(const Tuple &value) {
+    return std::apply(
+        [](const auto &...fields) {
+          return (size_t(0) + ... +
+                  Codec<std::remove_cvref_t<decltype(fields)>>::size(fields));
+        },
+        value);
+  }
+
+  template <typename P> static void encode(Encoder<P> &enc, const Tuple &value) {
+    std::apply(
+        [&](const auto &...fields) {
+          (Codec<std::remove_cvref_t<decltype(fields)>>::encode(enc, fields),
+           ...);
+        },
+        value);
+  }
+
+  static void decode(LimcodeDecoder &dec, Tuple &value) {
+    std::apply(
+        [&](auto &...fields) {
+          (Codec<std::remove_cvref_t<decltype(fields)>>::decode(dec, fields),
+           ...);
+        },
+        value);
+  }
+};
+
+} // namespace detail
+
+template <typename... Ts>
+struct Codec<std::tuple<Ts...>>
+    : detail::TupleCodec<std::tuple<Ts...>, Ts...> {};
+
+template <typename A, typename B>
+struct Codec<std::pair<A, B>> : detail::TupleCodec<std::pair<A, B>, A, B> {};
+
+// ==================== Built-in Solana Types ====================
+
+template <> struct Codec<Entry> {
+  static constexpr bool is_fixed = false;
+  static constexpr size_t min_size = MIN_ENTRY_BYTES;
+  static constexpr bool is_raw = false;
+
+  static size_t size(const Entry &value) { return serialized_size(value); }
+
+  template <typename P> static void encode(Encoder<P> &enc, const Entry &value) {
+    enc.write_entry(value);
+  }
+
+  static void decode(LimcodeDecoder &dec, Entry &value) {
+    value = dec.read_entry();
+  }
+};
+
+template <> struct Codec<VersionedTransaction> {
+  static constexpr bool is_fixed = false;
+  static constexpr size_t min_size = 1;
+  static constexpr bool is_raw = false;
+
+  static size_t size(const VersionedTransaction &value) {
+    return serialized_size(value);
+  }
+
+  template <typename P>
+  static void encode(Encoder<P> &enc, const VersionedTransaction &value) {
+    enc.write_versioned_transaction(value);
+  }
+
+  static void decode(LimcodeDecoder &dec, VersionedTransaction &value) {
+    value = dec.read_versioned_transaction();
+  }
+};
+
+// ==================== Schema Structs ====================
+
+namespace detail {
+
+template <typename T, size_t I>
+using SchemaFieldType = std::remove_cvref_t<
+    decltype(std::declval<T &>().*std::get<I>(Schema<T>::fields))>;
+
+template <typename T>
+inline constexpr size_t schema_field_count =
+    std::tuple_size_v<std::remove_cvref_t<decltype(Schema<T>::fields)>>;
+
+/// One past the last field of the raw run starting at I (I + 1 if field I
+/// isn't raw)
+template <typename T, size_t I> constexpr size_t schema_run_end() {
+  if constexpr (I + 1 < schema_field_count<T>) {
+    if constexpr (Codec<SchemaFieldType<T, I>>::is_raw &&
+                  Codec<SchemaFieldType<T, I + 1>>::is_raw) {
+      return schema_run_end<T, I + 1>();
+    }
+  }
+  return I + 1;
+}
+
+template <typename T, size_t Begin, size_t End>
+constexpr size_t schema_run_bytes() {
+  return []<size_t... K>(std::index_sequence<K...>) {
+    return (size_t(0) + ... + sizeof(SchemaFieldType<T, Begin + K>));
+  }(std::make_index_sequence<End - Begin>{});
+}
+
+template <typename T, size_t I>
+LIMCODE_ALWAYS_INLINE size_t schema_offset(const T &value) noexcept {
+  return static_cast<size_t>(
+      reinterpret_cast<const char *>(&(value.*std::get<I>(Schema<T>::fields))) -
+      reinterpret_cast<const char *>(&value));
+}
+
+/// Fields [Begin, End) are adjacent in memory in schema order; the offsets
+/// are constants, so this folds to true or false
+template <typename T, size_t Begin, size_t End>
+LIMCODE_ALWAYS_INLINE bool schema_run_contiguous(const T &value) noexcept {
+  return [&]<size_t... K>(std::index_sequence<K...>) {
+    return ((schema_offset<T, Begin + K>(value) +
+                 sizeof(SchemaFieldType<T, Begin + K>) ==
+             schema_offset<T, Begin + K + 1>(value)) &&
+            ...);
+  }(std::make_index_sequence<End - Begin - 1>{});
+}
+
+} // namespace detail
+
+template <HasSchema T> struct Codec<T> {
+private:
+  static constexpr size_t N = detail::schema_field_count<T>;
+
+  template <size_t I> using Field = Codec<detail::SchemaFieldType<T, I>>;
+
+  template <size_t I> static auto &get(T &value) {
+    return value.*std::get<I>(Schema<T>::fields);
+  }
+  template <size_t I> static const auto &get(const T &value) {
+    return value.*std::get<I>(Schema<T>::fields);
+  }
+
+  template <size_t... I>
+  static constexpr bool all_fixed(std::index_sequence<I...>) {
+    return (Field<I>::is_fixed && ...);
+  }
+  template <size_t... I>
+  static constexpr bool all_raw(std::index_sequence<I...>) {
+    return (Field<I>::is_raw && ...);
+  }
+  template <size_t... I>
+  static constexpr size_t sum_min(std::index_sequence<I...>) {
+    return (size_t(0) + ... + Field<I>::min_size);
+  }
+
+  template <size_t I, typename P>
+  LIMCODE_ALWAYS_INLINE static void encode_from(Encoder<P> &enc,
+                                                const T &value) {
+    if constexpr (I < N) {
+      constexpr size_t end = detail::schema_run_end<T, I>();
+      if constexpr (end - I >= 2) {
+        if (detail::schema_run_contiguous<T, I, end>(value)) {
+          enc.template write_fixed<detail::schema_run_bytes<T, I, end>()>(
+              &get<I>(value));
+        } else {
+          encode_each<I, end>(enc, value);
+        }
+      } else {
+        Field<I>::encode(enc, get<I>(value));
+      }
+      encode_from<end>(enc, value);
+    }
+  }
+
+  template <size_t I, size_t End, typename P>
+  static void encode_each(Encoder<P> &enc, const T &value) {
+    if constexpr (I < End) {
+      Field<I>::encode(enc, get<I>(value));
+      encode_each<I + 1, End>(enc, value);
+    }
+  }
+
+  template <size_t I>
+  LIMCODE_ALWAYS_INLINE static void decode_from(LimcodeDecoder &dec, T &value) {
+    if constexpr (I < N) {
+      constexpr size_t end = detail::schema_run_end<T, I>();
+      if constexpr (end - I >= 2) {
+        if (detail::schema_run_contiguous<T, I, end>(value)) {
+          dec.read_fixed<detail::schema_run_bytes<T, I, end>()>(&get<I>(value));
+        } else {
+          decode_each<I, end>(dec, value);
+        }
+      } else {
+        Field<I>::decode(dec, get<I>(value));
+      }
+      decode_from<end>(dec, value);
+    }
+  }
+
+  template <size_t I, size_t End>
+  static void decode_each(LimcodeDecoder &dec, T &value) {
+    if constexpr (I < End) {
+      Field<I>::decode(dec, get<I>(value));
+      decode_each<I + 1, End>(dec, value);
+    }
+  }
+
+public:
+  static constexpr bool is_fixed = all_fixed(std::make_index_sequence<N>{});
+  static constexpr size_t min_size = sum_min(std::make_index_sequence<N>{});
+  static constexpr bool is_raw = false; // See raw_layout()
+
+  /// The encoding of every T is its object bytes: all fields raw, no padding,
+  /// declared in schema order. Lets vectors of T copy in one block
+  static bool raw_layout(const T &sample) noexcept {
+    if constexpr (std::is_trivially_copyable_v<T> && N > 0 &&
+                  all_raw(std::make_index_sequence<N>{}) &&
+                  min_size == sizeof(T)) {
+      return detail::schema_offset<T, 0>(sample) == 0 &&
+             (N == 1 || detail::schema_run_contiguous<T, 0, N>(sample));
+    } else {
+      (void)sample;
+      return false;
+    }
+  }
+
+  static size_t size(const T &value) {
+    if constexpr (is_fixed) {
+      (void)value;
+      return min_size;
+    } else {
+      return [&]<size_t... I>(std::index_sequence<I...>) {
+        return (size_t(0) + ... + Field<I>::size(get<I>(value)));
+      }(std::make_index_sequence<N>{});
+    }
+  }
+
+  template <typename P> static void encode(Encoder<P> &enc, const T &value) {
+    encode_from<0>(enc, value);
+  }
+
+  static void decode(LimcodeDecoder &dec, T &value) {
+    decode_from<0>(dec, value);
+  }
+};
+
+// ==================== Entry Points ====================
+
+/**
+ * @brief Encoded size of `value` (exact; no encoding is done)
+ */
+template <Codable T>
+  requires HasSchema<T>
+[[nodiscard]] size_t serialized_size(const T &value) {
+  return Codec<T>::size(value);
+}
+
+/**
+ * @brief Encode `value` into caller-provided memory
+ * @return Bytes written
+ * @throws LimcodeError (BufferOverflow) if `out` is too small
+ */
+template <Codable T>
+size_t serialize_into(const T &value, std::span<uint8_t> out) {
+  size_t size = Codec<T>::size(value);
+  if (size > out.size()) {
+    throw LimcodeError::buffer_overflow(size, out.size());
+  }
+  Encoder<UncheckedPolicy> encoder(out);
+  Codec<T>::encode(encoder, value);
+  return encoder.size();
+}
+
+/**
+ * @brief Encode `value` (sized first, then written in one unchecked pass)
+ */
+template <Codable T>
+[[nodiscard]] std::vector<uint8_t> serialize(const T &value) {
+  Encoder<UncheckedPolicy> encoder(Codec<T>::size(value));
+  Codec<T>::encode(encoder, value);
+  return encoder.finish();
+}
+
+/**
+ * @brief Decode a T from the front of `decoder`
+ */
+template <Codable T> void deserialize_from(LimcodeDecoder &decoder, T &out) {
+  Codec<T>::decode(decoder, out);
+}
+
+/**
+ * @brief Decode a T from exactly `data`
+ * @throws LimcodeError on malformed input or trailing bytes
+ */
+template <Codable T> [[nodiscard]] T deserialize(std::span<const uint8_t> data) {
+  LimcodeDecoder decoder(data);
+  T value{};
+  Codec<T>::decode(decoder, value);
+  if (decoder.has_remaining()) {
+    throw LimcodeError::invalid_encoding("trailing bytes after value");
+  }
+  return value;
+}
+
+} // namespace limcode
+
+// ==================== LIMCODE_SCHEMA ====================
+
+#define LIMCODE_PP_PARENS ()
+#define LIMCODE_PP_EXPAND(...)                                                 \
+  LIMCODE_PP_EXPAND4(LIMCODE_PP_EXPAND4(                                       \
+      LIMCODE_PP_EXPAND4(LIMCODE_PP_EXPAND4(__VA_ARGS__))))
+#define LIMCODE_PP_EXPAND4(...)                                                \
+  LIMCODE_PP_EXPAND3(LIMCODE_PP_EXPAND3(                                       \
+      LIMCODE_PP_EXPAND3(LIMCODE_PP_EXPAND3(__VA_ARGS__))))
+#define LIMCODE_PP_EXPAND3(...)                                                \
+  LIMCODE_PP_EXPAND2(LIMCODE_PP_EXPAND2(                                       \
+      LIMCODE_PP_EXPAND2(LIMCODE_PP_EXPAND2(__VA_ARGS__))))
+#define LIMCODE_PP_EXPAND2(...)                                                \
+  LIMCODE_PP_EXPAND1(LIMCODE_PP_EXPAND1(                                       \
+      LIMCODE_PP_EXPAND1(LIMCODE_PP_EXPAND1(__VA_ARGS__))))
+#define LIMCODE_PP_EXPAND1(...) __VA_ARGS__
+
+// Expands to `&Type::a, &Type::b, ...` (up to 256 fields)
+#define LIMCODE_PP_MEMBERS(Type, ...)                                          \
+  __VA_OPT__(LIMCODE_PP_EXPAND(LIMCODE_PP_MEMBERS_STEP(Type, __VA_ARGS__)))
+#define LIMCODE_PP_MEMBERS_STEP(Type, field, ...)                              \
+  &Type::field __VA_OPT__(, LIMCODE_PP_MEMBERS_AGAIN LIMCODE_PP_PARENS(         \
+                                Type, __VA_ARGS__))
+#define LIMCODE_PP_MEMBERS_AGAIN() LIMCODE_PP_MEMBERS_STEP
+
+/**
+ * @brief Declare the wire fields of `Type`, in order
+ *
+ * Use at global namespace scope, after the definition of `Type`.
+ */
+#define LIMCODE_SCHEMA(Type, ...)                                              \
+  template <> struct limcode::Schema<Type> {                                   \
+    static constexpr auto fields =                                             \
+        std::make_tuple(LIMCODE_PP_MEMBERS(Type, __VA_ARGS__));                \
+  }
@@ -0,0 +1,267 @@
+#pragma once
+
+/**
+ * @file simd_dispatch.h
+ * @brief Runtime CPU dispatch for the bulk copy kernels
+ *
+ * The AVX2 and AVX-512 kernels are compiled with per-function target
+ * attributes, so one binary built for a baseline ISA (x86-64-v2) still runs
+ * them where the CPU supports it. The kernel table is chosen once from CPUID
+ * on first use; every later call is one indirect call.
+ *
+ * The environment variable LIMCODE_SIMD=scalar|avx2|avx512 caps the level
+ * (it never enables instructions the CPU lacks).
+ *
+ * Fixed-size 32/64/128-byte copies (limcode_copy32 and friends) stay
+ * compile-time: an indirect call costs more than the copy itself.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(_M_X64)) &&                                \
+    (defined(__GNUC__) || defined(__clang__))
+#define LIMCODE_HAS_SIMD_DISPATCH 1
+#include <immintrin.h>
+#define LIMCODE_TARGET_AVX2 __attribute__((target("avx2")))
+#define LIMCODE_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,bmi2")))
+#else
+#define LIMCODE_HAS_SIMD_DISPATCH 0
+#endif
+
+namespace limcode {
+
+/// Instruction set selected for the bulk kernels
+enum class SimdLevel : uint8_t { Scalar = 0, AVX2 = 1, AVX512 = 2 };
+
+/// Bulk kernels for one SimdLevel
+struct SimdKernels {
+  SimdLevel level;
+  /// Regular-store copy (stays in cache)
+  void (*copy)(void *dst, const void *src, size_t len) noexcept;
+  /// Non-temporal copy (bypasses cache; for large one-shot transfers)
+  void (*copy_nt)(void *dst, const void *src, size_t len) noexcept;
+};
+
+namespace simd {
+
+inline void copy_scalar(void *dst, const void *src, size_t len) noexcept {
+  std::memcpy(dst, src, len);
+}
+
+#if LIMCODE_HAS_SIMD_DISPATCH
+
+LIMCODE_TARGET_AVX2 inline void copy_avx2(void *dst, const void *src,
+                                          size_t len) noexcept {
+  auto *d = static_cast<uint8_t *>(dst);
+  const auto *s = static_cast<const uint8_t *>(src);
+
+  // 8x unrolled (256 bytes per iteration)
+  while (len >= 256) {
+    __builtin_prefetch(s + 1024, 0, 3);
+    __m256i v[8];
+    for (int i = 0; i < 8; ++i) {
+      v[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i * 32));
+    }
+    for (int i = 0; i < 8; ++i) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i * 32), v[i]);
+    }
+    d += 256;
+    s += 256;
+    len -= 256;
+  }
+  while (len >= 32) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(d),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s)));
+    d += 32;
+    s += 32;
+    len -= 32;
+  }
+  if (len > 0) {
+    std::memcpy(d, s, len);
+  }
+}
+
+LIMCODE_TARGET_AVX2 inline void copy_nt_avx2(void *dst, const void *src,
+                                             size_t len) noexcept {
+  auto *d = static_cast<uint8_t *>(dst);
+  const auto *s = static_cast<const uint8_t *>(src);
+
+  // Align destination to 32 bytes for streaming stores
+  size_t misalignment = reinterpret_cast<uintptr_t>(d) & 31;
+  if (misalignment != 0) {
+    size_t head = 32 - misalignment;
+    if (head > len) {
+      head = len;
+    }
+    std::memcpy(d, s, head);
+    d += head;
+    s += head;
+    len -= head;
+  }
+
+  while (len >= 128) {
+    __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s));
+    __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + 32));
+    __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + 64));
+    __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + 96));
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(d), v0);
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(d + 32), v1);
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(d + 64), v2);
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(d + 96), v3);
+    d += 128;
+    s += 128;
+    len -= 128;
+  }
+  _mm_sfence();
+
+  if (len > 0) {
+    std::memcpy(d, s, len);
+  }
+}
+
+LIMCODE_TARGET_AVX512 inline void copy_avx512(void *dst, const void *src,
+                                              size_t len) noexcept {
+  auto *d = static_cast<uint8_t *>(dst);
+  const auto *s = static_cast<const uint8_t *>(src);
+
+  // 16x unrolled (1024 bytes per iteration)
+  while (len >= 1024) {
+    __builtin_prefetch(s + 2048, 0, 3);
+    __m512i v[16];
+    for (int i = 0; i < 16; ++i) {
+      v[i] = _mm512_loadu_si512(s + i * 64);
+    }
+    for (int i = 0; i < 16; ++i) {
+      _mm512_storeu_si512(d + i * 64, v[i]);
+    }
+    d += 1024;
+    s += 1024;
+    len -= 1024;
+  }
+  while (len >= 64) {
+    _mm512_storeu_si512(d, _mm512_loadu_si512(s));
+    d += 64;
+    s += 64;
+    len -= 64;
+  }
+  if (len > 0) {
+    // Masked tail: one load/store instead of a memcpy call
+    __mmask64 mask = _bzhi_u64(~uint64_t(0), static_cast<unsigned>(len));
+    _mm512_mask_storeu_epi8(d, mask, _mm512_maskz_loadu_epi8(mask, s));
+  }
+}
+
+LIMCODE_TARGET_AVX512 inline void copy_nt_avx512(void *dst, const void *src,
+                                                 size_t len) noexcept {
+  auto *d = static_cast<uint8_t *>(dst);
+  const auto *s = static_cast<const uint8_t *>(src);
+
+  // Align destination to 64 bytes for streaming stores
+  size_t misalignment = reinterpret_cast<uintptr_t>(d) & 63;
+  if (misalignment != 0) {
+    size_t head = 64 - misalignment;
+    if (head > len) {
+      head = len;
+    }
+    std::memcpy(d, s, head);
+    d += head;
+    s += head;
+    len -= head;
+  }
+
+  while (len >= 128) {
+    __m512i v0 = _mm512_loadu_si512(s);
+    __m512i v1 = _mm512_loadu_si512(s + 64);
+    _mm512_stream_si512(reinterpret_cast<__m512i *>(d), v0);
+    _mm512_stream_si512(reinterpret_cast<__m512i *>(d + 64), v1);
+    d += 128;
+    s += 128;
+    len -= 128;
+  }
+  _mm_sfence();
+
+  if (len > 0) {
+    std::memcpy(d, s, len);
+  }
+}
+
+#endif // LIMCODE_HAS_SIMD_DISPATCH
+
+/// Highest level the CPU (and OS register state) supports
+inline SimdLevel detect_cpu_level() noexcept {
+#if LIMCODE_HAS_SIMD_DISPATCH
+  __builtin_cpu_init();
+  // _bzhi_u64 in the AVX-512 tail needs BMI2; every AVX-512 CPU has it
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("bmi2")) {
+    return SimdLevel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+#endif
+  return SimdLevel::Scalar;
+}
+
+/// Detected level, capped by LIMCODE_SIMD
+inline SimdLevel select_level() noexcept {
+  SimdLevel level = detect_cpu_level();
+  if (const char *env = std::getenv("LIMCODE_SIMD")) {
+    SimdLevel cap = level;
+    if (std::strcmp(env, "scalar") == 0) {
+      cap = SimdLevel::Scalar;
+    } else if (std::strcmp(env, "avx2") == 0) {
+      cap = SimdLevel::AVX2;
+    } else if (std::strcmp(env, "avx512") == 0) {
+      cap = SimdLevel::AVX512;
+    }
+    if (cap < level) {
+      level = cap;
+    }
+  }
+  return level;
+}
+
+} // namespace simd
+
+/**
+ * @brief Kernel table for an explicit level
+ *
+ * Levels the build can't target fall back to scalar. Callers must not
+ * request a level above simd::detect_cpu_level().
+ */
+inline const SimdKernels &simd_kernels_for(SimdLevel level) noexcept {
+  static constexpr SimdKernels scalar{SimdLevel::Scalar, simd::copy_scalar,
+                                      simd::copy_scalar};
+#if LIMCODE_HAS_SIMD_DISPATCH
+  static constexpr SimdKernels avx2{SimdLevel::AVX2, simd::copy_avx2,
+                                    simd::copy_nt_avx2};
+  static constexpr SimdKernels avx512{SimdLevel::AVX512, simd::copy_avx512,
+                                      simd::copy_nt_avx512};
+  switch (level) {
+  case SimdLevel::AVX512:
+    return avx512;
+  case SimdLevel::AVX2:
+    return avx2;
+  case SimdLevel::Scalar:
+    break;
+  }
+#else
+  (void)level;
+#endif
+  return scalar;
+}
+
+/// Kernel table for this CPU, selected once on first use
+inline const SimdKernels &simd_kernels() noexcept {
+  static const SimdKernels &kernels = simd_kernels_for(simd::select_level());
+  return kernels;
+}
+
+/// Level the dispatched kernels run at
+inline SimdLevel simd_level() noexcept { return simd_kernels().level; }
+
+} // namespace limcode
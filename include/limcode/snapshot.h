@@ -5,7 +5,9 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <algorithm>
 #include <array>
+#include <span>
 
 namespace limcode {
 namespace snapshot {
@@ -46,6 +48,83 @@ struct AppendVecHeader {
 
 static_assert(sizeof(AppendVecHeader) == 136, "AppendVecHeader must be 136 bytes");
 
+/// Zero-copy view of one AppendVec record
+///
+/// Points straight into the AppendVec buffer; only valid while that buffer is.
+struct SnapshotAccountView {
+    const AppendVecHeader* header = nullptr;
+    std::span<const uint8_t> data;   // Variable length account data
+
+    uint64_t write_version() const { return header->write_version; }
+    uint64_t lamports() const { return header->lamports; }
+    uint64_t rent_epoch() const { return header->rent_epoch; }
+    bool executable() const { return header->executable != 0; }
+    std::span<const uint8_t, 32> pubkey() const { return std::span<const uint8_t, 32>(header->pubkey, 32); }
+    std::span<const uint8_t, 32> owner() const { return std::span<const uint8_t, 32>(header->owner, 32); }
+    std::span<const uint8_t, 32> hash() const { return std::span<const uint8_t, 32>(header->hash, 32); }
+
+    /// Copy into an owning SnapshotAccount
+    SnapshotAccount to_owned() const {
+        SnapshotAccount account;
+        account.write_version = header->write_version;
+        account.lamports = header->lamports;
+        account.rent_epoch = header->rent_epoch;
+        account.executable = header->executable != 0;
+        std::copy_n(header->pubkey, 32, account.pubkey.begin());
+        std::copy_n(header->owner, 32, account.owner.begin());
+        std::copy_n(header->hash, 32, account.hash.begin());
+        account.data.assign(data.begin(), data.end());
+        return account;
+    }
+};
+
+struct AccountFilter;
+
+/// Callback receiving a batch of account views (return false to stop)
+using AccountBatchCallback = std::function<bool(std::span<const SnapshotAccountView>)>;
+
+/// Visit every record in an AppendVec buffer without copying
+///
+/// The callback is a template parameter so the per-account call inlines.
+/// It is invoked as `bool callback(const SnapshotAccountView&)`; return false to stop.
+///
+/// @param data Raw AppendVec file data
+/// @param size Size of data in bytes
+/// @param callback Visitor for each account
+/// @return Number of accounts visited (the one that returned false is not counted)
+template <typename Callback>
+inline size_t for_each_account_view(const uint8_t* data, size_t size, Callback&& callback) {
+    constexpr size_t HEADER_SIZE = sizeof(AppendVecHeader);
+    size_t count = 0;
+    size_t offset = 0;
+
+    while (offset + HEADER_SIZE <= size) {
+        const auto* header = reinterpret_cast<const AppendVecHeader*>(data + offset);
+
+        // Validate data_len
+        if (header->data_len > size - offset - HEADER_SIZE) {
+            break; // Incomplete account
+        }
+
+        SnapshotAccountView view;
+        view.header = header;
+        view.data = std::span<const uint8_t>(data + offset + HEADER_SIZE, header->data_len);
+
+        offset += HEADER_SIZE + header->data_len;
+
+        // 8-byte alignment padding
+        offset += (8 - (offset % 8)) % 8;
+
+        if (!callback(static_cast<const SnapshotAccountView&>(view))) {
+            break; // User requested stop
+        }
+
+        count++;
+    }
+
+    return count;
+}
+
 /// Parse accounts from AppendVec file data
 ///
 /// @param data Raw AppendVec file data
@@ -65,6 +144,21 @@ size_t parse_appendvec(const uint8_t* data, size_t size, std::vector<SnapshotAcc
 size_t stream_appendvec(const uint8_t* data, size_t size,
                        std::function<bool(const SnapshotAccount&)> callback);
 
+/// Stream account views from AppendVec file data in batches
+///
+/// Views in each batch point into `data`; no per-account allocation.
+///
+/// @param data Raw AppendVec file data
+/// @param size Size of data in bytes
+/// @param callback Function called for each batch (return false to stop)
+/// @param batch_size Maximum views per batch
+/// @param filter Optional predicate (see snapshot_filter.h); only matching accounts are batched
+/// @return Number of accounts delivered
+size_t stream_appendvec_batches(const uint8_t* data, size_t size,
+                                const AccountBatchCallback& callback,
+                                size_t batch_size = 1024,
+                                const AccountFilter* filter = nullptr);
+
 /// Parse Solana snapshot archive (.tar.zst)
 ///
 /// WARNING: Loads all accounts into memory. Use stream_snapshot for large snapshots.
@@ -88,6 +182,192 @@ bool parse_snapshot(const std::string& snapshot_path, std::vector<SnapshotAccoun
 int64_t stream_snapshot(const std::string& snapshot_path,
                        std::function<bool(const SnapshotAccount&)> callback);
 
+class AccountIndexBuilder;
+class AccountsHasher;
+class BufferArena;
+struct SnapshotManifest;
+
+/// Tuning knobs for stream_snapshot_parallel
+struct ParallelStreamOptions {
+    /// Number of AppendVec parser threads (0 = std::thread::hardware_concurrency())
+    unsigned num_threads = 0;
+
+    /// Upper bound on decompressed AppendVec bytes being read, queued or parsed
+    /// at once. The decompressor blocks once this budget is used up, before it
+    /// takes the next buffer from the arena. A single AppendVec
+    /// larger than the budget is still admitted when nothing else is in flight.
+    size_t max_inflight_bytes = size_t(1) << 30;
+
+    /// Size of each compressed read fed to zstd
+    size_t read_buffer_size = size_t(16) << 20;
+
+    /// Compressed reads kept in flight ahead of the decompressor
+    /// (io_uring where available, see prefetch_reader.h)
+    unsigned read_queue_depth = 4;
+
+    /// Read the archive with O_DIRECT where the filesystem supports it
+    bool direct_io = true;
+
+    /// Where AppendVec buffers come from and return to (see snapshot_arena.h);
+    /// nullptr uses BufferArena::shared()
+    BufferArena* arena = nullptr;
+
+    /// Maximum views per batch for stream_snapshot_parallel_batches
+    size_t batch_size = 1024;
+
+    /// Optional pubkey index fed from the same pass (see snapshot_index.h).
+    /// Every delivered account is added; call finish() on it afterwards.
+    AccountIndexBuilder* index_builder = nullptr;
+
+    /// Optional accounts lattice hash fed from the same pass (see
+    /// snapshot_hash.h). Each parser thread keeps a partial sum and adds it
+    /// once it is done; read it after the stream returns. Only complete if
+    /// the consumer never stopped the stream.
+    ///
+    /// stream_merged_snapshot mixes in the newest version of every pubkey,
+    /// filter or not: the bank's accounts lattice hash. The other scans mix
+    /// in every account they deliver, older versions of a pubkey included,
+    /// which is a digest of the raw storages rather than of the bank.
+    AccountsHasher* accounts_hasher = nullptr;
+
+    /// Optional: receives the decoded snapshots/SLOT/SLOT manifest (see
+    /// snapshot_manifest.h) if the archive or cache has one that decodes.
+    /// With a manifest, each AppendVec is parsed only up to its current_len.
+    SnapshotManifest* manifest = nullptr;
+
+    /// Optional predicate checked on each AppendVecHeader (see
+    /// snapshot_filter.h). Accounts that fail it are skipped without being
+    /// copied, batched or indexed. Archive scans still decompress every
+    /// AppendVec; the cached and merged scans never touch their data.
+    const AccountFilter* filter = nullptr;
+
+    /// stream_merged_snapshot only: also deliver accounts whose newest
+    /// version has zero lamports (deleted accounts are skipped by default)
+    bool keep_zero_lamport = false;
+};
+
+/// Stream accounts from Solana snapshot archive using a multithreaded pipeline
+///
+/// The calling thread decompresses the .tar.zst and walks the tar stream,
+/// handing each accounts/ AppendVec to a pool of parser threads. Memory use
+/// is bounded by options.max_inflight_bytes plus the zstd window. Once the
+/// manifest has been seen, each AppendVec is read only up to its current_len.
+///
+/// The callback is invoked concurrently from the parser threads and must be
+/// thread-safe. Account order across AppendVecs is unspecified; order within a
+/// single AppendVec is preserved. Returning false stops all threads as soon as
+/// they observe it.
+///
+/// @param snapshot_path Path to .tar.zst snapshot archive
+/// @param callback Function called for each account (return false to stop)
+/// @param options Thread count and memory bound
+/// @return Number of accounts processed, or -1 on error
+int64_t stream_snapshot_parallel(const std::string& snapshot_path,
+                                 std::function<bool(const SnapshotAccount&)> callback,
+                                 const ParallelStreamOptions& options = {});
+
+/// Stream zero-copy account views from Solana snapshot archive in batches
+///
+/// Views are only valid for the duration of the callback.
+///
+/// @param snapshot_path Path to .tar.zst snapshot archive
+/// @param callback Function called for each batch (return false to stop)
+/// @param batch_size Maximum views per batch
+/// @return Number of accounts processed, or -1 on error
+int64_t stream_snapshot_batches(const std::string& snapshot_path,
+                                const AccountBatchCallback& callback,
+                                size_t batch_size = 1024);
+
+/// Multithreaded zero-copy variant of stream_snapshot_batches
+///
+/// Same pipeline and threading contract as stream_snapshot_parallel; each
+/// batch holds views into a single AppendVec.
+///
+/// @param snapshot_path Path to .tar.zst snapshot archive
+/// @param callback Function called for each batch from worker threads (return false to stop)
+/// @param options Thread count, memory bound and batch size
+/// @return Number of accounts processed, or -1 on error
+int64_t stream_snapshot_parallel_batches(const std::string& snapshot_path,
+                                         const AccountBatchCallback& callback,
+                                         const ParallelStreamOptions& options = {});
+
+/// Extract a snapshot archive into an unpacked cache directory
+///
+/// Empties `cache_dir`, writes every regular file of the archive under it
+/// with its archive path (accounts/SLOT.ID, snapshots/SLOT/SLOT, version,
+/// ...), then drops a completion marker recording the archive's size and
+/// modification time, so a partial extraction is never mistaken for a
+/// usable cache.
+///
+/// @param snapshot_path Path to .tar.zst snapshot archive
+/// @param cache_dir Directory to extract into (created if missing)
+/// @param options Only the read options (read_buffer_size, read_queue_depth, direct_io) are used
+/// @return Number of AppendVec files extracted, or -1 on error
+int64_t unpack_snapshot(const std::string& snapshot_path, const std::string& cache_dir,
+                        const ParallelStreamOptions& options = {});
+
+/// Check for a complete unpack_snapshot() result in `cache_dir`
+bool is_unpacked_snapshot(const std::string& cache_dir);
+
+/// Check that `cache_dir` holds a complete extraction of `snapshot_path` as
+/// it is now (same size and modification time as when it was unpacked)
+bool is_unpacked_snapshot(const std::string& cache_dir, const std::string& snapshot_path);
+
+/// Stream zero-copy account views from an unpacked cache directory
+///
+/// Each accounts/SLOT.ID file is mapped with MappedFile (MADV_SEQUENTIAL,
+/// read-ahead and huge pages where the kernel supports them) and scanned in
+/// place (up to the manifest's current_len when the cache has a manifest);
+/// AppendVec files are spread across options.num_threads threads, largest first.
+/// Threading contract matches stream_snapshot_parallel_batches, and
+/// options.index_builder offsets refer to the cached files.
+///
+/// @param cache_dir Directory produced by unpack_snapshot
+/// @param callback Function called for each batch from worker threads (return false to stop)
+/// @param options Thread count, batch size and optional index builder
+/// @return Number of accounts processed, or -1 on error
+int64_t stream_unpacked_snapshot(const std::string& cache_dir,
+                                 const AccountBatchCallback& callback,
+                                 const ParallelStreamOptions& options = {});
+
+/// Stream a snapshot through its unpacked cache, extracting it first if the
+/// cache is missing, incomplete or from an older version of the archive
+///
+/// @param snapshot_path Path to .tar.zst snapshot archive
+/// @param cache_dir Cache directory for this snapshot
+/// @param callback Function called for each batch from worker threads (return false to stop)
+/// @param options Pipeline options
+/// @return Number of accounts processed, or -1 on error
+int64_t stream_snapshot_cached(const std::string& snapshot_path, const std::string& cache_dir,
+                               const AccountBatchCallback& callback,
+                               const ParallelStreamOptions& options = {});
+
+/// Stream a full snapshot overlaid with an incremental one, one version per pubkey
+///
+/// Both archives go through their unpacked caches (extracted first if
+/// missing or stale). An AccountIndex over both caches, kept as merged.index in the
+/// incremental cache, picks the newest version of every pubkey: highest
+/// slot, then highest write_version. Nothing is materialized beyond the
+/// index: views point into the mapped AppendVecs. The index records the
+/// archive size and mtime of both caches and is rebuilt whenever they differ.
+///
+/// Pubkeys are split into chunks spread across options.num_threads
+/// threads; within a chunk accounts come in file order. Threading contract
+/// matches stream_snapshot_parallel_batches. options.manifest receives the
+/// incremental snapshot's manifest, which describes the merged bank.
+///
+/// @param full_path Path to the full .tar.zst snapshot archive
+/// @param full_cache_dir Cache directory for the full snapshot
+/// @param incremental_path Path to the incremental .tar.zst snapshot archive
+/// @param incremental_cache_dir Cache directory for the incremental snapshot
+/// @param callback Function called for each batch from worker threads (return false to stop)
+/// @param options Pipeline options
+/// @return Number of accounts delivered, or -1 on error
+int64_t stream_merged_snapshot(const std::string& full_path, const std::string& full_cache_dir,
+                               const std::string& incremental_path, const std::string& incremental_cache_dir,
+                               const AccountBatchCallback& callback,
+                               const ParallelStreamOptions& options = {});
+
 /// Statistics from snapshot parsing
 struct SnapshotStats {
     uint64_t total_accounts = 0;
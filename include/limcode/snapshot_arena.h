@@ -0,0 +1,215 @@
+#pragma once
+
+/**
+ * @file snapshot_arena.h
+ * @brief Recycled huge-page buffers for AppendVec bodies
+ *
+ * Every AppendVec of a snapshot used to get a fresh std::vector: zero-filled,
+ * page-faulted, parsed once and freed. BufferArena keeps released buffers
+ * in size classes (four per power of two, so at most 25% slack) and hands
+ * them to the next AppendVec of a similar size, on any thread. Classes of
+ * 2 MiB and up come from internal::allocate_huge_pages; smaller ones are
+ * plain aligned allocations, since a huge page would hold up to 32 times
+ * their size outside the cache budget. Buffers are never zero-filled, so
+ * after warmup a snapshot load neither allocates nor faults for its buffers.
+ *
+ * Usage:
+ * @code
+ *   auto buffer = limcode::snapshot::BufferArena::shared().acquire(size);
+ *   reader.read_exact(buffer.data(), buffer.size());
+ *   // Returned to the arena when `buffer` goes out of scope
+ * @endcode
+ */
+
+#include "limcode/limcode.h"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace limcode {
+namespace snapshot {
+
+/// Thread-safe pool of huge-page buffers, recycled by size class
+///
+/// One mutex guards the free lists; it is taken once per AppendVec, which
+/// is negligible next to decompressing megabytes into the buffer.
+class BufferArena {
+public:
+    /// Smallest class; smaller requests round up to it
+    static constexpr size_t MIN_CLASS_SIZE = 64 * 1024;
+
+    /// Classes from this size up are backed by transparent huge pages
+    static constexpr size_t HUGE_PAGE_CLASS_SIZE = 2 * 1024 * 1024;
+
+    /// Requests above this are allocated and freed directly
+    static constexpr size_t MAX_CLASS_SIZE = size_t(1) << 34;
+
+    /// Owning handle to an arena buffer; returns it to the arena on destruction
+    class Buffer {
+    public:
+        Buffer() = default;
+        ~Buffer() { reset(); }
+
+        Buffer(Buffer&& other) noexcept
+            : arena_(std::exchange(other.arena_, nullptr)), data_(std::exchange(other.data_, nullptr)),
+              size_(std::exchange(other.size_, 0)), capacity_(std::exchange(other.capacity_, 0)) {}
+
+        Buffer& operator=(Buffer&& other) noexcept {
+            if (this != &other) {
+                reset();
+                arena_ = std::exchange(other.arena_, nullptr);
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+                capacity_ = std::exchange(other.capacity_, 0);
+            }
+            return *this;
+        }
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        uint8_t* data() const noexcept { return data_; }
+        size_t size() const noexcept { return size_; }           ///< Requested size
+        size_t capacity() const noexcept { return capacity_; }   ///< Class size
+        bool empty() const noexcept { return size_ == 0; }
+
+        /// Change the usable size without reallocating (must fit the capacity)
+        void resize(size_t size) noexcept { size_ = size <= capacity_ ? size : capacity_; }
+
+        /// Give the buffer back to its arena now
+        void reset() noexcept {
+            if (data_) {
+                arena_->release(data_, capacity_);
+            }
+            arena_ = nullptr;
+            data_ = nullptr;
+            size_ = capacity_ = 0;
+        }
+
+    private:
+        friend class BufferArena;
+        Buffer(BufferArena* arena, uint8_t* data, size_t size, size_t capacity)
+            : arena_(arena), data_(data), size_(size), capacity_(capacity) {}
+
+        BufferArena* arena_ = nullptr;
+        uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+    };
+
+    /// @param max_cached_bytes Free buffers kept for reuse; releases beyond it are freed
+    explicit BufferArena(size_t max_cached_bytes = size_t(4) << 30) : max_cached_bytes_(max_cached_bytes) {}
+
+    ~BufferArena() { trim(); }
+
+    BufferArena(const BufferArena&) = delete;
+    BufferArena& operator=(const BufferArena&) = delete;
+
+    /// Process-wide arena the snapshot pipelines use by default
+    static BufferArena& shared() {
+        static BufferArena arena;
+        return arena;
+    }
+
+    /// Buffer of at least `size` bytes with unspecified contents
+    /// @throws std::bad_alloc if a new buffer can't be allocated
+    Buffer acquire(size_t size) {
+        size_t capacity = class_size(size);
+        if (capacity <= MAX_CLASS_SIZE) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto& list = free_lists_[class_index(capacity)];
+            if (!list.empty()) {
+                uint8_t* data = list.back();
+                list.pop_back();
+                cached_bytes_ -= capacity;
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return Buffer(this, data, size, capacity);
+            }
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        // Class sizes are multiples of 16 KiB, so they suit aligned_alloc
+        auto* data = static_cast<uint8_t*>(capacity >= HUGE_PAGE_CLASS_SIZE
+                                               ? internal::allocate_huge_pages(capacity)
+                                               : std::aligned_alloc(64, capacity));
+        if (!data) {
+            throw std::bad_alloc();
+        }
+        return Buffer(this, data, size, capacity);
+    }
+
+    /// Free every cached buffer
+    void trim() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& list : free_lists_) {
+            for (uint8_t* data : list) {
+                deallocate(data);
+            }
+            list.clear();
+        }
+        cached_bytes_ = 0;
+    }
+
+    uint64_t hits() const noexcept { return hits_.load(std::memory_order_relaxed); }
+    uint64_t misses() const noexcept { return misses_.load(std::memory_order_relaxed); }
+
+    size_t cached_bytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cached_bytes_;
+    }
+
+    /// Capacity handed out for a `size`-byte request
+    static constexpr size_t class_size(size_t size) noexcept {
+        if (size <= MIN_CLASS_SIZE) return MIN_CLASS_SIZE;
+        // Quarter steps: 5, 6, 7 or 8 x 2^(k-2) for sizes in (2^k, 2^(k+1)]
+        size_t step = std::bit_floor(size - 1) >> 2;
+        return (size + step - 1) / step * step;
+    }
+
+private:
+    static constexpr size_t NUM_CLASSES =
+        4 * (std::countr_zero(MAX_CLASS_SIZE) - std::countr_zero(MIN_CLASS_SIZE)) + 1;
+
+    static constexpr size_t class_index(size_t capacity) noexcept {
+        if (capacity <= MIN_CLASS_SIZE) return 0;
+        size_t step = std::bit_floor(capacity - 1) >> 2;
+        size_t octave = static_cast<size_t>(std::countr_zero(step)) + 2 -
+                        static_cast<size_t>(std::countr_zero(MIN_CLASS_SIZE));
+        return 4 * octave + capacity / step - 4;   // 5..8 steps map to 1..4 within the octave
+    }
+
+    /// Both allocation paths come from the C heap
+    static void deallocate(uint8_t* data) noexcept { std::free(data); }
+
+    void release(uint8_t* data, size_t capacity) noexcept {
+        if (capacity <= MAX_CLASS_SIZE) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (cached_bytes_ + capacity <= max_cached_bytes_) {
+                try {
+                    free_lists_[class_index(capacity)].push_back(data);
+                    cached_bytes_ += capacity;
+                    return;
+                } catch (...) {
+                    // Fall through and free it
+                }
+            }
+        }
+        deallocate(data);
+    }
+
+    size_t max_cached_bytes_;
+    mutable std::mutex mutex_;
+    std::vector<uint8_t*> free_lists_[NUM_CLASSES];
+    size_t cached_bytes_ = 0;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace snapshot
+} // namespace limcode
@@ -0,0 +1,184 @@
+#pragma once
+
+/**
+ * @file snapshot_columns.h
+ * @brief Columnar (structure-of-arrays) account export for analytics
+ *
+ * A column directory holds one flat, mmap-able file per field, all with
+ * the same row order:
+ *
+ * - pubkey.bin, owner.bin: 32 bytes per row
+ * - lamports.bin, rent_epoch.bin, data_len.bin, write_version.bin: uint64_t per row
+ * - executable.bin: uint8_t per row
+ * - data_offset.bin: uint64_t per row plus one, start of each row in data.bin
+ * - data.bin: account data of all rows, back to back (optional)
+ * - columns.meta: ColumnFileHeader, written last; its presence marks a complete export
+ *
+ * Scans over one field then stream a dense array instead of chasing
+ * per-account objects.
+ *
+ * Usage:
+ * @code
+ *   limcode::snapshot::export_snapshot_columns("snapshot.tar.zst", "columns/");
+ *
+ *   limcode::snapshot::AccountColumns columns;
+ *   columns.open("columns/");
+ *   uint64_t total = columns.total_lamports();
+ *   for (const auto& [owner, stats] : columns.totals_by_owner()) { ... }
+ * @endcode
+ */
+
+#include "limcode/limcode.h"
+#include "limcode/snapshot.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace limcode {
+namespace snapshot {
+
+/// columns.meta (64 bytes)
+struct ColumnFileHeader {
+    char magic[8];              // "LIMCCOL1"
+    uint32_t version;
+    uint32_t flags;             // COLUMN_FLAG_*
+    uint64_t row_count;
+    uint64_t data_bytes;        // Size of data.bin
+    uint64_t reserved[4];
+};
+
+static_assert(sizeof(ColumnFileHeader) == 64, "ColumnFileHeader must be 64 bytes");
+
+constexpr uint32_t ACCOUNT_COLUMNS_VERSION = 1;
+constexpr uint32_t COLUMN_FLAG_HAS_DATA = 1;   // data_offset.bin and data.bin are present
+
+/// Writes a column directory from account batches
+///
+/// Thread-safe: add_batch() may be called concurrently from parser threads.
+/// Each batch is transposed into per-column blocks without the lock, then
+/// appended to every column file under it, so rows stay aligned across
+/// columns. Row order follows batch arrival.
+class AccountColumnsBuilder {
+public:
+    /// @param dir Output directory (created if missing)
+    /// @param include_data Also write data_offset.bin and data.bin
+    explicit AccountColumnsBuilder(std::string dir, bool include_data = true);
+    ~AccountColumnsBuilder();
+
+    AccountColumnsBuilder(const AccountColumnsBuilder&) = delete;
+    AccountColumnsBuilder& operator=(const AccountColumnsBuilder&) = delete;
+
+    /// Append one batch of rows
+    /// @return false after an I/O error (later calls keep failing)
+    bool add_batch(std::span<const SnapshotAccountView> batch);
+
+    /// Batch callback feeding this builder (for any stream_* call)
+    AccountBatchCallback callback() {
+        return [this](std::span<const SnapshotAccountView> batch) { return add_batch(batch); };
+    }
+
+    /// Close the column files and write columns.meta
+    ///
+    /// @return Number of rows written, or -1 on I/O error
+    int64_t finish();
+
+private:
+    enum Column { PUBKEY, OWNER, LAMPORTS, RENT_EPOCH, DATA_LEN, WRITE_VERSION, EXECUTABLE,
+                  DATA_OFFSET, DATA, COLUMN_COUNT };
+
+    bool open_locked();
+    void close_files();
+
+    std::string dir_;
+    bool include_data_;
+    std::mutex mutex_;
+    std::array<FILE*, COLUMN_COUNT> files_{};
+    uint64_t rows_ = 0;
+    uint64_t data_bytes_ = 0;
+    bool opened_ = false;
+    bool failed_ = false;
+};
+
+/// Per-owner aggregate from AccountColumns::totals_by_owner
+struct OwnerTotals {
+    uint64_t accounts = 0;
+    uint64_t lamports = 0;
+    uint64_t data_bytes = 0;
+};
+
+/// Read-only, mmap'd view of a column directory
+class AccountColumns {
+public:
+    AccountColumns() = default;
+
+    /// Map and validate a complete column directory
+    ///
+    /// @return false if columns.meta is missing or any column is short
+    bool open(const std::string& dir);
+
+    [[nodiscard]] size_t size() const noexcept { return rows_; }
+    [[nodiscard]] bool has_data() const noexcept { return data_offsets_.size() == rows_ + 1; }
+
+    std::span<const std::array<uint8_t, 32>> pubkeys() const { return pubkeys_; }
+    std::span<const std::array<uint8_t, 32>> owners() const { return owners_; }
+    std::span<const uint64_t> lamports() const { return lamports_; }
+    std::span<const uint64_t> rent_epochs() const { return rent_epochs_; }
+    std::span<const uint64_t> data_lens() const { return data_lens_; }
+    std::span<const uint64_t> write_versions() const { return write_versions_; }
+    std::span<const uint8_t> executable() const { return executable_; }
+
+    /// Account data of row `i` (empty without the data heap)
+    std::span<const uint8_t> data(size_t i) const {
+        if (!has_data()) return {};
+        return heap_.subspan(data_offsets_[i], data_offsets_[i + 1] - data_offsets_[i]);
+    }
+
+    uint64_t total_lamports() const;
+    uint64_t total_data_len() const;
+
+    /// Sum of lamports over rows owned by `owner`
+    uint64_t lamports_owned_by(const std::array<uint8_t, 32>& owner) const;
+
+    /// Group every row by owner, sorted by owner
+    std::vector<std::pair<std::array<uint8_t, 32>, OwnerTotals>> totals_by_owner() const;
+
+private:
+    template <typename T>
+    bool map_column(const std::string& dir, const char* name, size_t count, MappedFile& file,
+                    std::span<const T>& out);
+
+    size_t rows_ = 0;
+    std::array<MappedFile, 9> files_;
+    std::span<const std::array<uint8_t, 32>> pubkeys_;
+    std::span<const std::array<uint8_t, 32>> owners_;
+    std::span<const uint64_t> lamports_;
+    std::span<const uint64_t> rent_epochs_;
+    std::span<const uint64_t> data_lens_;
+    std::span<const uint64_t> write_versions_;
+    std::span<const uint8_t> executable_;
+    std::span<const uint64_t> data_offsets_;
+    std::span<const uint8_t> heap_;
+};
+
+/// Stream a snapshot archive straight into a column directory
+///
+/// Runs stream_snapshot_parallel_batches with an AccountColumnsBuilder as
+/// the callback; options.filter selects which accounts become rows.
+///
+/// @param snapshot_path Path to .tar.zst snapshot archive
+/// @param dir Output column directory
+/// @param options Pipeline options
+/// @param include_data Also write the account data heap
+/// @return Number of rows written, or -1 on error
+int64_t export_snapshot_columns(const std::string& snapshot_path, const std::string& dir,
+                                const ParallelStreamOptions& options = {},
+                                bool include_data = true);
+
+} // namespace snapshot
+} // namespace limcode
@@ -0,0 +1,159 @@
+#pragma once
+
+/**
+ * @file snapshot_filter.h
+ * @brief Account predicates evaluated on the AppendVecHeader during a scan
+ *
+ * An AccountFilter is checked against each record header before a view is
+ * built, so accounts that don't match are never copied, batched or handed
+ * to the callback, and their data bytes are never touched. Cheap bounds
+ * (data_len, lamports, executable) are tested first; owner and pubkey
+ * tests compare the 32-byte keys with SSE2/AVX2 straight from the header.
+ *
+ * Usage:
+ * @code
+ *   limcode::snapshot::AccountFilter filter;
+ *   filter.owners.push_back(spl_token_program_id);
+ *   filter.min_data_len = filter.max_data_len = 165;   // token accounts
+ *
+ *   limcode::snapshot::ParallelStreamOptions options;
+ *   options.filter = &filter;
+ *   stream_snapshot_parallel_batches(path, on_batch, options);
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+#include <limcode/snapshot.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace limcode {
+namespace snapshot {
+
+namespace detail {
+
+/// Index of the first byte where two 32-byte keys differ, or 32 if equal
+LIMCODE_ALWAYS_INLINE unsigned key32_first_difference(const uint8_t* a, const uint8_t* b) {
+#if defined(__AVX2__)
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+    uint32_t equal = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+#elif LIMCODE_HAS_SSE2
+    __m128i lo = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+    __m128i hi = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 16)),
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 16)));
+    uint32_t equal = static_cast<uint32_t>(_mm_movemask_epi8(lo)) |
+                     (static_cast<uint32_t>(_mm_movemask_epi8(hi)) << 16);
+#else
+    for (unsigned i = 0; i < 32; ++i) {
+        if (a[i] != b[i]) return i;
+    }
+    return 32;
+#endif
+#if defined(__AVX2__) || LIMCODE_HAS_SSE2
+    return equal == 0xFFFFFFFFu ? 32 : static_cast<unsigned>(__builtin_ctz(~equal));
+#endif
+}
+
+LIMCODE_ALWAYS_INLINE bool key32_equal(const uint8_t* a, const uint8_t* b) {
+    return key32_first_difference(a, b) == 32;
+}
+
+/// memcmp order over 32-byte keys: negative, zero or positive
+LIMCODE_ALWAYS_INLINE int key32_compare(const uint8_t* a, const uint8_t* b) {
+    unsigned i = key32_first_difference(a, b);
+    return i == 32 ? 0 : static_cast<int>(a[i]) - static_cast<int>(b[i]);
+}
+
+} // namespace detail
+
+/// Inclusive pubkey range [first, last] in byte order
+struct PubkeyRange {
+    std::array<uint8_t, 32> first{};
+    std::array<uint8_t, 32> last{};
+};
+
+/// Conjunction of account predicates; an empty filter matches everything
+///
+/// Owner and pubkey-range lists are scanned linearly, which suits the
+/// handful of programs or ranges a job usually selects.
+struct AccountFilter {
+    std::vector<std::array<uint8_t, 32>> owners;   ///< Owner is one of these (empty = any)
+    std::vector<PubkeyRange> pubkey_ranges;        ///< Pubkey is in one of these (empty = any)
+    uint64_t min_data_len = 0;
+    uint64_t max_data_len = std::numeric_limits<uint64_t>::max();
+    uint64_t min_lamports = 0;
+    uint64_t max_lamports = std::numeric_limits<uint64_t>::max();
+    std::optional<bool> executable;                ///< Unset = either
+
+    /// Select a single pubkey (adds the one-element range)
+    void add_pubkey(const std::array<uint8_t, 32>& pubkey) {
+        pubkey_ranges.push_back({pubkey, pubkey});
+    }
+
+    bool matches(const AppendVecHeader& header) const {
+        if (header.data_len < min_data_len || header.data_len > max_data_len ||
+            header.lamports < min_lamports || header.lamports > max_lamports) {
+            return false;
+        }
+        if (executable && (header.executable != 0) != *executable) {
+            return false;
+        }
+        if (!owners.empty() && !matches_owner(header.owner)) {
+            return false;
+        }
+        return pubkey_ranges.empty() || matches_pubkey(header.pubkey);
+    }
+
+    bool matches_owner(const uint8_t* owner) const {
+        for (const auto& candidate : owners) {
+            if (detail::key32_equal(owner, candidate.data())) return true;
+        }
+        return false;
+    }
+
+    bool matches_pubkey(const uint8_t* pubkey) const {
+        for (const auto& range : pubkey_ranges) {
+            if (detail::key32_compare(pubkey, range.first.data()) >= 0 &&
+                detail::key32_compare(pubkey, range.last.data()) <= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/// for_each_account_view restricted to records matching `filter`
+///
+/// Non-matching records are stepped over from their header alone. A null
+/// filter visits every record.
+///
+/// @return Number of matching accounts visited (the one that returned false is not counted)
+template <typename Callback>
+inline size_t for_each_matching_view(const uint8_t* data, size_t size, const AccountFilter* filter,
+                                     Callback&& callback) {
+    if (!filter) {
+        return for_each_account_view(data, size, callback);
+    }
+    size_t matched = 0;
+    for_each_account_view(data, size, [&](const SnapshotAccountView& view) {
+        if (!filter->matches(*view.header)) {
+            return true;
+        }
+        if (!callback(view)) {
+            return false;
+        }
+        matched++;
+        return true;
+    });
+    return matched;
+}
+
+} // namespace snapshot
+} // namespace limcode
@@ -0,0 +1,171 @@
+#pragma once
+
+/**
+ * @file snapshot_hash.h
+ * @brief Commutative (lattice) accounts hash computed during a snapshot scan
+ *
+ * Each account with nonzero lamports maps to an LtHash: the first 2048
+ * bytes of the BLAKE3 output stream over its lamports, data, executable
+ * flag, owner and pubkey, read as 1024 u16 lanes. This is agave's accounts
+ * lattice hash, so checksum() is comparable with a bank's. The accounts
+ * hash is the lane-wise sum (mod 2^16), so it doesn't depend on the order
+ * accounts are visited in. Parser threads each keep a partial sum and add
+ * it into the shared AccountsHasher once, when they finish. Verifying a
+ * snapshot then costs no second pass over its accounts. Updates are
+ * incremental as well: mix_out() the old version of an account and
+ * mix_in() the new one.
+ *
+ * What the sum covers depends on the scan (see
+ * ParallelStreamOptions::accounts_hasher). stream_merged_snapshot() mixes
+ * in the newest version of every pubkey, which is the bank's accounts
+ * hash. The archive and cache scans mix in every record they deliver,
+ * stale versions included: a digest of the raw storages, equal to the
+ * bank's only when no pubkey is stored twice.
+ *
+ * Usage:
+ * @code
+ *   limcode::snapshot::AccountsHasher hasher;
+ *   limcode::snapshot::ParallelStreamOptions options;
+ *   options.accounts_hasher = &hasher;
+ *   stream_merged_snapshot(full, full_cache, incr, incr_cache, on_batch, options);
+ *   bool ok = hasher.checksum() == expected_checksum;
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+#include <limcode/snapshot.h>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+namespace limcode {
+namespace snapshot {
+
+/// Lattice hash: 1024 u16 lanes, combined by lane-wise wrapping addition
+struct LtHash {
+    static constexpr size_t NUM_LANES = 1024;
+    static constexpr size_t NUM_BYTES = NUM_LANES * sizeof(uint16_t);
+
+    std::array<uint16_t, NUM_LANES> lanes{};
+
+    void mix_in(const LtHash& other) {
+        for (size_t i = 0; i < NUM_LANES; ++i) {
+            lanes[i] = static_cast<uint16_t>(lanes[i] + other.lanes[i]);
+        }
+    }
+
+    void mix_out(const LtHash& other) {
+        for (size_t i = 0; i < NUM_LANES; ++i) {
+            lanes[i] = static_cast<uint16_t>(lanes[i] - other.lanes[i]);
+        }
+    }
+
+    bool is_identity() const {
+        for (uint16_t lane : lanes) {
+            if (lane != 0) return false;
+        }
+        return true;
+    }
+
+    /// BLAKE3 of the lanes (little-endian u16 each), as agave's checksum()
+    Blake3::Digest checksum() const {
+        static_assert(sizeof(lanes) == NUM_BYTES);
+        return Blake3::compute({reinterpret_cast<const uint8_t*>(lanes.data()), NUM_BYTES});
+    }
+
+    bool operator==(const LtHash&) const = default;
+};
+
+/// Lattice element of one account; the identity for zero-lamport accounts
+inline LtHash account_lt_hash(const SnapshotAccountView& view) {
+    LtHash element;
+    if (view.lamports() == 0) {
+        return element;
+    }
+    uint64_t lamports = view.lamports();
+    uint8_t executable = view.executable() ? 1 : 0;
+
+    Blake3 hasher;
+    hasher.update({reinterpret_cast<const uint8_t*>(&lamports), sizeof(lamports)});
+    hasher.update(view.data);
+    hasher.update({&executable, 1});
+    hasher.update(view.owner());
+    hasher.update(view.pubkey());
+    hasher.finish_xof({reinterpret_cast<uint8_t*>(element.lanes.data()), LtHash::NUM_BYTES});
+    return element;
+}
+
+/// Accounts hash accumulated from parser threads
+///
+/// Thread-safe: mix_in() may be called concurrently. Parser threads use a
+/// Partial and touch the shared sum once each.
+class AccountsHasher {
+public:
+    /// Per-thread partial sum
+    ///
+    /// Not thread-safe; flushes into the hasher when destroyed. A null
+    /// hasher makes add() a no-op, so scans can create one unconditionally.
+    class Partial {
+    public:
+        explicit Partial(AccountsHasher* hasher) : hasher_(hasher) {}
+        ~Partial() { flush(); }
+
+        Partial(const Partial&) = delete;
+        Partial& operator=(const Partial&) = delete;
+
+        void add(const SnapshotAccountView& view) {
+            if (!hasher_ || view.lamports() == 0) return;
+            sum_.mix_in(account_lt_hash(view));
+            accounts_++;
+        }
+
+        void flush() {
+            if (hasher_ && accounts_ != 0) {
+                hasher_->mix_in(sum_, accounts_);
+                sum_ = LtHash{};
+                accounts_ = 0;
+            }
+        }
+
+    private:
+        AccountsHasher* hasher_;
+        LtHash sum_;
+        uint64_t accounts_ = 0;
+    };
+
+    /// Add a partial sum covering `accounts` accounts
+    void mix_in(const LtHash& partial, uint64_t accounts) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sum_.mix_in(partial);
+        accounts_ += accounts;
+    }
+
+    LtHash value() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sum_;
+    }
+
+    Blake3::Digest checksum() const { return value().checksum(); }
+
+    /// Accounts mixed in so far (zero-lamport accounts are not counted)
+    uint64_t accounts() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return accounts_;
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sum_ = LtHash{};
+        accounts_ = 0;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    LtHash sum_;
+    uint64_t accounts_ = 0;
+};
+
+} // namespace snapshot
+} // namespace limcode
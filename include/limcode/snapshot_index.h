@@ -0,0 +1,182 @@
+#pragma once
+
+#include "limcode/limcode.h"
+#include "limcode/snapshot.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace limcode {
+namespace snapshot {
+
+/// One account location in an unpacked snapshot (64 bytes)
+///
+/// Points at the AppendVecHeader of the newest version of `pubkey`, inside
+/// the AppendVec file accounts/SLOT.ID.
+struct AccountIndexEntry {
+    uint8_t pubkey[32];
+    uint64_t slot;              // AppendVec slot (from accounts/SLOT.ID)
+    uint64_t appendvec_id;      // AppendVec id (from accounts/SLOT.ID)
+    uint64_t offset;            // Byte offset of the AppendVecHeader in that file
+    uint64_t write_version;
+};
+
+static_assert(sizeof(AccountIndexEntry) == 64, "AccountIndexEntry must be 64 bytes");
+
+/// On-disk index file header (64 bytes)
+///
+/// File layout:
+/// - AccountIndexFileHeader
+/// - uint64_t fanout[65537]: fanout[p] = first entry whose 2-byte pubkey prefix >= p
+/// - AccountIndexEntry entries[entry_count], sorted by pubkey, one per pubkey
+struct AccountIndexFileHeader {
+    char magic[8];              // "LIMCIDX1"
+    uint32_t version;
+    uint32_t entry_size;
+    uint64_t entry_count;
+    uint64_t source_stamp[4];   // Caller-defined identity of the inputs (see set_source_stamp)
+    uint64_t reserved;
+};
+
+static_assert(sizeof(AccountIndexFileHeader) == 64, "AccountIndexFileHeader must be 64 bytes");
+
+constexpr uint32_t ACCOUNT_INDEX_VERSION = 1;
+constexpr size_t ACCOUNT_INDEX_FANOUT = 65536;
+
+/// Parse "accounts/SLOT.ID" (or a bare "SLOT.ID") into slot and id
+///
+/// @return true if the name has the expected form
+bool parse_appendvec_name(const char* name, uint64_t& slot, uint64_t& appendvec_id);
+
+/// Builds an AccountIndex file from accounts seen during a snapshot pass
+///
+/// Thread-safe: add() may be called concurrently from parser threads.
+/// Entries are buffered in memory up to `run_capacity`, then sorted and
+/// spilled to a temporary run file next to the output by the thread that
+/// filled the buffer, without holding the builder lock. finish(), called once
+/// every add() has returned, merges the runs, keeping the newest
+/// (slot, write_version, offset) per pubkey.
+class AccountIndexBuilder {
+public:
+    /// @param index_path Output index file path
+    /// @param run_capacity Entries buffered in memory before a sorted spill
+    ///        (64 bytes each: the default buffers 64 MiB per spilling thread)
+    explicit AccountIndexBuilder(std::string index_path, size_t run_capacity = size_t(1) << 20);
+    ~AccountIndexBuilder();
+
+    AccountIndexBuilder(const AccountIndexBuilder&) = delete;
+    AccountIndexBuilder& operator=(const AccountIndexBuilder&) = delete;
+
+    /// Per-AppendVec entry collector for one parser thread
+    ///
+    /// Not thread-safe; buffers locally and flushes into the builder.
+    class Collector {
+    public:
+        Collector(AccountIndexBuilder* builder, uint64_t slot, uint64_t appendvec_id, const uint8_t* base)
+            : builder_(builder), slot_(slot), appendvec_id_(appendvec_id), base_(base) {}
+        ~Collector() { flush(); }
+
+        Collector(const Collector&) = delete;
+        Collector& operator=(const Collector&) = delete;
+
+        void add(const SnapshotAccountView& view) {
+            if (!builder_) return;
+            AccountIndexEntry& entry = local_.emplace_back();
+            std::memcpy(entry.pubkey, view.header->pubkey, 32);
+            entry.slot = slot_;
+            entry.appendvec_id = appendvec_id_;
+            entry.offset = static_cast<uint64_t>(reinterpret_cast<const uint8_t*>(view.header) - base_);
+            entry.write_version = view.header->write_version;
+            if (local_.size() >= 4096) flush();
+        }
+
+        void flush() {
+            if (builder_ && !local_.empty()) {
+                builder_->add(local_);
+                local_.clear();
+            }
+        }
+
+    private:
+        AccountIndexBuilder* builder_;
+        uint64_t slot_;
+        uint64_t appendvec_id_;
+        const uint8_t* base_;
+        std::vector<AccountIndexEntry> local_;
+    };
+
+    /// Add every account of one AppendVec buffer
+    void add_appendvec(uint64_t slot, uint64_t appendvec_id, const uint8_t* data, size_t size);
+
+    /// Add pre-built entries
+    void add(std::span<const AccountIndexEntry> entries);
+
+    /// Record what the index was built from, for AccountIndex::source_stamp()
+    /// (stream_merged_snapshot stores both caches' archive size and mtime)
+    void set_source_stamp(const std::array<uint64_t, 4>& stamp) { source_stamp_ = stamp; }
+
+    /// Merge all runs and write the index file
+    ///
+    /// The file is written as `index_path.tmp`, synced and renamed into place,
+    /// so a failed or interrupted finish() leaves no index behind.
+    ///
+    /// @return Number of unique pubkeys written, or -1 on I/O error
+    int64_t finish();
+
+private:
+    static bool spill(std::vector<AccountIndexEntry>& run, const std::string& run_path);
+
+    std::string index_path_;
+    size_t run_capacity_;
+    std::mutex mutex_;
+    std::vector<AccountIndexEntry> pending_;
+    std::vector<std::string> run_paths_;
+    std::array<uint64_t, 4> source_stamp_{};
+    bool failed_ = false;
+};
+
+/// Read-only, mmap'd view of an AccountIndex file
+class AccountIndex {
+public:
+    AccountIndex() = default;
+
+    /// Map and validate an index file
+    ///
+    /// @return false if the file is missing, truncated or has a bad header
+    bool open(const std::string& index_path);
+
+    /// Look up the newest location of `pubkey`
+    ///
+    /// @return Pointer into the mapping, or nullptr if not present
+    const AccountIndexEntry* find(const uint8_t* pubkey) const;
+
+    const AccountIndexEntry* find(const std::array<uint8_t, 32>& pubkey) const {
+        return find(pubkey.data());
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return entry_count_; }
+    [[nodiscard]] bool is_open() const noexcept { return fanout_ != nullptr; }
+
+    /// The builder's set_source_stamp() value (all zero if it never set one)
+    [[nodiscard]] const std::array<uint64_t, 4>& source_stamp() const noexcept { return source_stamp_; }
+
+    /// All entries, sorted by pubkey
+    [[nodiscard]] std::span<const AccountIndexEntry> entries() const noexcept {
+        return {entries_, entry_count_};
+    }
+
+private:
+    MappedFile file_;
+    const uint64_t* fanout_ = nullptr;
+    const AccountIndexEntry* entries_ = nullptr;
+    size_t entry_count_ = 0;
+    std::array<uint64_t, 4> source_stamp_{};
+};
+
+} // namespace snapshot
+} // namespace limcode
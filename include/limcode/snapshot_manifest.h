@@ -0,0 +1,481 @@
+#pragma once
+
+/**
+ * @file snapshot_manifest.h
+ * @brief Decoder for the bank manifest (snapshots/SLOT/SLOT) of a snapshot archive
+ *
+ * The manifest is the bincode serialization of the bank fields followed by
+ * the accounts-db fields. The accounts-db part lists every AppendVec storage
+ * as (slot, id, current_len): bytes past current_len in accounts/SLOT.ID are
+ * stale and must not be parsed. Layout follows the Agave snapshot format
+ * (version 1.2.0):
+ *
+ * - Bank fields: blockhash queue, ancestors, hashes, counters, fee / rent /
+ *   epoch / inflation parameters, stakes, epoch stakes, is_delta
+ * - AccountsDb fields: storages by slot, write version, slot, bank hash
+ *   info, historical roots
+ * - Optional trailing fields: lamports_per_signature, incremental snapshot
+ *   persistence, epoch accounts hash (older snapshots end before them;
+ *   later additions are ignored)
+ *
+ * Stakes and epoch stakes are walked over, not kept. serialize_manifest()
+ * writes the same layout back (see its note on the skipped fields).
+ *
+ * Usage:
+ * @code
+ *   auto manifest = limcode::snapshot::deserialize_manifest(bytes);
+ *   for (const auto& storage : manifest.storages) {
+ *       schedule(storage.slot, storage.id, storage.current_len);
+ *   }
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace limcode {
+namespace snapshot {
+
+/// One accounts/SLOT.ID storage as recorded in the manifest
+struct AccountStorageInfo {
+    uint64_t slot = 0;
+    uint64_t id = 0;
+    uint64_t current_len = 0;   // Valid bytes; anything past this is stale
+
+    bool operator==(const AccountStorageInfo&) const = default;
+};
+
+struct ManifestEpochSchedule {
+    uint64_t slots_per_epoch = 0;
+    uint64_t leader_schedule_slot_offset = 0;
+    bool warmup = false;
+    uint64_t first_normal_epoch = 0;
+    uint64_t first_normal_slot = 0;
+};
+
+struct BankHashStats {
+    uint64_t num_updated_accounts = 0;
+    uint64_t num_removed_accounts = 0;
+    uint64_t num_lamports_stored = 0;
+    uint64_t total_data_len = 0;
+    uint64_t num_executable_accounts = 0;
+};
+
+/// Full snapshot an incremental snapshot was taken against
+struct IncrementalSnapshotPersistence {
+    uint64_t full_slot = 0;
+    std::array<uint8_t, 32> full_hash{};
+    uint64_t full_capitalization = 0;
+    std::array<uint8_t, 32> incremental_hash{};
+    uint64_t incremental_capitalization = 0;
+};
+
+/// Decoded bank manifest
+struct SnapshotManifest {
+    // Bank fields
+    uint64_t slot = 0;
+    uint64_t parent_slot = 0;
+    uint64_t epoch = 0;
+    uint64_t block_height = 0;
+    std::array<uint8_t, 32> bank_hash{};
+    std::array<uint8_t, 32> parent_hash{};
+    std::vector<uint64_t> ancestors;                        // Slots
+    std::vector<std::pair<uint64_t, uint64_t>> hard_forks;  // (slot, count)
+    uint64_t transaction_count = 0;
+    uint64_t tick_height = 0;
+    uint64_t signature_count = 0;
+    uint64_t capitalization = 0;
+    uint64_t max_tick_height = 0;
+    std::optional<uint64_t> hashes_per_tick;
+    uint64_t ticks_per_slot = 0;
+    uint64_t ns_per_slot = 0;   // Serialized as u128; the high half is always 0 in practice
+    int64_t genesis_creation_time = 0;
+    double slots_per_year = 0;
+    uint64_t accounts_data_len = 0;
+    std::array<uint8_t, 32> collector_id{};
+    uint64_t collector_fees = 0;
+    uint64_t collected_rent = 0;
+    ManifestEpochSchedule epoch_schedule;
+    bool is_delta = false;
+
+    // AccountsDb fields
+    std::vector<AccountStorageInfo> storages;   // Sorted by (slot, id)
+    uint64_t write_version = 0;
+    uint64_t accounts_slot = 0;
+    std::array<uint8_t, 32> accounts_delta_hash{};
+    std::array<uint8_t, 32> accounts_hash{};
+    BankHashStats bank_hash_stats;
+    std::vector<uint64_t> historical_roots;
+    std::vector<std::pair<uint64_t, std::array<uint8_t, 32>>> historical_roots_with_hash;
+
+    // Trailing fields (absent in older snapshots)
+    uint64_t lamports_per_signature = 0;
+    std::optional<IncrementalSnapshotPersistence> incremental_persistence;
+    std::optional<std::array<uint8_t, 32>> epoch_accounts_hash;
+
+    /// Storage entry for accounts/SLOT.ID, or nullptr if the manifest doesn't list it
+    const AccountStorageInfo* find_storage(uint64_t storage_slot, uint64_t id) const {
+        auto it = std::lower_bound(storages.begin(), storages.end(), std::make_pair(storage_slot, id),
+                                   [](const AccountStorageInfo& s, const std::pair<uint64_t, uint64_t>& key) {
+                                       return std::make_pair(s.slot, s.id) < key;
+                                   });
+        return it != storages.end() && it->slot == storage_slot && it->id == id ? &*it : nullptr;
+    }
+
+    /// Sum of current_len over all storages
+    uint64_t total_storage_bytes() const {
+        uint64_t total = 0;
+        for (const auto& storage : storages) {
+            total += storage.current_len;
+        }
+        return total;
+    }
+};
+
+namespace detail {
+
+/// bincode collection length, rejecting counts the input can't hold
+inline size_t read_manifest_len(LimcodeDecoder& d, size_t min_element_size) {
+    uint64_t count = d.read_u64();
+    if (min_element_size > 0 && count > d.remaining() / min_element_size) {
+        throw LimcodeError::invalid_encoding("Manifest collection length exceeds input size");
+    }
+    return static_cast<size_t>(count);
+}
+
+/// bincode Option tag: false for None, true for Some
+inline bool read_manifest_option(LimcodeDecoder& d) {
+    uint8_t tag = d.read_u8();
+    if (tag > 1) {
+        throw LimcodeError::invalid_encoding("Invalid Option tag in manifest");
+    }
+    return tag == 1;
+}
+
+/// Stakes<Delegation>: vote accounts, stake delegations, unused, epoch, stake history
+inline void skip_manifest_stakes(LimcodeDecoder& d) {
+    constexpr size_t VOTE_ACCOUNT_MIN = 32 + 8 + 8 + 8 + 32 + 1 + 8;
+    size_t vote_accounts = read_manifest_len(d, VOTE_ACCOUNT_MIN);
+    for (size_t i = 0; i < vote_accounts; ++i) {
+        d.skip(32 + 8 + 8);   // pubkey, stake, account lamports
+        d.skip(read_manifest_len(d, 1));
+        d.skip(32 + 1 + 8);   // owner, executable, rent_epoch
+    }
+    d.skip(read_manifest_len(d, 32 + 64) * (32 + 64));   // pubkey -> Delegation
+    d.skip(8 + 8);                                       // unused, epoch
+    d.skip(read_manifest_len(d, 32) * 32);               // (epoch, StakeHistoryEntry)
+}
+
+inline void skip_manifest_epoch_stakes(LimcodeDecoder& d) {
+    size_t epochs = read_manifest_len(d, 8);
+    for (size_t i = 0; i < epochs; ++i) {
+        d.skip(8);   // epoch
+        skip_manifest_stakes(d);
+        d.skip(8);   // total_stake
+        size_t nodes = read_manifest_len(d, 32 + 8 + 8);
+        for (size_t n = 0; n < nodes; ++n) {
+            d.skip(32);
+            d.skip(read_manifest_len(d, 32) * 32);
+            d.skip(8);
+        }
+        d.skip(read_manifest_len(d, 64) * 64);   // epoch_authorized_voters
+    }
+}
+
+inline std::array<uint8_t, 32> read_manifest_hash(LimcodeDecoder& d) {
+    return d.read_pod_array<32>();
+}
+
+} // namespace detail
+
+/// Decode a bank manifest
+///
+/// @param data Contents of snapshots/SLOT/SLOT
+/// @return Decoded manifest; storages sorted by (slot, id)
+/// @throws LimcodeError on truncated or malformed input
+inline SnapshotManifest deserialize_manifest(std::span<const uint8_t> data) {
+    using namespace detail;
+    LimcodeDecoder d(data.data(), data.size());
+    SnapshotManifest m;
+
+    // Blockhash queue: last_hash_index, last_hash, ages (hash -> HashInfo), max_age
+    d.skip(8);
+    if (read_manifest_option(d)) {
+        d.skip(32);
+    }
+    d.skip(read_manifest_len(d, 32 + 24) * (32 + 24));
+    d.skip(8);
+
+    size_t num_ancestors = read_manifest_len(d, 16);
+    m.ancestors.reserve(num_ancestors);
+    for (size_t i = 0; i < num_ancestors; ++i) {
+        m.ancestors.push_back(d.read_u64());
+        d.skip(8);
+    }
+    std::sort(m.ancestors.begin(), m.ancestors.end());
+
+    m.bank_hash = read_manifest_hash(d);
+    m.parent_hash = read_manifest_hash(d);
+    m.parent_slot = d.read_u64();
+    size_t num_hard_forks = read_manifest_len(d, 16);
+    for (size_t i = 0; i < num_hard_forks; ++i) {
+        uint64_t fork_slot = d.read_u64();
+        m.hard_forks.emplace_back(fork_slot, d.read_u64());
+    }
+
+    m.transaction_count = d.read_u64();
+    m.tick_height = d.read_u64();
+    m.signature_count = d.read_u64();
+    m.capitalization = d.read_u64();
+    m.max_tick_height = d.read_u64();
+    if (read_manifest_option(d)) {
+        m.hashes_per_tick = d.read_u64();
+    }
+    m.ticks_per_slot = d.read_u64();
+    m.ns_per_slot = d.read_u64();
+    d.skip(8);   // ns_per_slot high half
+    m.genesis_creation_time = d.read_i64();
+    m.slots_per_year = d.read_pod<double>();
+    m.accounts_data_len = d.read_u64();
+    m.slot = d.read_u64();
+    m.epoch = d.read_u64();
+    m.block_height = d.read_u64();
+    m.collector_id = read_manifest_hash(d);
+    m.collector_fees = d.read_u64();
+    d.skip(8);              // fee_calculator
+    d.skip(4 * 8 + 1);      // fee_rate_governor
+    m.collected_rent = d.read_u64();
+    d.skip(8 + 33 + 8 + 17);   // rent_collector: epoch, schedule, slots_per_year, rent
+
+    m.epoch_schedule.slots_per_epoch = d.read_u64();
+    m.epoch_schedule.leader_schedule_slot_offset = d.read_u64();
+    m.epoch_schedule.warmup = d.read_bool();
+    m.epoch_schedule.first_normal_epoch = d.read_u64();
+    m.epoch_schedule.first_normal_slot = d.read_u64();
+
+    d.skip(6 * 8);   // inflation
+    skip_manifest_stakes(d);
+    d.skip(read_manifest_len(d, 32) * 32);   // unused_accounts
+    d.skip(read_manifest_len(d, 32) * 32);
+    d.skip(read_manifest_len(d, 40) * 40);
+    skip_manifest_epoch_stakes(d);
+    m.is_delta = d.read_bool();
+
+    // AccountsDb fields: slot -> Vec<(id, current_len)>
+    size_t num_slots = read_manifest_len(d, 16);
+    for (size_t i = 0; i < num_slots; ++i) {
+        uint64_t storage_slot = d.read_u64();
+        size_t count = read_manifest_len(d, 16);
+        for (size_t k = 0; k < count; ++k) {
+            AccountStorageInfo storage;
+            storage.slot = storage_slot;
+            storage.id = d.read_u64();
+            storage.current_len = d.read_u64();
+            m.storages.push_back(storage);
+        }
+    }
+    std::sort(m.storages.begin(), m.storages.end(),
+              [](const AccountStorageInfo& a, const AccountStorageInfo& b) {
+                  return a.slot != b.slot ? a.slot < b.slot : a.id < b.id;
+              });
+
+    m.write_version = d.read_u64();
+    m.accounts_slot = d.read_u64();
+    m.accounts_delta_hash = read_manifest_hash(d);
+    m.accounts_hash = read_manifest_hash(d);
+    m.bank_hash_stats = d.read_pod<BankHashStats>();
+    size_t num_roots = read_manifest_len(d, 8);
+    m.historical_roots.reserve(num_roots);
+    for (size_t i = 0; i < num_roots; ++i) {
+        m.historical_roots.push_back(d.read_u64());
+    }
+    size_t num_roots_with_hash = read_manifest_len(d, 40);
+    for (size_t i = 0; i < num_roots_with_hash; ++i) {
+        uint64_t root = d.read_u64();
+        m.historical_roots_with_hash.emplace_back(root, read_manifest_hash(d));
+    }
+
+    // Trailing fields were appended over time; each is absent in older snapshots
+    if (d.remaining() < 8) {
+        return m;
+    }
+    m.lamports_per_signature = d.read_u64();
+    if (!d.has_remaining()) {
+        return m;
+    }
+    if (read_manifest_option(d)) {
+        IncrementalSnapshotPersistence inc;
+        inc.full_slot = d.read_u64();
+        inc.full_hash = read_manifest_hash(d);
+        inc.full_capitalization = d.read_u64();
+        inc.incremental_hash = read_manifest_hash(d);
+        inc.incremental_capitalization = d.read_u64();
+        m.incremental_persistence = inc;
+    }
+    if (!d.has_remaining()) {
+        return m;
+    }
+    if (read_manifest_option(d)) {
+        m.epoch_accounts_hash = read_manifest_hash(d);
+    }
+    return m;
+}
+
+/// Encode a manifest in the layout deserialize_manifest() reads
+///
+/// Fields the decoder skips (blockhash queue ages, fee / rent / inflation
+/// parameters, stakes, epoch stakes) are written empty or zeroed, so the
+/// result round-trips through deserialize_manifest() but is not a complete
+/// bank for a validator to boot from.
+///
+/// @param m Manifest; storages must be sorted by (slot, id)
+inline std::vector<uint8_t> serialize_manifest(const SnapshotManifest& m) {
+    LimcodeEncoder e(4096 + m.storages.size() * 16);
+
+    e.write_u64(0);    // blockhash queue: last_hash_index
+    e.write_u8(0);     // last_hash: None
+    e.write_u64(0);    // ages
+    e.write_u64(0);    // max_age
+    e.write_u64(m.ancestors.size());
+    for (uint64_t ancestor : m.ancestors) {
+        e.write_u64(ancestor);
+        e.write_u64(0);
+    }
+    e.write_pod(m.bank_hash);
+    e.write_pod(m.parent_hash);
+    e.write_u64(m.parent_slot);
+    e.write_u64(m.hard_forks.size());
+    for (const auto& [fork_slot, count] : m.hard_forks) {
+        e.write_u64(fork_slot);
+        e.write_u64(count);
+    }
+    e.write_u64(m.transaction_count);
+    e.write_u64(m.tick_height);
+    e.write_u64(m.signature_count);
+    e.write_u64(m.capitalization);
+    e.write_u64(m.max_tick_height);
+    e.write_u8(m.hashes_per_tick ? 1 : 0);
+    if (m.hashes_per_tick) {
+        e.write_u64(*m.hashes_per_tick);
+    }
+    e.write_u64(m.ticks_per_slot);
+    e.write_u64(m.ns_per_slot);
+    e.write_u64(0);    // ns_per_slot high half
+    e.write_i64(m.genesis_creation_time);
+    e.write_pod(m.slots_per_year);
+    e.write_u64(m.accounts_data_len);
+    e.write_u64(m.slot);
+    e.write_u64(m.epoch);
+    e.write_u64(m.block_height);
+    e.write_pod(m.collector_id);
+    e.write_u64(m.collector_fees);
+    e.write_u64(m.lamports_per_signature);   // fee_calculator
+    for (int i = 0; i < 4 * 8 + 1; ++i) {
+        e.write_u8(0);                       // fee_rate_governor
+    }
+    e.write_u64(m.collected_rent);
+    for (int i = 0; i < 8 + 33 + 8 + 17; ++i) {
+        e.write_u8(0);                       // rent_collector
+    }
+    e.write_u64(m.epoch_schedule.slots_per_epoch);
+    e.write_u64(m.epoch_schedule.leader_schedule_slot_offset);
+    e.write_bool(m.epoch_schedule.warmup);
+    e.write_u64(m.epoch_schedule.first_normal_epoch);
+    e.write_u64(m.epoch_schedule.first_normal_slot);
+    for (int i = 0; i < 6; ++i) {
+        e.write_u64(0);                      // inflation
+    }
+    e.write_u64(0);          // stakes: vote accounts
+    e.write_u64(0);          // stake delegations
+    e.write_u64(0);          // unused
+    e.write_u64(m.epoch);
+    e.write_u64(0);          // stake history
+    for (int i = 0; i < 3; ++i) {
+        e.write_u64(0);      // unused_accounts
+    }
+    e.write_u64(0);          // epoch stakes
+    e.write_bool(m.is_delta);
+
+    size_t num_slots = 0;
+    for (size_t i = 0; i < m.storages.size(); ++i) {
+        num_slots += i == 0 || m.storages[i].slot != m.storages[i - 1].slot;
+    }
+    e.write_u64(num_slots);
+    for (size_t i = 0; i < m.storages.size();) {
+        size_t end = i;
+        while (end < m.storages.size() && m.storages[end].slot == m.storages[i].slot) {
+            ++end;
+        }
+        e.write_u64(m.storages[i].slot);
+        e.write_u64(end - i);
+        for (; i < end; ++i) {
+            e.write_u64(m.storages[i].id);
+            e.write_u64(m.storages[i].current_len);
+        }
+    }
+    e.write_u64(m.write_version);
+    e.write_u64(m.accounts_slot);
+    e.write_pod(m.accounts_delta_hash);
+    e.write_pod(m.accounts_hash);
+    e.write_pod(m.bank_hash_stats);
+    e.write_u64(m.historical_roots.size());
+    for (uint64_t root : m.historical_roots) {
+        e.write_u64(root);
+    }
+    e.write_u64(m.historical_roots_with_hash.size());
+    for (const auto& [root, hash] : m.historical_roots_with_hash) {
+        e.write_u64(root);
+        e.write_pod(hash);
+    }
+
+    e.write_u64(m.lamports_per_signature);
+    e.write_u8(m.incremental_persistence ? 1 : 0);
+    if (const auto& inc = m.incremental_persistence) {
+        e.write_u64(inc->full_slot);
+        e.write_pod(inc->full_hash);
+        e.write_u64(inc->full_capitalization);
+        e.write_pod(inc->incremental_hash);
+        e.write_u64(inc->incremental_capitalization);
+    }
+    e.write_u8(m.epoch_accounts_hash ? 1 : 0);
+    if (m.epoch_accounts_hash) {
+        e.write_pod(*m.epoch_accounts_hash);
+    }
+    return std::move(e).finish();
+}
+
+/// True for "snapshots/SLOT/SLOT" (the manifest's path inside the archive)
+inline bool is_manifest_path(std::string_view name, uint64_t* slot = nullptr) {
+    constexpr std::string_view prefix = "snapshots/";
+    if (name.substr(0, prefix.size()) != prefix) {
+        return false;
+    }
+    name.remove_prefix(prefix.size());
+    size_t slash = name.find('/');
+    if (slash == 0 || slash == std::string_view::npos || slash > 20 ||
+        name.substr(0, slash) != name.substr(slash + 1)) {
+        return false;
+    }
+    uint64_t value = 0;
+    for (char c : name.substr(0, slash)) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    if (slot) {
+        *slot = value;
+    }
+    return true;
+}
+
+} // namespace snapshot
+} // namespace limcode
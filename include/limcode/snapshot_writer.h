@@ -0,0 +1,211 @@
+#pragma once
+
+/**
+ * @file snapshot_writer.h
+ * @brief Write accounts back out as a Solana snapshot archive (.tar.zst)
+ *
+ * The inverse of the streaming parser: accounts are appended to per-slot
+ * AppendVecs (136-byte AppendVecHeader + data, every record 8-byte aligned),
+ * full AppendVecs are staged to disk, and finish() writes the archive in the
+ * order Agave produces it:
+ *
+ *   version, snapshots/status_cache, snapshots/SLOT/SLOT, accounts/SLOT.ID...
+ *
+ * The manifest's storages list is filled in from the AppendVecs written, so
+ * every current_len matches its file. Compression runs on zstd's worker
+ * threads (ZSTD_c_nbWorkers) while the writer thread feeds it.
+ *
+ * Usage:
+ * @code
+ *   limcode::snapshot::SnapshotWriter writer("snapshot-1000.tar.zst");
+ *   for (const auto& [slot, account] : accounts) {
+ *       writer.add(slot, account);
+ *   }
+ *   limcode::snapshot::SnapshotManifest bank;
+ *   bank.slot = 1000;
+ *   bool ok = writer.finish(std::move(bank));
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+#include <limcode/snapshot.h>
+#include <limcode/snapshot_manifest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace limcode {
+namespace snapshot {
+
+/// One AppendVec being assembled in memory
+///
+/// The buffer comes from huge pages and grows geometrically; account data of
+/// NT_COPY_MIN bytes or more is copied with non-temporal stores, since the
+/// buffer is written out rather than read back.
+class AppendVecBuilder {
+public:
+    static constexpr size_t NT_COPY_MIN = 64 * 1024;
+    static constexpr size_t MIN_CAPACITY = 2 * 1024 * 1024;
+
+    AppendVecBuilder() = default;
+    explicit AppendVecBuilder(size_t initial_capacity) { reserve(initial_capacity); }
+
+    ~AppendVecBuilder() {
+        if (data_) {
+            internal::deallocate_huge_pages(data_);
+        }
+    }
+
+    AppendVecBuilder(AppendVecBuilder&& other) noexcept
+        : data_(other.data_), size_(other.size_), capacity_(other.capacity_), count_(other.count_) {
+        other.data_ = nullptr;
+        other.size_ = other.capacity_ = other.count_ = 0;
+    }
+
+    AppendVecBuilder& operator=(AppendVecBuilder&& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(count_, other.count_);
+        return *this;
+    }
+
+    AppendVecBuilder(const AppendVecBuilder&) = delete;
+    AppendVecBuilder& operator=(const AppendVecBuilder&) = delete;
+
+    /// Bytes one record occupies, alignment padding included
+    static constexpr size_t record_size(size_t data_len) {
+        return (sizeof(AppendVecHeader) + data_len + 7) & ~size_t(7);
+    }
+
+    /// Append a record; header.data_len is overwritten with data.size()
+    void append(const AppendVecHeader& header, std::span<const uint8_t> data) {
+        size_t record = record_size(data.size());
+        reserve(size_ + record);
+
+        uint8_t* out = data_ + size_;
+        std::memcpy(out, &header, sizeof(AppendVecHeader));
+        uint64_t data_len = data.size();
+        std::memcpy(out + offsetof(AppendVecHeader, data_len), &data_len, sizeof(data_len));
+        if (data.size() >= NT_COPY_MIN) {
+            fast_nt_memcpy(out + sizeof(AppendVecHeader), data.data(), data.size());
+        } else if (!data.empty()) {
+            std::memcpy(out + sizeof(AppendVecHeader), data.data(), data.size());
+        }
+        size_t written = sizeof(AppendVecHeader) + data.size();
+        std::memset(out + written, 0, record - written);
+
+        size_ += record;
+        count_++;
+    }
+
+    void append(const SnapshotAccountView& view) {
+        append(*view.header, view.data);
+    }
+
+    void append(const SnapshotAccount& account) {
+        AppendVecHeader header{};
+        header.write_version = account.write_version;
+        std::memcpy(header.pubkey, account.pubkey.data(), 32);
+        header.lamports = account.lamports;
+        header.rent_epoch = account.rent_epoch;
+        std::memcpy(header.owner, account.owner.data(), 32);
+        header.executable = account.executable ? 1 : 0;
+        std::memcpy(header.hash, account.hash.data(), 32);
+        append(header, account.data);
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity <= capacity_) {
+            return;
+        }
+        size_t new_capacity = std::max({capacity, capacity_ * 2, MIN_CAPACITY});
+        auto* grown = static_cast<uint8_t*>(internal::allocate_huge_pages(new_capacity));
+        if (!grown) {
+            throw std::bad_alloc();
+        }
+        if (data_) {
+            if (size_ > 0) {
+                internal::memcpy_simd_large(grown, data_, size_);
+            }
+            internal::deallocate_huge_pages(data_);
+        }
+        data_ = grown;
+        capacity_ = new_capacity;
+    }
+
+    /// Drop the records but keep the buffer
+    void clear() {
+        size_ = 0;
+        count_ = 0;
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }     ///< AppendVec length (the manifest's current_len)
+    size_t count() const { return count_; }   ///< Records appended
+    bool empty() const { return count_ == 0; }
+
+private:
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    size_t count_ = 0;
+};
+
+/// Options for SnapshotWriter
+struct SnapshotWriterOptions {
+    size_t appendvec_size = 0;                  ///< Roll over to a new accounts/SLOT.ID past this size (0 = one per slot)
+    size_t max_open_slots = 64;                 ///< Slots with an AppendVec in memory; the least recent is staged past this
+    int compression_level = 1;                  ///< zstd level
+    unsigned num_threads = 0;                   ///< zstd worker threads (0 = hardware concurrency)
+    std::string staging_dir;                    ///< Finished AppendVecs wait here (default: "<archive>.staging")
+    std::string version = "1.2.0";              ///< Contents of the archive's version file
+};
+
+/// Builds a snapshot archive from a stream of accounts
+///
+/// Not thread-safe: feed it from one thread. Accounts for a slot go into
+/// that slot's open AppendVec; AppendVec ids are unique across the archive.
+/// Feed accounts grouped by slot: a slot that comes back after its AppendVec
+/// was staged gets a second storage, which older validators refuse to load.
+/// Abandoning a writer without finish() removes the staging directory.
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::string archive_path, SnapshotWriterOptions options = {});
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    /// Append one account stored at `slot`
+    /// @return false if a full AppendVec could not be staged
+    bool add(uint64_t slot, const SnapshotAccount& account);
+    bool add(uint64_t slot, const SnapshotAccountView& view);
+    bool add_batch(uint64_t slot, std::span<const SnapshotAccountView> batch);
+
+    /// Stage the open AppendVecs and write the archive
+    ///
+    /// `manifest` supplies the bank fields; its storages are replaced with
+    /// the AppendVecs written, and accounts_slot / write_version default to
+    /// the bank slot / the highest write_version seen when left at 0.
+    ///
+    /// @return true once the archive is complete on disk
+    bool finish(SnapshotManifest manifest);
+
+    uint64_t accounts_written() const;
+    uint64_t appendvecs_written() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace snapshot
+} // namespace limcode
@@ -0,0 +1,477 @@
+#pragma once
+
+/**
+ * @file streaming.h
+ * @brief Resumable, chunk-fed decoder for Entry / VersionedTransaction
+ *
+ * LimcodeDecoder needs the whole message in one contiguous buffer and throws
+ * on underflow. StreamingDecoder instead accepts arbitrary fragments (shred
+ * payloads, TCP reads), returns NeedMoreData when a chunk ends mid-object and
+ * resumes exactly where it stopped on the next chunk. Field bytes are copied
+ * straight from each chunk into the destination objects, so there is no
+ * reassembly buffer.
+ *
+ * Usage:
+ * @code
+ *   StreamingDecoder decoder(StreamingDecoder::Target::Entries);
+ *   for (auto chunk : fragments) {
+ *     std::span<const uint8_t> in = chunk;
+ *     while (true) {
+ *       auto status = decoder.feed(in);
+ *       if (status == StreamStatus::Complete) handle(decoder.take_entry());
+ *       else break; // NeedMoreData, Done or Error
+ *     }
+ *   }
+ * @endcode
+ */
+
+#include <limcode/limcode.h>
+
+namespace limcode {
+
+/**
+ * @brief Result of StreamingDecoder::feed()
+ */
+enum class StreamStatus : uint8_t {
+  Complete,     ///< An object is ready; call take_entry()/take_transaction()
+  NeedMoreData, ///< Input exhausted mid-object; feed the next chunk
+  Done,         ///< Entries target: all entries of the batch were delivered
+  Error,        ///< Malformed input; see error()
+};
+
+/**
+ * @brief Incremental decoder that never throws on short input
+ *
+ * Targets:
+ * - Entry: a stream of back-to-back Entry encodings
+ * - Transaction: a stream of back-to-back VersionedTransaction encodings
+ * - Entries: one bincode Vec<Entry> (u64 length prefix, then entries)
+ */
+class StreamingDecoder {
+public:
+  enum class Target : uint8_t { Entry, Transaction, Entries };
+
+  explicit StreamingDecoder(Target target = Target::Entry) : target_(target) {
+    reset();
+  }
+
+  /**
+   * @brief Consume bytes from `input` until an object completes or it runs out
+   *
+   * `input` is advanced past every consumed byte. After Complete the
+   * remaining bytes are left in `input` for the next call.
+   */
+  StreamStatus feed(std::span<const uint8_t> &input);
+
+  /// Move out the completed entry and start on the next one
+  [[nodiscard]] Entry take_entry() {
+    Entry out = std::move(entry_);
+    entry_ = Entry{};
+    start_next();
+    return out;
+  }
+
+  /// Move out the completed transaction and start on the next one
+  [[nodiscard]] VersionedTransaction take_transaction() {
+    VersionedTransaction out = std::move(tx_storage_);
+    tx_storage_ = VersionedTransaction{};
+    start_next();
+    return out;
+  }
+
+  /// Discard any partial object and start over
+  void reset() {
+    entry_ = Entry{};
+    tx_storage_ = VersionedTransaction{};
+    error_ = nullptr;
+    field_pos_ = 0;
+    short_vec_shift_ = 0;
+    short_vec_value_ = 0;
+    remaining_entries_ = 0;
+    state_ = target_ == Target::Entries ? State::EntriesLen : first_state();
+  }
+
+  /// True while an object has been started but not completed
+  [[nodiscard]] bool in_progress() const noexcept {
+    return state_ != first_state() && state_ != State::Ready &&
+           state_ != State::Finished && state_ != State::Failed &&
+           state_ != State::EntriesLen;
+  }
+
+  /// Entries target: entries still to be delivered
+  [[nodiscard]] uint64_t remaining_entries() const noexcept {
+    return remaining_entries_;
+  }
+
+  /// Description of the last error, or nullptr
+  [[nodiscard]] const char *error() const noexcept { return error_; }
+
+private:
+  enum class State : uint8_t {
+    EntriesLen,
+    EntryNumHashes,
+    EntryHash,
+    EntryTxCount,
+    TxSigCount,
+    TxSigs,
+    MsgFirst,
+    MsgHeaderRest,
+    MsgKeyCount,
+    MsgKeys,
+    MsgBlockhash,
+    MsgIxCount,
+    IxProgram,
+    IxAccCount,
+    IxAccs,
+    IxDataLen,
+    IxData,
+    MsgAtlCount,
+    AtlKey,
+    AtlWritableCount,
+    AtlWritable,
+    AtlReadonlyCount,
+    AtlReadonly,
+    Ready,
+    Finished,
+    Failed,
+  };
+
+  static_assert(sizeof(Signature) == SIGNATURE_BYTES &&
+                    sizeof(Pubkey) == PUBKEY_BYTES,
+                "flat copies assume unpadded key arrays");
+
+  [[nodiscard]] State first_state() const noexcept {
+    return target_ == Target::Transaction ? State::TxSigCount
+                                          : State::EntryNumHashes;
+  }
+
+  /// Copy up to `total - field_pos_` bytes; true once the field is complete
+  bool copy_field(std::span<const uint8_t> &in, uint8_t *dst, size_t total) {
+    size_t want = total - field_pos_;
+    size_t n = want < in.size() ? want : in.size();
+    if (n > 0) {
+      std::memcpy(dst + field_pos_, in.data(), n);
+      in = in.subspan(n);
+      field_pos_ += n;
+    }
+    if (field_pos_ < total) {
+      return false;
+    }
+    field_pos_ = 0;
+    return true;
+  }
+
+  /// Read a ShortVec length byte by byte; true once complete
+  bool read_short_vec(std::span<const uint8_t> &in, uint16_t &out) {
+    while (!in.empty()) {
+      uint8_t byte = in[0];
+      in = in.subspan(1);
+      short_vec_value_ |= static_cast<uint32_t>(byte & 0x7F) << short_vec_shift_;
+      if ((byte & 0x80) == 0) {
+        out = static_cast<uint16_t>(short_vec_value_);
+        short_vec_value_ = 0;
+        short_vec_shift_ = 0;
+        return true;
+      }
+      short_vec_shift_ += 7;
+      if (short_vec_shift_ >= 16) {
+        fail("ShortVec overflow");
+        return false;
+      }
+    }
+    return false;
+  }
+
+  void fail(const char *message) {
+    error_ = message;
+    state_ = State::Failed;
+  }
+
+  /// Transaction finished: next tx in the entry, or the object is complete
+  void finish_transaction() {
+    if (target_ == Target::Transaction || ++tx_index_ == tx_count_) {
+      state_ = State::Ready;
+    } else {
+      begin_transaction();
+    }
+  }
+
+  void begin_transaction() {
+    tx_ = target_ == Target::Transaction ? &tx_storage_
+                                         : &entry_.transactions.emplace_back();
+    state_ = State::TxSigCount;
+  }
+
+  /// Instruction list finished: ATLs for v0, else the transaction is done
+  void finish_instructions() {
+    if (atls_ != nullptr) {
+      state_ = State::MsgAtlCount;
+    } else {
+      finish_transaction();
+    }
+  }
+
+  void start_next() {
+    if (target_ == Target::Entries) {
+      state_ = --remaining_entries_ == 0 ? State::Finished : State::EntryNumHashes;
+    } else {
+      state_ = first_state();
+    }
+  }
+
+  Target target_;
+  State state_ = State::EntryNumHashes;
+  const char *error_ = nullptr;
+
+  // Object under construction
+  Entry entry_;
+  VersionedTransaction tx_storage_;
+  VersionedTransaction *tx_ = nullptr;
+  MessageHeader *header_ = nullptr;
+  std::vector<Pubkey> *keys_ = nullptr;
+  Hash *blockhash_ = nullptr;
+  std::vector<CompiledInstruction> *instructions_ = nullptr;
+  std::vector<AddressTableLookup> *atls_ = nullptr;
+  CompiledInstruction *ix_ = nullptr;
+  AddressTableLookup *atl_ = nullptr;
+
+  // Cursor state
+  size_t tx_count_ = 0;
+  size_t tx_index_ = 0;
+  size_t list_count_ = 0;
+  size_t list_index_ = 0;
+  size_t field_pos_ = 0;
+  uint64_t remaining_entries_ = 0;
+  uint32_t short_vec_value_ = 0;
+  uint8_t short_vec_shift_ = 0;
+  uint8_t scratch_[8] = {};
+};
+
+inline StreamStatus StreamingDecoder::feed(std::span<const uint8_t> &in) {
+  uint16_t len = 0;
+
+  while (true) {
+    switch (state_) {
+    case State::Ready:
+      return StreamStatus::Complete;
+    case State::Finished:
+      return StreamStatus::Done;
+    case State::Failed:
+      return StreamStatus::Error;
+
+    case State::EntriesLen:
+      if (!copy_field(in, scratch_, 8))
+        return StreamStatus::NeedMoreData;
+      std::memcpy(&remaining_entries_, scratch_, 8);
+      state_ = remaining_entries_ == 0 ? State::Finished : State::EntryNumHashes;
+      break;
+
+    // ---- Entry ----
+    case State::EntryNumHashes:
+      if (!copy_field(in, scratch_, 8))
+        return StreamStatus::NeedMoreData;
+      std::memcpy(&entry_.num_hashes, scratch_, 8);
+      state_ = State::EntryHash;
+      break;
+    case State::EntryHash:
+      if (!copy_field(in, entry_.hash.data(), HASH_BYTES))
+        return StreamStatus::NeedMoreData;
+      state_ = State::EntryTxCount;
+      break;
+    case State::EntryTxCount:
+      if (!read_short_vec(in, len))
+        return state_ == State::Failed ? StreamStatus::Error
+                                       : StreamStatus::NeedMoreData;
+      tx_count_ = len;
+      tx_index_ = 0;
+      entry_.transactions.reserve(len);
+      if (len == 0) {
+        state_ = State::Ready;
+      } else {
+        begin_transaction();
+      }
+      break;
+
+    // ---- VersionedTransaction ----
+    case State::TxSigCount:
+      if (target_ == Target::Transaction) {
+        tx_ = &tx_storage_;
+      }
+      if (!read_short_vec(in, len))
+        return state_ == State::Failed ? StreamStatus::Error
+                                       : StreamStatus::NeedMoreData;
+      tx_->signatures.resize(len);
+      state_ = State::TxSigs;
+      break;
+    case State::TxSigs:
+      if (!copy_field(in, reinterpret_cast<uint8_t *>(tx_->signatures.data()),
+                      tx_->signatures.size() * SIGNATURE_BYTES))
+        return StreamStatus::NeedMoreData;
+      state_ = State::MsgFirst;
+      break;
+
+    // ---- Message ----
+    case State::MsgFirst: {
+      if (in.empty())
+        return StreamStatus::NeedMoreData;
+      uint8_t first = in[0];
+      in = in.subspan(1);
+      if (first & VERSION_PREFIX_MASK) {
+        tx_->message = VersionedMessage(V0Message{});
+        V0Message &msg = tx_->message.as_v0();
+        header_ = &msg.header;
+        keys_ = &msg.account_keys;
+        blockhash_ = &msg.recent_blockhash;
+        instructions_ = &msg.instructions;
+        atls_ = &msg.address_table_lookups;
+        field_pos_ = 0;
+      } else {
+        tx_->message = VersionedMessage(LegacyMessage{});
+        LegacyMessage &msg = tx_->message.as_legacy();
+        header_ = &msg.header;
+        keys_ = &msg.account_keys;
+        blockhash_ = &msg.recent_blockhash;
+        instructions_ = &msg.instructions;
+        atls_ = nullptr;
+        // Legacy: the first byte is num_required_signatures
+        scratch_[0] = first;
+        field_pos_ = 1;
+      }
+      state_ = State::MsgHeaderRest;
+      break;
+    }
+    case State::MsgHeaderRest:
+      if (!copy_field(in, scratch_, 3))
+        return StreamStatus::NeedMoreData;
+      header_->num_required_signatures = scratch_[0];
+      header_->num_readonly_signed_accounts = scratch_[1];
+      header_->num_readonly_unsigned_accounts = scratch_[2];
+      state_ = State::MsgKeyCount;
+      break;
+    case State::MsgKeyCount:
+      if (!read_short_vec(in, len))
+        return state_ == State::Failed ? StreamStatus::Error
+                                       : StreamStatus::NeedMoreData;
+      keys_->resize(len);
+      state_ = State::MsgKeys;
+      break;
+    case State::MsgKeys:
+      if (!copy_field(in, reinterpret_cast<uint8_t *>(keys_->data()),
+                      keys_->size() * PUBKEY_BYTES))
+        return StreamStatus::NeedMoreData;
+      state_ = State::MsgBlockhash;
+      break;
+    case State::MsgBlockhash:
+      if (!copy_field(in, blockhash_->data(), HASH_BYTES))
+        return StreamStatus::NeedMoreData;
+      state_ = State::MsgIxCount;
+      break;
+
+    // ---- Instructions ----
+    case State::MsgIxCount:
+      if (!read_short_vec(in, len))
+        return state_ == State::Failed ? StreamStatus::Error
+                                       : StreamStatus::NeedMoreData;
+      instructions_->resize(len);
+      list_count_ = len;
+      list_index_ = 0;
+      if (len == 0) {
+        finish_instructions();
+      } else {
+        ix_ = &(*instructions_)[0];
+        state_ = State::IxProgram;
+      }
+      break;
+    case State::IxProgram:
+      if (in.empty())
+        return StreamStatus::NeedMoreData;
+      ix_->program_id_index = in[0];
+      in = in.subspan(1);
+      state_ = State::IxAccCount;
+      break;
+    case State::IxAccCount:
+      if (!read_short_vec(in, len))
+        return state_ == State::Failed ? StreamStatus::Error
+                                       : StreamStatus::NeedMoreData;
+      ix_->accounts.resize(len);
+      state_ = State::IxAccs;
+      break;
+    case State::IxAccs:
+      if (!copy_field(in, ix_->accounts.data(), ix_->accounts.size()))
+        return StreamStatus::NeedMoreData;
+      state_ = State::IxDataLen;
+      break;
+    case State::IxDataLen:
+      if (!read_short_vec(in, len))
+        return state_ == State::Failed ? StreamStatus::Error
+                                       : StreamStatus::NeedMoreData;
+      ix_->data.resize(len);
+      state_ = State::IxData;
+      break;
+    case State::IxData:
+      if (!copy_field(in, ix_->data.data(), ix_->data.size()))
+        return StreamStatus::NeedMoreData;
+      if (++list_index_ == list_count_) {
+        finish_instructions();
+      } else {
+        ix_ = &(*instructions_)[list_index_];
+        state_ = State::IxProgram;
+      }
+      break;
+
+    // ---- Address table lookups (v0 only) ----
+    case State::MsgAtlCount:
+      if (!read_short_vec(in, len))
+        return state_ == State::Failed ? StreamStatus::Error
+                                       : StreamStatus::NeedMoreData;
+      atls_->resize(len);
+      list_count_ = len;
+      list_index_ = 0;
+      if (len == 0) {
+        finish_transaction();
+      } else {
+        atl_ = &(*atls_)[0];
+        state_ = State::AtlKey;
+      }
+      break;
+    case State::AtlKey:
+      if (!copy_field(in, atl_->account_key.data(), PUBKEY_BYTES))
+        return StreamStatus::NeedMoreData;
+      state_ = State::AtlWritableCount;
+      break;
+    case State::AtlWritableCount:
+      if (!read_short_vec(in, len))
+        return state_ == State::Failed ? StreamStatus::Error
+                                       : StreamStatus::NeedMoreData;
+      atl_->writable_indexes.resize(len);
+      state_ = State::AtlWritable;
+      break;
+    case State::AtlWritable:
+      if (!copy_field(in, atl_->writable_indexes.data(),
+                      atl_->writable_indexes.size()))
+        return StreamStatus::NeedMoreData;
+      state_ = State::AtlReadonlyCount;
+      break;
+    case State::AtlReadonlyCount:
+      if (!read_short_vec(in, len))
+        return state_ == State::Failed ? StreamStatus::Error
+                                       : StreamStatus::NeedMoreData;
+      atl_->readonly_indexes.resize(len);
+      state_ = State::AtlReadonly;
+      break;
+    case State::AtlReadonly:
+      if (!copy_field(in, atl_->readonly_indexes.data(),
+                      atl_->readonly_indexes.size()))
+        return StreamStatus::NeedMoreData;
+      if (++list_index_ == list_count_) {
+        finish_transaction();
+      } else {
+        atl_ = &(*atls_)[list_index_];
+        state_ = State::AtlKey;
+      }
+      break;
+    }
+  }
+}
+
+} // namespace limcode
@@ -68,6 +68,263 @@ void limcode_encoder_advance(LimcodeEncoder *encoder, size_t bytes);
 uint8_t *limcode_encoder_alloc_space(LimcodeEncoder *encoder, size_t bytes,
                                      size_t *out_offset);
 
+// ==================== Bulk Entry API ====================
+//
+// One call per block instead of one call per field. Offsets in the decode
+// layout are relative to the start of the input buffer; all pointers in
+// the encode descriptors are only read during the call. Pointers may be
+// NULL when the matching count is 0.
+
+/// Status codes of the bulk API
+enum {
+  LIMCODE_FFI_OK = 0,
+  LIMCODE_FFI_INVALID_ARGUMENT = -1, ///< NULL pointer, bad descriptor
+  LIMCODE_FFI_INVALID_DATA = -2,     ///< Malformed or truncated input
+  LIMCODE_FFI_BUFFER_TOO_SMALL = -3, ///< Required sizes were written back
+  LIMCODE_FFI_INTERNAL = -4,         ///< Allocation failure
+};
+
+/// `version` of a legacy (unversioned) message
+#define LIMCODE_MESSAGE_LEGACY 0xFF
+
+typedef struct LimcodeInstructionDesc {
+  const uint8_t *accounts; ///< num_accounts account indexes
+  const uint8_t *data;     ///< data_len bytes
+  uint16_t num_accounts;
+  uint16_t data_len;
+  uint8_t program_id_index;
+} LimcodeInstructionDesc;
+
+typedef struct LimcodeLookupDesc {
+  const uint8_t *account_key;      ///< 32 bytes
+  const uint8_t *writable_indexes; ///< num_writable bytes
+  const uint8_t *readonly_indexes; ///< num_readonly bytes
+  uint16_t num_writable;
+  uint16_t num_readonly;
+} LimcodeLookupDesc;
+
+typedef struct LimcodeTransactionDesc {
+  const uint8_t *signatures;       ///< num_signatures * 64 bytes
+  const uint8_t *account_keys;     ///< num_account_keys * 32 bytes
+  const uint8_t *recent_blockhash; ///< 32 bytes
+  const LimcodeInstructionDesc *instructions;
+  const LimcodeLookupDesc *lookups; ///< v0 only
+  uint16_t num_signatures;
+  uint16_t num_account_keys;
+  uint16_t num_instructions;
+  uint16_t num_lookups;
+  uint8_t version; ///< LIMCODE_MESSAGE_LEGACY or 0
+  uint8_t num_required_signatures;
+  uint8_t num_readonly_signed_accounts;
+  uint8_t num_readonly_unsigned_accounts;
+} LimcodeTransactionDesc;
+
+typedef struct LimcodeEntryDesc {
+  uint64_t num_hashes;
+  const uint8_t *hash; ///< 32 bytes
+  const LimcodeTransactionDesc *transactions;
+  uint16_t num_transactions;
+} LimcodeEntryDesc;
+
+/**
+ * Serialize a bincode Vec<Entry> described by `entries` into `out`.
+ *
+ * `*out_len` receives the encoded size. If it exceeds `out_capacity`,
+ * nothing is written and LIMCODE_FFI_BUFFER_TOO_SMALL is returned, so
+ * (out = NULL, out_capacity = 0) queries the size. Large batches are
+ * encoded on the shared executor.
+ */
+int limcode_serialize_entries(const LimcodeEntryDesc *entries,
+                              size_t num_entries, uint8_t *out,
+                              size_t out_capacity, size_t *out_len);
+
+typedef struct LimcodeEntryLayout {
+  uint64_t num_hashes;
+  uint32_t hash_offset;
+  uint32_t first_transaction; ///< Index into LimcodeBlockLayout.transactions
+  uint32_t num_transactions;
+} LimcodeEntryLayout;
+
+typedef struct LimcodeTransactionLayout {
+  uint32_t offset; ///< Start of the encoded transaction
+  uint32_t size;   ///< Encoded length; the message runs to offset + size
+  uint32_t signatures_offset;
+  uint32_t message_offset;
+  uint32_t account_keys_offset;
+  uint32_t recent_blockhash_offset;
+  uint32_t first_instruction; ///< Index into LimcodeBlockLayout.instructions
+  uint32_t first_lookup;      ///< Index into LimcodeBlockLayout.lookups
+  uint16_t num_signatures;
+  uint16_t num_account_keys;
+  uint16_t num_instructions;
+  uint16_t num_lookups;
+  uint8_t version; ///< LIMCODE_MESSAGE_LEGACY or 0
+  uint8_t num_required_signatures;
+  uint8_t num_readonly_signed_accounts;
+  uint8_t num_readonly_unsigned_accounts;
+} LimcodeTransactionLayout;
+
+typedef struct LimcodeInstructionLayout {
+  uint32_t accounts_offset;
+  uint32_t data_offset;
+  uint16_t num_accounts;
+  uint16_t data_len;
+  uint8_t program_id_index;
+} LimcodeInstructionLayout;
+
+typedef struct LimcodeLookupLayout {
+  uint32_t account_key_offset;
+  uint32_t writable_offset;
+  uint32_t readonly_offset;
+  uint16_t num_writable;
+  uint16_t num_readonly;
+} LimcodeLookupLayout;
+
+/**
+ * Caller-owned output of limcode_decode_entries().
+ *
+ * The caller sets the four arrays and their capacities; the call sets the
+ * num_* fields and `consumed`.
+ */
+typedef struct LimcodeBlockLayout {
+  LimcodeEntryLayout *entries;
+  size_t entries_capacity;
+  size_t num_entries;
+  LimcodeTransactionLayout *transactions;
+  size_t transactions_capacity;
+  size_t num_transactions;
+  LimcodeInstructionLayout *instructions;
+  size_t instructions_capacity;
+  size_t num_instructions;
+  LimcodeLookupLayout *lookups;
+  size_t lookups_capacity;
+  size_t num_lookups;
+  size_t consumed; ///< Input bytes the Vec<Entry> occupies
+} LimcodeBlockLayout;
+
+/**
+ * Decode a bincode Vec<Entry> into flat, offset-based tables.
+ *
+ * The input is validated first (see limcode::validate_entries), then
+ * walked without copying any payload; large blocks are walked on the
+ * shared executor. If any table is too small, LIMCODE_FFI_BUFFER_TOO_SMALL
+ * is returned with every num_* set to the required size, so a call with
+ * zero capacities sizes the tables. Inputs over 4 GiB are rejected
+ * (offsets are 32-bit).
+ */
+int limcode_decode_entries(const uint8_t *data, size_t len,
+                           LimcodeBlockLayout *layout);
+
+/**
+ * Check that `data` starts with a well-formed bincode Vec<Entry>.
+ *
+ * Never allocates. `consumed` (optional) receives the encoded length, or
+ * on LIMCODE_FFI_INVALID_DATA the offset validation stopped at.
+ */
+int limcode_validate_entries(const uint8_t *data, size_t len,
+                             size_t *consumed);
+
+// ==================== Snapshot Account API ====================
+//
+// Accounts are delivered in batches of views into the AppendVec buffer, so
+// the FFI cost is paid once per batch rather than once per account. Views
+// are only valid for the duration of the callback. The archive and cache
+// entry points are provided by the limcode_snapshot library (libarchive +
+// libzstd); the in-memory AppendVec entry point only needs limcode_ffi.
+
+typedef struct LimcodeAccountView {
+  const uint8_t *pubkey; ///< 32 bytes
+  const uint8_t *owner;  ///< 32 bytes
+  const uint8_t *hash;   ///< 32 bytes
+  const uint8_t *data;   ///< data_len bytes
+  uint64_t data_len;
+  uint64_t lamports;
+  uint64_t rent_epoch;
+  uint64_t write_version;
+  uint8_t executable;
+} LimcodeAccountView;
+
+/// Receives `count` views; return 0 to stop the stream
+typedef int (*LimcodeAccountBatchCallback)(void *user_data,
+                                           const LimcodeAccountView *views,
+                                           size_t count);
+
+/// Mirror of limcode::snapshot::ParallelStreamOptions (0 = default)
+typedef struct LimcodeSnapshotStreamOptions {
+  uint32_t num_threads; ///< Parser threads (0 = hardware concurrency)
+  size_t max_inflight_bytes;
+  size_t read_buffer_size;
+  size_t batch_size; ///< Maximum views per callback
+} LimcodeSnapshotStreamOptions;
+
+/// Fill `options` with the C++ defaults
+void limcode_snapshot_stream_options_init(LimcodeSnapshotStreamOptions *options);
+
+/**
+ * Visit every record of an in-memory AppendVec in batches of at most
+ * `batch_size` views, on the calling thread.
+ *
+ * @return Number of accounts delivered (the batch whose callback returned 0
+ *         is not counted)
+ */
+size_t limcode_appendvec_stream(const uint8_t *data, size_t len,
+                                size_t batch_size,
+                                LimcodeAccountBatchCallback callback,
+                                void *user_data);
+
+/**
+ * Stream a .tar.zst snapshot through the parallel pipeline
+ * (limcode::snapshot::stream_snapshot_parallel_batches).
+ *
+ * The callback runs concurrently on the parser threads and must be
+ * thread-safe; each batch holds views into a single AppendVec. `options`
+ * may be NULL for the defaults.
+ *
+ * @return Number of accounts delivered, or -1 on error
+ */
+int64_t limcode_snapshot_stream(const char *snapshot_path,
+                                const LimcodeSnapshotStreamOptions *options,
+                                LimcodeAccountBatchCallback callback,
+                                void *user_data);
+
+/**
+ * Stream a snapshot through its unpacked cache directory, extracting it
+ * first if needed (limcode::snapshot::stream_snapshot_cached). Same
+ * threading contract as limcode_snapshot_stream().
+ *
+ * @return Number of accounts delivered, or -1 on error
+ */
+int64_t limcode_snapshot_stream_cached(
+    const char *snapshot_path, const char *cache_dir,
+    const LimcodeSnapshotStreamOptions *options,
+    LimcodeAccountBatchCallback callback, void *user_data);
+
+/**
+ * Stream an existing unpacked cache directory
+ * (limcode::snapshot::stream_unpacked_snapshot). Same threading contract
+ * as limcode_snapshot_stream().
+ *
+ * @return Number of accounts delivered, or -1 on error
+ */
+int64_t limcode_snapshot_stream_unpacked(
+    const char *cache_dir, const LimcodeSnapshotStreamOptions *options,
+    LimcodeAccountBatchCallback callback, void *user_data);
+
+/**
+ * Stream a full snapshot overlaid with an incremental one, delivering only
+ * the newest version of each account and skipping deleted (zero-lamport)
+ * ones (limcode::snapshot::stream_merged_snapshot). Both archives go
+ * through their cache directories. Same threading contract as
+ * limcode_snapshot_stream().
+ *
+ * @return Number of accounts delivered, or -1 on error
+ */
+int64_t limcode_snapshot_stream_merged(
+    const char *full_path, const char *full_cache_dir,
+    const char *incremental_path, const char *incremental_cache_dir,
+    const LimcodeSnapshotStreamOptions *options,
+    LimcodeAccountBatchCallback callback, void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
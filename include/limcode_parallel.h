@@ -8,113 +8,35 @@
 
 #pragma once
 
-#include "common/limcode.h"
-#include <atomic>
-#include <functional>
-#include <thread>
+#include "limcode/limcode.h"
 #include <vector>
 
 namespace limcode {
 
-/**
- * @brief Lock-free work-stealing queue for parallel encoding tasks
- */
-template <typename T> class WorkStealingQueue {
-private:
-  alignas(64) std::atomic<size_t> head_{0};
-  alignas(64) std::atomic<size_t> tail_{0};
-  std::vector<T> buffer_;
-  size_t mask_;
-
-public:
-  explicit WorkStealingQueue(size_t capacity = 1024)
-      : buffer_(capacity), mask_(capacity - 1) {
-    // Ensure capacity is power of 2
-    if ((capacity & (capacity - 1)) != 0) {
-      throw std::invalid_argument("Capacity must be power of 2");
-    }
-  }
-
-  bool try_push(const T &item) {
-    size_t tail = tail_.load(std::memory_order_relaxed);
-    size_t next_tail = (tail + 1) & mask_;
-
-    if (next_tail == head_.load(std::memory_order_acquire)) {
-      return false; // Queue full
-    }
-
-    buffer_[tail] = item;
-    tail_.store(next_tail, std::memory_order_release);
-    return true;
-  }
-
-  bool try_pop(T &item) {
-    size_t tail = tail_.load(std::memory_order_relaxed);
-
-    if (tail == head_.load(std::memory_order_acquire)) {
-      return false; // Queue empty
-    }
-
-    size_t prev_tail = (tail - 1) & mask_;
-    item = buffer_[prev_tail];
-    tail_.store(prev_tail, std::memory_order_release);
-    return true;
-  }
-
-  bool try_steal(T &item) {
-    size_t head = head_.load(std::memory_order_acquire);
-    size_t tail = tail_.load(std::memory_order_acquire);
-
-    if (head == tail) {
-      return false; // Empty
-    }
-
-    item = buffer_[head];
-    head_.store((head + 1) & mask_, std::memory_order_release);
-    return true;
-  }
-};
-
 /**
  * @brief Parallel batch encoder for encoding multiple transactions
+ *
+ * Runs on a shared Executor (default_executor() unless one is given), so
+ * several encoders never add threads of their own.
  */
 class ParallelBatchEncoder {
 private:
-  size_t num_threads_;
-  std::vector<std::thread> workers_;
-  std::vector<WorkStealingQueue<std::function<void()>>> queues_;
-  std::atomic<bool> stop_{false};
-  std::atomic<size_t> active_tasks_{0};
+  Executor &executor_;
+  size_t num_chunks_;
 
 public:
-  explicit ParallelBatchEncoder(size_t num_threads = 0)
-      : num_threads_(num_threads == 0 ? std::thread::hardware_concurrency()
-                                      : num_threads) {
-
-    queues_.reserve(num_threads_);
-    for (size_t i = 0; i < num_threads_; ++i) {
-      queues_.emplace_back(1024);
-    }
-
-    // Spawn worker threads
-    for (size_t i = 0; i < num_threads_; ++i) {
-      workers_.emplace_back([this, i]() { worker_loop(i); });
-    }
-  }
+  /// @param num_threads Upper bound on parallel chunks (0 = executor concurrency)
+  explicit ParallelBatchEncoder(size_t num_threads = 0,
+                                Executor &executor = default_executor())
+      : executor_(executor), num_chunks_(num_threads) {}
 
-  ~ParallelBatchEncoder() {
-    stop_.store(true, std::memory_order_release);
-    for (auto &worker : workers_) {
-      if (worker.joinable()) {
-        worker.join();
-      }
-    }
-  }
+  explicit ParallelBatchEncoder(Executor &executor)
+      : ParallelBatchEncoder(0, executor) {}
 
   /**
    * @brief Encode multiple transactions in parallel
    *
-   * @tparam TxIterator Iterator over VersionedTransaction objects
+   * @tparam TxIterator Random-access iterator over VersionedTransaction
    * @param begin Start iterator
    * @param end End iterator
    * @return Vector of encoded byte buffers (one per transaction)
@@ -125,25 +47,14 @@ public:
     size_t count = std::distance(begin, end);
     std::vector<std::vector<uint8_t>> results(count);
 
-    // Submit encoding tasks
-    active_tasks_.store(count, std::memory_order_release);
-
-    size_t task_id = 0;
-    for (auto it = begin; it != end; ++it, ++task_id) {
-      size_t queue_idx = task_id % num_threads_;
-
-      queues_[queue_idx].try_push([this, &results, task_id, tx = *it]() {
-        LimcodeEncoder encoder;
+    executor_.parallel_for(count, num_chunks_, [&](size_t start, size_t stop) {
+      for (size_t i = start; i < stop; ++i) {
+        const auto &tx = *(begin + i);
+        LimcodeEncoder encoder(serialized_size(tx));
         encoder.write_versioned_transaction(tx);
-        results[task_id] = std::move(encoder.into_vec());
-        active_tasks_.fetch_sub(1, std::memory_order_release);
-      });
-    }
-
-    // Wait for all tasks to complete
-    while (active_tasks_.load(std::memory_order_acquire) > 0) {
-      std::this_thread::yield();
-    }
+        results[i] = std::move(encoder).finish();
+      }
+    });
 
     return results;
   }
@@ -158,56 +69,18 @@ public:
   template <typename T, typename EncodeFn>
   std::vector<std::vector<uint8_t>>
   encode_batch_generic(const std::vector<T> &inputs, EncodeFn &&encode_fn) {
-
     size_t count = inputs.size();
     std::vector<std::vector<uint8_t>> results(count);
 
-    active_tasks_.store(count, std::memory_order_release);
-
-    for (size_t i = 0; i < count; ++i) {
-      size_t queue_idx = i % num_threads_;
-
-      queues_[queue_idx].try_push([this, &results, i, &inputs, &encode_fn]() {
+    executor_.parallel_for(count, num_chunks_, [&](size_t start, size_t stop) {
+      for (size_t i = start; i < stop; ++i) {
         LimcodeEncoder encoder;
         encode_fn(encoder, inputs[i]);
-        results[i] = std::move(encoder.into_vec());
-        active_tasks_.fetch_sub(1, std::memory_order_release);
-      });
-    }
-
-    while (active_tasks_.load(std::memory_order_acquire) > 0) {
-      std::this_thread::yield();
-    }
-
-    return results;
-  }
-
-private:
-  void worker_loop(size_t thread_id) {
-    std::function<void()> task;
-
-    while (!stop_.load(std::memory_order_acquire)) {
-      // Try to pop from own queue
-      if (queues_[thread_id].try_pop(task)) {
-        task();
-        continue;
+        results[i] = std::move(encoder).finish();
       }
+    });
 
-      // Work stealing: try to steal from other queues
-      bool stolen = false;
-      for (size_t i = 1; i < num_threads_; ++i) {
-        size_t victim = (thread_id + i) % num_threads_;
-        if (queues_[victim].try_steal(task)) {
-          task();
-          stolen = true;
-          break;
-        }
-      }
-
-      if (!stolen) {
-        std::this_thread::yield();
-      }
-    }
+    return results;
   }
 };
 
@@ -231,68 +104,35 @@ encode_transactions_parallel(TxIterator begin, TxIterator end,
  */
 class ParallelMegaBlockCopier {
 private:
-  size_t num_threads_;
+  Executor &executor_;
   static constexpr size_t CHUNK_SIZE = 4194304; // 4MB chunks
 
 public:
-  explicit ParallelMegaBlockCopier(size_t num_threads = 0)
-      : num_threads_(num_threads == 0 ? std::thread::hardware_concurrency()
-                                      : num_threads) {}
+  explicit ParallelMegaBlockCopier(Executor &executor = default_executor())
+      : executor_(executor) {}
 
   /**
    * @brief Copy mega-block (1MB - 48MB) in parallel
    *
-   * Splits data into 4MB chunks and processes on multiple cores.
-   * Uses non-temporal stores to bypass cache.
+   * Splits data into 4MB chunks that the executor's workers steal.
    *
    * @param dst Destination buffer (must be pre-allocated!)
    * @param src Source data
    * @param size Total size (1MB to 48MB)
    */
   void copy_parallel(uint8_t *dst, const uint8_t *src, size_t size) {
-    if (size < CHUNK_SIZE || num_threads_ == 1) {
+    if (size < CHUNK_SIZE || executor_.concurrency() == 1) {
       // Small enough or single-threaded: use direct copy
-#if defined(__AVX512F__)
-      limcode_nt_copy_avx512(dst, src, size);
-#elif defined(__AVX2__)
-      limcode_nt_copy_avx2(dst, src, size);
-#else
-      std::memcpy(dst, src, size);
-#endif
+      internal::memcpy_simd_large(dst, src, size);
       return;
     }
 
-    // Split into chunks
     size_t num_chunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
-    size_t chunks_per_thread = std::max(size_t(1), num_chunks / num_threads_);
-
-    std::vector<std::thread> workers;
-    std::atomic<size_t> chunk_idx{0};
-
-    for (size_t i = 0; i < num_threads_; ++i) {
-      workers.emplace_back([&]() {
-        while (true) {
-          size_t idx = chunk_idx.fetch_add(1, std::memory_order_relaxed);
-          if (idx >= num_chunks)
-            break;
-
-          size_t offset = idx * CHUNK_SIZE;
-          size_t chunk_size = std::min(CHUNK_SIZE, size - offset);
-
-#if defined(__AVX512F__)
-          limcode_nt_copy_avx512(dst + offset, src + offset, chunk_size);
-#elif defined(__AVX2__)
-          limcode_nt_copy_avx2(dst + offset, src + offset, chunk_size);
-#else
-          std::memcpy(dst + offset, src + offset, chunk_size);
-#endif
-        }
-      });
-    }
-
-    for (auto &worker : workers) {
-      worker.join();
-    }
+    executor_.run(num_chunks, [&](size_t idx) {
+      size_t offset = idx * CHUNK_SIZE;
+      size_t chunk_size = std::min(CHUNK_SIZE, size - offset);
+      internal::memcpy_simd_large(dst + offset, src + offset, chunk_size);
+    });
   }
 
   /**
@@ -309,7 +149,7 @@ public:
     // Copy data in parallel
     size_t header_size = encoder.size();
     result.resize(header_size + size);
-    std::memcpy(result.data(), encoder.data(), header_size);
+    std::memcpy(result.data(), encoder.data().data(), header_size);
 
     copy_parallel(result.data() + header_size, data, size);
 
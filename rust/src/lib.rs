@@ -61,7 +61,7 @@ pub use serializer::{deserialize_pod_safe, serialize_pod_safe};
 
 // ==================== FFI Bindings ====================
 
-use std::os::raw::c_int;
+use std::os::raw::{c_char, c_int, c_void};
 
 // Opaque handle types
 #[repr(C)]
@@ -109,6 +109,232 @@ extern "C" {
     ) -> *mut u8;
 }
 
+// ==================== Bulk Entry API ====================
+//
+// Mirrors of the flat tables in limcode_ffi.h. One call encodes or decodes
+// a whole Vec<Entry>; all buffers stay owned by the caller.
+
+pub const LIMCODE_FFI_OK: c_int = 0;
+pub const LIMCODE_FFI_INVALID_ARGUMENT: c_int = -1;
+pub const LIMCODE_FFI_INVALID_DATA: c_int = -2;
+pub const LIMCODE_FFI_BUFFER_TOO_SMALL: c_int = -3;
+pub const LIMCODE_FFI_INTERNAL: c_int = -4;
+
+/// `LimcodeTransactionDesc::version` / `LimcodeTransactionLayout::version` of a legacy message
+pub const LIMCODE_MESSAGE_LEGACY: u8 = 0xFF;
+
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct LimcodeInstructionDesc {
+    pub accounts: *const u8,
+    pub data: *const u8,
+    pub num_accounts: u16,
+    pub data_len: u16,
+    pub program_id_index: u8,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct LimcodeLookupDesc {
+    pub account_key: *const u8,
+    pub writable_indexes: *const u8,
+    pub readonly_indexes: *const u8,
+    pub num_writable: u16,
+    pub num_readonly: u16,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct LimcodeTransactionDesc {
+    pub signatures: *const u8,
+    pub account_keys: *const u8,
+    pub recent_blockhash: *const u8,
+    pub instructions: *const LimcodeInstructionDesc,
+    pub lookups: *const LimcodeLookupDesc,
+    pub num_signatures: u16,
+    pub num_account_keys: u16,
+    pub num_instructions: u16,
+    pub num_lookups: u16,
+    pub version: u8,
+    pub num_required_signatures: u8,
+    pub num_readonly_signed_accounts: u8,
+    pub num_readonly_unsigned_accounts: u8,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct LimcodeEntryDesc {
+    pub num_hashes: u64,
+    pub hash: *const u8,
+    pub transactions: *const LimcodeTransactionDesc,
+    pub num_transactions: u16,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct LimcodeEntryLayout {
+    pub num_hashes: u64,
+    pub hash_offset: u32,
+    pub first_transaction: u32,
+    pub num_transactions: u32,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct LimcodeTransactionLayout {
+    pub offset: u32,
+    pub size: u32,
+    pub signatures_offset: u32,
+    pub message_offset: u32,
+    pub account_keys_offset: u32,
+    pub recent_blockhash_offset: u32,
+    pub first_instruction: u32,
+    pub first_lookup: u32,
+    pub num_signatures: u16,
+    pub num_account_keys: u16,
+    pub num_instructions: u16,
+    pub num_lookups: u16,
+    pub version: u8,
+    pub num_required_signatures: u8,
+    pub num_readonly_signed_accounts: u8,
+    pub num_readonly_unsigned_accounts: u8,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct LimcodeInstructionLayout {
+    pub accounts_offset: u32,
+    pub data_offset: u32,
+    pub num_accounts: u16,
+    pub data_len: u16,
+    pub program_id_index: u8,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct LimcodeLookupLayout {
+    pub account_key_offset: u32,
+    pub writable_offset: u32,
+    pub readonly_offset: u32,
+    pub num_writable: u16,
+    pub num_readonly: u16,
+}
+
+#[repr(C)]
+#[derive(Debug)]
+pub struct LimcodeBlockLayout {
+    pub entries: *mut LimcodeEntryLayout,
+    pub entries_capacity: usize,
+    pub num_entries: usize,
+    pub transactions: *mut LimcodeTransactionLayout,
+    pub transactions_capacity: usize,
+    pub num_transactions: usize,
+    pub instructions: *mut LimcodeInstructionLayout,
+    pub instructions_capacity: usize,
+    pub num_instructions: usize,
+    pub lookups: *mut LimcodeLookupLayout,
+    pub lookups_capacity: usize,
+    pub num_lookups: usize,
+    pub consumed: usize,
+}
+
+extern "C" {
+    pub fn limcode_serialize_entries(
+        entries: *const LimcodeEntryDesc,
+        num_entries: usize,
+        out: *mut u8,
+        out_capacity: usize,
+        out_len: *mut usize,
+    ) -> c_int;
+    pub fn limcode_decode_entries(
+        data: *const u8,
+        len: usize,
+        layout: *mut LimcodeBlockLayout,
+    ) -> c_int;
+    pub fn limcode_validate_entries(data: *const u8, len: usize, consumed: *mut usize) -> c_int;
+}
+
+// ==================== Snapshot Account API ====================
+//
+// Batched account views from limcode_snapshot (archive / cache streams, with
+// the "snapshot" feature) and limcode_ffi (in-memory AppendVec). Views are
+// only valid inside the callback.
+
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct LimcodeAccountView {
+    pub pubkey: *const u8,
+    pub owner: *const u8,
+    pub hash: *const u8,
+    pub data: *const u8,
+    pub data_len: u64,
+    pub lamports: u64,
+    pub rent_epoch: u64,
+    pub write_version: u64,
+    pub executable: u8,
+}
+
+/// Return 0 to stop the stream. Archive / cache streams call this
+/// concurrently from parser threads.
+pub type LimcodeAccountBatchCallback = unsafe extern "C" fn(
+    user_data: *mut c_void,
+    views: *const LimcodeAccountView,
+    count: usize,
+) -> c_int;
+
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct LimcodeSnapshotStreamOptions {
+    pub num_threads: u32,
+    pub max_inflight_bytes: usize,
+    pub read_buffer_size: usize,
+    pub batch_size: usize,
+}
+
+extern "C" {
+    pub fn limcode_snapshot_stream_options_init(options: *mut LimcodeSnapshotStreamOptions);
+    pub fn limcode_appendvec_stream(
+        data: *const u8,
+        len: usize,
+        batch_size: usize,
+        callback: Option<LimcodeAccountBatchCallback>,
+        user_data: *mut c_void,
+    ) -> usize;
+}
+
+// Compiled only with the "snapshot" feature (links libarchive and libzstd)
+#[cfg(feature = "snapshot")]
+extern "C" {
+    pub fn limcode_snapshot_stream(
+        snapshot_path: *const c_char,
+        options: *const LimcodeSnapshotStreamOptions,
+        callback: Option<LimcodeAccountBatchCallback>,
+        user_data: *mut c_void,
+    ) -> i64;
+    pub fn limcode_snapshot_stream_cached(
+        snapshot_path: *const c_char,
+        cache_dir: *const c_char,
+        options: *const LimcodeSnapshotStreamOptions,
+        callback: Option<LimcodeAccountBatchCallback>,
+        user_data: *mut c_void,
+    ) -> i64;
+    pub fn limcode_snapshot_stream_unpacked(
+        cache_dir: *const c_char,
+        options: *const LimcodeSnapshotStreamOptions,
+        callback: Option<LimcodeAccountBatchCallback>,
+        user_data: *mut c_void,
+    ) -> i64;
+    pub fn limcode_snapshot_stream_merged(
+        full_path: *const c_char,
+        full_cache_dir: *const c_char,
+        incremental_path: *const c_char,
+        incremental_cache_dir: *const c_char,
+        options: *const LimcodeSnapshotStreamOptions,
+        callback: Option<LimcodeAccountBatchCallback>,
+        user_data: *mut c_void,
+    ) -> i64;
+}
+
 // ==================== End FFI Bindings ====================
 
 /// Ultra-fast bincode-compatible serialization with adaptive optimization
@@ -0,0 +1,66 @@
+/**
+ * @file ffi_account_views.h
+ * @brief Conversions between the C snapshot account API and
+ *        limcode::snapshot, shared by limcode_ffi.cpp and
+ *        limcode_snapshot_ffi.cpp (not installed)
+ */
+
+#pragma once
+
+#include "limcode_ffi.h"
+#include "limcode/snapshot.h"
+#include <span>
+#include <vector>
+
+namespace limcode::ffi {
+
+inline LimcodeAccountView to_c_view(const snapshot::SnapshotAccountView &view) {
+  const snapshot::AppendVecHeader *header = view.header;
+  return LimcodeAccountView{header->pubkey,
+                            header->owner,
+                            header->hash,
+                            view.data.data(),
+                            view.data.size(),
+                            header->lamports,
+                            header->rent_epoch,
+                            header->write_version,
+                            header->executable};
+}
+
+/// Unset (0) fields keep the C++ defaults
+inline snapshot::ParallelStreamOptions
+to_stream_options(const LimcodeSnapshotStreamOptions *options) {
+  snapshot::ParallelStreamOptions out;
+  if (!options) {
+    return out;
+  }
+  out.num_threads = options->num_threads;
+  if (options->max_inflight_bytes) {
+    out.max_inflight_bytes = options->max_inflight_bytes;
+  }
+  if (options->read_buffer_size) {
+    out.read_buffer_size = options->read_buffer_size;
+  }
+  if (options->batch_size) {
+    out.batch_size = options->batch_size;
+  }
+  return out;
+}
+
+/// AccountBatchCallback forwarding each batch to a C callback
+///
+/// The view array is per thread, so the parallel pipeline can call this
+/// from every parser thread at once without allocating per batch.
+inline snapshot::AccountBatchCallback
+forward_batches(LimcodeAccountBatchCallback callback, void *user_data) {
+  return [callback, user_data](std::span<const snapshot::SnapshotAccountView> batch) {
+    thread_local std::vector<LimcodeAccountView> views;
+    views.clear();
+    for (const auto &view : batch) {
+      views.push_back(to_c_view(view));
+    }
+    return callback(user_data, views.data(), views.size()) != 0;
+  };
+}
+
+} // namespace limcode::ffi
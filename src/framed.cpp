@@ -0,0 +1,453 @@
+#include "limcode/framed.h"
+#include <zdict.h>
+#include <zstd.h>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace limcode {
+
+struct ZstdDictionary::Impl {
+  std::vector<uint8_t> content;
+  uint32_t id = 0;
+  int level = 0;
+  ZSTD_CDict *cdict = nullptr;
+  ZSTD_DDict *ddict = nullptr;
+
+  ~Impl() {
+    ZSTD_freeCDict(cdict);
+    ZSTD_freeDDict(ddict);
+  }
+};
+
+/// Digested dictionaries for the encoder / decoder paths
+struct ZstdDictionaryAccess {
+  static ZSTD_CDict *cdict(const ZstdDictionary *dict) noexcept {
+    return dict ? dict->impl_->cdict : nullptr;
+  }
+  static ZSTD_DDict *ddict(const ZstdDictionary *dict) noexcept {
+    return dict ? dict->impl_->ddict : nullptr;
+  }
+};
+
+namespace {
+
+struct CCtxDeleter {
+  void operator()(ZSTD_CCtx *ctx) const noexcept { ZSTD_freeCCtx(ctx); }
+};
+
+struct DCtxDeleter {
+  void operator()(ZSTD_DCtx *ctx) const noexcept { ZSTD_freeDCtx(ctx); }
+};
+
+/// Contexts for the parallel paths, one per worker thread: creating one
+/// costs more than compressing a typical batch
+ZSTD_CCtx *thread_cctx() {
+  thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> ctx(ZSTD_createCCtx());
+  if (!ctx) {
+    throw std::bad_alloc();
+  }
+  return ctx.get();
+}
+
+ZSTD_DCtx *thread_dctx() {
+  thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> ctx(ZSTD_createDCtx());
+  if (!ctx) {
+    throw std::bad_alloc();
+  }
+  return ctx.get();
+}
+
+LimcodeError zstd_error(const char *what, size_t code) {
+  return LimcodeError::invalid_encoding(std::string(what) + ": " +
+                                        ZSTD_getErrorName(code));
+}
+
+void write_header(uint8_t *dst, const FrameHeader &header) {
+  uint32_t magic = FRAME_MAGIC;
+  uint16_t reserved = 0;
+  std::memcpy(dst, &magic, 4);
+  dst[4] = FRAME_VERSION;
+  dst[5] = header.flags;
+  std::memcpy(dst + 6, &reserved, 2);
+  std::memcpy(dst + 8, &header.dict_id, 4);
+  std::memcpy(dst + 12, &header.stored_size, 4);
+  std::memcpy(dst + 16, &header.raw_size, 4);
+}
+
+/// Append a frame for `payload` to `out`, compressed when that pays off
+size_t append_frame(ZSTD_CCtx *cctx, std::span<const uint8_t> payload,
+                    const FrameOptions &options, std::vector<uint8_t> &out) {
+  if (payload.size() > MAX_FRAME_PAYLOAD) {
+    throw LimcodeError(ErrorCode::InvalidLength,
+                       "Frame payload of " + std::to_string(payload.size()) +
+                           " bytes exceeds " +
+                           std::to_string(MAX_FRAME_PAYLOAD));
+  }
+
+  const size_t start = out.size();
+  FrameHeader header;
+  header.raw_size = static_cast<uint32_t>(payload.size());
+
+  if (payload.size() >= options.min_compress_size) {
+    ZSTD_CDict *cdict = ZstdDictionaryAccess::cdict(options.dictionary);
+    size_t capacity = ZSTD_compressBound(payload.size());
+    out.resize(start + FRAME_HEADER_SIZE + capacity);
+    uint8_t *dst = out.data() + start + FRAME_HEADER_SIZE;
+    size_t written =
+        cdict ? ZSTD_compress_usingCDict(cctx, dst, capacity, payload.data(),
+                                         payload.size(), cdict)
+              : ZSTD_compressCCtx(cctx, dst, capacity, payload.data(),
+                                  payload.size(), options.level);
+    if (ZSTD_isError(written)) {
+      out.resize(start);
+      throw zstd_error("zstd compression failed", written);
+    }
+    if (written < payload.size()) {
+      header.flags = FRAME_COMPRESSED;
+      header.dict_id = cdict ? options.dictionary->id() : 0;
+      header.stored_size = static_cast<uint32_t>(written);
+      out.resize(start + header.frame_size());
+      write_header(out.data() + start, header);
+      return header.frame_size();
+    }
+  }
+
+  // Too small or incompressible: store it as is
+  header.stored_size = header.raw_size;
+  out.resize(start + header.frame_size());
+  write_header(out.data() + start, header);
+  if (!payload.empty()) {
+    std::memcpy(out.data() + start + FRAME_HEADER_SIZE, payload.data(),
+                payload.size());
+  }
+  return header.frame_size();
+}
+
+/// Header of the frame at the front of `data`, which must be complete
+FrameHeader whole_frame_header(std::span<const uint8_t> data) {
+  FrameHeader header;
+  if (!read_frame_header(data, header)) {
+    throw LimcodeError::buffer_underflow(FRAME_HEADER_SIZE, data.size());
+  }
+  if (data.size() < header.frame_size()) {
+    throw LimcodeError::buffer_underflow(header.frame_size(), data.size());
+  }
+  return header;
+}
+
+const ZstdDictionary *
+find_dictionary(std::span<const ZstdDictionary *const> dictionaries,
+                uint32_t id) {
+  for (const ZstdDictionary *dict : dictionaries) {
+    if (dict && dict->id() == id) {
+      return dict;
+    }
+  }
+  return nullptr;
+}
+
+/// Decode the whole frame at the front of `frame` into `payload`
+size_t decode_frame(ZSTD_DCtx *dctx, std::span<const uint8_t> frame,
+                    std::span<const ZstdDictionary *const> dictionaries,
+                    std::vector<uint8_t> &payload) {
+  FrameHeader header = whole_frame_header(frame);
+  const uint8_t *stored = frame.data() + FRAME_HEADER_SIZE;
+  payload.resize(header.raw_size);
+  if (!header.compressed()) {
+    if (header.raw_size) {
+      std::memcpy(payload.data(), stored, header.raw_size);
+    }
+    return header.frame_size();
+  }
+
+  size_t size;
+  if (header.dict_id != 0) {
+    const ZstdDictionary *dict = find_dictionary(dictionaries, header.dict_id);
+    if (!dict) {
+      throw LimcodeError::invalid_encoding("unknown dictionary id " +
+                                           std::to_string(header.dict_id));
+    }
+    size = ZSTD_decompress_usingDDict(dctx, payload.data(), payload.size(),
+                                      stored, header.stored_size,
+                                      ZstdDictionaryAccess::ddict(dict));
+  } else {
+    size = ZSTD_decompressDCtx(dctx, payload.data(), payload.size(), stored,
+                               header.stored_size);
+  }
+  if (ZSTD_isError(size)) {
+    throw zstd_error("zstd decompression failed", size);
+  }
+  if (size != header.raw_size) {
+    throw LimcodeError::invalid_encoding("frame raw size mismatch");
+  }
+  return header.frame_size();
+}
+
+/// serialize_entries(entries) into `scratch`, reusing its capacity
+std::span<const uint8_t> serialize_batch(const std::vector<Entry> &entries,
+                                         std::vector<uint8_t> &scratch) {
+  scratch.resize(serialized_size(entries));
+  return {scratch.data(), serialize_entries_into(entries, scratch)};
+}
+
+/// Frame payload_of(i, scratch) for i in [0, count) concurrently
+template <typename PayloadOf>
+std::vector<uint8_t> encode_frames(size_t count, const FrameOptions &options,
+                                   Executor &executor, PayloadOf payload_of) {
+  std::vector<std::vector<uint8_t>> frames(count);
+  executor.run(count, [&](size_t i) {
+    thread_local std::vector<uint8_t> scratch;
+    append_frame(thread_cctx(), payload_of(i, scratch), options, frames[i]);
+  });
+
+  size_t total = 0;
+  for (const auto &frame : frames) {
+    total += frame.size();
+  }
+  std::vector<uint8_t> out;
+  out.reserve(total);
+  for (const auto &frame : frames) {
+    out.insert(out.end(), frame.begin(), frame.end());
+  }
+  return out;
+}
+
+} // namespace
+
+// ==================== Frame header ====================
+
+bool read_frame_header(std::span<const uint8_t> data, FrameHeader &header) {
+  if (data.size() < FRAME_HEADER_SIZE) {
+    return false;
+  }
+  uint32_t magic;
+  uint16_t reserved;
+  std::memcpy(&magic, data.data(), 4);
+  std::memcpy(&reserved, data.data() + 6, 2);
+  if (magic != FRAME_MAGIC) {
+    throw LimcodeError::invalid_encoding("bad frame magic");
+  }
+  if (data[4] != FRAME_VERSION) {
+    throw LimcodeError::invalid_version(data[4]);
+  }
+  header.flags = data[5];
+  std::memcpy(&header.dict_id, data.data() + 8, 4);
+  std::memcpy(&header.stored_size, data.data() + 12, 4);
+  std::memcpy(&header.raw_size, data.data() + 16, 4);
+  if ((header.flags & ~FRAME_COMPRESSED) != 0 || reserved != 0) {
+    throw LimcodeError::invalid_encoding("unknown frame flags");
+  }
+  if (!header.compressed() && header.stored_size != header.raw_size) {
+    throw LimcodeError::invalid_encoding("stored frame size mismatch");
+  }
+  return true;
+}
+
+// ==================== ZstdDictionary ====================
+
+ZstdDictionary::ZstdDictionary(std::vector<uint8_t> content, int level)
+    : impl_(std::make_unique<Impl>()) {
+  impl_->id = ZDICT_getDictID(content.data(), content.size());
+  if (impl_->id == 0) {
+    // Raw-content dictionaries have no ID to put in the frame header
+    throw LimcodeError::invalid_encoding("not a zstd dictionary");
+  }
+  impl_->content = std::move(content);
+  impl_->level = level;
+  impl_->cdict =
+      ZSTD_createCDict(impl_->content.data(), impl_->content.size(), level);
+  impl_->ddict = ZSTD_createDDict(impl_->content.data(), impl_->content.size());
+  if (!impl_->cdict || !impl_->ddict) {
+    throw std::bad_alloc();
+  }
+}
+
+ZstdDictionary::~ZstdDictionary() = default;
+ZstdDictionary::ZstdDictionary(ZstdDictionary &&) noexcept = default;
+ZstdDictionary &ZstdDictionary::operator=(ZstdDictionary &&) noexcept = default;
+
+uint32_t ZstdDictionary::id() const noexcept { return impl_->id; }
+int ZstdDictionary::level() const noexcept { return impl_->level; }
+std::span<const uint8_t> ZstdDictionary::content() const noexcept {
+  return impl_->content;
+}
+
+std::vector<uint8_t>
+train_zstd_dictionary(std::span<const std::vector<uint8_t>> samples,
+                      size_t max_size) {
+  // ZDICT takes the samples back to back plus their sizes
+  size_t total = 0;
+  for (const auto &sample : samples) {
+    total += sample.size();
+  }
+  std::vector<uint8_t> corpus;
+  std::vector<size_t> sizes;
+  corpus.reserve(total);
+  sizes.reserve(samples.size());
+  for (const auto &sample : samples) {
+    corpus.insert(corpus.end(), sample.begin(), sample.end());
+    sizes.push_back(sample.size());
+  }
+
+  std::vector<uint8_t> dict(max_size);
+  size_t size = ZDICT_trainFromBuffer(dict.data(), dict.size(), corpus.data(),
+                                      sizes.data(),
+                                      static_cast<unsigned>(sizes.size()));
+  if (ZDICT_isError(size)) {
+    throw LimcodeError(ErrorCode::InvalidData,
+                       std::string("zstd dictionary training failed: ") +
+                           ZDICT_getErrorName(size));
+  }
+  dict.resize(size);
+  return dict;
+}
+
+std::vector<uint8_t>
+train_entry_dictionary(std::span<const std::vector<Entry>> batches,
+                       size_t max_size) {
+  std::vector<std::vector<uint8_t>> samples;
+  samples.reserve(batches.size());
+  for (const auto &batch : batches) {
+    samples.push_back(serialize_entries(batch));
+  }
+  return train_zstd_dictionary(samples, max_size);
+}
+
+// ==================== FrameEncoder ====================
+
+FrameEncoder::FrameEncoder(FrameOptions options)
+    : options_(options), cctx_(ZSTD_createCCtx()) {
+  if (!cctx_) {
+    throw std::bad_alloc();
+  }
+}
+
+FrameEncoder::~FrameEncoder() { ZSTD_freeCCtx(cctx_); }
+
+size_t FrameEncoder::encode(std::span<const uint8_t> payload,
+                            std::vector<uint8_t> &out) {
+  return append_frame(cctx_, payload, options_, out);
+}
+
+size_t FrameEncoder::encode_entries(const std::vector<Entry> &entries,
+                                    std::vector<uint8_t> &out) {
+  return encode(serialize_batch(entries, scratch_), out);
+}
+
+// ==================== FrameDecoder ====================
+
+FrameDecoder::FrameDecoder() : dctx_(ZSTD_createDCtx()) {
+  if (!dctx_) {
+    throw std::bad_alloc();
+  }
+}
+
+FrameDecoder::FrameDecoder(std::span<const ZstdDictionary *const> dictionaries)
+    : FrameDecoder() {
+  dictionaries_.assign(dictionaries.begin(), dictionaries.end());
+}
+
+FrameDecoder::~FrameDecoder() { ZSTD_freeDCtx(dctx_); }
+
+void FrameDecoder::add_dictionary(const ZstdDictionary &dictionary) {
+  dictionaries_.push_back(&dictionary);
+}
+
+void FrameDecoder::feed(std::span<const uint8_t> data) {
+  // Drop decoded bytes before growing, so the buffer stays near one frame
+  if (consumed_ > 0 && consumed_ >= pending_.size() / 2) {
+    pending_.erase(pending_.begin(),
+                   pending_.begin() + static_cast<ptrdiff_t>(consumed_));
+    consumed_ = 0;
+  }
+  pending_.insert(pending_.end(), data.begin(), data.end());
+}
+
+size_t FrameDecoder::decode(std::span<const uint8_t> data,
+                            std::vector<uint8_t> &payload) {
+  return decode_frame(dctx_, data, dictionaries_, payload);
+}
+
+bool FrameDecoder::next(std::vector<uint8_t> &payload) {
+  std::span<const uint8_t> available(pending_.data() + consumed_, buffered());
+  FrameHeader header;
+  if (!read_frame_header(available, header) ||
+      available.size() < header.frame_size()) {
+    return false;
+  }
+  consumed_ += decode(available, payload);
+  if (consumed_ == pending_.size()) {
+    pending_.clear();
+    consumed_ = 0;
+  }
+  return true;
+}
+
+bool FrameDecoder::next_entries(std::vector<Entry> &entries) {
+  if (!next(scratch_)) {
+    return false;
+  }
+  entries = deserialize_entries(std::span<const uint8_t>(scratch_));
+  return true;
+}
+
+// ==================== Parallel framing ====================
+
+std::vector<size_t> frame_offsets(std::span<const uint8_t> stream) {
+  std::vector<size_t> offsets;
+  size_t pos = 0;
+  while (pos < stream.size()) {
+    offsets.push_back(pos);
+    pos += whole_frame_header(stream.subspan(pos)).frame_size();
+  }
+  return offsets;
+}
+
+std::vector<uint8_t>
+encode_frames_parallel(std::span<const std::span<const uint8_t>> payloads,
+                       const FrameOptions &options, Executor &executor) {
+  return encode_frames(payloads.size(), options, executor,
+                       [&](size_t i, std::vector<uint8_t> &) {
+                         return payloads[i];
+                       });
+}
+
+std::vector<uint8_t>
+encode_entry_frames_parallel(std::span<const std::vector<Entry>> batches,
+                             const FrameOptions &options, Executor &executor) {
+  return encode_frames(batches.size(), options, executor,
+                       [&](size_t i, std::vector<uint8_t> &scratch) {
+                         return serialize_batch(batches[i], scratch);
+                       });
+}
+
+std::vector<std::vector<uint8_t>>
+decode_frames_parallel(std::span<const uint8_t> stream,
+                       std::span<const ZstdDictionary *const> dictionaries,
+                       Executor &executor) {
+  std::vector<size_t> offsets = frame_offsets(stream);
+  std::vector<std::vector<uint8_t>> payloads(offsets.size());
+  executor.run(offsets.size(), [&](size_t i) {
+    decode_frame(thread_dctx(), stream.subspan(offsets[i]), dictionaries,
+                 payloads[i]);
+  });
+  return payloads;
+}
+
+std::vector<std::vector<Entry>>
+decode_entry_frames_parallel(std::span<const uint8_t> stream,
+                             std::span<const ZstdDictionary *const> dictionaries,
+                             Executor &executor) {
+  std::vector<size_t> offsets = frame_offsets(stream);
+  std::vector<std::vector<Entry>> batches(offsets.size());
+  executor.run(offsets.size(), [&](size_t i) {
+    thread_local std::vector<uint8_t> scratch;
+    decode_frame(thread_dctx(), stream.subspan(offsets[i]), dictionaries,
+                 scratch);
+    batches[i] = deserialize_entries(std::span<const uint8_t>(scratch));
+  });
+  return batches;
+}
+
+} // namespace limcode
@@ -4,12 +4,310 @@
  */
 
 #include "limcode_ffi.h"
-#include "limcode.h"
+#include "ffi_account_views.h"
+#include "limcode/limcode.h"
+#include <atomic>
 #include <cstring>
 #include <new>
 
 // NOTE: Use explicit limcode:: namespace prefix for clarity with C typedefs
 
+namespace {
+
+using limcode::short_vec_size;
+
+/// Batches at least this large are encoded / walked on the executor
+constexpr size_t BULK_PARALLEL_MIN_ENTRIES = 16;
+
+// ==================== Descriptor Encoding ====================
+
+bool region_ok(const void *ptr, size_t len) { return ptr != nullptr || len == 0; }
+
+/// Encoded size of one transaction descriptor; 0 if it is malformed
+size_t desc_size(const LimcodeTransactionDesc &tx) {
+  bool v0 = tx.version == 0;
+  if ((!v0 && tx.version != LIMCODE_MESSAGE_LEGACY) ||
+      (!v0 && (tx.num_lookups != 0 ||
+               (tx.num_required_signatures & limcode::VERSION_PREFIX_MASK)))) {
+    return 0; // Unknown version, or a legacy message that would parse as v0
+  }
+  if (!region_ok(tx.signatures, tx.num_signatures) ||
+      !region_ok(tx.account_keys, tx.num_account_keys) ||
+      tx.recent_blockhash == nullptr ||
+      !region_ok(tx.instructions, tx.num_instructions) ||
+      !region_ok(tx.lookups, tx.num_lookups)) {
+    return 0;
+  }
+
+  size_t size = short_vec_size(tx.num_signatures) +
+                size_t(tx.num_signatures) * limcode::SIGNATURE_BYTES +
+                (v0 ? 1 : 0) + 3 + short_vec_size(tx.num_account_keys) +
+                size_t(tx.num_account_keys) * limcode::PUBKEY_BYTES +
+                limcode::HASH_BYTES + short_vec_size(tx.num_instructions);
+  for (uint16_t i = 0; i < tx.num_instructions; ++i) {
+    const LimcodeInstructionDesc &instr = tx.instructions[i];
+    if (!region_ok(instr.accounts, instr.num_accounts) ||
+        !region_ok(instr.data, instr.data_len)) {
+      return 0;
+    }
+    size += 1 + short_vec_size(instr.num_accounts) + instr.num_accounts +
+            short_vec_size(instr.data_len) + instr.data_len;
+  }
+  if (v0) {
+    size += short_vec_size(tx.num_lookups);
+    for (uint16_t i = 0; i < tx.num_lookups; ++i) {
+      const LimcodeLookupDesc &atl = tx.lookups[i];
+      if (atl.account_key == nullptr ||
+          !region_ok(atl.writable_indexes, atl.num_writable) ||
+          !region_ok(atl.readonly_indexes, atl.num_readonly)) {
+        return 0;
+      }
+      size += limcode::PUBKEY_BYTES + short_vec_size(atl.num_writable) +
+              atl.num_writable + short_vec_size(atl.num_readonly) +
+              atl.num_readonly;
+    }
+  }
+  return size;
+}
+
+/// Encoded size of one entry descriptor; 0 if it is malformed
+size_t desc_size(const LimcodeEntryDesc &entry) {
+  if (entry.hash == nullptr ||
+      !region_ok(entry.transactions, entry.num_transactions)) {
+    return 0;
+  }
+  size_t size = 8 + limcode::HASH_BYTES + short_vec_size(entry.num_transactions);
+  for (uint16_t i = 0; i < entry.num_transactions; ++i) {
+    size_t tx_size = desc_size(entry.transactions[i]);
+    if (tx_size == 0) {
+      return 0;
+    }
+    size += tx_size;
+  }
+  return size;
+}
+
+using DescEncoder = limcode::Encoder<limcode::UncheckedPolicy>;
+
+void write_region(DescEncoder &encoder, const uint8_t *data, size_t len) {
+  if (len > 0) {
+    encoder.write_bytes(data, len);
+  }
+}
+
+void write_prefixed(DescEncoder &encoder, const uint8_t *data, uint16_t len) {
+  encoder.write_short_vec_len(size_t(len));
+  write_region(encoder, data, len);
+}
+
+/// Same wire format as Encoder::write_versioned_transaction()
+void write_desc(DescEncoder &encoder, const LimcodeTransactionDesc &tx) {
+  encoder.write_short_vec_len(size_t(tx.num_signatures));
+  write_region(encoder, tx.signatures,
+               size_t(tx.num_signatures) * limcode::SIGNATURE_BYTES);
+  if (tx.version == 0) {
+    encoder.write_u8(limcode::VERSION_PREFIX_MASK);
+  }
+  encoder.write_u8(tx.num_required_signatures);
+  encoder.write_u8(tx.num_readonly_signed_accounts);
+  encoder.write_u8(tx.num_readonly_unsigned_accounts);
+  encoder.write_short_vec_len(size_t(tx.num_account_keys));
+  write_region(encoder, tx.account_keys,
+               size_t(tx.num_account_keys) * limcode::PUBKEY_BYTES);
+  write_region(encoder, tx.recent_blockhash, limcode::HASH_BYTES);
+
+  encoder.write_short_vec_len(size_t(tx.num_instructions));
+  for (uint16_t i = 0; i < tx.num_instructions; ++i) {
+    const LimcodeInstructionDesc &instr = tx.instructions[i];
+    encoder.write_u8(instr.program_id_index);
+    write_prefixed(encoder, instr.accounts, instr.num_accounts);
+    write_prefixed(encoder, instr.data, instr.data_len);
+  }
+
+  if (tx.version == 0) {
+    encoder.write_short_vec_len(size_t(tx.num_lookups));
+    for (uint16_t i = 0; i < tx.num_lookups; ++i) {
+      const LimcodeLookupDesc &atl = tx.lookups[i];
+      write_region(encoder, atl.account_key, limcode::PUBKEY_BYTES);
+      write_prefixed(encoder, atl.writable_indexes, atl.num_writable);
+      write_prefixed(encoder, atl.readonly_indexes, atl.num_readonly);
+    }
+  }
+}
+
+void write_desc(DescEncoder &encoder, const LimcodeEntryDesc &entry) {
+  encoder.write_u64(entry.num_hashes);
+  write_region(encoder, entry.hash, limcode::HASH_BYTES);
+  encoder.write_short_vec_len(size_t(entry.num_transactions));
+  for (uint16_t i = 0; i < entry.num_transactions; ++i) {
+    write_desc(encoder, entry.transactions[i]);
+  }
+}
+
+// ==================== Layout Decoding ====================
+
+/// Next free slot of each layout table
+struct LayoutCursor {
+  size_t transaction = 0;
+  size_t instruction = 0;
+  size_t lookup = 0;
+};
+
+/**
+ * @brief Walk one entry at the decoder's position into the layout tables
+ *
+ * Rows past a table's capacity are counted but not written, so a layout
+ * with zero capacities only counts.
+ */
+void walk_entry(limcode::StructuredZeroCopyDecoder &decoder,
+                LimcodeBlockLayout &layout, size_t entry_index,
+                LayoutCursor &cursor) {
+  LimcodeEntryLayout entry;
+  entry.num_hashes = decoder.read_u64();
+  entry.hash_offset = static_cast<uint32_t>(decoder.position());
+  decoder.skip(limcode::HASH_BYTES);
+  entry.num_transactions = decoder.read_short_vec_len();
+  entry.first_transaction = static_cast<uint32_t>(cursor.transaction);
+
+  for (uint32_t t = 0; t < entry.num_transactions; ++t) {
+    LimcodeTransactionLayout tx;
+    size_t start = decoder.position();
+    tx.offset = static_cast<uint32_t>(start);
+    tx.num_signatures = decoder.read_short_vec_len();
+    tx.signatures_offset = static_cast<uint32_t>(decoder.position());
+    decoder.skip(size_t(tx.num_signatures) * limcode::SIGNATURE_BYTES);
+
+    tx.message_offset = static_cast<uint32_t>(decoder.position());
+    uint8_t first = decoder.read_u8();
+    bool v0 = (first & limcode::VERSION_PREFIX_MASK) != 0;
+    tx.version = LIMCODE_MESSAGE_LEGACY;
+    if (v0) {
+      tx.version = first & 0x7F;
+      first = decoder.read_u8();
+    }
+    tx.num_required_signatures = first;
+    tx.num_readonly_signed_accounts = decoder.read_u8();
+    tx.num_readonly_unsigned_accounts = decoder.read_u8();
+    tx.num_account_keys = decoder.read_short_vec_len();
+    tx.account_keys_offset = static_cast<uint32_t>(decoder.position());
+    decoder.skip(size_t(tx.num_account_keys) * limcode::PUBKEY_BYTES);
+    tx.recent_blockhash_offset = static_cast<uint32_t>(decoder.position());
+    decoder.skip(limcode::HASH_BYTES);
+
+    tx.num_instructions = decoder.read_short_vec_len();
+    tx.first_instruction = static_cast<uint32_t>(cursor.instruction);
+    for (uint16_t i = 0; i < tx.num_instructions; ++i) {
+      LimcodeInstructionLayout instr;
+      instr.program_id_index = decoder.read_u8();
+      instr.num_accounts = decoder.read_short_vec_len();
+      instr.accounts_offset = static_cast<uint32_t>(decoder.position());
+      decoder.skip(instr.num_accounts);
+      instr.data_len = decoder.read_short_vec_len();
+      instr.data_offset = static_cast<uint32_t>(decoder.position());
+      decoder.skip(instr.data_len);
+      if (cursor.instruction < layout.instructions_capacity) {
+        layout.instructions[cursor.instruction] = instr;
+      }
+      ++cursor.instruction;
+    }
+
+    tx.num_lookups = 0;
+    tx.first_lookup = static_cast<uint32_t>(cursor.lookup);
+    if (v0) {
+      tx.num_lookups = decoder.read_short_vec_len();
+      for (uint16_t i = 0; i < tx.num_lookups; ++i) {
+        LimcodeLookupLayout atl;
+        atl.account_key_offset = static_cast<uint32_t>(decoder.position());
+        decoder.skip(limcode::PUBKEY_BYTES);
+        atl.num_writable = decoder.read_short_vec_len();
+        atl.writable_offset = static_cast<uint32_t>(decoder.position());
+        decoder.skip(atl.num_writable);
+        atl.num_readonly = decoder.read_short_vec_len();
+        atl.readonly_offset = static_cast<uint32_t>(decoder.position());
+        decoder.skip(atl.num_readonly);
+        if (cursor.lookup < layout.lookups_capacity) {
+          layout.lookups[cursor.lookup] = atl;
+        }
+        ++cursor.lookup;
+      }
+    }
+
+    tx.size = static_cast<uint32_t>(decoder.position() - start);
+    if (cursor.transaction < layout.transactions_capacity) {
+      layout.transactions[cursor.transaction] = tx;
+    }
+    ++cursor.transaction;
+  }
+
+  if (entry_index < layout.entries_capacity) {
+    layout.entries[entry_index] = entry;
+  }
+}
+
+bool layout_fits(const LimcodeBlockLayout &layout) {
+  return layout.num_entries <= layout.entries_capacity &&
+         layout.num_transactions <= layout.transactions_capacity &&
+         layout.num_instructions <= layout.instructions_capacity &&
+         layout.num_lookups <= layout.lookups_capacity;
+}
+
+bool layout_args_ok(const LimcodeBlockLayout &layout) {
+  return region_ok(layout.entries, layout.entries_capacity) &&
+         region_ok(layout.transactions, layout.transactions_capacity) &&
+         region_ok(layout.instructions, layout.instructions_capacity) &&
+         region_ok(layout.lookups, layout.lookups_capacity);
+}
+
+/**
+ * @brief Parallel walk: entry boundaries, per-entry counts, prefix sums,
+ *        then every entry fills its own slice of the tables
+ */
+void walk_entries_parallel(const uint8_t *data, size_t len,
+                           limcode::StructuredZeroCopyDecoder &scanner,
+                           uint64_t count, LimcodeBlockLayout &layout) {
+  std::vector<size_t> offsets(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    offsets[i] = scanner.position();
+    scanner.skip_entry();
+  }
+  layout.consumed = scanner.position();
+
+  limcode::Executor &executor = limcode::default_executor();
+  std::vector<LayoutCursor> starts(count + 1);
+  LimcodeBlockLayout counting{};
+  executor.parallel_for(count, 0, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      limcode::StructuredZeroCopyDecoder decoder(data, len);
+      decoder.skip(offsets[i]);
+      walk_entry(decoder, counting, i, starts[i + 1]);
+    }
+  });
+  for (size_t i = 1; i <= count; ++i) {
+    starts[i].transaction += starts[i - 1].transaction;
+    starts[i].instruction += starts[i - 1].instruction;
+    starts[i].lookup += starts[i - 1].lookup;
+  }
+
+  layout.num_entries = count;
+  layout.num_transactions = starts[count].transaction;
+  layout.num_instructions = starts[count].instruction;
+  layout.num_lookups = starts[count].lookup;
+  if (!layout_fits(layout)) {
+    return;
+  }
+
+  executor.parallel_for(count, 0, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      limcode::StructuredZeroCopyDecoder decoder(data, len);
+      decoder.skip(offsets[i]);
+      LayoutCursor cursor = starts[i];
+      walk_entry(decoder, layout, i, cursor);
+    }
+  });
+}
+
+} // namespace
+
 extern "C" {
 
 LimcodeEncoder *limcode_encoder_new(void) {
@@ -271,4 +569,172 @@ uint8_t *limcode_encoder_alloc_space(LimcodeEncoder *encoder, size_t bytes,
   return enc->buffer_ptr();
 }
 
+// ==================== Bulk Entry API ====================
+
+int limcode_serialize_entries(const LimcodeEntryDesc *entries,
+                              size_t num_entries, uint8_t *out,
+                              size_t out_capacity, size_t *out_len) {
+  if (!out_len || !region_ok(entries, num_entries) ||
+      !region_ok(out, out_capacity)) {
+    return LIMCODE_FFI_INVALID_ARGUMENT;
+  }
+  try {
+    const bool parallel = num_entries >= BULK_PARALLEL_MIN_ENTRIES;
+    limcode::Executor &executor = limcode::default_executor();
+
+    // Phase 1: sizes (and descriptor checks)
+    std::vector<size_t> offsets(num_entries + 1);
+    std::atomic<bool> malformed{false};
+    auto size_range = [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        offsets[i + 1] = desc_size(entries[i]);
+        if (offsets[i + 1] == 0) {
+          malformed.store(true, std::memory_order_relaxed);
+        }
+      }
+    };
+    if (parallel) {
+      executor.parallel_for(num_entries, 0, size_range);
+    } else {
+      size_range(0, num_entries);
+    }
+    if (malformed.load(std::memory_order_relaxed)) {
+      return LIMCODE_FFI_INVALID_ARGUMENT;
+    }
+    offsets[0] = 8; // u64 length prefix
+    for (size_t i = 1; i <= num_entries; ++i) {
+      offsets[i] += offsets[i - 1];
+    }
+
+    *out_len = offsets[num_entries];
+    if (*out_len > out_capacity) {
+      return LIMCODE_FFI_BUFFER_TOO_SMALL;
+    }
+
+    // Phase 2: every entry writes its own slot
+    uint64_t count = num_entries;
+    std::memcpy(out, &count, 8);
+    auto write_range = [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        DescEncoder encoder(
+            std::span<uint8_t>(out + offsets[i], offsets[i + 1] - offsets[i]));
+        write_desc(encoder, entries[i]);
+      }
+    };
+    if (parallel) {
+      executor.parallel_for(num_entries, 0, write_range);
+    } else {
+      write_range(0, num_entries);
+    }
+    return LIMCODE_FFI_OK;
+  } catch (const std::bad_alloc &) {
+    return LIMCODE_FFI_INTERNAL;
+  } catch (...) {
+    return LIMCODE_FFI_INVALID_ARGUMENT;
+  }
+}
+
+int limcode_decode_entries(const uint8_t *data, size_t len,
+                           LimcodeBlockLayout *layout) {
+  if (!layout || !data || !layout_args_ok(*layout)) {
+    return LIMCODE_FFI_INVALID_ARGUMENT;
+  }
+  if (len > UINT32_MAX) {
+    return LIMCODE_FFI_INVALID_ARGUMENT; // Offsets are 32-bit
+  }
+  layout->num_entries = layout->num_transactions = 0;
+  layout->num_instructions = layout->num_lookups = 0;
+
+  limcode::ValidationResult valid =
+      limcode::validate_entries(std::span<const uint8_t>(data, len));
+  layout->consumed = valid.consumed;
+  if (!valid) {
+    return LIMCODE_FFI_INVALID_DATA;
+  }
+
+  try {
+    limcode::StructuredZeroCopyDecoder scanner(data, len);
+    uint64_t count = scanner.read_u64();
+    if (count >= BULK_PARALLEL_MIN_ENTRIES &&
+        limcode::default_executor().concurrency() > 1) {
+      walk_entries_parallel(data, len, scanner, count, *layout);
+    } else {
+      LayoutCursor cursor;
+      for (uint64_t i = 0; i < count; ++i) {
+        walk_entry(scanner, *layout, i, cursor);
+      }
+      layout->num_entries = count;
+      layout->num_transactions = cursor.transaction;
+      layout->num_instructions = cursor.instruction;
+      layout->num_lookups = cursor.lookup;
+    }
+    return layout_fits(*layout) ? LIMCODE_FFI_OK : LIMCODE_FFI_BUFFER_TOO_SMALL;
+  } catch (const std::bad_alloc &) {
+    return LIMCODE_FFI_INTERNAL;
+  } catch (...) {
+    return LIMCODE_FFI_INVALID_DATA;
+  }
+}
+
+int limcode_validate_entries(const uint8_t *data, size_t len,
+                             size_t *consumed) {
+  if (!data && len > 0) {
+    return LIMCODE_FFI_INVALID_ARGUMENT;
+  }
+  limcode::ValidationResult valid =
+      limcode::validate_entries(std::span<const uint8_t>(data, len));
+  if (consumed) {
+    *consumed = valid.consumed;
+  }
+  return valid ? LIMCODE_FFI_OK : LIMCODE_FFI_INVALID_DATA;
+}
+
+// ==================== Snapshot Account API ====================
+
+void limcode_snapshot_stream_options_init(LimcodeSnapshotStreamOptions *options) {
+  if (!options) {
+    return;
+  }
+  limcode::snapshot::ParallelStreamOptions defaults;
+  options->num_threads = defaults.num_threads;
+  options->max_inflight_bytes = defaults.max_inflight_bytes;
+  options->read_buffer_size = defaults.read_buffer_size;
+  options->batch_size = defaults.batch_size;
+}
+
+size_t limcode_appendvec_stream(const uint8_t *data, size_t len,
+                                size_t batch_size,
+                                LimcodeAccountBatchCallback callback,
+                                void *user_data) {
+  if (!callback || (!data && len > 0)) {
+    return 0;
+  }
+  batch_size = batch_size ? batch_size : 1;
+  std::vector<LimcodeAccountView> batch;
+  batch.reserve(batch_size);
+  size_t delivered = 0;
+  bool stopped = false;
+
+  limcode::snapshot::for_each_account_view(
+      data, len, [&](const limcode::snapshot::SnapshotAccountView &view) {
+        batch.push_back(limcode::ffi::to_c_view(view));
+        if (batch.size() < batch_size) {
+          return true;
+        }
+        if (!callback(user_data, batch.data(), batch.size())) {
+          stopped = true;
+          return false;
+        }
+        delivered += batch.size();
+        batch.clear();
+        return true;
+      });
+
+  if (!stopped && !batch.empty() &&
+      callback(user_data, batch.data(), batch.size())) {
+    delivered += batch.size();
+  }
+  return delivered;
+}
+
 } // extern "C"
@@ -0,0 +1,89 @@
+/**
+ * @file limcode_snapshot_ffi.cpp
+ * @brief C FFI for the snapshot streaming pipeline (part of limcode_snapshot)
+ */
+
+#include "limcode_ffi.h"
+#include "ffi_account_views.h"
+#include "limcode/snapshot.h"
+#include <string>
+
+namespace {
+
+/// Run a stream call, mapping bad arguments and exceptions to -1
+template <typename Stream>
+int64_t guarded_stream(LimcodeAccountBatchCallback callback, Stream &&stream) {
+  if (!callback) {
+    return -1;
+  }
+  try {
+    return stream();
+  } catch (...) {
+    return -1;
+  }
+}
+
+} // namespace
+
+extern "C" {
+
+int64_t limcode_snapshot_stream(const char *snapshot_path,
+                                const LimcodeSnapshotStreamOptions *options,
+                                LimcodeAccountBatchCallback callback,
+                                void *user_data) {
+  if (!snapshot_path) {
+    return -1;
+  }
+  return guarded_stream(callback, [&] {
+    return limcode::snapshot::stream_snapshot_parallel_batches(
+        snapshot_path, limcode::ffi::forward_batches(callback, user_data),
+        limcode::ffi::to_stream_options(options));
+  });
+}
+
+int64_t limcode_snapshot_stream_cached(
+    const char *snapshot_path, const char *cache_dir,
+    const LimcodeSnapshotStreamOptions *options,
+    LimcodeAccountBatchCallback callback, void *user_data) {
+  if (!snapshot_path || !cache_dir) {
+    return -1;
+  }
+  return guarded_stream(callback, [&] {
+    return limcode::snapshot::stream_snapshot_cached(
+        snapshot_path, cache_dir,
+        limcode::ffi::forward_batches(callback, user_data),
+        limcode::ffi::to_stream_options(options));
+  });
+}
+
+int64_t limcode_snapshot_stream_unpacked(
+    const char *cache_dir, const LimcodeSnapshotStreamOptions *options,
+    LimcodeAccountBatchCallback callback, void *user_data) {
+  if (!cache_dir) {
+    return -1;
+  }
+  return guarded_stream(callback, [&] {
+    return limcode::snapshot::stream_unpacked_snapshot(
+        cache_dir, limcode::ffi::forward_batches(callback, user_data),
+        limcode::ffi::to_stream_options(options));
+  });
+}
+
+int64_t limcode_snapshot_stream_merged(
+    const char *full_path, const char *full_cache_dir,
+    const char *incremental_path, const char *incremental_cache_dir,
+    const LimcodeSnapshotStreamOptions *options,
+    LimcodeAccountBatchCallback callback, void *user_data) {
+  if (!full_path || !full_cache_dir || !incremental_path ||
+      !incremental_cache_dir) {
+    return -1;
+  }
+  return guarded_stream(callback, [&] {
+    return limcode::snapshot::stream_merged_snapshot(
+        full_path, full_cache_dir, incremental_path, incremental_cache_dir,
+        limcode::ffi::forward_batches(callback, user_data),
+        limcode::ffi::to_stream_options(options));
+  });
+}
+
+} // extern "C"
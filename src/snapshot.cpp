@@ -1,102 +1,72 @@
 #include "limcode/snapshot.h"
+#include "limcode/snapshot_arena.h"
+#include "limcode/snapshot_filter.h"
+#include "limcode/snapshot_hash.h"
+#include "limcode/snapshot_index.h"
+#include "limcode/snapshot_manifest.h"
+#include "limcode/metrics.h"
+#include "limcode/prefetch_reader.h"
 #include <archive.h>
 #include <archive_entry.h>
+#include <zstd.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
 #include <cstring>
 #include <chrono>
+#include <deque>
+#include <filesystem>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 namespace limcode {
 namespace snapshot {
 
 size_t parse_appendvec(const uint8_t* data, size_t size, std::vector<SnapshotAccount>& accounts) {
-    size_t count = 0;
-    size_t offset = 0;
-    constexpr size_t HEADER_SIZE = sizeof(AppendVecHeader);
-
-    while (offset + HEADER_SIZE <= size) {
-        const auto* header = reinterpret_cast<const AppendVecHeader*>(data + offset);
-
-        // Validate data_len
-        if (offset + HEADER_SIZE + header->data_len > size) {
-            break; // Incomplete account
-        }
-
-        SnapshotAccount account;
-        account.write_version = header->write_version;
-        account.lamports = header->lamports;
-        account.rent_epoch = header->rent_epoch;
-        account.executable = header->executable != 0;
-
-        std::memcpy(account.pubkey.data(), header->pubkey, 32);
-        std::memcpy(account.owner.data(), header->owner, 32);
-        std::memcpy(account.hash.data(), header->hash, 32);
-
-        offset += HEADER_SIZE;
-
-        // Read variable-length account data
-        if (header->data_len > 0) {
-            account.data.resize(header->data_len);
-            std::memcpy(account.data.data(), data + offset, header->data_len);
-            offset += header->data_len;
-        }
-
-        // 8-byte alignment padding
-        size_t padding = (8 - (offset % 8)) % 8;
-        offset += padding;
-
-        accounts.push_back(std::move(account));
-        count++;
-    }
-
-    return count;
+    return for_each_account_view(data, size, [&](const SnapshotAccountView& view) {
+        accounts.push_back(view.to_owned());
+        return true;
+    });
 }
 
 size_t stream_appendvec(const uint8_t* data, size_t size,
                        std::function<bool(const SnapshotAccount&)> callback) {
-    size_t count = 0;
-    size_t offset = 0;
-    constexpr size_t HEADER_SIZE = sizeof(AppendVecHeader);
-
-    while (offset + HEADER_SIZE <= size) {
-        const auto* header = reinterpret_cast<const AppendVecHeader*>(data + offset);
-
-        // Validate data_len
-        if (offset + HEADER_SIZE + header->data_len > size) {
-            break; // Incomplete account
-        }
-
-        SnapshotAccount account;
-        account.write_version = header->write_version;
-        account.lamports = header->lamports;
-        account.rent_epoch = header->rent_epoch;
-        account.executable = header->executable != 0;
+    return for_each_account_view(data, size, [&](const SnapshotAccountView& view) {
+        return callback(view.to_owned());
+    });
+}
 
-        std::memcpy(account.pubkey.data(), header->pubkey, 32);
-        std::memcpy(account.owner.data(), header->owner, 32);
-        std::memcpy(account.hash.data(), header->hash, 32);
+size_t stream_appendvec_batches(const uint8_t* data, size_t size,
+                                const AccountBatchCallback& callback,
+                                size_t batch_size,
+                                const AccountFilter* filter) {
+    if (batch_size == 0) batch_size = 1;
 
-        offset += HEADER_SIZE;
+    std::vector<SnapshotAccountView> batch;
+    batch.reserve(batch_size);
+    size_t delivered = 0;
+    bool stopped = false;
 
-        // Read variable-length account data
-        if (header->data_len > 0) {
-            account.data.resize(header->data_len);
-            std::memcpy(account.data.data(), data + offset, header->data_len);
-            offset += header->data_len;
+    for_each_matching_view(data, size, filter, [&](const SnapshotAccountView& view) {
+        batch.push_back(view);
+        if (batch.size() < batch_size) {
+            return true;
         }
-
-        // 8-byte alignment padding
-        size_t padding = (8 - (offset % 8)) % 8;
-        offset += padding;
-
-        // Call callback with account
-        if (!callback(account)) {
-            break; // User requested stop
+        if (!callback(std::span<const SnapshotAccountView>(batch))) {
+            stopped = true;
+            return false;
         }
+        delivered += batch.size();
+        batch.clear();
+        return true;
+    });
 
-        count++;
+    if (!stopped && !batch.empty() && callback(std::span<const SnapshotAccountView>(batch))) {
+        delivered += batch.size();
     }
 
-    return count;
+    return delivered;
 }
 
 bool parse_snapshot(const std::string& snapshot_path, std::vector<SnapshotAccount>& accounts) {
@@ -117,7 +87,7 @@ bool parse_snapshot(const std::string& snapshot_path, std::vector<SnapshotAccoun
         if (std::strncmp(pathname, "accounts/", 9) == 0) {
             // Read entire file into buffer
             size_t size = archive_entry_size(entry);
-            std::vector<uint8_t> buffer(size);
+            auto buffer = BufferArena::shared().acquire(size);
 
             ssize_t bytes_read = archive_read_data(a, buffer.data(), size);
             if (bytes_read > 0) {
@@ -153,7 +123,7 @@ int64_t stream_snapshot(const std::string& snapshot_path,
         if (std::strncmp(pathname, "accounts/", 9) == 0) {
             // Read entire AppendVec file
             size_t size = archive_entry_size(entry);
-            std::vector<uint8_t> buffer(size);
+            auto buffer = BufferArena::shared().acquire(size);
 
             ssize_t bytes_read = archive_read_data(a, buffer.data(), size);
             if (bytes_read > 0) {
@@ -170,6 +140,56 @@ int64_t stream_snapshot(const std::string& snapshot_path,
     return total_accounts;
 }
 
+int64_t stream_snapshot_batches(const std::string& snapshot_path,
+                                const AccountBatchCallback& callback,
+                                size_t batch_size) {
+    struct archive* a = archive_read_new();
+    archive_read_support_filter_zstd(a);
+    archive_read_support_format_tar(a);
+
+    if (archive_read_open_filename(a, snapshot_path.c_str(), 10240) != ARCHIVE_OK) {
+        archive_read_free(a);
+        return -1;
+    }
+
+    int64_t total_accounts = 0;
+    bool stopped = false;
+    struct archive_entry* entry;
+
+    // Recycled across AppendVecs; views never outlive the callback
+    BufferArena::Buffer buffer;
+
+    while (!stopped && archive_read_next_header(a, &entry) == ARCHIVE_OK) {
+        const char* pathname = archive_entry_pathname(entry);
+
+        // Look for AppendVec files in accounts/ directory
+        if (std::strncmp(pathname, "accounts/", 9) == 0) {
+            size_t size = archive_entry_size(entry);
+            if (buffer.capacity() < size) {
+                buffer = {};
+                buffer = BufferArena::shared().acquire(size);
+            }
+
+            ssize_t bytes_read = archive_read_data(a, buffer.data(), size);
+            if (bytes_read > 0) {
+                size_t count = stream_appendvec_batches(buffer.data(), bytes_read, [&](std::span<const SnapshotAccountView> batch) {
+                    if (!callback(batch)) {
+                        stopped = true;
+                        return false;
+                    }
+                    return true;
+                }, batch_size);
+                total_accounts += count;
+            }
+        }
+
+        archive_read_data_skip(a);
+    }
+
+    archive_read_free(a);
+    return total_accounts;
+}
+
 // OPTIMIZED: Direct parsing without callback overhead
 int64_t parse_snapshot_stats(const std::string& snapshot_path, SnapshotStats& stats) {
     auto start = std::chrono::high_resolution_clock::now();
@@ -194,7 +214,7 @@ int64_t parse_snapshot_stats(const std::string& snapshot_path, SnapshotStats& st
         if (std::strncmp(pathname, "accounts/", 9) == 0) {
             // Read entire AppendVec file
             size_t size = archive_entry_size(entry);
-            std::vector<uint8_t> buffer(size);
+            auto buffer = BufferArena::shared().acquire(size);
 
             ssize_t bytes_read = archive_read_data(a, buffer.data(), size);
             if (bytes_read > 0) {
@@ -244,5 +264,952 @@ int64_t parse_snapshot_stats(const std::string& snapshot_path, SnapshotStats& st
     return total_accounts;
 }
 
+// ==================== Parallel streaming pipeline ====================
+
+namespace {
+
+/// POSIX ustar header (512 bytes)
+struct TarHeader {
+    char name[100];
+    char mode[8];
+    char uid[8];
+    char gid[8];
+    char size[12];
+    char mtime[12];
+    char checksum[8];
+    char typeflag;
+    char linkname[100];
+    char magic[6];
+    char version[2];
+    char uname[32];
+    char gname[32];
+    char devmajor[8];
+    char devminor[8];
+    char prefix[155];
+    char padding[12];
+};
+
+static_assert(sizeof(TarHeader) == 512, "TarHeader must be 512 bytes");
+
+constexpr size_t TAR_BLOCK_SIZE = 512;
+
+/// Parse a tar numeric field (octal, or GNU base-256 when the high bit is set)
+inline uint64_t parse_tar_number(const char* field, size_t len) {
+    if (static_cast<uint8_t>(field[0]) & 0x80) {
+        uint64_t result = static_cast<uint8_t>(field[0]) & 0x7F;
+        for (size_t i = 1; i < len; i++) {
+            result = (result << 8) | static_cast<uint8_t>(field[i]);
+        }
+        return result;
+    }
+
+    uint64_t result = 0;
+    size_t i = 0;
+    while (i < len && field[i] == ' ') i++;
+    for (; i < len && field[i] >= '0' && field[i] <= '7'; i++) {
+        result = result * 8 + (field[i] - '0');
+    }
+    return result;
+}
+
+/// Pull-style zstd decompressor over a FILE*
+///
+/// Decompresses straight into the caller's buffer so AppendVec payloads are
+/// written exactly once.
+class ZstdFileReader {
+public:
+    explicit ZstdFileReader(const ParallelStreamOptions& options)
+        : file_(prefetch_options(options)) {}
+
+    ~ZstdFileReader() {
+        if (dctx_) ZSTD_freeDCtx(dctx_);
+    }
+
+    ZstdFileReader(const ZstdFileReader&) = delete;
+    ZstdFileReader& operator=(const ZstdFileReader&) = delete;
+
+    bool open(const std::string& path) {
+        if (!file_.open(path)) return false;
+
+        dctx_ = ZSTD_createDCtx();
+        if (!dctx_) return false;
+
+        // Solana snapshots are compressed with long-distance matching
+        return !ZSTD_isError(ZSTD_DCtx_setParameter(dctx_, ZSTD_d_windowLogMax, 31));
+    }
+
+    /// Decompress exactly `len` bytes into `dst`. Returns false on EOF or corruption.
+    bool read_exact(uint8_t* dst, size_t len) {
+        LIMCODE_METRIC_TIME(SnapshotDecompress);
+        LIMCODE_METRIC_ADD(SnapshotBytesDecompressed, len);
+        ZSTD_outBuffer out = {dst, len, 0};
+
+        while (out.pos < out.size) {
+            if (in_.pos == in_.size && !eof_) {
+                std::span<const uint8_t> chunk;
+                if (!file_.next(chunk)) {
+                    return false; // Read error
+                }
+                eof_ = chunk.empty();
+                in_ = {chunk.data(), chunk.size(), 0};
+            }
+
+            size_t before = out.pos;
+            size_t ret = ZSTD_decompressStream(dctx_, &out, &in_);
+            if (ZSTD_isError(ret)) {
+                return false;
+            }
+
+            if (out.pos == before && in_.pos == in_.size && eof_) {
+                return false; // Truncated stream
+            }
+        }
+
+        return true;
+    }
+
+    /// Decompress and discard `len` bytes
+    bool skip(size_t len) {
+        uint8_t scratch[64 * 1024];
+        while (len > 0) {
+            size_t chunk = len < sizeof(scratch) ? len : sizeof(scratch);
+            if (!read_exact(scratch, chunk)) return false;
+            len -= chunk;
+        }
+        return true;
+    }
+
+private:
+    static PrefetchOptions prefetch_options(const ParallelStreamOptions& options) {
+        PrefetchOptions out;
+        out.chunk_size = options.read_buffer_size > 0 ? options.read_buffer_size
+                                                      : ZSTD_DStreamInSize();
+        out.queue_depth = options.read_queue_depth;
+        out.direct_io = options.direct_io;
+        return out;
+    }
+
+    PrefetchReader file_;
+    ZSTD_DCtx* dctx_ = nullptr;
+    ZSTD_inBuffer in_ = {nullptr, 0, 0};
+    bool eof_ = false;
+};
+
+/// Sequential tar walker over a ZstdFileReader
+class TarStream {
+public:
+    explicit TarStream(ZstdFileReader& reader) : reader_(reader) {}
+
+    /// Advance to the next entry header (skipping any unread body)
+    ///
+    /// @return 1 on entry, 0 at end-of-archive, -1 on error
+    int next() {
+        LIMCODE_METRIC_TIME(SnapshotTar);
+        if (!skip_body()) return -1;
+
+        if (!reader_.read_exact(reinterpret_cast<uint8_t*>(&header_), TAR_BLOCK_SIZE)) {
+            return -1; // Missing end-of-archive marker
+        }
+        if (header_.name[0] == '\0') {
+            return 0;
+        }
+
+        size_ = parse_tar_number(header_.size, sizeof(header_.size));
+        padded_size_ = (size_ + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE * TAR_BLOCK_SIZE;
+        body_pending_ = true;
+
+        // ustar splits long paths into prefix + "/" + name
+        name_.assign(header_.name, strnlen(header_.name, sizeof(header_.name)));
+        if (std::memcmp(header_.magic, "ustar", 5) == 0 && header_.prefix[0] != '\0') {
+            name_ = std::string(header_.prefix, strnlen(header_.prefix, sizeof(header_.prefix))) + "/" + name_;
+        }
+        return 1;
+    }
+
+    const std::string& name() const { return name_; }
+    uint64_t size() const { return size_; }
+    bool is_file() const { return header_.typeflag == '0' || header_.typeflag == '\0'; }
+    bool is_accounts() const { return is_file() && size_ > 0 && name_.compare(0, 9, "accounts/") == 0; }
+
+    /// Read the current entry's body (exactly size() bytes) and its padding
+    bool read_body(uint8_t* dst) { return read_body_prefix(dst, size_); }
+
+    /// Read the first `len` (<= size()) body bytes, skipping the rest and the padding
+    bool read_body_prefix(uint8_t* dst, uint64_t len) {
+        body_pending_ = false;
+        return reader_.read_exact(dst, len) && reader_.skip(padded_size_ - len);
+    }
+
+    /// Stream the current entry's body to `sink` in chunks of scratch.size() bytes
+    template <typename Sink>
+    bool read_body_chunked(std::vector<uint8_t>& scratch, Sink&& sink) {
+        body_pending_ = false;
+        uint64_t remaining = size_;
+        while (remaining > 0) {
+            size_t chunk = remaining < scratch.size() ? remaining : scratch.size();
+            if (!reader_.read_exact(scratch.data(), chunk) || !sink(scratch.data(), chunk)) {
+                return false;
+            }
+            remaining -= chunk;
+        }
+        return reader_.skip(padded_size_ - size_);
+    }
+
+private:
+    bool skip_body() {
+        if (!body_pending_) return true;
+        body_pending_ = false;
+        return reader_.skip(padded_size_);
+    }
+
+    ZstdFileReader& reader_;
+    TarHeader header_;
+    std::string name_;
+    uint64_t size_ = 0;
+    uint64_t padded_size_ = 0;
+    bool body_pending_ = false;
+};
+
+/// Decode a manifest body; a manifest this decoder can't read is ignored
+bool decode_manifest(const std::vector<uint8_t>& body, SnapshotManifest& out) {
+    try {
+        out = deserialize_manifest(body);
+        return true;
+    } catch (const LimcodeError&) {
+        return false;
+    }
+}
+
+/// Bytes of accounts/SLOT.ID worth parsing: the manifest's current_len if it lists the file
+uint64_t valid_appendvec_len(const SnapshotManifest* manifest, const std::string& name,
+                             uint64_t file_size) {
+    uint64_t slot;
+    uint64_t appendvec_id;
+    const AccountStorageInfo* storage = nullptr;
+    if (manifest && parse_appendvec_name(name.c_str(), slot, appendvec_id)) {
+        storage = manifest->find_storage(slot, appendvec_id);
+    }
+    return storage ? std::min(storage->current_len, file_size) : file_size;
+}
+
+/// One decompressed accounts/SLOT.ID file
+struct AppendVecWork {
+    BufferArena::Buffer data;
+    uint64_t slot = 0;
+    uint64_t appendvec_id = 0;
+};
+
+/// Bounded queue of AppendVec buffers
+///
+/// The byte budget covers buffers from reserve() until release(), so it
+/// also accounts for AppendVecs being read in or still being parsed.
+/// Reserving before the buffer is acquired keeps the arena within budget too.
+class AppendVecQueue {
+public:
+    explicit AppendVecQueue(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+    /// Blocks until the budget admits `bytes` more. Returns false if cancelled.
+    bool reserve(size_t bytes) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_cv_.wait(lock, [&] {
+            return cancelled_ || inflight_bytes_ == 0 ||
+                   inflight_bytes_ + bytes <= max_bytes_;
+        });
+        if (cancelled_) return false;
+
+        inflight_bytes_ += bytes;
+        return true;
+    }
+
+    /// Queue a buffer whose bytes were reserve()d. Returns false if cancelled.
+    bool push(AppendVecWork&& work) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cancelled_) return false;
+
+        items_.push_back(std::move(work));
+        items_cv_.notify_one();
+        return true;
+    }
+
+    /// Blocks for the next buffer. Returns false once closed and drained.
+    bool pop(AppendVecWork& work) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        items_cv_.wait(lock, [&] { return cancelled_ || closed_ || !items_.empty(); });
+        if (cancelled_ || items_.empty()) return false;
+
+        work = std::move(items_.front());
+        items_.pop_front();
+        return true;
+    }
+
+    /// Return a popped buffer's bytes to the budget
+    void release(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inflight_bytes_ -= bytes;
+        space_cv_.notify_one();
+    }
+
+    /// No more buffers will be pushed
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        items_cv_.notify_all();
+    }
+
+    /// Drop queued buffers and wake everyone
+    void cancel() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancelled_ = true;
+        items_.clear();
+        items_cv_.notify_all();
+        space_cv_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable items_cv_;
+    std::condition_variable space_cv_;
+    std::deque<AppendVecWork> items_;
+    size_t max_bytes_;
+    size_t inflight_bytes_ = 0;
+    bool closed_ = false;
+    bool cancelled_ = false;
+};
+
+inline unsigned resolve_num_threads(const ParallelStreamOptions& options) {
+    unsigned num_threads = options.num_threads;
+    if (num_threads == 0) {
+        num_threads = std::thread::hardware_concurrency();
+        if (num_threads == 0) num_threads = 1;
+    }
+    return num_threads;
+}
+
+/// Decompress + walk tar on the calling thread, parse AppendVecs on workers
+///
+/// `parse_buffer(data, size, collector, hasher)` runs on a worker thread and
+/// returns the number of accounts it delivered; it sets `stop` when the
+/// consumer asks to stop. Delivered accounts are passed to `collector` for the
+/// optional index and to `hasher`, the worker's accounts hash partial sum.
+template <typename ParseBuffer>
+int64_t run_parallel_pipeline(const std::string& snapshot_path,
+                              const ParallelStreamOptions& options,
+                              std::atomic<bool>& stop,
+                              ParseBuffer&& parse_buffer) {
+    ZstdFileReader reader(options);
+    if (!reader.open(snapshot_path)) {
+        return -1;
+    }
+
+    unsigned num_threads = resolve_num_threads(options);
+
+    AppendVecQueue queue(options.max_inflight_bytes);
+    std::atomic<int64_t> total_accounts{0};
+
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (unsigned i = 0; i < num_threads; i++) {
+        workers.emplace_back([&] {
+            AccountsHasher::Partial hasher(options.accounts_hasher);
+            AppendVecWork work;
+            while (queue.pop(work)) {
+                size_t count;
+                {
+                    LIMCODE_METRIC_TIME(SnapshotParse);
+                    AccountIndexBuilder::Collector collector(options.index_builder, work.slot,
+                                                             work.appendvec_id, work.data.data());
+                    count = parse_buffer(work.data.data(), work.data.size(), collector, hasher);
+                }
+                LIMCODE_METRIC_ADD(SnapshotAppendVecs, 1);
+                LIMCODE_METRIC_ADD(SnapshotAccounts, count);
+                total_accounts.fetch_add(static_cast<int64_t>(count), std::memory_order_relaxed);
+                // Back to the arena before the budget admits the next AppendVec
+                size_t bytes = work.data.size();
+                work.data.reset();
+                queue.release(bytes);
+
+                if (stop.load(std::memory_order_relaxed)) {
+                    queue.cancel();
+                }
+            }
+        });
+    }
+
+    bool ok = true;
+    TarStream tar(reader);
+    SnapshotManifest manifest;
+    bool have_manifest = false;
+    BufferArena& arena = options.arena ? *options.arena : BufferArena::shared();
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        int status = tar.next();
+        if (status <= 0) {
+            ok = status == 0;
+            break;
+        }
+        if (tar.is_file() && is_manifest_path(tar.name())) {
+            // Agave archives put snapshots/ ahead of accounts/
+            std::vector<uint8_t> body(tar.size());
+            if (!tar.read_body(body.data())) {
+                ok = false;
+                break;
+            }
+            have_manifest = decode_manifest(body, manifest);
+            continue;
+        }
+        if (!tar.is_accounts()) {
+            continue;
+        }
+
+        AppendVecWork work;
+        if (options.index_builder &&
+            !parse_appendvec_name(tar.name().c_str(), work.slot, work.appendvec_id)) {
+            ok = false; // Index entries need SLOT.ID
+            break;
+        }
+
+        size_t len = valid_appendvec_len(have_manifest ? &manifest : nullptr, tar.name(), tar.size());
+        if (!queue.reserve(len)) {
+            break; // Cancelled by consumer
+        }
+        work.data = arena.acquire(len);
+        if (!tar.read_body_prefix(work.data.data(), work.data.size())) {
+            ok = false;
+            break;
+        }
+
+        if (!queue.push(std::move(work))) {
+            break; // Cancelled by consumer
+        }
+    }
+
+    if (ok) {
+        queue.close();
+    } else {
+        queue.cancel();
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (ok && have_manifest && options.manifest) {
+        *options.manifest = std::move(manifest);
+    }
+    return ok ? total_accounts.load() : -1;
+}
+
+} // namespace
+
+int64_t stream_snapshot_parallel(const std::string& snapshot_path,
+                                 std::function<bool(const SnapshotAccount&)> callback,
+                                 const ParallelStreamOptions& options) {
+    std::atomic<bool> stop{false};
+
+    return run_parallel_pipeline(snapshot_path, options, stop, [&](const uint8_t* data, size_t size,
+                                                                    AccountIndexBuilder::Collector& collector,
+                                                                    AccountsHasher::Partial& hasher) {
+        return for_each_matching_view(data, size, options.filter, [&](const SnapshotAccountView& view) {
+            if (stop.load(std::memory_order_relaxed) || !callback(view.to_owned())) {
+                stop.store(true, std::memory_order_relaxed);
+                return false;
+            }
+            collector.add(view);
+            hasher.add(view);
+            return true;
+        });
+    });
+}
+
+int64_t stream_snapshot_parallel_batches(const std::string& snapshot_path,
+                                         const AccountBatchCallback& callback,
+                                         const ParallelStreamOptions& options) {
+    std::atomic<bool> stop{false};
+
+    return run_parallel_pipeline(snapshot_path, options, stop, [&](const uint8_t* data, size_t size,
+                                                                    AccountIndexBuilder::Collector& collector,
+                                                                    AccountsHasher::Partial& hasher) {
+        return stream_appendvec_batches(data, size, [&](std::span<const SnapshotAccountView> batch) {
+            if (stop.load(std::memory_order_relaxed) || !callback(batch)) {
+                stop.store(true, std::memory_order_relaxed);
+                return false;
+            }
+            for (const auto& view : batch) {
+                collector.add(view);
+                hasher.add(view);
+            }
+            return true;
+        }, options.batch_size, options.filter);
+    });
+}
+
+// ==================== Unpacked snapshot cache ====================
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr const char* UNPACKED_MARKER = ".limcode-unpacked";
+constexpr size_t UNPACK_CHUNK_SIZE = size_t(4) << 20;
+
+/// Reject absolute paths and ".." components from archive entries
+bool is_safe_archive_path(const std::string& name) {
+    if (name.empty() || name[0] == '/') return false;
+    for (const auto& part : fs::path(name)) {
+        if (part == "..") return false;
+    }
+    return true;
+}
+
+/// Identifies the archive a cache was extracted from: a cache is reused only
+/// while the archive keeps the size and modification time it had
+struct ArchiveStamp {
+    uint64_t size = 0;
+    int64_t mtime = 0;   // file_time_type ticks
+
+    bool operator==(const ArchiveStamp&) const = default;
+};
+
+bool stat_archive(const std::string& snapshot_path, ArchiveStamp& out) {
+    std::error_code ec;
+    out.size = fs::file_size(snapshot_path, ec);
+    if (ec) return false;
+    out.mtime = static_cast<int64_t>(fs::last_write_time(snapshot_path, ec).time_since_epoch().count());
+    return !ec;
+}
+
+/// Marker contents: "<archive size> <archive mtime> <appendvecs>"
+bool read_unpacked_marker(const std::string& cache_dir, ArchiveStamp& stamp) {
+    FILE* marker = std::fopen((fs::path(cache_dir) / UNPACKED_MARKER).c_str(), "rb");
+    if (!marker) return false;
+    unsigned long long size = 0;
+    long long mtime = 0;
+    long long appendvecs = 0;
+    bool ok = std::fscanf(marker, "%llu %lld %lld", &size, &mtime, &appendvecs) == 3;
+    std::fclose(marker);
+    stamp.size = size;
+    stamp.mtime = mtime;
+    return ok;
+}
+
+struct CachedAppendVec {
+    std::string path;
+    uint64_t slot;
+    uint64_t appendvec_id;
+    uint64_t valid_len;   // File size, or the manifest's current_len
+};
+
+/// Decode the cache's snapshots/SLOT/SLOT, if it has one this decoder can read
+bool load_cached_manifest(const fs::path& cache_dir, SnapshotManifest& out) {
+    std::error_code ec;
+    for (const auto& dirent : fs::directory_iterator(cache_dir / "snapshots", ec)) {
+        std::string slot = dirent.path().filename().string();
+        fs::path path = dirent.path() / slot;
+        if (!is_manifest_path("snapshots/" + slot + "/" + slot) || !fs::is_regular_file(path, ec)) {
+            continue;
+        }
+        std::vector<uint8_t> body(fs::file_size(path, ec));
+        FILE* in = ec ? nullptr : std::fopen(path.c_str(), "rb");
+        if (!in) continue;
+        bool read = std::fread(body.data(), 1, body.size(), in) == body.size();
+        std::fclose(in);
+        if (read && decode_manifest(body, out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int64_t unpack_snapshot(const std::string& snapshot_path, const std::string& cache_dir,
+                        const ParallelStreamOptions& options) {
+    ArchiveStamp stamp;
+    ZstdFileReader reader(options);
+    if (cache_dir.empty() || !stat_archive(snapshot_path, stamp) || !reader.open(snapshot_path)) {
+        return -1;
+    }
+
+    std::error_code ec;
+    fs::create_directories(cache_dir, ec);
+    if (ec) return -1;
+
+    // Invalidate any previous extraction until this one completes, then
+    // clear it out: files the new archive lacks would otherwise be scanned
+    fs::remove(fs::path(cache_dir) / UNPACKED_MARKER, ec);
+    if (ec) return -1;
+    for (const auto& dirent : fs::directory_iterator(cache_dir, ec)) {
+        fs::remove_all(dirent.path(), ec);
+        if (ec) return -1;
+    }
+    if (ec) return -1;
+
+    TarStream tar(reader);
+    std::vector<uint8_t> scratch(UNPACK_CHUNK_SIZE);
+    int64_t appendvecs = 0;
+
+    while (true) {
+        int status = tar.next();
+        if (status < 0) return -1;
+        if (status == 0) break;
+
+        if (!tar.is_file() || !is_safe_archive_path(tar.name())) {
+            continue;
+        }
+
+        fs::path out_path = fs::path(cache_dir) / tar.name();
+        fs::create_directories(out_path.parent_path(), ec);
+        if (ec) return -1;
+
+        FILE* out = std::fopen(out_path.c_str(), "wb");
+        if (!out) return -1;
+
+        bool ok = tar.read_body_chunked(scratch, [&](const uint8_t* data, size_t len) {
+            return std::fwrite(data, 1, len, out) == len;
+        });
+        ok = (std::fclose(out) == 0) && ok;
+        if (!ok) return -1;
+
+        if (tar.is_accounts()) {
+            appendvecs++;
+        }
+    }
+
+    FILE* marker = std::fopen((fs::path(cache_dir) / UNPACKED_MARKER).c_str(), "wb");
+    if (!marker) return -1;
+    bool ok = std::fprintf(marker, "%llu %lld %lld\n", static_cast<unsigned long long>(stamp.size),
+                           static_cast<long long>(stamp.mtime), static_cast<long long>(appendvecs)) > 0;
+    ok = (std::fclose(marker) == 0) && ok;
+
+    return ok ? appendvecs : -1;
+}
+
+bool is_unpacked_snapshot(const std::string& cache_dir) {
+    ArchiveStamp stamp;
+    return read_unpacked_marker(cache_dir, stamp);
+}
+
+bool is_unpacked_snapshot(const std::string& cache_dir, const std::string& snapshot_path) {
+    ArchiveStamp cached;
+    ArchiveStamp current;
+    return read_unpacked_marker(cache_dir, cached) && stat_archive(snapshot_path, current) &&
+           cached == current;
+}
+
+int64_t stream_unpacked_snapshot(const std::string& cache_dir,
+                                 const AccountBatchCallback& callback,
+                                 const ParallelStreamOptions& options) {
+    if (!is_unpacked_snapshot(cache_dir)) {
+        return -1;
+    }
+
+    SnapshotManifest manifest;
+    bool have_manifest = load_cached_manifest(cache_dir, manifest);
+
+    std::vector<CachedAppendVec> files;
+    std::error_code ec;
+    for (const auto& dirent : fs::directory_iterator(fs::path(cache_dir) / "accounts", ec)) {
+        CachedAppendVec file;
+        if (dirent.is_regular_file(ec) &&
+            parse_appendvec_name(dirent.path().filename().c_str(), file.slot, file.appendvec_id)) {
+            file.path = dirent.path().string();
+            file.valid_len = dirent.file_size(ec);
+            if (have_manifest) {
+                if (const auto* storage = manifest.find_storage(file.slot, file.appendvec_id)) {
+                    file.valid_len = std::min(file.valid_len, storage->current_len);
+                }
+            }
+            files.push_back(std::move(file));
+        }
+    }
+    if (ec) return -1;
+
+    // Largest first so one big AppendVec doesn't finish alone at the end;
+    // ties in (slot, id) order so the same cache is always scanned alike
+    std::sort(files.begin(), files.end(), [](const CachedAppendVec& a, const CachedAppendVec& b) {
+        if (a.valid_len != b.valid_len) return a.valid_len > b.valid_len;
+        return a.slot != b.slot ? a.slot < b.slot : a.appendvec_id < b.appendvec_id;
+    });
+
+    unsigned num_threads = resolve_num_threads(options);
+    if (num_threads > files.size()) {
+        num_threads = files.empty() ? 1 : static_cast<unsigned>(files.size());
+    }
+
+    std::atomic<size_t> next_file{0};
+    std::atomic<int64_t> total_accounts{0};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> failed{false};
+
+    auto worker = [&] {
+        AccountsHasher::Partial hasher(options.accounts_hasher);
+        while (!stop.load(std::memory_order_relaxed)) {
+            size_t i = next_file.fetch_add(1, std::memory_order_relaxed);
+            if (i >= files.size()) break;
+
+            MappedFile file;
+            if (!file.open(files[i].path.c_str(), MADV_SEQUENTIAL)) {
+                failed.store(true, std::memory_order_relaxed);
+                stop.store(true, std::memory_order_relaxed);
+                break;
+            }
+
+            // Start read-ahead of the whole file; collapse into huge pages if supported
+            file.advise(MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+            file.advise(MADV_HUGEPAGE);
+#endif
+
+            AccountIndexBuilder::Collector collector(options.index_builder, files[i].slot,
+                                                     files[i].appendvec_id, file.data());
+            size_t count = stream_appendvec_batches(file.data(),
+                                                    std::min<uint64_t>(file.size(), files[i].valid_len),
+                                                    [&](std::span<const SnapshotAccountView> batch) {
+                if (stop.load(std::memory_order_relaxed) || !callback(batch)) {
+                    stop.store(true, std::memory_order_relaxed);
+                    return false;
+                }
+                for (const auto& view : batch) {
+                    collector.add(view);
+                    hasher.add(view);
+                }
+                return true;
+            }, options.batch_size, options.filter);
+
+            total_accounts.fetch_add(static_cast<int64_t>(count), std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (unsigned t = 1; t < num_threads; t++) {
+        workers.emplace_back(worker);
+    }
+    worker(); // Calling thread takes a share of the files
+
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    if (!failed.load() && have_manifest && options.manifest) {
+        *options.manifest = std::move(manifest);
+    }
+    return failed.load() ? -1 : total_accounts.load();
+}
+
+int64_t stream_snapshot_cached(const std::string& snapshot_path, const std::string& cache_dir,
+                               const AccountBatchCallback& callback,
+                               const ParallelStreamOptions& options) {
+    if (!is_unpacked_snapshot(cache_dir, snapshot_path) && unpack_snapshot(snapshot_path, cache_dir, options) < 0) {
+        return -1;
+    }
+    return stream_unpacked_snapshot(cache_dir, callback, options);
+}
+
+
+// ==================== Full + incremental merge ====================
+
+namespace {
+
+constexpr const char* MERGED_INDEX_NAME = "merged.index";
+constexpr size_t MERGE_CHUNK_ENTRIES = 64 * 1024;
+
+/// One mapped AppendVec of either cache, looked up by (slot, id)
+struct MergeSource {
+    uint64_t slot;
+    uint64_t appendvec_id;
+    uint64_t valid_len;
+    MappedFile file;
+};
+
+/// Map every accounts/SLOT.ID of an unpacked cache (capped at the manifest's current_len)
+bool map_cache_appendvecs(const fs::path& cache_dir, std::vector<MergeSource>& out) {
+    SnapshotManifest manifest;
+    bool have_manifest = load_cached_manifest(cache_dir, manifest);
+
+    std::error_code ec;
+    for (const auto& dirent : fs::directory_iterator(cache_dir / "accounts", ec)) {
+        MergeSource source;
+        if (!dirent.is_regular_file(ec) ||
+            !parse_appendvec_name(dirent.path().filename().c_str(), source.slot, source.appendvec_id)) {
+            continue;
+        }
+        // Point lookups in pubkey order: no read-ahead
+        if (!source.file.open(dirent.path().c_str(), MADV_RANDOM)) {
+            return false;
+        }
+        source.valid_len = source.file.size();
+        if (have_manifest) {
+            if (const auto* storage = manifest.find_storage(source.slot, source.appendvec_id)) {
+                source.valid_len = std::min(source.valid_len, storage->current_len);
+            }
+        }
+        out.push_back(std::move(source));
+    }
+    return !ec;
+}
+
+/// Identity of the two caches a merged index is built from: the archive
+/// stamps their completion markers record
+bool merged_source_stamp(const std::string& full_cache_dir, const std::string& incremental_cache_dir,
+                         std::array<uint64_t, 4>& out) {
+    ArchiveStamp full;
+    ArchiveStamp incremental;
+    if (!read_unpacked_marker(full_cache_dir, full) || !read_unpacked_marker(incremental_cache_dir, incremental)) {
+        return false;
+    }
+    out = {full.size, static_cast<uint64_t>(full.mtime), incremental.size, static_cast<uint64_t>(incremental.mtime)};
+    return true;
+}
+
+} // namespace
+
+int64_t stream_merged_snapshot(const std::string& full_path, const std::string& full_cache_dir,
+                               const std::string& incremental_path, const std::string& incremental_cache_dir,
+                               const AccountBatchCallback& callback,
+                               const ParallelStreamOptions& options) {
+    for (const auto& [path, cache] : {std::pair(&full_path, &full_cache_dir),
+                                      std::pair(&incremental_path, &incremental_cache_dir)}) {
+        if (!is_unpacked_snapshot(*cache, *path) && unpack_snapshot(*path, *cache, options) < 0) {
+            return -1;
+        }
+    }
+
+    // One index over both caches keeps the newest (slot, write_version) per pubkey;
+    // incremental AppendVecs are all past the full slot, so (slot, id) never collides
+    // Reused only if it was built from these two extractions
+    fs::path index_path = fs::path(incremental_cache_dir) / MERGED_INDEX_NAME;
+    std::array<uint64_t, 4> source_stamp;
+    if (!merged_source_stamp(full_cache_dir, incremental_cache_dir, source_stamp)) {
+        return -1;
+    }
+    AccountIndex index;
+    if (!index.open(index_path.string()) || index.source_stamp() != source_stamp) {
+        AccountIndexBuilder builder(index_path.string());
+        builder.set_source_stamp(source_stamp);
+        ParallelStreamOptions index_options = options;
+        index_options.index_builder = &builder;
+        index_options.manifest = nullptr;
+        index_options.filter = nullptr;   // Newest version must win before filtering
+        index_options.accounts_hasher = nullptr;   // Would mix in every version
+        auto ignore = [](std::span<const SnapshotAccountView>) { return true; };
+        if (stream_unpacked_snapshot(full_cache_dir, ignore, index_options) < 0 ||
+            stream_unpacked_snapshot(incremental_cache_dir, ignore, index_options) < 0 ||
+            builder.finish() < 0 || !index.open(index_path.string())) {
+            return -1;
+        }
+    }
+
+    std::vector<MergeSource> sources;
+    if (!map_cache_appendvecs(full_cache_dir, sources) ||
+        !map_cache_appendvecs(incremental_cache_dir, sources)) {
+        return -1;
+    }
+    std::sort(sources.begin(), sources.end(), [](const MergeSource& a, const MergeSource& b) {
+        return a.slot != b.slot ? a.slot < b.slot : a.appendvec_id < b.appendvec_id;
+    });
+    auto find_source = [&](const AccountIndexEntry& entry) -> const MergeSource* {
+        auto it = std::lower_bound(sources.begin(), sources.end(), entry, [](const MergeSource& s, const AccountIndexEntry& e) {
+            return s.slot != e.slot ? s.slot < e.slot : s.appendvec_id < e.appendvec_id;
+        });
+        return it != sources.end() && it->slot == entry.slot && it->appendvec_id == entry.appendvec_id ? &*it : nullptr;
+    };
+
+    std::span<const AccountIndexEntry> entries = index.entries();
+    size_t num_chunks = (entries.size() + MERGE_CHUNK_ENTRIES - 1) / MERGE_CHUNK_ENTRIES;
+    unsigned num_threads = resolve_num_threads(options);
+    if (num_threads > num_chunks) {
+        num_threads = num_chunks == 0 ? 1 : static_cast<unsigned>(num_chunks);
+    }
+    size_t batch_size = std::max<size_t>(options.batch_size, 1);
+
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<int64_t> total_accounts{0};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> failed{false};
+
+    auto worker = [&] {
+        AccountsHasher::Partial hasher(options.accounts_hasher);
+        std::vector<const AccountIndexEntry*> order;
+        std::vector<SnapshotAccountView> batch;
+        batch.reserve(batch_size);
+
+        auto deliver = [&] {
+            if (batch.empty()) return true;
+            if (stop.load(std::memory_order_relaxed) || !callback(batch)) {
+                stop.store(true, std::memory_order_relaxed);
+                return false;
+            }
+            total_accounts.fetch_add(static_cast<int64_t>(batch.size()), std::memory_order_relaxed);
+            batch.clear();
+            return true;
+        };
+
+        while (!stop.load(std::memory_order_relaxed)) {
+            size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= num_chunks) break;
+
+            // Visit a chunk of pubkeys in file order so reads stay mostly sequential
+            auto range = entries.subspan(chunk * MERGE_CHUNK_ENTRIES,
+                                         std::min(MERGE_CHUNK_ENTRIES, entries.size() - chunk * MERGE_CHUNK_ENTRIES));
+            order.clear();
+            for (const auto& entry : range) {
+                order.push_back(&entry);
+            }
+            std::sort(order.begin(), order.end(), [](const AccountIndexEntry* a, const AccountIndexEntry* b) {
+                if (a->slot != b->slot) return a->slot < b->slot;
+                return a->appendvec_id != b->appendvec_id ? a->appendvec_id < b->appendvec_id
+                                                          : a->offset < b->offset;
+            });
+
+            for (const AccountIndexEntry* entry : order) {
+                const MergeSource* source = find_source(*entry);
+                if (!source || entry->offset + sizeof(AppendVecHeader) > source->valid_len) {
+                    failed.store(true, std::memory_order_relaxed);
+                    stop.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                const auto* header = reinterpret_cast<const AppendVecHeader*>(source->file.data() + entry->offset);
+                if (header->data_len > source->valid_len - entry->offset - sizeof(AppendVecHeader)) {
+                    failed.store(true, std::memory_order_relaxed);
+                    stop.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                SnapshotAccountView view;
+                view.header = header;
+                view.data = std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(header + 1), header->data_len);
+                // The bank hash covers every newest version, delivered or not
+                hasher.add(view);
+
+                // A zero-lamport newest version means the account was deleted
+                if ((header->lamports == 0 && !options.keep_zero_lamport) ||
+                    (options.filter && !options.filter->matches(*header))) {
+                    continue;
+                }
+                batch.push_back(view);
+                if (batch.size() >= batch_size && !deliver()) return;
+            }
+            if (!deliver()) return;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (unsigned t = 1; t < num_threads; t++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    if (failed.load()) return -1;
+    if (options.manifest) {
+        load_cached_manifest(incremental_cache_dir, *options.manifest);
+    }
+    return total_accounts.load();
+}
+
 } // namespace snapshot
 } // namespace limcode
@@ -0,0 +1,293 @@
+#include "limcode/snapshot_columns.h"
+#include "limcode/snapshot_filter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+
+namespace limcode {
+namespace snapshot {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char COLUMNS_MAGIC[8] = {'L', 'I', 'M', 'C', 'C', 'O', 'L', '1'};
+constexpr const char* META_NAME = "columns.meta";
+constexpr const char* COLUMN_NAMES[] = {"pubkey.bin", "owner.bin", "lamports.bin", "rent_epoch.bin",
+                                        "data_len.bin", "write_version.bin", "executable.bin",
+                                        "data_offset.bin", "data.bin"};
+
+/// Owner keys are already uniformly distributed; any 8 bytes make a hash
+struct OwnerHash {
+    size_t operator()(const std::array<uint8_t, 32>& key) const noexcept {
+        uint64_t h;
+        std::memcpy(&h, key.data(), sizeof(h));
+        return static_cast<size_t>(h);
+    }
+};
+
+using OwnerMap = std::unordered_map<std::array<uint8_t, 32>, OwnerTotals, OwnerHash>;
+
+bool write_block(FILE* file, const void* data, size_t len) {
+    return len == 0 || std::fwrite(data, 1, len, file) == len;
+}
+
+} // namespace
+
+// ==================== AccountColumnsBuilder ====================
+
+AccountColumnsBuilder::AccountColumnsBuilder(std::string dir, bool include_data)
+    : dir_(std::move(dir)), include_data_(include_data) {}
+
+AccountColumnsBuilder::~AccountColumnsBuilder() {
+    close_files();
+}
+
+bool AccountColumnsBuilder::open_locked() {
+    opened_ = true;
+    std::error_code ec;
+    fs::create_directories(dir_, ec);
+    if (ec) return false;
+
+    // Invalidate any previous export until this one completes
+    fs::remove(fs::path(dir_) / META_NAME, ec);
+    if (!include_data_) {
+        fs::remove(fs::path(dir_) / COLUMN_NAMES[DATA_OFFSET], ec);
+        fs::remove(fs::path(dir_) / COLUMN_NAMES[DATA], ec);
+    }
+
+    int count = include_data_ ? COLUMN_COUNT : DATA_OFFSET;
+    for (int c = 0; c < count; ++c) {
+        files_[c] = std::fopen((fs::path(dir_) / COLUMN_NAMES[c]).c_str(), "wb");
+        if (!files_[c]) return false;
+    }
+    return true;
+}
+
+void AccountColumnsBuilder::close_files() {
+    for (auto& file : files_) {
+        if (file) {
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+}
+
+bool AccountColumnsBuilder::add_batch(std::span<const SnapshotAccountView> batch) {
+    // Transpose outside the lock; copying into the files is all that's serialized
+    size_t n = batch.size();
+    std::vector<uint8_t> keys(n * 64);
+    std::vector<uint64_t> words(n * 4);
+    std::vector<uint8_t> executable(n);
+    std::vector<uint64_t> offsets(include_data_ ? n : 0);
+    size_t data_len = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const AppendVecHeader* h = batch[i].header;
+        std::memcpy(&keys[i * 32], h->pubkey, 32);
+        std::memcpy(&keys[(n + i) * 32], h->owner, 32);
+        words[i] = h->lamports;
+        words[n + i] = h->rent_epoch;
+        words[2 * n + i] = h->data_len;
+        words[3 * n + i] = h->write_version;
+        executable[i] = h->executable;
+        if (include_data_) {
+            offsets[i] = data_len;   // Rebased onto data_bytes_ under the lock
+        }
+        data_len += batch[i].data.size();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!opened_ && !open_locked()) failed_ = true;
+    if (failed_) return false;
+
+    for (auto& offset : offsets) {
+        offset += data_bytes_;
+    }
+    bool ok = write_block(files_[PUBKEY], keys.data(), n * 32) &&
+              write_block(files_[OWNER], keys.data() + n * 32, n * 32) &&
+              write_block(files_[LAMPORTS], words.data(), n * 8) &&
+              write_block(files_[RENT_EPOCH], words.data() + n, n * 8) &&
+              write_block(files_[DATA_LEN], words.data() + 2 * n, n * 8) &&
+              write_block(files_[WRITE_VERSION], words.data() + 3 * n, n * 8) &&
+              write_block(files_[EXECUTABLE], executable.data(), n);
+    if (ok && include_data_) {
+        ok = write_block(files_[DATA_OFFSET], offsets.data(), n * 8);
+        for (size_t i = 0; ok && i < n; ++i) {
+            ok = write_block(files_[DATA], batch[i].data.data(), batch[i].data.size());
+        }
+    }
+    if (!ok) {
+        failed_ = true;
+        return false;
+    }
+    rows_ += n;
+    data_bytes_ += data_len;
+    return true;
+}
+
+int64_t AccountColumnsBuilder::finish() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!opened_ && !open_locked()) failed_ = true;
+
+    // data_offset.bin ends with the heap size so row i spans [off[i], off[i + 1])
+    bool ok = !failed_ && (!include_data_ || write_block(files_[DATA_OFFSET], &data_bytes_, 8));
+    for (auto& file : files_) {
+        if (file) {
+            ok = (std::fclose(file) == 0) && ok;
+            file = nullptr;
+        }
+    }
+    if (!ok) {
+        failed_ = true;
+        return -1;
+    }
+
+    ColumnFileHeader header{};
+    std::memcpy(header.magic, COLUMNS_MAGIC, sizeof(COLUMNS_MAGIC));
+    header.version = ACCOUNT_COLUMNS_VERSION;
+    header.flags = include_data_ ? COLUMN_FLAG_HAS_DATA : 0;
+    header.row_count = rows_;
+    header.data_bytes = data_bytes_;
+
+    FILE* meta = std::fopen((fs::path(dir_) / META_NAME).c_str(), "wb");
+    if (!meta) return -1;
+    ok = std::fwrite(&header, sizeof(header), 1, meta) == 1;
+    ok = (std::fclose(meta) == 0) && ok;
+    return ok ? static_cast<int64_t>(rows_) : -1;
+}
+
+// ==================== AccountColumns ====================
+
+template <typename T>
+bool AccountColumns::map_column(const std::string& dir, const char* name, size_t count,
+                                MappedFile& file, std::span<const T>& out) {
+    // Column scans read front to back
+    if (!file.open((fs::path(dir) / name).c_str(), MADV_SEQUENTIAL) || file.size() < count * sizeof(T)) {
+        return false;
+    }
+    out = count == 0 ? std::span<const T>() : std::span<const T>(reinterpret_cast<const T*>(file.data()), count);
+    return true;
+}
+
+bool AccountColumns::open(const std::string& dir) {
+    *this = AccountColumns();
+
+    MappedFile meta;
+    ColumnFileHeader header;
+    if (!meta.open((fs::path(dir) / META_NAME).c_str()) || meta.size() < sizeof(header)) return false;
+    std::memcpy(&header, meta.data(), sizeof(header));
+    if (std::memcmp(header.magic, COLUMNS_MAGIC, sizeof(COLUMNS_MAGIC)) != 0 ||
+        header.version != ACCOUNT_COLUMNS_VERSION) {
+        return false;
+    }
+
+    size_t rows = static_cast<size_t>(header.row_count);
+    bool ok = map_column(dir, COLUMN_NAMES[0], rows, files_[0], pubkeys_) &&
+              map_column(dir, COLUMN_NAMES[1], rows, files_[1], owners_) &&
+              map_column(dir, COLUMN_NAMES[2], rows, files_[2], lamports_) &&
+              map_column(dir, COLUMN_NAMES[3], rows, files_[3], rent_epochs_) &&
+              map_column(dir, COLUMN_NAMES[4], rows, files_[4], data_lens_) &&
+              map_column(dir, COLUMN_NAMES[5], rows, files_[5], write_versions_) &&
+              map_column(dir, COLUMN_NAMES[6], rows, files_[6], executable_);
+    if (ok && (header.flags & COLUMN_FLAG_HAS_DATA)) {
+        ok = map_column(dir, COLUMN_NAMES[7], rows + 1, files_[7], data_offsets_) &&
+             map_column(dir, COLUMN_NAMES[8], static_cast<size_t>(header.data_bytes), files_[8], heap_) &&
+             data_offsets_.back() == header.data_bytes;
+    }
+    if (!ok) {
+        *this = AccountColumns();
+        return false;
+    }
+    rows_ = rows;
+    return true;
+}
+
+uint64_t AccountColumns::total_lamports() const {
+    std::atomic<uint64_t> total{0};
+    default_executor().parallel_for(lamports_.size(), 0, [&](size_t start, size_t end) {
+        uint64_t sum = 0;
+        for (size_t i = start; i < end; ++i) {
+            sum += lamports_[i];
+        }
+        total.fetch_add(sum, std::memory_order_relaxed);
+    });
+    return total.load();
+}
+
+uint64_t AccountColumns::total_data_len() const {
+    std::atomic<uint64_t> total{0};
+    default_executor().parallel_for(data_lens_.size(), 0, [&](size_t start, size_t end) {
+        uint64_t sum = 0;
+        for (size_t i = start; i < end; ++i) {
+            sum += data_lens_[i];
+        }
+        total.fetch_add(sum, std::memory_order_relaxed);
+    });
+    return total.load();
+}
+
+uint64_t AccountColumns::lamports_owned_by(const std::array<uint8_t, 32>& owner) const {
+    std::atomic<uint64_t> total{0};
+    default_executor().parallel_for(owners_.size(), 0, [&](size_t start, size_t end) {
+        uint64_t sum = 0;
+        for (size_t i = start; i < end; ++i) {
+            if (detail::key32_equal(owners_[i].data(), owner.data())) {
+                sum += lamports_[i];
+            }
+        }
+        total.fetch_add(sum, std::memory_order_relaxed);
+    });
+    return total.load();
+}
+
+std::vector<std::pair<std::array<uint8_t, 32>, OwnerTotals>> AccountColumns::totals_by_owner() const {
+    Executor& executor = default_executor();
+    size_t chunk_count = std::max<size_t>(std::min(executor.concurrency(), rows_), 1);
+    size_t chunk_size = (rows_ + chunk_count - 1) / chunk_count;
+    std::vector<OwnerMap> partials(chunk_count);
+
+    executor.run(chunk_count, [&](size_t chunk) {
+        OwnerMap& local = partials[chunk];
+        OwnerTotals* last = nullptr;
+        const uint8_t* last_owner = nullptr;
+        size_t end = std::min(rows_, (chunk + 1) * chunk_size);
+        for (size_t i = chunk * chunk_size; i < end; ++i) {
+            // Rows of one AppendVec tend to repeat owners; skip the lookup for runs
+            if (!last_owner || !detail::key32_equal(owners_[i].data(), last_owner)) {
+                last = &local[owners_[i]];
+                last_owner = owners_[i].data();
+            }
+            last->accounts++;
+            last->lamports += lamports_[i];
+            last->data_bytes += data_lens_[i];
+        }
+    });
+
+    OwnerMap merged = std::move(partials[0]);
+    for (size_t p = 1; p < partials.size(); ++p) {
+        for (const auto& [owner, totals] : partials[p]) {
+            OwnerTotals& into = merged[owner];
+            into.accounts += totals.accounts;
+            into.lamports += totals.lamports;
+            into.data_bytes += totals.data_bytes;
+        }
+    }
+
+    std::vector<std::pair<std::array<uint8_t, 32>, OwnerTotals>> out(merged.begin(), merged.end());
+    std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    return out;
+}
+
+int64_t export_snapshot_columns(const std::string& snapshot_path, const std::string& dir,
+                                const ParallelStreamOptions& options, bool include_data) {
+    AccountColumnsBuilder builder(dir, include_data);
+    if (stream_snapshot_parallel_batches(snapshot_path, builder.callback(), options) < 0) {
+        return -1;
+    }
+    return builder.finish();
+}
+
+} // namespace snapshot
+} // namespace limcode
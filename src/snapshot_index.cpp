@@ -0,0 +1,306 @@
+#include "limcode/snapshot_index.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+
+#include <unistd.h>
+
+namespace limcode {
+namespace snapshot {
+
+namespace {
+
+constexpr char INDEX_MAGIC[8] = {'L', 'I', 'M', 'C', 'I', 'D', 'X', '1'};
+constexpr size_t MERGE_READ_ENTRIES = 64 * 1024;
+
+inline int compare_pubkey(const AccountIndexEntry& a, const AccountIndexEntry& b) {
+    return std::memcmp(a.pubkey, b.pubkey, 32);
+}
+
+/// True if `a` is a newer version of the same account than `b`
+inline bool is_newer(const AccountIndexEntry& a, const AccountIndexEntry& b) {
+    if (a.slot != b.slot) return a.slot > b.slot;
+    if (a.write_version != b.write_version) return a.write_version > b.write_version;
+    return a.offset > b.offset;
+}
+
+inline uint32_t pubkey_prefix(const uint8_t* pubkey) {
+    return (static_cast<uint32_t>(pubkey[0]) << 8) | pubkey[1];
+}
+
+/// Sort by pubkey and keep only the newest entry per pubkey
+void sort_and_dedup(std::vector<AccountIndexEntry>& entries) {
+    std::sort(entries.begin(), entries.end(), [](const AccountIndexEntry& a, const AccountIndexEntry& b) {
+        int c = compare_pubkey(a, b);
+        return c != 0 ? c < 0 : is_newer(a, b);
+    });
+
+    auto last = std::unique(entries.begin(), entries.end(), [](const AccountIndexEntry& a, const AccountIndexEntry& b) {
+        return compare_pubkey(a, b) == 0;
+    });
+    entries.erase(last, entries.end());
+}
+
+/// Sequential reader over one sorted run (file-backed or in-memory)
+struct RunCursor {
+    FILE* file = nullptr;
+    std::vector<AccountIndexEntry> buffer;
+    size_t pos = 0;
+
+    const AccountIndexEntry& current() const { return buffer[pos]; }
+
+    /// Advance; returns false when the run is exhausted
+    bool advance() {
+        if (++pos < buffer.size()) return true;
+        return refill();
+    }
+
+    bool refill() {
+        if (!file) return false;
+        buffer.resize(MERGE_READ_ENTRIES);
+        size_t got = std::fread(buffer.data(), sizeof(AccountIndexEntry), MERGE_READ_ENTRIES, file);
+        buffer.resize(got);
+        pos = 0;
+        return got > 0;
+    }
+};
+
+/// Merge sorted runs into `out` (header, fanout, entries); `count` gets the unique pubkeys
+bool merge_runs(std::vector<RunCursor>& cursors, const std::array<uint64_t, 4>& source_stamp, FILE* out,
+                uint64_t& count) {
+    // Header and fanout are rewritten once the entry count is known
+    AccountIndexFileHeader header{};
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = ACCOUNT_INDEX_VERSION;
+    header.entry_size = sizeof(AccountIndexEntry);
+    std::copy(source_stamp.begin(), source_stamp.end(), header.source_stamp);
+
+    std::vector<uint64_t> fanout(ACCOUNT_INDEX_FANOUT + 1, 0);
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(fanout.data(), sizeof(uint64_t), fanout.size(), out) == fanout.size();
+
+    // k-way merge; cursors with equal pubkeys are resolved by is_newer
+    auto greater = [&](size_t a, size_t b) {
+        int c = compare_pubkey(cursors[a].current(), cursors[b].current());
+        return c != 0 ? c > 0 : is_newer(cursors[b].current(), cursors[a].current());
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+
+    for (size_t i = 0; i < cursors.size(); i++) {
+        bool has_data = cursors[i].file ? cursors[i].refill() : !cursors[i].buffer.empty();
+        if (has_data) heap.push(i);
+    }
+
+    std::vector<AccountIndexEntry> out_buffer;
+    out_buffer.reserve(MERGE_READ_ENTRIES);
+    uint8_t last_pubkey[32];
+    count = 0;
+
+    while (ok && !heap.empty()) {
+        size_t i = heap.top();
+        heap.pop();
+
+        // The heap yields the newest version of each pubkey first
+        const AccountIndexEntry& entry = cursors[i].current();
+        if (count == 0 || std::memcmp(last_pubkey, entry.pubkey, 32) != 0) {
+            std::memcpy(last_pubkey, entry.pubkey, 32);
+            out_buffer.push_back(entry);
+            fanout[pubkey_prefix(entry.pubkey) + 1]++;
+            count++;
+
+            if (out_buffer.size() == MERGE_READ_ENTRIES) {
+                ok = std::fwrite(out_buffer.data(), sizeof(AccountIndexEntry), out_buffer.size(), out) ==
+                     out_buffer.size();
+                out_buffer.clear();
+            }
+        }
+
+        if (cursors[i].advance()) heap.push(i);
+    }
+
+    if (ok && !out_buffer.empty()) {
+        ok = std::fwrite(out_buffer.data(), sizeof(AccountIndexEntry), out_buffer.size(), out) == out_buffer.size();
+    }
+
+    // Prefix counts -> first-entry offsets
+    for (size_t p = 1; p <= ACCOUNT_INDEX_FANOUT; p++) {
+        fanout[p] += fanout[p - 1];
+    }
+
+    header.entry_count = count;
+    return ok && std::fseek(out, 0, SEEK_SET) == 0 &&
+           std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+           std::fwrite(fanout.data(), sizeof(uint64_t), fanout.size(), out) == fanout.size();
+}
+
+} // namespace
+
+bool parse_appendvec_name(const char* name, uint64_t& slot, uint64_t& appendvec_id) {
+    if (std::strncmp(name, "accounts/", 9) == 0) {
+        name += 9;
+    }
+
+    char* end = nullptr;
+    slot = std::strtoull(name, &end, 10);
+    if (end == name || *end != '.') return false;
+
+    const char* id_start = end + 1;
+    appendvec_id = std::strtoull(id_start, &end, 10);
+    return end != id_start && *end == '\0';
+}
+
+// ==================== AccountIndexBuilder ====================
+
+AccountIndexBuilder::AccountIndexBuilder(std::string index_path, size_t run_capacity)
+    : index_path_(std::move(index_path)), run_capacity_(run_capacity > 0 ? run_capacity : 1) {}
+
+AccountIndexBuilder::~AccountIndexBuilder() {
+    for (const auto& path : run_paths_) {
+        std::remove(path.c_str());
+    }
+}
+
+void AccountIndexBuilder::add_appendvec(uint64_t slot, uint64_t appendvec_id,
+                                        const uint8_t* data, size_t size) {
+    Collector collector(this, slot, appendvec_id, data);
+    for_each_account_view(data, size, [&](const SnapshotAccountView& view) {
+        collector.add(view);
+        return true;
+    });
+}
+
+void AccountIndexBuilder::add(std::span<const AccountIndexEntry> entries) {
+    std::vector<AccountIndexEntry> run;
+    std::string run_path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.insert(pending_.end(), entries.begin(), entries.end());
+        if (pending_.size() < run_capacity_) return;
+
+        // Take the full buffer and a run slot; other threads keep adding meanwhile
+        run.swap(pending_);
+        run_path = index_path_ + ".run" + std::to_string(run_paths_.size());
+        run_paths_.push_back(run_path);
+    }
+
+    if (!spill(run, run_path)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failed_ = true;
+    }
+}
+
+bool AccountIndexBuilder::spill(std::vector<AccountIndexEntry>& run, const std::string& run_path) {
+    sort_and_dedup(run);
+
+    FILE* f = std::fopen(run_path.c_str(), "wb");
+    if (!f) return false;
+
+    bool ok = std::fwrite(run.data(), sizeof(AccountIndexEntry), run.size(), f) == run.size();
+    ok = (std::fclose(f) == 0) && ok;
+    return ok;
+}
+
+int64_t AccountIndexBuilder::finish() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failed_) return -1;
+
+    // Runs: every spilled file plus whatever is still in memory
+    std::vector<RunCursor> cursors(run_paths_.size() + 1);
+    bool ok = true;
+    for (size_t i = 0; i < run_paths_.size(); i++) {
+        cursors[i].file = std::fopen(run_paths_[i].c_str(), "rb");
+        if (!cursors[i].file) ok = false;
+    }
+
+    // Written under a temporary name and renamed into place once complete,
+    // so a failed or interrupted finish() never leaves an openable index
+    std::string tmp_path = index_path_ + ".tmp";
+    FILE* out = ok ? std::fopen(tmp_path.c_str(), "wb") : nullptr;
+    uint64_t count = 0;
+    if (out) {
+        try {
+            sort_and_dedup(pending_);
+            cursors.back().buffer = std::move(pending_);
+            pending_.clear();
+            ok = merge_runs(cursors, source_stamp_, out, count);
+        } catch (...) {
+            ok = false;
+        }
+        ok = ok && std::fflush(out) == 0 && ::fsync(::fileno(out)) == 0;
+        ok = (std::fclose(out) == 0) && ok;
+        ok = ok && std::rename(tmp_path.c_str(), index_path_.c_str()) == 0;
+        if (!ok) std::remove(tmp_path.c_str());
+    } else {
+        ok = false;
+    }
+
+    for (auto& c : cursors) {
+        if (c.file) std::fclose(c.file);
+    }
+    for (const auto& path : run_paths_) {
+        std::remove(path.c_str());
+    }
+    run_paths_.clear();
+
+    return ok ? static_cast<int64_t>(count) : -1;
+}
+
+// ==================== AccountIndex ====================
+
+bool AccountIndex::open(const std::string& index_path) {
+    fanout_ = nullptr;
+    entries_ = nullptr;
+    entry_count_ = 0;
+    source_stamp_ = {};
+
+    // Point lookups: random access, don't read ahead
+    if (!file_.open(index_path.c_str(), MADV_RANDOM)) return false;
+
+    constexpr size_t FANOUT_BYTES = (ACCOUNT_INDEX_FANOUT + 1) * sizeof(uint64_t);
+    constexpr size_t PREFIX_BYTES = sizeof(AccountIndexFileHeader) + FANOUT_BYTES;
+    if (file_.size() < PREFIX_BYTES) return false;
+
+    AccountIndexFileHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+        header.version != ACCOUNT_INDEX_VERSION ||
+        header.entry_size != sizeof(AccountIndexEntry) ||
+        header.entry_count > (file_.size() - PREFIX_BYTES) / sizeof(AccountIndexEntry)) {
+        file_.close();
+        return false;
+    }
+
+    fanout_ = reinterpret_cast<const uint64_t*>(file_.data() + sizeof(AccountIndexFileHeader));
+    entries_ = reinterpret_cast<const AccountIndexEntry*>(file_.data() + PREFIX_BYTES);
+    entry_count_ = header.entry_count;
+    std::copy(std::begin(header.source_stamp), std::end(header.source_stamp), source_stamp_.begin());
+    return true;
+}
+
+const AccountIndexEntry* AccountIndex::find(const uint8_t* pubkey) const {
+    if (!fanout_) return nullptr;
+
+    uint32_t prefix = pubkey_prefix(pubkey);
+    size_t lo = fanout_[prefix];
+    size_t hi = fanout_[prefix + 1];
+    if (hi > entry_count_ || lo > hi) return nullptr; // Corrupt fanout
+
+    // Binary search within the 2-byte prefix bucket
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int c = std::memcmp(entries_[mid].pubkey, pubkey, 32);
+        if (c == 0) return &entries_[mid];
+        if (c < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace snapshot
+} // namespace limcode
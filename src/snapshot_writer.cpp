@@ -0,0 +1,388 @@
+#include "limcode/snapshot_writer.h"
+#include "limcode/prefetch_reader.h"
+#include <zstd.h>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace limcode {
+namespace snapshot {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t TAR_BLOCK_SIZE = 512;
+constexpr size_t STAGED_READ_CHUNK = 4 * 1024 * 1024;
+
+/// Push-style zstd compressor into a FILE*
+///
+/// nbWorkers > 0 makes zstd compress on its own threads; compress() then
+/// only hands input over and drains whatever output is ready.
+class ZstdFileWriter {
+public:
+    ZstdFileWriter() = default;
+
+    ~ZstdFileWriter() {
+        if (cctx_) ZSTD_freeCCtx(cctx_);
+        if (file_) std::fclose(file_);
+    }
+
+    ZstdFileWriter(const ZstdFileWriter&) = delete;
+    ZstdFileWriter& operator=(const ZstdFileWriter&) = delete;
+
+    bool open(const std::string& path, int level, unsigned num_threads) {
+        file_ = std::fopen(path.c_str(), "wb");
+        if (!file_) return false;
+
+        cctx_ = ZSTD_createCCtx();
+        if (!cctx_) return false;
+        if (ZSTD_isError(ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel, level))) {
+            return false;
+        }
+        // Fails on a libzstd built without threading; compression then stays on this thread
+        ZSTD_CCtx_setParameter(cctx_, ZSTD_c_nbWorkers, static_cast<int>(num_threads));
+
+        out_.resize(ZSTD_CStreamOutSize());
+        return true;
+    }
+
+    bool write(const void* data, size_t len) {
+        ZSTD_inBuffer in = {data, len, 0};
+        while (in.pos < in.size) {
+            if (!drive(in, ZSTD_e_continue)) return false;
+        }
+        return true;
+    }
+
+    bool write_zeros(size_t len) {
+        static const uint8_t zeros[TAR_BLOCK_SIZE] = {};
+        while (len > 0) {
+            size_t chunk = len < sizeof(zeros) ? len : sizeof(zeros);
+            if (!write(zeros, chunk)) return false;
+            len -= chunk;
+        }
+        return true;
+    }
+
+    /// Flush the frame epilogue and close the file
+    bool finish() {
+        ZSTD_inBuffer in = {nullptr, 0, 0};
+        size_t remaining;
+        do {
+            ZSTD_outBuffer out = {out_.data(), out_.size(), 0};
+            remaining = ZSTD_compressStream2(cctx_, &out, &in, ZSTD_e_end);
+            if (ZSTD_isError(remaining) || !flush(out)) return false;
+        } while (remaining != 0);
+
+        bool ok = std::fclose(file_) == 0;
+        file_ = nullptr;
+        return ok;
+    }
+
+private:
+    bool drive(ZSTD_inBuffer& in, ZSTD_EndDirective mode) {
+        ZSTD_outBuffer out = {out_.data(), out_.size(), 0};
+        size_t ret = ZSTD_compressStream2(cctx_, &out, &in, mode);
+        return !ZSTD_isError(ret) && flush(out);
+    }
+
+    bool flush(const ZSTD_outBuffer& out) {
+        return out.pos == 0 || std::fwrite(out_.data(), 1, out.pos, file_) == out.pos;
+    }
+
+    FILE* file_ = nullptr;
+    ZSTD_CCtx* cctx_ = nullptr;
+    std::vector<uint8_t> out_;
+};
+
+/// Write `value` as a zero-padded octal tar field, or GNU base-256 if it doesn't fit
+void put_tar_number(char* field, size_t len, uint64_t value) {
+    if (len < 20 && value >= (uint64_t(1) << (3 * (len - 1)))) {
+        std::memset(field, 0, len);
+        field[0] = static_cast<char>(0x80);
+        for (size_t i = len - 1; i > 0 && value > 0; --i, value >>= 8) {
+            field[i] = static_cast<char>(value & 0xFF);
+        }
+        return;
+    }
+    std::snprintf(field, len, "%0*llo", static_cast<int>(len - 1),
+                  static_cast<unsigned long long>(value));
+}
+
+/// ustar regular-file entry header
+std::array<uint8_t, TAR_BLOCK_SIZE> make_tar_header(const std::string& name, uint64_t size,
+                                                    uint64_t mtime) {
+    std::array<uint8_t, TAR_BLOCK_SIZE> block{};
+    char* h = reinterpret_cast<char*>(block.data());
+    std::memcpy(h, name.data(), std::min<size_t>(name.size(), 100));
+    put_tar_number(h + 100, 8, 0644);    // mode
+    put_tar_number(h + 108, 8, 0);       // uid
+    put_tar_number(h + 116, 8, 0);       // gid
+    put_tar_number(h + 124, 12, size);
+    put_tar_number(h + 136, 12, mtime);
+    h[156] = '0';                        // typeflag: regular file
+    std::memcpy(h + 257, "ustar", 6);
+    std::memcpy(h + 263, "00", 2);
+
+    // Checksum is computed with its own field as spaces
+    std::memset(h + 148, ' ', 8);
+    unsigned sum = 0;
+    for (uint8_t byte : block) {
+        sum += byte;
+    }
+    std::snprintf(h + 148, 7, "%06o", sum);
+    h[154] = '\0';
+    h[155] = ' ';
+    return block;
+}
+
+/// Sequential tar writer over a ZstdFileWriter
+class TarWriter {
+public:
+    explicit TarWriter(ZstdFileWriter& out)
+        : out_(out), mtime_(static_cast<uint64_t>(std::time(nullptr))) {}
+
+    bool begin_file(const std::string& name, uint64_t size) {
+        if (name.size() > 100) return false;   // ustar prefix split not needed for snapshot paths
+        auto header = make_tar_header(name, size, mtime_);
+        pending_padding_ = (TAR_BLOCK_SIZE - size % TAR_BLOCK_SIZE) % TAR_BLOCK_SIZE;
+        return out_.write(header.data(), header.size());
+    }
+
+    bool write(const void* data, size_t len) { return out_.write(data, len); }
+
+    bool end_file() {
+        bool ok = out_.write_zeros(pending_padding_);
+        pending_padding_ = 0;
+        return ok;
+    }
+
+    bool write_file(const std::string& name, std::span<const uint8_t> body) {
+        return begin_file(name, body.size()) && write(body.data(), body.size()) && end_file();
+    }
+
+    /// Two zero blocks end the archive
+    bool finish() { return out_.write_zeros(2 * TAR_BLOCK_SIZE); }
+
+private:
+    ZstdFileWriter& out_;
+    uint64_t mtime_;
+    size_t pending_padding_ = 0;
+};
+
+struct StagedAppendVec {
+    uint64_t slot;
+    uint64_t id;
+    uint64_t len;
+    fs::path path;
+};
+
+std::string appendvec_name(uint64_t slot, uint64_t id) {
+    return std::to_string(slot) + "." + std::to_string(id);
+}
+
+} // namespace
+
+struct SnapshotWriter::Impl {
+    std::string archive_path;
+    SnapshotWriterOptions options;
+    fs::path staging_dir;
+
+    struct OpenAppendVec {
+        AppendVecBuilder builder;
+        uint64_t last_use = 0;
+    };
+    std::map<uint64_t, OpenAppendVec> open;
+    std::vector<AppendVecBuilder> spare;   // Cleared buffers for reuse
+    std::vector<StagedAppendVec> staged;
+
+    uint64_t next_id = 0;
+    uint64_t uses = 0;
+    uint64_t accounts = 0;
+    uint64_t max_write_version = 0;
+    bool staging_created = false;
+    bool failed = false;
+    bool finished = false;
+
+    AppendVecBuilder& builder_for(uint64_t slot) {
+        auto it = open.find(slot);
+        if (it == open.end()) {
+            if (options.max_open_slots > 0 && open.size() >= options.max_open_slots) {
+                auto oldest = std::min_element(open.begin(), open.end(), [](const auto& a, const auto& b) {
+                    return a.second.last_use < b.second.last_use;
+                });
+                close_slot(oldest);
+            }
+            OpenAppendVec entry;
+            if (!spare.empty()) {
+                entry.builder = std::move(spare.back());
+                spare.pop_back();
+            }
+            it = open.emplace(slot, std::move(entry)).first;
+        }
+        it->second.last_use = ++uses;
+        return it->second.builder;
+    }
+
+    void close_slot(std::map<uint64_t, OpenAppendVec>::iterator it) {
+        if (!stage(it->first, it->second.builder)) {
+            failed = true;
+        }
+        it->second.builder.clear();
+        spare.push_back(std::move(it->second.builder));
+        open.erase(it);
+    }
+
+    /// Write a finished AppendVec to the staging directory
+    bool stage(uint64_t slot, const AppendVecBuilder& builder) {
+        if (builder.empty()) return true;
+        std::error_code ec;
+        if (!staging_created) {
+            fs::create_directories(staging_dir, ec);
+            if (ec) return false;
+            staging_created = true;
+        }
+
+        uint64_t id = next_id++;
+        fs::path path = staging_dir / appendvec_name(slot, id);
+        FILE* out = std::fopen(path.c_str(), "wb");
+        if (!out) return false;
+        bool ok = std::fwrite(builder.data(), 1, builder.size(), out) == builder.size();
+        ok = (std::fclose(out) == 0) && ok;
+        if (ok) {
+            staged.push_back({slot, id, builder.size(), path});
+        }
+        return ok;
+    }
+
+    template <typename Account>
+    bool add(uint64_t slot, const Account& account, size_t data_len, uint64_t write_version) {
+        if (failed || finished) return false;
+
+        AppendVecBuilder& builder = builder_for(slot);
+        if (options.appendvec_size > 0 && !builder.empty() &&
+            builder.size() + AppendVecBuilder::record_size(data_len) > options.appendvec_size) {
+            if (!stage(slot, builder)) {
+                failed = true;
+                return false;
+            }
+            builder.clear();
+        }
+        builder.append(account);
+        accounts++;
+        max_write_version = std::max(max_write_version, write_version);
+        return !failed;
+    }
+
+    bool write_archive(SnapshotManifest& manifest) {
+        std::sort(staged.begin(), staged.end(), [](const StagedAppendVec& a, const StagedAppendVec& b) {
+            return a.slot != b.slot ? a.slot < b.slot : a.id < b.id;
+        });
+        manifest.storages.clear();
+        for (const auto& s : staged) {
+            manifest.storages.push_back({s.slot, s.id, s.len});
+        }
+        if (manifest.accounts_slot == 0) manifest.accounts_slot = manifest.slot;
+        if (manifest.write_version == 0) manifest.write_version = max_write_version;
+
+        unsigned threads = options.num_threads > 0 ? options.num_threads
+                                                   : std::max(1u, std::thread::hardware_concurrency());
+        ZstdFileWriter zstd;
+        if (!zstd.open(archive_path, options.compression_level, threads)) return false;
+        TarWriter tar(zstd);
+
+        std::string slot = std::to_string(manifest.slot);
+        std::vector<uint8_t> manifest_bytes = serialize_manifest(manifest);
+        const uint8_t empty_status_cache[8] = {};   // bincode Vec<BankSlotDelta> of length 0
+        auto version = std::span(reinterpret_cast<const uint8_t*>(options.version.data()),
+                                 options.version.size());
+
+        bool ok = tar.write_file("version", version) &&
+                  tar.write_file("snapshots/status_cache", empty_status_cache) &&
+                  tar.write_file("snapshots/" + slot + "/" + slot, manifest_bytes);
+
+        PrefetchOptions read_options;
+        read_options.chunk_size = STAGED_READ_CHUNK;
+        PrefetchReader reader(read_options);
+        for (size_t i = 0; ok && i < staged.size(); ++i) {
+            const StagedAppendVec& s = staged[i];
+            ok = reader.open(s.path.string()) &&
+                 tar.begin_file("accounts/" + appendvec_name(s.slot, s.id), s.len);
+            uint64_t copied = 0;
+            std::span<const uint8_t> chunk;
+            while (ok && copied < s.len) {
+                ok = reader.next(chunk) && !chunk.empty() && tar.write(chunk.data(), chunk.size());
+                copied += chunk.size();
+            }
+            ok = ok && copied == s.len && tar.end_file();
+            reader.close();
+        }
+
+        return ok && tar.finish() && zstd.finish();
+    }
+
+    void remove_staging() {
+        if (staging_created) {
+            std::error_code ec;
+            fs::remove_all(staging_dir, ec);
+            staging_created = false;
+        }
+    }
+};
+
+SnapshotWriter::SnapshotWriter(std::string archive_path, SnapshotWriterOptions options)
+    : impl_(std::make_unique<Impl>()) {
+    impl_->staging_dir = options.staging_dir.empty() ? archive_path + ".staging" : options.staging_dir;
+    impl_->archive_path = std::move(archive_path);
+    impl_->options = std::move(options);
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    impl_->remove_staging();
+}
+
+bool SnapshotWriter::add(uint64_t slot, const SnapshotAccount& account) {
+    return impl_->add(slot, account, account.data.size(), account.write_version);
+}
+
+bool SnapshotWriter::add(uint64_t slot, const SnapshotAccountView& view) {
+    return impl_->add(slot, view, view.data.size(), view.write_version());
+}
+
+bool SnapshotWriter::add_batch(uint64_t slot, std::span<const SnapshotAccountView> batch) {
+    for (const auto& view : batch) {
+        if (!add(slot, view)) return false;
+    }
+    return true;
+}
+
+bool SnapshotWriter::finish(SnapshotManifest manifest) {
+    if (impl_->failed || impl_->finished) return false;
+    impl_->finished = true;
+
+    while (!impl_->open.empty()) {
+        impl_->close_slot(impl_->open.begin());
+    }
+    bool ok = !impl_->failed && impl_->write_archive(manifest);
+    impl_->remove_staging();
+    if (!ok) {
+        std::error_code ec;
+        fs::remove(impl_->archive_path, ec);
+    }
+    return ok;
+}
+
+uint64_t SnapshotWriter::accounts_written() const {
+    return impl_->accounts;
+}
+
+uint64_t SnapshotWriter::appendvecs_written() const {
+    return impl_->staged.size() + impl_->open.size();
+}
+
+} // namespace snapshot
+} // namespace limcode
@@ -0,0 +1,386 @@
+/**
+ * @file test_ffi.cpp
+ * @brief Tests for the bulk entry C FFI (include/limcode_ffi.h)
+ *
+ * Kept apart from test_limcode.cpp: the C handle typedefs (LimcodeEncoder,
+ * LimcodeDecoder) clash with `using namespace limcode`.
+ */
+
+#include <limcode/limcode.h>
+#include <limcode/snapshot.h>
+#include <limcode_ffi.h>
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using limcode::AddressTableLookup;
+using limcode::CompiledInstruction;
+using limcode::Entry;
+using limcode::LegacyMessage;
+using limcode::V0Message;
+using limcode::VersionedTransaction;
+
+// Mixed legacy / v0 entries, some with multi-byte ShortVec lengths
+static std::vector<Entry> make_test_entries(size_t count) {
+  std::vector<Entry> entries;
+  for (size_t i = 0; i < count; ++i) {
+    Entry e;
+    e.num_hashes = i * 7 + 1;
+    e.hash.fill(static_cast<uint8_t>(i));
+
+    for (size_t t = 0; t < i % 4; ++t) {
+      VersionedTransaction tx;
+      limcode::Signature sig;
+      sig.fill(static_cast<uint8_t>(0xA0 + t));
+      tx.signatures = {sig, sig};
+
+      CompiledInstruction instr;
+      instr.program_id_index = 1;
+      instr.accounts = {0, 1};
+      instr.data.assign(100 + i * 3, static_cast<uint8_t>(t));
+
+      limcode::Pubkey key;
+      key.fill(static_cast<uint8_t>(0x10 + i));
+      if (t % 2 == 0) {
+        LegacyMessage msg;
+        msg.header = {2, 0, 1};
+        msg.account_keys = {key, key};
+        msg.recent_blockhash.fill(0xEE);
+        msg.instructions.push_back(instr);
+        tx.message.set_legacy(std::move(msg));
+      } else {
+        V0Message msg;
+        msg.header = {2, 1, 0};
+        msg.account_keys = {key, key, key};
+        msg.recent_blockhash.fill(0xEF);
+        msg.instructions = {instr, CompiledInstruction{2, {}, {}}};
+        AddressTableLookup atl;
+        atl.account_key.fill(0xDD);
+        atl.writable_indexes = {3, 4};
+        atl.readonly_indexes = {5};
+        msg.address_table_lookups = {atl, atl};
+        tx.message.set_v0(std::move(msg));
+      }
+      e.transactions.push_back(std::move(tx));
+    }
+    entries.push_back(std::move(e));
+  }
+  return entries;
+}
+
+// Descriptor tables pointing into the source entries
+struct EntryDescTables {
+  std::vector<LimcodeEntryDesc> entries;
+  std::vector<std::vector<LimcodeTransactionDesc>> txs;
+  std::vector<std::vector<LimcodeInstructionDesc>> instrs;
+  std::vector<std::vector<LimcodeLookupDesc>> lookups;
+};
+
+template <typename Message>
+static void describe_message(const Message &msg, LimcodeTransactionDesc &tx,
+                             EntryDescTables &tables) {
+  tx.num_required_signatures = msg.header.num_required_signatures;
+  tx.num_readonly_signed_accounts = msg.header.num_readonly_signed_accounts;
+  tx.num_readonly_unsigned_accounts = msg.header.num_readonly_unsigned_accounts;
+  tx.account_keys = msg.account_keys[0].data();
+  tx.num_account_keys = static_cast<uint16_t>(msg.account_keys.size());
+  tx.recent_blockhash = msg.recent_blockhash.data();
+  auto &instrs = tables.instrs.emplace_back();
+  for (const auto &instr : msg.instructions) {
+    instrs.push_back({instr.accounts.data(), instr.data.data(),
+                      static_cast<uint16_t>(instr.accounts.size()),
+                      static_cast<uint16_t>(instr.data.size()),
+                      instr.program_id_index});
+  }
+  tx.instructions = instrs.data();
+  tx.num_instructions = static_cast<uint16_t>(instrs.size());
+}
+
+static EntryDescTables describe_entries(const std::vector<Entry> &entries) {
+  EntryDescTables tables;
+  // Reserve so the outer vectors never move the inner ones we point into
+  size_t num_txs = 0;
+  for (const auto &entry : entries) {
+    num_txs += entry.transactions.size();
+  }
+  tables.txs.reserve(entries.size());
+  tables.instrs.reserve(num_txs);
+  tables.lookups.reserve(num_txs);
+
+  for (const auto &entry : entries) {
+    auto &txs = tables.txs.emplace_back();
+    for (const auto &source : entry.transactions) {
+      LimcodeTransactionDesc tx{};
+      tx.signatures = source.signatures[0].data();
+      tx.num_signatures = static_cast<uint16_t>(source.signatures.size());
+      if (source.message.is_v0()) {
+        const auto &msg = source.message.as_v0();
+        tx.version = 0;
+        describe_message(msg, tx, tables);
+        auto &lookups = tables.lookups.emplace_back();
+        for (const auto &atl : msg.address_table_lookups) {
+          lookups.push_back(
+              {atl.account_key.data(), atl.writable_indexes.data(),
+               atl.readonly_indexes.data(),
+               static_cast<uint16_t>(atl.writable_indexes.size()),
+               static_cast<uint16_t>(atl.readonly_indexes.size())});
+        }
+        tx.lookups = lookups.data();
+        tx.num_lookups = static_cast<uint16_t>(lookups.size());
+      } else {
+        tx.version = LIMCODE_MESSAGE_LEGACY;
+        describe_message(source.message.as_legacy(), tx, tables);
+      }
+      txs.push_back(tx);
+    }
+    tables.entries.push_back({entry.num_hashes, entry.hash.data(), txs.data(),
+                              static_cast<uint16_t>(txs.size())});
+  }
+  return tables;
+}
+
+// Rebuild owned entries from the layout tables alone
+static std::vector<Entry> rebuild_entries(const uint8_t *base,
+                                          const LimcodeBlockLayout &layout) {
+  auto bytes_at = [&](uint32_t offset, size_t len) {
+    return std::vector<uint8_t>(base + offset, base + offset + len);
+  };
+  std::vector<Entry> out;
+  for (size_t e = 0; e < layout.num_entries; ++e) {
+    const LimcodeEntryLayout &row = layout.entries[e];
+    Entry entry;
+    entry.num_hashes = row.num_hashes;
+    std::memcpy(entry.hash.data(), base + row.hash_offset, 32);
+    for (uint32_t t = 0; t < row.num_transactions; ++t) {
+      const LimcodeTransactionLayout &txr =
+          layout.transactions[row.first_transaction + t];
+      VersionedTransaction tx;
+      tx.signatures.resize(txr.num_signatures);
+      std::memcpy(tx.signatures.data(), base + txr.signatures_offset,
+                  txr.num_signatures * size_t(64));
+      auto fill = [&](auto &msg) {
+        msg.header = {txr.num_required_signatures,
+                      txr.num_readonly_signed_accounts,
+                      txr.num_readonly_unsigned_accounts};
+        msg.account_keys.resize(txr.num_account_keys);
+        std::memcpy(msg.account_keys.data(), base + txr.account_keys_offset,
+                    txr.num_account_keys * size_t(32));
+        std::memcpy(msg.recent_blockhash.data(),
+                    base + txr.recent_blockhash_offset, 32);
+        for (uint16_t i = 0; i < txr.num_instructions; ++i) {
+          const LimcodeInstructionLayout &ir =
+              layout.instructions[txr.first_instruction + i];
+          msg.instructions.push_back(CompiledInstruction{
+              ir.program_id_index,
+              bytes_at(ir.accounts_offset, ir.num_accounts),
+              bytes_at(ir.data_offset, ir.data_len)});
+        }
+      };
+      if (txr.version == 0) {
+        V0Message msg;
+        fill(msg);
+        for (uint16_t i = 0; i < txr.num_lookups; ++i) {
+          const LimcodeLookupLayout &lr = layout.lookups[txr.first_lookup + i];
+          AddressTableLookup atl;
+          std::memcpy(atl.account_key.data(), base + lr.account_key_offset,
+                      32);
+          atl.writable_indexes = bytes_at(lr.writable_offset, lr.num_writable);
+          atl.readonly_indexes = bytes_at(lr.readonly_offset, lr.num_readonly);
+          msg.address_table_lookups.push_back(std::move(atl));
+        }
+        tx.message.set_v0(std::move(msg));
+      } else {
+        assert(txr.version == LIMCODE_MESSAGE_LEGACY);
+        LegacyMessage msg;
+        fill(msg);
+        tx.message.set_legacy(std::move(msg));
+      }
+      assert(txr.size == limcode::serialized_size(tx));
+      entry.transactions.push_back(std::move(tx));
+    }
+    out.push_back(std::move(entry));
+  }
+  return out;
+}
+
+static void check_round_trip(const std::vector<Entry> &entries) {
+  auto expected = limcode::serialize_entries(entries);
+  auto tables = describe_entries(entries);
+
+  // Size query, then encode into caller memory
+  size_t len = 0;
+  int status = limcode_serialize_entries(tables.entries.data(), entries.size(),
+                                         nullptr, 0, &len);
+  assert(status == LIMCODE_FFI_BUFFER_TOO_SMALL && len == expected.size());
+  std::vector<uint8_t> out(len);
+  status = limcode_serialize_entries(tables.entries.data(), entries.size(),
+                                     out.data(), out.size(), &len);
+  assert(status == LIMCODE_FFI_OK && out == expected);
+
+  // Sizing call with empty tables, then the real decode
+  LimcodeBlockLayout layout{};
+  status = limcode_decode_entries(out.data(), out.size(), &layout);
+  assert(status == (entries.empty() ? LIMCODE_FFI_OK
+                                    : LIMCODE_FFI_BUFFER_TOO_SMALL));
+  assert(layout.num_entries == entries.size());
+  std::vector<LimcodeEntryLayout> entry_rows(layout.num_entries);
+  std::vector<LimcodeTransactionLayout> tx_rows(layout.num_transactions);
+  std::vector<LimcodeInstructionLayout> instr_rows(layout.num_instructions);
+  std::vector<LimcodeLookupLayout> lookup_rows(layout.num_lookups);
+  layout.entries = entry_rows.data();
+  layout.entries_capacity = entry_rows.size();
+  layout.transactions = tx_rows.data();
+  layout.transactions_capacity = tx_rows.size();
+  layout.instructions = instr_rows.data();
+  layout.instructions_capacity = instr_rows.size();
+  layout.lookups = lookup_rows.data();
+  layout.lookups_capacity = lookup_rows.size();
+  status = limcode_decode_entries(out.data(), out.size(), &layout);
+  assert(status == LIMCODE_FFI_OK && layout.consumed == out.size());
+  [[maybe_unused]] auto rebuilt = rebuild_entries(out.data(), layout);
+  assert(rebuilt == entries);
+  (void)status;
+}
+
+void test_bulk_round_trip() {
+  check_round_trip(make_test_entries(40));
+  check_round_trip(make_test_entries(3));
+  check_round_trip({});
+
+  // Parallel paths need an executor with more than one thread
+  limcode::ExecutorOptions opts;
+  opts.num_threads = 4;
+  limcode::WorkStealingExecutor pool(opts);
+  limcode::set_default_executor(&pool);
+  check_round_trip(make_test_entries(40));
+  check_round_trip(make_test_entries(200));
+  limcode::set_default_executor(nullptr);
+
+  std::cout << "  Bulk encode / decode round trip: PASS\n";
+}
+
+void test_bulk_errors() {
+  auto entries = make_test_entries(20);
+  auto tables = describe_entries(entries);
+  size_t len = 0;
+
+  tables.txs[2][0].version = 7; // Unknown message version
+  int status = limcode_serialize_entries(tables.entries.data(), entries.size(),
+                                         nullptr, 0, &len);
+  assert(status == LIMCODE_FFI_INVALID_ARGUMENT);
+  tables.txs[2][0].version = LIMCODE_MESSAGE_LEGACY;
+  tables.txs[2][0].account_keys = nullptr; // Count without data
+  status = limcode_serialize_entries(tables.entries.data(), entries.size(),
+                                     nullptr, 0, &len);
+  assert(status == LIMCODE_FFI_INVALID_ARGUMENT);
+  status = limcode_serialize_entries(tables.entries.data(), 1, nullptr, 0,
+                                     nullptr);
+  assert(status == LIMCODE_FFI_INVALID_ARGUMENT);
+
+  auto bytes = limcode::serialize_entries(entries);
+  size_t consumed = 0;
+  status = limcode_validate_entries(bytes.data(), bytes.size(), &consumed);
+  assert(status == LIMCODE_FFI_OK && consumed == bytes.size());
+
+  LimcodeBlockLayout layout{};
+  status = limcode_decode_entries(bytes.data(), bytes.size() - 1, &layout);
+  assert(status == LIMCODE_FFI_INVALID_DATA);
+  status = limcode_validate_entries(bytes.data(), bytes.size() - 1, nullptr);
+  assert(status == LIMCODE_FFI_INVALID_DATA);
+  layout.entries_capacity = 4; // Capacity without a table
+  status = limcode_decode_entries(bytes.data(), bytes.size(), &layout);
+  assert(status == LIMCODE_FFI_INVALID_ARGUMENT);
+  (void)len;
+  (void)status;
+
+  std::cout << "  Bulk FFI errors: PASS\n";
+}
+
+// AppendVec with data lengths 0, 1, 2, ... (exercises the 8-byte padding)
+static std::vector<uint8_t> make_appendvec(size_t num_accounts) {
+  std::vector<uint8_t> out;
+  for (size_t i = 0; i < num_accounts; ++i) {
+    limcode::snapshot::AppendVecHeader header{};
+    header.write_version = i;
+    header.data_len = i % 20;
+    header.lamports = 1000 + i;
+    header.rent_epoch = UINT64_MAX;
+    std::memset(header.pubkey, static_cast<int>(i), 32);
+    header.executable = i % 7 == 0;
+    size_t start = out.size();
+    out.resize(start + sizeof(header) + header.data_len,
+               static_cast<uint8_t>(i));
+    std::memcpy(out.data() + start, &header, sizeof(header));
+    out.resize((out.size() + 7) & ~size_t(7));
+  }
+  return out;
+}
+
+struct StreamSink {
+  size_t batches = 0;
+  size_t accounts = 0;
+  uint64_t lamports = 0;
+  size_t stop_after = SIZE_MAX; // Batches before returning 0
+};
+
+static int collect_batch(void *user_data, const LimcodeAccountView *views,
+                         size_t count) {
+  auto *sink = static_cast<StreamSink *>(user_data);
+  for (size_t i = 0; i < count; ++i) {
+    const LimcodeAccountView &view = views[i];
+    [[maybe_unused]] size_t index = sink->accounts + i;
+    assert(view.write_version == index && view.lamports == 1000 + index);
+    assert(view.data_len == index % 20 && view.pubkey[31] == uint8_t(index));
+    assert(view.data_len == 0 || view.data[view.data_len - 1] == uint8_t(index));
+    assert(view.executable == (index % 7 == 0));
+    sink->lamports += view.lamports;
+  }
+  sink->accounts += count;
+  return ++sink->batches < sink->stop_after;
+}
+
+void test_appendvec_stream() {
+  auto appendvec = make_appendvec(1000);
+
+  StreamSink sink;
+  size_t delivered = limcode_appendvec_stream(
+      appendvec.data(), appendvec.size(), 64, collect_batch, &sink);
+  assert(delivered == 1000 && sink.accounts == 1000);
+  assert(sink.batches == 16); // 15 full batches + 40
+
+  // Stopping drops the rejected batch from the count
+  StreamSink stopping;
+  stopping.stop_after = 3;
+  delivered = limcode_appendvec_stream(appendvec.data(), appendvec.size(), 64,
+                                       collect_batch, &stopping);
+  assert(delivered == 128 && stopping.batches == 3);
+
+  // A truncated record ends the stream
+  StreamSink truncated;
+  delivered = limcode_appendvec_stream(appendvec.data(), appendvec.size() - 9,
+                                       0, collect_batch, &truncated);
+  assert(delivered == 999 && truncated.batches == 999);
+  delivered = limcode_appendvec_stream(appendvec.data(), appendvec.size(), 64,
+                                       nullptr, nullptr);
+  assert(delivered == 0);
+
+  LimcodeSnapshotStreamOptions options;
+  limcode_snapshot_stream_options_init(&options);
+  assert(options.batch_size == limcode::snapshot::ParallelStreamOptions{}.batch_size);
+  (void)delivered;
+
+  std::cout << "  AppendVec batch stream: PASS\n";
+}
+
+int main() {
+  std::cout << "\nLimcode FFI Tests\n\n";
+
+  test_bulk_round_trip();
+  test_bulk_errors();
+  test_appendvec_stream();
+
+  std::cout << "\nAll FFI tests passed!\n";
+  return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file test_framed.cpp
+ * @brief Tests for zstd-framed batches (include/limcode/framed.h)
+ *
+ * Separate binary: it links limcode_framed, which needs libzstd.
+ */
+
+#include <limcode/framed.h>
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace limcode;
+
+// Batches that share blockhashes and program keys, with random signatures
+// and instruction data, like consecutive entries of a slot
+static std::vector<std::vector<Entry>> make_batches(size_t count,
+                                                    uint32_t seed) {
+  std::mt19937 rng(seed);
+  Pubkey programs[4];
+  for (size_t p = 0; p < 4; ++p) {
+    programs[p].fill(static_cast<uint8_t>(0x30 + p));
+  }
+  std::vector<std::vector<Entry>> batches(count);
+  for (size_t b = 0; b < count; ++b) {
+    for (size_t i = 0; i < 1 + rng() % 4; ++i) {
+      Entry e;
+      e.num_hashes = rng() % 5000;
+      for (auto &byte : e.hash) {
+        byte = static_cast<uint8_t>(rng());
+      }
+      for (size_t t = 0; t < rng() % 6; ++t) {
+        LegacyMessage msg;
+        msg.header = {1, 0, 1};
+        Pubkey payer;
+        for (auto &byte : payer) {
+          byte = static_cast<uint8_t>(rng());
+        }
+        msg.account_keys = {payer, programs[rng() % 4]};
+        msg.recent_blockhash.fill(static_cast<uint8_t>(0xB0 + b % 3));
+        msg.instructions.push_back(
+            CompiledInstruction{1, {0}, std::vector<uint8_t>(8 + rng() % 24, 7)});
+
+        VersionedTransaction tx;
+        Signature sig;
+        for (auto &byte : sig) {
+          byte = static_cast<uint8_t>(rng());
+        }
+        tx.signatures = {sig};
+        tx.message.set_legacy(std::move(msg));
+        e.transactions.push_back(std::move(tx));
+      }
+      batches[b].push_back(std::move(e));
+    }
+  }
+  return batches;
+}
+
+static bool throws_limcode_error(auto &&fn) {
+  try {
+    fn();
+  } catch (const LimcodeError &) {
+    return true;
+  }
+  return false;
+}
+
+void test_frame_round_trip() {
+  auto batches = make_batches(50, 1);
+  FrameEncoder encoder;
+  std::vector<uint8_t> stream;
+  size_t raw_total = 0;
+  for (const auto &batch : batches) {
+    encoder.encode_entries(batch, stream);
+    raw_total += serialize_entries(batch).size();
+  }
+  // Tiny payloads are stored raw
+  std::vector<uint8_t> tiny = {1, 2, 3};
+  encoder.encode(tiny, stream);
+
+  FrameHeader header;
+  [[maybe_unused]] bool have_header = read_frame_header(stream, header);
+  assert(have_header && header.dict_id == 0);
+  assert(frame_offsets(stream).size() == batches.size() + 1);
+
+  // Feed one byte at a time: frames complete across feed() calls
+  FrameDecoder decoder;
+  std::vector<Entry> entries;
+  size_t decoded = 0;
+  for (uint8_t byte : stream) {
+    decoder.feed({&byte, 1});
+    while (decoded < batches.size() && decoder.next_entries(entries)) {
+      assert(serialize_entries(entries) == serialize_entries(batches[decoded]));
+      decoded++;
+    }
+  }
+  assert(decoded == batches.size());
+  std::vector<uint8_t> payload;
+  [[maybe_unused]] bool have_tiny = decoder.next(payload);
+  assert(have_tiny && payload == tiny);
+  [[maybe_unused]] bool have_more = decoder.next(payload);
+  assert(!have_more && decoder.buffered() == 0);
+  assert(stream.size() < raw_total);
+
+  std::cout << "  Frame round trip: PASS\n";
+}
+
+void test_frame_dictionary() {
+  auto corpus = make_batches(400, 2);
+  ZstdDictionary dict(train_entry_dictionary(corpus, 16 * 1024));
+  assert(dict.id() != 0);
+
+  auto batches = make_batches(64, 3);
+  FrameOptions plain;
+  FrameOptions with_dict;
+  with_dict.dictionary = &dict;
+  auto without = encode_entry_frames_parallel(batches, plain);
+  auto with = encode_entry_frames_parallel(batches, with_dict);
+  assert(with.size() < without.size());
+
+  // Parallel output matches frame-at-a-time encoding
+  FrameEncoder encoder(with_dict);
+  std::vector<uint8_t> sequential;
+  for (const auto &batch : batches) {
+    encoder.encode_entries(batch, sequential);
+  }
+  assert(sequential == with);
+
+  const ZstdDictionary *dicts[] = {&dict};
+  auto decoded = decode_entry_frames_parallel(with, dicts);
+  assert(decoded.size() == batches.size());
+  for (size_t i = 0; i < batches.size(); ++i) {
+    assert(serialize_entries(decoded[i]) == serialize_entries(batches[i]));
+  }
+  auto payloads = decode_frames_parallel(with, dicts);
+  assert(payloads.size() == batches.size());
+  assert(payloads[5] == serialize_entries(batches[5]));
+
+  // Frames name their dictionary; decoding without it fails
+  FrameHeader header;
+  [[maybe_unused]] bool have_header = read_frame_header(with, header);
+  assert(have_header && header.dict_id == dict.id());
+  assert(throws_limcode_error([&] { (void)decode_frames_parallel(with); }));
+
+  std::cout << "  Frame dictionary: PASS\n";
+}
+
+void test_frame_corruption() {
+  auto batches = make_batches(4, 4);
+  auto stream = encode_entry_frames_parallel(batches);
+  assert(frame_offsets(stream).size() == 4);
+
+  auto truncated = stream;
+  truncated.pop_back();
+  assert(throws_limcode_error([&] { (void)frame_offsets(truncated); }));
+
+  auto bad_magic = stream;
+  bad_magic[0] ^= 0xFF;
+  assert(throws_limcode_error([&] { (void)decode_frames_parallel(bad_magic); }));
+
+  auto bad_flags = stream;
+  bad_flags[5] |= 0x80;
+  assert(throws_limcode_error([&] { (void)decode_frames_parallel(bad_flags); }));
+
+  // Garbage in a compressed payload is caught by zstd or the size check
+  FrameHeader header;
+  [[maybe_unused]] bool have_header = read_frame_header(stream, header);
+  assert(have_header && header.compressed());
+  auto bad_payload = stream;
+  std::memset(bad_payload.data() + FRAME_HEADER_SIZE, 0xAB, 8);
+  assert(throws_limcode_error([&] { (void)decode_frames_parallel(bad_payload); }));
+
+  std::cout << "  Frame corruption: PASS\n";
+}
+
+int main() {
+  std::cout << "\nLimcode Framed Batch Tests\n\n";
+
+  test_frame_round_trip();
+  test_frame_dictionary();
+  test_frame_corruption();
+
+  std::cout << "\nAll framed batch tests passed!\n";
+  return 0;
+}
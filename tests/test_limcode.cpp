@@ -4,9 +4,31 @@
  */
 
 #include <limcode/limcode.h>
+#include <limcode/arena.h>
+#include <limcode/async.h>
+#include <limcode/streaming.h>
+#include <limcode/gossip.h>
+#include <limcode/intern.h>
+#include <limcode/ledger.h>
+#include <limcode/prefetch_reader.h>
+#include <limcode/schema.h>
+#include <limcode/snapshot_arena.h>
+#include <limcode/snapshot_filter.h>
+#include <limcode/snapshot_hash.h>
+#include <limcode/snapshot_manifest.h>
+#include <limcode/snapshot_writer.h>
+#include <limcode_parallel.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <numeric>
+#include <sstream>
+#include <thread>
 
 using namespace limcode;
 
@@ -159,6 +181,2241 @@ void test_round_trip() {
   std::cout << "  Round-trip serialization: PASS\n";
 }
 
+// Mixed legacy / v0 entries with multi-byte ShortVec lengths
+static std::vector<Entry> make_test_entries(size_t count) {
+  std::vector<Entry> entries;
+  for (size_t i = 0; i < count; ++i) {
+    Entry e;
+    e.num_hashes = i * 7 + 1;
+    e.hash.fill(static_cast<uint8_t>(i));
+
+    for (size_t t = 0; t < i % 3; ++t) {
+      VersionedTransaction tx;
+      Signature sig;
+      sig.fill(static_cast<uint8_t>(0xA0 + t));
+      tx.signatures = {sig, sig};
+
+      CompiledInstruction instr;
+      instr.program_id_index = 1;
+      instr.accounts = {0, 1};
+      instr.data.assign(200 + i, static_cast<uint8_t>(t));
+
+      Pubkey key;
+      key.fill(static_cast<uint8_t>(0x10 + i));
+      if (t % 2 == 0) {
+        LegacyMessage msg;
+        msg.header = {2, 0, 1};
+        msg.account_keys = {key, key};
+        msg.recent_blockhash.fill(0xEE);
+        msg.instructions.push_back(instr);
+        tx.message.set_legacy(std::move(msg));
+      } else {
+        V0Message msg;
+        msg.header = {2, 1, 0};
+        msg.account_keys = {key, key};
+        msg.recent_blockhash.fill(0xEF);
+        msg.instructions = {instr, instr};
+        AddressTableLookup atl;
+        atl.account_key.fill(0xDD);
+        atl.writable_indexes = {3, 4};
+        atl.readonly_indexes = {5};
+        msg.address_table_lookups.push_back(atl);
+        tx.message.set_v0(std::move(msg));
+      }
+      e.transactions.push_back(std::move(tx));
+    }
+    entries.push_back(std::move(e));
+  }
+  return entries;
+}
+
+void test_streaming_decoder() {
+  auto entries = make_test_entries(12);
+  auto bytes = limcode::serialize_entries(entries);
+
+  // Any fragmentation must decode to the same entries
+  for (size_t chunk_size : {size_t(1), size_t(7), size_t(13), bytes.size()}) {
+    StreamingDecoder decoder(StreamingDecoder::Target::Entries);
+    std::vector<Entry> decoded;
+    StreamStatus status = StreamStatus::NeedMoreData;
+
+    for (size_t off = 0; off < bytes.size(); off += chunk_size) {
+      std::span<const uint8_t> in(bytes.data() + off,
+                                  std::min(chunk_size, bytes.size() - off));
+      while ((status = decoder.feed(in)) == StreamStatus::Complete) {
+        decoded.push_back(decoder.take_entry());
+      }
+      assert(status != StreamStatus::Error && "fragmented input must decode");
+      assert((status != StreamStatus::NeedMoreData || in.empty()) &&
+             "NeedMoreData only once the chunk is consumed");
+    }
+    assert(status == StreamStatus::Done && "batch should be fully decoded");
+    assert(decoded == entries && "streamed entries should match");
+  }
+
+  // Transaction target, split in two mid-message
+  const auto &tx = entries[5].transactions[1];
+  auto tx_bytes = limcode::serialize_transaction(tx);
+  StreamingDecoder tx_decoder(StreamingDecoder::Target::Transaction);
+  std::span<const uint8_t> first(tx_bytes.data(), tx_bytes.size() / 2);
+  std::span<const uint8_t> second(tx_bytes.data() + tx_bytes.size() / 2,
+                                  tx_bytes.size() - tx_bytes.size() / 2);
+  [[maybe_unused]] StreamStatus first_status = tx_decoder.feed(first);
+  assert(first_status == StreamStatus::NeedMoreData);
+  assert(tx_decoder.in_progress());
+  [[maybe_unused]] StreamStatus second_status = tx_decoder.feed(second);
+  assert(second_status == StreamStatus::Complete);
+  [[maybe_unused]] VersionedTransaction taken = tx_decoder.take_transaction();
+  assert(taken == tx && "transaction should match");
+
+  // Malformed ShortVec reports an error instead of throwing
+  const uint8_t bad[] = {0xFF, 0xFF, 0xFF, 0xFF};
+  std::span<const uint8_t> bad_in(bad);
+  StreamingDecoder bad_decoder(StreamingDecoder::Target::Transaction);
+  [[maybe_unused]] StreamStatus bad_status = bad_decoder.feed(bad_in);
+  assert(bad_status == StreamStatus::Error);
+  assert(bad_decoder.error() != nullptr);
+
+  // Empty batch
+  const uint8_t empty[8] = {};
+  std::span<const uint8_t> empty_in(empty);
+  StreamingDecoder empty_decoder(StreamingDecoder::Target::Entries);
+  [[maybe_unused]] StreamStatus empty_status = empty_decoder.feed(empty_in);
+  assert(empty_status == StreamStatus::Done);
+
+  std::cout << "  Streaming decoder: PASS\n";
+}
+
+void test_arena_decode() {
+  auto entries = make_test_entries(12);
+  auto bytes = limcode::serialize_entries(entries);
+
+  DecodeArena arena(4096);
+  auto decoded = limcode::arena::deserialize_entries(bytes, arena);
+  assert(decoded.size() == entries.size() && "entry count should match");
+  for (size_t i = 0; i < entries.size(); ++i) {
+    assert(decoded[i].to_owned() == entries[i] && "arena entry should match");
+  }
+
+  // Same arena is reusable after an O(1) reset
+  arena.reset();
+  auto tx_bytes = limcode::serialize_transaction(entries[5].transactions[1]);
+  [[maybe_unused]] auto tx =
+      limcode::arena::deserialize_transaction(tx_bytes, arena);
+  assert(tx.message.is_v0 && tx.message.address_table_lookups.size() == 1);
+  assert(tx.to_owned() == entries[5].transactions[1]);
+
+  // Truncated input still throws like LimcodeDecoder
+  [[maybe_unused]] bool threw = false;
+  try {
+    (void)limcode::arena::deserialize_entries(
+        std::span<const uint8_t>(bytes.data(), bytes.size() - 1), arena);
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw && "truncated input should throw");
+
+  std::cout << "  Arena decode: PASS\n";
+}
+
+void test_sigverify_batch() {
+  auto entries = make_test_entries(12);
+  auto bytes = limcode::serialize_entries(entries);
+
+  SigverifyBatch batch;
+  [[maybe_unused]] size_t extracted =
+      limcode::extract_sigverify_batch(bytes, batch);
+  assert(extracted == entries.size());
+
+  size_t tx_index = 0;
+  size_t sig_index = 0;
+  for (const auto &entry : entries) {
+    for (const auto &tx : entry.transactions) {
+      LimcodeEncoder encoder;
+      encoder.write_versioned_message(tx.message);
+      assert(std::ranges::equal(batch.message(tx_index), encoder.data()) &&
+             "message range should cover the serialized message");
+      assert(batch.first_signature[tx_index] == sig_index);
+
+      [[maybe_unused]] const auto &keys =
+          tx.message.is_v0() ? tx.message.as_v0().account_keys
+                             : tx.message.as_legacy().account_keys;
+      for (size_t s = 0; s < tx.signatures.size(); ++s, ++sig_index) {
+        assert(std::memcmp(batch.signatures[sig_index],
+                           tx.signatures[s].data(), SIGNATURE_BYTES) == 0);
+        assert(std::memcmp(batch.pubkeys[sig_index], keys[s].data(),
+                           PUBKEY_BYTES) == 0);
+        assert(batch.signature_message[sig_index] == tx_index);
+      }
+      ++tx_index;
+    }
+  }
+  assert(batch.num_transactions() == tx_index);
+  assert(batch.num_signatures() == sig_index);
+
+  // More signatures than the header requires is rejected
+  auto bad = entries[2];
+  bad.transactions[0].signatures.push_back(Signature{});
+  std::vector<Entry> bad_batch = {bad};
+  auto bad_bytes = limcode::serialize_entries(bad_batch);
+  [[maybe_unused]] bool threw = false;
+  try {
+    (void)limcode::extract_sigverify_batch(bad_bytes, batch);
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw && "signature/header mismatch should throw");
+
+  std::cout << "  Sigverify batch: PASS\n";
+}
+
+void test_parallel_deserialize() {
+  auto entries = make_test_entries(300);
+  auto bytes = limcode::serialize_entries(entries);
+
+  assert(limcode::deserialize_entries(bytes) == entries &&
+         "sequential decode should match");
+
+  for ([[maybe_unused]] size_t threads : {size_t(0), size_t(1), size_t(3)}) {
+    assert(limcode::deserialize_entries_parallel(bytes, threads) == entries &&
+           "parallel decode should match");
+  }
+
+  // Truncated input is caught by the pre-scan
+  [[maybe_unused]] bool threw = false;
+  try {
+    (void)limcode::deserialize_entries_parallel(
+        std::span<const uint8_t>(bytes.data(), bytes.size() - 1));
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw && "truncated input should throw");
+
+  std::cout << "  Parallel deserialize: PASS\n";
+}
+
+// Counts run() calls and forwards to an inner executor
+struct CountingExecutor : Executor {
+  Executor &inner;
+  std::atomic<size_t> runs{0};
+
+  explicit CountingExecutor(Executor &e) : inner(e) {}
+  size_t concurrency() const noexcept override { return inner.concurrency(); }
+  void run(size_t num_tasks, TaskRef task) override {
+    runs.fetch_add(1);
+    inner.run(num_tasks, task);
+  }
+};
+
+void test_executor() {
+  ExecutorOptions opts;
+  opts.num_threads = 4;
+  WorkStealingExecutor pool(opts);
+  assert(pool.concurrency() == 4);
+
+  // Every index runs exactly once; nested run() executes inline
+  std::vector<std::atomic<int>> hits(1000);
+  pool.run(hits.size(), [&](size_t i) {
+    hits[i].fetch_add(1);
+    if (i % 100 == 0) {
+      pool.parallel_for(10, 0, [](size_t, size_t) {});
+    }
+  });
+  for ([[maybe_unused]] const auto &h : hits) {
+    assert(h.load() == 1 && "each task should run once");
+  }
+
+  // First task exception reaches the caller
+  [[maybe_unused]] bool threw = false;
+  try {
+    pool.run(64, [](size_t i) {
+      if (i == 17) {
+        throw LimcodeError::invalid_encoding("boom");
+      }
+    });
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw && "task exception should propagate");
+
+  // Injected executor is used by the parallel APIs
+  CountingExecutor counting(pool);
+  set_default_executor(&counting);
+  auto entries = make_test_entries(100);
+  auto bytes = limcode::serialize_entries_parallel(entries);
+  assert(bytes == limcode::serialize_entries(entries));
+  assert(limcode::serialize_entries_ultra_parallel(entries) == bytes);
+  assert(limcode::deserialize_entries_parallel(bytes) == entries);
+
+  std::vector<VersionedTransaction> txs;
+  for (const auto &e : entries) {
+    txs.insert(txs.end(), e.transactions.begin(), e.transactions.end());
+  }
+  auto encoded = limcode::encode_transactions_parallel(txs.begin(), txs.end());
+  for (size_t i = 0; i < txs.size(); ++i) {
+    assert(encoded[i] == limcode::serialize_transaction(txs[i]));
+  }
+  assert(counting.runs.load() >= 5 && "parallel APIs should use the executor");
+  set_default_executor(nullptr);
+
+  std::cout << "  Executor: PASS\n";
+}
+
+void test_simd_dispatch() {
+  // Every kernel the CPU supports matches memcpy for odd sizes/alignments
+  std::vector<uint8_t> src(70000);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<uint8_t>(i * 131 + 7);
+  }
+
+  const SimdLevel max_level = limcode::simd::detect_cpu_level();
+  assert(simd_level() <= max_level && "dispatch must not exceed the CPU");
+
+  for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (level > max_level) {
+      continue;
+    }
+    const SimdKernels &kernels = limcode::simd_kernels_for(level);
+    for (size_t len : {size_t(0), size_t(1), size_t(63), size_t(1000),
+                       size_t(4099), size_t(65537)}) {
+      for (size_t offset : {size_t(0), size_t(3)}) {
+        std::vector<uint8_t> dst(len + 8, 0xCC);
+        kernels.copy(dst.data() + offset, src.data() + 1, len);
+        assert(std::memcmp(dst.data() + offset, src.data() + 1, len) == 0);
+        assert(dst[offset + len] == 0xCC && "copy must not overrun");
+
+        std::fill(dst.begin(), dst.end(), 0xCC);
+        kernels.copy_nt(dst.data() + offset, src.data() + 1, len);
+        assert(std::memcmp(dst.data() + offset, src.data() + 1, len) == 0);
+        assert(dst[offset + len] == 0xCC && "NT copy must not overrun");
+      }
+    }
+  }
+
+  // POD serialize goes through the dispatched copy; 17 chunks of 64 bytes
+  std::vector<uint64_t> pod(17 * 8 + 3);
+  std::iota(pod.begin(), pod.end(), uint64_t(1));
+  std::vector<uint8_t> out;
+  limcode::serialize(out, pod);
+  assert(out.size() == 8 + pod.size() * 8);
+  assert(std::memcmp(out.data() + 8, pod.data(), pod.size() * 8) == 0);
+
+  std::cout << "  SIMD dispatch: PASS\n";
+}
+
+void test_gossip_contact_info() {
+  GossipContactInfo ci;
+  ci.pubkey.fill(0x5A);
+  ci.wallclock = 1'700'000'000'123ULL; // multi-byte varint
+  ci.outset = 42;
+  ci.shred_version = 50093;
+  ci.version.commit = 0xDEADBEEF;
+  GossipIpAddr v4;
+  v4.v4_bytes = {10, 0, 0, 1};
+  GossipIpAddr v6;
+  v6.is_v4 = false;
+  v6.v6_bytes.fill(0xFE);
+  ci.addrs = {v4, v6};
+  ci.sockets = {{static_cast<uint8_t>(SocketTag::GOSSIP), 0, 8001},
+                {static_cast<uint8_t>(SocketTag::TPU_QUIC), 1, 200}};
+
+  LimcodeEncoder encoder;
+  encoder.write_crds_data_contact_info(ci);
+  encoder.write_crds_data_contact_info(ci);
+  const auto &bytes = encoder.data();
+
+  LimcodeDecoder decoder(bytes);
+  [[maybe_unused]] GossipContactInfo first =
+      decoder.read_crds_data_contact_info();
+  [[maybe_unused]] GossipContactInfo second =
+      decoder.read_crds_data_contact_info();
+  assert(first == ci && second == ci);
+  assert(decoder.is_exhausted());
+
+  // View: filter fields are available without materializing the lists
+  StructuredZeroCopyDecoder zc(bytes);
+  CrdsDataView view = zc.read_crds_data_view();
+  assert(view.type == CrdsDataType::ContactInfo);
+  assert(view.contact_info.pubkey == ci.pubkey);
+  assert(view.contact_info.wallclock == ci.wallclock);
+  assert(view.contact_info.shred_version == ci.shred_version);
+  assert(view.contact_info.version == ci.version);
+  assert(view.contact_info.addrs_count == 2);
+  assert(view.contact_info.sockets_count == 2);
+  assert(view.size * 2 == bytes.size());
+  assert(view.contact_info.to_owned() == ci);
+  (void)zc.read_crds_data_view();
+  assert(!zc.has_remaining());
+
+  // Wrong variant, unknown discriminant and truncation are rejected
+  std::vector<uint8_t> vote = bytes;
+  vote[0] = static_cast<uint8_t>(CrdsDataType::Vote);
+  LimcodeDecoder vote_decoder(vote);
+  [[maybe_unused]] bool threw = false;
+  try {
+    (void)vote_decoder.read_crds_data_contact_info();
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw);
+
+  std::vector<uint8_t> unknown = bytes;
+  unknown[0] = 99;
+  threw = false;
+  try {
+    StructuredZeroCopyDecoder bad(unknown);
+    (void)bad.read_crds_data_view();
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw);
+
+  threw = false;
+  try {
+    LimcodeDecoder short_decoder(bytes.data(), view.size - 1);
+    (void)short_decoder.read_crds_data_contact_info();
+  } catch (const LimcodeError &e) {
+    threw = e.code() == ErrorCode::BufferUnderflow;
+  }
+  assert(threw);
+
+  std::cout << "  Gossip ContactInfo decode: PASS\n";
+}
+
+void test_crds_data_variants() {
+  Pubkey from;
+  from.fill(0x11);
+  Hash hash;
+  hash.fill(0x22);
+
+  GossipSocketAddr addr;
+  addr.ip.v4_bytes = {127, 0, 0, 1};
+  addr.port = 8001;
+  GossipLegacyContactInfo legacy_ci;
+  legacy_ci.id = from;
+  legacy_ci.gossip = addr;
+  legacy_ci.rpc.ip.is_v4 = false;
+  legacy_ci.rpc.ip.v6_bytes.fill(0xAB);
+  legacy_ci.rpc.port = 8899;
+  legacy_ci.wallclock = 1;
+
+  GossipVote vote;
+  vote.index = 3;
+  vote.from = from;
+  vote.transaction.signatures.resize(1);
+  LegacyMessage vote_msg;
+  vote_msg.header.num_required_signatures = 1;
+  vote_msg.account_keys = {from};
+  vote_msg.instructions.push_back(CompiledInstruction{0, {0}, {1, 2, 3}});
+  vote.transaction.message = VersionedMessage(vote_msg);
+  vote.wallclock = 2;
+
+  GossipLowestSlot lowest;
+  lowest.from = from;
+  lowest.root = 100;
+  lowest.lowest = 90;
+  lowest.wallclock = 3;
+
+  GossipAccountsHashes accounts_hashes;
+  accounts_hashes.from = from;
+  accounts_hashes.hashes = {{7, hash}, {8, hash}};
+  accounts_hashes.wallclock = 4;
+
+  GossipEpochSlots epoch_slots;
+  epoch_slots.index = 1;
+  epoch_slots.from = from;
+  GossipCompressedSlots flate2;
+  flate2.is_flate2 = true;
+  flate2.first_slot = 10;
+  flate2.num = 5;
+  flate2.compressed = {0x78, 0x9C, 0x01};
+  GossipCompressedSlots raw;
+  raw.first_slot = 20;
+  raw.num = 9;
+  raw.slots = {{0xFF, 0x01}, 9};
+  epoch_slots.slots = {flate2, raw};
+  epoch_slots.wallclock = 5;
+
+  GossipLegacyVersion legacy_version{from, 6, 1, 18, 3, 0xCAFE};
+  GossipNodeVersion node_version{from, 7, 2, 0, 1, std::nullopt, 0x1234};
+  GossipNodeInstance instance{from, 8, 99, 0xABCDEF};
+
+  GossipDuplicateShred dup;
+  dup.index = 2;
+  dup.from = from;
+  dup.wallclock = 9;
+  dup.slot = 1000;
+  dup.num_chunks = 3;
+  dup.chunk_index = 1;
+  dup.chunk.assign(300, 0x5C);
+
+  GossipSnapshotHashes snapshot{from, {500, hash}, {{510, hash}}, 10};
+
+  GossipContactInfo ci;
+  ci.pubkey = from;
+  ci.wallclock = 11;
+  ci.addrs = {addr.ip};
+  ci.sockets = {{static_cast<uint8_t>(SocketTag::GOSSIP), 0, 8001}};
+
+  GossipRestartLastVotedForkSlots rlv;
+  rlv.from = from;
+  rlv.wallclock = 12;
+  rlv.run_lengths = {1, 300, 2};
+  rlv.last_voted_slot = 77;
+  rlv.last_voted_hash = hash;
+  GossipRestartLastVotedForkSlots rlv_raw = rlv;
+  rlv_raw.run_length_encoded = false;
+  rlv_raw.run_lengths.clear();
+  rlv_raw.raw_offsets = {{0x0F}, 4};
+
+  GossipRestartHeaviestFork heaviest{from, 13, 88, hash, 1'000'000, 50093};
+
+  std::vector<CrdsData> all = {
+      legacy_ci, vote, lowest, GossipLegacySnapshotHashes{accounts_hashes},
+      accounts_hashes, epoch_slots, legacy_version, node_version, instance,
+      dup, snapshot, ci, rlv, heaviest, rlv_raw};
+
+  for (size_t i = 0; i < all.size(); ++i) {
+    const CrdsData &data = all[i];
+    assert(static_cast<size_t>(data.type()) == (i < 14 ? i : 12));
+    assert(data.from() == from);
+
+    LimcodeEncoder encoder;
+    encoder.write_crds_data(data);
+    const auto &bytes = encoder.data();
+
+    LimcodeDecoder decoder(bytes);
+    [[maybe_unused]] CrdsData decoded = decoder.read_crds_data();
+    assert(decoded == data);
+    assert(decoder.is_exhausted());
+
+    StructuredZeroCopyDecoder zc(bytes);
+    [[maybe_unused]] CrdsDataView view = zc.read_crds_data_view();
+    assert(view.type == data.type());
+    assert(view.from == from);
+    assert(view.wallclock == data.wallclock());
+    assert(view.size == bytes.size());
+    assert(view.to_owned() == data);
+
+    // Every truncation is rejected by both paths
+    for (size_t cut = 0; cut < bytes.size(); cut += 7) {
+      [[maybe_unused]] bool threw = false;
+      try {
+        LimcodeDecoder short_decoder(bytes.data(), cut);
+        (void)short_decoder.read_crds_data();
+      } catch (const LimcodeError &) {
+        threw = true;
+      }
+      assert(threw);
+      threw = false;
+      try {
+        StructuredZeroCopyDecoder short_view(bytes.data(), cut);
+        (void)short_view.read_crds_data_view();
+      } catch (const LimcodeError &) {
+        threw = true;
+      }
+      assert(threw);
+    }
+  }
+
+  // CrdsValue = signature + data
+  CrdsValue value{{}, heaviest};
+  value.signature.fill(0x33);
+  LimcodeEncoder value_encoder;
+  value_encoder.write_crds_value(value);
+  LimcodeDecoder value_decoder(value_encoder.data());
+  [[maybe_unused]] CrdsValue decoded_value = value_decoder.read_crds_value();
+  assert(decoded_value == value);
+
+  std::cout << "  CrdsData variants: PASS\n";
+}
+
+void test_crds_packet_batcher() {
+  Pubkey self;
+  self.fill(0x44);
+
+  std::vector<CrdsValue> values;
+  for (uint64_t i = 0; i < 64; ++i) {
+    GossipDuplicateShred dup;
+    dup.from = self;
+    dup.wallclock = i;
+    dup.chunk.assign(static_cast<size_t>(i * 37 % 400), 0xD5);
+    values.push_back(CrdsValue{{}, dup});
+    values.push_back(
+        CrdsValue{{}, GossipNodeInstance{self, i, i * 2, i * 3}});
+  }
+  GossipDuplicateShred oversized;
+  oversized.chunk.assign(GOSSIP_PACKET_DATA_SIZE, 0);
+  values.insert(values.begin() + 5, CrdsValue{{}, oversized});
+
+  CrdsPacketBatcher batcher(GossipProtocolType::PushMessage, self);
+  size_t accepted = 0;
+  for (const auto &v : values) {
+    accepted += batcher.push(v) ? 1 : 0;
+  }
+  assert(accepted == values.size() - 1);
+  assert(batcher.dropped() == 1);
+  auto packets = batcher.finish();
+  assert(packets.size() > 1);
+  assert(batcher.open_values() == 0 && batcher.num_packets() == 0);
+
+  // Decode every packet; values come back in order and packing is greedy
+  std::vector<CrdsValue> decoded;
+  for (size_t p = 0; p < packets.size(); ++p) {
+    const auto &packet = packets[p];
+    assert(packet.size() <= GOSSIP_PACKET_DATA_SIZE);
+    LimcodeDecoder decoder(packet);
+    [[maybe_unused]] uint32_t protocol = decoder.read_u32();
+    assert(protocol == static_cast<uint32_t>(GossipProtocolType::PushMessage));
+    [[maybe_unused]] Pubkey from = decoder.read_pod<Pubkey>();
+    assert(from == self);
+    uint64_t count = decoder.read_u64();
+    assert(count > 0);
+    for (uint64_t i = 0; i < count; ++i) {
+      decoded.push_back(decoder.read_crds_value());
+    }
+    assert(decoder.is_exhausted());
+
+    // The next packet's first value would not have fit in this one
+    if (p + 1 < packets.size()) {
+      LimcodeDecoder peek(packets[p + 1]);
+      peek.skip(CrdsPacketBatcher::HEADER_SIZE);
+      [[maybe_unused]] size_t before = peek.position();
+      (void)peek.read_crds_value();
+      assert(packet.size() + (peek.position() - before) >
+             GOSSIP_PACKET_DATA_SIZE);
+    }
+  }
+  values.erase(values.begin() + 5);
+  assert(decoded == values);
+
+  std::cout << "  CRDS packet batcher: PASS\n";
+}
+
+void test_encode_into_caller_memory() {
+  auto entries = make_test_entries(9);
+  const auto expected = limcode::serialize_entries(entries);
+
+  // Whole batch into a caller buffer
+  std::vector<uint8_t> out(expected.size() + 16, 0xCC);
+  [[maybe_unused]] size_t written = limcode::serialize_entries_into(entries, out);
+  assert(written == expected.size());
+  assert(std::equal(expected.begin(), expected.end(), out.begin()));
+  assert(out[written] == 0xCC);
+
+  // Too small: throws and leaves the buffer untouched
+  std::vector<uint8_t> small(expected.size() - 1, 0xCC);
+  [[maybe_unused]] bool threw = false;
+  try {
+    (void)limcode::serialize_entries_into(entries, small);
+  } catch (const LimcodeError &e) {
+    threw = e.code() == ErrorCode::BufferOverflow;
+  }
+  assert(threw);
+  assert(std::all_of(small.begin(), small.end(),
+                     [](uint8_t b) { return b == 0xCC; }));
+
+  // One transaction per packet slot
+  std::vector<VersionedTransaction> txs;
+  for (const auto &e : entries) {
+    txs.insert(txs.end(), e.transactions.begin(), e.transactions.end());
+  }
+  constexpr size_t SLOT = 1232;
+  std::vector<uint8_t> ring(SLOT * 4);
+  std::vector<size_t> lengths(4);
+  size_t n = limcode::serialize_transactions_into_slots(txs, ring, SLOT, lengths);
+  assert(n == std::min<size_t>(4, txs.size()));
+  for (size_t i = 0; i < n; ++i) {
+    auto one = limcode::serialize_transaction(txs[i]);
+    assert(lengths[i] == one.size());
+    assert(std::equal(one.begin(), one.end(), ring.begin() + i * SLOT));
+  }
+
+  // Scatter/gather: large runs reference the source entries
+  limcode::IovecEncoder iov_encoder(128);
+  iov_encoder.write_entries(entries);
+  const auto &iov = iov_encoder.iovecs();
+  std::vector<uint8_t> gathered;
+  bool references_source = false;
+  const auto *sigs = entries[1].transactions[0].signatures.data();
+  for (const auto &seg : iov) {
+    const auto *base = static_cast<const uint8_t *>(seg.iov_base);
+    gathered.insert(gathered.end(), base, base + seg.iov_len);
+    references_source |= seg.iov_base == static_cast<const void *>(sigs);
+  }
+  assert(gathered == expected);
+  assert(iov_encoder.size() == expected.size());
+  assert(references_source);
+  assert(iov_encoder.referenced_bytes() > expected.size() / 2);
+
+  std::cout << "  Encode into caller memory / iovec: PASS\n";
+}
+
+void test_single_pass_encoder() {
+  auto entries = make_test_entries(40);
+  // Multi-byte ShortVec lengths and a buffer-growing instruction
+  VersionedTransaction big;
+  big.signatures.resize(1);
+  LegacyMessage msg;
+  msg.header = {1, 0, 0};
+  msg.account_keys.resize(200);
+  msg.instructions.push_back(CompiledInstruction{0, {0}, {}});
+  msg.instructions[0].data.assign(20000, 0x7E);
+  big.message.set_legacy(std::move(msg));
+  entries[3].transactions.push_back(big);
+
+  // Reference: the growable LimcodeEncoder path
+  LimcodeEncoder reference;
+  reference.write_u64(entries.size());
+  for (const auto &e : entries) {
+    reference.write_entry(e);
+  }
+  [[maybe_unused]] const auto &expected = reference.data();
+
+  assert(limcode::serialize_entries(entries) == expected);
+  assert(limcode::serialize_entries_parallel(entries, 1) == expected);
+
+  LimcodeEncoder one;
+  one.write_entry(entries[3]);
+  assert(limcode::serialize_entry(entries[3]) == one.data());
+
+  std::vector<VersionedTransaction> txs;
+  for (const auto &e : entries) {
+    txs.insert(txs.end(), e.transactions.begin(), e.transactions.end());
+  }
+  LimcodeEncoder tx_reference;
+  tx_reference.write_u64(txs.size());
+  for (const auto &tx : txs) {
+    tx_reference.write_versioned_transaction(tx);
+  }
+  assert(limcode::serialize_transactions(txs) == tx_reference.data());
+  assert(limcode::serialize_transactions_parallel(txs, 1) ==
+         tx_reference.data());
+
+  std::cout << "  Single-pass encoder: PASS\n";
+}
+
+void test_encoder_policies() {
+  auto entries = make_test_entries(30);
+  // Instruction data past SIMD_DISPATCH_MIN_BYTES takes the bulk kernels
+  entries[5].transactions[0].message.as_legacy().instructions[0].data.assign(
+      4096, 0x5A);
+
+  // Round trip through the (independent) decoder
+  auto expected = limcode::serialize_entries(entries);
+  assert(limcode::deserialize_entries(expected) == entries);
+
+  auto encode = [&](auto &encoder) {
+    encoder.write_u64(entries.size());
+    encoder.write_entries(entries.data(), entries.size());
+    return encoder.to_vector();
+  };
+  limcode::Encoder<limcode::CheckedPolicy> checked(16);
+  limcode::Encoder<limcode::UncheckedPolicy> unchecked(expected.size());
+  limcode::Encoder<limcode::ThroughputPolicy> throughput(16);
+  limcode::Encoder<limcode::StreamingPolicy> streaming(16);
+  assert(encode(checked) == expected);
+  assert(encode(unchecked) == expected);
+  assert(encode(throughput) == expected);
+  assert(encode(streaming) == expected);
+  assert(limcode::serialize_entries_turbo(entries) == expected);
+  assert(limcode::serialize_entries_ultra_vec(entries) == expected);
+  assert(limcode::serialize_entries_hyper_vec(entries) == expected);
+
+  // Append mode extends the vector and trims it on destruction
+  std::vector<uint8_t> sink = {0xAB};
+  {
+    limcode::Encoder<> append(sink);
+    append.write_entry(entries[1]);
+  }
+  auto one = limcode::serialize_entry(entries[1]);
+  assert(sink.size() == 1 + one.size() && sink[0] == 0xAB);
+  assert(std::equal(one.begin(), one.end(), sink.begin() + 1));
+
+  // A reset rewinds to the starting size, not over the caller's prefix
+  {
+    limcode::Encoder<> append(sink);
+    append.write_entry(entries[0]);
+    append.reset();
+    append.write_entry(entries[1]);
+    append.reset_and_trim(0);
+    append.write_entry(entries[1]);
+  }
+  assert(sink.size() == 1 + 2 * one.size() && sink[0] == 0xAB);
+  assert(std::equal(one.begin(), one.end(), sink.begin() + 1 + one.size()));
+
+  // Checked writes into caller memory throw instead of overrunning
+  std::vector<uint8_t> small(expected.size() - 1);
+  limcode::Encoder<> external{std::span<uint8_t>(small)};
+  [[maybe_unused]] bool threw = false;
+  try {
+    (void)encode(external);
+  } catch (const LimcodeError &e) {
+    threw = e.code() == ErrorCode::BufferOverflow;
+  }
+  assert(threw);
+
+  // Lengths a ShortVec can't hold are rejected, not truncated
+  Entry wide;
+  wide.transactions.resize(1);
+  LegacyMessage msg;
+  msg.account_keys.resize(70000);
+  wide.transactions[0].message.set_legacy(std::move(msg));
+  threw = false;
+  try {
+    checked.write_entry(wide);
+  } catch (const LimcodeError &e) {
+    threw = e.code() == ErrorCode::InvalidLength;
+  }
+  assert(threw);
+
+  // Thread-local span paths grow past their initial scratch
+  std::vector<Entry> large(300);
+  for (auto &e : large) {
+    e.transactions.resize(1);
+    LegacyMessage m;
+    m.instructions.push_back(CompiledInstruction{0, {}, {}});
+    m.instructions[0].data.assign(60000, 0x33);
+    e.transactions[0].message.set_legacy(std::move(m));
+  }
+  auto large_bytes = limcode::serialize_entries(large);
+  assert(large_bytes.size() > 16 * 1024 * 1024);
+  auto ultra = limcode::serialize_entries_ultra(large);
+  assert(std::equal(ultra.begin(), ultra.end(), large_bytes.begin(),
+                    large_bytes.end()));
+
+  std::cout << "  Encoder<Policy>: PASS\n";
+}
+
+void test_varint_batch_decode() {
+  const std::vector<uint64_t> values = {
+      0,         1,          127,        128,        255,
+      16383,     16384,      65535,      1ULL << 21, 1ULL << 35,
+      1ULL << 49, (1ULL << 56) - 1, 1ULL << 56, UINT64_MAX, 300};
+
+  // Every trailing-padding length moves values across the 8-byte window
+  // edge and into the scalar tail
+  for (size_t pad = 0; pad < 10; ++pad) {
+    LimcodeEncoder encoder;
+    for (uint64_t v : values) {
+      encoder.write_varint(v);
+    }
+    std::vector<uint8_t> bytes = encoder.data();
+    bytes.insert(bytes.end(), pad, 0xEE);
+
+    LimcodeDecoder decoder(bytes);
+    ZeroCopyDecoder zc(bytes);
+    for ([[maybe_unused]] uint64_t v : values) {
+      [[maybe_unused]] uint64_t decoded = decoder.read_varint();
+      [[maybe_unused]] uint64_t viewed = zc.read_varint();
+      assert(decoded == v && viewed == v);
+    }
+    assert(decoder.remaining() == pad && zc.remaining() == pad);
+  }
+
+  // Bulk kernel: every value that ends in a window, stopping near the end
+  {
+    std::vector<uint8_t> bytes;
+    std::vector<uint64_t> small;
+    for (uint64_t i = 0; i < 100; ++i) {
+      small.push_back((i * 977) % 70000);
+      LimcodeEncoder encoder;
+      encoder.write_varint(small.back());
+      bytes.insert(bytes.end(), encoder.data().begin(), encoder.data().end());
+    }
+    std::vector<uint64_t> out(small.size());
+    size_t consumed = 0;
+    [[maybe_unused]] size_t n = limcode_decode_varints(
+        bytes.data(), bytes.size(), out.data(), out.size(), consumed);
+    assert(n > 90 && n <= small.size() && consumed + 8 > bytes.size() - 8);
+    assert(std::equal(out.begin(), out.begin() + n, small.begin()));
+
+    // read_varints_u16 finishes the tail; 70000 > u16 must still throw
+    [[maybe_unused]] bool threw = false;
+    try {
+      std::vector<uint16_t> runs(small.size());
+      LimcodeDecoder decoder(bytes);
+      decoder.read_varints_u16(runs.data(), runs.size());
+    } catch (const LimcodeError &e) {
+      threw = e.code() == ErrorCode::InvalidEncoding;
+    }
+    assert(threw);
+
+    for (auto &v : small) {
+      v &= 0x7FFF;
+    }
+    bytes.clear();
+    for (uint64_t v : small) {
+      LimcodeEncoder encoder;
+      encoder.write_varint(v);
+      bytes.insert(bytes.end(), encoder.data().begin(), encoder.data().end());
+    }
+    std::vector<uint16_t> runs(small.size());
+    LimcodeDecoder decoder(bytes);
+    decoder.read_varints_u16(runs.data(), runs.size());
+    assert(decoder.remaining() == 0);
+    assert(std::equal(runs.begin(), runs.end(), small.begin()));
+
+    ZeroCopyDecoder zc(bytes);
+    zc.skip_varints_u16(0, small.size());
+    assert(zc.remaining() == 0);
+  }
+
+  // ShortVec lengths, with and without readable bytes past the prefix
+  for (uint16_t v : {0, 1, 127, 128, 255, 16383, 16384, 65535}) {
+    for (size_t pad : {0, 8}) {
+      std::vector<uint8_t> bytes(3 + pad, 0xEE);
+      bytes.resize(encode_short_vec(v, bytes.data()) + pad);
+      LimcodeDecoder decoder(bytes);
+      ZeroCopyDecoder zc(bytes);
+      [[maybe_unused]] uint16_t decoded = decoder.read_short_vec_len();
+      [[maybe_unused]] uint16_t viewed = zc.read_short_vec_len();
+      assert(decoded == v && viewed == v);
+      assert(decoder.remaining() == pad && zc.remaining() == pad);
+    }
+  }
+
+  [[maybe_unused]] auto error_code = [](auto &&fn) {
+    try {
+      fn();
+    } catch (const LimcodeError &e) {
+      return e.code();
+    }
+    return ErrorCode::Ok;
+  };
+  for (size_t pad : {0, 8}) {
+    std::vector<uint8_t> overlong = {0x80, 0x80, 0x80, 0x01};
+    overlong.insert(overlong.end(), pad, 0);
+    assert(error_code([&] {
+             LimcodeDecoder d(overlong);
+             (void)d.read_short_vec_len();
+           }) == ErrorCode::InvalidEncoding);
+    assert(error_code([&] {
+             ZeroCopyDecoder d(overlong);
+             (void)d.read_short_vec_len();
+           }) == ErrorCode::InvalidEncoding);
+
+    std::vector<uint8_t> varint(11, 0xFF);
+    varint.insert(varint.end(), pad, 0);
+    assert(error_code([&] {
+             LimcodeDecoder d(varint);
+             (void)d.read_varint();
+           }) == ErrorCode::InvalidEncoding);
+  }
+  std::vector<uint8_t> truncated = {0x80};
+  assert(error_code([&] {
+           LimcodeDecoder d(truncated);
+           (void)d.read_short_vec_len();
+         }) == ErrorCode::BufferUnderflow);
+
+  // Batched instruction skips agree with the full decoder, and a cut
+  // transaction still reports underflow
+  auto entries = make_test_entries(4);
+  auto &instrs = entries[2].transactions[0].message.as_legacy().instructions;
+  instrs[0].data.assign(300, 0x42);
+  for (int i = 0; i < 20; ++i) {
+    instrs.push_back(CompiledInstruction{1, {0, 1}, {uint8_t(i)}});
+  }
+  for (const auto &tx : entries[2].transactions) {
+    auto tx_bytes = serialize_transaction(tx);
+    StructuredZeroCopyDecoder view_decoder(tx_bytes);
+    auto view = view_decoder.read_versioned_transaction_view();
+    assert(view_decoder.remaining() == 0);
+    if (!view.message.is_v0) {
+      assert(view.message.legacy.instructions_count == instrs.size());
+    }
+    for (size_t cut = 1; cut < 40; ++cut) {
+      std::span<const uint8_t> part(tx_bytes.data(), tx_bytes.size() - cut);
+      assert(error_code([&] {
+               StructuredZeroCopyDecoder d(part);
+               (void)d.read_versioned_transaction_view();
+             }) == ErrorCode::BufferUnderflow);
+    }
+  }
+
+  std::cout << "  Word-at-a-time varint decode: PASS\n";
+}
+
+void test_validate_wire_bytes() {
+  auto entries = make_test_entries(12);
+  auto bytes = serialize_entries(entries);
+
+  auto result = validate_entries(bytes);
+  assert(result.ok() && result.consumed == bytes.size());
+
+  // Trailing bytes are reported through consumed, not as an error
+  const auto &tx = entries[2].transactions[1];
+  auto tx_bytes = serialize_transaction(tx);
+  auto tx_size = tx_bytes.size();
+  tx_bytes.push_back(0xFF);
+  result = validate_transaction(tx_bytes);
+  assert(result && result.consumed == tx_size);
+
+  // Every truncation is an underflow, without throwing
+  for (size_t len = 0; len < tx_size; ++len) {
+    result = validate_transaction({tx_bytes.data(), len});
+    assert(result.error == ErrorCode::BufferUnderflow);
+  }
+  for (size_t len = 0; len < bytes.size(); len += 7) {
+    assert(!validate_entries({bytes.data(), len}));
+  }
+
+  // Non-canonical ShortVec: zero continuation (alias) and u16 overflow
+  std::vector<uint8_t> alias = {0x81, 0x00};
+  assert(validate_transaction(alias).error == ErrorCode::InvalidEncoding);
+  std::vector<uint8_t> wide = {0xFF, 0xFF, 0x04};
+  assert(validate_transaction(wide).error == ErrorCode::InvalidEncoding);
+  std::vector<uint8_t> too_long = {0x80, 0x80, 0x80, 0x01};
+  assert(validate_transaction(too_long).error == ErrorCode::InvalidEncoding);
+
+  // Only message version 0 is accepted
+  auto v1 = serialize_transaction(tx);
+  size_t prefix = 1 + tx.signatures.size() * SIGNATURE_BYTES;
+  assert(v1[prefix] == VERSION_PREFIX_MASK);
+  v1[prefix] |= 1;
+  result = validate_transaction(v1);
+  assert(result.error == ErrorCode::InvalidVersion && result.consumed == prefix);
+
+  // Entry counts the input can't hold
+  std::vector<uint8_t> huge(8, 0xFF);
+  assert(validate_entries(huge).error == ErrorCode::InvalidEncoding);
+
+  // Whatever the validator accepts, the decoder decodes to the same length
+  uint32_t seed = 12345;
+  for (int round = 0; round < 2000; ++round) {
+    auto mutated = bytes;
+    for (int k = 0; k < 3; ++k) {
+      seed = seed * 1103515245 + 12345;
+      mutated[(seed >> 8) % mutated.size()] ^= static_cast<uint8_t>(seed >> 24);
+    }
+    result = validate_entries(mutated);
+    if (result) {
+      LimcodeDecoder decoder(mutated);
+      uint64_t count = decoder.read_u64();
+      for (uint64_t i = 0; i < count; ++i) {
+        (void)decoder.read_entry();
+      }
+      assert(decoder.position() == result.consumed);
+    }
+  }
+
+  std::cout << "  Validate-only fast path: PASS\n";
+}
+
+void test_indexed_entry_view() {
+  Entry entry;
+  entry.num_hashes = 9;
+  entry.hash.fill(0x3C);
+  for (auto &source : make_test_entries(12)) {
+    for (auto &tx : source.transactions) {
+      entry.transactions.push_back(tx);
+    }
+  }
+  entry.transactions[3].message.as_legacy().instructions[0].data.assign(500, 1);
+  auto bytes = serialize_entry(entry);
+
+  IndexedEntryView view{std::span<const uint8_t>(bytes)};
+  assert(view.size() == entry.transactions.size() && !view.indexed());
+  assert(view.entry().num_hashes == 9);
+
+  // Any order; the table is built on the first access
+  for (size_t i = view.size(); i-- > 0;) {
+    [[maybe_unused]] auto tx = view.tx(i);
+    assert(tx.to_owned() == entry.transactions[i]);
+  }
+  assert(view.indexed());
+  assert(view[3].to_owned() == entry.transactions[3]);
+
+  auto tx_bytes = view.tx_bytes(5);
+  auto expected = serialize_transaction(entry.transactions[5]);
+  assert(std::equal(tx_bytes.begin(), tx_bytes.end(), expected.begin(),
+                    expected.end()));
+  assert(view.entry().transaction(5).to_owned() == entry.transactions[5]);
+
+  size_t i = 0;
+  for ([[maybe_unused]] const auto &tx : view) {
+    assert(tx.first_signature() == entry.transactions[i].signatures[0]);
+    ++i;
+  }
+  assert(i == view.size());
+
+  [[maybe_unused]] bool threw = false;
+  try {
+    (void)view.tx(view.size());
+  } catch (const LimcodeError &e) {
+    threw = e.code() == ErrorCode::InvalidLength;
+  }
+  assert(threw);
+
+  std::cout << "  IndexedEntryView: PASS\n";
+}
+
+void test_metrics() {
+  static_assert(metrics::bucket_index(0) == 0);
+  static_assert(metrics::bucket_index(1024) == 0);
+  static_assert(metrics::bucket_index(1025) == 1);
+  static_assert(metrics::bucket_index(2048) == 1);
+  static_assert(metrics::bucket_index(UINT64_MAX) ==
+                metrics::HISTOGRAM_BUCKETS - 1);
+
+  metrics::reset();
+  auto entries = make_test_entries(20);
+  auto bytes = serialize_entries(entries);
+  auto decoded = deserialize_entries(bytes);
+  assert(decoded == entries);
+
+  // A thread that exits hands its shard (and totals) back to the registry
+  std::thread([&] { (void)deserialize_entries(bytes); }).join();
+
+  auto snap = metrics::snapshot();
+  if constexpr (metrics::enabled) {
+    assert(snap.counter(metrics::Counter::BytesEncoded) == bytes.size());
+    assert(snap.counter(metrics::Counter::EntriesEncoded) == entries.size());
+    assert(snap.counter(metrics::Counter::BytesDecoded) == 2 * bytes.size());
+    assert(snap.counter(metrics::Counter::EntriesDecoded) ==
+           2 * entries.size());
+    [[maybe_unused]] const auto &decode = snap.stage(metrics::Stage::Decode);
+    assert(decode.count == 2 && decode.sum_ns > 0);
+    assert(decode.percentile_upper_bound_ns(99) >= decode.mean_ns());
+    assert(snap.stage(metrics::Stage::Encode).count == 1);
+  } else {
+    static_assert(sizeof(metrics::Snapshot) > 0);
+    for ([[maybe_unused]] uint64_t value : snap.counters) {
+      assert(value == 0);
+    }
+    assert(snap.stage(metrics::Stage::Decode).count == 0);
+  }
+
+  metrics::Snapshot fake;
+  fake.counters[static_cast<size_t>(metrics::Counter::BytesEncoded)] = 42;
+  auto &encode = fake.stages[static_cast<size_t>(metrics::Stage::Encode)];
+  encode.count = 3;
+  encode.sum_ns = 5000;
+  encode.buckets[0] = 1;
+  encode.buckets[2] = 2;
+  std::ostringstream text;
+  metrics::write_prometheus(text, fake);
+  std::string out = text.str();
+  assert(out.find("limcode_bytes_encoded_total 42\n") != std::string::npos);
+  assert(out.find("limcode_stage_duration_seconds_bucket{stage=\"encode\","
+                  "le=\"4.096e-06\"} 3\n") != std::string::npos);
+  assert(out.find("limcode_stage_duration_seconds_bucket{stage=\"encode\","
+                  "le=\"+Inf\"} 3\n") != std::string::npos);
+  assert(out.find("limcode_stage_duration_seconds_count{stage=\"encode\"} 3")
+         != std::string::npos);
+
+  std::cout << "  Metrics (" << (metrics::enabled ? "enabled" : "compiled out")
+            << "): PASS\n";
+}
+
+void test_prefetch_reader() {
+  // Three full 64 KiB chunks and an unaligned tail
+  std::vector<uint8_t> expected(3 * 65536 + 1234);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    expected[i] = static_cast<uint8_t>(i * 131 + (i >> 16));
+  }
+  auto path = (std::filesystem::temp_directory_path() /
+               ("limcode_prefetch_" + std::to_string(::getpid())))
+                  .string();
+  std::ofstream(path, std::ios::binary)
+      .write(reinterpret_cast<const char *>(expected.data()),
+             static_cast<std::streamsize>(expected.size()));
+
+  for (bool use_io_uring : {true, false}) {
+    for (bool direct_io : {true, false}) {
+      PrefetchOptions options;
+      options.chunk_size = 65536;
+      options.queue_depth = 3;
+      options.use_io_uring = use_io_uring;
+      options.direct_io = direct_io;
+      PrefetchReader reader(options);
+      [[maybe_unused]] bool opened = reader.open(path);
+      assert(opened);
+      assert(use_io_uring || reader.backend() == PrefetchReader::Backend::Thread);
+      assert(direct_io || !reader.direct());
+
+      std::vector<uint8_t> got;
+      std::span<const uint8_t> chunk;
+      size_t chunks = 0;
+      while (reader.next(chunk) && !chunk.empty()) {
+        got.insert(got.end(), chunk.begin(), chunk.end());
+        ++chunks;
+      }
+      assert(got == expected && chunks == 4);
+      [[maybe_unused]] bool at_end = reader.next(chunk);
+      assert(at_end && chunk.empty());
+    }
+  }
+
+  // Closing with reads still in flight
+  {
+    PrefetchOptions options;
+    options.chunk_size = 4096;
+    PrefetchReader reader(options);
+    [[maybe_unused]] bool opened = reader.open(path);
+    std::span<const uint8_t> chunk;
+    [[maybe_unused]] bool read = reader.next(chunk);
+    assert(opened && read && chunk.size() == 4096);
+    assert(std::equal(chunk.begin(), chunk.end(), expected.begin()));
+  }
+
+  std::ofstream(path, std::ios::trunc).close();
+  PrefetchReader empty;
+  std::span<const uint8_t> chunk;
+  [[maybe_unused]] bool opened = empty.open(path);
+  [[maybe_unused]] bool read = empty.next(chunk);
+  assert(opened && read && chunk.empty());
+  std::filesystem::remove(path);
+  [[maybe_unused]] bool reopened = empty.open(path);
+  assert(!reopened);
+
+  std::cout << "  PrefetchReader: PASS\n";
+}
+
+// Minimal well-formed manifest: one vote account, one delegation, one
+// epoch-stakes entry and three storages over two slots
+static std::vector<uint8_t> make_test_manifest(bool trailing_fields) {
+  std::vector<uint8_t> out;
+  auto u8 = [&](uint8_t v) { out.push_back(v); };
+  auto u64 = [&](uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+      out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+  };
+  auto fill = [&](size_t n, uint8_t v) { out.insert(out.end(), n, v); };
+  auto stakes = [&] {
+    u64(1);                       // vote accounts
+    fill(32, 0x71);               // pubkey
+    u64(500);                     // stake
+    u64(27074400);                // lamports
+    u64(3);                       // data
+    fill(3, 0xDA);
+    fill(32, 0x72);               // owner
+    u8(0);                        // executable
+    u64(UINT64_MAX);              // rent_epoch
+    u64(1);                       // stake delegations
+    fill(32 + 64, 0x73);
+    u64(0);                       // unused
+    u64(99);                      // epoch
+    u64(1);                       // stake history
+    fill(32, 0x74);
+  };
+
+  u64(7);                                   // blockhash queue
+  u8(1);
+  fill(32, 0x11);
+  u64(1);
+  fill(32 + 24, 0x12);
+  u64(300);
+  u64(2);                                   // ancestors
+  u64(1001);
+  u64(0);
+  u64(1000);
+  u64(0);
+  fill(32, 0xB1);                           // hash
+  fill(32, 0xB2);                           // parent_hash
+  u64(1000);                                // parent_slot
+  u64(1);                                   // hard forks
+  u64(500);
+  u64(1);
+  for (uint64_t v : {11u, 12u, 13u, 14u, 15u}) {
+    u64(v);                                 // transaction_count .. max_tick_height
+  }
+  u8(1);
+  u64(62500);                               // hashes_per_tick
+  u64(64);                                  // ticks_per_slot
+  u64(400000000);                           // ns_per_slot (u128)
+  u64(0);
+  u64(1584368940);                          // genesis_creation_time
+  double slots_per_year = 78892314.98;
+  out.insert(out.end(), reinterpret_cast<const uint8_t *>(&slots_per_year),
+             reinterpret_cast<const uint8_t *>(&slots_per_year) + 8);
+  u64(0);                                   // accounts_data_len
+  u64(1001);                                // slot
+  u64(2);                                   // epoch
+  u64(950);                                 // block_height
+  fill(32, 0xC0);                           // collector_id
+  u64(5000);                                // collector_fees
+  u64(5000);                                // fee_calculator
+  fill(33, 0);                              // fee_rate_governor
+  u64(42);                                  // collected_rent
+  fill(8 + 33 + 8 + 17, 0);                 // rent_collector
+  u64(432000);                              // epoch_schedule
+  u64(432000);
+  u8(1);
+  u64(14);
+  u64(524256);
+  fill(48, 0);                              // inflation
+  stakes();
+  u64(0);                                   // unused_accounts
+  u64(0);
+  u64(0);
+  u64(1);                                   // epoch stakes
+  u64(2);
+  stakes();
+  u64(500);                                 // total_stake
+  u64(1);                                   // node_id_to_vote_accounts
+  fill(32, 0x75);
+  u64(1);
+  fill(32, 0x71);
+  u64(500);
+  u64(1);                                   // epoch_authorized_voters
+  fill(64, 0x76);
+  u8(0);                                    // is_delta
+
+  u64(2);                                   // storages by slot
+  u64(1001);
+  u64(1);
+  u64(9);
+  u64(4096);
+  u64(1000);
+  u64(2);
+  u64(8);
+  u64(200);
+  u64(3);
+  u64(0);
+  u64(123456);                              // write_version
+  u64(1001);                                // slot
+  fill(32, 0xD1);                           // accounts_delta_hash
+  fill(32, 0xD2);                           // accounts_hash
+  for (uint64_t v : {1u, 2u, 3u, 4u, 5u}) {
+    u64(v);                                 // bank hash stats
+  }
+  u64(1);                                   // historical roots
+  u64(900);
+  u64(0);
+
+  if (trailing_fields) {
+    u64(5000);                              // lamports_per_signature
+    u8(1);                                  // incremental persistence
+    u64(900);
+    fill(32, 0xE1);
+    u64(77);
+    fill(32, 0xE2);
+    u64(88);
+    u8(1);                                  // epoch accounts hash
+    fill(32, 0xE3);
+    u64(0);                                 // later fields are ignored
+  }
+  return out;
+}
+
+void test_snapshot_manifest() {
+  using namespace limcode::snapshot;
+
+  auto bytes = make_test_manifest(true);
+  SnapshotManifest m = deserialize_manifest(bytes);
+  assert(m.slot == 1001 && m.parent_slot == 1000 && m.epoch == 2);
+  assert(m.block_height == 950 && m.capitalization == 14);
+  assert(m.bank_hash[0] == 0xB1 && m.parent_hash[31] == 0xB2);
+  assert((m.ancestors == std::vector<uint64_t>{1000, 1001}));
+  assert(m.hard_forks.size() == 1 && m.hard_forks[0].first == 500);
+  assert(m.hashes_per_tick == 62500u && m.ticks_per_slot == 64);
+  assert(m.ns_per_slot == 400000000 && m.collector_fees == 5000);
+  assert(m.epoch_schedule.slots_per_epoch == 432000 && m.epoch_schedule.warmup);
+  assert(m.epoch_schedule.first_normal_slot == 524256 && !m.is_delta);
+
+  std::vector<AccountStorageInfo> storages = {
+      {1000, 3, 0}, {1000, 8, 200}, {1001, 9, 4096}};
+  assert(m.storages == storages);
+  assert(m.find_storage(1001, 9)->current_len == 4096);
+  assert(m.find_storage(1001, 2) == nullptr);
+  assert(m.total_storage_bytes() == 4296);
+  assert(m.write_version == 123456 && m.accounts_slot == 1001);
+  assert(m.accounts_hash[0] == 0xD2 && m.bank_hash_stats.num_executable_accounts == 5);
+  assert((m.historical_roots == std::vector<uint64_t>{900}));
+
+  assert(m.lamports_per_signature == 5000);
+  assert(m.incremental_persistence && m.incremental_persistence->full_slot == 900);
+  assert(m.incremental_persistence->incremental_capitalization == 88);
+  assert(m.epoch_accounts_hash && (*m.epoch_accounts_hash)[0] == 0xE3);
+
+  // Older snapshots end after the accounts-db fields
+  auto old = deserialize_manifest(make_test_manifest(false));
+  assert(old.storages == storages && old.lamports_per_signature == 0);
+  assert(!old.incremental_persistence && !old.epoch_accounts_hash);
+
+  [[maybe_unused]] bool threw = false;
+  try {
+    (void)deserialize_manifest(std::span<const uint8_t>(bytes).first(600));
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw);
+
+  // serialize_manifest writes back everything the decoder keeps
+  SnapshotManifest again = deserialize_manifest(serialize_manifest(m));
+  assert(again.slot == m.slot && again.bank_hash == m.bank_hash);
+  assert(again.ancestors == m.ancestors && again.hard_forks == m.hard_forks);
+  assert(again.hashes_per_tick == m.hashes_per_tick && again.ns_per_slot == m.ns_per_slot);
+  assert(again.slots_per_year == m.slots_per_year && again.collector_id == m.collector_id);
+  assert(again.epoch_schedule.first_normal_slot == m.epoch_schedule.first_normal_slot);
+  assert(again.storages == storages && again.write_version == m.write_version);
+  assert(again.accounts_hash == m.accounts_hash && again.historical_roots == m.historical_roots);
+  assert(again.bank_hash_stats.num_executable_accounts == 5);
+  assert(again.lamports_per_signature == 5000);
+  assert(again.incremental_persistence->incremental_capitalization == 88);
+  assert(again.epoch_accounts_hash == m.epoch_accounts_hash);
+  assert(deserialize_manifest(serialize_manifest(old)).storages == storages);
+
+  uint64_t slot = 0;
+  [[maybe_unused]] bool manifest = is_manifest_path("snapshots/1001/1001", &slot);
+  assert(manifest && slot == 1001);
+  assert(!is_manifest_path("snapshots/1001/1000"));
+  assert(!is_manifest_path("snapshots/status_cache"));
+  assert(!is_manifest_path("snapshots/1001/1001.pre"));
+  assert(!is_manifest_path("accounts/1001.9"));
+
+  std::cout << "  Snapshot manifest: PASS\n";
+}
+
+void test_appendvec_builder() {
+  using namespace limcode::snapshot;
+
+  AppendVecBuilder builder;
+  std::vector<SnapshotAccount> accounts(5);
+  const size_t data_lens[] = {0, 1, 7, 8, AppendVecBuilder::NT_COPY_MIN + 3};
+  size_t expected_size = 0;
+  for (size_t i = 0; i < accounts.size(); ++i) {
+    auto &a = accounts[i];
+    a.write_version = 100 + i;
+    a.lamports = 1000 * i;
+    a.rent_epoch = i;
+    a.executable = i % 2;
+    a.pubkey.fill(static_cast<uint8_t>(i));
+    a.owner.fill(0xA0);
+    a.hash.fill(0xB0);
+    a.data.resize(data_lens[i]);
+    std::iota(a.data.begin(), a.data.end(), static_cast<uint8_t>(i));
+    builder.append(a);
+    expected_size += AppendVecBuilder::record_size(data_lens[i]);
+  }
+  assert(builder.count() == 5 && builder.size() == expected_size);
+  assert(builder.size() % 8 == 0);
+
+  // Records parse back in order, each at an 8-byte aligned offset
+  std::vector<SnapshotAccount> parsed;
+  size_t n = for_each_account_view(builder.data(), builder.size(), [&](const SnapshotAccountView &v) {
+    assert((reinterpret_cast<const uint8_t *>(v.header) - builder.data()) % 8 == 0);
+    parsed.push_back(v.to_owned());
+    return true;
+  });
+  assert(n == 5);
+  for (size_t i = 0; i < n; ++i) {
+    assert(parsed[i].write_version == accounts[i].write_version);
+    assert(parsed[i].lamports == accounts[i].lamports);
+    assert(parsed[i].executable == accounts[i].executable);
+    assert(parsed[i].pubkey == accounts[i].pubkey && parsed[i].hash == accounts[i].hash);
+    assert(parsed[i].data == accounts[i].data);
+  }
+
+  // Views copy straight across, and padding is zeroed
+  AppendVecBuilder copy;
+  for_each_account_view(builder.data(), builder.size(), [&](const SnapshotAccountView &v) {
+    copy.append(v);
+    return true;
+  });
+  assert(copy.size() == builder.size());
+  assert(std::memcmp(copy.data(), builder.data(), builder.size()) == 0);
+  [[maybe_unused]] const size_t second_pad =
+      AppendVecBuilder::record_size(0) + sizeof(AppendVecHeader) + 1;
+  for (size_t k = 0; k < 7; ++k) {
+    assert(builder.data()[second_pad + k] == 0);
+  }
+
+  AppendVecBuilder moved = std::move(copy);
+  assert(moved.count() == 5 && copy.empty());
+  moved.clear();
+  assert(moved.empty() && moved.size() == 0);
+
+  std::cout << "  AppendVec builder: PASS\n";
+}
+
+void test_snapshot_filter() {
+  using namespace limcode::snapshot;
+  using limcode::snapshot::detail::key32_compare;
+
+  // SIMD key compare agrees with memcmp, including a difference in the last byte
+  std::array<uint8_t, 32> a{}, b{};
+  for (int trial = 0; trial < 256; ++trial) {
+    for (size_t i = 0; i < 32; ++i) {
+      a[i] = static_cast<uint8_t>((trial * 31 + i * 7) & 0xFF);
+      b[i] = a[i];
+    }
+    b[trial % 32] ^= static_cast<uint8_t>(trial | 1);
+    [[maybe_unused]] int expected = std::memcmp(a.data(), b.data(), 32);
+    [[maybe_unused]] int got = key32_compare(a.data(), b.data());
+    assert((expected < 0) == (got < 0) && (expected > 0) == (got > 0));
+    assert(key32_compare(a.data(), a.data()) == 0);
+  }
+
+  std::array<uint8_t, 32> token{}, system{};
+  token.fill(0x06);
+  AppendVecBuilder builder;
+  for (int i = 0; i < 1000; ++i) {
+    SnapshotAccount account;
+    account.pubkey[0] = static_cast<uint8_t>(i >> 8);
+    account.pubkey[1] = static_cast<uint8_t>(i);
+    account.owner = i % 10 == 0 ? token : system;
+    account.lamports = static_cast<uint64_t>(i);
+    account.executable = i % 100 == 0;
+    account.data.resize(i % 10 == 0 ? 165 : i % 7);
+    builder.append(account);
+  }
+
+  auto count = [&](const AccountFilter *filter) {
+    size_t visited = 0;
+    size_t n = for_each_matching_view(builder.data(), builder.size(), filter,
+                                      [&]([[maybe_unused]] const SnapshotAccountView &v) {
+      assert(!filter || filter->matches(*v.header));
+      visited++;
+      return true;
+    });
+    assert(n == visited);
+    return n;
+  };
+
+  AccountFilter everything;
+  [[maybe_unused]] size_t all = count(nullptr);
+  [[maybe_unused]] size_t unfiltered = count(&everything);
+  assert(all == 1000 && unfiltered == 1000);
+
+  AccountFilter token_accounts;
+  token_accounts.owners.push_back(token);
+  token_accounts.min_data_len = token_accounts.max_data_len = 165;
+  [[maybe_unused]] size_t tokens = count(&token_accounts);
+  assert(tokens == 100);
+
+  token_accounts.executable = true;
+  token_accounts.min_lamports = 1;
+  [[maybe_unused]] size_t executable = count(&token_accounts);
+  assert(executable == 9);   // 100, 200, ..., 900
+
+  AccountFilter range;
+  range.pubkey_ranges.push_back({});
+  range.pubkey_ranges[0].first[1] = 10;
+  range.pubkey_ranges[0].last[1] = 19;   // Inclusive: pubkeys 10..19
+  std::array<uint8_t, 32> pubkey_700{};
+  pubkey_700[0] = 700 >> 8;
+  pubkey_700[1] = 700 & 0xFF;
+  range.add_pubkey(pubkey_700);
+  [[maybe_unused]] size_t in_range = count(&range);
+  assert(in_range == 11);
+
+  // Stop requests are honoured and the stopping account isn't counted
+  size_t seen = 0;
+  [[maybe_unused]] size_t n =
+      for_each_matching_view(builder.data(), builder.size(), &token_accounts,
+                             [&](const SnapshotAccountView &) { return ++seen < 3; });
+  assert(seen == 3 && n == 2);
+
+  std::cout << "  Snapshot filter: PASS\n";
+}
+
+void test_buffer_arena() {
+  using limcode::snapshot::BufferArena;
+
+  // Classes cover the request with at most 25% slack above the minimum
+  for (size_t size = 1; size < (size_t(1) << 36); size += size / 3 + 1) {
+    [[maybe_unused]] size_t capacity = BufferArena::class_size(size);
+    assert(capacity >= size);
+    assert(size <= BufferArena::MIN_CLASS_SIZE || capacity <= size + size / 4);
+  }
+
+  BufferArena arena(size_t(64) << 20);
+  [[maybe_unused]] uint8_t *first;
+  {
+    auto buffer = arena.acquire(3 << 20);
+    assert(buffer.size() == size_t(3) << 20 && buffer.capacity() >= buffer.size());
+    std::memset(buffer.data(), 0xAB, buffer.size());
+    first = buffer.data();
+  }
+  assert(arena.misses() == 1 && arena.cached_bytes() > 0);
+#ifdef __linux__
+  // Large classes sit on huge-page boundaries
+  assert(reinterpret_cast<uintptr_t>(first) %
+             BufferArena::HUGE_PAGE_CLASS_SIZE ==
+         0);
+#endif
+
+  // A similar size reuses the same buffer, from any thread
+  std::thread([&] {
+    auto again = arena.acquire((3 << 20) - 100);
+    assert(again.data() == first);
+  }).join();
+  assert(arena.hits() == 1);
+
+  // Moves hand over ownership; reset() returns early
+  auto a = arena.acquire(1000);
+  assert(reinterpret_cast<uintptr_t>(a.data()) % 64 == 0);
+  auto b = std::move(a);
+  assert(a.data() == nullptr && b.capacity() == BufferArena::MIN_CLASS_SIZE);
+  b.reset();
+  assert(b.data() == nullptr);
+
+  // Releases beyond max_cached_bytes are freed instead of cached
+  {
+    auto big = arena.acquire(size_t(100) << 20);
+  }
+  assert(arena.cached_bytes() <= size_t(64) << 20);
+  arena.trim();
+  assert(arena.cached_bytes() == 0);
+
+  std::cout << "  Buffer arena: PASS\n";
+}
+
+void test_buffer_pool_size_classes() {
+  using limcode::LockFreeBufferPool;
+
+  limcode::AtomicStats stats;
+  limcode::BufferPoolOptions options;
+  options.huge_pages = true;
+  options.stats = &stats;
+  LockFreeBufferPool pool(options);
+
+  // Power-of-two classes from 256 B up
+  assert(LockFreeBufferPool::class_size_for(1) == 256);
+  assert(LockFreeBufferPool::class_size_for(200) == 256);
+  assert(LockFreeBufferPool::class_size_for(257) == 512);
+  assert(LockFreeBufferPool::class_size_for(3 << 20) == size_t(4) << 20);
+
+  [[maybe_unused]] const std::vector<uint8_t> *vote;
+  {
+    auto buf = pool.acquire(200);
+    assert(buf && buf->empty() && buf->capacity() >= 256 &&
+           buf->capacity() < 512);
+    buf->resize(200, 0x11);
+    vote = buf.get();
+  }
+  // Same class comes back from this thread's magazine, cleared
+  {
+    auto buf = pool.acquire(150);
+    assert(buf.get() == vote && buf->empty());
+  }
+  // A different class never gets it
+  {
+    auto block = pool.acquire(3 << 20);
+    assert(block.get() != vote && block->capacity() >= size_t(4) << 20);
+  }
+
+  // Released on another thread, reused here via the global freelists
+  auto handoff = pool.acquire(64 * 1024);
+  [[maybe_unused]] const auto *handed = handoff.get();
+  std::thread([&] { auto moved = std::move(handoff); }).join();
+  assert(pool.pool_size() == 1);
+  {
+    auto buf = pool.acquire(40 * 1024);
+    assert(buf.get() == handed);
+  }
+
+  // Oversized requests bypass the classes
+  {
+    auto huge = pool.acquire(LockFreeBufferPool::MAX_CLASS_SIZE + 1);
+    assert(huge->capacity() > LockFreeBufferPool::MAX_CLASS_SIZE);
+  }
+
+  pool.flush_thread_cache();
+  assert(stats.pool_hits() == 2);
+  assert(stats.pool_misses() == 4);
+  assert(pool.pool_size() >= 3 && pool.cached_bytes() > 0);
+
+  // take() detaches the buffer from the pool
+  auto taken = pool.acquire(100).take();
+  assert(taken.capacity() >= 256);
+
+  std::cout << "  Buffer pool size classes: PASS\n";
+}
+
+// Encode then decode inside one coroutine; each step hops onto the scheduler
+static limcode::Task<std::vector<Entry>>
+encode_decode_entries(const std::vector<Entry> &entries) {
+  auto bytes = co_await limcode::async_serialize_entries(entries);
+  co_return co_await limcode::async_deserialize_entries(*bytes);
+}
+
+void test_async_serialization() {
+  auto entries = make_test_entries(12);
+  auto expected = limcode::serialize_entries(entries);
+
+  auto bytes = limcode::sync_wait(limcode::async_serialize_entries(entries));
+  assert(*bytes == expected);
+
+  auto decoded = limcode::sync_wait(encode_decode_entries(entries));
+  assert(limcode::serialize_entries(decoded) == expected);
+
+  // Transactions
+  const auto &tx = entries[2].transactions[0];
+  auto tx_bytes =
+      limcode::sync_wait(limcode::async_serialize_transaction(tx));
+  assert(*tx_bytes == limcode::serialize_transaction(tx));
+  auto tx_back =
+      limcode::sync_wait(limcode::async_deserialize_transaction(*tx_bytes));
+  assert(limcode::serialize_transaction(tx_back) == *tx_bytes);
+
+  // POD arrays, all batches in flight at once on a private scheduler
+  limcode::InlineExecutor inline_executor;
+  limcode::AsyncScheduler scheduler(&inline_executor);
+  std::vector<std::vector<uint64_t>> batches(16);
+  std::vector<limcode::Task<limcode::LockFreeBufferPool::PooledBuffer>> tasks;
+  for (size_t b = 0; b < batches.size(); ++b) {
+    batches[b].resize(100 + b);
+    std::iota(batches[b].begin(), batches[b].end(), b * 1000);
+    tasks.push_back(limcode::async_serialize_pod(batches[b].data(),
+                                                 batches[b].size(), scheduler));
+  }
+  auto buffers = limcode::sync_wait(limcode::when_all(std::move(tasks)));
+  assert(buffers.size() == batches.size());
+  for (size_t b = 0; b < batches.size(); ++b) {
+    auto back = limcode::sync_wait(
+        limcode::async_deserialize_pod<uint64_t>(*buffers[b], scheduler));
+    assert(back == batches[b]);
+  }
+  [[maybe_unused]] auto none = limcode::sync_wait(
+      limcode::when_all(std::vector<limcode::Task<std::vector<Entry>>>()));
+  assert(none.empty());
+
+  // Errors surface at the awaiter
+  std::vector<uint8_t> truncated(buffers[0]->begin(), buffers[0]->begin() + 20);
+  [[maybe_unused]] bool threw = false;
+  try {
+    (void)limcode::sync_wait(
+        limcode::async_deserialize_pod<uint64_t>(truncated, scheduler));
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw);
+
+  std::cout << "  Async serialization: PASS\n";
+}
+
+struct TestShredMeta {
+  uint64_t slot;
+  uint32_t index;
+  uint16_t version;
+  uint16_t fec_set;
+  bool is_data;
+};
+LIMCODE_SCHEMA(TestShredMeta, slot, index, version, fec_set, is_data);
+
+struct TestAccountRecord {
+  uint64_t lamports = 0;
+  Pubkey owner{};
+  std::vector<uint8_t> data;
+  std::optional<Pubkey> delegate;
+  std::variant<uint64_t, std::string> memo;
+  std::vector<TestShredMeta> shreds;
+  std::tuple<uint8_t, int32_t> tail{};
+};
+LIMCODE_SCHEMA(TestAccountRecord, lamports, owner, data, delegate, memo,
+               shreds, tail);
+
+void test_schema_serialization() {
+  TestAccountRecord rec;
+  rec.lamports = 1'000'000;
+  rec.owner.fill(0x42);
+  rec.data = {1, 2, 3, 4, 5};
+  rec.delegate.emplace().fill(0x07);
+  rec.memo = std::string("hello");
+  rec.shreds = {{10, 1, 2, 3, true}, {11, 4, 5, 6, false}};
+  rec.tail = {9, -2};
+
+  // Same bytes as bincode's derive: fixed ints, u64 lengths, u8/u32 tags
+  LimcodeEncoder expected_enc(256);
+  expected_enc.write_u64(rec.lamports);
+  expected_enc.write_bytes(rec.owner.data(), 32);
+  expected_enc.write_u64(5);
+  expected_enc.write_bytes(rec.data.data(), 5);
+  expected_enc.write_u8(1);
+  expected_enc.write_bytes(rec.delegate->data(), 32);
+  expected_enc.write_u32(1);
+  expected_enc.write_u64(5);
+  expected_enc.write_bytes(reinterpret_cast<const uint8_t *>("hello"), 5);
+  expected_enc.write_u64(2);
+  for (const auto &s : rec.shreds) {
+    expected_enc.write_u64(s.slot);
+    expected_enc.write_u32(s.index);
+    expected_enc.write_u16(s.version);
+    expected_enc.write_u16(s.fec_set);
+    expected_enc.write_bool(s.is_data);
+  }
+  expected_enc.write_u8(9);
+  expected_enc.write_i32(-2);
+  auto expected = std::move(expected_enc).finish();
+
+  auto bytes = limcode::serialize(rec);
+  assert(bytes == expected);
+  assert(limcode::serialized_size(rec) == bytes.size());
+  static_assert(Codec<TestShredMeta>::is_fixed &&
+                Codec<TestShredMeta>::min_size == 17);
+
+  auto back = limcode::deserialize<TestAccountRecord>(bytes);
+  assert(back.lamports == rec.lamports && back.owner == rec.owner);
+  assert(back.data == rec.data && back.delegate == rec.delegate);
+  assert(std::get<std::string>(back.memo) == "hello");
+  assert(back.shreds.size() == 2 && back.shreds[1].fec_set == 6 &&
+         back.shreds[0].is_data && !back.shreds[1].is_data);
+  assert(back.tail == rec.tail);
+
+  // Caller memory, exact fit or overflow
+  std::vector<uint8_t> out(bytes.size());
+  [[maybe_unused]] size_t written = limcode::serialize_into(rec, out);
+  assert(written == bytes.size() && out == bytes);
+  [[maybe_unused]] bool threw = false;
+  try {
+    (void)limcode::serialize_into(rec, std::span<uint8_t>(out).first(10));
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw);
+
+  // Built-in types nest with their own encoders
+  auto entries = make_test_entries(5);
+  assert(limcode::serialize(entries) == limcode::serialize_entries(entries));
+
+  // Malformed input is rejected
+  [[maybe_unused]] auto rejects = [](std::vector<uint8_t> input) {
+    try {
+      (void)limcode::deserialize<TestAccountRecord>(input);
+    } catch (const LimcodeError &) {
+      return true;
+    }
+    return false;
+  };
+  const size_t option_tag = 8 + 32 + 8 + 5;
+  const size_t variant_index = option_tag + 1 + 32;
+  const size_t first_bool = variant_index + 4 + 8 + 5 + 8 + 16;
+  auto bad = bytes;
+  bad[option_tag] = 2;
+  assert(rejects(bad));
+  bad = bytes;
+  bad[variant_index] = 7;
+  assert(rejects(bad));
+  bad = bytes;
+  bad[first_bool] = 2;
+  assert(rejects(bad));
+  bad = bytes;
+  bad.push_back(0);
+  assert(rejects(bad));
+  bad = bytes;
+  bad.resize(bytes.size() - 1);
+  assert(rejects(bad));
+
+  std::cout << "  Schema serialization: PASS\n";
+}
+
+void test_fused_digest() {
+  // Reference vectors
+  [[maybe_unused]] const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  assert(Crc32c::compute(check) == 0xE3069283);
+  const uint8_t abc[] = {'a', 'b', 'c'};
+  [[maybe_unused]] auto abc_hash = Sha256::compute(abc);
+  assert(abc_hash[0] == 0xBA && abc_hash[1] == 0x78 && abc_hash[31] == 0xAD);
+
+  // SHA-NI and scalar kernels agree; chunked updates match one-shot
+  std::vector<uint8_t> data(4096 + 37);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 131 + 7);
+  }
+  uint32_t a[8], b[8];
+  std::memcpy(a, limcode::digest_detail::SHA256_INIT, sizeof(a));
+  std::memcpy(b, a, sizeof(b));
+  limcode::digest_detail::sha256_blocks_scalar(a, data.data(), data.size() / 64);
+  limcode::digest_detail::sha256_blocks(b, data.data(), data.size() / 64);
+  assert(std::memcmp(a, b, sizeof(a)) == 0);
+  Sha256 chunked;
+  for (size_t pos = 0; pos < data.size(); pos += 61) {
+    chunked.update(std::span<const uint8_t>(data).subspan(
+        pos, std::min<size_t>(61, data.size() - pos)));
+  }
+  [[maybe_unused]] Sha256::Digest chunked_digest = chunked.finish();
+  assert(chunked_digest == Sha256::compute(data));
+  assert(limcode::digest_detail::crc32c_scalar(~0u, data.data(), data.size()) ==
+         ~Crc32c::compute(data));
+
+  // Fused encode digest equals digesting the finished buffer
+  auto entries = make_test_entries(20);
+  Crc32c crc;
+  Sha256 sha;
+  auto bytes = limcode::serialize_entries_with_digest(entries, crc);
+  assert(bytes == limcode::serialize_entries(entries));
+  assert(crc.value() == Crc32c::compute(bytes));
+  std::vector<uint8_t> out(bytes.size());
+  [[maybe_unused]] size_t written =
+      limcode::serialize_entries_into(entries, out, sha);
+  [[maybe_unused]] Sha256::Digest encode_digest = sha.finish();
+  assert(written == bytes.size() && out == bytes);
+  assert(encode_digest == Sha256::compute(bytes));
+
+  // Fused scan digest, plus per-message hashes in the sigverify batch
+  SigverifyBatch batch;
+  batch.hash_messages = true;
+  Crc32c scan_crc;
+  [[maybe_unused]] size_t extracted =
+      limcode::extract_sigverify_batch(bytes, batch, scan_crc);
+  assert(extracted == entries.size());
+  assert(scan_crc.value() == crc.value());
+  assert(batch.message_hashes.size() == batch.num_transactions());
+  for (size_t i = 0; i < batch.num_transactions(); ++i) {
+    assert(batch.message_hashes[i] == Sha256::compute(batch.message(i)));
+  }
+  batch.clear();
+  assert(batch.hash_messages && batch.message_hashes.empty());
+
+  std::vector<Entry> none;
+  Crc32c empty_crc;
+  auto empty = limcode::serialize_entries(none);
+  extracted = limcode::extract_sigverify_batch(empty, batch, empty_crc);
+  assert(extracted == 0);
+  assert(empty_crc.value() == Crc32c::compute(empty));
+
+  std::cout << "  Fused digest: PASS\n";
+}
+
+void test_entry_ledger() {
+  namespace fs = std::filesystem;
+  auto dir = (fs::temp_directory_path() /
+              ("limcode_ledger_" + std::to_string(::getpid())))
+                 .string();
+  fs::remove_all(dir);
+
+  std::vector<std::vector<Entry>> slots;
+  for (size_t s = 0; s < 12; ++s) {
+    slots.push_back(make_test_entries(3 + s));
+  }
+
+  // Small segments force rollover; sync_bytes groups several slots per commit
+  LedgerOptions options;
+  options.segment_size = 16 * 1024;
+  options.sync_bytes = 8 * 1024;
+  options.sync = false;
+  {
+    LedgerWriter writer(options);
+    [[maybe_unused]] bool ok = writer.open(dir);
+    assert(ok);
+    for (size_t s = 0; s < 8; ++s) {
+      ok = writer.append(100 + s, slots[s]);
+      assert(ok);
+    }
+    ok = writer.append(103, slots[0]);
+    assert(!ok && "duplicate slot");
+    ok = writer.commit();
+    assert(ok && writer.pending_bytes() == 0);
+    assert(writer.segment() > 0);
+  }
+
+  // Reopen: append more, then simulate a crash mid-commit
+  {
+    LedgerWriter writer(options);
+    [[maybe_unused]] bool ok = writer.open(dir);
+    assert(ok && writer.num_slots() == 8);
+    ok = writer.append(107, slots[0]);
+    assert(writer.contains(107) && !ok);
+    for (size_t s = 8; s < 12; ++s) {
+      ok = writer.append(200 - s, slots[s]); // out of order
+      assert(ok);
+    }
+    ok = writer.close();
+    assert(ok);
+  }
+  uint32_t last_segment = 0;
+  {
+    LedgerReader reader;
+    [[maybe_unused]] bool ok = reader.open(dir);
+    assert(ok);
+    last_segment = static_cast<uint32_t>(reader.num_segments() - 1);
+  }
+  std::ofstream(dir + "/ledger.idx", std::ios::binary | std::ios::app)
+      .write("torn", 4);
+  char segment_name[32];
+  std::snprintf(segment_name, sizeof(segment_name), "/segment-%06u.dat",
+                last_segment);
+  std::ofstream(dir + segment_name, std::ios::binary | std::ios::app)
+      .write("uncommitted", 11);
+  {
+    LedgerWriter writer(options);
+    [[maybe_unused]] bool ok = writer.open(dir);
+    assert(ok && writer.num_slots() == 12);
+    assert(fs::file_size(dir + "/ledger.idx") ==
+           LEDGER_INDEX_HEADER_SIZE + 12 * sizeof(LedgerSlot));
+  }
+
+  LedgerReader reader;
+  [[maybe_unused]] bool ok = reader.open(dir);
+  assert(ok);
+  assert(reader.num_slots() == 12 && reader.num_segments() > 1);
+  for (size_t i = 1; i < reader.slots().size(); ++i) {
+    assert(reader.slots()[i - 1].slot < reader.slots()[i].slot);
+  }
+  std::vector<EntryView> views;
+  for (size_t s = 0; s < 12; ++s) {
+    uint64_t slot = s < 8 ? 100 + s : 200 - s;
+    assert(reader.verify(slot));
+    assert(std::ranges::equal(reader.slot_bytes(slot),
+                              limcode::serialize_entries(slots[s])));
+    ok = reader.entries_into(slot, views);
+    assert(ok && views.size() == slots[s].size());
+    for (size_t e = 0; e < views.size(); ++e) {
+      assert(views[e].num_hashes == slots[s][e].num_hashes);
+      assert(views[e].num_transactions() == slots[s][e].transactions.size());
+    }
+    assert(limcode::serialize_entries(reader.read_entries(slot)) ==
+           limcode::serialize_entries(slots[s]));
+  }
+  assert(!reader.contains(150) && reader.entries(150).empty());
+  assert(reader.slot_bytes(150).empty() && !reader.verify(150));
+
+  fs::remove_all(dir);
+  std::cout << "  Entry ledger: PASS\n";
+}
+
+void test_interned_batch() {
+  auto entries = make_test_entries(30);
+  auto bytes = limcode::serialize_entries(entries);
+
+  InternedBatch batch;
+  [[maybe_unused]] size_t decoded = decode_entries_interned(bytes, batch);
+  assert(decoded == entries.size());
+  assert(batch.to_entries() == entries);
+
+  // One key per transacting entry, plus two blockhashes and one ALT
+  size_t key_refs = 0;
+  for (const auto &e : entries) {
+    for (const auto &tx : e.transactions) {
+      key_refs += std::visit(
+          [](const auto &msg) { return msg.account_keys.size(); },
+          tx.message.inner);
+    }
+  }
+  assert(batch.message_keys.size() == key_refs);
+  assert(batch.keys.size() == 20 + 3);
+
+  Hash blockhash;
+  blockhash.fill(0xEE);
+  [[maybe_unused]] KeyIndex legacy_hash = batch.keys.find(blockhash);
+  assert(legacy_hash != KeyTable::NOT_FOUND);
+  blockhash.fill(0x42);
+  assert(batch.keys.find(blockhash) == KeyTable::NOT_FOUND);
+
+  // Both keys of a message are the same Pubkey, so the same index
+  const InternedEntry &entry = batch.entries[2];
+  auto txs = batch.transactions_of(entry);
+  assert(txs.size() == 2 && !txs[0].is_v0 && txs[1].is_v0);
+  auto keys = batch.account_keys(txs[1]);
+  assert(keys.size() == 2 && keys[0] == keys[1]);
+  assert(batch.key(keys[0]) == entries[2].transactions[1].message.as_v0()
+                                   .account_keys[0]);
+  assert(txs[0].recent_blockhash == legacy_hash);
+  assert(batch.lookups_of(txs[1]).size() == 1);
+  [[maybe_unused]] auto lookup = batch.lookups_of(txs[1])[0];
+  assert(batch.writable_indexes(lookup).size() == 2);
+  assert(batch.readonly_indexes(lookup)[0] == 5);
+
+  // Header {2, 0, 1}: both signers writable; {2, 1, 0}: second is readonly
+  assert(batch.is_writable(txs[0], 0) && batch.is_writable(txs[0], 1));
+  assert(batch.is_writable(txs[1], 0) && !batch.is_writable(txs[1], 1));
+
+  // Reuse: a smaller block replaces the previous contents
+  std::vector<Entry> single = {entries[2]};
+  single[0].transactions.erase(single[0].transactions.begin());
+  auto single_bytes = limcode::serialize_entries(single);
+  decoded = decode_entries_interned(single_bytes, batch);
+  assert(decoded == 1);
+  assert(batch.transactions.size() == 1 && batch.keys.size() == 3);
+  assert(batch.to_entries() == single);
+
+  // Version byte of the only transaction: count, entry header, sigs
+  size_t version_at = 8 + 8 + HASH_BYTES + 1 + 1 + 2 * SIGNATURE_BYTES;
+  assert(single_bytes[version_at] == VERSION_PREFIX_MASK);
+  single_bytes[version_at] = VERSION_PREFIX_MASK | 1;
+  [[maybe_unused]] bool threw = false;
+  try {
+    decode_entries_interned(single_bytes, batch);
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw && "v1 message should be rejected");
+
+  bytes.resize(bytes.size() - 1);
+  threw = false;
+  try {
+    decode_entries_interned(bytes, batch);
+  } catch (const LimcodeError &) {
+    threw = true;
+  }
+  assert(threw && "truncated block should be rejected");
+
+  std::cout << "  Interned batch: PASS\n";
+}
+
+void test_accounts_lt_hash() {
+  using namespace limcode::snapshot;
+
+  AppendVecBuilder builder;
+  size_t nonzero = 0;
+  for (size_t i = 0; i < 200; ++i) {
+    SnapshotAccount a;
+    a.write_version = i;
+    a.lamports = i % 7 == 0 ? 0 : 1000 + i;
+    a.executable = i % 5 == 0;
+    a.pubkey.fill(static_cast<uint8_t>(i));
+    a.pubkey[31] = static_cast<uint8_t>(i >> 8);
+    a.owner.fill(static_cast<uint8_t>(i % 3));
+    a.data.resize(i % 50);
+    std::iota(a.data.begin(), a.data.end(), static_cast<uint8_t>(i));
+    builder.append(a);
+    nonzero += a.lamports != 0;
+  }
+  std::vector<SnapshotAccountView> views;
+  for_each_account_view(builder.data(), builder.size(), [&](const SnapshotAccountView &v) {
+    views.push_back(v);
+    return true;
+  });
+  assert(views.size() == 200);
+
+  // BLAKE3 reference vectors: input byte i is i % 251; the XOF stream
+  // starts with the hash and crosses chunk (1024) and tree boundaries
+  auto hex = [](std::span<const uint8_t> bytes) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (uint8_t b : bytes) {
+      out += digits[b >> 4];
+      out += digits[b & 15];
+    }
+    return out;
+  };
+  auto blake3_of = [&](size_t len, size_t piece) {
+    std::vector<uint8_t> input(len);
+    for (size_t i = 0; i < len; ++i) {
+      input[i] = static_cast<uint8_t>(i % 251);
+    }
+    Blake3 hasher;
+    for (size_t pos = 0; pos < len; pos += piece) {
+      hasher.update(std::span<const uint8_t>(input).subspan(
+          pos, std::min(piece, len - pos)));
+    }
+    auto digest = hasher.finish();
+    return hex(digest);
+  };
+  const std::pair<size_t, const char *> vectors[] = {
+      {0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"},
+      {1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213"},
+      {1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11"},
+      {1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7"},
+      {1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"},
+      {2048, "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a"},
+      {102400, "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085"}};
+  for (const auto &[len, expected_hex] : vectors) {
+    [[maybe_unused]] std::string one_shot = blake3_of(len, SIZE_MAX);
+    [[maybe_unused]] std::string chunked = blake3_of(len, 61);
+    assert(one_shot == expected_hex && chunked == expected_hex);
+  }
+  std::vector<uint8_t> xof(131);
+  Blake3 empty;
+  empty.finish_xof(xof);
+  [[maybe_unused]] std::string xof_hex = hex(xof);
+  assert(xof_hex.substr(0, 64) == vectors[0].second);
+  assert(xof_hex.substr(64, 64) == "e00f03e7b69af26b7faaf09fcd333050"
+                                   "338ddfe085b8cc869ca98b206c08243a");
+  assert(xof_hex.substr(256) == "cce14d");
+
+  // Lanes are the BLAKE3 output stream over agave's field order, whose
+  // first 32 bytes are the plain hash
+  const SnapshotAccountView &v = views[1];
+  uint64_t lamports = v.lamports();
+  uint8_t executable = v.executable();
+  Blake3 hasher;
+  hasher.update({reinterpret_cast<const uint8_t *>(&lamports), 8});
+  hasher.update(v.data);
+  hasher.update({&executable, 1});
+  hasher.update(v.owner());
+  hasher.update(v.pubkey());
+  LtHash expected;
+  auto *lane_bytes = reinterpret_cast<uint8_t *>(expected.lanes.data());
+  hasher.finish_xof({lane_bytes, LtHash::NUM_BYTES});
+  assert(account_lt_hash(v) == expected);
+  [[maybe_unused]] Blake3::Digest prefix;
+  std::memcpy(prefix.data(), lane_bytes, prefix.size());
+  hasher.update({reinterpret_cast<const uint8_t *>(&lamports), 8});
+  hasher.update(v.data);
+  hasher.update({&executable, 1});
+  hasher.update(v.owner());
+  hasher.update(v.pubkey());
+  [[maybe_unused]] Blake3::Digest digest = hasher.finish();
+  assert(digest == prefix);
+
+  // The dispatched multi-block kernel matches one compression per block
+  uint32_t cv[8];
+  uint32_t block[16] = {};
+  std::memcpy(cv, limcode::digest_detail::BLAKE3_IV, sizeof(cv));
+  for (size_t blocks = 0; blocks <= 40; blocks += 1 + blocks / 4) {
+    std::vector<uint8_t> wide(blocks * 64);
+    limcode::digest_detail::blake3_root_blocks(cv, block, 0, 11, 3, blocks,
+                                               wide.data());
+    for (size_t b = 0; b < blocks; ++b) {
+      [[maybe_unused]] uint32_t words[16];
+      limcode::digest_detail::blake3_compress(cv, block, 3 + b, 0, 11, words);
+      assert(std::memcmp(wide.data() + b * 64, words, 64) == 0);
+    }
+  }
+  assert(account_lt_hash(views[0]).is_identity());
+  assert(expected.checksum() == Blake3::compute({lane_bytes, LtHash::NUM_BYTES}));
+
+  AccountsHasher sequential;
+  {
+    AccountsHasher::Partial partial(&sequential);
+    for (const auto &view : views) {
+      partial.add(view);
+    }
+  }
+  assert(sequential.accounts() == nonzero);
+
+  // Any split across threads, in any order, sums to the same hash
+  AccountsHasher threaded;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      AccountsHasher::Partial partial(&threaded);
+      for (size_t i = views.size() - 1 - t; i < views.size(); i -= 4) {
+        partial.add(views[i]);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  assert(threaded.value() == sequential.value());
+  assert(threaded.checksum() == sequential.checksum());
+  assert(threaded.accounts() == nonzero);
+
+  // Incremental update: removing and re-adding an account round-trips
+  LtHash sum = sequential.value();
+  sum.mix_out(account_lt_hash(views[43]));
+  assert(!(sum == sequential.value()));
+  sum.mix_in(account_lt_hash(views[43]));
+  assert(sum == sequential.value());
+
+  // Any change to an account's data changes the checksum
+  std::vector<uint8_t> copy(builder.data(), builder.data() + builder.size());
+  const uint8_t *first_data = views[1].data.data();
+  copy[first_data - builder.data()] ^= 1;
+  AccountsHasher changed;
+  {
+    AccountsHasher::Partial partial(&changed);
+    for_each_account_view(copy.data(), copy.size(), [&](const SnapshotAccountView &view) {
+      partial.add(view);
+      return true;
+    });
+  }
+  assert(changed.checksum() != sequential.checksum());
+
+  AccountsHasher::Partial detached(nullptr);
+  detached.add(views[1]); // No hasher: no-op
+  sequential.reset();
+  assert(sequential.value().is_identity() && sequential.accounts() == 0);
+
+  std::cout << "  Accounts lattice hash: PASS\n";
+}
+
 int main() {
   std::cout << "\n";
   std::cout
@@ -171,6 +2428,34 @@ int main() {
   test_batch_serialization();
   test_v0_message();
   test_round_trip();
+  test_streaming_decoder();
+  test_arena_decode();
+  test_sigverify_batch();
+  test_parallel_deserialize();
+  test_executor();
+  test_simd_dispatch();
+  test_gossip_contact_info();
+  test_crds_data_variants();
+  test_crds_packet_batcher();
+  test_encode_into_caller_memory();
+  test_single_pass_encoder();
+  test_encoder_policies();
+  test_varint_batch_decode();
+  test_validate_wire_bytes();
+  test_indexed_entry_view();
+  test_metrics();
+  test_prefetch_reader();
+  test_snapshot_manifest();
+  test_appendvec_builder();
+  test_snapshot_filter();
+  test_buffer_arena();
+  test_buffer_pool_size_classes();
+  test_async_serialization();
+  test_schema_serialization();
+  test_fused_digest();
+  test_entry_ledger();
+  test_interned_batch();
+  test_accounts_lt_hash();
 
   std::cout << "\nAll tests passed!\n";
   std::cout
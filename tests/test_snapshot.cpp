@@ -0,0 +1,844 @@
+/**
+ * @file test_snapshot.cpp
+ * @brief Tests for the snapshot pipeline (include/limcode/snapshot*.h)
+ *
+ * Separate binary: it links limcode_snapshot, which needs libarchive and
+ * libzstd. Archives are built with SnapshotWriter in the temp directory.
+ */
+
+#include <limcode/snapshot.h>
+#include <limcode/snapshot_arena.h>
+#include <limcode/snapshot_columns.h>
+#include <limcode/snapshot_filter.h>
+#include <limcode/snapshot_hash.h>
+#include <limcode/snapshot_index.h>
+#include <limcode/snapshot_manifest.h>
+#include <limcode/snapshot_writer.h>
+#include <limcode_ffi.h>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+using limcode::snapshot::ParallelStreamOptions;
+using limcode::snapshot::SnapshotAccount;
+using limcode::snapshot::SnapshotAccountView;
+using limcode::snapshot::SnapshotManifest;
+using limcode::snapshot::SnapshotWriter;
+using limcode::snapshot::SnapshotWriterOptions;
+
+static std::string temp_path(const std::string &name) {
+  return (fs::temp_directory_path() /
+          ("limcode_" + name + "_" + std::to_string(::getpid())))
+      .string();
+}
+
+// `count` accounts over a few owners, with data lengths from 0 to 300 bytes
+// (unaligned ones included) and pubkeys unique from `first` on
+static std::vector<SnapshotAccount> make_accounts(size_t count,
+                                                  size_t first = 0) {
+  std::vector<SnapshotAccount> accounts(count);
+  for (size_t i = 0; i < count; ++i) {
+    size_t key = first + i;
+    auto &account = accounts[i];
+    account.write_version = key + 1;
+    account.pubkey[0] = static_cast<uint8_t>(key);
+    account.pubkey[1] = static_cast<uint8_t>(key >> 8);
+    account.pubkey[31] = 0xA5;
+    account.owner.fill(static_cast<uint8_t>(0x10 + key % 3));
+    account.lamports = key * 1000 + 1;
+    account.rent_epoch = key % 7;
+    account.executable = key % 5 == 0;
+    account.data.assign((key * 37) % 301, static_cast<uint8_t>(key));
+  }
+  return accounts;
+}
+
+static uint64_t total_lamports(const std::vector<SnapshotAccount> &accounts) {
+  uint64_t total = 0;
+  for (const auto &account : accounts) {
+    total += account.lamports;
+  }
+  return total;
+}
+
+// Ten accounts per slot from `first_slot` on; small AppendVecs so every
+// slot rolls over into several storages
+static bool write_archive(const std::string &path,
+                          const std::vector<SnapshotAccount> &accounts,
+                          uint64_t first_slot = 100) {
+  SnapshotWriterOptions options;
+  options.appendvec_size = 2 * 1024;
+  options.num_threads = 2;
+  SnapshotWriter writer(path, options);
+  for (size_t i = 0; i < accounts.size(); ++i) {
+    if (!writer.add(first_slot + i / 10, accounts[i])) return false;
+  }
+  SnapshotManifest manifest;
+  manifest.slot = first_slot + accounts.size() / 10;
+  manifest.parent_slot = manifest.slot - 1;
+  manifest.capitalization = total_lamports(accounts);
+  return writer.finish(std::move(manifest)) &&
+         writer.accounts_written() == accounts.size();
+}
+
+// Thread-safe per-pubkey tally of the accounts a stream delivered
+struct Collector {
+  std::mutex mutex;
+  std::map<std::array<uint8_t, 32>, SnapshotAccount> accounts;
+  size_t delivered = 0;
+
+  bool add(std::span<const SnapshotAccountView> batch) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &view : batch) {
+      auto account = view.to_owned();
+      accounts[account.pubkey] = std::move(account);
+    }
+    delivered += batch.size();
+    return true;
+  }
+
+  bool matches(const std::vector<SnapshotAccount> &expected) const {
+    if (accounts.size() != expected.size()) return false;
+    for (const auto &account : expected) {
+      auto it = accounts.find(account.pubkey);
+      if (it == accounts.end() || it->second.lamports != account.lamports ||
+          it->second.write_version != account.write_version ||
+          it->second.rent_epoch != account.rent_epoch ||
+          it->second.owner != account.owner ||
+          it->second.executable != account.executable ||
+          it->second.data != account.data) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void test_parallel_batches() {
+  auto path = temp_path("parallel") + ".tar.zst";
+  auto accounts = make_accounts(250);
+  [[maybe_unused]] bool written = write_archive(path, accounts);
+  assert(written);
+
+  for (unsigned threads : {1u, 4u}) {
+    ParallelStreamOptions options;
+    options.num_threads = threads;
+    options.batch_size = 16;
+    // Smaller than the archive: the decompressor has to wait for workers
+    options.max_inflight_bytes = 8 * 1024;
+    Collector collector;
+    std::atomic<uint64_t> lamports{0};
+    std::atomic<size_t> oversized{0};
+    [[maybe_unused]] int64_t streamed =
+        limcode::snapshot::stream_snapshot_parallel_batches(
+            path,
+            [&](std::span<const SnapshotAccountView> batch) {
+              if (batch.size() > options.batch_size) oversized++;
+              for (const auto &view : batch) {
+                lamports += view.lamports();
+              }
+              return collector.add(batch);
+            },
+            options);
+    assert(streamed == static_cast<int64_t>(accounts.size()));
+    assert(collector.delivered == accounts.size());
+    assert(collector.matches(accounts));
+    assert(lamports == total_lamports(accounts));
+    assert(oversized == 0);
+  }
+
+  fs::remove(path);
+  std::cout << "  Parallel batches: PASS\n";
+}
+
+void test_parallel_early_stop() {
+  auto path = temp_path("early_stop") + ".tar.zst";
+  auto accounts = make_accounts(250);
+  [[maybe_unused]] bool written = write_archive(path, accounts);
+  assert(written);
+
+  for (unsigned threads : {1u, 4u}) {
+    ParallelStreamOptions options;
+    options.num_threads = threads;
+    options.batch_size = 8;
+    std::atomic<size_t> calls{0};
+    [[maybe_unused]] int64_t streamed =
+        limcode::snapshot::stream_snapshot_parallel_batches(
+            path,
+            [&](std::span<const SnapshotAccountView>) {
+              return ++calls < 3;
+            },
+            options);
+    // The stopping batch is not counted; batches already in flight on
+    // other threads may still be delivered
+    assert(streamed >= 0 && streamed < static_cast<int64_t>(accounts.size()));
+    assert(calls >= 3 && calls < accounts.size() / options.batch_size);
+  }
+
+  fs::remove(path);
+  std::cout << "  Parallel early stop: PASS\n";
+}
+
+void test_missing_archive() {
+  auto path = temp_path("missing") + ".tar.zst";
+  fs::remove(path);
+  std::atomic<size_t> calls{0};
+  auto count = [&](std::span<const SnapshotAccountView>) {
+    calls++;
+    return true;
+  };
+  ParallelStreamOptions options;
+  options.num_threads = 2;
+  [[maybe_unused]] int64_t streamed =
+      limcode::snapshot::stream_snapshot_parallel_batches(path, count,
+                                                          options);
+  assert(streamed == -1);
+  assert(calls == 0);
+
+  std::cout << "  Missing archive: PASS\n";
+}
+
+void test_inflight_budget() {
+  auto path = temp_path("budget") + ".tar.zst";
+  auto accounts = make_accounts(150);
+  [[maybe_unused]] bool written = write_archive(path, accounts);
+  assert(written);
+
+  // A budget below one AppendVec admits one at a time, so the arena never
+  // hands out a second buffer, even to a decompressor running ahead
+  limcode::snapshot::BufferArena arena;
+  ParallelStreamOptions options;
+  options.num_threads = 4;
+  options.max_inflight_bytes = 1;
+  options.arena = &arena;
+  Collector collector;
+  [[maybe_unused]] int64_t streamed =
+      limcode::snapshot::stream_snapshot_parallel_batches(
+          path,
+          [&](std::span<const SnapshotAccountView> batch) {
+            return collector.add(batch);
+          },
+          options);
+  assert(streamed == static_cast<int64_t>(accounts.size()));
+  assert(collector.matches(accounts));
+  assert(arena.misses() == 1 && arena.hits() > 10);
+  assert(arena.cached_bytes() == limcode::snapshot::BufferArena::MIN_CLASS_SIZE);
+
+  fs::remove(path);
+  std::cout << "  Inflight budget: PASS\n";
+}
+
+void test_writer_round_trip() {
+  auto path = temp_path("writer") + ".tar.zst";
+  auto accounts = make_accounts(120);
+  SnapshotWriterOptions writer_options;
+  writer_options.appendvec_size = 2 * 1024;
+  writer_options.max_open_slots = 2;   // Stages slots while others are open
+  SnapshotWriter writer(path, writer_options);
+  for (size_t i = 0; i < accounts.size(); ++i) {
+    [[maybe_unused]] bool added = writer.add(100 + i / 10, accounts[i]);
+    assert(added);
+  }
+  SnapshotManifest manifest;
+  manifest.slot = 112;
+  manifest.parent_slot = 111;
+  manifest.epoch = 3;
+  manifest.capitalization = total_lamports(accounts);
+  manifest.ancestors = {111, 112};
+  manifest.bank_hash.fill(0xB4);
+  [[maybe_unused]] bool finished = writer.finish(manifest);
+  assert(finished);
+  assert(writer.accounts_written() == accounts.size());
+  assert(writer.appendvecs_written() > 12);
+
+  // Sequential libarchive reader
+  std::vector<SnapshotAccount> sequential;
+  [[maybe_unused]] int64_t read = limcode::snapshot::stream_snapshot(
+      path, [&](const SnapshotAccount &account) {
+        sequential.push_back(account);
+        return true;
+      });
+  assert(read == static_cast<int64_t>(accounts.size()));
+  Collector from_archive;
+  for (const auto &account : sequential) {
+    from_archive.accounts[account.pubkey] = account;
+  }
+  assert(from_archive.matches(accounts));
+
+  // Parallel reader, which also decodes the manifest the writer filled in
+  SnapshotManifest parsed;
+  ParallelStreamOptions options;
+  options.num_threads = 3;
+  options.manifest = &parsed;
+  Collector collector;
+  [[maybe_unused]] int64_t streamed =
+      limcode::snapshot::stream_snapshot_parallel_batches(
+          path,
+          [&](std::span<const SnapshotAccountView> batch) {
+            return collector.add(batch);
+          },
+          options);
+  assert(streamed == static_cast<int64_t>(accounts.size()));
+  assert(collector.matches(accounts));
+
+  assert(parsed.slot == 112 && parsed.parent_slot == 111 && parsed.epoch == 3);
+  assert(parsed.capitalization == total_lamports(accounts));
+  assert(parsed.ancestors == manifest.ancestors);
+  assert(parsed.bank_hash == manifest.bank_hash);
+  assert(parsed.accounts_slot == 112);
+  assert(parsed.write_version == accounts.size());
+  assert(parsed.storages.size() == writer.appendvecs_written());
+  assert(std::is_sorted(parsed.storages.begin(), parsed.storages.end(),
+                        [](const auto &a, const auto &b) {
+                          return a.slot != b.slot ? a.slot < b.slot
+                                                  : a.id < b.id;
+                        }));
+  uint64_t stored = 0;
+  for (const auto &account : accounts) {
+    stored += (sizeof(limcode::snapshot::AppendVecHeader) +
+               account.data.size() + 7) & ~uint64_t(7);
+  }
+  assert(parsed.total_storage_bytes() == stored);
+
+  // serialize_manifest() writes back what deserialize_manifest() reads
+  auto bytes = limcode::snapshot::serialize_manifest(parsed);
+  auto decoded = limcode::snapshot::deserialize_manifest(bytes);
+  assert(decoded.slot == parsed.slot && decoded.epoch == parsed.epoch);
+  assert(decoded.capitalization == parsed.capitalization);
+  assert(decoded.ancestors == parsed.ancestors);
+  assert(decoded.bank_hash == parsed.bank_hash);
+  assert(decoded.storages == parsed.storages);
+  assert(decoded.write_version == parsed.write_version);
+  assert(decoded.accounts_slot == parsed.accounts_slot);
+  assert(limcode::snapshot::serialize_manifest(decoded) == bytes);
+
+  fs::remove(path);
+  std::cout << "  Writer round trip: PASS\n";
+}
+
+// C callback state; written from several parser threads
+struct CStreamSink {
+  std::atomic<size_t> batches{0};
+  std::atomic<size_t> accounts{0};   // Accepted batches only
+  std::atomic<uint64_t> lamports{0};
+  size_t stop_after = SIZE_MAX;      // Batches before returning 0
+};
+
+static int c_collect_batch(void *user_data, const LimcodeAccountView *views,
+                           size_t count) {
+  auto *sink = static_cast<CStreamSink *>(user_data);
+  if (++sink->batches >= sink->stop_after) return 0;
+  for (size_t i = 0; i < count; ++i) {
+    sink->lamports += views[i].lamports;
+  }
+  sink->accounts += count;
+  return 1;
+}
+
+void test_c_stream_cached_merged() {
+  auto full_path = temp_path("c_full") + ".tar.zst";
+  auto incremental_path = temp_path("c_incremental") + ".tar.zst";
+  auto full_cache = temp_path("c_full_cache");
+  auto incremental_cache = temp_path("c_incremental_cache");
+  for (const auto &dir : {full_cache, incremental_cache}) {
+    fs::remove_all(dir);
+  }
+
+  // The incremental archive rewrites pubkeys 50..99 with new lamports,
+  // deletes pubkey 60 and adds 100..129
+  auto full = make_accounts(100);
+  auto incremental = make_accounts(80, 50);
+  for (auto &account : incremental) {
+    account.lamports += 7;
+    account.write_version += 1000;
+  }
+  incremental[10].lamports = 0;
+  [[maybe_unused]] bool written = write_archive(full_path, full) &&
+                                  write_archive(incremental_path, incremental,
+                                                200);
+  assert(written);
+
+  LimcodeSnapshotStreamOptions options;
+  limcode_snapshot_stream_options_init(&options);
+  options.num_threads = 4;
+  options.batch_size = 8;
+
+  // First call unpacks, the second streams the existing cache
+  for (int pass = 0; pass < 2; ++pass) {
+    CStreamSink sink;
+    [[maybe_unused]] int64_t delivered = limcode_snapshot_stream_cached(
+        full_path.c_str(), full_cache.c_str(), &options, c_collect_batch,
+        &sink);
+    assert(delivered == 100 && sink.accounts == 100);
+    assert(sink.lamports == total_lamports(full));
+  }
+  CStreamSink unpacked;
+  [[maybe_unused]] int64_t delivered = limcode_snapshot_stream_unpacked(
+      full_cache.c_str(), &options, c_collect_batch, &unpacked);
+  assert(delivered == 100 && unpacked.lamports == total_lamports(full));
+
+  // Newest version per pubkey, deleted one skipped
+  uint64_t merged_lamports = total_lamports(incremental);
+  for (size_t i = 0; i < 50; ++i) {
+    merged_lamports += full[i].lamports;
+  }
+  CStreamSink merged;
+  delivered = limcode_snapshot_stream_merged(
+      full_path.c_str(), full_cache.c_str(), incremental_path.c_str(),
+      incremental_cache.c_str(), &options, c_collect_batch, &merged);
+  assert(delivered == 129 && merged.accounts == 129);
+  assert(merged.lamports == merged_lamports);
+
+  // Stopping: the rejected batch is not counted
+  options.num_threads = 1;
+  CStreamSink stop_cached;
+  stop_cached.stop_after = 3;
+  delivered = limcode_snapshot_stream_cached(full_path.c_str(),
+                                             full_cache.c_str(), &options,
+                                             c_collect_batch, &stop_cached);
+  assert(delivered == static_cast<int64_t>(stop_cached.accounts.load()));
+  assert(stop_cached.batches == 3 && delivered > 0 && delivered < 100);
+  CStreamSink stop_unpacked;
+  stop_unpacked.stop_after = 3;
+  delivered = limcode_snapshot_stream_unpacked(
+      full_cache.c_str(), &options, c_collect_batch, &stop_unpacked);
+  assert(delivered == static_cast<int64_t>(stop_unpacked.accounts.load()));
+  assert(stop_unpacked.batches == 3 && delivered > 0 && delivered < 100);
+  CStreamSink stop_merged;
+  stop_merged.stop_after = 3;
+  delivered = limcode_snapshot_stream_merged(
+      full_path.c_str(), full_cache.c_str(), incremental_path.c_str(),
+      incremental_cache.c_str(), &options, c_collect_batch, &stop_merged);
+  assert(delivered == 16 && stop_merged.accounts == 16);
+  assert(stop_merged.batches == 3);
+
+  // Bad arguments
+  CStreamSink unused;
+  delivered = limcode_snapshot_stream_cached(full_path.c_str(),
+                                             full_cache.c_str(), &options,
+                                             nullptr, nullptr);
+  assert(delivered == -1);
+  delivered = limcode_snapshot_stream_unpacked(
+      temp_path("c_no_cache").c_str(), nullptr, c_collect_batch, &unused);
+  assert(delivered == -1);
+  delivered = limcode_snapshot_stream_merged(
+      full_path.c_str(), full_cache.c_str(), nullptr,
+      incremental_cache.c_str(), &options, c_collect_batch, &unused);
+  assert(delivered == -1 && unused.batches == 0);
+
+  for (const auto &path : {full_path, incremental_path}) {
+    fs::remove(path);
+  }
+  for (const auto &dir : {full_cache, incremental_cache}) {
+    fs::remove_all(dir);
+  }
+  std::cout << "  C cached / unpacked / merged streams: PASS\n";
+}
+
+void test_column_export() {
+  auto path = temp_path("columns") + ".tar.zst";
+  auto dir = temp_path("columns_dir");
+  auto accounts = make_accounts(200);
+  [[maybe_unused]] bool written = write_archive(path, accounts);
+  assert(written);
+
+  std::map<std::array<uint8_t, 32>, const SnapshotAccount *> by_pubkey;
+  std::map<std::array<uint8_t, 32>, limcode::snapshot::OwnerTotals> owners;
+  uint64_t data_bytes = 0;
+  for (const auto &account : accounts) {
+    by_pubkey[account.pubkey] = &account;
+    auto &totals = owners[account.owner];
+    totals.accounts++;
+    totals.lamports += account.lamports;
+    totals.data_bytes += account.data.size();
+    data_bytes += account.data.size();
+  }
+
+  for (bool include_data : {true, false}) {
+    fs::remove_all(dir);
+    ParallelStreamOptions options;
+    options.num_threads = 4;
+    options.batch_size = 16;
+    [[maybe_unused]] int64_t rows = limcode::snapshot::export_snapshot_columns(
+        path, dir, options, include_data);
+    assert(rows == static_cast<int64_t>(accounts.size()));
+
+    limcode::snapshot::AccountColumns columns;
+    [[maybe_unused]] bool opened = columns.open(dir);
+    assert(opened);
+    assert(columns.size() == accounts.size());
+    assert(columns.has_data() == include_data);
+    assert(columns.total_lamports() == total_lamports(accounts));
+    assert(columns.total_data_len() == data_bytes);
+
+    // Rows come in pipeline order; match them up by pubkey
+    for (size_t i = 0; i < columns.size(); ++i) {
+      auto it = by_pubkey.find(columns.pubkeys()[i]);
+      assert(it != by_pubkey.end());
+      [[maybe_unused]] const SnapshotAccount &account = *it->second;
+      assert(columns.lamports()[i] == account.lamports);
+      assert(columns.owners()[i] == account.owner);
+      assert(columns.data_lens()[i] == account.data.size());
+      assert(columns.write_versions()[i] == account.write_version);
+      assert(columns.rent_epochs()[i] == account.rent_epoch);
+      assert((columns.executable()[i] != 0) == account.executable);
+      [[maybe_unused]] auto data = columns.data(i);
+      if (include_data) {
+        assert(data.size() == account.data.size());
+        assert(std::equal(data.begin(), data.end(), account.data.begin()));
+      } else {
+        assert(data.empty());
+      }
+    }
+
+    [[maybe_unused]] auto totals = columns.totals_by_owner();
+    assert(totals.size() == owners.size());
+    for ([[maybe_unused]] const auto &[owner, owner_totals] : totals) {
+      assert(owner_totals.accounts == owners[owner].accounts);
+      assert(owner_totals.lamports == owners[owner].lamports);
+      assert(owner_totals.data_bytes == owners[owner].data_bytes);
+      assert(columns.lamports_owned_by(owner) == owners[owner].lamports);
+    }
+  }
+
+  fs::remove(path);
+  fs::remove_all(dir);
+  std::cout << "  Column export: PASS\n";
+}
+
+// Lattice element of an owned account, through the same view the scans hash
+static limcode::snapshot::LtHash lt_hash_of(const SnapshotAccount &account) {
+  limcode::snapshot::AppendVecHeader header{};
+  header.write_version = account.write_version;
+  header.data_len = account.data.size();
+  std::memcpy(header.pubkey, account.pubkey.data(), 32);
+  header.lamports = account.lamports;
+  header.rent_epoch = account.rent_epoch;
+  std::memcpy(header.owner, account.owner.data(), 32);
+  header.executable = account.executable ? 1 : 0;
+  return limcode::snapshot::account_lt_hash(
+      SnapshotAccountView{&header, account.data});
+}
+
+void test_merged_accounts_hash() {
+  using limcode::snapshot::AccountsHasher;
+  using limcode::snapshot::LtHash;
+
+  auto full_path = temp_path("hash_full") + ".tar.zst";
+  auto incremental_path = temp_path("hash_incremental") + ".tar.zst";
+  auto full_cache = temp_path("hash_full_cache");
+  auto incremental_cache = temp_path("hash_incremental_cache");
+  for (const auto &dir : {full_cache, incremental_cache}) {
+    fs::remove_all(dir);
+  }
+
+  // Pubkeys 40..79 are rewritten by the incremental archive, 45 deleted
+  auto full = make_accounts(80);
+  auto incremental = make_accounts(60, 40);
+  for (auto &account : incremental) {
+    account.lamports += 3;
+    account.write_version += 1000;
+  }
+  incremental[5].lamports = 0;
+  [[maybe_unused]] bool written = write_archive(full_path, full) &&
+                                  write_archive(incremental_path, incremental,
+                                                200);
+  assert(written);
+
+  // The bank hash: newest version of every pubkey
+  LtHash expected;
+  for (size_t i = 0; i < 40; ++i) {
+    expected.mix_in(lt_hash_of(full[i]));
+  }
+  for (const auto &account : incremental) {
+    expected.mix_in(lt_hash_of(account));
+  }
+  LtHash raw = expected;
+  for (size_t i = 40; i < 80; ++i) {
+    raw.mix_in(lt_hash_of(full[i]));
+  }
+  assert(raw != expected);
+
+  // Filtered or not, the merged scan hashes the same accounts
+  limcode::snapshot::AccountFilter filter;
+  filter.owners = {full[0].owner};
+  for (bool filtered : {false, true}) {
+    AccountsHasher hasher;
+    ParallelStreamOptions options;
+    options.num_threads = 3;
+    options.batch_size = 8;
+    options.accounts_hasher = &hasher;
+    options.filter = filtered ? &filter : nullptr;
+    std::atomic<size_t> delivered{0};
+    [[maybe_unused]] int64_t streamed =
+        limcode::snapshot::stream_merged_snapshot(
+            full_path, full_cache, incremental_path, incremental_cache,
+            [&](std::span<const SnapshotAccountView> batch) {
+              delivered += batch.size();
+              return true;
+            },
+            options);
+    assert(streamed == static_cast<int64_t>(delivered.load()));
+    assert(filtered ? delivered < 99 : delivered == 99);
+    assert(hasher.accounts() == 99);
+    assert(hasher.value() == expected);
+    assert(hasher.checksum() == expected.checksum());
+  }
+
+  // The cache scans digest the raw storages, stale versions included
+  AccountsHasher storages;
+  ParallelStreamOptions options;
+  options.num_threads = 2;
+  options.accounts_hasher = &storages;
+  auto ignore = [](std::span<const SnapshotAccountView>) { return true; };
+  [[maybe_unused]] int64_t full_count =
+      limcode::snapshot::stream_unpacked_snapshot(full_cache, ignore, options);
+  [[maybe_unused]] int64_t incremental_count =
+      limcode::snapshot::stream_unpacked_snapshot(incremental_cache, ignore,
+                                                  options);
+  assert(full_count == 80 && incremental_count == 60);
+  assert(storages.accounts() == 139);
+  assert(storages.value() == raw);
+
+  for (const auto &path : {full_path, incremental_path}) {
+    fs::remove(path);
+  }
+  for (const auto &dir : {full_cache, incremental_cache}) {
+    fs::remove_all(dir);
+  }
+  std::cout << "  Merged accounts hash: PASS\n";
+}
+
+void test_index_concurrent_spills() {
+  using limcode::snapshot::AccountIndexEntry;
+  auto path = temp_path("index") + ".index";
+
+  // Every thread adds every pubkey at its own slot; small runs make the
+  // threads spill while others keep adding
+  constexpr size_t KEYS = 4000;
+  constexpr unsigned THREADS = 4;
+  limcode::snapshot::AccountIndexBuilder builder(path, 500);
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&, t] {
+      std::vector<AccountIndexEntry> chunk;
+      for (size_t k = 0; k < KEYS; ++k) {
+        // Descending keys within runs: spills have to sort
+        size_t key = KEYS - 1 - k;
+        AccountIndexEntry &entry = chunk.emplace_back();
+        std::memset(entry.pubkey, 0, 32);
+        entry.pubkey[0] = static_cast<uint8_t>(key >> 8);
+        entry.pubkey[1] = static_cast<uint8_t>(key);
+        entry.slot = 100 + t;
+        entry.appendvec_id = t;
+        entry.offset = key * 8;
+        entry.write_version = key;
+        if (chunk.size() == 64) {
+          builder.add(chunk);
+          chunk.clear();
+        }
+      }
+      builder.add(chunk);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  [[maybe_unused]] int64_t written = builder.finish();
+  assert(written == static_cast<int64_t>(KEYS));
+
+  limcode::snapshot::AccountIndex index;
+  [[maybe_unused]] bool opened = index.open(path);
+  assert(opened && index.size() == KEYS);
+  for (size_t key = 0; key < KEYS; ++key) {
+    [[maybe_unused]] const AccountIndexEntry &entry = index.entries()[key];
+    assert(entry.pubkey[0] == static_cast<uint8_t>(key >> 8) &&
+           entry.pubkey[1] == static_cast<uint8_t>(key));
+    assert(entry.slot == 100 + THREADS - 1 && entry.offset == key * 8);
+    assert(index.find(entry.pubkey) == &entry);
+  }
+
+  // Run files are gone once the index is written
+  for (size_t run = 0; run < KEYS * THREADS / 500; ++run) {
+    assert(!fs::exists(path + ".run" + std::to_string(run)));
+  }
+  fs::remove(path);
+  std::cout << "  Index concurrent spills: PASS\n";
+}
+
+void test_index_failed_finish() {
+  using limcode::snapshot::AccountIndexEntry;
+  auto path = temp_path("torn") + ".index";
+  fs::remove(path);
+
+  // Cap the file size past the header and fanout (~512 KiB) but short of
+  // the entries: finish() fails midway through the merge
+  std::vector<AccountIndexEntry> entries(20000);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    std::memset(entries[i].pubkey, 0, 32);
+    std::memcpy(entries[i].pubkey, &i, sizeof(i));
+    entries[i].slot = 1;
+    entries[i].offset = i * 8;
+  }
+  limcode::snapshot::AccountIndexBuilder builder(path);
+  builder.add(entries);
+
+  rlimit saved;
+  getrlimit(RLIMIT_FSIZE, &saved);
+  rlimit capped = saved;
+  capped.rlim_cur = 768 * 1024;
+  auto previous = std::signal(SIGXFSZ, SIG_IGN);
+  setrlimit(RLIMIT_FSIZE, &capped);
+  [[maybe_unused]] int64_t written = builder.finish();
+  setrlimit(RLIMIT_FSIZE, &saved);
+  std::signal(SIGXFSZ, previous);
+
+  assert(written == -1);
+  assert(!fs::exists(path) && !fs::exists(path + ".tmp"));
+  limcode::snapshot::AccountIndex index;
+  [[maybe_unused]] bool opened = index.open(path);
+  assert(!opened && !index.is_open());
+
+  std::cout << "  Index failed finish: PASS\n";
+}
+
+void test_merged_index_reuse() {
+  auto full_path = temp_path("reuse_full") + ".tar.zst";
+  auto incremental_path = temp_path("reuse_incremental") + ".tar.zst";
+  auto full_cache = temp_path("reuse_full_cache");
+  auto incremental_cache = temp_path("reuse_incremental_cache");
+  for (const auto &dir : {full_cache, incremental_cache}) {
+    fs::remove_all(dir);
+  }
+  [[maybe_unused]] bool written =
+      write_archive(full_path, make_accounts(60)) &&
+      write_archive(incremental_path, make_accounts(30, 40), 200);
+  assert(written);
+
+  ParallelStreamOptions options;
+  options.num_threads = 2;
+  auto merged = [&] {
+    return limcode::snapshot::stream_merged_snapshot(
+        full_path, full_cache, incremental_path, incremental_cache,
+        [](std::span<const SnapshotAccountView>) { return true; }, options);
+  };
+  auto index_path = (fs::path(incremental_cache) / "merged.index").string();
+  [[maybe_unused]] int64_t streamed = merged();
+  assert(streamed == 70);
+  limcode::snapshot::AccountIndex index;
+  [[maybe_unused]] bool opened = index.open(index_path);
+  assert(opened && index.size() == 70);
+  [[maybe_unused]] auto stamp = index.source_stamp();
+  assert(stamp[0] == fs::file_size(full_path) &&
+         stamp[2] == fs::file_size(incremental_path));
+
+  // A newer index that wasn't built from these caches is not trusted
+  limcode::snapshot::AccountIndexBuilder empty(index_path);
+  [[maybe_unused]] int64_t rows = empty.finish();
+  assert(rows == 0);
+  streamed = merged();
+  assert(streamed == 70);
+
+  // Nor is one built before the incremental archive was replaced
+  written = write_archive(incremental_path, make_accounts(50, 40), 200);
+  assert(written);
+  streamed = merged();
+  assert(streamed == 90);
+  opened = index.open(index_path);
+  assert(opened && index.size() == 90);
+  assert(index.source_stamp()[2] == fs::file_size(incremental_path));
+
+  for (const auto &path : {full_path, incremental_path}) {
+    fs::remove(path);
+  }
+  for (const auto &dir : {full_cache, incremental_cache}) {
+    fs::remove_all(dir);
+  }
+  std::cout << "  Merged index reuse: PASS\n";
+}
+
+void test_cache_invalidation() {
+  auto path = temp_path("stale") + ".tar.zst";
+  auto cache = temp_path("stale_cache");
+  fs::remove_all(cache);
+  auto count = [](std::span<const SnapshotAccountView>) { return true; };
+  ParallelStreamOptions options;
+  options.num_threads = 2;
+
+  auto first = make_accounts(100);
+  [[maybe_unused]] bool written = write_archive(path, first);
+  assert(written);
+  assert(!limcode::snapshot::is_unpacked_snapshot(cache, path));
+  [[maybe_unused]] int64_t streamed =
+      limcode::snapshot::stream_snapshot_cached(path, cache, count, options);
+  assert(streamed == 100);
+  assert(limcode::snapshot::is_unpacked_snapshot(cache, path));
+
+  // A new archive at the same path, with storages at other slots: the old
+  // extraction must be replaced, not merged into
+  auto second = make_accounts(40, 500);
+  written = write_archive(path, second, 300);
+  assert(written);
+  assert(limcode::snapshot::is_unpacked_snapshot(cache));
+  assert(!limcode::snapshot::is_unpacked_snapshot(cache, path));
+  std::atomic<uint64_t> lamports{0};
+  streamed = limcode::snapshot::stream_snapshot_cached(
+      path, cache,
+      [&](std::span<const SnapshotAccountView> batch) {
+        for (const auto &view : batch) {
+          lamports += view.lamports();
+        }
+        return true;
+      },
+      options);
+  assert(streamed == 40 && lamports == total_lamports(second));
+  assert(limcode::snapshot::is_unpacked_snapshot(cache, path));
+  streamed = limcode::snapshot::stream_unpacked_snapshot(cache, count, options);
+  assert(streamed == 40);
+
+  // A missing archive fails before the old cache is touched
+  fs::remove(path);
+  streamed = limcode::snapshot::unpack_snapshot(path, cache, options);
+  assert(streamed == -1);
+  assert(limcode::snapshot::is_unpacked_snapshot(cache));
+
+  fs::remove_all(cache);
+  std::cout << "  Cache invalidation: PASS\n";
+}
+
+int main() {
+  std::cout << "\nLimcode Snapshot Tests\n\n";
+
+  test_parallel_batches();
+  test_parallel_early_stop();
+  test_missing_archive();
+  test_inflight_budget();
+  test_writer_round_trip();
+  test_c_stream_cached_merged();
+  test_column_export();
+  test_merged_accounts_hash();
+  test_merged_index_reuse();
+  test_cache_invalidation();
+  test_index_concurrent_spills();
+  test_index_failed_finish();
+
+  std::cout << "\nAll snapshot tests passed!\n";
+  return 0;
+}